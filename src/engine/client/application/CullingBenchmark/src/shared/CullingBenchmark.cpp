@@ -0,0 +1,380 @@
+// ======================================================================
+//
+// CullingBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstCullingBenchmark.h"
+#include "CullingBenchmark.h"
+
+#include "clientGraphics/BatchCuller.h"
+#include "clientGraphics/Graphics.h"
+#include "clientGraphics/SetupClientGraphics.h"
+#include "clientObject/ObjectListCamera.h"
+#include "clientObject/SetupClientObject.h"
+#include "sharedCompression/SetupSharedCompression.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedDebug/SetupSharedDebug.h"
+#include "sharedFile/SetupSharedFile.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/SetupSharedFoundation.h"
+#include "sharedImage/SetupSharedImage.h"
+#include "sharedMath/SetupSharedMath.h"
+#include "sharedMath/Sphere.h"
+#include "sharedMath/Vector.h"
+#include "sharedObject/SetupSharedObject.h"
+#include "sharedRandom/Random.h"
+#include "sharedRandom/SetupSharedRandom.h"
+#include "sharedThread/SetupSharedThread.h"
+#include "sharedUtility/SetupSharedUtility.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// ======================================================================
+
+namespace CullingBenchmarkNamespace
+{
+	enum Pass
+	{
+		P_object,
+		P_scalar,
+		P_simd
+	};
+
+	struct PassStatistics
+	{
+		int    frameCount;
+		float  elapsedTime;
+		int    testedCount;
+		int    culledCount;
+	};
+
+	typedef std::vector<uint32>  ChecksumVector;
+	typedef std::vector<float>   FloatVector;
+	typedef std::vector<Sphere>  SphereVector;
+
+	char const *const cs_sectionName = "CullingBenchmark";
+
+	// the camera stands at eye height in the middle of the scene
+	float const cs_eyeHeight = 1.8f;
+
+	int  s_exitCode;
+
+	void    createScene(int objectCount, float areaSize, float maximumDistance, SphereVector &spheres, FloatVector &maximumDistances);
+	uint32  addToChecksum(uint32 checksum, int index);
+	void    runPass(Pass pass, ObjectListCamera &camera, SphereVector const &spheres, FloatVector const &maximumDistances, float fadeFraction, int frameCount, PassStatistics &statistics, ChecksumVector &checksums);
+	void    printPass(char const *name, PassStatistics const &statistics, PassStatistics const &object);
+	bool    compareChecksums(char const *name, ChecksumVector const &checksums, ChecksumVector const &objectChecksums);
+	void    runBenchmark();
+}
+
+using namespace CullingBenchmarkNamespace;
+
+// ======================================================================
+// namespace CullingBenchmarkNamespace
+// ======================================================================
+/**
+ * Scatters spheres over the x-z plane centered on the origin, most of them
+ * small and culled close in like flora and clutter, a few large ones that
+ * stay visible out to the full maximum distance like trees and buildings.
+ */
+
+void CullingBenchmarkNamespace::createScene(int const objectCount, float const areaSize, float const maximumDistance, SphereVector &spheres, FloatVector &maximumDistances)
+{
+	float const halfSize = areaSize * 0.5f;
+
+	spheres.reserve(static_cast<size_t>(objectCount));
+	maximumDistances.reserve(static_cast<size_t>(objectCount));
+
+	for (int i = 0; i < objectCount; ++i)
+	{
+		bool const large = (i % 16) == 0;
+		float const radius = large ? Random::randomReal(4.0f, 24.0f) : Random::randomReal(0.25f, 2.0f);
+
+		Vector const center(Random::randomReal(-halfSize, halfSize), radius * 0.5f, Random::randomReal(-halfSize, halfSize));
+
+		spheres.push_back(Sphere(center, radius));
+		maximumDistances.push_back(large ? maximumDistance : maximumDistance * 0.25f);
+	}
+}
+
+// ----------------------------------------------------------------------
+
+inline uint32 CullingBenchmarkNamespace::addToChecksum(uint32 const checksum, int const index)
+{
+	return (checksum * 31u) + static_cast<uint32>(index) + 1u;
+}
+
+// ----------------------------------------------------------------------
+
+void CullingBenchmarkNamespace::runPass(Pass const pass, ObjectListCamera &camera, SphereVector const &spheres, FloatVector const &maximumDistances, float const fadeFraction, int const frameCount, PassStatistics &statistics, ChecksumVector &checksums)
+{
+	memset(&statistics, 0, sizeof(statistics));
+	checksums.clear();
+
+	BatchCuller::setUseSimd(pass == P_simd);
+
+	int const objectCount = static_cast<int>(spheres.size());
+	float const yawPerFrame = PI_TIMES_2 / static_cast<float>(frameCount);
+
+	BatchCuller::Batch batch;
+	BatchCuller::Result result;
+	batch.reserve(objectCount);
+
+	camera.resetRotate_o2p();
+	camera.setPosition_p(Vector(0.0f, cs_eyeHeight, 0.0f));
+
+	PerformanceTimer timer;
+	timer.start();
+
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		camera.yaw_o(yawPerFrame);
+
+		uint32 checksum = 0;
+		int visibleCount = 0;
+
+		if (pass == P_object)
+		{
+			Vector const cameraPosition_w = camera.getPosition_w();
+
+			for (int i = 0; i < objectCount; ++i)
+			{
+				Sphere const &sphere = spheres[static_cast<size_t>(i)];
+
+				if (camera.testVisibility_w(sphere) && cameraPosition_w.magnitudeBetween(sphere.getCenter()) <= maximumDistances[static_cast<size_t>(i)])
+				{
+					checksum = addToChecksum(checksum, i);
+					++visibleCount;
+				}
+			}
+		}
+		else
+		{
+			batch.clear();
+
+			for (int i = 0; i < objectCount; ++i)
+			{
+				Sphere const &sphere = spheres[static_cast<size_t>(i)];
+				float const maximumDistance = maximumDistances[static_cast<size_t>(i)];
+
+				IGNORE_RETURN(batch.addSphere(sphere.getCenter(), sphere.getRadius(), maximumDistance, maximumDistance * fadeFraction));
+			}
+
+			BatchCuller::cull(batch, camera, result);
+
+			visibleCount = result.getNumberOfVisible();
+			for (int i = 0; i < visibleCount; ++i)
+				checksum = addToChecksum(checksum, result.getIndex(i));
+		}
+
+		checksums.push_back(checksum);
+
+		statistics.testedCount += objectCount;
+		statistics.culledCount += objectCount - visibleCount;
+		++statistics.frameCount;
+	}
+
+	timer.stop();
+
+	statistics.elapsedTime = timer.getElapsedTime();
+}
+
+// ----------------------------------------------------------------------
+
+void CullingBenchmarkNamespace::printPass(char const *const name, PassStatistics const &statistics, PassStatistics const &object)
+{
+	float const frameCount = static_cast<float>(std::max(1, statistics.frameCount));
+	float const milliseconds = statistics.elapsedTime * 1000.0f;
+	float const culledPerMillisecond = milliseconds > 0.0f ? static_cast<float>(statistics.culledCount) / milliseconds : 0.0f;
+	float const savedPerFrame = (object.elapsedTime - statistics.elapsedTime) * 1000.0f / frameCount;
+
+	printf("%-8s %8d %10.3f %10d %10d %12.0f %10.3f\n", name, statistics.frameCount, milliseconds / frameCount, statistics.testedCount / statistics.frameCount, statistics.culledCount / statistics.frameCount, culledPerMillisecond, savedPerFrame);
+}
+
+// ----------------------------------------------------------------------
+
+bool CullingBenchmarkNamespace::compareChecksums(char const *const name, ChecksumVector const &checksums, ChecksumVector const &objectChecksums)
+{
+	int mismatchCount = 0;
+	for (size_t i = 0; i < checksums.size() && i < objectChecksums.size(); ++i)
+		if (checksums[i] != objectChecksums[i])
+		{
+			if (mismatchCount == 0)
+				printf("ERROR: frame %d of the %s pass found different visible spheres than the object pass.\n", static_cast<int>(i), name);
+			++mismatchCount;
+		}
+
+	if (mismatchCount > 0)
+	{
+		printf("ERROR: %d of %d frames of the %s pass differ.\n", mismatchCount, static_cast<int>(objectChecksums.size()), name);
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+void CullingBenchmarkNamespace::runBenchmark()
+{
+	int const   objectCount     = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "objectCount", 100000));
+	float const areaSize        = std::max(1.0f, ConfigFile::getKeyFloat(cs_sectionName, "areaSize", 2048.0f));
+	float const maximumDistance = std::max(1.0f, ConfigFile::getKeyFloat(cs_sectionName, "maximumDistance", 512.0f));
+	float const fadeFraction    = clamp(0.0f, ConfigFile::getKeyFloat(cs_sectionName, "fadeFraction", 0.75f), 1.0f);
+	int const   frameCount      = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "frameCount", 200));
+
+	bool const wasUsingSimd = BatchCuller::getUseSimd();
+	BatchCuller::setUseSimd(true);
+	bool const simdAvailable = BatchCuller::getUseSimd();
+
+	SphereVector spheres;
+	FloatVector maximumDistances;
+	createScene(objectCount, areaSize, maximumDistance, spheres, maximumDistances);
+
+	ObjectListCamera *const camera = new ObjectListCamera(1);
+	camera->setViewport(0, 0, Graphics::getFrameBufferMaxWidth(), Graphics::getFrameBufferMaxHeight());
+	camera->setNearPlane(0.1f);
+	camera->setFarPlane(maximumDistance);
+
+	PassStatistics object;
+	ChecksumVector objectChecksums;
+	runPass(P_object, *camera, spheres, maximumDistances, fadeFraction, frameCount, object, objectChecksums);
+
+	PassStatistics scalar;
+	ChecksumVector scalarChecksums;
+	runPass(P_scalar, *camera, spheres, maximumDistances, fadeFraction, frameCount, scalar, scalarChecksums);
+
+	PassStatistics simd;
+	ChecksumVector simdChecksums;
+	if (simdAvailable)
+		runPass(P_simd, *camera, spheres, maximumDistances, fadeFraction, frameCount, simd, simdChecksums);
+
+	//-- Report.
+	printf("\n%d spheres over %1.0f m, %1.0f m maximum distance, %d frames per pass.\n", objectCount, areaSize, maximumDistance, frameCount);
+	printf("%-8s %8s %10s %10s %10s %12s %10s\n", "pass", "frames", "ms/frm", "tested", "culled", "culled/ms", "saved ms");
+	printPass("object", object, object);
+	printPass("scalar", scalar, object);
+	if (simdAvailable)
+		printPass("simd", simd, object);
+	else
+		printf("%-8s the cpu has no SSE2, the SIMD pass was skipped.\n", "simd");
+
+	bool matched = compareChecksums("scalar", scalarChecksums, objectChecksums);
+	if (simdAvailable)
+		matched = compareChecksums("simd", simdChecksums, objectChecksums) && matched;
+
+	if (matched)
+		printf("Every pass found the same visible spheres over %d frames.\n", frameCount);
+	else
+		s_exitCode = 1;
+
+	//-- Clean up.
+	delete camera;
+
+	BatchCuller::setUseSimd(wasUsingSimd);
+}
+
+// ======================================================================
+
+int main(int argc, char **argv)
+{
+	//-- thread
+	SetupSharedThread::install();
+
+	//-- debug
+	SetupSharedDebug::install(4096);
+
+	//-- foundation
+	{
+		SetupSharedFoundation::Data data(SetupSharedFoundation::Data::D_console);
+		data.argc       = argc;
+		data.argv       = argv;
+		data.configFile = "cullingBenchmark.cfg";
+		SetupSharedFoundation::install(data);
+	}
+
+	//-- file
+	SetupSharedCompression::install();
+	SetupSharedFile::install(false);
+
+	//-- math
+	SetupSharedMath::install();
+
+	//-- utility
+	{
+		SetupSharedUtility::Data data;
+		SetupSharedUtility::setupToolData(data);
+		SetupSharedUtility::install(data);
+	}
+
+	//-- random
+	SetupSharedRandom::install(0);
+
+	//-- image
+	{
+		SetupSharedImage::Data data;
+		SetupSharedImage::setupDefaultData(data);
+		SetupSharedImage::install(data);
+	}
+
+	//-- object
+	{
+		SetupSharedObject::Data data;
+		SetupSharedObject::setupDefaultConsoleData(data);
+		SetupSharedObject::install(data);
+	}
+
+	//-- graphics
+	SetupClientGraphics::Data graphicsData;
+	SetupClientGraphics::setupDefaultGameData(graphicsData);
+	graphicsData.screenWidth                       = 640;
+	graphicsData.screenHeight                      = 480;
+	graphicsData.windowed                          = true;
+	graphicsData.preloadVertexColorShaderTemplates = false;
+
+	if (SetupClientGraphics::install(graphicsData))
+	{
+		//-- object
+		{
+			SetupClientObject::Data data;
+			SetupClientObject::setupToolData(data);
+			SetupClientObject::install(data);
+		}
+
+		SetupSharedFoundation::callbackWithExceptionHandling(CullingBenchmark::run);
+	}
+	else
+	{
+		printf("ERROR: the graphics system could not be installed.\n");
+		s_exitCode = 1;
+	}
+
+	SetupSharedFoundation::remove();
+	SetupSharedThread::remove();
+
+	return CullingBenchmark::getExitCode();
+}
+
+// ======================================================================
+// class CullingBenchmark
+// ======================================================================
+
+void CullingBenchmark::run()
+{
+	printf("Culling benchmark " __DATE__ " " __TIME__ "\n");
+	runBenchmark();
+}
+
+// ----------------------------------------------------------------------
+
+int CullingBenchmark::getExitCode()
+{
+	return s_exitCode;
+}
+
+// ======================================================================
@@ -0,0 +1,49 @@
+// ======================================================================
+//
+// CullingBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_CullingBenchmark_H
+#define INCLUDED_CullingBenchmark_H
+
+// ======================================================================
+/**
+ * Measures culling a dense outdoor scene with the BatchCuller against
+ * testing each object on its own.
+ *
+ * objectCount bounding spheres are scattered over an areaSize square around
+ * a camera standing at eye height, which turns a full circle over
+ * frameCount frames.  Each frame every sphere is tested against the frustum
+ * and its maximumDistance from the camera three times:
+ *
+ *   - object:  Camera::testVisibility_w() and a distance check per sphere,
+ *              the way the managers test their objects.
+ *   - scalar:  one BatchCuller pass with the SIMD path disabled.
+ *   - simd:    one BatchCuller pass with the SIMD path, when the cpu has it.
+ *
+ * The batch passes include filling the batch each frame.  Each pass prints
+ * its time per frame, spheres culled per millisecond and the main thread
+ * time saved per frame over the object pass.  The benchmark fails if any
+ * pass finds a different set of visible spheres than the object pass.
+ */
+
+class CullingBenchmark
+{
+public:
+
+	static void run();
+	static int  getExitCode();
+
+private:
+
+	// disabled
+	CullingBenchmark();
+	CullingBenchmark(CullingBenchmark const &);
+	CullingBenchmark &operator =(CullingBenchmark const &);
+};
+
+// ======================================================================
+
+#endif
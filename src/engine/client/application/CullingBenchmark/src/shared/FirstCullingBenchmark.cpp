@@ -0,0 +1,8 @@
+// ======================================================================
+//
+// FirstCullingBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstCullingBenchmark.h"
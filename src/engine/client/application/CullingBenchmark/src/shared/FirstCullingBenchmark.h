@@ -0,0 +1,17 @@
+// ======================================================================
+//
+// FirstCullingBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_FirstCullingBenchmark_H
+#define INCLUDED_FirstCullingBenchmark_H
+
+// ======================================================================
+
+#include "sharedFoundation/FirstSharedFoundation.h"
+
+// ======================================================================
+
+#endif
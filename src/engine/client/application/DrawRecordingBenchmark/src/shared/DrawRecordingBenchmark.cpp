@@ -0,0 +1,405 @@
+// ======================================================================
+//
+// DrawRecordingBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstDrawRecordingBenchmark.h"
+#include "DrawRecordingBenchmark.h"
+
+#include "clientGraphics/Graphics.h"
+#include "clientGraphics/SetupClientGraphics.h"
+#include "clientGraphics/ShaderPrimitiveSorter.h"
+#include "clientObject/ObjectListCamera.h"
+#include "clientObject/SetupClientObject.h"
+#include "sharedCompression/SetupSharedCompression.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedDebug/SetupSharedDebug.h"
+#include "sharedFile/SetupSharedFile.h"
+#include "sharedFile/TreeFile.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/Os.h"
+#include "sharedFoundation/SetupSharedFoundation.h"
+#include "sharedImage/SetupSharedImage.h"
+#include "sharedMath/SetupSharedMath.h"
+#include "sharedMath/Vector.h"
+#include "sharedObject/AppearanceTemplateList.h"
+#include "sharedObject/Object.h"
+#include "sharedObject/ObjectList.h"
+#include "sharedObject/SetupSharedObject.h"
+#include "sharedRandom/SetupSharedRandom.h"
+#include "sharedThread/SetupSharedThread.h"
+#include "sharedUtility/SetupSharedUtility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ======================================================================
+
+namespace DrawRecordingBenchmarkNamespace
+{
+	struct PassStatistics
+	{
+		int    frameCount;
+		float  elapsedTime;
+		float  recordTime;
+		float  executeTime;
+		int    recordedEntryCount;
+		int    deferredEntryCount;
+		int    commandCount;
+		int    drawCallCount;
+		int    byteCount;
+	};
+
+	typedef std::vector<uint32>       ChecksumVector;
+	typedef std::vector<Object*>      ObjectVector;
+	typedef std::vector<std::string>  StringVector;
+
+	char const *const cs_sectionName = "DrawRecordingBenchmark";
+
+	int  s_exitCode;
+
+	bool  loadAppearanceNames(StringVector &appearanceNames);
+	bool  createObjects(StringVector const &appearanceNames, int objectCount, float spacing, ObjectVector &objects);
+	void  lookAt(ObjectListCamera &camera, Vector const &center, float gridSize);
+	void  accumulateFrame(PassStatistics &statistics, ChecksumVector &checksums);
+	void  runPass(ObjectListCamera &camera, bool recording, bool threads, int frameCount, float frameTime, PassStatistics &statistics, ChecksumVector &checksums);
+	void  printPass(char const *name, PassStatistics const &statistics);
+	void  runBenchmark();
+}
+
+using namespace DrawRecordingBenchmarkNamespace;
+
+// ======================================================================
+// namespace DrawRecordingBenchmarkNamespace
+// ======================================================================
+
+bool DrawRecordingBenchmarkNamespace::loadAppearanceNames(StringVector &appearanceNames)
+{
+	for (int i = 0; ; ++i)
+	{
+		char const *const text = ConfigFile::getKeyString(cs_sectionName, "appearance", i, 0);
+		if (!text)
+			break;
+
+		if (!TreeFile::exists(text))
+		{
+			printf("ERROR: appearance %d is not in the tree file search path: [%s]\n", i, text);
+			return false;
+		}
+
+		appearanceNames.push_back(text);
+	}
+
+	if (appearanceNames.empty())
+	{
+		printf("ERROR: no [%s] appearance keys were specified.\n", cs_sectionName);
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * The objects are laid out in a grid on the x-z plane centered on the
+ * origin, cycling through the appearance names.
+ */
+
+bool DrawRecordingBenchmarkNamespace::createObjects(StringVector const &appearanceNames, int objectCount, float spacing, ObjectVector &objects)
+{
+	int const gridWidth = static_cast<int>(ceil(sqrt(static_cast<double>(objectCount))));
+	float const gridOffset = static_cast<float>(gridWidth - 1) * spacing * 0.5f;
+
+	for (int i = 0; i < objectCount; ++i)
+	{
+		std::string const &appearanceName = appearanceNames[static_cast<size_t>(i) % appearanceNames.size()];
+
+		Appearance *const appearance = AppearanceTemplateList::createAppearance(appearanceName.c_str());
+		if (!appearance)
+		{
+			printf("ERROR: [%s] could not be created.\n", appearanceName.c_str());
+			return false;
+		}
+
+		Object *const object = new Object();
+		object->setAppearance(appearance);
+		object->setPosition_p(Vector(static_cast<float>(i % gridWidth) * spacing - gridOffset, 0.0f, static_cast<float>(i / gridWidth) * spacing - gridOffset));
+
+		objects.push_back(object);
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+void DrawRecordingBenchmarkNamespace::lookAt(ObjectListCamera &camera, Vector const &center, float const gridSize)
+{
+	camera.resetRotate_o2p();
+	camera.setPosition_p(center + Vector(0.0f, gridSize * 0.5f, -gridSize));
+	camera.pitch_o(PI_OVER_4 * 0.5f);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * The sorter reports the frame before the current one, so this is called
+ * after Graphics::update() has started the next frame.
+ */
+
+void DrawRecordingBenchmarkNamespace::accumulateFrame(PassStatistics &statistics, ChecksumVector &checksums)
+{
+	statistics.recordTime         += ShaderPrimitiveSorter::getDrawRecordTimeLastFrame();
+	statistics.executeTime        += ShaderPrimitiveSorter::getDrawExecuteTimeLastFrame();
+	statistics.recordedEntryCount += ShaderPrimitiveSorter::getNumberOfRecordedEntriesLastFrame();
+	statistics.deferredEntryCount += ShaderPrimitiveSorter::getNumberOfDeferredEntriesLastFrame();
+	statistics.commandCount       += ShaderPrimitiveSorter::getNumberOfRecordedCommandsLastFrame();
+	statistics.drawCallCount      += ShaderPrimitiveSorter::getNumberOfRecordedDrawCallsLastFrame();
+	statistics.byteCount          += ShaderPrimitiveSorter::getRecordedBytesLastFrame();
+
+	checksums.push_back(ShaderPrimitiveSorter::getRecordedChecksumLastFrame());
+}
+
+// ----------------------------------------------------------------------
+
+void DrawRecordingBenchmarkNamespace::runPass(ObjectListCamera &camera, bool const recording, bool const threads, int const frameCount, float const frameTime, PassStatistics &statistics, ChecksumVector &checksums)
+{
+	memset(&statistics, 0, sizeof(statistics));
+	checksums.clear();
+
+	ShaderPrimitiveSorter::setDrawRecordingEnabled(recording);
+	ShaderPrimitiveSorter::setDrawRecordingThreadsEnabled(threads);
+
+	PerformanceTimer timer;
+	timer.start();
+
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		IGNORE_RETURN(Os::update());
+		Graphics::update(frameTime);
+
+		if (frame > 0)
+			accumulateFrame(statistics, checksums);
+
+		Graphics::setViewport(0, 0, camera.getViewportWidth(), camera.getViewportHeight());
+		Graphics::beginScene();
+		camera.renderScene();
+		Graphics::endScene();
+
+		++statistics.frameCount;
+	}
+
+	timer.stop();
+
+	//-- Start one more frame to collect the statistics of the last one drawn.
+	IGNORE_RETURN(Os::update());
+	Graphics::update(frameTime);
+	accumulateFrame(statistics, checksums);
+
+	statistics.elapsedTime = timer.getElapsedTime();
+}
+
+// ----------------------------------------------------------------------
+
+void DrawRecordingBenchmarkNamespace::printPass(char const *const name, PassStatistics const &statistics)
+{
+	float const frameCount = static_cast<float>(std::max(1, statistics.frameCount));
+
+	printf("%-10s %8d %10.3f %10.3f %10.3f %10d %10d %10d %10d %10d\n", name, statistics.frameCount, statistics.elapsedTime * 1000.0f / frameCount, statistics.recordTime * 1000.0f / frameCount, statistics.executeTime * 1000.0f / frameCount, statistics.recordedEntryCount / statistics.frameCount, statistics.deferredEntryCount / statistics.frameCount, statistics.commandCount / statistics.frameCount, statistics.drawCallCount / statistics.frameCount, statistics.byteCount / 1024 / statistics.frameCount);
+}
+
+// ----------------------------------------------------------------------
+
+void DrawRecordingBenchmarkNamespace::runBenchmark()
+{
+	StringVector appearanceNames;
+	if (!loadAppearanceNames(appearanceNames))
+	{
+		s_exitCode = 1;
+		return;
+	}
+
+	int const   objectCount      = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "objectCount", 256));
+	float const spacing          = ConfigFile::getKeyFloat(cs_sectionName, "spacing", 8.0f);
+	int const   frameCount       = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "frameCount", 200));
+	int const   warmupFrameCount = clamp(0, ConfigFile::getKeyInt(cs_sectionName, "warmupFrameCount", 4), frameCount - 1);
+	float const frameTime        = 1.0f / std::max(1.0f, ConfigFile::getKeyFloat(cs_sectionName, "framesPerSecond", 30.0f));
+
+	bool const wasEnabled        = ShaderPrimitiveSorter::isDrawRecordingEnabled();
+	bool const wereThreadsEnabled = ShaderPrimitiveSorter::isDrawRecordingThreadsEnabled();
+
+	float const gridSize = static_cast<float>(ceil(sqrt(static_cast<double>(objectCount)))) * spacing;
+
+	ObjectVector objects;
+	objects.reserve(static_cast<size_t>(objectCount));
+
+	ObjectList objectList(objectCount);
+	ObjectListCamera *const camera = new ObjectListCamera(1);
+
+	if (createObjects(appearanceNames, objectCount, spacing, objects))
+	{
+		for (ObjectVector::const_iterator it = objects.begin(); it != objects.end(); ++it)
+			objectList.addObject(*it);
+
+		camera->setViewport(0, 0, Graphics::getFrameBufferMaxWidth(), Graphics::getFrameBufferMaxHeight());
+		camera->setNearPlane(0.1f);
+		camera->setFarPlane(gridSize * 4.0f);
+		camera->addObjectList(&objectList);
+		lookAt(*camera, Vector::zero, gridSize);
+
+		PassStatistics immediate;
+		ChecksumVector immediateChecksums;
+		runPass(*camera, false, false, frameCount, frameTime, immediate, immediateChecksums);
+
+		PassStatistics serial;
+		ChecksumVector serialChecksums;
+		runPass(*camera, true, false, frameCount, frameTime, serial, serialChecksums);
+
+		PassStatistics threaded;
+		ChecksumVector threadedChecksums;
+		runPass(*camera, true, true, frameCount, frameTime, threaded, threadedChecksums);
+
+		//-- Report.
+		printf("\n%d objects, %d worker threads, %d frames per pass.\n", objectCount, ShaderPrimitiveSorter::getDrawRecordingThreadCount(), frameCount);
+		printf("%-10s %8s %10s %10s %10s %10s %10s %10s %10s %10s\n", "pass", "frames", "ms/frm", "record ms", "execute ms", "recorded", "deferred", "commands", "draws", "KB/frm");
+		printPass("immediate", immediate);
+		printPass("serial", serial);
+		printPass("threaded", threaded);
+
+		int mismatchCount = 0;
+		for (int i = warmupFrameCount; i < frameCount; ++i)
+			if (serialChecksums[static_cast<size_t>(i)] != threadedChecksums[static_cast<size_t>(i)])
+			{
+				if (mismatchCount == 0)
+					printf("ERROR: frame %d recorded %08lx serially and %08lx on the worker threads.\n", i, serialChecksums[static_cast<size_t>(i)], threadedChecksums[static_cast<size_t>(i)]);
+				++mismatchCount;
+			}
+
+		if (mismatchCount > 0)
+		{
+			printf("ERROR: %d of %d frames recorded different command streams.\n", mismatchCount, frameCount - warmupFrameCount);
+			s_exitCode = 1;
+		}
+		else
+			printf("The serial and threaded command streams match over %d frames.\n", frameCount - warmupFrameCount);
+	}
+	else
+		s_exitCode = 1;
+
+	//-- Clean up.
+	camera->removeObjectList(&objectList);
+	delete camera;
+
+	objectList.removeAll(false);
+
+	for (ObjectVector::iterator it = objects.begin(); it != objects.end(); ++it)
+		delete *it;
+
+	ShaderPrimitiveSorter::setDrawRecordingEnabled(wasEnabled);
+	ShaderPrimitiveSorter::setDrawRecordingThreadsEnabled(wereThreadsEnabled);
+}
+
+// ======================================================================
+
+int main(int argc, char **argv)
+{
+	//-- thread
+	SetupSharedThread::install();
+
+	//-- debug
+	SetupSharedDebug::install(4096);
+
+	//-- foundation
+	{
+		SetupSharedFoundation::Data data(SetupSharedFoundation::Data::D_console);
+		data.argc       = argc;
+		data.argv       = argv;
+		data.configFile = "drawRecordingBenchmark.cfg";
+		SetupSharedFoundation::install(data);
+	}
+
+	//-- file
+	SetupSharedCompression::install();
+	SetupSharedFile::install(false);
+
+	//-- math
+	SetupSharedMath::install();
+
+	//-- utility
+	{
+		SetupSharedUtility::Data data;
+		SetupSharedUtility::setupToolData(data);
+		SetupSharedUtility::install(data);
+	}
+
+	//-- random
+	SetupSharedRandom::install(0);
+
+	//-- image
+	{
+		SetupSharedImage::Data data;
+		SetupSharedImage::setupDefaultData(data);
+		SetupSharedImage::install(data);
+	}
+
+	//-- object
+	{
+		SetupSharedObject::Data data;
+		SetupSharedObject::setupDefaultConsoleData(data);
+		SetupSharedObject::install(data);
+	}
+
+	//-- graphics
+	SetupClientGraphics::Data graphicsData;
+	SetupClientGraphics::setupDefaultGameData(graphicsData);
+	graphicsData.screenWidth                       = 640;
+	graphicsData.screenHeight                      = 480;
+	graphicsData.windowed                          = true;
+	graphicsData.preloadVertexColorShaderTemplates = false;
+
+	if (SetupClientGraphics::install(graphicsData))
+	{
+		//-- object
+		{
+			SetupClientObject::Data data;
+			SetupClientObject::setupToolData(data);
+			SetupClientObject::install(data);
+		}
+
+		SetupSharedFoundation::callbackWithExceptionHandling(DrawRecordingBenchmark::run);
+	}
+	else
+	{
+		printf("ERROR: the graphics system could not be installed.\n");
+		s_exitCode = 1;
+	}
+
+	SetupSharedFoundation::remove();
+	SetupSharedThread::remove();
+
+	return DrawRecordingBenchmark::getExitCode();
+}
+
+// ======================================================================
+// class DrawRecordingBenchmark
+// ======================================================================
+
+void DrawRecordingBenchmark::run()
+{
+	printf("Draw recording benchmark " __DATE__ " " __TIME__ "\n");
+	runBenchmark();
+}
+
+// ----------------------------------------------------------------------
+
+int DrawRecordingBenchmark::getExitCode()
+{
+	return s_exitCode;
+}
+
+// ======================================================================
@@ -0,0 +1,50 @@
+// ======================================================================
+//
+// DrawRecordingBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_DrawRecordingBenchmark_H
+#define INCLUDED_DrawRecordingBenchmark_H
+
+// ======================================================================
+/**
+ * Measures recording ShaderPrimitiveSorter phases into command buffers.
+ *
+ * The appearances listed in the [DrawRecordingBenchmark] config section are
+ * laid out in a grid and drawn for frameCount frames three times:
+ *
+ *   - immediate:  draw recording disabled, every entry draws on the main
+ *                 thread.
+ *   - serial:     each phase recorded on the main thread.
+ *   - threaded:   each phase recorded on the worker threads.
+ *
+ * Each pass prints its time per frame and, for the recorded passes, the
+ * record and execute times and the size of the command stream.  The
+ * benchmark fails if the command stream of any frame after warmupFrameCount
+ * differs between the serial and threaded passes.
+ *
+ * [ClientGraphics] drawRecordingThreadCount sets the number of worker
+ * threads.  No GPU is needed when [ClientGraphics] rasterMajor selects the
+ * Headless rasterizer DLL, which consumes the same command stream.
+ */
+
+class DrawRecordingBenchmark
+{
+public:
+
+	static void run();
+	static int  getExitCode();
+
+private:
+
+	// disabled
+	DrawRecordingBenchmark();
+	DrawRecordingBenchmark(DrawRecordingBenchmark const &);
+	DrawRecordingBenchmark &operator =(DrawRecordingBenchmark const &);
+};
+
+// ======================================================================
+
+#endif
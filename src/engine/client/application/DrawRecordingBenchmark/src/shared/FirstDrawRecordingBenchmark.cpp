@@ -0,0 +1,8 @@
+// ======================================================================
+//
+// FirstDrawRecordingBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstDrawRecordingBenchmark.h"
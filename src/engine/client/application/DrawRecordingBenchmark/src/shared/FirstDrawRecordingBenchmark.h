@@ -0,0 +1,17 @@
+// ======================================================================
+//
+// FirstDrawRecordingBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_FirstDrawRecordingBenchmark_H
+#define INCLUDED_FirstDrawRecordingBenchmark_H
+
+// ======================================================================
+
+#include "sharedFoundation/FirstSharedFoundation.h"
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,8 @@
+// ======================================================================
+//
+// FirstParticleBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstParticleBenchmark.h"
@@ -0,0 +1,17 @@
+// ======================================================================
+//
+// FirstParticleBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_FirstParticleBenchmark_H
+#define INCLUDED_FirstParticleBenchmark_H
+
+// ======================================================================
+
+#include "sharedFoundation/FirstSharedFoundation.h"
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,611 @@
+// ======================================================================
+//
+// ParticleBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstParticleBenchmark.h"
+#include "ParticleBenchmark.h"
+
+#include "clientGraphics/Graphics.h"
+#include "clientGraphics/SetupClientGraphics.h"
+#include "clientObject/ObjectListCamera.h"
+#include "clientObject/SetupClientObject.h"
+#include "clientParticle/ParticleEffectAppearance.h"
+#include "clientParticle/ParticleEmitter.h"
+#include "clientParticle/ParticleEmitterGroup.h"
+#include "clientParticle/ParticleManager.h"
+#include "clientParticle/ParticleQuad.h"
+#include "clientParticle/ParticleQuadPool.h"
+#include "clientParticle/SetupClientParticle.h"
+#include "sharedCompression/SetupSharedCompression.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedDebug/SetupSharedDebug.h"
+#include "sharedFile/SetupSharedFile.h"
+#include "sharedFile/TreeFile.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/Os.h"
+#include "sharedFoundation/SetupSharedFoundation.h"
+#include "sharedImage/SetupSharedImage.h"
+#include "sharedMath/SetupSharedMath.h"
+#include "sharedMath/Vector.h"
+#include "sharedMemoryManager/MemoryManager.h"
+#include "sharedObject/AppearanceTemplateList.h"
+#include "sharedObject/Object.h"
+#include "sharedObject/ObjectList.h"
+#include "sharedObject/SetupSharedObject.h"
+#include "sharedRandom/Random.h"
+#include "sharedRandom/SetupSharedRandom.h"
+#include "sharedThread/SetupSharedThread.h"
+#include "sharedUtility/SetupSharedUtility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ======================================================================
+
+namespace ParticleBenchmarkNamespace
+{
+	enum Stage
+	{
+		S_alter,
+		S_render,
+
+		S_count
+	};
+
+	enum Mode
+	{
+		M_legacy,
+		M_pooledScalar,
+		M_pooledSimd,
+
+		M_count
+	};
+
+	struct StageStatistics
+	{
+		float          elapsedTime;
+		int            allocationCount;
+		unsigned long  allocatedByteCount;
+	};
+
+	struct SimulationStatistics
+	{
+		int    frameCount;
+		int    emitterCount;
+		int    parallelEmitterCount;
+		float  phaseTime;
+	};
+
+	typedef std::vector<Object*>      ObjectVector;
+	typedef std::vector<std::string>  StringVector;
+	typedef std::vector<uint32>       ChecksumVector;
+
+	class StageSample
+	{
+	public:
+
+		StageSample(StageStatistics &statistics, bool record);
+		~StageSample();
+
+	private:
+
+		// disabled
+		StageSample();
+		StageSample(StageSample const &);
+		StageSample &operator =(StageSample const &);
+
+	private:
+
+		StageStatistics     &m_statistics;
+		bool const           m_record;
+		int const            m_allocationCount;
+		unsigned long const  m_allocatedByteCount;
+		PerformanceTimer     m_timer;
+	};
+
+	char const *const cs_sectionName = "ParticleBenchmark";
+	char const *const cs_stageNames[S_count] =
+	{
+		"alter",
+		"render"
+	};
+	char const *const cs_modeNames[M_count] =
+	{
+		"legacy",
+		"pooled scalar",
+		"pooled simd"
+	};
+
+	int  s_exitCode;
+
+	bool  loadEffectNames(StringVector &effectNames);
+	bool  createEffects(StringVector const &effectNames, int effectCount, float spacing, ObjectVector &objects);
+	ParticleEffectAppearance *getParticleEffectAppearance(Object *object);
+	uint32 calculateParticleChecksum(ObjectVector const &objects);
+	void  runPass(Mode mode, StringVector const &effectNames);
+	bool  runDeterminismPass(bool simulationThreadsEnabled, StringVector const &effectNames, ChecksumVector &checksums);
+	void  checkDeterminism(StringVector const &effectNames);
+	void  runBenchmark();
+}
+
+using namespace ParticleBenchmarkNamespace;
+
+// ======================================================================
+// class ParticleBenchmarkNamespace::StageSample
+// ======================================================================
+
+ParticleBenchmarkNamespace::StageSample::StageSample(StageStatistics &statistics, bool record) :
+	m_statistics(statistics),
+	m_record(record),
+	m_allocationCount(MemoryManager::getTotalNumberOfAllocations()),
+	m_allocatedByteCount(MemoryManager::getTotalNumberOfBytesAllocated()),
+	m_timer()
+{
+	m_timer.start();
+}
+
+// ----------------------------------------------------------------------
+
+ParticleBenchmarkNamespace::StageSample::~StageSample()
+{
+	m_timer.stop();
+
+	if (m_record)
+	{
+		m_statistics.elapsedTime        += m_timer.getElapsedTime();
+		m_statistics.allocationCount    += MemoryManager::getTotalNumberOfAllocations() - m_allocationCount;
+		m_statistics.allocatedByteCount += MemoryManager::getTotalNumberOfBytesAllocated() - m_allocatedByteCount;
+	}
+}
+
+// ======================================================================
+// namespace ParticleBenchmarkNamespace
+// ======================================================================
+
+bool ParticleBenchmarkNamespace::loadEffectNames(StringVector &effectNames)
+{
+	for (int i = 0; ; ++i)
+	{
+		char const *const text = ConfigFile::getKeyString(cs_sectionName, "effect", i, 0);
+		if (!text)
+			break;
+
+		if (!TreeFile::exists(text))
+		{
+			printf("ERROR: effect %d is not in the tree file search path: [%s]\n", i, text);
+			return false;
+		}
+
+		effectNames.push_back(text);
+	}
+
+	if (effectNames.empty())
+	{
+		printf("ERROR: no [%s] effect keys were specified.\n", cs_sectionName);
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * The effects are laid out in a grid on the x-z plane centered on the
+ * origin, cycling through the effect names.
+ */
+
+bool ParticleBenchmarkNamespace::createEffects(StringVector const &effectNames, int effectCount, float spacing, ObjectVector &objects)
+{
+	int const gridWidth = static_cast<int>(ceil(sqrt(static_cast<double>(effectCount))));
+	float const gridOffset = static_cast<float>(gridWidth - 1) * spacing * 0.5f;
+
+	for (int i = 0; i < effectCount; ++i)
+	{
+		std::string const &effectName = effectNames[static_cast<size_t>(i) % effectNames.size()];
+
+		Appearance *const appearance = AppearanceTemplateList::createAppearance(effectName.c_str());
+		if (!ParticleEffectAppearance::asParticleEffectAppearance(appearance))
+		{
+			printf("ERROR: [%s] is not a particle effect.\n", effectName.c_str());
+			delete appearance;
+			return false;
+		}
+
+		Object *const object = new Object();
+		object->setAppearance(appearance);
+		object->setPosition_p(Vector(static_cast<float>(i % gridWidth) * spacing - gridOffset, 0.0f, static_cast<float>(i / gridWidth) * spacing - gridOffset));
+
+		objects.push_back(object);
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+ParticleEffectAppearance *ParticleBenchmarkNamespace::getParticleEffectAppearance(Object *object)
+{
+	NOT_NULL(object);
+	return NON_NULL(ParticleEffectAppearance::asParticleEffectAppearance(object->getAppearance()));
+}
+
+// ----------------------------------------------------------------------
+
+uint32 ParticleBenchmarkNamespace::calculateParticleChecksum(ObjectVector const &objects)
+{
+	uint32 checksum = 0;
+
+	for (ObjectVector::const_iterator it = objects.begin(); it != objects.end(); ++it)
+	{
+		ParticleEffectAppearance const *const appearance = getParticleEffectAppearance(*it);
+
+		for (int i = 0; i < appearance->getEmitterGroupCount(); ++i)
+		{
+			ParticleEmitterGroup const *const emitterGroup = NON_NULL(appearance->getEmitterGroup(i));
+
+			for (int j = 0; j < emitterGroup->getEmitterCount(); ++j)
+				checksum = NON_NULL(emitterGroup->getEmitter(j))->calculateParticleChecksum(checksum);
+		}
+	}
+
+	return checksum;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Emitters choose their particle storage when they are created, so every
+ * pass builds its own set of effects after selecting the mode.
+ */
+
+void ParticleBenchmarkNamespace::runPass(Mode const mode, StringVector const &effectNames)
+{
+	int const   effectCount      = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "effectCount", 64));
+	float const spacing          = ConfigFile::getKeyFloat(cs_sectionName, "spacing", 4.0f);
+	int const   warmUpFrameCount = std::max(0, ConfigFile::getKeyInt(cs_sectionName, "warmUpFrameCount", 60));
+	int const   frameCount       = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "frameCount", 600));
+	float const frameTime        = 1.0f / std::max(1.0f, ConfigFile::getKeyFloat(cs_sectionName, "framesPerSecond", 30.0f));
+
+	ParticleQuadPool::setEnabled(mode != M_legacy);
+	ParticleQuadPool::setUseSimd(mode == M_pooledSimd);
+
+	//-- Create the effects and a camera that looks down on all of them.
+	ObjectVector objects;
+	objects.reserve(static_cast<size_t>(effectCount));
+
+	ObjectList objectList(effectCount);
+	ObjectListCamera *const camera = new ObjectListCamera(1);
+
+	if (createEffects(effectNames, effectCount, spacing, objects))
+	{
+		for (ObjectVector::const_iterator it = objects.begin(); it != objects.end(); ++it)
+			objectList.addObject(*it);
+
+		float const gridSize = static_cast<float>(ceil(sqrt(static_cast<double>(effectCount)))) * spacing;
+
+		camera->setViewport(0, 0, Graphics::getFrameBufferMaxWidth(), Graphics::getFrameBufferMaxHeight());
+		camera->setNearPlane(0.1f);
+		camera->setFarPlane(gridSize * 4.0f);
+		camera->addObjectList(&objectList);
+		camera->setPosition_p(Vector(0.0f, gridSize * 0.5f, -gridSize));
+		camera->pitch_o(PI_OVER_4 * 0.5f);
+
+		//-- Run the frames.  Effects that finish are restarted outside the timed stages.
+		StageStatistics stageStatistics[S_count];
+		memset(stageStatistics, 0, sizeof(stageStatistics));
+
+		SimulationStatistics simulationStatistics;
+		memset(&simulationStatistics, 0, sizeof(simulationStatistics));
+
+		float particleCount    = 0.0f;
+		int   maxParticleCount = 0;
+
+		for (int frame = 0; frame < warmUpFrameCount + frameCount; ++frame)
+		{
+			bool const record = (frame >= warmUpFrameCount);
+
+			IGNORE_RETURN(Os::update());
+			Graphics::update(frameTime);
+
+			//-- The simulation counters roll over with the graphics frame, so they describe the previous frame here.
+			if (frame > warmUpFrameCount)
+			{
+				++simulationStatistics.frameCount;
+				simulationStatistics.emitterCount         += ParticleManager::getNumberOfSimulatedEmittersLastFrame();
+				simulationStatistics.parallelEmitterCount += ParticleManager::getNumberOfParallelEmittersLastFrame();
+				simulationStatistics.phaseTime            += ParticleManager::getSimulationPhaseTimeLastFrame();
+			}
+
+			for (ObjectVector::const_iterator it = objects.begin(); it != objects.end(); ++it)
+			{
+				ParticleEffectAppearance *const appearance = getParticleEffectAppearance(*it);
+				if (appearance->isDeletable())
+					appearance->restart();
+			}
+
+			{
+				StageSample const sample(stageStatistics[S_alter], record);
+
+				for (ObjectVector::const_iterator it = objects.begin(); it != objects.end(); ++it)
+					IGNORE_RETURN(getParticleEffectAppearance(*it)->alter(frameTime));
+			}
+
+			{
+				StageSample const sample(stageStatistics[S_render], record);
+
+				Graphics::setViewport(0, 0, camera->getViewportWidth(), camera->getViewportHeight());
+				Graphics::beginScene();
+				camera->renderScene();
+				Graphics::endScene();
+			}
+
+			if (record)
+			{
+				int const frameParticleCount = ParticleQuad::getGlobalCount();
+				particleCount += static_cast<float>(frameParticleCount);
+				maxParticleCount = std::max(maxParticleCount, frameParticleCount);
+			}
+		}
+
+		//-- Report.
+		float const particleFrameCount = std::max(1.0f, particleCount);
+
+		printf("\n%s: %d effects, %d frames at %.1f frames per second after %d warm-up frames, %.1f quad particles per frame, %d at most.\n", cs_modeNames[mode], effectCount, frameCount, 1.0f / frameTime, warmUpFrameCount, particleCount / static_cast<float>(frameCount), maxParticleCount);
+		printf("%-12s %12s %12s %16s %14s %14s\n", "stage", "total ms", "ms/frame", "ns/particle", "allocs/frame", "bytes/frame");
+
+		StageStatistics total;
+		memset(&total, 0, sizeof(total));
+
+		for (int stage = 0; stage < S_count; ++stage)
+		{
+			StageStatistics const &statistics = stageStatistics[stage];
+			printf("%-12s %12.3f %12.4f %16.3f %14.1f %14.1f\n", cs_stageNames[stage], statistics.elapsedTime * 1000.0f, statistics.elapsedTime * 1000.0f / static_cast<float>(frameCount), statistics.elapsedTime * 1000000000.0f / particleFrameCount, static_cast<float>(statistics.allocationCount) / static_cast<float>(frameCount), static_cast<float>(statistics.allocatedByteCount) / static_cast<float>(frameCount));
+
+			total.elapsedTime        += statistics.elapsedTime;
+			total.allocationCount    += statistics.allocationCount;
+			total.allocatedByteCount += statistics.allocatedByteCount;
+		}
+
+		printf("%-12s %12.3f %12.4f %16.3f %14.1f %14.1f\n", "total", total.elapsedTime * 1000.0f, total.elapsedTime * 1000.0f / static_cast<float>(frameCount), total.elapsedTime * 1000000000.0f / particleFrameCount, static_cast<float>(total.allocationCount) / static_cast<float>(frameCount), static_cast<float>(total.allocatedByteCount) / static_cast<float>(frameCount));
+
+		float const simulationFrameCount = static_cast<float>(std::max(1, simulationStatistics.frameCount));
+		printf("simulation: %.1f emitters per frame, %.1f of them in parallel, %.4f ms/frame in the parallel phase.\n", static_cast<float>(simulationStatistics.emitterCount) / simulationFrameCount, static_cast<float>(simulationStatistics.parallelEmitterCount) / simulationFrameCount, simulationStatistics.phaseTime * 1000.0f / simulationFrameCount);
+	}
+	else
+		s_exitCode = 1;
+
+	//-- Clean up.
+	camera->removeObjectList(&objectList);
+	delete camera;
+
+	objectList.removeAll(false);
+
+	for (ObjectVector::iterator it = objects.begin(); it != objects.end(); ++it)
+		delete *it;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Replays the effects from the same random seed every frame and records a
+ * checksum of every particle after each frame.  Nothing is drawn.
+ */
+
+bool ParticleBenchmarkNamespace::runDeterminismPass(bool const simulationThreadsEnabled, StringVector const &effectNames, ChecksumVector &checksums)
+{
+	int const   effectCount = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "effectCount", 64));
+	float const spacing     = ConfigFile::getKeyFloat(cs_sectionName, "spacing", 4.0f);
+	int const   frameCount  = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "determinismFrameCount", 120));
+	float const frameTime   = 1.0f / std::max(1.0f, ConfigFile::getKeyFloat(cs_sectionName, "framesPerSecond", 30.0f));
+
+	bool const wasSimulationThreadsEnabled = ParticleManager::isSimulationThreadsEnabled();
+	ParticleManager::setSimulationThreadsEnabled(simulationThreadsEnabled);
+
+	ObjectVector objects;
+	objects.reserve(static_cast<size_t>(effectCount));
+
+	Random::setSeed(1);
+
+	bool const result = createEffects(effectNames, effectCount, spacing, objects);
+	if (result)
+	{
+		checksums.reserve(static_cast<size_t>(frameCount));
+
+		for (int frame = 0; frame < frameCount; ++frame)
+		{
+			Random::setSeed(static_cast<uint32>(frame + 1));
+
+			for (ObjectVector::const_iterator it = objects.begin(); it != objects.end(); ++it)
+			{
+				ParticleEffectAppearance *const appearance = getParticleEffectAppearance(*it);
+				if (appearance->isDeletable())
+					appearance->restart();
+
+				IGNORE_RETURN(appearance->alter(frameTime));
+			}
+
+			checksums.push_back(calculateParticleChecksum(objects));
+		}
+	}
+
+	for (ObjectVector::iterator it = objects.begin(); it != objects.end(); ++it)
+		delete *it;
+
+	ParticleManager::setSimulationThreadsEnabled(wasSimulationThreadsEnabled);
+
+	return result;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Emitters simulated on the worker threads must end up in exactly the same
+ * state as when every emitter is simulated on the main thread.
+ */
+
+void ParticleBenchmarkNamespace::checkDeterminism(StringVector const &effectNames)
+{
+	ParticleQuadPool::setEnabled(true);
+	ParticleQuadPool::setUseSimd(true);
+
+	ChecksumVector serialChecksums;
+	ChecksumVector threadedChecksums;
+
+	if (!runDeterminismPass(false, effectNames, serialChecksums) || !runDeterminismPass(true, effectNames, threadedChecksums))
+	{
+		s_exitCode = 1;
+		return;
+	}
+
+	int mismatchCount = 0;
+
+	for (size_t frame = 0; frame < serialChecksums.size(); ++frame)
+	{
+		if (serialChecksums[frame] != threadedChecksums[frame])
+		{
+			if (mismatchCount == 0)
+				printf("ERROR: frame %d simulated on worker threads does not match the main thread: 0x%08lx != 0x%08lx\n", static_cast<int>(frame), threadedChecksums[frame], serialChecksums[frame]);
+
+			++mismatchCount;
+		}
+	}
+
+	printf("\ndeterminism: %d frames, %d differ between serial and threaded simulation.\n", static_cast<int>(serialChecksums.size()), mismatchCount);
+
+	if (mismatchCount > 0)
+		s_exitCode = 1;
+}
+
+// ----------------------------------------------------------------------
+
+void ParticleBenchmarkNamespace::runBenchmark()
+{
+	StringVector effectNames;
+	if (!loadEffectNames(effectNames))
+	{
+		s_exitCode = 1;
+		return;
+	}
+
+	//-- The user limit would cap the emission of large effects and hide the cost being measured.
+	ParticleEffectAppearance::setGlobalUserLimit(std::max(0, ConfigFile::getKeyInt(cs_sectionName, "particleLimit", 1000000)));
+
+	bool const wasEnabled = ParticleQuadPool::isEnabled();
+	bool const usedSimd   = ParticleQuadPool::getUseSimd();
+
+	for (int mode = 0; mode < M_count && s_exitCode == 0; ++mode)
+		runPass(static_cast<Mode>(mode), effectNames);
+
+	if (s_exitCode == 0)
+		checkDeterminism(effectNames);
+
+	ParticleQuadPool::setEnabled(wasEnabled);
+	ParticleQuadPool::setUseSimd(usedSimd);
+}
+
+// ======================================================================
+
+int main(int argc, char **argv)
+{
+	//-- thread
+	SetupSharedThread::install();
+
+	//-- debug
+	SetupSharedDebug::install(4096);
+
+	//-- foundation
+	{
+		SetupSharedFoundation::Data data(SetupSharedFoundation::Data::D_console);
+		data.argc       = argc;
+		data.argv       = argv;
+		data.configFile = "particleBenchmark.cfg";
+		SetupSharedFoundation::install(data);
+	}
+
+	//-- file
+	SetupSharedCompression::install();
+	SetupSharedFile::install(false);
+
+	//-- math
+	SetupSharedMath::install();
+
+	//-- utility
+	{
+		SetupSharedUtility::Data data;
+		SetupSharedUtility::setupToolData(data);
+		SetupSharedUtility::install(data);
+	}
+
+	//-- random
+	SetupSharedRandom::install(0);
+
+	//-- image
+	{
+		SetupSharedImage::Data data;
+		SetupSharedImage::setupDefaultData(data);
+		SetupSharedImage::install(data);
+	}
+
+	//-- object
+	{
+		SetupSharedObject::Data data;
+		SetupSharedObject::setupDefaultConsoleData(data);
+		SetupSharedObject::install(data);
+	}
+
+	//-- graphics
+	SetupClientGraphics::Data graphicsData;
+	SetupClientGraphics::setupDefaultGameData(graphicsData);
+	graphicsData.screenWidth                       = 640;
+	graphicsData.screenHeight                      = 480;
+	graphicsData.windowed                          = true;
+	graphicsData.preloadVertexColorShaderTemplates = false;
+
+	if (SetupClientGraphics::install(graphicsData))
+	{
+		//-- object
+		{
+			SetupClientObject::Data data;
+			SetupClientObject::setupToolData(data);
+			SetupClientObject::install(data);
+		}
+
+		//-- particles
+		SetupClientParticle::install();
+
+		SetupSharedFoundation::callbackWithExceptionHandling(ParticleBenchmark::run);
+	}
+	else
+	{
+		printf("ERROR: the graphics system could not be installed.\n");
+		s_exitCode = 1;
+	}
+
+	SetupSharedFoundation::remove();
+	SetupSharedThread::remove();
+
+	return ParticleBenchmark::getExitCode();
+}
+
+// ======================================================================
+// class ParticleBenchmark
+// ======================================================================
+
+void ParticleBenchmark::run()
+{
+	printf("Particle benchmark " __DATE__ " " __TIME__ "\n");
+	runBenchmark();
+}
+
+// ----------------------------------------------------------------------
+
+int ParticleBenchmark::getExitCode()
+{
+	return s_exitCode;
+}
+
+// ======================================================================
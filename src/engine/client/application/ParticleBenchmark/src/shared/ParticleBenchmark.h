@@ -0,0 +1,55 @@
+// ======================================================================
+//
+// ParticleBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_ParticleBenchmark_H
+#define INCLUDED_ParticleBenchmark_H
+
+// ======================================================================
+/**
+ * Measures the CPU cost of updating and drawing particle effects.
+ *
+ * The .prt effects listed in the [ParticleBenchmark] config section are
+ * laid out in a grid in front of a camera and replayed for a fixed number
+ * of frames, once for each particle storage mode:
+ *
+ *   - legacy:         one heap allocated ParticleQuad per particle.
+ *   - pooled scalar:  ParticleQuadPool with the SSE2 kernels disabled.
+ *   - pooled simd:    ParticleQuadPool with the SSE2 kernels enabled.
+ *
+ * The time and allocations spent in each stage are printed when a pass
+ * finishes, along with how many emitters were simulated on the worker
+ * threads:
+ *
+ *   - alter:   emitting, integrating and expiring particles.
+ *   - render:  sorting the particles and filling their vertex buffers.
+ *
+ * A final pass replays the effects twice from the same random seeds, once
+ * with the simulation threads disabled, and fails if the particles of any
+ * frame differ between the two runs.
+ *
+ * No GPU is needed when [ClientGraphics] rasterMajor selects the Headless
+ * rasterizer DLL, which only keeps vertex and index buffers in memory.
+ */
+
+class ParticleBenchmark
+{
+public:
+
+	static void run();
+	static int  getExitCode();
+
+private:
+
+	// disabled
+	ParticleBenchmark();
+	ParticleBenchmark(ParticleBenchmark const &);
+	ParticleBenchmark &operator =(ParticleBenchmark const &);
+};
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,8 @@
+// ======================================================================
+//
+// FirstShaderCacheBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstShaderCacheBenchmark.h"
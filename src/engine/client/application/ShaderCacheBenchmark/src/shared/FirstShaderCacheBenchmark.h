@@ -0,0 +1,17 @@
+// ======================================================================
+//
+// FirstShaderCacheBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_FirstShaderCacheBenchmark_H
+#define INCLUDED_FirstShaderCacheBenchmark_H
+
+// ======================================================================
+
+#include "sharedFoundation/FirstSharedFoundation.h"
+
+// ======================================================================
+
+#endif
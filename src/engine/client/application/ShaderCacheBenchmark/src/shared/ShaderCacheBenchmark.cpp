@@ -0,0 +1,300 @@
+// ======================================================================
+//
+// ShaderCacheBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstShaderCacheBenchmark.h"
+#include "ShaderCacheBenchmark.h"
+
+#include "clientGraphics/SetupClientGraphics.h"
+#include "clientGraphics/ShaderCache.h"
+#include "clientGraphics/ShaderTemplate.h"
+#include "clientGraphics/ShaderTemplateList.h"
+#include "clientObject/SetupClientObject.h"
+#include "sharedCompression/SetupSharedCompression.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedDebug/SetupSharedDebug.h"
+#include "sharedFile/SetupSharedFile.h"
+#include "sharedFile/TreeFile.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/SetupSharedFoundation.h"
+#include "sharedImage/SetupSharedImage.h"
+#include "sharedMath/SetupSharedMath.h"
+#include "sharedMemoryManager/MemoryManager.h"
+#include "sharedObject/SetupSharedObject.h"
+#include "sharedRandom/SetupSharedRandom.h"
+#include "sharedThread/SetupSharedThread.h"
+#include "sharedUtility/SetupSharedUtility.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ======================================================================
+
+namespace ShaderCacheBenchmarkNamespace
+{
+	struct PassStatistics
+	{
+		float  elapsedTime;
+		int    allocationCount;
+		int    loadedCount;
+		int    hitCount;
+		int    missCount;
+	};
+
+	typedef std::vector<ShaderTemplate const *>  ShaderTemplateVector;
+	typedef std::vector<std::string>             StringVector;
+
+	char const *const cs_sectionName = "ShaderCacheBenchmark";
+
+	int  s_exitCode;
+
+	bool  loadShaderTemplateNames(StringVector &shaderTemplateNames);
+	void  runPass(StringVector const &shaderTemplateNames, PassStatistics &statistics);
+	void  printPass(char const *name, PassStatistics const &statistics);
+	void  runBenchmark();
+}
+
+using namespace ShaderCacheBenchmarkNamespace;
+
+// ======================================================================
+// namespace ShaderCacheBenchmarkNamespace
+// ======================================================================
+
+bool ShaderCacheBenchmarkNamespace::loadShaderTemplateNames(StringVector &shaderTemplateNames)
+{
+	for (int i = 0; ; ++i)
+	{
+		char const *const text = ConfigFile::getKeyString(cs_sectionName, "shaderTemplate", i, 0);
+		if (!text)
+			break;
+
+		if (!TreeFile::exists(text))
+		{
+			printf("ERROR: shader template %d is not in the tree file search path: [%s]\n", i, text);
+			return false;
+		}
+
+		shaderTemplateNames.push_back(text);
+	}
+
+	if (shaderTemplateNames.empty())
+	{
+		printf("ERROR: no [%s] shaderTemplate keys were specified.\n", cs_sectionName);
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Every shader template is fetched before any is released, so effects and
+ * implementations shared between them are only loaded once per pass.
+ */
+
+void ShaderCacheBenchmarkNamespace::runPass(StringVector const &shaderTemplateNames, PassStatistics &statistics)
+{
+	memset(&statistics, 0, sizeof(statistics));
+	ShaderCache::resetStatistics();
+
+	ShaderTemplateVector shaderTemplates;
+	shaderTemplates.reserve(shaderTemplateNames.size());
+
+	int const allocationCount = MemoryManager::getTotalNumberOfAllocations();
+
+	PerformanceTimer timer;
+	timer.start();
+
+	for (StringVector::const_iterator it = shaderTemplateNames.begin(); it != shaderTemplateNames.end(); ++it)
+		shaderTemplates.push_back(ShaderTemplateList::fetch(it->c_str()));
+
+	timer.stop();
+
+	statistics.elapsedTime     = timer.getElapsedTime();
+	statistics.allocationCount = MemoryManager::getTotalNumberOfAllocations() - allocationCount;
+	statistics.hitCount        = ShaderCache::getNumberOfHits();
+	statistics.missCount       = ShaderCache::getNumberOfMisses();
+
+	for (ShaderTemplateVector::const_iterator it = shaderTemplates.begin(); it != shaderTemplates.end(); ++it)
+		if (*it)
+		{
+			++statistics.loadedCount;
+			(*it)->release();
+		}
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderCacheBenchmarkNamespace::printPass(char const *const name, PassStatistics const &statistics)
+{
+	printf("%-8s %8d %10.3f %12d %8d %8d\n", name, statistics.loadedCount, statistics.elapsedTime * 1000.0f, statistics.allocationCount, statistics.hitCount, statistics.missCount);
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderCacheBenchmarkNamespace::runBenchmark()
+{
+	StringVector shaderTemplateNames;
+	if (!loadShaderTemplateNames(shaderTemplateNames))
+	{
+		s_exitCode = 1;
+		return;
+	}
+
+	bool const wasEnabled = ShaderCache::isEnabled();
+
+	//-- Read everything from the tree file.
+	ShaderCache::setEnabled(false);
+
+	PassStatistics tree;
+	runPass(shaderTemplateNames, tree);
+
+	//-- Start from an empty cache and record everything read.
+	ShaderCache::setEnabled(true);
+	ShaderCache::unload();
+
+	PassStatistics build;
+	runPass(shaderTemplateNames, build);
+
+	int const newRecordCount = ShaderCache::getNumberOfNewRecords();
+	if (!ShaderCache::save() || !ShaderCache::load())
+	{
+		printf("ERROR: the shader cache could not be written and read back.\n");
+		ShaderCache::setEnabled(wasEnabled);
+		s_exitCode = 1;
+		return;
+	}
+
+	float const loadTime = ShaderCache::getLoadTime();
+
+	//-- Read everything from the cache.
+	PassStatistics cached;
+	runPass(shaderTemplateNames, cached);
+
+	//-- Report.
+	printf("\n%d shader templates, %d cache records in %d KB, %d recorded.\n", static_cast<int>(shaderTemplateNames.size()), ShaderCache::getNumberOfRecords(), ShaderCache::getSize() / 1024, newRecordCount);
+	printf("%-8s %8s %10s %12s %8s %8s\n", "pass", "loaded", "ms", "allocations", "hits", "misses");
+	printPass("tree", tree);
+	printPass("build", build);
+	printPass("cached", cached);
+	printf("The cache file loaded in %.3f ms.\n", loadTime * 1000.0f);
+
+	if (cached.missCount > 0 || ShaderCache::getNumberOfStaleRecords() > 0)
+	{
+		printf("ERROR: the cached pass read %d files from the tree file, %d records were stale.\n", cached.missCount, ShaderCache::getNumberOfStaleRecords());
+		s_exitCode = 1;
+	}
+
+	if (cached.loadedCount != tree.loadedCount)
+	{
+		printf("ERROR: %d shader templates loaded from the cache, %d from the tree file.\n", cached.loadedCount, tree.loadedCount);
+		s_exitCode = 1;
+	}
+
+	ShaderCache::setEnabled(wasEnabled);
+}
+
+// ======================================================================
+
+int main(int argc, char **argv)
+{
+	//-- thread
+	SetupSharedThread::install();
+
+	//-- debug
+	SetupSharedDebug::install(4096);
+
+	//-- foundation
+	{
+		SetupSharedFoundation::Data data(SetupSharedFoundation::Data::D_console);
+		data.argc       = argc;
+		data.argv       = argv;
+		data.configFile = "shaderCacheBenchmark.cfg";
+		SetupSharedFoundation::install(data);
+	}
+
+	//-- file
+	SetupSharedCompression::install();
+	SetupSharedFile::install(false);
+
+	//-- math
+	SetupSharedMath::install();
+
+	//-- utility
+	{
+		SetupSharedUtility::Data data;
+		SetupSharedUtility::setupToolData(data);
+		SetupSharedUtility::install(data);
+	}
+
+	//-- random
+	SetupSharedRandom::install(0);
+
+	//-- image
+	{
+		SetupSharedImage::Data data;
+		SetupSharedImage::setupDefaultData(data);
+		SetupSharedImage::install(data);
+	}
+
+	//-- object
+	{
+		SetupSharedObject::Data data;
+		SetupSharedObject::setupDefaultConsoleData(data);
+		SetupSharedObject::install(data);
+	}
+
+	//-- graphics
+	SetupClientGraphics::Data graphicsData;
+	SetupClientGraphics::setupDefaultGameData(graphicsData);
+	graphicsData.screenWidth                       = 640;
+	graphicsData.screenHeight                      = 480;
+	graphicsData.windowed                          = true;
+	graphicsData.preloadVertexColorShaderTemplates = false;
+
+	if (SetupClientGraphics::install(graphicsData))
+	{
+		//-- object
+		{
+			SetupClientObject::Data data;
+			SetupClientObject::setupToolData(data);
+			SetupClientObject::install(data);
+		}
+
+		SetupSharedFoundation::callbackWithExceptionHandling(ShaderCacheBenchmark::run);
+	}
+	else
+	{
+		printf("ERROR: the graphics system could not be installed.\n");
+		s_exitCode = 1;
+	}
+
+	SetupSharedFoundation::remove();
+	SetupSharedThread::remove();
+
+	return ShaderCacheBenchmark::getExitCode();
+}
+
+// ======================================================================
+// class ShaderCacheBenchmark
+// ======================================================================
+
+void ShaderCacheBenchmark::run()
+{
+	printf("Shader cache benchmark " __DATE__ " " __TIME__ "\n");
+	runBenchmark();
+}
+
+// ----------------------------------------------------------------------
+
+int ShaderCacheBenchmark::getExitCode()
+{
+	return s_exitCode;
+}
+
+// ======================================================================
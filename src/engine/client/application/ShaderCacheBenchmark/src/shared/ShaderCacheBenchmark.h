@@ -0,0 +1,47 @@
+// ======================================================================
+//
+// ShaderCacheBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_ShaderCacheBenchmark_H
+#define INCLUDED_ShaderCacheBenchmark_H
+
+// ======================================================================
+/**
+ * Measures loading shader templates through the ShaderCache.
+ *
+ * The shader templates listed in the [ShaderCacheBenchmark] config section
+ * are fetched and released three times:
+ *
+ *   - tree:    the cache disabled, every file read from the tree file.
+ *   - build:   the cache enabled and empty, recording every file it reads,
+ *              after which the cache file is written and loaded.
+ *   - cached:  every file read from the cache.
+ *
+ * Each pass prints its time and the number of allocations it made, and the
+ * cached pass adds the time to load the cache file.  The benchmark fails
+ * if the cached pass has to read any file from the tree file.
+ *
+ * [ClientGraphics] shaderCacheFile names the cache file that is written.
+ */
+
+class ShaderCacheBenchmark
+{
+public:
+
+	static void run();
+	static int  getExitCode();
+
+private:
+
+	// disabled
+	ShaderCacheBenchmark();
+	ShaderCacheBenchmark(ShaderCacheBenchmark const &);
+	ShaderCacheBenchmark &operator =(ShaderCacheBenchmark const &);
+};
+
+// ======================================================================
+
+#endif
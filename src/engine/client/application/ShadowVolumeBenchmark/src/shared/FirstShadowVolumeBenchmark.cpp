@@ -0,0 +1,8 @@
+// ======================================================================
+//
+// FirstShadowVolumeBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstShadowVolumeBenchmark.h"
@@ -0,0 +1,17 @@
+// ======================================================================
+//
+// FirstShadowVolumeBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_FirstShadowVolumeBenchmark_H
+#define INCLUDED_FirstShadowVolumeBenchmark_H
+
+// ======================================================================
+
+#include "sharedFoundation/FirstSharedFoundation.h"
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,600 @@
+// ======================================================================
+//
+// ShadowVolumeBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstShadowVolumeBenchmark.h"
+#include "ShadowVolumeBenchmark.h"
+
+#include "clientGraphics/Graphics.h"
+#include "clientGraphics/SetupClientGraphics.h"
+#include "clientGraphics/StaticIndexBuffer.h"
+#include "clientGraphics/SystemVertexBuffer.h"
+#include "clientObject/ConfigClientObject.h"
+#include "clientObject/SetupClientObject.h"
+#include "clientObject/ShadowVolume.h"
+#include "sharedCompression/SetupSharedCompression.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedDebug/SetupSharedDebug.h"
+#include "sharedFile/SetupSharedFile.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/SetupSharedFoundation.h"
+#include "sharedImage/SetupSharedImage.h"
+#include "sharedMath/SetupSharedMath.h"
+#include "sharedMath/Vector.h"
+#include "sharedObject/SetupSharedObject.h"
+#include "sharedRandom/Random.h"
+#include "sharedRandom/SetupSharedRandom.h"
+#include "sharedThread/SetupSharedThread.h"
+#include "sharedUtility/SetupSharedUtility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// ======================================================================
+
+namespace ShadowVolumeBenchmarkNamespace
+{
+	enum Pass
+	{
+		P_scalar,
+		P_simd,
+		P_cached,
+		P_instanced,
+		P_instancedCached
+	};
+
+	//-- one placement of a caster, every instance of a caster shares its shadow volume
+	struct Instance
+	{
+		float  yawSine;
+		float  yawCosine;
+	};
+
+	struct Caster
+	{
+		ShadowVolume          *shadowVolume;
+		SystemVertexBuffer    *vertexBuffer;
+		StaticIndexBuffer     *indexBuffer;
+		std::vector<Vector>    restPositions;
+		std::vector<Instance>  instances;      // the first instance is the caster itself
+		float                  phase;
+	};
+
+	struct PassStatistics
+	{
+		int    frameCount;
+		float  elapsedTime;
+		int    rebuiltCount;
+		int    reusedCount;
+		int    edgeCount;
+	};
+
+	//-- the silhouettes of every shadow primitive of every caster for one frame
+	struct FrameSilhouettes
+	{
+		std::vector<int>  edgeCounts;   // one per shadow primitive, casters in order
+		std::vector<int>  edges;        // (edge index << 1) | inverted winding
+	};
+
+	typedef std::vector<Caster>            CasterVector;
+	typedef std::vector<FrameSilhouettes>  SilhouetteHistory;
+
+	char const *const cs_sectionName = "ShadowVolumeBenchmark";
+
+	// the sun stays at this elevation while it turns
+	float const cs_sunElevation      = convertDegreesToRadians(40.0f);
+	float const cs_frameTime         = 1.0f / 30.0f;
+	float const cs_wobbleAmplitude   = 0.08f;
+	float const cs_wobbleSpeed       = 4.0f;
+
+	int  s_exitCode;
+
+	void    createCaster(ShadowVolume::PrimitiveType primitiveType, int rings, int segments, int instanceCount, Caster &caster);
+	void    wobbleCaster(Caster &caster, float time);
+	void    destroyCaster(Caster &caster);
+	Vector  getDirectionToSun(int frame, float sunRadiansPerFrame);
+	Vector  rotateToObject(Instance const &instance, Vector const &direction_w);
+	void    collectSilhouettes(CasterVector const &casters, FrameSilhouettes &frameSilhouettes);
+	int     compareSilhouettes(SilhouetteHistory const &expected, SilhouetteHistory const &actual);
+	void    runPass(Pass pass, CasterVector &staticCasters, CasterVector &animatingCasters, float sunRadiansPerFrame, int frameCount, PassStatistics &statistics, SilhouetteHistory *silhouettes);
+	void    printPass(char const *name, PassStatistics const &statistics, PassStatistics const &baseline);
+	void    runBenchmark();
+}
+
+using namespace ShadowVolumeBenchmarkNamespace;
+
+// ======================================================================
+// namespace ShadowVolumeBenchmarkNamespace
+// ======================================================================
+/**
+ * Builds a lumpy sphere as a grid of rings and segments.  The seam and pole
+ * vertices are duplicated the way exported meshes duplicate them for their
+ * texture coordinates, so the shadow volume has to weld them back together.
+ * Each instance of the caster gets its own random yaw.
+ */
+
+void ShadowVolumeBenchmarkNamespace::createCaster(ShadowVolume::PrimitiveType const primitiveType, int const rings, int const segments, int const instanceCount, Caster &caster)
+{
+	int const numberOfVertices = (rings + 1) * (segments + 1);
+	int const numberOfIndices  = rings * segments * 6;
+
+	std::vector<float> lumps(static_cast<size_t>((rings + 1) * segments));
+	for (size_t i = 0; i < lumps.size(); ++i)
+		lumps[i] = Random::randomReal(0.85f, 1.15f);
+
+	caster.restPositions.clear();
+	caster.restPositions.reserve(static_cast<size_t>(numberOfVertices));
+
+	for (int ring = 0; ring <= rings; ++ring)
+	{
+		float const theta = PI * static_cast<float>(ring) / static_cast<float>(rings);
+
+		for (int segment = 0; segment <= segments; ++segment)
+		{
+			int const wrappedSegment = (ring == 0 || ring == rings) ? 0 : segment % segments;
+			float const phi = PI_TIMES_2 * static_cast<float>(wrappedSegment) / static_cast<float>(segments);
+			float const lump = lumps[static_cast<size_t>(ring * segments + wrappedSegment)];
+
+			Vector direction(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi));
+			if (ring == 0)
+				direction = Vector::unitY;
+			else if (ring == rings)
+				direction = Vector::negativeUnitY;
+
+			caster.restPositions.push_back(direction * lump);
+		}
+	}
+
+	VertexBufferFormat format;
+	format.setPosition();
+
+	caster.vertexBuffer = new SystemVertexBuffer(format, numberOfVertices);
+	caster.indexBuffer  = new StaticIndexBuffer(numberOfIndices);
+
+	{
+		VertexBufferWriteIterator v = caster.vertexBuffer->beginWriteOnly();
+		for (int i = 0; i < numberOfVertices; ++i, ++v)
+			v.setPosition(caster.restPositions[static_cast<size_t>(i)]);
+	}
+
+	caster.indexBuffer->lock();
+	{
+		Index *index = caster.indexBuffer->begin();
+
+		for (int ring = 0; ring < rings; ++ring)
+			for (int segment = 0; segment < segments; ++segment)
+			{
+				Index const a = static_cast<Index>(ring * (segments + 1) + segment);
+				Index const b = static_cast<Index>(a + 1);
+				Index const c = static_cast<Index>(a + segments + 1);
+				Index const d = static_cast<Index>(c + 1);
+
+				*index++ = a;
+				*index++ = c;
+				*index++ = b;
+
+				*index++ = b;
+				*index++ = c;
+				*index++ = d;
+			}
+	}
+	caster.indexBuffer->unlock();
+
+	caster.instances.resize(static_cast<size_t>(instanceCount));
+	for (size_t i = 0; i < caster.instances.size(); ++i)
+	{
+		float const yaw = Random::randomReal(0.0f, PI_TIMES_2);
+		caster.instances[i].yawSine   = sin(yaw);
+		caster.instances[i].yawCosine = cos(yaw);
+	}
+
+	caster.phase = Random::randomReal(0.0f, PI_TIMES_2);
+
+	caster.shadowVolume = new ShadowVolume(ShadowVolume::ST_vertexShader, primitiveType, primitiveType == ShadowVolume::PT_static ? "ShadowVolumeBenchmark static caster" : "ShadowVolumeBenchmark animating caster");
+	caster.shadowVolume->addPrimitive(caster.vertexBuffer, caster.indexBuffer);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Moves the vertices in and out the way a skinned mesh resubmits its
+ * geometry each frame.  The motion only depends on the time, so every pass
+ * sees the same shapes.
+ */
+
+void ShadowVolumeBenchmarkNamespace::wobbleCaster(Caster &caster, float const time)
+{
+	VertexBufferWriteIterator v = caster.vertexBuffer->beginWriteOnly();
+
+	for (size_t i = 0; i < caster.restPositions.size(); ++i, ++v)
+	{
+		Vector const &rest = caster.restPositions[i];
+		v.setPosition(rest * (1.0f + cs_wobbleAmplitude * sin(time * cs_wobbleSpeed + caster.phase + rest.y * 3.0f)));
+	}
+
+	caster.shadowVolume->addPrimitive(caster.vertexBuffer, caster.indexBuffer);
+}
+
+// ----------------------------------------------------------------------
+
+void ShadowVolumeBenchmarkNamespace::destroyCaster(Caster &caster)
+{
+	delete caster.shadowVolume;
+	caster.shadowVolume = 0;
+
+	delete caster.vertexBuffer;
+	caster.vertexBuffer = 0;
+
+	delete caster.indexBuffer;
+	caster.indexBuffer = 0;
+}
+
+// ----------------------------------------------------------------------
+
+Vector ShadowVolumeBenchmarkNamespace::getDirectionToSun(int const frame, float const sunRadiansPerFrame)
+{
+	float const azimuth = sunRadiansPerFrame * static_cast<float>(frame);
+	return Vector(cos(cs_sunElevation) * cos(azimuth), sin(cs_sunElevation), cos(cs_sunElevation) * sin(azimuth));
+}
+
+// ----------------------------------------------------------------------
+
+inline Vector ShadowVolumeBenchmarkNamespace::rotateToObject(Instance const &instance, Vector const &direction_w)
+{
+	return Vector(instance.yawCosine * direction_w.x - instance.yawSine * direction_w.z, direction_w.y, instance.yawSine * direction_w.x + instance.yawCosine * direction_w.z);
+}
+
+// ----------------------------------------------------------------------
+
+void ShadowVolumeBenchmarkNamespace::collectSilhouettes(CasterVector const &casters, FrameSilhouettes &frameSilhouettes)
+{
+	ShadowVolume::SilhouetteEdgeList silhouetteEdgeList;
+
+	for (size_t i = 0; i < casters.size(); ++i)
+	{
+		ShadowVolume const &shadowVolume = *casters[i].shadowVolume;
+
+		int const numberOfShadowPrimitives = shadowVolume.getNumberOfShadowPrimitives();
+		for (int j = 0; j < numberOfShadowPrimitives; ++j)
+		{
+			shadowVolume.getSilhouetteEdges(j, silhouetteEdgeList);
+
+			frameSilhouettes.edgeCounts.push_back(static_cast<int>(silhouetteEdgeList.size()));
+			frameSilhouettes.edges.insert(frameSilhouettes.edges.end(), silhouetteEdgeList.begin(), silhouetteEdgeList.end());
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Compares the silhouettes of two passes edge by edge, reporting the first
+ * difference.
+ *
+ * @return The number of frames that differ.
+ */
+
+int ShadowVolumeBenchmarkNamespace::compareSilhouettes(SilhouetteHistory const &expected, SilhouetteHistory const &actual)
+{
+	int mismatchCount = 0;
+
+	size_t const frameCount = std::min(expected.size(), actual.size());
+	for (size_t frame = 0; frame < frameCount; ++frame)
+	{
+		FrameSilhouettes const &expectedFrame = expected[frame];
+		FrameSilhouettes const &actualFrame   = actual[frame];
+
+		if (expectedFrame.edgeCounts == actualFrame.edgeCounts && expectedFrame.edges == actualFrame.edges)
+			continue;
+
+		if (mismatchCount == 0)
+		{
+			//-- find the first primitive that differs
+			int first = 0;
+			for (size_t primitive = 0; primitive < expectedFrame.edgeCounts.size() && primitive < actualFrame.edgeCounts.size(); ++primitive)
+			{
+				int const expectedCount = expectedFrame.edgeCounts[primitive];
+				int const actualCount   = actualFrame.edgeCounts[primitive];
+
+				std::vector<int>::const_iterator const expectedBegin = expectedFrame.edges.begin() + first;
+				std::vector<int>::const_iterator const actualBegin   = actualFrame.edges.begin() + first;
+
+				if (expectedCount != actualCount)
+				{
+					printf("ERROR: frame %d shadow primitive %d has %d silhouette edges in the simd pass, %d in the scalar pass.
+", static_cast<int>(frame), static_cast<int>(primitive), actualCount, expectedCount);
+					break;
+				}
+
+				std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator> const difference = std::mismatch(expectedBegin, expectedBegin + expectedCount, actualBegin);
+				if (difference.first != expectedBegin + expectedCount)
+				{
+					printf("ERROR: frame %d shadow primitive %d silhouette edge %d is edge %d%s in the simd pass, edge %d%s in the scalar pass.
+", static_cast<int>(frame), static_cast<int>(primitive), static_cast<int>(difference.first - expectedBegin), *difference.second >> 1, (*difference.second & 1) ? " inverted" : "", *difference.first >> 1, (*difference.first & 1) ? " inverted" : "");
+					break;
+				}
+
+				first += expectedCount;
+			}
+		}
+
+		++mismatchCount;
+	}
+
+	return mismatchCount;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Runs every caster through frameCount frames of a turning sun.  The
+ * instanced passes draw every instance of each static caster from its one
+ * shadow volume, the others only draw the caster itself.  When silhouettes
+ * is given, the edges of every frame are kept for comparing passes; they are
+ * gathered outside the timed part of the frame.
+ */
+
+void ShadowVolumeBenchmarkNamespace::runPass(Pass const pass, CasterVector &staticCasters, CasterVector &animatingCasters, float const sunRadiansPerFrame, int const frameCount, PassStatistics &statistics, SilhouetteHistory *const silhouettes)
+{
+	memset(&statistics, 0, sizeof(statistics));
+
+	if (silhouettes)
+	{
+		silhouettes->clear();
+		silhouettes->resize(static_cast<size_t>(frameCount));
+	}
+
+	ShadowVolume::setUseSimd(pass != P_scalar);
+	ShadowVolume::setSilhouetteCacheEnabled(pass == P_cached || pass == P_instancedCached);
+
+	bool const instanced = pass == P_instanced || pass == P_instancedCached;
+
+	//-- start the pass on a fresh frame so the counters only cover this pass
+	Graphics::update(cs_frameTime);
+	IGNORE_RETURN(ShadowVolume::getNumberOfVolumesRebuiltLastFrame());
+
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		Vector const directionToSun_w = getDirectionToSun(frame, sunRadiansPerFrame);
+		float const time = cs_frameTime * static_cast<float>(frame);
+
+		PerformanceTimer timer;
+		timer.start();
+
+		for (size_t i = 0; i < staticCasters.size(); ++i)
+		{
+			Caster const &caster = staticCasters[i];
+			size_t const instanceCount = instanced ? caster.instances.size() : 1;
+
+			for (size_t j = 0; j < instanceCount; ++j)
+				caster.shadowVolume->computeSilhouette(rotateToObject(caster.instances[j], directionToSun_w), &caster.instances[j]);
+		}
+
+		for (size_t i = 0; i < animatingCasters.size(); ++i)
+		{
+			wobbleCaster(animatingCasters[i], time);
+			animatingCasters[i].shadowVolume->computeSilhouette(rotateToObject(animatingCasters[i].instances[0], directionToSun_w), &animatingCasters[i].instances[0]);
+		}
+
+		timer.stop();
+		statistics.elapsedTime += timer.getElapsedTime();
+
+		if (silhouettes)
+		{
+			FrameSilhouettes &frameSilhouettes = (*silhouettes)[static_cast<size_t>(frame)];
+			collectSilhouettes(staticCasters, frameSilhouettes);
+			collectSilhouettes(animatingCasters, frameSilhouettes);
+		}
+
+		Graphics::update(cs_frameTime);
+
+		int const edgeCount = ShadowVolume::getNumberOfSilhouetteEdgesLastFrame();
+
+		statistics.rebuiltCount += ShadowVolume::getNumberOfVolumesRebuiltLastFrame();
+		statistics.reusedCount  += ShadowVolume::getNumberOfVolumesReusedLastFrame();
+		statistics.edgeCount    += edgeCount;
+		++statistics.frameCount;
+	}
+}
+
+// ----------------------------------------------------------------------
+
+void ShadowVolumeBenchmarkNamespace::printPass(char const *const name, PassStatistics const &statistics, PassStatistics const &baseline)
+{
+	int const frameCount = std::max(1, statistics.frameCount);
+	float const milliseconds = statistics.elapsedTime * 1000.0f / static_cast<float>(frameCount);
+	float const savedPerFrame = (baseline.elapsedTime - statistics.elapsedTime) * 1000.0f / static_cast<float>(frameCount);
+	int const volumeCount = statistics.rebuiltCount + statistics.reusedCount;
+	float const reuseRate = volumeCount > 0 ? 100.0f * static_cast<float>(statistics.reusedCount) / static_cast<float>(volumeCount) : 0.0f;
+
+	printf("%-10s %8d %10.3f %10d %10d %8.1f%% %10d %10.3f\n", name, statistics.frameCount, milliseconds, statistics.rebuiltCount / frameCount, statistics.reusedCount / frameCount, reuseRate, statistics.edgeCount / frameCount, savedPerFrame);
+}
+
+// ----------------------------------------------------------------------
+
+void ShadowVolumeBenchmarkNamespace::runBenchmark()
+{
+	int const   staticCasterCount    = std::max(0, ConfigFile::getKeyInt(cs_sectionName, "staticCasterCount", 256));
+	int const   animatingCasterCount = std::max(0, ConfigFile::getKeyInt(cs_sectionName, "animatingCasterCount", 32));
+	int const   rings                = clamp(2, ConfigFile::getKeyInt(cs_sectionName, "rings", 16), 64);
+	int const   segments             = clamp(3, ConfigFile::getKeyInt(cs_sectionName, "segments", 24), 64);
+	int const   instanceCount        = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "instanceCount", 8));
+	float const sunDegreesPerFrame   = ConfigFile::getKeyFloat(cs_sectionName, "sunDegreesPerFrame", 0.05f);
+	int const   frameCount           = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "frameCount", 600));
+
+	bool const wasUsingSimd = ShadowVolume::getUseSimd();
+	bool const wasCaching   = ShadowVolume::getSilhouetteCacheEnabled();
+
+	ShadowVolume::setUseSimd(true);
+	bool const simdAvailable = ShadowVolume::getUseSimd();
+
+	CasterVector staticCasters(static_cast<size_t>(staticCasterCount));
+	for (size_t i = 0; i < staticCasters.size(); ++i)
+		createCaster(ShadowVolume::PT_static, rings, segments, instanceCount, staticCasters[i]);
+
+	CasterVector animatingCasters(static_cast<size_t>(animatingCasterCount));
+	for (size_t i = 0; i < animatingCasters.size(); ++i)
+		createCaster(ShadowVolume::PT_animating, rings, segments, 1, animatingCasters[i]);
+
+	float const sunRadiansPerFrame = convertDegreesToRadians(sunDegreesPerFrame);
+
+	//-- the cached pass reuses silhouettes on purpose, so only the scalar and simd passes are compared
+	PassStatistics scalar;
+	SilhouetteHistory scalarSilhouettes;
+	runPass(P_scalar, staticCasters, animatingCasters, sunRadiansPerFrame, frameCount, scalar, simdAvailable ? &scalarSilhouettes : 0);
+
+	PassStatistics simd;
+	SilhouetteHistory simdSilhouettes;
+	if (simdAvailable)
+		runPass(P_simd, staticCasters, animatingCasters, sunRadiansPerFrame, frameCount, simd, &simdSilhouettes);
+
+	PassStatistics cached;
+	runPass(P_cached, staticCasters, animatingCasters, sunRadiansPerFrame, frameCount, cached, 0);
+
+	//-- the instances of a caster turn the sun differently in object space, so each has to keep its own silhouette
+	PassStatistics instanced;
+	runPass(P_instanced, staticCasters, animatingCasters, sunRadiansPerFrame, frameCount, instanced, 0);
+
+	PassStatistics instancedCached;
+	runPass(P_instancedCached, staticCasters, animatingCasters, sunRadiansPerFrame, frameCount, instancedCached, 0);
+
+	//-- Report.
+	printf("\n%d static and %d animating casters of %d faces, sun turning %1.3f degrees per frame, %1.2f degree silhouette angle, %d frames per pass.\n", staticCasterCount, animatingCasterCount, rings * segments * 2, sunDegreesPerFrame, ConfigClientObject::getShadowVolumeSilhouetteAngle(), frameCount);
+	printf("%-10s %8s %10s %10s %10s %9s %10s %10s\n", "pass", "frames", "ms/frm", "rebuilt", "reused", "reuse", "edges", "saved ms");
+	printPass("scalar", scalar, scalar);
+	if (simdAvailable)
+		printPass("simd", simd, scalar);
+	else
+		printf("%-10s the cpu has no SSE2, the SIMD pass was skipped.\n", "simd");
+	printPass("cached", cached, scalar);
+
+	printf("\n%d randomly rotated instances of each static caster, saved time against the uncached instances.\n", instanceCount);
+	printPass("instanced", instanced, instanced);
+	printPass("inst cache", instancedCached, instanced);
+
+	if (simdAvailable)
+	{
+		int const mismatchCount = compareSilhouettes(scalarSilhouettes, simdSilhouettes);
+
+		if (mismatchCount > 0)
+		{
+			printf("ERROR: %d of %d frames of the simd pass differ.\n", mismatchCount, static_cast<int>(scalarSilhouettes.size()));
+			s_exitCode = 1;
+		}
+		else
+			printf("The scalar and simd passes found the same silhouette edges and windings over %d frames.\n", frameCount);
+	}
+
+	//-- Clean up.
+	for (size_t i = 0; i < staticCasters.size(); ++i)
+		destroyCaster(staticCasters[i]);
+
+	for (size_t i = 0; i < animatingCasters.size(); ++i)
+		destroyCaster(animatingCasters[i]);
+
+	ShadowVolume::setUseSimd(wasUsingSimd);
+	ShadowVolume::setSilhouetteCacheEnabled(wasCaching);
+}
+
+// ======================================================================
+
+int main(int argc, char **argv)
+{
+	//-- thread
+	SetupSharedThread::install();
+
+	//-- debug
+	SetupSharedDebug::install(4096);
+
+	//-- foundation
+	{
+		SetupSharedFoundation::Data data(SetupSharedFoundation::Data::D_console);
+		data.argc       = argc;
+		data.argv       = argv;
+		data.configFile = "shadowVolumeBenchmark.cfg";
+		SetupSharedFoundation::install(data);
+	}
+
+	//-- file
+	SetupSharedCompression::install();
+	SetupSharedFile::install(false);
+
+	//-- math
+	SetupSharedMath::install();
+
+	//-- utility
+	{
+		SetupSharedUtility::Data data;
+		SetupSharedUtility::setupToolData(data);
+		SetupSharedUtility::install(data);
+	}
+
+	//-- random
+	SetupSharedRandom::install(0);
+
+	//-- image
+	{
+		SetupSharedImage::Data data;
+		SetupSharedImage::setupDefaultData(data);
+		SetupSharedImage::install(data);
+	}
+
+	//-- object
+	{
+		SetupSharedObject::Data data;
+		SetupSharedObject::setupDefaultConsoleData(data);
+		SetupSharedObject::install(data);
+	}
+
+	//-- graphics
+	SetupClientGraphics::Data graphicsData;
+	SetupClientGraphics::setupDefaultGameData(graphicsData);
+	graphicsData.screenWidth                       = 640;
+	graphicsData.screenHeight                      = 480;
+	graphicsData.windowed                          = true;
+	graphicsData.preloadVertexColorShaderTemplates = false;
+
+	if (SetupClientGraphics::install(graphicsData))
+	{
+		//-- object
+		{
+			SetupClientObject::Data data;
+			SetupClientObject::setupToolData(data);
+			SetupClientObject::install(data);
+		}
+
+		SetupSharedFoundation::callbackWithExceptionHandling(ShadowVolumeBenchmark::run);
+	}
+	else
+	{
+		printf("ERROR: the graphics system could not be installed.\n");
+		s_exitCode = 1;
+	}
+
+	SetupSharedFoundation::remove();
+	SetupSharedThread::remove();
+
+	return ShadowVolumeBenchmark::getExitCode();
+}
+
+// ======================================================================
+// class ShadowVolumeBenchmark
+// ======================================================================
+
+void ShadowVolumeBenchmark::run()
+{
+	printf("Shadow volume benchmark " __DATE__ " " __TIME__ "\n");
+	runBenchmark();
+}
+
+// ----------------------------------------------------------------------
+
+int ShadowVolumeBenchmark::getExitCode()
+{
+	return s_exitCode;
+}
+
+// ======================================================================
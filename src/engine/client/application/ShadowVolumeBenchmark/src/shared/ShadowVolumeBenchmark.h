@@ -0,0 +1,55 @@
+// ======================================================================
+//
+// ShadowVolumeBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_ShadowVolumeBenchmark_H
+#define INCLUDED_ShadowVolumeBenchmark_H
+
+// ======================================================================
+/**
+ * Measures finding shadow volume silhouettes for a scene of static and
+ * animating casters under a slowly moving sun, without drawing anything.
+ *
+ * staticCasterCount lumpy spheres are placed at random yaws and
+ * animatingCasterCount more wobble every frame, the way skinned meshes
+ * resubmit their geometry.  The sun turns sunDegreesPerFrame each frame
+ * for frameCount frames, and every caster has its silhouette found each
+ * frame in three passes:
+ *
+ *   - scalar:  silhouette cache and SIMD facing test disabled.
+ *   - simd:    silhouette cache disabled.
+ *   - cached:  static casters reuse their silhouette until the sun has
+ *              turned [ClientObject] shadowVolumeSilhouetteAngle degrees.
+ *
+ * Two more passes draw instanceCount instances of every static caster, each
+ * at its own random yaw and all sharing the caster's shadow volume, first
+ * with the silhouette cache disabled and then enabled, so each instance
+ * has to keep its own cached silhouette.
+ *
+ * Each pass prints its time per frame along with the volumes rebuilt,
+ * volumes reused, reuse rate and silhouette edges per frame from the
+ * ShadowVolume counters.  The benchmark fails if the scalar and SIMD passes find a
+ * different number of silhouette edges on any frame.
+ */
+
+class ShadowVolumeBenchmark
+{
+public:
+
+	static void run();
+	static int  getExitCode();
+
+private:
+
+	// disabled
+	ShadowVolumeBenchmark();
+	ShadowVolumeBenchmark(ShadowVolumeBenchmark const &);
+	ShadowVolumeBenchmark &operator =(ShadowVolumeBenchmark const &);
+};
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,8 @@
+// ======================================================================
+//
+// FirstSkeletalAnimationBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstSkeletalAnimationBenchmark.h"
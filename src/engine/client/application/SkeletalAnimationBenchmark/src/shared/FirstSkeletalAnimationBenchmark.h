@@ -0,0 +1,17 @@
+// ======================================================================
+//
+// FirstSkeletalAnimationBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_FirstSkeletalAnimationBenchmark_H
+#define INCLUDED_FirstSkeletalAnimationBenchmark_H
+
+// ======================================================================
+
+#include "sharedFoundation/FirstSharedFoundation.h"
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,647 @@
+// ======================================================================
+//
+// SkeletalAnimationBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstSkeletalAnimationBenchmark.h"
+#include "SkeletalAnimationBenchmark.h"
+
+#include "clientAnimation/SetupClientAnimation.h"
+#include "clientGraphics/Graphics.h"
+#include "clientGraphics/SetupClientGraphics.h"
+#include "clientObject/SetupClientObject.h"
+#include "clientSkeletalAnimation/AnimationUpdateScheduler.h"
+#include "clientSkeletalAnimation/PoseCache.h"
+#include "clientSkeletalAnimation/SetupClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/SkeletalAppearance2.h"
+#include "clientSkeletalAnimation/SkeletalAppearanceTemplate.h"
+#include "clientSkeletalAnimation/Skeleton.h"
+#include "clientSkeletalAnimation/TransformAnimationResolver.h"
+#include "sharedCompression/SetupSharedCompression.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedDebug/SetupSharedDebug.h"
+#include "sharedFile/SetupSharedFile.h"
+#include "sharedFile/TreeFile.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/CrcLowerString.h"
+#include "sharedFoundation/Os.h"
+#include "sharedFoundation/SetupSharedFoundation.h"
+#include "sharedImage/SetupSharedImage.h"
+#include "sharedMath/Quaternion.h"
+#include "sharedMath/SetupSharedMath.h"
+#include "sharedMath/Transform.h"
+#include "sharedMath/Vector.h"
+#include "sharedMemoryManager/MemoryManager.h"
+#include "sharedObject/AppearanceTemplateList.h"
+#include "sharedObject/Object.h"
+#include "sharedObject/SetupSharedObject.h"
+#include "sharedRandom/SetupSharedRandom.h"
+#include "sharedThread/SetupSharedThread.h"
+#include "sharedUtility/SetupSharedUtility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ======================================================================
+
+namespace SkeletalAnimationBenchmarkNamespace
+{
+	enum Stage
+	{
+		S_controller,
+		S_evaluation,
+		S_resolution,
+		S_hardpoints,
+		S_skinning,
+
+		S_count
+	};
+
+	struct StageStatistics
+	{
+		float          elapsedTime;
+		int            allocationCount;
+		unsigned long  allocatedByteCount;
+	};
+
+	struct CharacterDefinition
+	{
+		std::string               skeletonTemplateName;
+		std::string               latName;
+		std::vector<std::string>  meshGeneratorNames;
+	};
+
+	struct ScriptedAction
+	{
+		int          frameInterval;
+		std::string  actionName;
+	};
+
+	typedef std::vector<CharacterDefinition>          CharacterDefinitionVector;
+	typedef std::vector<ScriptedAction>               ScriptedActionVector;
+	typedef std::vector<CrcLowerString>               CrcLowerStringVector;
+	typedef std::vector<SkeletalAppearanceTemplate*>  SkeletalAppearanceTemplateVector;
+	typedef std::vector<Object*>                      ObjectVector;
+	typedef std::vector<std::string>                  StringVector;
+
+	class StageSample
+	{
+	public:
+
+		StageSample(StageStatistics &statistics, bool record);
+		~StageSample();
+
+	private:
+
+		// disabled
+		StageSample();
+		StageSample(StageSample const &);
+		StageSample &operator =(StageSample const &);
+
+	private:
+
+		StageStatistics     &m_statistics;
+		bool const           m_record;
+		int const            m_allocationCount;
+		unsigned long const  m_allocatedByteCount;
+		PerformanceTimer     m_timer;
+	};
+
+	char const *const cs_sectionName = "SkeletalAnimationBenchmark";
+	char const *const cs_stageNames[S_count] =
+	{
+		"controller",
+		"evaluation",
+		"resolution",
+		"hardpoints",
+		"skinning"
+	};
+
+	int  s_exitCode;
+
+	void  splitWords(char const *text, StringVector &words);
+	bool  loadCharacterDefinitions(CharacterDefinitionVector &definitions);
+	void  loadScriptedActions(ScriptedActionVector &actions);
+	void  loadHardpointNames(CrcLowerStringVector &hardpointNames);
+	SkeletalAppearanceTemplate *createAppearanceTemplate(CharacterDefinition const &definition);
+	bool  waitForCharacters(ObjectVector const &objects, int detailLevel, float timeout);
+	void  playScriptedActions(SkeletalAppearance2 &appearance, ScriptedActionVector const &actions, int frame, int characterIndex);
+	SkeletalAppearance2 *getSkeletalAppearance(Object *object);
+	void  runBenchmark();
+}
+
+using namespace SkeletalAnimationBenchmarkNamespace;
+
+// ======================================================================
+// class SkeletalAnimationBenchmarkNamespace::StageSample
+// ======================================================================
+
+SkeletalAnimationBenchmarkNamespace::StageSample::StageSample(StageStatistics &statistics, bool record) :
+	m_statistics(statistics),
+	m_record(record),
+	m_allocationCount(MemoryManager::getTotalNumberOfAllocations()),
+	m_allocatedByteCount(MemoryManager::getTotalNumberOfBytesAllocated()),
+	m_timer()
+{
+	m_timer.start();
+}
+
+// ----------------------------------------------------------------------
+
+SkeletalAnimationBenchmarkNamespace::StageSample::~StageSample()
+{
+	m_timer.stop();
+
+	if (m_record)
+	{
+		m_statistics.elapsedTime        += m_timer.getElapsedTime();
+		m_statistics.allocationCount    += MemoryManager::getTotalNumberOfAllocations() - m_allocationCount;
+		m_statistics.allocatedByteCount += MemoryManager::getTotalNumberOfBytesAllocated() - m_allocatedByteCount;
+	}
+}
+
+// ======================================================================
+// namespace SkeletalAnimationBenchmarkNamespace
+// ======================================================================
+
+void SkeletalAnimationBenchmarkNamespace::splitWords(char const *text, StringVector &words)
+{
+	words.clear();
+
+	std::string const line(text ? text : "");
+	std::string::size_type wordStart = line.find_first_not_of(" \t");
+	while (wordStart != std::string::npos)
+	{
+		std::string::size_type const wordEnd = line.find_first_of(" \t", wordStart);
+		words.push_back(line.substr(wordStart, (wordEnd == std::string::npos) ? std::string::npos : wordEnd - wordStart));
+		wordStart = line.find_first_not_of(" \t", wordEnd);
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Each character key lists a skeleton template, the LAT file that maps it
+ * to an animation state hierarchy ("-" for none) and one or more mesh
+ * generators.
+ */
+
+bool SkeletalAnimationBenchmarkNamespace::loadCharacterDefinitions(CharacterDefinitionVector &definitions)
+{
+	StringVector words;
+
+	for (int i = 0; ; ++i)
+	{
+		char const *const text = ConfigFile::getKeyString(cs_sectionName, "character", i, 0);
+		if (!text)
+			break;
+
+		splitWords(text, words);
+		if (words.size() < 3)
+		{
+			printf("ERROR: character %d needs a skeleton, a LAT file and at least one mesh: [%s]\n", i, text);
+			return false;
+		}
+
+		CharacterDefinition definition;
+		definition.skeletonTemplateName = words[0];
+		if (words[1] != "-")
+			definition.latName = words[1];
+		definition.meshGeneratorNames.assign(words.begin() + 2, words.end());
+
+		bool allFilesExist = TreeFile::exists(definition.skeletonTemplateName.c_str()) && (definition.latName.empty() || TreeFile::exists(definition.latName.c_str()));
+		for (StringVector::const_iterator it = definition.meshGeneratorNames.begin(); it != definition.meshGeneratorNames.end(); ++it)
+			allFilesExist = allFilesExist && TreeFile::exists(it->c_str());
+
+		if (!allFilesExist)
+		{
+			printf("ERROR: character %d references a file that is not in the tree file search path: [%s]\n", i, text);
+			return false;
+		}
+
+		definitions.push_back(definition);
+	}
+
+	if (definitions.empty())
+	{
+		printf("ERROR: no [%s] character keys were specified.\n", cs_sectionName);
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Each action key lists a frame interval and an action name.  Every
+ * character plays the action once per interval, staggered by character so
+ * the controllers do not all start blending on the same frame.
+ */
+
+void SkeletalAnimationBenchmarkNamespace::loadScriptedActions(ScriptedActionVector &actions)
+{
+	StringVector words;
+
+	for (int i = 0; ; ++i)
+	{
+		char const *const text = ConfigFile::getKeyString(cs_sectionName, "action", i, 0);
+		if (!text)
+			break;
+
+		splitWords(text, words);
+
+		ScriptedAction action;
+		action.frameInterval = (words.size() == 2) ? atoi(words[0].c_str()) : 0;
+		if (action.frameInterval <= 0)
+		{
+			printf("WARNING: ignoring action %d, expecting a positive frame interval and an action name: [%s]\n", i, text);
+			continue;
+		}
+
+		action.actionName = words[1];
+		actions.push_back(action);
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Each hardpoint key names a hardpoint every character looks up once per
+ * frame, the way attachments and effects query a loadout.
+ */
+
+void SkeletalAnimationBenchmarkNamespace::loadHardpointNames(CrcLowerStringVector &hardpointNames)
+{
+	for (int i = 0; ; ++i)
+	{
+		char const *const text = ConfigFile::getKeyString(cs_sectionName, "hardpoint", i, 0);
+		if (!text)
+			break;
+
+		hardpointNames.push_back(CrcLowerString(text));
+	}
+}
+
+// ----------------------------------------------------------------------
+
+SkeletalAppearanceTemplate *SkeletalAnimationBenchmarkNamespace::createAppearanceTemplate(CharacterDefinition const &definition)
+{
+	SkeletalAppearanceTemplate *const appearanceTemplate = new SkeletalAppearanceTemplate();
+	IGNORE_RETURN(AppearanceTemplateList::fetchNew(appearanceTemplate));
+
+	if (!definition.latName.empty())
+	{
+		appearanceTemplate->setSktToLatMapping(CrcLowerString(definition.skeletonTemplateName.c_str()), CrcLowerString(definition.latName.c_str()));
+		appearanceTemplate->setCreateAnimationController(true);
+	}
+
+	IGNORE_RETURN(appearanceTemplate->addSkeletonTemplate(definition.skeletonTemplateName.c_str(), ""));
+
+	for (StringVector::const_iterator it = definition.meshGeneratorNames.begin(); it != definition.meshGeneratorNames.end(); ++it)
+		IGNORE_RETURN(appearanceTemplate->addMeshGenerator(it->c_str()));
+
+	return appearanceTemplate;
+}
+
+// ----------------------------------------------------------------------
+
+SkeletalAppearance2 *SkeletalAnimationBenchmarkNamespace::getSkeletalAppearance(Object *object)
+{
+	NOT_NULL(object);
+	return NON_NULL(object->getAppearance())->asSkeletalAppearance2();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Mesh construction may happen on worker threads, so keep updating until
+ * every character has built the requested detail level.
+ */
+
+bool SkeletalAnimationBenchmarkNamespace::waitForCharacters(ObjectVector const &objects, int detailLevel, float timeout)
+{
+	PerformanceTimer timer;
+	timer.start();
+
+	for (;;)
+	{
+		int readyCount = 0;
+
+		for (ObjectVector::const_iterator it = objects.begin(); it != objects.end(); ++it)
+		{
+			SkeletalAppearance2 *const appearance = NON_NULL(getSkeletalAppearance(*it));
+			appearance->setDetailLevel(detailLevel);
+
+			int const wantedDetailLevel = std::min(detailLevel, appearance->getDetailLevelCount() - 1);
+			if ((appearance->getDisplayLodIndex() == wantedDetailLevel) && appearance->isDetailLevelAvailable(wantedDetailLevel) && appearance->rebuildIfDirtyAndAvailable())
+				++readyCount;
+		}
+
+		if (readyCount == static_cast<int>(objects.size()))
+			return true;
+
+		if (timer.getSplitTime() > timeout)
+		{
+			printf("ERROR: only %d of %d characters were built after %.1f seconds.\n", readyCount, static_cast<int>(objects.size()), timeout);
+			return false;
+		}
+
+		IGNORE_RETURN(Os::update());
+		Os::sleep(1);
+	}
+}
+
+// ----------------------------------------------------------------------
+
+void SkeletalAnimationBenchmarkNamespace::playScriptedActions(SkeletalAppearance2 &appearance, ScriptedActionVector const &actions, int frame, int characterIndex)
+{
+	for (ScriptedActionVector::const_iterator it = actions.begin(); it != actions.end(); ++it)
+	{
+		if (((frame + characterIndex) % it->frameInterval) != 0)
+			continue;
+
+		int  animationId    = 0;
+		bool animationIsAdd = false;
+
+		appearance.getAnimationResolver().playAction(CrcLowerString(it->actionName.c_str()), animationId, animationIsAdd, 0);
+	}
+}
+
+// ----------------------------------------------------------------------
+
+void SkeletalAnimationBenchmarkNamespace::runBenchmark()
+{
+	//-- Read the setup.
+	CharacterDefinitionVector definitions;
+	if (!loadCharacterDefinitions(definitions))
+	{
+		s_exitCode = 1;
+		return;
+	}
+
+	ScriptedActionVector actions;
+	loadScriptedActions(actions);
+
+	CrcLowerStringVector hardpointNames;
+	loadHardpointNames(hardpointNames);
+
+	int const   characterCount   = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "characterCount", 64));
+	int const   warmUpFrameCount = std::max(0, ConfigFile::getKeyInt(cs_sectionName, "warmUpFrameCount", 10));
+	int const   frameCount       = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "frameCount", 300));
+	float const frameTime        = 1.0f / std::max(1.0f, ConfigFile::getKeyFloat(cs_sectionName, "framesPerSecond", 30.0f));
+	int const   detailLevel      = std::max(0, ConfigFile::getKeyInt(cs_sectionName, "detailLevel", 0));
+	float const speed            = ConfigFile::getKeyFloat(cs_sectionName, "speed", 0.0f);
+	float const loadTimeout      = ConfigFile::getKeyFloat(cs_sectionName, "loadTimeout", 120.0f);
+
+	//-- The update scheduler would throttle characters that are never rendered, and the pose
+	//   cache would evaluate a single pose for identical characters.  Both are opt-in here.
+	AnimationUpdateScheduler::setEnabled(ConfigFile::getKeyBool(cs_sectionName, "updateSchedulerEnabled", false));
+	PoseCache::setEnabled(ConfigFile::getKeyBool(cs_sectionName, "poseCacheEnabled", false));
+
+	//-- Create the characters in a grid, cycling through the definitions.
+	SkeletalAppearanceTemplateVector appearanceTemplates;
+	for (CharacterDefinitionVector::const_iterator it = definitions.begin(); it != definitions.end(); ++it)
+		appearanceTemplates.push_back(createAppearanceTemplate(*it));
+
+	int const gridWidth = static_cast<int>(ceil(sqrt(static_cast<double>(characterCount))));
+
+	ObjectVector objects;
+	objects.reserve(static_cast<size_t>(characterCount));
+
+	for (int i = 0; i < characterCount; ++i)
+	{
+		SkeletalAppearance2 *const appearance = new SkeletalAppearance2(appearanceTemplates[static_cast<size_t>(i) % appearanceTemplates.size()]);
+		appearance->setUserControlledDetailLevel(true);
+		appearance->setDesiredVelocity(Vector(0.0f, 0.0f, speed));
+
+		Object *const object = new Object();
+		object->setAppearance(appearance);
+		object->setPosition_p(Vector(static_cast<float>(i % gridWidth) * 2.0f, 0.0f, static_cast<float>(i / gridWidth) * 2.0f));
+
+		objects.push_back(object);
+	}
+
+	if (waitForCharacters(objects, detailLevel, loadTimeout))
+	{
+		printf("%d characters, %d definitions, %d actions, %d hardpoints, detail level %d, %d frames at %.1f frames per second after %d warm-up frames.\n", characterCount, static_cast<int>(definitions.size()), static_cast<int>(actions.size()), static_cast<int>(hardpointNames.size()), detailLevel, frameCount, 1.0f / frameTime, warmUpFrameCount);
+
+		//-- Run the frames, one stage at a time across all characters.
+		StageStatistics stageStatistics[S_count];
+		memset(stageStatistics, 0, sizeof(stageStatistics));
+
+		int        skinnedPrimitiveCount = 0;
+		Quaternion rotation;
+		Vector     translation;
+		Transform  hardpointTransform;
+
+		for (int frame = 0; frame < warmUpFrameCount + frameCount; ++frame)
+		{
+			bool const record = (frame >= warmUpFrameCount);
+
+			IGNORE_RETURN(Os::update());
+			Graphics::update(frameTime);
+
+			{
+				StageSample const sample(stageStatistics[S_controller], record);
+
+				for (int i = 0; i < characterCount; ++i)
+				{
+					SkeletalAppearance2 *const appearance = getSkeletalAppearance(objects[static_cast<size_t>(i)]);
+					playScriptedActions(*appearance, actions, frame, i);
+					IGNORE_RETURN(appearance->alter(frameTime));
+				}
+			}
+
+			{
+				StageSample const sample(stageStatistics[S_evaluation], record);
+
+				for (int i = 0; i < characterCount; ++i)
+				{
+					TransformAnimationResolver const &resolver = getSkeletalAppearance(objects[static_cast<size_t>(i)])->getAnimationResolver();
+
+					int const transformCount = resolver.getTransformCount();
+					for (int transformIndex = 0; transformIndex < transformCount; ++transformIndex)
+						resolver.getTransformComponents(transformIndex, rotation, translation);
+				}
+			}
+
+			{
+				StageSample const sample(stageStatistics[S_resolution], record);
+
+				for (int i = 0; i < characterCount; ++i)
+				{
+					Skeleton const *const skeleton = getSkeletalAppearance(objects[static_cast<size_t>(i)])->getDisplayLodSkeleton();
+					if (skeleton)
+						IGNORE_RETURN(skeleton->getBindPoseModelToRootTransforms());
+				}
+			}
+
+			{
+				StageSample const sample(stageStatistics[S_hardpoints], record);
+
+				for (int i = 0; i < characterCount; ++i)
+				{
+					SkeletalAppearance2 const *const appearance = getSkeletalAppearance(objects[static_cast<size_t>(i)]);
+
+					for (CrcLowerStringVector::const_iterator it = hardpointNames.begin(); it != hardpointNames.end(); ++it)
+						IGNORE_RETURN(appearance->findHardpoint(*it, hardpointTransform));
+				}
+			}
+
+			{
+				StageSample const sample(stageStatistics[S_skinning], record);
+
+				for (int i = 0; i < characterCount; ++i)
+				{
+					int const primitiveCount = getSkeletalAppearance(objects[static_cast<size_t>(i)])->prepareDisplayLodToDraw();
+					if (record)
+						skinnedPrimitiveCount += primitiveCount;
+				}
+			}
+		}
+
+		//-- Report.
+		float const characterFrameCount = static_cast<float>(characterCount * frameCount);
+
+		printf("%-12s %12s %12s %16s %14s %14s\n", "stage", "total ms", "ms/frame", "us/character", "allocs/frame", "bytes/frame");
+
+		StageStatistics total;
+		memset(&total, 0, sizeof(total));
+
+		for (int stage = 0; stage < S_count; ++stage)
+		{
+			StageStatistics const &statistics = stageStatistics[stage];
+			printf("%-12s %12.3f %12.4f %16.3f %14.1f %14.1f\n", cs_stageNames[stage], statistics.elapsedTime * 1000.0f, statistics.elapsedTime * 1000.0f / static_cast<float>(frameCount), statistics.elapsedTime * 1000000.0f / characterFrameCount, static_cast<float>(statistics.allocationCount) / static_cast<float>(frameCount), static_cast<float>(statistics.allocatedByteCount) / static_cast<float>(frameCount));
+
+			total.elapsedTime        += statistics.elapsedTime;
+			total.allocationCount    += statistics.allocationCount;
+			total.allocatedByteCount += statistics.allocatedByteCount;
+		}
+
+		printf("%-12s %12.3f %12.4f %16.3f %14.1f %14.1f\n", "total", total.elapsedTime * 1000.0f, total.elapsedTime * 1000.0f / static_cast<float>(frameCount), total.elapsedTime * 1000000.0f / characterFrameCount, static_cast<float>(total.allocationCount) / static_cast<float>(frameCount), static_cast<float>(total.allocatedByteCount) / static_cast<float>(frameCount));
+		printf("%.1f shader primitives skinned per frame.\n", static_cast<float>(skinnedPrimitiveCount) / static_cast<float>(frameCount));
+	}
+	else
+		s_exitCode = 1;
+
+	//-- Clean up.
+	for (ObjectVector::iterator it = objects.begin(); it != objects.end(); ++it)
+		delete *it;
+
+	for (SkeletalAppearanceTemplateVector::iterator it = appearanceTemplates.begin(); it != appearanceTemplates.end(); ++it)
+		AppearanceTemplateList::release(*it);
+}
+
+// ======================================================================
+
+int main(int argc, char **argv)
+{
+	//-- thread
+	SetupSharedThread::install();
+
+	//-- debug
+	SetupSharedDebug::install(4096);
+
+	//-- foundation
+	{
+		SetupSharedFoundation::Data data(SetupSharedFoundation::Data::D_console);
+		data.argc       = argc;
+		data.argv       = argv;
+		data.configFile = "skeletalAnimationBenchmark.cfg";
+		SetupSharedFoundation::install(data);
+	}
+
+	//-- file
+	SetupSharedCompression::install();
+	SetupSharedFile::install(false);
+
+	//-- math
+	SetupSharedMath::install();
+
+	//-- utility
+	{
+		SetupSharedUtility::Data data;
+		SetupSharedUtility::setupToolData(data);
+		SetupSharedUtility::install(data);
+	}
+
+	//-- random
+	SetupSharedRandom::install(0);
+
+	//-- image
+	{
+		SetupSharedImage::Data data;
+		SetupSharedImage::setupDefaultData(data);
+		SetupSharedImage::install(data);
+	}
+
+	//-- object
+	{
+		SetupSharedObject::Data data;
+		SetupSharedObject::setupDefaultConsoleData(data);
+		SetupSharedObject::addCustomizationSupportData(data);
+		SetupSharedObject::install(data);
+	}
+
+	//-- graphics
+	SetupClientGraphics::Data graphicsData;
+	SetupClientGraphics::setupDefaultGameData(graphicsData);
+	graphicsData.screenWidth                       = 640;
+	graphicsData.screenHeight                      = 480;
+	graphicsData.windowed                          = true;
+	graphicsData.preloadVertexColorShaderTemplates = false;
+
+	if (SetupClientGraphics::install(graphicsData))
+	{
+		//-- object
+		{
+			SetupClientObject::Data data;
+			SetupClientObject::setupToolData(data);
+			SetupClientObject::install(data);
+		}
+
+		//-- animation and skeletal animation
+		SetupClientAnimation::install();
+
+		{
+			SetupClientSkeletalAnimation::Data data;
+			SetupClientSkeletalAnimation::setupGameData(data);
+			SetupClientSkeletalAnimation::install(data);
+		}
+
+		SetupSharedFoundation::callbackWithExceptionHandling(SkeletalAnimationBenchmark::run);
+	}
+	else
+	{
+		printf("ERROR: the graphics system could not be installed.\n");
+		s_exitCode = 1;
+	}
+
+	SetupSharedFoundation::remove();
+	SetupSharedThread::remove();
+
+	return SkeletalAnimationBenchmark::getExitCode();
+}
+
+// ======================================================================
+// class SkeletalAnimationBenchmark
+// ======================================================================
+
+void SkeletalAnimationBenchmark::run()
+{
+	printf("Skeletal animation benchmark " __DATE__ " " __TIME__ "\n");
+	runBenchmark();
+}
+
+// ----------------------------------------------------------------------
+
+int SkeletalAnimationBenchmark::getExitCode()
+{
+	return s_exitCode;
+}
+
+// ======================================================================
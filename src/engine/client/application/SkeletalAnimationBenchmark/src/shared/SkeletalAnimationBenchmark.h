@@ -0,0 +1,48 @@
+// ======================================================================
+//
+// SkeletalAnimationBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_SkeletalAnimationBenchmark_H
+#define INCLUDED_SkeletalAnimationBenchmark_H
+
+// ======================================================================
+/**
+ * Measures the CPU cost of animating and skinning characters.
+ *
+ * Characters are built from the skeletons, LAT files and meshes listed in
+ * the [SkeletalAnimationBenchmark] config section, driven by scripted
+ * actions for a fixed number of frames, and skinned into dynamic vertex
+ * buffers.  The time and allocations spent in each stage are printed when
+ * the run finishes:
+ *
+ *   - controller:  advancing the animation controllers.
+ *   - evaluation:  evaluating the animated transform components.
+ *   - resolution:  composing the joint and bind pose transforms.
+ *   - hardpoints:  looking up the hardpoints named by the hardpoint keys.
+ *   - skinning:    skinning the display detail level meshes.
+ *
+ * No GPU is needed when [ClientGraphics] rasterMajor selects the Headless
+ * rasterizer DLL, which only keeps vertex and index buffers in memory.
+ */
+
+class SkeletalAnimationBenchmark
+{
+public:
+
+	static void run();
+	static int  getExitCode();
+
+private:
+
+	// disabled
+	SkeletalAnimationBenchmark();
+	SkeletalAnimationBenchmark(SkeletalAnimationBenchmark const &);
+	SkeletalAnimationBenchmark &operator =(SkeletalAnimationBenchmark const &);
+};
+
+// ======================================================================
+
+#endif
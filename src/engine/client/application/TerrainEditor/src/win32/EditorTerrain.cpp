@@ -1390,6 +1390,37 @@ void EditorTerrain::markDirty ()
 		i->second->setDirty (true);
 }
 
+//-------------------------------------------------------------------
+//
+// marks only the chunks touched by extent (see TerrainDirtyRegion) and returns how many were marked
+//
+int EditorTerrain::markDirty (const Rectangle2d& extent)
+{
+	NOT_NULL (mapView);
+
+	//-- chunks sample poles beyond their own edges for normals
+	const real pad = static_cast<real> (upperPad) * distanceBetweenPoles_w / mapView->getZoomLevel ();
+
+	Rectangle2d paddedExtent (extent);
+	paddedExtent.x0 -= pad;
+	paddedExtent.y0 -= pad;
+	paddedExtent.x1 += pad;
+	paddedExtent.y1 += pad;
+
+	int numberOfDirtyChunks = 0;
+
+	for (ChunkMap::iterator i = m_chunkMap->begin (); i != m_chunkMap->end (); ++i)
+	{
+		if (i->second->getExtent ().intersects (paddedExtent))
+		{
+			i->second->setDirty (true);
+			++numberOfDirtyChunks;
+		}
+	}
+
+	return numberOfDirtyChunks;
+}
+
 //-------------------------------------------------------------------
 
 bool EditorTerrain::getDataAt (const Vector2d& position, EditorTerrain::Data& data, bool heightOnly) const
@@ -84,6 +84,7 @@ public:
 
 	void clearChunks ();
 	void markDirty ();
+	int  markDirty (const Rectangle2d& extent);
 
 	void showProfile (bool newShowProfile);
 
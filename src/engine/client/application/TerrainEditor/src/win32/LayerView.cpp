@@ -25,6 +25,7 @@
 #include "sharedTerrain/Affector.h"
 #include "sharedTerrain/Boundary.h"
 #include "sharedTerrain/Filter.h"
+#include "sharedTerrain/TerrainDirtyRegion.h"
 #include "sharedTerrain/TerrainGeneratorLoader.h"
 
 //-------------------------------------------------------------------
@@ -1511,6 +1512,10 @@ void LayerView::OnButtonApply()
 	if (!verify ())
 		return;
 
+	//-- find out which part of the map the changes touch
+	NOT_NULL (doc->getDirtyRegion ());
+	IGNORE_RETURN (doc->getDirtyRegion ()->update (*doc->getTerrainGenerator ()));
+
 	//-- tell document to update views
 	doc->UpdateAllViews (this, TerrainEditorDoc::H_layerViewApply);
 	doc->SetModifiedFlag ();
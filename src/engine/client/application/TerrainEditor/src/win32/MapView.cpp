@@ -22,6 +22,7 @@
 #include "clientObject/ObjectListCamera.h"
 #include "clientGraphics/ShaderTemplateList.h"
 #include "TerrainEditorDoc.h"
+#include "sharedTerrain/TerrainDirtyRegion.h"
 #include "TerrainGeneratorHelper.h"
 #include "sharedDebug/Profiler.h"
 
@@ -1599,9 +1600,19 @@ void MapView::OnUpdate(CView* pSender, LPARAM lHint, CObject* pHint)
 
 	if (lHint == TerrainEditorDoc::H_layerViewApply)
 	{
-		//-- mark all chunks as dirty
+		//-- mark the chunks touched by the edit as dirty
 		if (terrain)
-			terrain->markDirty ();
+		{
+			const TerrainEditorDoc* const doc = static_cast<TerrainEditorDoc*> (GetDocument ());
+			NOT_NULL (doc);
+
+			const TerrainDirtyRegion* const dirtyRegion = doc->getDirtyRegion ();
+
+			if (!dirtyRegion || dirtyRegion->isEntireMap ())
+				terrain->markDirty ();
+			else if (!dirtyRegion->isEmpty ())
+				IGNORE_RETURN (terrain->markDirty (dirtyRegion->getExtent ()));
+		}
 
 		OnRebuild ();
 	}
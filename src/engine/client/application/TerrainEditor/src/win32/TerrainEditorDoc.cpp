@@ -66,6 +66,7 @@
 #include "sharedTerrain/Filter.h"
 #include "sharedTerrain/ProceduralTerrainAppearanceTemplate.h"
 #include "sharedTerrain/SamplerProceduralTerrainAppearanceTemplate.h"
+#include "sharedTerrain/TerrainDirtyRegion.h"
 #include "sharedTerrain/TerrainGeneratorLoader.h"
 #include "sharedTerrain/TerrainGeneratorType.def"
 #include "sharedUtility/BakedTerrain.h"
@@ -275,6 +276,7 @@ TerrainEditorDoc::TerrainEditorDoc() :
         lastMinimumChunkGenerationTime (0),
         lastMaximumChunkGenerationTime (0),
         m_bakedTerrain(0),
+        m_dirtyRegion(0),
         m_staticCollidableFloraMap(0),
         m_staticCollidableFloraHeightMap(0),
         m_guidanceOverlayEnabled(false),
@@ -288,6 +290,9 @@ TerrainEditorDoc::TerrainEditorDoc() :
 
 	//-- create baked terrain
 	m_bakedTerrain = new BakedTerrain ();
+
+	//-- tracks which part of the map an apply needs to regenerate
+	m_dirtyRegion = new TerrainDirtyRegion ();
 }
 
 //-------------------------------------------------------------------
@@ -306,6 +311,12 @@ TerrainEditorDoc::~TerrainEditorDoc()
 		m_bakedTerrain = 0;
 	}
 
+	if (m_dirtyRegion)
+	{
+		delete m_dirtyRegion;
+		m_dirtyRegion = 0;
+	}
+
 	if (m_staticCollidableFloraMap)
 	{
 		delete m_staticCollidableFloraMap;
@@ -364,6 +375,9 @@ BOOL TerrainEditorDoc::OnNewDocument()
         NOT_NULL (terrainGenerator);
         terrainGenerator->reset ();
 
+        NOT_NULL (m_dirtyRegion);
+        m_dirtyRegion->reset ();
+
         TerrainAutoPainter::Config autoConfig;
         autoConfig.seed = static_cast<int>(Os::getRealSystemTime() & 0x7fffffff);
         autoConfig.gridSize = 257;
@@ -580,6 +594,9 @@ void TerrainEditorDoc::_load(Iff& iff, Tag version)
 		NOT_NULL (terrainGenerator);
 		terrainGenerator->load (iff);
 
+		NOT_NULL (m_dirtyRegion);
+		m_dirtyRegion->snapshot (*terrainGenerator);
+
 		NOT_NULL (m_bakedTerrain);
 		m_bakedTerrain->load (iff);
 
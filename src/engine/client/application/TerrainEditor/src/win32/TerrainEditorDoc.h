@@ -45,6 +45,7 @@ class PackedIntegerMap;
 class PackedFixedPointMap;
 class GuidedCreationFrame;
 class TerrainAutoPainter;
+class TerrainDirtyRegion;
 
 //-------------------------------------------------------------------
 
@@ -205,6 +206,7 @@ private:
 	real                    lastMaximumChunkGenerationTime;
 
         BakedTerrain*           m_bakedTerrain;
+        TerrainDirtyRegion*     m_dirtyRegion;
 
         PackedIntegerMap       *m_staticCollidableFloraMap;
         PackedFixedPointMap    *m_staticCollidableFloraHeightMap;
@@ -412,6 +414,9 @@ public:
 	BakedTerrain*           getBakedTerrain ();
 	const BakedTerrain*     getBakedTerrain () const;
 
+	TerrainDirtyRegion*       getDirtyRegion ();
+	const TerrainDirtyRegion* getDirtyRegion () const;
+
         real                    getDefaultShaderSize (void) const;
         int                     getEnvironmentCycleTime () const;
 
@@ -1024,6 +1029,20 @@ inline const BakedTerrain* TerrainEditorDoc::getBakedTerrain () const
 
 //-------------------------------------------------------------------
 
+inline TerrainDirtyRegion* TerrainEditorDoc::getDirtyRegion ()
+{
+	return m_dirtyRegion;
+}
+
+//-------------------------------------------------------------------
+
+inline const TerrainDirtyRegion* TerrainEditorDoc::getDirtyRegion () const
+{
+	return m_dirtyRegion;
+}
+
+//-------------------------------------------------------------------
+
 //{{AFX_INSERT_LOCATION}}
 
 //-------------------------------------------------------------------
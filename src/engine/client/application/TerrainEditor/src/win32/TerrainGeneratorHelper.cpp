@@ -21,12 +21,15 @@
 #include "sharedTerrain/AffectorRoad.h"
 #include "sharedTerrain/Boundary.h"
 #include "sharedTerrain/Filter.h"
+#include "sharedTerrain/TerrainGeneratorProfiler.h"
 #include "sharedUtility/FileName.h"
 #include "sharedFile/Iff.h"
 #include "sharedFile/TreeFile.h"
 #include "TerrainEditorDoc.h"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 //-------------------------------------------------------------------
 
@@ -1761,6 +1764,47 @@ void TerrainGeneratorHelper::profile (const TerrainGenerator* generator, real to
 		buffer->Format ("maximum chunk time = %1.3f seconds", maximumChunkGenerationTime);
 		output.add (TerrainGeneratorHelper::OutputData (TerrainGeneratorHelper::OutputData::M_console, TerrainGeneratorHelper::OutputData::T_info, buffer, 0));
 	}
+
+	//-- per item times are only collected while the profiler is on, so the first request turns it on
+	if (!TerrainGeneratorProfiler::isEnabled ())
+	{
+		TerrainGeneratorProfiler::setEnabled (true);
+
+		CString* buffer = new CString;
+		buffer->Format ("layer item profiling enabled, regenerate the terrain and show the profile again for per item times");
+		output.add (TerrainGeneratorHelper::OutputData (TerrainGeneratorHelper::OutputData::M_console, TerrainGeneratorHelper::OutputData::T_info, buffer, 0));
+
+		return;
+	}
+
+	//-- most expensive layer items
+	{
+		TerrainGeneratorProfiler::RecordList recordList;
+		TerrainGeneratorProfiler::getRecords (recordList);
+
+		const int numberOfRecords = std::min (10, static_cast<int> (recordList.size ()));
+		for (int i = 0; i < numberOfRecords; ++i)
+		{
+			const TerrainGeneratorProfiler::Record& record = recordList [static_cast<size_t> (i)];
+
+			CString* buffer = new CString;
+			buffer->Format ("%1.3f seconds, %i poles: %s '%s' in '%s'", record.time, record.numberOfPoles, record.type, record.name.c_str (), record.layerName.c_str ());
+			output.add (TerrainGeneratorHelper::OutputData (TerrainGeneratorHelper::OutputData::M_console, TerrainGeneratorHelper::OutputData::T_info, buffer, 0));
+		}
+	}
+
+	//-- full report
+	{
+		const char* const fileName = "terrainGeneratorProfile.json";
+
+		CString* buffer = new CString;
+		if (TerrainGeneratorProfiler::writeReport (fileName))
+			buffer->Format ("profile report written to %s", fileName);
+		else
+			buffer->Format ("could not write profile report to %s", fileName);
+
+		output.add (TerrainGeneratorHelper::OutputData (TerrainGeneratorHelper::OutputData::M_console, TerrainGeneratorHelper::OutputData::T_info, buffer, 0));
+	}
 }
 
 //-------------------------------------------------------------------
@@ -0,0 +1,8 @@
+// ======================================================================
+//
+// FirstTextureStreamingBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstTextureStreamingBenchmark.h"
@@ -0,0 +1,17 @@
+// ======================================================================
+//
+// FirstTextureStreamingBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_FirstTextureStreamingBenchmark_H
+#define INCLUDED_FirstTextureStreamingBenchmark_H
+
+// ======================================================================
+
+#include "sharedFoundation/FirstSharedFoundation.h"
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,390 @@
+// ======================================================================
+//
+// TextureStreamingBenchmark.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "FirstTextureStreamingBenchmark.h"
+#include "TextureStreamingBenchmark.h"
+
+#include "clientGraphics/Graphics.h"
+#include "clientGraphics/SetupClientGraphics.h"
+#include "clientGraphics/TextureStreamer.h"
+#include "clientObject/ObjectListCamera.h"
+#include "clientObject/SetupClientObject.h"
+#include "sharedCompression/SetupSharedCompression.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedDebug/SetupSharedDebug.h"
+#include "sharedFile/SetupSharedFile.h"
+#include "sharedFile/TreeFile.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/Os.h"
+#include "sharedFoundation/SetupSharedFoundation.h"
+#include "sharedImage/SetupSharedImage.h"
+#include "sharedMath/SetupSharedMath.h"
+#include "sharedMath/Vector.h"
+#include "sharedObject/AppearanceTemplateList.h"
+#include "sharedObject/Object.h"
+#include "sharedObject/ObjectList.h"
+#include "sharedObject/SetupSharedObject.h"
+#include "sharedRandom/SetupSharedRandom.h"
+#include "sharedThread/SetupSharedThread.h"
+#include "sharedUtility/SetupSharedUtility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ======================================================================
+
+namespace TextureStreamingBenchmarkNamespace
+{
+	struct PhaseStatistics
+	{
+		int    frameCount;
+		bool   sharp;
+		float  elapsedTime;
+		int    uploadedByteCount;
+		int    peakUploadedByteCount;
+		int    residentMemory;
+		int    peakResidentMemory;
+		int    targetMemory;
+	};
+
+	typedef std::vector<Object*>      ObjectVector;
+	typedef std::vector<std::string>  StringVector;
+
+	char const *const cs_sectionName = "TextureStreamingBenchmark";
+
+	int  s_exitCode;
+
+	bool  loadAppearanceNames(StringVector &appearanceNames);
+	bool  createObjects(StringVector const &appearanceNames, int objectCount, float spacing, ObjectVector &objects);
+	void  lookAt(ObjectListCamera &camera, Vector const &center, float gridSize);
+	void  runPhase(ObjectListCamera &camera, bool waitForSharp, int frameCount, float frameTime, PhaseStatistics &statistics);
+	void  printPhase(char const *name, PhaseStatistics const &statistics);
+	void  runBenchmark();
+}
+
+using namespace TextureStreamingBenchmarkNamespace;
+
+// ======================================================================
+// namespace TextureStreamingBenchmarkNamespace
+// ======================================================================
+
+bool TextureStreamingBenchmarkNamespace::loadAppearanceNames(StringVector &appearanceNames)
+{
+	for (int i = 0; ; ++i)
+	{
+		char const *const text = ConfigFile::getKeyString(cs_sectionName, "appearance", i, 0);
+		if (!text)
+			break;
+
+		if (!TreeFile::exists(text))
+		{
+			printf("ERROR: appearance %d is not in the tree file search path: [%s]\n", i, text);
+			return false;
+		}
+
+		appearanceNames.push_back(text);
+	}
+
+	if (appearanceNames.empty())
+	{
+		printf("ERROR: no [%s] appearance keys were specified.\n", cs_sectionName);
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * The objects are laid out in a grid on the x-z plane centered on the
+ * origin, cycling through the appearance names.
+ */
+
+bool TextureStreamingBenchmarkNamespace::createObjects(StringVector const &appearanceNames, int objectCount, float spacing, ObjectVector &objects)
+{
+	int const gridWidth = static_cast<int>(ceil(sqrt(static_cast<double>(objectCount))));
+	float const gridOffset = static_cast<float>(gridWidth - 1) * spacing * 0.5f;
+
+	for (int i = 0; i < objectCount; ++i)
+	{
+		std::string const &appearanceName = appearanceNames[static_cast<size_t>(i) % appearanceNames.size()];
+
+		Appearance *const appearance = AppearanceTemplateList::createAppearance(appearanceName.c_str());
+		if (!appearance)
+		{
+			printf("ERROR: [%s] could not be created.\n", appearanceName.c_str());
+			return false;
+		}
+
+		Object *const object = new Object();
+		object->setAppearance(appearance);
+		object->setPosition_p(Vector(static_cast<float>(i % gridWidth) * spacing - gridOffset, 0.0f, static_cast<float>(i / gridWidth) * spacing - gridOffset));
+
+		objects.push_back(object);
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+void TextureStreamingBenchmarkNamespace::lookAt(ObjectListCamera &camera, Vector const &center, float const gridSize)
+{
+	camera.resetRotate_o2p();
+	camera.setPosition_p(center + Vector(0.0f, gridSize * 0.5f, -gridSize));
+	camera.pitch_o(PI_OVER_4 * 0.5f);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Draw frames until the streamer reports every texture sharp, or for a
+ * fixed number of frames.
+ *
+ * The streamer updates at the start of Graphics::update() with the screen
+ * sizes of the previous frame, so the first frame after a camera move
+ * still describes the old view and is never counted as sharp.
+ */
+
+void TextureStreamingBenchmarkNamespace::runPhase(ObjectListCamera &camera, bool const waitForSharp, int const frameCount, float const frameTime, PhaseStatistics &statistics)
+{
+	memset(&statistics, 0, sizeof(statistics));
+
+	int const uploadedByteCount = TextureStreamer::getTotalUploadedBytes();
+
+	PerformanceTimer timer;
+	timer.start();
+
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		IGNORE_RETURN(Os::update());
+		Graphics::update(frameTime);
+
+		statistics.peakUploadedByteCount = std::max(statistics.peakUploadedByteCount, TextureStreamer::getUploadedBytesLastFrame());
+		statistics.peakResidentMemory    = std::max(statistics.peakResidentMemory, TextureStreamer::getResidentMemory());
+
+		if (waitForSharp && frame > 0 && TextureStreamer::isSharp())
+		{
+			statistics.sharp = true;
+			break;
+		}
+
+		Graphics::setViewport(0, 0, camera.getViewportWidth(), camera.getViewportHeight());
+		Graphics::beginScene();
+		camera.renderScene();
+		Graphics::endScene();
+
+		++statistics.frameCount;
+	}
+
+	timer.stop();
+
+	statistics.elapsedTime       = timer.getElapsedTime();
+	statistics.uploadedByteCount = TextureStreamer::getTotalUploadedBytes() - uploadedByteCount;
+	statistics.residentMemory    = TextureStreamer::getResidentMemory();
+	statistics.targetMemory      = TextureStreamer::getTargetMemory();
+}
+
+// ----------------------------------------------------------------------
+
+void TextureStreamingBenchmarkNamespace::printPhase(char const *const name, PhaseStatistics const &statistics)
+{
+	float const bandwidth = statistics.elapsedTime > 0.0f ? static_cast<float>(statistics.uploadedByteCount) / (1024.0f * 1024.0f) / statistics.elapsedTime : 0.0f;
+
+	printf("%-10s %8d %6s %10.1f %12d %12.1f %12d %12d %12d %12d\n", name, statistics.frameCount, statistics.sharp ? "yes" : "no", statistics.elapsedTime * 1000.0f, statistics.uploadedByteCount / 1024, bandwidth, statistics.peakUploadedByteCount / 1024, statistics.residentMemory / 1024, statistics.peakResidentMemory / 1024, statistics.targetMemory / 1024);
+}
+
+// ----------------------------------------------------------------------
+
+void TextureStreamingBenchmarkNamespace::runBenchmark()
+{
+	StringVector appearanceNames;
+	if (!loadAppearanceNames(appearanceNames))
+	{
+		s_exitCode = 1;
+		return;
+	}
+
+	int const   objectCount       = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "objectCount", 64));
+	float const spacing           = ConfigFile::getKeyFloat(cs_sectionName, "spacing", 8.0f);
+	float const awayDistance      = ConfigFile::getKeyFloat(cs_sectionName, "awayDistance", 4000.0f);
+	int const   maximumFrameCount = std::max(2, ConfigFile::getKeyInt(cs_sectionName, "maximumFrameCount", 600));
+	int const   awayFrameCount    = std::max(1, ConfigFile::getKeyInt(cs_sectionName, "awayFrameCount", 60));
+	int const   budget            = ConfigFile::getKeyInt(cs_sectionName, "budgetMB", 0);
+	float const frameTime         = 1.0f / std::max(1.0f, ConfigFile::getKeyFloat(cs_sectionName, "framesPerSecond", 30.0f));
+
+	//-- Textures choose whether they stream when they are loaded, so streaming is enabled before the appearances are created.
+	bool const wasEnabled = TextureStreamer::isEnabled();
+	int const  previousBudget = TextureStreamer::getMemoryBudget();
+
+	TextureStreamer::setEnabled(true);
+	if (budget > 0)
+		TextureStreamer::setMemoryBudget(budget * 1024 * 1024);
+
+	float const gridSize = static_cast<float>(ceil(sqrt(static_cast<double>(objectCount)))) * spacing;
+	Vector const gridCenter;
+	Vector const awayCenter(awayDistance, 0.0f, 0.0f);
+
+	ObjectVector objects;
+	objects.reserve(static_cast<size_t>(objectCount));
+
+	ObjectList objectList(objectCount);
+	ObjectListCamera *const camera = new ObjectListCamera(1);
+
+	if (createObjects(appearanceNames, objectCount, spacing, objects))
+	{
+		for (ObjectVector::const_iterator it = objects.begin(); it != objects.end(); ++it)
+			objectList.addObject(*it);
+
+		camera->setViewport(0, 0, Graphics::getFrameBufferMaxWidth(), Graphics::getFrameBufferMaxHeight());
+		camera->setNearPlane(0.1f);
+		camera->setFarPlane(gridSize * 4.0f);
+		camera->addObjectList(&objectList);
+
+		PhaseStatistics load;
+		lookAt(*camera, gridCenter, gridSize);
+		runPhase(*camera, true, maximumFrameCount, frameTime, load);
+
+		PhaseStatistics away;
+		lookAt(*camera, awayCenter, gridSize);
+		runPhase(*camera, false, awayFrameCount, frameTime, away);
+
+		PhaseStatistics teleport;
+		lookAt(*camera, gridCenter, gridSize);
+		runPhase(*camera, true, maximumFrameCount, frameTime, teleport);
+
+		//-- Report.
+		printf("\n%d objects, %d streamed textures, %d KB budget, %.1f frames per second.\n", objectCount, TextureStreamer::getNumberOfStreamedTextures(), TextureStreamer::getMemoryBudget() / 1024, 1.0f / frameTime);
+		printf("%-10s %8s %6s %10s %12s %12s %12s %12s %12s %12s\n", "phase", "frames", "sharp", "ms", "uploaded KB", "MB/s", "peak KB/frm", "resident KB", "peak res KB", "target KB");
+		printPhase("load", load);
+		printPhase("away", away);
+		printPhase("teleport", teleport);
+
+		if (!load.sharp || !teleport.sharp)
+		{
+			printf("ERROR: the textures were not sharp within %d frames.\n", maximumFrameCount);
+			s_exitCode = 1;
+		}
+	}
+	else
+		s_exitCode = 1;
+
+	//-- Clean up.
+	camera->removeObjectList(&objectList);
+	delete camera;
+
+	objectList.removeAll(false);
+
+	for (ObjectVector::iterator it = objects.begin(); it != objects.end(); ++it)
+		delete *it;
+
+	TextureStreamer::setMemoryBudget(previousBudget);
+	TextureStreamer::setEnabled(wasEnabled);
+}
+
+// ======================================================================
+
+int main(int argc, char **argv)
+{
+	//-- thread
+	SetupSharedThread::install();
+
+	//-- debug
+	SetupSharedDebug::install(4096);
+
+	//-- foundation
+	{
+		SetupSharedFoundation::Data data(SetupSharedFoundation::Data::D_console);
+		data.argc       = argc;
+		data.argv       = argv;
+		data.configFile = "textureStreamingBenchmark.cfg";
+		SetupSharedFoundation::install(data);
+	}
+
+	//-- file
+	SetupSharedCompression::install();
+	SetupSharedFile::install(false);
+
+	//-- math
+	SetupSharedMath::install();
+
+	//-- utility
+	{
+		SetupSharedUtility::Data data;
+		SetupSharedUtility::setupToolData(data);
+		SetupSharedUtility::install(data);
+	}
+
+	//-- random
+	SetupSharedRandom::install(0);
+
+	//-- image
+	{
+		SetupSharedImage::Data data;
+		SetupSharedImage::setupDefaultData(data);
+		SetupSharedImage::install(data);
+	}
+
+	//-- object
+	{
+		SetupSharedObject::Data data;
+		SetupSharedObject::setupDefaultConsoleData(data);
+		SetupSharedObject::install(data);
+	}
+
+	//-- graphics
+	SetupClientGraphics::Data graphicsData;
+	SetupClientGraphics::setupDefaultGameData(graphicsData);
+	graphicsData.screenWidth                       = 640;
+	graphicsData.screenHeight                      = 480;
+	graphicsData.windowed                          = true;
+	graphicsData.preloadVertexColorShaderTemplates = false;
+
+	if (SetupClientGraphics::install(graphicsData))
+	{
+		//-- object
+		{
+			SetupClientObject::Data data;
+			SetupClientObject::setupToolData(data);
+			SetupClientObject::install(data);
+		}
+
+		SetupSharedFoundation::callbackWithExceptionHandling(TextureStreamingBenchmark::run);
+	}
+	else
+	{
+		printf("ERROR: the graphics system could not be installed.\n");
+		s_exitCode = 1;
+	}
+
+	SetupSharedFoundation::remove();
+	SetupSharedThread::remove();
+
+	return TextureStreamingBenchmark::getExitCode();
+}
+
+// ======================================================================
+// class TextureStreamingBenchmark
+// ======================================================================
+
+void TextureStreamingBenchmark::run()
+{
+	printf("Texture streaming benchmark " __DATE__ " " __TIME__ "\n");
+	runBenchmark();
+}
+
+// ----------------------------------------------------------------------
+
+int TextureStreamingBenchmark::getExitCode()
+{
+	return s_exitCode;
+}
+
+// ======================================================================
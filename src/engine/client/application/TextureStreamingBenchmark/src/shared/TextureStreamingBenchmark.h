@@ -0,0 +1,51 @@
+// ======================================================================
+//
+// TextureStreamingBenchmark.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_TextureStreamingBenchmark_H
+#define INCLUDED_TextureStreamingBenchmark_H
+
+// ======================================================================
+/**
+ * Measures how quickly the TextureStreamer brings a scene to full detail
+ * after the camera teleports.
+ *
+ * The appearances listed in the [TextureStreamingBenchmark] config section
+ * are laid out in a grid with texture streaming enabled, and the camera
+ * runs through three phases:
+ *
+ *   - load:      looking at the grid until its textures are sharp.
+ *   - away:      a fixed number of frames far from the grid, long enough
+ *                for its textures to drop back to their lowest level.
+ *   - teleport:  moved back to the grid, until its textures are sharp.
+ *
+ * Each phase prints its frame count, time, the bytes uploaded and the
+ * resident texture memory.  The benchmark fails if a phase that waits for
+ * sharp textures does not get there within maximumFrameCount frames.
+ *
+ * No GPU is needed when [ClientGraphics] rasterMajor selects the Headless
+ * rasterizer DLL, which keeps texture levels in system memory.  Selecting a
+ * Direct3d rasterizer instead measures the uploads on real hardware.
+ */
+
+class TextureStreamingBenchmark
+{
+public:
+
+	static void run();
+	static int  getExitCode();
+
+private:
+
+	// disabled
+	TextureStreamingBenchmark();
+	TextureStreamingBenchmark(TextureStreamingBenchmark const &);
+	TextureStreamingBenchmark &operator =(TextureStreamingBenchmark const &);
+};
+
+// ======================================================================
+
+#endif
@@ -72,6 +72,7 @@
 #include "clientSkeletalAnimation/AnimationStateNameId.h"
 #include "clientSkeletalAnimation/AnimationStateNameIdManager.h"
 #include "clientSkeletalAnimation/AnimationStatePath.h"
+#include "clientSkeletalAnimation/AnimationUpdateScheduler.h"
 #include "clientSkeletalAnimation/CharacterLodManager.h"
 #include "clientSkeletalAnimation/LogicalAnimationTableTemplateList.h"
 #include "clientSkeletalAnimation/LookAtTransformModifier.h"
@@ -359,6 +360,8 @@ namespace GameNamespace
 	bool  allowLookAtTarget(SkeletalAppearance2 const &lookerAppearance);
 	void  destroyedAttachmentWearableCallback(Object &object);
 	bool  manageCharacterLodCallback(Object &object);
+	bool  buildMeshSynchronouslyCallback(Object const &object);
+	bool  forceFullAnimationRateCallback(Object const &object);
 	void  preloadAssets ();
 	void  alterNetworkBandwidthCalculation(const float deltaTime);
 	bool  isCellAccessAllowed(CellProperty const &cellProperty);
@@ -558,6 +561,35 @@ bool GameNamespace::manageCharacterLodCallback(Object &object)
 
 // ----------------------------------------------------------------------
 
+bool GameNamespace::buildMeshSynchronouslyCallback(Object const &object)
+{
+	//-- The player's clothing and customization changes must show up the frame they happen.
+	return &object == Game::getPlayer();
+}
+
+// ----------------------------------------------------------------------
+
+bool GameNamespace::forceFullAnimationRateCallback(Object const &object)
+{
+	//-- The player always animates at full rate.
+	Object const *const player = Game::getPlayer();
+	if (&object == player)
+		return true;
+
+	//-- So does whatever the player is targeting.
+	CreatureObject const *const playerCreature = Game::getPlayerCreature();
+	if (playerCreature && ((playerCreature->getLookAtTarget() == object.getNetworkId()) || (playerCreature->getIntendedTarget() == object.getNetworkId())))
+		return true;
+
+	//-- And anyone in combat.
+	ClientObject const *const clientObject = object.asClientObject();
+	TangibleObject const *const tangibleObject = clientObject ? clientObject->asTangibleObject() : 0;
+
+	return tangibleObject && tangibleObject->isInCombat();
+}
+
+// ----------------------------------------------------------------------
+
 void GameNamespace::preloadAssets ()
 {
 	if (ConfigFile::getKeyBool ("ClientGame", "disablePreloadedAssetManager", false))
@@ -824,6 +856,9 @@ void Game::install(Application const application)
 			//-- setup what to do if a skeletal appearance detects an unnotified deletion of a wearable or attached item.
 			//   note this shouldn't be needed but our container system doesn't always tell me about these.
 			SkeletalAppearance2::setContainsDestroyedAttachmentWearableCallback(destroyedAttachmentWearableCallback);
+
+			//-- never make the player wait on the mesh construction threads.
+			SkeletalAppearance2::setBuildMeshSynchronouslyCallback(buildMeshSynchronouslyCallback);
 		}
 
 		//-- setup network
@@ -925,6 +960,7 @@ void Game::install(Application const application)
 				s_cosHalfLookatConeAngle = cos(0.5f * cs_lookatConeAngle);
 				LookAtTransformModifier::setAllowLookAtTargetFunction(allowLookAtTarget);
 				CharacterLodManager::setManageLodCallback(manageCharacterLodCallback);
+				AnimationUpdateScheduler::setForceFullRateCallback(forceFullAnimationRateCallback);
 
 #if 0
 				//-- Tell these classes how to get the current camera for debug purposes.
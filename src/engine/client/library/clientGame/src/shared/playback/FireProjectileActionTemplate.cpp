@@ -606,7 +606,7 @@ bool FireProjectileActionTemplate::getSkeletonTransformPositionByIndex(const Obj
 	//-- calculate the hardpoint's position
 	// get hardpoint's transform to object root
 	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, transformIndex, skeleton.getTransformCount());
-	const Transform &hardpointToObject = skeleton.getJointToRootTransformArray()[transformIndex];
+	const Transform &hardpointToObject = skeleton.getTransformToRoot(transformIndex);
 
 	// hardopint to world = object to world * hardpoint to object
 	Transform hardpointToWorld(Transform::IF_none);
@@ -0,0 +1 @@
+#include "../../src/shared/BatchCuller.h"
\ No newline at end of file
@@ -0,0 +1 @@
+#include "../../src/shared/GraphicsCommandBuffer.h"
\ No newline at end of file
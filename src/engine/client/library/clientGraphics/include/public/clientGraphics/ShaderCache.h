@@ -0,0 +1 @@
+#include "../../src/shared/ShaderCache.h"
\ No newline at end of file
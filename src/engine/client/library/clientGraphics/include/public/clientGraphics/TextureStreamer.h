@@ -0,0 +1 @@
+#include "../../src/shared/TextureStreamer.h"
\ No newline at end of file
@@ -0,0 +1,611 @@
+// ======================================================================
+//
+// BatchCuller.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientGraphics/FirstClientGraphics.h"
+#include "clientGraphics/BatchCuller.h"
+
+#include "clientGraphics/Camera.h"
+#include "clientGraphics/Graphics.h"
+#include "clientGraphics/LodDistanceTable.h"
+#include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedMath/Plane.h"
+#include "sharedMath/Vector.h"
+#include "sharedMath/Volume.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// ----------------------------------------------------------------------
+// The SIMD kernel uses SSE2 intrinsics on x86 and x64.  It is compiled for
+// SSE2 on its own and selected at runtime, so the rest of the library does
+// not require it.
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define BATCH_CULLER_USE_SIMD 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BATCH_CULLER_TARGET_SSE2
+#else
+#define BATCH_CULLER_TARGET_SSE2 __attribute__((target("sse2")))
+#endif
+#else
+#define BATCH_CULLER_USE_SIMD 0
+#endif
+
+// ======================================================================
+
+namespace BatchCullerNamespace
+{
+	struct Statistics
+	{
+		int    numberOfSpheresTested;
+		int    numberOfSpheresCulled;
+		float  cullTime;
+	};
+
+	bool  detectSimd();
+
+	Statistics &getStatistics();
+	void        reportBatchCuller();
+
+	bool        s_installed;
+	bool        s_simdAvailable;
+	bool        s_disableSimd;
+	bool        s_disabled;
+	bool        s_report;
+
+	int         s_statisticsFrameNumber = -1;
+	Statistics  s_statistics;
+	Statistics  s_lastFrameStatistics;
+}
+
+using namespace BatchCullerNamespace;
+
+// ======================================================================
+// namespace BatchCullerNamespace
+// ======================================================================
+
+bool BatchCullerNamespace::detectSimd()
+{
+#if BATCH_CULLER_USE_SIMD
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 1)
+		return false;
+
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse2") != 0;
+#endif
+#else
+	return false;
+#endif
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Statistics are kept per graphics frame, the previous frame is what gets
+ * reported.
+ */
+
+BatchCullerNamespace::Statistics &BatchCullerNamespace::getStatistics()
+{
+	int const frameNumber = Graphics::getFrameNumber();
+
+	if (frameNumber != s_statisticsFrameNumber)
+	{
+		s_statisticsFrameNumber = frameNumber;
+		s_lastFrameStatistics = s_statistics;
+		memset(&s_statistics, 0, sizeof(s_statistics));
+	}
+
+	return s_statistics;
+}
+
+// ----------------------------------------------------------------------
+
+void BatchCullerNamespace::reportBatchCuller()
+{
+	IGNORE_RETURN(getStatistics());
+	Statistics const &statistics = s_lastFrameStatistics;
+
+	float const culledPerMillisecond = statistics.cullTime > 0.0f ? static_cast<float>(statistics.numberOfSpheresCulled) / (statistics.cullTime * 1000.0f) : 0.0f;
+
+	DEBUG_REPORT_PRINT(true, ("-- BatchCuller%s%s\n", s_disabled ? " (disabled)" : "", BatchCuller::getUseSimd() ? "" : " (scalar)"));
+	DEBUG_REPORT_PRINT(true, ("  spheres = %d tested, %d culled\n", statistics.numberOfSpheresTested, statistics.numberOfSpheresCulled));
+	DEBUG_REPORT_PRINT(true, ("  time    = %1.3f ms, %1.0f culled/ms\n", statistics.cullTime * 1000.0f, culledPerMillisecond));
+}
+
+// ======================================================================
+// class BatchCuller::Batch
+// ======================================================================
+
+BatchCuller::Batch::Batch() :
+	m_centerX(),
+	m_centerY(),
+	m_centerZ(),
+	m_radius(),
+	m_maximumDistance(),
+	m_fadeDistance(),
+	m_oneOverFadeLength(),
+	m_numberOfBands(0)
+{
+	for (int i = 0; i < cms_maximumNumberOfBands; ++i)
+		m_bandDistance[i] = FLT_MAX;
+}
+
+// ----------------------------------------------------------------------
+
+BatchCuller::Batch::~Batch()
+{
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Removes the spheres but keeps the storage and the distance bands.
+ */
+
+void BatchCuller::Batch::clear()
+{
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_radius.clear();
+	m_maximumDistance.clear();
+	m_fadeDistance.clear();
+	m_oneOverFadeLength.clear();
+}
+
+// ----------------------------------------------------------------------
+
+void BatchCuller::Batch::reserve(int const numberOfSpheres)
+{
+	size_t const size = static_cast<size_t>(std::max(0, numberOfSpheres));
+
+	m_centerX.reserve(size);
+	m_centerY.reserve(size);
+	m_centerZ.reserve(size);
+	m_radius.reserve(size);
+	m_maximumDistance.reserve(size);
+	m_fadeDistance.reserve(size);
+	m_oneOverFadeLength.reserve(size);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Adds a sphere that is culled only by the frustum.
+ *
+ * @return The index of the sphere in the batch.
+ */
+
+int BatchCuller::Batch::addSphere(Vector const &center_w, float const radius)
+{
+	return addSphere(center_w, radius, 0.0f, 0.0f);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Adds a sphere that is also culled beyond maximumDistance from the camera
+ * center to center, and fades out from fadeDistance to maximumDistance.
+ *
+ * @param maximumDistance  The cull distance, or 0 for none.
+ * @param fadeDistance     Where the fade starts.  The sphere does not fade
+ *                         when this is not less than maximumDistance.
+ * @return The index of the sphere in the batch.
+ */
+
+int BatchCuller::Batch::addSphere(Vector const &center_w, float const radius, float const maximumDistance, float const fadeDistance)
+{
+	int const index = getNumberOfSpheres();
+
+	m_centerX.push_back(center_w.x);
+	m_centerY.push_back(center_w.y);
+	m_centerZ.push_back(center_w.z);
+	m_radius.push_back(radius);
+
+	if (maximumDistance > 0.0f)
+	{
+		m_maximumDistance.push_back(maximumDistance);
+
+		if (fadeDistance < maximumDistance)
+		{
+			m_fadeDistance.push_back(fadeDistance);
+			m_oneOverFadeLength.push_back(1.0f / (maximumDistance - fadeDistance));
+		}
+		else
+		{
+			m_fadeDistance.push_back(0.0f);
+			m_oneOverFadeLength.push_back(0.0f);
+		}
+	}
+	else
+	{
+		m_maximumDistance.push_back(FLT_MAX);
+		m_fadeDistance.push_back(0.0f);
+		m_oneOverFadeLength.push_back(0.0f);
+	}
+
+	return index;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Sets the distances, in increasing order, that divide the spheres into
+ * bands.  Bands beyond cms_maximumNumberOfBands are ignored.
+ */
+
+void BatchCuller::Batch::setDistanceBands(float const *const bandDistances, int const numberOfBands)
+{
+	DEBUG_FATAL(numberOfBands > 0 && !bandDistances, ("no band distances"));
+	DEBUG_WARNING(numberOfBands > cms_maximumNumberOfBands, ("BatchCuller::Batch::setDistanceBands: %d bands, only %d are used", numberOfBands, cms_maximumNumberOfBands));
+
+	m_numberOfBands = clamp(0, numberOfBands, static_cast<int>(cms_maximumNumberOfBands));
+
+	for (int i = 0; i < cms_maximumNumberOfBands; ++i)
+		m_bandDistance[i] = i < m_numberOfBands ? bandDistances[i] : FLT_MAX;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Uses the detail levels of a LodDistanceTable as the bands, so the band of
+ * a visible sphere is the detail level to draw it at.
+ */
+
+void BatchCuller::Batch::setDistanceBands(LodDistanceTable const &lodDistanceTable, float const lodBias)
+{
+	float bandDistances[cms_maximumNumberOfBands];
+	int const numberOfBands = lodDistanceTable.getDistanceBands(bandDistances, cms_maximumNumberOfBands, lodBias);
+
+	setDistanceBands(bandDistances, numberOfBands);
+}
+
+// ======================================================================
+// class BatchCuller::Result
+// ======================================================================
+
+BatchCuller::Result::Result() :
+	m_index(),
+	m_distance(),
+	m_fade(),
+	m_band(),
+	m_numberOfVisible(0),
+	m_numberOfCulled(0)
+{
+}
+
+// ----------------------------------------------------------------------
+
+BatchCuller::Result::~Result()
+{
+}
+
+// ----------------------------------------------------------------------
+
+void BatchCuller::Result::clear()
+{
+	m_numberOfVisible = 0;
+	m_numberOfCulled = 0;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Makes room for every sphere of a batch to be visible.  The storage only
+ * grows, so a result reused every frame stops allocating.
+ */
+
+void BatchCuller::Result::resize(int const numberOfSpheres)
+{
+	size_t const size = static_cast<size_t>(numberOfSpheres);
+
+	if (m_index.size() < size)
+	{
+		m_index.resize(size);
+		m_distance.resize(size);
+		m_fade.resize(size);
+		m_band.resize(size);
+	}
+
+	m_numberOfVisible = 0;
+	m_numberOfCulled = 0;
+}
+
+// ======================================================================
+// class BatchCuller
+// ======================================================================
+
+void BatchCuller::install()
+{
+	DEBUG_FATAL(s_installed, ("BatchCuller already installed"));
+
+	s_simdAvailable = detectSimd();
+	s_disableSimd = false;
+	s_disabled = false;
+	s_report = false;
+
+	DebugFlags::registerFlag(s_disabled, "ClientGraphics/BatchCuller", "disableBatchCuller");
+	DebugFlags::registerFlag(s_disableSimd, "ClientGraphics/BatchCuller", "disableBatchCullerSimd");
+	DebugFlags::registerFlag(s_report, "ClientGraphics/BatchCuller", "reportBatchCuller", reportBatchCuller);
+
+	ExitChain::add(BatchCuller::remove, "BatchCuller::remove");
+
+	s_installed = true;
+}
+
+// ----------------------------------------------------------------------
+
+void BatchCuller::remove()
+{
+	DEBUG_FATAL(!s_installed, ("BatchCuller not installed"));
+	s_installed = false;
+
+	DebugFlags::unregisterFlag(s_disabled);
+	DebugFlags::unregisterFlag(s_disableSimd);
+	DebugFlags::unregisterFlag(s_report);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Whether callers should cull in batches.  When this is false the callers
+ * go back to testing each object on its own.
+ */
+
+bool BatchCuller::isEnabled()
+{
+	return s_installed && !s_disabled;
+}
+
+// ----------------------------------------------------------------------
+
+void BatchCuller::setEnabled(bool const enabled)
+{
+	s_disabled = !enabled;
+}
+
+// ----------------------------------------------------------------------
+
+bool BatchCuller::getUseSimd()
+{
+	return s_simdAvailable && !s_disableSimd;
+}
+
+// ----------------------------------------------------------------------
+
+void BatchCuller::setUseSimd(bool const useSimd)
+{
+	s_disableSimd = !useSimd;
+}
+
+// ----------------------------------------------------------------------
+
+void BatchCuller::cull(Batch const &batch, Camera const &camera, Result &result)
+{
+	cull(batch, camera.getWorldFrustumVolume(), camera.getPosition_w(), result);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Writes the spheres of the batch that are inside the frustum and within
+ * their maximum distance of the camera to the result, in batch order.
+ */
+
+void BatchCuller::cull(Batch const &batch, Volume const &frustum_w, Vector const &cameraPosition_w, Result &result)
+{
+	PerformanceTimer timer;
+	timer.start();
+
+	int const numberOfSpheres = batch.getNumberOfSpheres();
+	result.resize(numberOfSpheres);
+
+	int const numberOfPlanes = frustum_w.getNumberOfPlanes();
+	int first = 0;
+
+#if BATCH_CULLER_USE_SIMD
+	if (getUseSimd() && numberOfPlanes <= cms_maximumNumberOfPlanes)
+		first = cullSimd(batch, frustum_w, cameraPosition_w, result);
+#else
+	UNREF(numberOfPlanes);
+#endif
+
+	cullScalar(batch, frustum_w, cameraPosition_w, first, numberOfSpheres, result);
+
+	result.m_numberOfCulled = numberOfSpheres - result.m_numberOfVisible;
+
+	timer.stop();
+
+	Statistics &statistics = getStatistics();
+	statistics.numberOfSpheresTested += numberOfSpheres;
+	statistics.numberOfSpheresCulled += result.m_numberOfCulled;
+	statistics.cullTime              += timer.getElapsedTime();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Tests the spheres one at a time.  The plane test is Volume::intersects()
+ * and the SIMD kernel does the same arithmetic, so both agree exactly.
+ */
+
+void BatchCuller::cullScalar(Batch const &batch, Volume const &frustum_w, Vector const &cameraPosition_w, int const first, int const end, Result &result)
+{
+	int const numberOfPlanes = frustum_w.getNumberOfPlanes();
+	int const numberOfBands  = batch.m_numberOfBands;
+
+	for (int i = first; i < end; ++i)
+	{
+		size_t const index = static_cast<size_t>(i);
+
+		Vector const center(batch.m_centerX[index], batch.m_centerY[index], batch.m_centerZ[index]);
+		float const  radius = batch.m_radius[index];
+
+		bool outside = false;
+		for (int p = 0; p < numberOfPlanes && !outside; ++p)
+			outside = frustum_w.getPlane(p).computeDistanceTo(center) > radius;
+
+		if (outside)
+			continue;
+
+		float const dx = center.x - cameraPosition_w.x;
+		float const dy = center.y - cameraPosition_w.y;
+		float const dz = center.z - cameraPosition_w.z;
+		float const distance = sqrt((dx * dx) + (dy * dy) + (dz * dz));
+
+		if (distance > batch.m_maximumDistance[index])
+			continue;
+
+		float const fadeAmount = std::max(std::min((distance - batch.m_fadeDistance[index]) * batch.m_oneOverFadeLength[index], 1.0f), 0.0f);
+
+		int band = 0;
+		for (int b = 0; b < numberOfBands; ++b)
+			if (distance > batch.m_bandDistance[b])
+				++band;
+
+		size_t const visibleIndex = static_cast<size_t>(result.m_numberOfVisible++);
+		result.m_index[visibleIndex]    = i;
+		result.m_distance[visibleIndex] = distance;
+		result.m_fade[visibleIndex]     = 1.0f - fadeAmount;
+		result.m_band[visibleIndex]     = band;
+	}
+}
+
+// ----------------------------------------------------------------------
+
+#if BATCH_CULLER_USE_SIMD
+
+/**
+ * Culls the spheres four at a time and returns the index of the first
+ * sphere left over for the scalar path.
+ */
+
+BATCH_CULLER_TARGET_SSE2 int BatchCuller::cullSimd(Batch const &batch, Volume const &frustum_w, Vector const &cameraPosition_w, Result &result)
+{
+	int const numberOfSpheres = batch.getNumberOfSpheres();
+	int const numberOfPlanes  = frustum_w.getNumberOfPlanes();
+	DEBUG_FATAL(numberOfPlanes > cms_maximumNumberOfPlanes, ("%d planes, the SIMD path supports %d", numberOfPlanes, cms_maximumNumberOfPlanes));
+
+	__m128 planeX[cms_maximumNumberOfPlanes];
+	__m128 planeY[cms_maximumNumberOfPlanes];
+	__m128 planeZ[cms_maximumNumberOfPlanes];
+	__m128 planeD[cms_maximumNumberOfPlanes];
+
+	for (int p = 0; p < numberOfPlanes; ++p)
+	{
+		Plane const &plane = frustum_w.getPlane(p);
+		planeX[p] = _mm_set1_ps(plane.getNormal().x);
+		planeY[p] = _mm_set1_ps(plane.getNormal().y);
+		planeZ[p] = _mm_set1_ps(plane.getNormal().z);
+		planeD[p] = _mm_set1_ps(plane.getD());
+	}
+
+	__m128 bandDistance[cms_maximumNumberOfBands];
+	for (int b = 0; b < batch.m_numberOfBands; ++b)
+		bandDistance[b] = _mm_set1_ps(batch.m_bandDistance[b]);
+
+	__m128 const cameraX = _mm_set1_ps(cameraPosition_w.x);
+	__m128 const cameraY = _mm_set1_ps(cameraPosition_w.y);
+	__m128 const cameraZ = _mm_set1_ps(cameraPosition_w.z);
+	__m128 const zero    = _mm_setzero_ps();
+	__m128 const one     = _mm_set1_ps(1.0f);
+
+	float const *const centerX           = numberOfSpheres > 0 ? &batch.m_centerX[0] : 0;
+	float const *const centerY           = numberOfSpheres > 0 ? &batch.m_centerY[0] : 0;
+	float const *const centerZ           = numberOfSpheres > 0 ? &batch.m_centerZ[0] : 0;
+	float const *const radius            = numberOfSpheres > 0 ? &batch.m_radius[0] : 0;
+	float const *const maximumDistance   = numberOfSpheres > 0 ? &batch.m_maximumDistance[0] : 0;
+	float const *const fadeDistance      = numberOfSpheres > 0 ? &batch.m_fadeDistance[0] : 0;
+	float const *const oneOverFadeLength = numberOfSpheres > 0 ? &batch.m_oneOverFadeLength[0] : 0;
+
+	int first = 0;
+	for (; first + 4 <= numberOfSpheres; first += 4)
+	{
+		__m128 const x = _mm_loadu_ps(centerX + first);
+		__m128 const y = _mm_loadu_ps(centerY + first);
+		__m128 const z = _mm_loadu_ps(centerZ + first);
+		__m128 const r = _mm_loadu_ps(radius + first);
+
+		//-- Outside any plane.
+		__m128 outside = zero;
+		for (int p = 0; p < numberOfPlanes; ++p)
+		{
+			__m128 const planeDistance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y)), _mm_mul_ps(planeZ[p], z)), planeD[p]);
+			outside = _mm_or_ps(outside, _mm_cmpgt_ps(planeDistance, r));
+		}
+
+		//-- Beyond the maximum distance.
+		__m128 const dx = _mm_sub_ps(x, cameraX);
+		__m128 const dy = _mm_sub_ps(y, cameraY);
+		__m128 const dz = _mm_sub_ps(z, cameraZ);
+		__m128 const distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+		outside = _mm_or_ps(outside, _mm_cmpgt_ps(distance, _mm_loadu_ps(maximumDistance + first)));
+
+		int const visibleMask = ~_mm_movemask_ps(outside) & 0xf;
+		if (!visibleMask)
+			continue;
+
+		__m128 const fadeAmount = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_sub_ps(distance, _mm_loadu_ps(fadeDistance + first)), _mm_loadu_ps(oneOverFadeLength + first)), one), zero);
+		__m128 const fade = _mm_sub_ps(one, fadeAmount);
+
+		//-- Each compare is all ones, -1, where the sphere is beyond the band.
+		__m128i band = _mm_setzero_si128();
+		for (int b = 0; b < batch.m_numberOfBands; ++b)
+			band = _mm_sub_epi32(band, _mm_castps_si128(_mm_cmpgt_ps(distance, bandDistance[b])));
+
+		float distances[4];
+		float fades[4];
+		int   bands[4];
+		_mm_storeu_ps(distances, distance);
+		_mm_storeu_ps(fades, fade);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(bands), band);
+
+		for (int lane = 0; lane < 4; ++lane)
+			if (visibleMask & (1 << lane))
+			{
+				size_t const visibleIndex = static_cast<size_t>(result.m_numberOfVisible++);
+				result.m_index[visibleIndex]    = first + lane;
+				result.m_distance[visibleIndex] = distances[lane];
+				result.m_fade[visibleIndex]     = fades[lane];
+				result.m_band[visibleIndex]     = bands[lane];
+			}
+	}
+
+	return first;
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+
+int BatchCuller::getNumberOfSpheresTestedLastFrame()
+{
+	IGNORE_RETURN(getStatistics());
+	return s_lastFrameStatistics.numberOfSpheresTested;
+}
+
+// ----------------------------------------------------------------------
+
+int BatchCuller::getNumberOfSpheresCulledLastFrame()
+{
+	IGNORE_RETURN(getStatistics());
+	return s_lastFrameStatistics.numberOfSpheresCulled;
+}
+
+// ----------------------------------------------------------------------
+
+float BatchCuller::getCullTimeLastFrame()
+{
+	IGNORE_RETURN(getStatistics());
+	return s_lastFrameStatistics.cullTime;
+}
+
+// ======================================================================
@@ -0,0 +1,236 @@
+// ======================================================================
+//
+// BatchCuller.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_BatchCuller_H
+#define INCLUDED_BatchCuller_H
+
+// ======================================================================
+
+#include <vector>
+
+class Camera;
+class LodDistanceTable;
+class Vector;
+class Volume;
+
+// ======================================================================
+/**
+ * Culls batches of world space bounding spheres against the camera in one
+ * pass, ahead of the per-object tests and the visibility system.
+ *
+ * A Batch keeps the spheres in separate center, radius and distance arrays
+ * so the SIMD path tests four spheres at a time.  Each sphere is tested
+ * against every plane of the world frustum volume and against its own
+ * maximum distance from the camera, and the spheres that pass are written
+ * to a Result in batch order along with their distance, fade and distance
+ * band.
+ *
+ * The fade runs from 1 at the sphere's fade distance down to 0 at its
+ * maximum distance.  The band counts how many of the batch's band
+ * distances the sphere is beyond, which with the bands from a
+ * LodDistanceTable is the detail level to draw.
+ *
+ * The radial flora manager culls its flora nodes with it, and RenderWorld
+ * culls the dpvs objects of the rendered objects in the world cell before
+ * resolving visibility.  Objects in interior cells and regions of influence
+ * are still culled by the visibility system alone.
+ *
+ * Both paths give the same results as Volume::intersects().  The SIMD path
+ * is used when the cpu has SSE2 unless the disableBatchCullerSimd debug
+ * flag is set.  Statistics are kept per graphics frame for the main thread.
+ */
+
+class BatchCuller
+{
+public:
+
+	class Batch;
+	class Result;
+
+	enum
+	{
+		cms_maximumNumberOfBands  = 8,
+		cms_maximumNumberOfPlanes = 16
+	};
+
+public:
+
+	static void  install();
+
+	static bool  isEnabled();
+	static void  setEnabled(bool enabled);
+	static bool  getUseSimd();
+	static void  setUseSimd(bool useSimd);
+
+	static void  cull(Batch const &batch, Camera const &camera, Result &result);
+	static void  cull(Batch const &batch, Volume const &frustum_w, Vector const &cameraPosition_w, Result &result);
+
+	static int   getNumberOfSpheresTestedLastFrame();
+	static int   getNumberOfSpheresCulledLastFrame();
+	static float getCullTimeLastFrame();
+
+private:
+
+	static void  remove();
+	static void  cullScalar(Batch const &batch, Volume const &frustum_w, Vector const &cameraPosition_w, int first, int end, Result &result);
+	static int   cullSimd(Batch const &batch, Volume const &frustum_w, Vector const &cameraPosition_w, Result &result);
+
+	// disabled
+	BatchCuller();
+	BatchCuller(BatchCuller const &);
+	BatchCuller &operator =(BatchCuller const &);
+};
+
+// ======================================================================
+
+class BatchCuller::Batch
+{
+	friend class BatchCuller;
+
+public:
+
+	Batch();
+	~Batch();
+
+	void  clear();
+	void  reserve(int numberOfSpheres);
+
+	int   addSphere(Vector const &center_w, float radius);
+	int   addSphere(Vector const &center_w, float radius, float maximumDistance, float fadeDistance);
+	int   getNumberOfSpheres() const;
+
+	void  setDistanceBands(float const *bandDistances, int numberOfBands);
+	void  setDistanceBands(LodDistanceTable const &lodDistanceTable, float lodBias);
+	int   getNumberOfDistanceBands() const;
+
+private:
+
+	typedef std::vector<float> FloatVector;
+
+private:
+
+	// disabled
+	Batch(Batch const &);
+	Batch &operator =(Batch const &);
+
+private:
+
+	FloatVector  m_centerX;
+	FloatVector  m_centerY;
+	FloatVector  m_centerZ;
+	FloatVector  m_radius;
+	FloatVector  m_maximumDistance;
+	FloatVector  m_fadeDistance;
+	FloatVector  m_oneOverFadeLength;
+
+	int          m_numberOfBands;
+	float        m_bandDistance[cms_maximumNumberOfBands];
+};
+
+// ======================================================================
+
+class BatchCuller::Result
+{
+	friend class BatchCuller;
+
+public:
+
+	Result();
+	~Result();
+
+	void   clear();
+
+	int    getNumberOfVisible() const;
+	int    getNumberOfCulled() const;
+
+	int    getIndex(int visibleIndex) const;
+	float  getDistance(int visibleIndex) const;
+	float  getFade(int visibleIndex) const;
+	int    getBand(int visibleIndex) const;
+
+private:
+
+	void   resize(int numberOfSpheres);
+
+	// disabled
+	Result(Result const &);
+	Result &operator =(Result const &);
+
+private:
+
+	std::vector<int>    m_index;
+	std::vector<float>  m_distance;
+	std::vector<float>  m_fade;
+	std::vector<int>    m_band;
+
+	int                 m_numberOfVisible;
+	int                 m_numberOfCulled;
+};
+
+// ======================================================================
+
+inline int BatchCuller::Batch::getNumberOfSpheres() const
+{
+	return static_cast<int>(m_centerX.size());
+}
+
+// ----------------------------------------------------------------------
+
+inline int BatchCuller::Batch::getNumberOfDistanceBands() const
+{
+	return m_numberOfBands;
+}
+
+// ======================================================================
+
+inline int BatchCuller::Result::getNumberOfVisible() const
+{
+	return m_numberOfVisible;
+}
+
+// ----------------------------------------------------------------------
+
+inline int BatchCuller::Result::getNumberOfCulled() const
+{
+	return m_numberOfCulled;
+}
+
+// ----------------------------------------------------------------------
+
+inline int BatchCuller::Result::getIndex(int const visibleIndex) const
+{
+	DEBUG_FATAL(visibleIndex < 0 || visibleIndex >= m_numberOfVisible, ("visible index %d out of range [0..%d)", visibleIndex, m_numberOfVisible));
+	return m_index[static_cast<size_t>(visibleIndex)];
+}
+
+// ----------------------------------------------------------------------
+
+inline float BatchCuller::Result::getDistance(int const visibleIndex) const
+{
+	DEBUG_FATAL(visibleIndex < 0 || visibleIndex >= m_numberOfVisible, ("visible index %d out of range [0..%d)", visibleIndex, m_numberOfVisible));
+	return m_distance[static_cast<size_t>(visibleIndex)];
+}
+
+// ----------------------------------------------------------------------
+
+inline float BatchCuller::Result::getFade(int const visibleIndex) const
+{
+	DEBUG_FATAL(visibleIndex < 0 || visibleIndex >= m_numberOfVisible, ("visible index %d out of range [0..%d)", visibleIndex, m_numberOfVisible));
+	return m_fade[static_cast<size_t>(visibleIndex)];
+}
+
+// ----------------------------------------------------------------------
+
+inline int BatchCuller::Result::getBand(int const visibleIndex) const
+{
+	DEBUG_FATAL(visibleIndex < 0 || visibleIndex >= m_numberOfVisible, ("visible index %d out of range [0..%d)", visibleIndex, m_numberOfVisible));
+	return m_band[static_cast<size_t>(visibleIndex)];
+}
+
+// ======================================================================
+
+#endif
@@ -53,6 +53,17 @@ bool  ms_enableLightScaling;
 int   ms_discardHighestMipMapLevels;
 int   ms_discardHighestNormalMipMapLevels;
 
+bool  ms_textureStreamingEnabled;
+int   ms_textureStreamingBudgetMB;
+int   ms_textureStreamingMinimumSize;
+int   ms_textureStreamingUploadBudgetKB;
+int   ms_textureStreamingMipmapBias;
+
+int   ms_drawRecordingThreadCount;
+
+bool  ms_shaderCacheEnabled;
+bool  ms_shaderCacheVerifySources;
+
 bool  ms_loadAllAssetsRegardlessOfShaderCapability;
 
 bool  ms_loadGpa;
@@ -158,6 +169,17 @@ KEY_BOOL(logBadCustomizationData,             false);
 	KEY_INT(discardHighestMipMapLevels,           0);
 	KEY_INT(discardHighestNormalMipMapLevels,     0);
 
+	KEY_BOOL(textureStreamingEnabled,             false);
+	KEY_INT(textureStreamingBudgetMB,             256);
+	KEY_INT(textureStreamingMinimumSize,          64);
+	KEY_INT(textureStreamingUploadBudgetKB,       2048);
+	KEY_INT(textureStreamingMipmapBias,           0);
+
+	KEY_INT(drawRecordingThreadCount,             0);
+
+	KEY_BOOL(shaderCacheEnabled,                  false);
+	KEY_BOOL(shaderCacheVerifySources,            false);
+
 KEY_BOOL(loadAllAssetsRegardlessOfShaderCapability, false);
 
 KEY_BOOL(loadGpa,                             false);
@@ -378,6 +400,62 @@ int ConfigClientGraphics::getDiscardHighestNormalMipMapLevels()
 
 // ----------------------------------------------------------------------
 
+bool ConfigClientGraphics::getTextureStreamingEnabled()
+{
+	return ms_textureStreamingEnabled;
+}
+
+// ----------------------------------------------------------------------
+
+int ConfigClientGraphics::getTextureStreamingBudgetMB()
+{
+	return ms_textureStreamingBudgetMB;
+}
+
+// ----------------------------------------------------------------------
+
+int ConfigClientGraphics::getTextureStreamingMinimumSize()
+{
+	return ms_textureStreamingMinimumSize;
+}
+
+// ----------------------------------------------------------------------
+
+int ConfigClientGraphics::getTextureStreamingUploadBudgetKB()
+{
+	return ms_textureStreamingUploadBudgetKB;
+}
+
+// ----------------------------------------------------------------------
+
+int ConfigClientGraphics::getTextureStreamingMipmapBias()
+{
+	return ms_textureStreamingMipmapBias;
+}
+
+// ----------------------------------------------------------------------
+
+int ConfigClientGraphics::getDrawRecordingThreadCount()
+{
+	return ms_drawRecordingThreadCount;
+}
+
+// ----------------------------------------------------------------------
+
+bool ConfigClientGraphics::getShaderCacheEnabled()
+{
+	return ms_shaderCacheEnabled;
+}
+
+// ----------------------------------------------------------------------
+
+bool ConfigClientGraphics::getShaderCacheVerifySources()
+{
+	return ms_shaderCacheVerifySources;
+}
+
+// ----------------------------------------------------------------------
+
 bool ConfigClientGraphics::getLoadAllAssetsRegardlessOfShaderCapability()
 {
 	return ms_loadAllAssetsRegardlessOfShaderCapability;
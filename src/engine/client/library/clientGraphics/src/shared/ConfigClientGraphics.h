@@ -67,6 +67,17 @@ public:
 	static int            getDiscardHighestMipMapLevels();
 	static int            getDiscardHighestNormalMipMapLevels();
 
+	static bool           getTextureStreamingEnabled();
+	static int            getTextureStreamingBudgetMB();
+	static int            getTextureStreamingMinimumSize();
+	static int            getTextureStreamingUploadBudgetKB();
+	static int            getTextureStreamingMipmapBias();
+
+	static int            getDrawRecordingThreadCount();
+
+	static bool           getShaderCacheEnabled();
+	static bool           getShaderCacheVerifySources();
+
 static bool           getLoadAllAssetsRegardlessOfShaderCapability();
 
 static bool           getLoadGpa();
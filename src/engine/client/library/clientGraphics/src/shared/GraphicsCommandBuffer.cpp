@@ -0,0 +1,601 @@
+// ======================================================================
+//
+// GraphicsCommandBuffer.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientGraphics/FirstClientGraphics.h"
+#include "clientGraphics/GraphicsCommandBuffer.h"
+
+#include "clientGraphics/Graphics.h"
+#include "clientGraphics/HardwareIndexBuffer.h"
+#include "clientGraphics/HardwareVertexBuffer.h"
+#include "sharedMath/Transform.h"
+#include "sharedMath/Vector.h"
+#include "sharedMath/VectorRgba.h"
+
+#include <cstring>
+#include <vector>
+
+// ======================================================================
+// Commands are stored as 32 bit words.  The first word of every command
+// holds the command in its low byte and a small argument, like a pass or
+// a count, in the remaining bits.  Pointers and larger values follow in as
+// many words as they need.
+
+namespace GraphicsCommandBufferNamespace
+{
+	enum Command
+	{
+		C_setStaticShader = 1,
+		C_setObjectToWorldTransformAndScale,
+		C_setVertexBuffer,
+		C_setVertexBufferVector,
+		C_setIndexBuffer,
+		C_setLights,
+		C_setAlphaFadeOpacity,
+		C_setVertexShaderUserConstants,
+		C_setPixelShaderUserConstants,
+		C_setBadVertexBufferVertexShaderCombination,
+		C_draw,
+		C_drawPartial,
+		C_drawIndexedPartial,
+		C_call
+	};
+
+	int const cs_commandBits     = 8;
+	int const cs_commandMask     = (1 << cs_commandBits) - 1;
+	int const cs_maximumArgument = (1 << (32 - cs_commandBits)) - 1;
+
+	int const cs_pointerWords    = (sizeof(void *) + sizeof(uint32) - 1) / sizeof(uint32);
+
+	class Reader
+	{
+	public:
+
+		explicit Reader(uint32 const *words);
+
+		uint32       readWord();
+		int          readInt();
+		float        readFloat();
+		void const  *readPointer();
+		void         read(void *data, int size);
+		void const  *skip(int size);
+
+	private:
+
+		uint32 const *m_words;
+	};
+
+	// the light list passed to Graphics while executing; buffers only execute on the main thread
+	GraphicsCommandBuffer::LightList s_executeLightList;
+}
+
+using namespace GraphicsCommandBufferNamespace;
+
+// ======================================================================
+
+GraphicsCommandBufferNamespace::Reader::Reader(uint32 const *words) :
+	m_words(words)
+{
+}
+
+// ----------------------------------------------------------------------
+
+inline uint32 GraphicsCommandBufferNamespace::Reader::readWord()
+{
+	return *m_words++;
+}
+
+// ----------------------------------------------------------------------
+
+inline int GraphicsCommandBufferNamespace::Reader::readInt()
+{
+	return static_cast<int>(*m_words++);
+}
+
+// ----------------------------------------------------------------------
+
+inline float GraphicsCommandBufferNamespace::Reader::readFloat()
+{
+	float value;
+	memcpy(&value, m_words++, sizeof(value));
+	return value;
+}
+
+// ----------------------------------------------------------------------
+
+inline void const *GraphicsCommandBufferNamespace::Reader::readPointer()
+{
+	void const *pointer = NULL;
+	memcpy(&pointer, m_words, sizeof(pointer));
+	m_words += cs_pointerWords;
+	return pointer;
+}
+
+// ----------------------------------------------------------------------
+
+inline void GraphicsCommandBufferNamespace::Reader::read(void *data, int size)
+{
+	memcpy(data, skip(size), static_cast<size_t>(size));
+}
+
+// ----------------------------------------------------------------------
+
+inline void const *GraphicsCommandBufferNamespace::Reader::skip(int size)
+{
+	void const *const data = m_words;
+	m_words += (size + static_cast<int>(sizeof(uint32)) - 1) / static_cast<int>(sizeof(uint32));
+	return data;
+}
+
+// ======================================================================
+
+GraphicsCommandBuffer::GraphicsCommandBuffer() :
+	m_words(new Words),
+	m_numberOfCommands(0),
+	m_numberOfDrawCalls(0),
+	m_recording(false)
+{
+}
+
+// ----------------------------------------------------------------------
+
+GraphicsCommandBuffer::~GraphicsCommandBuffer()
+{
+	DEBUG_FATAL(m_recording, ("GraphicsCommandBuffer destroyed while recording"));
+	delete m_words;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Start recording the Graphics calls made on the calling thread.
+ *
+ * Recording appends to the commands already in the buffer.
+ */
+
+void GraphicsCommandBuffer::beginRecording()
+{
+	DEBUG_FATAL(m_recording, ("GraphicsCommandBuffer is already recording"));
+	DEBUG_FATAL(getRecording(), ("another GraphicsCommandBuffer is already recording on this thread"));
+
+	PerThreadData::setGraphicsCommandBuffer(this);
+	m_recording = true;
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::endRecording()
+{
+	DEBUG_FATAL(getRecording() != this, ("GraphicsCommandBuffer is not recording on this thread"));
+
+	PerThreadData::setGraphicsCommandBuffer(NULL);
+	m_recording = false;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Remove all the commands, keeping the memory for the next recording.
+ */
+
+void GraphicsCommandBuffer::clear()
+{
+	m_words->clear();
+	m_numberOfCommands = 0;
+	m_numberOfDrawCalls = 0;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Issue the recorded commands, in order, through Graphics.
+ *
+ * The buffer is left intact so that it may be executed again.
+ */
+
+void GraphicsCommandBuffer::execute() const
+{
+	DEBUG_FATAL(m_recording, ("GraphicsCommandBuffer executed while recording"));
+
+	if (m_words->empty())
+		return;
+
+	uint32 const *const end = &(*m_words)[0] + m_words->size();
+	Reader reader(&(*m_words)[0]);
+
+	for (int i = 0; i < m_numberOfCommands; ++i)
+	{
+		uint32 const header   = reader.readWord();
+		int const    argument = static_cast<int>(header >> cs_commandBits);
+
+		switch (header & cs_commandMask)
+		{
+		case C_setStaticShader:
+			Graphics::setStaticShader(*static_cast<StaticShader const *>(reader.readPointer()), argument);
+			break;
+
+		case C_setObjectToWorldTransformAndScale:
+			{
+				Transform objectToWorld(Transform::IF_none);
+				Vector    scale;
+				reader.read(&objectToWorld, sizeof(objectToWorld));
+				reader.read(&scale, sizeof(scale));
+				Graphics::setObjectToWorldTransformAndScale(objectToWorld, scale);
+			}
+			break;
+
+		case C_setVertexBuffer:
+			Graphics::setVertexBuffer(*static_cast<HardwareVertexBuffer const *>(reader.readPointer()));
+			break;
+
+		case C_setVertexBufferVector:
+			Graphics::setVertexBuffer(*static_cast<VertexBufferVector const *>(reader.readPointer()));
+			break;
+
+		case C_setIndexBuffer:
+			Graphics::setIndexBuffer(*static_cast<HardwareIndexBuffer const *>(reader.readPointer()));
+			break;
+
+		case C_setLights:
+			{
+				s_executeLightList.clear();
+				for (int j = 0; j < argument; ++j)
+					s_executeLightList.push_back(static_cast<Light const *>(reader.readPointer()));
+
+				Graphics::setLights(s_executeLightList);
+			}
+			break;
+
+		case C_setAlphaFadeOpacity:
+			Graphics::setAlphaFadeOpacity(argument != 0, reader.readFloat());
+			break;
+
+		case C_setVertexShaderUserConstants:
+			{
+				float const c0 = reader.readFloat();
+				float const c1 = reader.readFloat();
+				float const c2 = reader.readFloat();
+				float const c3 = reader.readFloat();
+				Graphics::setVertexShaderUserConstants(argument, c0, c1, c2, c3);
+			}
+			break;
+
+		case C_setPixelShaderUserConstants:
+			Graphics::setPixelShaderUserConstants(static_cast<VectorRgba const *>(reader.skip(argument * static_cast<int>(sizeof(VectorRgba)))), argument);
+			break;
+
+		case C_setBadVertexBufferVertexShaderCombination:
+			{
+				bool *const       badDrawFlag         = const_cast<bool *>(static_cast<bool const *>(reader.readPointer()));
+				char const *const debugAppearanceName = static_cast<char const *>(reader.readPointer());
+#ifdef _DEBUG
+				Graphics::setBadVertexBufferVertexShaderCombination(badDrawFlag, debugAppearanceName);
+#else
+				UNREF(badDrawFlag);
+				UNREF(debugAppearanceName);
+#endif
+			}
+			break;
+
+		case C_draw:
+			switch (argument)
+			{
+			case DT_pointList:             Graphics::drawPointList();             break;
+			case DT_lineList:              Graphics::drawLineList();              break;
+			case DT_lineStrip:             Graphics::drawLineStrip();             break;
+			case DT_triangleList:          Graphics::drawTriangleList();          break;
+			case DT_triangleStrip:         Graphics::drawTriangleStrip();         break;
+			case DT_triangleFan:           Graphics::drawTriangleFan();           break;
+			case DT_quadList:              Graphics::drawQuadList();              break;
+			case DT_indexedPointList:      Graphics::drawIndexedPointList();      break;
+			case DT_indexedLineList:       Graphics::drawIndexedLineList();       break;
+			case DT_indexedLineStrip:      Graphics::drawIndexedLineStrip();      break;
+			case DT_indexedTriangleList:   Graphics::drawIndexedTriangleList();   break;
+			case DT_indexedTriangleStrip:  Graphics::drawIndexedTriangleStrip();  break;
+			case DT_indexedTriangleFan:    Graphics::drawIndexedTriangleFan();    break;
+			default:
+				DEBUG_FATAL(true, ("bad draw type %d", argument));
+				break;
+			}
+			break;
+
+		case C_drawPartial:
+			{
+				int const startVertex    = reader.readInt();
+				int const primitiveCount = reader.readInt();
+
+				switch (argument)
+				{
+				case DT_pointList:      Graphics::drawPointList(startVertex, primitiveCount);      break;
+				case DT_lineList:       Graphics::drawLineList(startVertex, primitiveCount);       break;
+				case DT_lineStrip:      Graphics::drawLineStrip(startVertex, primitiveCount);      break;
+				case DT_triangleList:   Graphics::drawTriangleList(startVertex, primitiveCount);   break;
+				case DT_triangleStrip:  Graphics::drawTriangleStrip(startVertex, primitiveCount);  break;
+				case DT_triangleFan:    Graphics::drawTriangleFan(startVertex, primitiveCount);    break;
+				default:
+					DEBUG_FATAL(true, ("bad partial draw type %d", argument));
+					break;
+				}
+			}
+			break;
+
+		case C_drawIndexedPartial:
+			{
+				int const baseIndex          = reader.readInt();
+				int const minimumVertexIndex = reader.readInt();
+				int const numberOfVertices   = reader.readInt();
+				int const startIndex         = reader.readInt();
+				int const primitiveCount     = reader.readInt();
+
+				switch (argument)
+				{
+				case DT_indexedPointList:      Graphics::drawIndexedPointList(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);      break;
+				case DT_indexedLineList:       Graphics::drawIndexedLineList(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);       break;
+				case DT_indexedLineStrip:      Graphics::drawIndexedLineStrip(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);      break;
+				case DT_indexedTriangleList:   Graphics::drawIndexedTriangleList(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);   break;
+				case DT_indexedTriangleStrip:  Graphics::drawIndexedTriangleStrip(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);  break;
+				case DT_indexedTriangleFan:    Graphics::drawIndexedTriangleFan(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);    break;
+				default:
+					DEBUG_FATAL(true, ("bad indexed partial draw type %d", argument));
+					break;
+				}
+			}
+			break;
+
+		case C_call:
+			{
+				CallFunction callFunction;
+				reader.read(&callFunction, sizeof(callFunction));
+				void const *const context = reader.readPointer();
+				(*callFunction)(context);
+			}
+			break;
+
+		default:
+			DEBUG_FATAL(true, ("bad command %d", static_cast<int>(header & cs_commandMask)));
+			return;
+		}
+	}
+
+	UNREF(end);
+	DEBUG_FATAL(reader.skip(0) != end, ("GraphicsCommandBuffer command stream is corrupt"));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the number of bytes the recorded commands take.
+ */
+
+int GraphicsCommandBuffer::getSize() const
+{
+	return static_cast<int>(m_words->size() * sizeof(uint32));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Fold the recorded commands into a running checksum.
+ *
+ * Folding several buffers in order gives the same result as folding one
+ * buffer that recorded all of their commands, so recordings split across
+ * threads can be compared against a serial one.
+ *
+ * @param checksum  The checksum of the commands before this buffer, 0 to start.
+ */
+
+uint32 GraphicsCommandBuffer::getChecksum(uint32 checksum) const
+{
+	Words::const_iterator const end = m_words->end();
+	for (Words::const_iterator i = m_words->begin(); i != end; ++i)
+		checksum = (checksum ^ *i) * 16777619u;
+
+	return checksum;
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::setStaticShader(StaticShader const &shader, int pass)
+{
+	beginCommand(C_setStaticShader, pass);
+	write(&shader);
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::setObjectToWorldTransformAndScale(Transform const &objectToWorld, Vector const &scale)
+{
+	beginCommand(C_setObjectToWorldTransformAndScale, 0);
+	write(&objectToWorld, sizeof(objectToWorld));
+	write(&scale, sizeof(scale));
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::setVertexBuffer(HardwareVertexBuffer const &vertexBuffer)
+{
+	DEBUG_FATAL(vertexBuffer.getType() != HardwareVertexBuffer::T_static, ("only static vertex buffers may be recorded"));
+
+	beginCommand(C_setVertexBuffer, 0);
+	write(&vertexBuffer);
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::setVertexBuffer(VertexBufferVector const &vertexBufferVector)
+{
+	beginCommand(C_setVertexBufferVector, 0);
+	write(&vertexBufferVector);
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::setIndexBuffer(HardwareIndexBuffer const &indexBuffer)
+{
+	DEBUG_FATAL(indexBuffer.getType() != HardwareIndexBuffer::T_static, ("only static index buffers may be recorded"));
+
+	beginCommand(C_setIndexBuffer, 0);
+	write(&indexBuffer);
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::setLights(LightList const &lightList)
+{
+	int const numberOfLights = static_cast<int>(lightList.size());
+
+	beginCommand(C_setLights, numberOfLights);
+	for (int i = 0; i < numberOfLights; ++i)
+		write(lightList[static_cast<size_t>(i)]);
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::setAlphaFadeOpacity(bool enabled, float opacity)
+{
+	beginCommand(C_setAlphaFadeOpacity, enabled ? 1 : 0);
+	write(opacity);
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::setVertexShaderUserConstants(int index, float c0, float c1, float c2, float c3)
+{
+	beginCommand(C_setVertexShaderUserConstants, index);
+	write(c0);
+	write(c1);
+	write(c2);
+	write(c3);
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::setPixelShaderUserConstants(VectorRgba const *constants, int count)
+{
+	NOT_NULL(constants);
+
+	beginCommand(C_setPixelShaderUserConstants, count);
+	write(constants, count * static_cast<int>(sizeof(VectorRgba)));
+}
+
+// ----------------------------------------------------------------------
+
+#ifdef _DEBUG
+
+void GraphicsCommandBuffer::setBadVertexBufferVertexShaderCombination(bool *badDrawFlag, char const *debugAppearanceName)
+{
+	beginCommand(C_setBadVertexBufferVertexShaderCombination, 0);
+	write(badDrawFlag);
+	write(debugAppearanceName);
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+/**
+ * Record a draw of the whole vertex buffer, or index buffer for the indexed types.
+ */
+
+void GraphicsCommandBuffer::draw(DrawType drawType)
+{
+	beginCommand(C_draw, drawType);
+	++m_numberOfDrawCalls;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Record a draw of part of the vertex buffer.  The draw type must not be
+ * an indexed one or a quad list.
+ */
+
+void GraphicsCommandBuffer::draw(DrawType drawType, int startVertex, int primitiveCount)
+{
+	DEBUG_FATAL(drawType > DT_triangleFan, ("bad partial draw type %d", drawType));
+
+	beginCommand(C_drawPartial, drawType);
+	write(static_cast<uint32>(startVertex));
+	write(static_cast<uint32>(primitiveCount));
+	++m_numberOfDrawCalls;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Record a draw of part of the index buffer.  The draw type must be an
+ * indexed one.
+ */
+
+void GraphicsCommandBuffer::draw(DrawType drawType, int baseIndex, int minimumVertexIndex, int numberOfVertices, int startIndex, int primitiveCount)
+{
+	DEBUG_FATAL(drawType < DT_indexedPointList, ("bad indexed partial draw type %d", drawType));
+
+	beginCommand(C_drawIndexedPartial, drawType);
+	write(static_cast<uint32>(baseIndex));
+	write(static_cast<uint32>(minimumVertexIndex));
+	write(static_cast<uint32>(numberOfVertices));
+	write(static_cast<uint32>(startIndex));
+	write(static_cast<uint32>(primitiveCount));
+	++m_numberOfDrawCalls;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Record a call to a function, made in its place in the stream when the
+ * buffer executes.
+ *
+ * This defers work that cannot be recorded, like drawing with dynamic
+ * vertex buffers, while keeping it in order with the recorded commands.
+ * The context must stay valid until the buffer has executed.
+ */
+
+void GraphicsCommandBuffer::call(CallFunction callFunction, void const *context)
+{
+	NOT_NULL(callFunction);
+
+	beginCommand(C_call, 0);
+	write(&callFunction, sizeof(callFunction));
+	write(context);
+}
+
+// ----------------------------------------------------------------------
+
+inline void GraphicsCommandBuffer::beginCommand(int command, int argument)
+{
+	DEBUG_FATAL(argument < 0 || argument > cs_maximumArgument, ("GraphicsCommandBuffer argument %d out of range", argument));
+
+	m_words->push_back(static_cast<uint32>(command) | (static_cast<uint32>(argument) << cs_commandBits));
+	++m_numberOfCommands;
+}
+
+// ----------------------------------------------------------------------
+
+inline void GraphicsCommandBuffer::write(uint32 word)
+{
+	m_words->push_back(word);
+}
+
+// ----------------------------------------------------------------------
+
+inline void GraphicsCommandBuffer::write(float value)
+{
+	uint32 word;
+	memcpy(&word, &value, sizeof(word));
+	m_words->push_back(word);
+}
+
+// ----------------------------------------------------------------------
+
+inline void GraphicsCommandBuffer::write(void const *pointer)
+{
+	write(&pointer, sizeof(pointer));
+}
+
+// ----------------------------------------------------------------------
+
+void GraphicsCommandBuffer::write(void const *data, int size)
+{
+	int const numberOfWords = (size + static_cast<int>(sizeof(uint32)) - 1) / static_cast<int>(sizeof(uint32));
+	size_t const offset = m_words->size();
+
+	m_words->resize(offset + static_cast<size_t>(numberOfWords), 0);
+	memcpy(&(*m_words)[offset], data, static_cast<size_t>(size));
+}
+
+// ======================================================================
@@ -0,0 +1,165 @@
+// ======================================================================
+//
+// GraphicsCommandBuffer.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_GraphicsCommandBuffer_H
+#define INCLUDED_GraphicsCommandBuffer_H
+
+// ======================================================================
+
+class HardwareIndexBuffer;
+class HardwareVertexBuffer;
+class Light;
+class StaticShader;
+class Transform;
+class Vector;
+class VectorRgba;
+class VertexBufferVector;
+
+#include "sharedFoundation/PerThreadData.h"
+
+// ======================================================================
+/**
+ * A compact recording of the state and draw calls made through Graphics.
+ *
+ * While a command buffer is recording on a thread, the Graphics calls that
+ * shader primitives make to draw themselves append commands to it instead
+ * of going to the rasterizer.  execute() later replays the commands in
+ * order through Graphics on the main thread, so every rasterizer,
+ * including the Headless one, consumes the same command stream.
+ *
+ * Only the calls listed below are recorded.  Code that records must not
+ * make any other Graphics call, and must not lock dynamic vertex or index
+ * buffers, because the rasterizer would see those before the commands
+ * recorded ahead of them.  Anything else can be deferred with call(), which
+ * runs a function in its place in the stream when the buffer executes.
+ */
+
+class GraphicsCommandBuffer
+{
+public:
+
+	typedef stdvector<const Light *>::fwd LightList;
+	typedef void (*CallFunction)(void const *context);
+
+	enum DrawType
+	{
+		DT_pointList,
+		DT_lineList,
+		DT_lineStrip,
+		DT_triangleList,
+		DT_triangleStrip,
+		DT_triangleFan,
+		DT_quadList,
+		DT_indexedPointList,
+		DT_indexedLineList,
+		DT_indexedLineStrip,
+		DT_indexedTriangleList,
+		DT_indexedTriangleStrip,
+		DT_indexedTriangleFan
+	};
+
+public:
+
+	static GraphicsCommandBuffer *getRecording();
+
+public:
+
+	GraphicsCommandBuffer();
+	~GraphicsCommandBuffer();
+
+	void   beginRecording();
+	void   endRecording();
+	bool   isRecording() const;
+
+	void   clear();
+	void   execute() const;
+
+	int    getNumberOfCommands() const;
+	int    getNumberOfDrawCalls() const;
+	int    getSize() const;
+	uint32 getChecksum(uint32 checksum) const;
+
+	void   setStaticShader(StaticShader const &shader, int pass);
+	void   setObjectToWorldTransformAndScale(Transform const &objectToWorld, Vector const &scale);
+	void   setVertexBuffer(HardwareVertexBuffer const &vertexBuffer);
+	void   setVertexBuffer(VertexBufferVector const &vertexBufferVector);
+	void   setIndexBuffer(HardwareIndexBuffer const &indexBuffer);
+	void   setLights(LightList const &lightList);
+	void   setAlphaFadeOpacity(bool enabled, float opacity);
+	void   setVertexShaderUserConstants(int index, float c0, float c1, float c2, float c3);
+	void   setPixelShaderUserConstants(VectorRgba const *constants, int count);
+#ifdef _DEBUG
+	void   setBadVertexBufferVertexShaderCombination(bool *badDrawFlag, char const *debugAppearanceName);
+#endif
+
+	void   draw(DrawType drawType);
+	void   draw(DrawType drawType, int startVertex, int primitiveCount);
+	void   draw(DrawType drawType, int baseIndex, int minimumVertexIndex, int numberOfVertices, int startIndex, int primitiveCount);
+
+	void   call(CallFunction callFunction, void const *context);
+
+private:
+
+	typedef stdvector<uint32>::fwd Words;
+
+private:
+
+	void   beginCommand(int command, int argument);
+	void   write(uint32 word);
+	void   write(float value);
+	void   write(void const *pointer);
+	void   write(void const *data, int size);
+
+	// disabled
+	GraphicsCommandBuffer(GraphicsCommandBuffer const &);
+	GraphicsCommandBuffer &operator =(GraphicsCommandBuffer const &);
+
+private:
+
+	Words * const m_words;
+	int           m_numberOfCommands;
+	int           m_numberOfDrawCalls;
+	bool          m_recording;
+};
+
+// ======================================================================
+/**
+ * Get the command buffer recording on the calling thread.
+ *
+ * @return The recording command buffer, or NULL if Graphics calls made on
+ *         this thread go straight to the rasterizer.
+ */
+
+inline GraphicsCommandBuffer *GraphicsCommandBuffer::getRecording()
+{
+	return PerThreadData::getGraphicsCommandBuffer();
+}
+
+// ----------------------------------------------------------------------
+
+inline bool GraphicsCommandBuffer::isRecording() const
+{
+	return m_recording;
+}
+
+// ----------------------------------------------------------------------
+
+inline int GraphicsCommandBuffer::getNumberOfCommands() const
+{
+	return m_numberOfCommands;
+}
+
+// ----------------------------------------------------------------------
+
+inline int GraphicsCommandBuffer::getNumberOfDrawCalls() const
+{
+	return m_numberOfDrawCalls;
+}
+
+// ======================================================================
+
+#endif
@@ -9,6 +9,7 @@
 #include "clientGraphics/GraphicsOptionTags.h"
 
 #include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/Crc.h"
 
 #include <map>
 
@@ -79,6 +80,24 @@ void GraphicsOptionTags::toggle(Tag option)
 	value = !value;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Fold the disabled option tags into a crc.
+ *
+ * Tags are enabled until they are set otherwise, so the disabled ones are
+ * what distinguishes one set of options from another.
+ */
+
+uint32 GraphicsOptionTags::calculateCrc(uint32 crc)
+{
+	Map::const_iterator const iEnd = ms_map.end();
+	for (Map::const_iterator i = ms_map.begin(); i != iEnd; ++i)
+		if (!i->second)
+			crc = Crc::calculate(&i->first, static_cast<int>(sizeof(i->first)), crc);
+
+	return crc;
+}
+
 // ----------------------------------------------------------------------
 
 bool *GraphicsOptionTagsNamespace::find(Tag option)
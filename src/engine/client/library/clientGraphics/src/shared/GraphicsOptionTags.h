@@ -23,6 +23,8 @@ public:
 	static void   set(Tag option, bool enabled);
 	static bool   get(Tag option);
 	static void   toggle(Tag option);
+
+	static uint32 calculateCrc(uint32 crc);
 };
 
 // ======================================================================
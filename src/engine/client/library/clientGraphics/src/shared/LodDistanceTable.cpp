@@ -109,6 +109,31 @@ int LodDistanceTable::getDetailLevel(float distanceFromCameraSquared, int curren
 	return index;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Get the distances at which each detail level after the first starts, for
+ * culling in batches.  A distance beyond n of them selects detail level n,
+ * which is the level getDetailLevel() settles on without the hysteresis of
+ * the current detail level.
+ *
+ * @return The number of distances written to bandDistances.
+ */
+
+int LodDistanceTable::getDistanceBands(float *bandDistances, int maximumNumberOfBands, float lodBias) const
+{
+	NOT_NULL(m_levels);
+	NOT_NULL(bandDistances);
+
+	int const numberOfBands = std::min(m_levelCount - 1, maximumNumberOfBands);
+	for (int i = 0; i < numberOfBands; ++i)
+	{
+		const Level &level = (*m_levels)[static_cast<LevelVector::size_type>(i + 1)];
+		bandDistances[i] = sqrt(level.m_minDistanceSquared * lodBias);
+	}
+
+	return std::max(0, numberOfBands);
+}
+
 // ----------------------------------------------------------------------
 
 void LodDistanceTable::write(Iff &iff)
@@ -23,6 +23,7 @@ public:
 	~LodDistanceTable();
 
 	int   getDetailLevel(float distanceFromCameraSquared, int currentDetailLevel, float lodBias) const;
+	int   getDistanceBands(float *bandDistances, int maximumNumberOfBands, float lodBias) const;
 
 	void  write(Iff &iff);
 
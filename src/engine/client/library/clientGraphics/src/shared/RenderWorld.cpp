@@ -9,6 +9,7 @@
 #include "clientGraphics/FirstClientGraphics.h"
 #include "clientGraphics/RenderWorld.h"
 
+#include "clientGraphics/BatchCuller.h"
 #include "clientGraphics/ConfigClientGraphics.h"
 #include "clientGraphics/DebugPrimitive.h"
 #include "clientGraphics/Graphics.h"
@@ -31,6 +32,7 @@
 #include "sharedObject/CellProperty.h"
 #include "sharedObject/ObjectList.h"
 #include "sharedObject/Portal.h"
+#include "sharedObject/World.h"
 
 #include "dpvsCamera.hpp"
 #include "dpvsCell.hpp"
@@ -119,6 +121,11 @@ namespace RenderWorldNamespace
 	ObjectList                                   ms_worldEnvironmentLights;
 	std::vector<DPVS::Object *>                  ms_excludedDpvsObjects;
 
+	//-- outdoor dpvs object spheres culled together before visibility is resolved, and the dpvs object of each sphere
+	BatchCuller::Batch                           ms_outdoorCullingBatch;
+	BatchCuller::Result                          ms_outdoorCullingResult;
+	DpvsObjects                                  ms_outdoorCullingDpvsObjects;
+
 	DPVS::Model                                 *ms_defaultModel;
 
 	RenderWorld::CellPropertyList                ms_visibleCellList;
@@ -127,6 +134,8 @@ namespace RenderWorldNamespace
 	void                  clearVisibleCells();
 	void                  inWorldAddDpvsObject(Object *object, DPVS::Object *dpvsObject);
 	void                  inWorldRemoveDpvsObject(DPVS::Object *dpvsObject);
+	void                  addOutdoorCullingDpvsObjects(Object const *object, DPVS::Cell const *worldDpvsCell);
+	void                  cullOutdoorDpvsObjects(Camera const &camera);
 	DPVS::Cell           *createDpvsCell(CellProperty *owner);
 	void                  destroyDpvsCell(DPVS::Cell *dpvsCell);
 
@@ -663,6 +672,92 @@ void RenderWorldNamespace::inWorldRemoveDpvsObject(DPVS::Object *dpvsObject)
 
 // ----------------------------------------------------------------------
 
+void RenderWorldNamespace::addOutdoorCullingDpvsObjects(Object const *object, DPVS::Cell const *worldDpvsCell)
+{
+	NOT_NULL(object);
+
+	{
+		Object::DpvsObjects const *dpvsObjects = object->getDpvsObjects();
+		if (dpvsObjects)
+		{
+			Object::DpvsObjects::const_iterator iEnd = dpvsObjects->end();
+			for (Object::DpvsObjects::const_iterator i = dpvsObjects->begin(); i != iEnd; ++i)
+			{
+				DPVS::Object *const dpvsObject = *i;
+
+				//-- lights and portals still have to reach the commander when their bounds are outside the frustum
+				if (!dpvsObject || dpvsObject->getCell() != worldDpvsCell || !dpvsObject->test(DPVS::Object::ENABLED) || dpvsObject->test(DPVS::Object::UNBOUNDED))
+					continue;
+				if (dynamic_cast<DPVS::RegionOfInfluence *>(dpvsObject) || dynamic_cast<DPVS::PhysicalPortal *>(dpvsObject))
+					continue;
+
+				//-- the world cell is in world space, so the cell space sphere is the world space sphere
+				DPVS::Vector3 center;
+				float radius;
+				dpvsObject->getSphere(center, radius);
+
+				IGNORE_RETURN(ms_outdoorCullingBatch.addSphere(Vector(center.v[0], center.v[1], center.v[2]), radius));
+				ms_outdoorCullingDpvsObjects.push_back(dpvsObject);
+			}
+		}
+	}
+
+	{
+		const int numberOfChildObjects = object->getNumberOfChildObjects();
+		for (int i = 0; i < numberOfChildObjects; ++i)
+			addOutdoorCullingDpvsObjects(object->getChildObject(i), worldDpvsCell);
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Culls the dpvs objects of the rendered objects in the world cell against
+ * the camera frustum in one batch and disables the ones outside it for this
+ * render, so visibility is only resolved for the outdoor objects the batch
+ * culler kept.
+ */
+
+void RenderWorldNamespace::cullOutdoorDpvsObjects(Camera const &camera)
+{
+	if (!World::isInstalled())
+		return;
+
+	CellProperty const *const worldCellProperty = CellProperty::getWorldCellProperty();
+	DPVS::Cell const *const worldDpvsCell = worldCellProperty ? worldCellProperty->getDpvsCell() : 0;
+	if (!worldDpvsCell)
+		return;
+
+	ms_outdoorCullingBatch.clear();
+	ms_outdoorCullingDpvsObjects.clear();
+
+	for (int listIndex = WOL_MarkerRenderedStart; listIndex < WOL_MarkerRenderedEnd; ++listIndex)
+	{
+		int const numberOfObjects = World::getNumberOfObjects(listIndex);
+		for (int i = 0; i < numberOfObjects; ++i)
+		{
+			Object const *const object = World::getConstObject(listIndex, i);
+			if (object && object->isInWorld() && object->isInWorldCell())
+				addOutdoorCullingDpvsObjects(object, worldDpvsCell);
+		}
+	}
+
+	BatchCuller::cull(ms_outdoorCullingBatch, camera, ms_outdoorCullingResult);
+
+	//-- the result is in batch order, so every sphere skipped between two visible ones was culled
+	int const numberOfSpheres = ms_outdoorCullingBatch.getNumberOfSpheres();
+	int const numberOfVisible = ms_outdoorCullingResult.getNumberOfVisible();
+	int visibleIndex = 0;
+	for (int i = 0; i < numberOfSpheres; ++i)
+	{
+		if (visibleIndex < numberOfVisible && ms_outdoorCullingResult.getIndex(visibleIndex) == i)
+			++visibleIndex;
+		else
+			RenderWorld::disableDpvsObjectForThisRender(ms_outdoorCullingDpvsObjects[static_cast<size_t>(i)]);
+	}
+}
+
+// ----------------------------------------------------------------------
+
 DPVS::Cell *RenderWorldNamespace::createDpvsCell(CellProperty *owner)
 {
 	DPVS::Cell *dpvsCell = DPVS::Cell::create();
@@ -1038,6 +1133,18 @@ void RenderWorld::drawScene(const RenderWorldCamera &camera)
 #endif
 	{
 		clearVisibleCells();
+
+		//-- the dpvs frustum is not the camera's while the view frustum is locked or frustum culling is off
+#ifdef _DEBUG
+		if (BatchCuller::isEnabled() && !ms_lockViewFrustum && !ms_disableViewFrustumCulling)
+#else
+		if (BatchCuller::isEnabled())
+#endif
+		{
+			NP_PROFILER_AUTO_BLOCK_DEFINE("cullOutdoorDpvsObjects");
+			cullOutdoorDpvsObjects(camera);
+		}
+
 		NP_PROFILER_AUTO_BLOCK_DEFINE("resolveVisibility");
 
 		// the end of this profiler block is in RenderWorldCommander::command() case QUERY_BEGIN
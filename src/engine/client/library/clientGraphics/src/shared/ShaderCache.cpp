@@ -0,0 +1,789 @@
+// ======================================================================
+//
+// ShaderCache.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientGraphics/FirstClientGraphics.h"
+#include "clientGraphics/ShaderCache.h"
+
+#include "clientGraphics/ConfigClientGraphics.h"
+#include "clientGraphics/Graphics.h"
+#include "clientGraphics/GraphicsOptionTags.h"
+#include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedFile/Iff.h"
+#include "sharedFile/TreeFile.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/Crc.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedFoundation/Os.h"
+#include "sharedFoundation/TemporaryCrcString.h"
+#include "sharedSynchronization/Mutex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+// ======================================================================
+
+namespace ShaderCacheNamespace
+{
+	//----------------------------------------------------------------------
+	// The cache file.  Every field is a 32 bit word and every offset is from
+	// the start of the file, so the image works wherever it is loaded.
+
+	struct Header
+	{
+		uint32 magic;
+		uint32 version;
+		uint32 size;
+		uint32 checksum;           // crc of everything after the header
+		uint32 sourceFingerprint;
+		uint32 numberOfRecords;
+		uint32 recordsOffset;
+		uint32 namesOffset;
+		uint32 dataOffset;
+	};
+
+	struct Record
+	{
+		uint32 nameCrc;
+		uint32 nameOffset;
+		uint32 dataOffset;
+		uint32 dataSize;
+		uint32 sourceIdentity;
+		uint32 sourceCrc;
+		uint32 selectionKey;
+		int32  selection;
+	};
+
+	//----------------------------------------------------------------------
+	// A record with its offsets fixed up.
+
+	enum State
+	{
+		S_unverified,
+		S_valid,
+		S_stale
+	};
+
+	struct Entry
+	{
+		uint32       nameCrc;
+		char const  *name;
+		byte const  *data;
+		int          dataSize;
+		uint32       sourceIdentity;
+		uint32       sourceCrc;
+		uint32       selectionKey;
+		int          selection;
+		State        state;
+	};
+
+	//----------------------------------------------------------------------
+	// A file loaded from the tree file since the cache was last saved.
+
+	struct NewRecord
+	{
+		uint32             nameCrc;
+		uint32             sourceIdentity;
+		uint32             sourceCrc;
+		std::vector<byte>  data;
+	};
+
+	struct Selection
+	{
+		uint32 key;
+		int    implementationIndex;
+	};
+
+	typedef std::vector<Entry>                 Entries;
+	typedef std::map<std::string, NewRecord>   NewRecords;
+	typedef std::map<std::string, Selection>   Selections;
+
+	Tag const    TAG_SHCH   = TAG(S,H,C,H);
+	uint32 const cs_version = 2;
+
+	bool          ms_installed;
+	bool          ms_enabled;
+	bool          ms_verifySources;
+	bool          ms_reportShaderCache;
+	bool          ms_dirty;
+	std::string   ms_fileName;
+
+	Mutex         ms_mutex;
+	byte         *ms_image;
+	int           ms_imageSize;
+	Entries       ms_entries;
+	NewRecords    ms_newRecords;
+	Selections    ms_selections;
+
+	int           ms_numberOfHits;
+	int           ms_numberOfMisses;
+	int           ms_numberOfStaleRecords;
+	float         ms_loadTime;
+
+	bool          sortEntries(Entry const &lhs, Entry const &rhs);
+	bool          lessThanNameCrc(Entry const &entry, uint32 nameCrc);
+	uint32        calculateSourceFingerprint();
+	uint32        calculateSelectionKey();
+	bool          isValid(byte const *image, int imageSize);
+	Entry        *findEntry(CrcString const &name);
+	Entry const  *findValidEntry(CrcString const &name);
+	uint32        align(uint32 offset);
+	void          debugReport();
+}
+
+using namespace ShaderCacheNamespace;
+
+// ======================================================================
+
+bool ShaderCacheNamespace::sortEntries(Entry const &lhs, Entry const &rhs)
+{
+	if (lhs.nameCrc != rhs.nameCrc)
+		return lhs.nameCrc < rhs.nameCrc;
+
+	return strcmp(lhs.name, rhs.name) < 0;
+}
+
+// ----------------------------------------------------------------------
+
+bool ShaderCacheNamespace::lessThanNameCrc(Entry const &entry, uint32 const nameCrc)
+{
+	return entry.nameCrc < nameCrc;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * The cache is only good for the tree file searches it was built from.
+ * Patches add or replace trees, which changes their size or modification
+ * time, so any change to the searches discards it.
+ */
+
+uint32 ShaderCacheNamespace::calculateSourceFingerprint()
+{
+	uint32 const searchIdentity = TreeFile::getSearchIdentity();
+	return Crc::calculate(&searchIdentity, static_cast<int>(sizeof(searchIdentity)), Crc::calculate(&cs_version, static_cast<int>(sizeof(cs_version))));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Which implementation an effect resolves to depends on the shader
+ * capability, the option tags and whether unsupported assets are loaded.
+ */
+
+uint32 ShaderCacheNamespace::calculateSelectionKey()
+{
+	int32 const values[3] =
+	{
+		Graphics::getShaderCapability(),
+		ConfigClientGraphics::getLoadAllAssetsRegardlessOfShaderCapability() ? 1 : 0,
+		ConfigClientGraphics::getValidateShaderImplementations() ? 1 : 0
+	};
+
+	return GraphicsOptionTags::calculateCrc(Crc::calculate(values, static_cast<int>(sizeof(values))));
+}
+
+// ----------------------------------------------------------------------
+
+bool ShaderCacheNamespace::isValid(byte const * const image, int const imageSize)
+{
+	if (imageSize < static_cast<int>(sizeof(Header)))
+		return false;
+
+	Header const &header = *reinterpret_cast<Header const *>(image);
+	uint32 const size = static_cast<uint32>(imageSize);
+
+	if (header.magic != TAG_SHCH || header.version != cs_version || header.size != size)
+		return false;
+
+	if (   header.recordsOffset != sizeof(Header)
+	    || header.numberOfRecords > (size - header.recordsOffset) / sizeof(Record)
+	    || header.namesOffset != header.recordsOffset + header.numberOfRecords * sizeof(Record)
+	    || header.dataOffset < header.namesOffset
+	    || header.dataOffset > size)
+		return false;
+
+	if (header.checksum != Crc::calculate(image + sizeof(Header), imageSize - static_cast<int>(sizeof(Header))))
+		return false;
+
+	if (header.sourceFingerprint != calculateSourceFingerprint())
+	{
+		DEBUG_REPORT_LOG(true, ("ShaderCache: the tree file searches changed since %s was built\n", ms_fileName.c_str()));
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+ShaderCacheNamespace::Entry *ShaderCacheNamespace::findEntry(CrcString const &name)
+{
+	uint32 const nameCrc = name.getCrc();
+
+	Entries::iterator const iEnd = ms_entries.end();
+	for (Entries::iterator i = std::lower_bound(ms_entries.begin(), iEnd, nameCrc, lessThanNameCrc); i != iEnd && i->nameCrc == nameCrc; ++i)
+		if (strcmp(i->name, name.getString()) == 0)
+			return &*i;
+
+	return NULL;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Find an entry whose source has not changed since it was cached.
+ *
+ * Each entry is checked against its source the first time it is used.
+ */
+
+ShaderCacheNamespace::Entry const *ShaderCacheNamespace::findValidEntry(CrcString const &name)
+{
+	Entry * const entry = findEntry(name);
+	if (!entry)
+		return NULL;
+
+	if (entry->state == S_unverified)
+	{
+		bool valid = TreeFile::getSourceIdentity(entry->name) == entry->sourceIdentity;
+
+		if (valid && ms_verifySources)
+		{
+			Iff source;
+			valid = source.open(entry->name, true) && source.calculateCrc() == entry->sourceCrc;
+		}
+
+		if (valid)
+			entry->state = S_valid;
+		else
+		{
+			DEBUG_REPORT_LOG(true, ("ShaderCache: [%s] is stale\n", entry->name));
+			entry->state = S_stale;
+			++ms_numberOfStaleRecords;
+			ms_dirty = true;
+		}
+	}
+
+	return entry->state == S_valid ? entry : NULL;
+}
+
+// ----------------------------------------------------------------------
+
+uint32 ShaderCacheNamespace::align(uint32 const offset)
+{
+	return (offset + 3) & ~3u;
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderCacheNamespace::debugReport()
+{
+	DEBUG_REPORT_PRINT(true, ("-- ShaderCache%s\n", ms_enabled ? "" : " (disabled)"));
+	DEBUG_REPORT_PRINT(true, ("  records = %d in %d KB, loaded in %1.2f ms\n", static_cast<int>(ms_entries.size()), ms_imageSize / 1024, ms_loadTime * 1000.0f));
+	DEBUG_REPORT_PRINT(true, ("  hits    = %d, %d misses, %d stale\n", ms_numberOfHits, ms_numberOfMisses, ms_numberOfStaleRecords));
+	DEBUG_REPORT_PRINT(true, ("  new     = %d records, %d selections\n", static_cast<int>(ms_newRecords.size()), static_cast<int>(ms_selections.size())));
+}
+
+// ======================================================================
+
+void ShaderCache::install()
+{
+	DEBUG_FATAL(ms_installed, ("ShaderCache already installed"));
+
+	ms_enabled       = ConfigClientGraphics::getShaderCacheEnabled();
+	ms_verifySources = ConfigClientGraphics::getShaderCacheVerifySources();
+	ms_fileName      = ConfigFile::getKeyString("ClientGraphics", "shaderCacheFile", "shaderCache.bin");
+
+	if (ms_enabled)
+		IGNORE_RETURN(load());
+
+	DebugFlags::registerFlag(ms_reportShaderCache, "ClientGraphics", "reportShaderCache", debugReport);
+
+	ms_installed = true;
+	ExitChain::add(remove, "ShaderCache::remove");
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderCache::remove()
+{
+	DEBUG_FATAL(!ms_installed, ("ShaderCache not installed"));
+	ms_installed = false;
+
+	DebugFlags::unregisterFlag(ms_reportShaderCache);
+
+	if (ms_enabled && ms_dirty)
+		IGNORE_RETURN(save());
+
+	unload();
+
+	NewRecords().swap(ms_newRecords);
+	Selections().swap(ms_selections);
+}
+
+// ----------------------------------------------------------------------
+
+bool ShaderCache::isEnabled()
+{
+	return ms_enabled;
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderCache::setEnabled(bool const enabled)
+{
+	ms_enabled = enabled;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Open a shader file from the cache, or from the tree file if the cache
+ * does not have it.
+ *
+ * An Iff opened from the cache refers to the cache image, so it must be
+ * closed before the cache is loaded or unloaded again.
+ *
+ * @return True if the Iff was opened, false if the file does not exist
+ *         and optional was set.
+ */
+
+bool ShaderCache::open(Iff &iff, char const * const fileName, bool const optional)
+{
+	if (!ms_enabled)
+		return iff.open(fileName, optional);
+
+	TemporaryCrcString const name(fileName, true);
+
+	//-- the entries may be replaced by another thread once the mutex is left, so copy the data out
+	byte const *cachedData = NULL;
+	int cachedDataSize = 0;
+
+	ms_mutex.enter();
+		Entry const * const entry = findValidEntry(name);
+		if (entry)
+		{
+			cachedData = entry->data;
+			cachedDataSize = entry->dataSize;
+			++ms_numberOfHits;
+		}
+		else
+			++ms_numberOfMisses;
+	ms_mutex.leave();
+
+	if (cachedData)
+	{
+		iff.open(cachedDataSize, cachedData, fileName, false);
+		return true;
+	}
+
+	if (!iff.open(fileName, optional))
+		return false;
+
+	//-- record the file for the next save
+	byte const * const data = iff.getRawData();
+	int const dataSize = iff.getRawDataSize();
+	uint32 const sourceIdentity = TreeFile::getSourceIdentity(fileName);
+
+	ms_mutex.enter();
+
+		NewRecord &record = ms_newRecords[name.getString()];
+		record.nameCrc        = name.getCrc();
+		record.sourceIdentity = sourceIdentity;
+		record.sourceCrc      = iff.calculateCrc();
+		record.data.assign(data, data + dataSize);
+		ms_dirty = true;
+
+	ms_mutex.leave();
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Check for a file in the cache, without searching the tree file.
+ */
+
+bool ShaderCache::exists(char const * const fileName)
+{
+	if (!ms_enabled)
+		return false;
+
+	TemporaryCrcString const name(fileName, true);
+
+	ms_mutex.enter();
+		bool const result = findValidEntry(name) != NULL;
+	ms_mutex.leave();
+
+	return result;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the implementation an effect resolved to when it was cached.
+ *
+ * @return The index of the implementation, or -1 if the effect has not
+ *         been resolved for the current shader capability and options.
+ */
+
+int ShaderCache::getSelectedImplementation(CrcString const &effectName)
+{
+	if (!ms_enabled || effectName.isEmpty())
+		return -1;
+
+	uint32 const key = calculateSelectionKey();
+	int result = -1;
+
+	ms_mutex.enter();
+
+		Selections::const_iterator const i = ms_selections.find(effectName.getString());
+		if (i != ms_selections.end())
+		{
+			if (i->second.key == key)
+				result = i->second.implementationIndex;
+		}
+		else
+		{
+			Entry const * const entry = findEntry(effectName);
+			if (entry && entry->state == S_valid && entry->selectionKey == key)
+				result = entry->selection;
+		}
+
+	ms_mutex.leave();
+
+	return result;
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderCache::setSelectedImplementation(CrcString const &effectName, int const implementationIndex)
+{
+	if (!ms_enabled || effectName.isEmpty())
+		return;
+
+	Selection selection;
+	selection.key = calculateSelectionKey();
+	selection.implementationIndex = implementationIndex;
+
+	ms_mutex.enter();
+
+		Entry const * const entry = findEntry(effectName);
+		if (!entry || entry->selectionKey != selection.key || entry->selection != implementationIndex)
+		{
+			ms_selections[effectName.getString()] = selection;
+			ms_dirty = true;
+		}
+
+	ms_mutex.leave();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Replace the cache with the contents of the cache file.
+ *
+ * Files recorded since the last save() are discarded.
+ *
+ * @return True if the cache file was read and is usable.
+ */
+
+bool ShaderCache::load()
+{
+	unload();
+
+	NewRecords().swap(ms_newRecords);
+	Selections().swap(ms_selections);
+	ms_dirty = false;
+
+	PerformanceTimer timer;
+	timer.start();
+
+	FILE * const file = fopen(ms_fileName.c_str(), "rb");
+	if (!file)
+	{
+		ms_dirty = true;
+		return false;
+	}
+
+	int imageSize = 0;
+	if (fseek(file, 0, SEEK_END) == 0)
+		imageSize = static_cast<int>(ftell(file));
+
+	byte * const image = imageSize > 0 ? new byte[static_cast<size_t>(imageSize)] : NULL;
+	bool const read = image && fseek(file, 0, SEEK_SET) == 0 && static_cast<int>(fread(image, 1, static_cast<size_t>(imageSize), file)) == imageSize;
+	IGNORE_RETURN(fclose(file));
+
+	if (!read || !isValid(image, imageSize))
+	{
+		DEBUG_WARNING(read, ("ShaderCache: discarding %s, it is out of date or damaged", ms_fileName.c_str()));
+		delete [] image;
+		ms_dirty = true;
+		return false;
+	}
+
+	//-- fix the record offsets up into pointers
+	Header const &header = *reinterpret_cast<Header const *>(image);
+	Record const * const records = reinterpret_cast<Record const *>(image + header.recordsOffset);
+	uint32 const size = static_cast<uint32>(imageSize);
+
+	ms_entries.reserve(header.numberOfRecords);
+
+	for (uint32 i = 0; i < header.numberOfRecords; ++i)
+	{
+		Record const &record = records[i];
+
+		if (   record.nameOffset < header.namesOffset
+		    || record.nameOffset >= header.dataOffset
+		    || record.dataOffset < header.dataOffset
+		    || record.dataSize > size - record.dataOffset
+		    || record.dataOffset > size)
+		{
+			DEBUG_WARNING(true, ("ShaderCache: discarding %s, record %u is out of range", ms_fileName.c_str(), i));
+			ms_entries.clear();
+			delete [] image;
+			ms_dirty = true;
+			return false;
+		}
+
+		Entry entry;
+		entry.nameCrc        = record.nameCrc;
+		entry.name           = reinterpret_cast<char const *>(image + record.nameOffset);
+		entry.data           = image + record.dataOffset;
+		entry.dataSize       = static_cast<int>(record.dataSize);
+		entry.sourceIdentity = record.sourceIdentity;
+		entry.sourceCrc      = record.sourceCrc;
+		entry.selectionKey   = record.selectionKey;
+		entry.selection      = record.selection;
+		entry.state          = S_unverified;
+
+		ms_entries.push_back(entry);
+	}
+
+	//-- the name pool must end in a terminator for the names to be safe to read
+	if (header.dataOffset > header.namesOffset && image[header.dataOffset - 1] != '\0')
+	{
+		DEBUG_WARNING(true, ("ShaderCache: discarding %s, the name pool is damaged", ms_fileName.c_str()));
+		ms_entries.clear();
+		delete [] image;
+		ms_dirty = true;
+		return false;
+	}
+
+	ms_image = image;
+	ms_imageSize = imageSize;
+
+	timer.stop();
+	ms_loadTime = timer.getElapsedTime();
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Write the cache file.
+ *
+ * The file holds every record that is not stale plus the files recorded
+ * since the last load(), and the implementations effects resolved to.
+ */
+
+bool ShaderCache::save()
+{
+	ms_mutex.enter();
+
+		//-- gather the records, letting new records replace the ones they were reloaded for
+		Entries output;
+		output.reserve(ms_entries.size() + ms_newRecords.size());
+
+		{
+			Entries::const_iterator const iEnd = ms_entries.end();
+			for (Entries::const_iterator i = ms_entries.begin(); i != iEnd; ++i)
+				if (i->state != S_stale && ms_newRecords.find(i->name) == ms_newRecords.end())
+					output.push_back(*i);
+		}
+
+		{
+			NewRecords::const_iterator const iEnd = ms_newRecords.end();
+			for (NewRecords::const_iterator i = ms_newRecords.begin(); i != iEnd; ++i)
+			{
+				Entry entry;
+				entry.nameCrc        = i->second.nameCrc;
+				entry.name           = i->first.c_str();
+				entry.data           = i->second.data.empty() ? NULL : &i->second.data[0];
+				entry.dataSize       = static_cast<int>(i->second.data.size());
+				entry.sourceIdentity = i->second.sourceIdentity;
+				entry.sourceCrc      = i->second.sourceCrc;
+				entry.selectionKey   = 0;
+				entry.selection      = -1;
+				entry.state          = S_valid;
+
+				output.push_back(entry);
+			}
+		}
+
+		{
+			Entries::iterator const iEnd = output.end();
+			for (Entries::iterator i = output.begin(); i != iEnd; ++i)
+			{
+				Selections::const_iterator const j = ms_selections.find(i->name);
+				if (j != ms_selections.end())
+				{
+					i->selectionKey = j->second.key;
+					i->selection = j->second.implementationIndex;
+				}
+			}
+		}
+
+		std::sort(output.begin(), output.end(), sortEntries);
+
+		//-- lay the file out
+		uint32 const numberOfRecords = static_cast<uint32>(output.size());
+		uint32 const recordsOffset = sizeof(Header);
+		uint32 const namesOffset = recordsOffset + numberOfRecords * sizeof(Record);
+
+		uint32 dataOffset = namesOffset;
+		{
+			Entries::const_iterator const iEnd = output.end();
+			for (Entries::const_iterator i = output.begin(); i != iEnd; ++i)
+				dataOffset += static_cast<uint32>(strlen(i->name)) + 1;
+		}
+
+		dataOffset = align(dataOffset);
+
+		uint32 size = dataOffset;
+		{
+			Entries::const_iterator const iEnd = output.end();
+			for (Entries::const_iterator i = output.begin(); i != iEnd; ++i)
+				size = align(size + static_cast<uint32>(i->dataSize));
+		}
+
+		std::vector<byte> image(size, 0);
+
+		Header &header = *reinterpret_cast<Header *>(&image[0]);
+		header.magic             = TAG_SHCH;
+		header.version           = cs_version;
+		header.size              = size;
+		header.sourceFingerprint = calculateSourceFingerprint();
+		header.numberOfRecords   = numberOfRecords;
+		header.recordsOffset     = recordsOffset;
+		header.namesOffset       = namesOffset;
+		header.dataOffset        = dataOffset;
+
+		Record * const records = reinterpret_cast<Record *>(&image[0] + recordsOffset);
+		uint32 nameOffset = namesOffset;
+		uint32 recordDataOffset = dataOffset;
+
+		for (uint32 i = 0; i < numberOfRecords; ++i)
+		{
+			Entry const &entry = output[i];
+			Record &record = records[i];
+
+			uint32 const nameLength = static_cast<uint32>(strlen(entry.name)) + 1;
+			memcpy(&image[nameOffset], entry.name, nameLength);
+
+			if (entry.dataSize > 0)
+				memcpy(&image[recordDataOffset], entry.data, static_cast<size_t>(entry.dataSize));
+
+			record.nameCrc        = entry.nameCrc;
+			record.nameOffset     = nameOffset;
+			record.dataOffset     = recordDataOffset;
+			record.dataSize       = static_cast<uint32>(entry.dataSize);
+			record.sourceIdentity = entry.sourceIdentity;
+			record.sourceCrc      = entry.sourceCrc;
+			record.selectionKey   = entry.selectionKey;
+			record.selection      = entry.selection;
+
+			nameOffset += nameLength;
+			recordDataOffset = align(recordDataOffset + record.dataSize);
+		}
+
+		header.checksum = Crc::calculate(&image[0] + sizeof(Header), static_cast<int>(size - sizeof(Header)));
+
+	ms_mutex.leave();
+
+	if (!Os::writeFile(ms_fileName.c_str(), &image[0], static_cast<int>(size)))
+		return false;
+
+	ms_dirty = false;
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Release the cache image.  Files recorded since the last save() are kept.
+ */
+
+void ShaderCache::unload()
+{
+	ms_mutex.enter();
+
+		Entries().swap(ms_entries);
+
+		delete [] ms_image;
+		ms_image = NULL;
+		ms_imageSize = 0;
+
+	ms_mutex.leave();
+}
+
+// ----------------------------------------------------------------------
+
+int ShaderCache::getNumberOfRecords()
+{
+	return static_cast<int>(ms_entries.size());
+}
+
+// ----------------------------------------------------------------------
+
+int ShaderCache::getSize()
+{
+	return ms_imageSize;
+}
+
+// ----------------------------------------------------------------------
+
+int ShaderCache::getNumberOfHits()
+{
+	return ms_numberOfHits;
+}
+
+// ----------------------------------------------------------------------
+
+int ShaderCache::getNumberOfMisses()
+{
+	return ms_numberOfMisses;
+}
+
+// ----------------------------------------------------------------------
+
+int ShaderCache::getNumberOfStaleRecords()
+{
+	return ms_numberOfStaleRecords;
+}
+
+// ----------------------------------------------------------------------
+
+int ShaderCache::getNumberOfNewRecords()
+{
+	return static_cast<int>(ms_newRecords.size());
+}
+
+// ----------------------------------------------------------------------
+
+float ShaderCache::getLoadTime()
+{
+	return ms_loadTime;
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderCache::resetStatistics()
+{
+	ms_numberOfHits = 0;
+	ms_numberOfMisses = 0;
+	ms_numberOfStaleRecords = 0;
+	ms_loadTime = 0.0f;
+}
+
+// ======================================================================
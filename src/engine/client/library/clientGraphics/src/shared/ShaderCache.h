@@ -0,0 +1,84 @@
+// ======================================================================
+//
+// ShaderCache.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_ShaderCache_H
+#define INCLUDED_ShaderCache_H
+
+// ======================================================================
+
+class CrcString;
+class Iff;
+
+// ======================================================================
+/**
+ * A single file holding the shader template, effect and implementation
+ * files the client loads, so they come from one read instead of a tree
+ * file search, open and decompress each.
+ *
+ * The cache file is a flat, relocatable image: a header, a table of
+ * records sorted by name crc, a name pool and the file data, all addressed
+ * by offsets.  load() reads it in one go and fixes the offsets up into
+ * pointers.  Each record keeps the identity of the source it was copied
+ * from, which covers the file's size and the size and modification time of
+ * the tree or disk file holding it.  A record whose source no longer
+ * matches is stale: the file is loaded from the tree again and replaces the
+ * record on save().  The header keeps the identity of every search path,
+ * tree and table of contents, so a patch discards the whole cache.
+ *
+ * Each effect record also keeps the implementation the effect resolved to,
+ * along with a key of the shader capability and option tags it was
+ * resolved against.  While the key matches, the effect skips straight to
+ * that implementation instead of trying the ones ahead of it again.
+ *
+ * The cache is built on the first run: while it is enabled, every file
+ * loaded from the tree is recorded, and the cache file is written when the
+ * cache is removed.  [ClientGraphics] shaderCacheFile names the file, and
+ * it is used only when shaderCacheEnabled is set.  shaderCacheVerifySources
+ * also reads each source and compares its crc.
+ */
+
+class ShaderCache
+{
+public:
+
+	static void   install();
+
+	static bool   isEnabled();
+	static void   setEnabled(bool enabled);
+
+	static bool   open(Iff &iff, char const *fileName, bool optional);
+	static bool   exists(char const *fileName);
+
+	static int    getSelectedImplementation(CrcString const &effectName);
+	static void   setSelectedImplementation(CrcString const &effectName, int implementationIndex);
+
+	static bool   load();
+	static bool   save();
+	static void   unload();
+
+	static int    getNumberOfRecords();
+	static int    getSize();
+	static int    getNumberOfHits();
+	static int    getNumberOfMisses();
+	static int    getNumberOfStaleRecords();
+	static int    getNumberOfNewRecords();
+	static float  getLoadTime();
+	static void   resetStatistics();
+
+private:
+
+	static void   remove();
+
+	// disabled
+	ShaderCache();
+	ShaderCache(ShaderCache const &);
+	ShaderCache &operator =(ShaderCache const &);
+};
+
+// ======================================================================
+
+#endif
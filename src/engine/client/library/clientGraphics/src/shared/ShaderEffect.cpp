@@ -12,6 +12,7 @@
 #include "sharedFile/Iff.h"
 #include "clientGraphics/ConfigClientGraphics.h"
 #include "clientGraphics/GraphicsDebugFlags.h"
+#include "clientGraphics/ShaderCache.h"
 #include "clientGraphics/ShaderCapability.h"
 #include "clientGraphics/ShaderEffectList.h"
 #include "clientGraphics/ShaderImplementation.h"
@@ -110,6 +111,26 @@ void ShaderEffect::load(Iff &iff)
 }
 
 
+// ----------------------------------------------------------------------
+/**
+ * Skip the implementations ahead of the one this effect resolved to when it
+ * was cached, as they would fail validation again.
+ *
+ * @return The index of the next implementation to read.
+ */
+
+int ShaderEffect::skipToSelectedImplementation(Iff &iff, int numberOfImplementations) const
+{
+	if (ConfigClientGraphics::getLoadAllAssetsRegardlessOfShaderCapability())
+		return 0;
+
+	int const selectedImplementation = ShaderCache::getSelectedImplementation(m_name);
+	if (selectedImplementation <= 0 || selectedImplementation >= numberOfImplementations)
+		return 0;
+
+	return iff.goForward(selectedImplementation, true) ? selectedImplementation : 0;
+}
+
 // ----------------------------------------------------------------------
 
 void ShaderEffect::load_0000(Iff &iff)
@@ -119,10 +140,13 @@ void ShaderEffect::load_0000(Iff &iff)
 				const int numberOfImplementations = iff.read_int8();
 		iff.exitChunk(TAG_DATA);
 
-		int i = 0;
+		int i = skipToSelectedImplementation(iff, numberOfImplementations);
 		for (; !m_implementation && i < numberOfImplementations; ++i)
 			m_implementation = ShaderImplementationList::fetch(iff);
 
+		if (m_implementation)
+			ShaderCache::setSelectedImplementation(m_name, i - 1);
+
 		if (ConfigClientGraphics::getLoadAllAssetsRegardlessOfShaderCapability())
 		{
 			for ( ; i < numberOfImplementations; ++i)
@@ -149,10 +173,13 @@ void ShaderEffect::load_0001(Iff &iff)
 				m_containsPrecalculatedVertexLighting = iff.read_bool8();
 		iff.exitChunk(TAG_DATA);
 
-		int i = 0;
+		int i = skipToSelectedImplementation(iff, numberOfImplementations);
 		for ( ; !m_implementation && i < numberOfImplementations; ++i)
 			m_implementation = ShaderImplementationList::fetch(iff);
 
+		if (m_implementation)
+			ShaderCache::setSelectedImplementation(m_name, i - 1);
+
 		if (ConfigClientGraphics::getLoadAllAssetsRegardlessOfShaderCapability())
 		{
 			for ( ; i < numberOfImplementations; ++i)
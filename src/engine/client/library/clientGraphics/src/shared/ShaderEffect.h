@@ -55,6 +55,7 @@ private:
 	void load(Iff &iff);
 	void load_0000(Iff &iff);
 	void load_0001(Iff &iff);
+	int  skipToSelectedImplementation(Iff &iff, int numberOfImplementations) const;
 
 private:
 
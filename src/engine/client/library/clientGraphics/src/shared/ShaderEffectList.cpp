@@ -8,6 +8,7 @@
 #include "clientGraphics/FirstClientGraphics.h"
 #include "clientGraphics/ShaderEffectList.h"
 
+#include "clientGraphics/ShaderCache.h"
 #include "clientGraphics/ShaderEffect.h"
 #include "sharedDebug/DataLint.h"
 #include "sharedDebug/DebugFlags.h"
@@ -120,7 +121,7 @@ const ShaderEffect *ShaderEffectList::fetch(CrcString const &name, bool create)
 			{
 				// load the file
 				Iff iff;
-				if (!iff.open (name.getString(), true))
+				if (!ShaderCache::open(iff, name.getString(), true))
 				{
 					WARNING(true, ("could not open effect %s", name.getString()));
 					IGNORE_RETURN(iff.open("effect/defaulteffect.eft"));
@@ -184,7 +185,7 @@ const ShaderEffect *ShaderEffectList::fetch(CrcString const &name, Iff &iff)
 				//-- sorry jeff, we have too many bad assets... :)  see if the effect exists, and
 				//   if it doesn't, strip the path and extension and see if it exists again. this
 				//   is to fix the artists not setting up the paths correctly in the shader builder
-				if (!TreeFile::exists (buffer))
+				if (!ShaderCache::exists(buffer) && !TreeFile::exists (buffer))
 				{
 					char newName [256];
 					WARNING (true, ("%s: full path effect name (%s) detected", iff.getFileName (), buffer));
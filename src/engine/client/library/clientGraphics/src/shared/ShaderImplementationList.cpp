@@ -9,6 +9,7 @@
 #include "clientGraphics/FirstClientGraphics.h"
 #include "clientGraphics/ShaderImplementationList.h"
 
+#include "clientGraphics/ShaderCache.h"
 #include "clientGraphics/ShaderImplementation.h"
 #include "sharedFile/Iff.h"
 #include "sharedFoundation/ExitChain.h"
@@ -59,7 +60,8 @@ const ShaderImplementation *ShaderImplementationList::fetch(const char *name)
 		else
 		{
 			// load the file
-			Iff iff(name);
+			Iff iff;
+			IGNORE_RETURN(ShaderCache::open(iff, name, false));
 			result = fetch(name, iff);
 		}
 
@@ -188,6 +188,25 @@ bool ShaderPrimitive::isReady() const
 	return true;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Determine if prepareToDraw() and draw() may be recorded into a
+ * GraphicsCommandBuffer on a worker thread.
+ *
+ * Derived classes may return true only if those routines make no Graphics
+ * calls other than the ones a GraphicsCommandBuffer records, only draw
+ * from static vertex and index buffers, and read nothing that the main
+ * thread changes while the ShaderPrimitiveSorter draws.  This default
+ * implementation returns false, so the primitive draws on the main thread.
+ *
+ * @return  true if this ShaderPrimitive instance may be recorded; false otherwise.
+ */
+
+bool ShaderPrimitive::canRecordDraw() const
+{
+	return false;
+}
+
 // ----------------------------------------------------------------------
 
 bool ShaderPrimitive::collide(const Vector & /*start_o*/, const Vector & /*end_o*/, CollisionInfo & /*result*/) const
@@ -50,6 +50,7 @@ public:
 	virtual void                calculateSkinnedGeometryNow();
 	virtual void                setSkinningMode(SkinningMode skinningMode);
 	virtual bool                isReady() const;
+	virtual bool                canRecordDraw() const;
 
 	virtual bool                collide(const Vector &start_o, const Vector &end_o, CollisionInfo &result) const;
 
@@ -10,6 +10,7 @@
 #include "clientGraphics/ShaderPrimitiveSet.h"
 
 #include "clientGraphics/Graphics.h"
+#include "clientGraphics/GraphicsDebugFlags.h"
 #include "clientGraphics/ShaderPrimitive.h"
 #include "clientGraphics/ShaderPrimitiveSetTemplate.h"
 #include "clientGraphics/ShaderPrimitiveSorter.h"
@@ -57,6 +58,7 @@ public:
 	virtual void                prepareToDraw() const;
 	virtual void                draw() const;
 	virtual float               getRadius() const;
+	virtual bool                canRecordDraw() const;
 
 	virtual void                setCustomizationData(CustomizationData *customizationData);
 	virtual void                addCustomizationVariables(CustomizationData &customizationData) const;
@@ -246,6 +248,23 @@ void ShaderPrimitiveSet::LocalShaderPrimitive::draw() const
 #endif
 }
 
+// ----------------------------------------------------------------------
+/**
+ * The template draws from static buffers with the owner's transform, so
+ * drawing can be recorded on a worker thread.
+ */
+
+bool ShaderPrimitiveSet::LocalShaderPrimitive::canRecordDraw() const
+{
+#ifdef _DEBUG
+	// these add debug primitives to the current camera while preparing to draw
+	if (GraphicsDebugFlags::renderNormals || GraphicsDebugFlags::renderVertexMatrices)
+		return false;
+#endif
+
+	return true;
+}
+
 // ----------------------------------------------------------------------
 
 void ShaderPrimitiveSet::LocalShaderPrimitive::setCustomizationData(CustomizationData *customizationData)
@@ -9,8 +9,10 @@
 #include "clientGraphics/ShaderPrimitiveSorter.h"
 
 #include "clientGraphics/Camera.h"
+#include "clientGraphics/ConfigClientGraphics.h"
 #include "clientGraphics/DynamicVertexBuffer.h"
 #include "clientGraphics/Graphics.h"
+#include "clientGraphics/GraphicsCommandBuffer.h"
 #include "clientGraphics/GraphicsOptionTags.h"
 #include "clientGraphics/Light.h"
 #include "clientGraphics/PostProcessingEffectsManager.h"
@@ -19,15 +21,18 @@
 #include "clientGraphics/StaticShader.h"
 #include "clientGraphics/Texture.h"
 #include "clientGraphics/TextureList.h"
+#include "clientGraphics/TextureStreamer.h"
 #include "sharedDebug/DebugFlags.h"
 #include "sharedDebug/PerformanceTimer.h"
 #include "sharedDebug/Profiler.h"
 #include "sharedFoundation/Clock.h"
 #include "sharedFoundation/ExitChain.h"
+#include "sharedFoundation/PointerDeleter.h"
 #include "sharedMath/Rectangle2d.h"
 #include "sharedMath/Rectangle2d.h"
 #include "sharedMath/VectorRgba.h"
 #include "sharedObject/CellProperty.h"
+#include "sharedThread/WorkerPool.h"
 #include "sharedUtility/LocalMachineOptionManager.h"
 #include <algorithm>
 #include <bitset>
@@ -64,12 +69,21 @@ public:
 		int                     textureSortKey;
 		real                    depthSortKey;
 		LightBitSet             lightBitSet;
+
+		// the keys above packed for the radix sort.  sortKey holds the shader implementation and
+		// template, or the depth; secondarySortKey holds the vertex buffer and texture.
+		uint64                  sortKey;
+		uint64                  secondarySortKey;
 	};
 
 public:
 
 	static void install();
 
+#if PRODUCTION == 0
+	static bool getUseComparisonSort();
+#endif
+
 public:
 
 	Phase();
@@ -80,6 +94,8 @@ public:
 	bool  getDrawEnable() const;
 	void  clearFrameDrawTime();
 	float getFrameDrawTime() const;
+	float getFrameSortTime() const;
+	int   getFrameSortCount() const;
 #endif
 
 	void setSort(Sort sort);
@@ -116,6 +132,14 @@ private:
 
 	void add(const ShaderPrimitive &shaderPrimitive, const StaticShader &staticShader, bool alphaFadeEnabled, float alphaFadeOpacity, const LightBitSet &lightBitVector);
 
+	static bool shouldRecord(int numberOfEntries);
+	static void drawRecorded(Entry const *entries, int numberOfEntries);
+	static void runRecordingJob(void *context, int jobIndex);
+	static bool canRecord(Entry const &entry);
+	static void recordEntry(Entry const &entry, LightList &lightList);
+	static void drawEntry(Entry const &entry);
+	static void drawDeferredEntry(void const *context);
+
 	static void getSortKeys_unknown(Entry &);
 	static void getSortKeys_none(Entry &);
 	static void getSortKeys_depth(Entry &);
@@ -126,6 +150,7 @@ private:
 	static SortFunction  ms_sortPerformance;
 
 #if PRODUCTION == 0
+	static bool          ms_useComparisonSort;
 	static bool          ms_profileByType;
 	static bool          ms_profilePrepareToDraw;
 	static bool          ms_profileDraw;
@@ -140,6 +165,8 @@ private:
 #ifdef _DEBUG
 	bool                             m_drawEnable;
 	float                            m_frameDrawTime;
+	float                            m_frameSortTime;
+	int                              m_frameSortCount;
 #endif
 
 	DrawTime                         m_drawTime;
@@ -178,6 +205,84 @@ namespace ShaderPrimitiveSorterNamespace
 		bool operator()(const ShaderPrimitiveSorter::Phase::Entry &lhs, const ShaderPrimitiveSorter::Phase::Entry &rhs) const;
 	};
 
+	//----------------------------------------------------------------------
+	// The radix sort orders entries one byte of a packed sort key at a time,
+	// least significant byte first.  Each pass is stable, so the result matches
+	// a stable sort with the comparators above.
+
+	struct RadixDigit
+	{
+		uint64 ShaderPrimitiveSorter::Phase::Entry::*key;
+		int                                          shift;
+	};
+
+	int const cs_radixBucketCount      = 256;
+	int const cs_maximumRadixDigitCount = 16;
+
+	// phases smaller than this are not worth the histogram passes
+	int const cs_minimumRadixSortCount = 64;
+
+	RadixDigit const cs_shaderImplementationShaderTemplateVertexBufferTextureDigits[] =
+	{
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey,  0 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey,  8 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 16 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 24 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 32 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 40 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 48 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 56 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey,           0 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey,           8 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey,          16 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey,          24 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey,          32 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey,          40 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey,          48 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey,          56 }
+	};
+
+	RadixDigit const cs_textureVertexBufferDigits[] =
+	{
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 32 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 40 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 48 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 56 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey,  0 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey,  8 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 16 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 24 }
+	};
+
+	RadixDigit const cs_vertexBufferTextureDigits[] =
+	{
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey,  0 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey,  8 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 16 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 24 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 32 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 40 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 48 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::secondarySortKey, 56 }
+	};
+
+	RadixDigit const cs_depthDigits[] =
+	{
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey,  0 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey,  8 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey, 16 },
+		{ &ShaderPrimitiveSorter::Phase::Entry::sortKey, 24 }
+	};
+
+	uint64 makeSortKey(int high, int low);
+	uint64 makeDepthSortKey(float depth);
+	void   radixSort(ShaderPrimitiveSorter::Phase::Entry *entries, int count, RadixDigit const *digits, int digitCount);
+
+	template <class Comparator>
+	void   sortEntries(std::vector<ShaderPrimitiveSorter::Phase::Entry> &entries, int first, RadixDigit const *digits, int digitCount, Comparator comparator, bool stable);
+
+	std::vector<ShaderPrimitiveSorter::Phase::Entry> ms_radixSortScratch;
+
 	bool ms_showDebugHeatShaders = false;
 	bool ms_debugDisableHeatShaders = false;
 	bool ms_showDebugHeatShaderRects = false;
@@ -185,12 +290,94 @@ namespace ShaderPrimitiveSorterNamespace
 	int ms_pixelsCompositedThisFrame = 0;
 	int ms_compositePasses = 0;
 	bool ms_reportPixelsComposited = false;
+
+	//----------------------------------------------------------------------
+	// Draw recording splits a phase into contiguous runs of entries, records
+	// each run into its own command buffer on the worker threads, then
+	// executes the buffers in order on the main thread.
+
+	struct RecordingStatistics
+	{
+		int    numberOfRecordedEntries;
+		int    numberOfDeferredEntries;
+		int    numberOfCommands;
+		int    numberOfDrawCalls;
+		int    numberOfBytes;
+		int    numberOfJobs;
+		int    numberOfPhases;
+		uint32 checksum;
+		float  recordTime;
+		float  executeTime;
+	};
+
+	struct RecordingBatch
+	{
+		ShaderPrimitiveSorter::Phase::Entry const *entries;
+		int                                        numberOfEntries;
+		int                                        numberOfJobs;
+	};
+
+	typedef std::vector<GraphicsCommandBuffer *> CommandBuffers;
+
+	// phases smaller than this draw directly, and each job records at least this many entries
+	int const cs_minimumRecordedEntries = 32;
+	int const cs_jobsPerThread          = 4;
+
+	WorkerPool *          s_drawRecordingWorkerPool = NULL;
+	bool                  s_drawRecordingEnabled = false;
+	bool                  s_disableDrawRecordingThreads = false;
+	bool                  s_reportDrawRecording = false;
+	CommandBuffers        s_commandBuffers;
+	std::vector<int>      s_numberOfDeferredEntries;
+
+	int                   s_recordingStatisticsFrameNumber = -1;
+	RecordingStatistics   s_recordingStatistics;
+	RecordingStatistics   s_lastFrameRecordingStatistics;
+
+	RecordingStatistics  &getRecordingStatistics();
+	void                  reportDrawRecording();
 	
 	//----------------------------------------------------------------------
 
 }
 using namespace ShaderPrimitiveSorterNamespace;
 
+// ======================================================================
+/**
+ * Statistics are kept per graphics frame, the previous frame is what gets
+ * reported.
+ */
+
+ShaderPrimitiveSorterNamespace::RecordingStatistics &ShaderPrimitiveSorterNamespace::getRecordingStatistics()
+{
+	int const frameNumber = Graphics::getFrameNumber();
+
+	if (frameNumber != s_recordingStatisticsFrameNumber)
+	{
+		s_recordingStatisticsFrameNumber = frameNumber;
+		s_lastFrameRecordingStatistics = s_recordingStatistics;
+		memset(&s_recordingStatistics, 0, sizeof(s_recordingStatistics));
+	}
+
+	return s_recordingStatistics;
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderPrimitiveSorterNamespace::reportDrawRecording()
+{
+	IGNORE_RETURN(getRecordingStatistics());
+	RecordingStatistics const &statistics = s_lastFrameRecordingStatistics;
+
+	DEBUG_REPORT_PRINT(true, ("-- ShaderPrimitiveSorter draw recording%s\n", s_drawRecordingEnabled ? "" : " (disabled)"));
+	DEBUG_REPORT_PRINT(true, ("  recorded entries = %d, %d deferred to the main thread\n", statistics.numberOfRecordedEntries, statistics.numberOfDeferredEntries));
+	DEBUG_REPORT_PRINT(true, ("  commands         = %d with %d draws, %d KB\n", statistics.numberOfCommands, statistics.numberOfDrawCalls, statistics.numberOfBytes / 1024));
+	DEBUG_REPORT_PRINT(true, ("  phases           = %d in %d jobs, %1.3f ms record, %1.3f ms execute\n", statistics.numberOfPhases, statistics.numberOfJobs, statistics.recordTime * 1000.0f, statistics.executeTime * 1000.0f));
+	DEBUG_REPORT_PRINT(true, ("  worker threads   = %d%s\n", s_drawRecordingWorkerPool ? s_drawRecordingWorkerPool->getNumberOfThreads() : 0, s_disableDrawRecordingThreads ? " (disabled)" : ""));
+}
+
+// ======================================================================
+
 inline bool Sort_ShaderImplementation_ShaderTemplate_Texture_VertexBuffer::operator()(const ShaderPrimitiveSorter::Phase::Entry &lhs, const ShaderPrimitiveSorter::Phase::Entry &rhs) const
 {
 	if (lhs.shaderImplementationSortKey < rhs.shaderImplementationSortKey)
@@ -264,10 +451,136 @@ inline bool Sort_Depth::operator()(const ShaderPrimitiveSorter::Phase::Entry &lh
 	return (lhs.depthSortKey > rhs.depthSortKey);
 }
 
+//----------------------------------------------------------------------
+/**
+ * Pack two signed sort keys so they order as unsigned integers the way
+ * the comparators order them as signed integers.
+ */
+
+inline uint64 ShaderPrimitiveSorterNamespace::makeSortKey(int high, int low)
+{
+	uint32 const signBit = 0x80000000;
+	return (static_cast<uint64>(static_cast<uint32>(high) ^ signBit) << 32) | static_cast<uint64>(static_cast<uint32>(low) ^ signBit);
+}
+
+//----------------------------------------------------------------------
+/**
+ * Map a depth to a key that sorts far to near, matching Sort_Depth.
+ */
+
+inline uint64 ShaderPrimitiveSorterNamespace::makeDepthSortKey(float depth)
+{
+	// -0 and 0 compare equal, so they must share a key
+	if (depth == 0.0f)
+		depth = 0.0f;
+
+	uint32 bits;
+	memcpy(&bits, &depth, sizeof(bits));
+
+	uint32 const signBit   = 0x80000000;
+	uint32 const ascending = (bits & signBit) ? ~bits : (bits | signBit);
+
+	return static_cast<uint64>(~ascending);
+}
+
+//----------------------------------------------------------------------
+/**
+ * Stable LSD radix sort of entries by the given digits, least significant
+ * first.
+ *
+ * All histograms are gathered in one pass, and digits that are the same for
+ * every entry are skipped.  Sort keys built from pointers share most of their
+ * high bytes, so most of the passes usually are.
+ */
+
+void ShaderPrimitiveSorterNamespace::radixSort(ShaderPrimitiveSorter::Phase::Entry *entries, int count, RadixDigit const *digits, int digitCount)
+{
+	NOT_NULL(entries);
+	DEBUG_FATAL(digitCount > cs_maximumRadixDigitCount, ("too many radix digits %d", digitCount));
+
+	if (count < 2)
+		return;
+
+	//-- gather the histograms
+	int counts[cs_maximumRadixDigitCount][cs_radixBucketCount];
+	memset(counts, 0, sizeof(counts));
+
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			ShaderPrimitiveSorter::Phase::Entry const &entry = entries[i];
+			for (int d = 0; d < digitCount; ++d)
+				++counts[d][static_cast<int>((entry.*(digits[d].key) >> digits[d].shift) & 0xff)];
+		}
+	}
+
+	if (ms_radixSortScratch.size() < static_cast<size_t>(count))
+		ms_radixSortScratch.resize(static_cast<size_t>(count));
+
+	ShaderPrimitiveSorter::Phase::Entry *source      = entries;
+	ShaderPrimitiveSorter::Phase::Entry *destination = &ms_radixSortScratch[0];
+
+	for (int d = 0; d < digitCount; ++d)
+	{
+		int *const digitCounts = counts[d];
+		int const  shift       = digits[d].shift;
+
+		uint64 ShaderPrimitiveSorter::Phase::Entry::*const key = digits[d].key;
+
+		//-- skip digits every entry shares
+		if (digitCounts[static_cast<int>((source[0].*key >> shift) & 0xff)] == count)
+			continue;
+
+		//-- turn the counts into bucket offsets
+		int offset = 0;
+		for (int bucket = 0; bucket < cs_radixBucketCount; ++bucket)
+		{
+			int const bucketCount = digitCounts[bucket];
+			digitCounts[bucket] = offset;
+			offset += bucketCount;
+		}
+
+		for (int i = 0; i < count; ++i)
+			destination[digitCounts[static_cast<int>((source[i].*key >> shift) & 0xff)]++] = source[i];
+
+		std::swap(source, destination);
+	}
+
+	if (source != entries)
+		std::copy(source, source + count, entries);
+}
+
+//----------------------------------------------------------------------
+
+template <class Comparator>
+void ShaderPrimitiveSorterNamespace::sortEntries(std::vector<ShaderPrimitiveSorter::Phase::Entry> &entries, int first, RadixDigit const *digits, int digitCount, Comparator comparator, bool stable)
+{
+	int const count = static_cast<int>(entries.size()) - first;
+	if (count < 2)
+		return;
+
+#if PRODUCTION == 0
+	if (ShaderPrimitiveSorter::Phase::getUseComparisonSort())
+	{
+		if (stable)
+			std::stable_sort(entries.begin() + first, entries.end(), comparator);
+		else
+			std::sort(entries.begin() + first, entries.end(), comparator);
+		return;
+	}
+#endif
+
+	if (count < cs_minimumRadixSortCount)
+		std::stable_sort(entries.begin() + first, entries.end(), comparator);
+	else
+		radixSort(&entries[static_cast<size_t>(first)], count, digits, digitCount);
+}
+
 // ======================================================================
 
 ShaderPrimitiveSorter::Phase::SortFunction ShaderPrimitiveSorter::Phase::ms_sortPerformance = NULL;
 #if PRODUCTION == 0
+bool                                       ShaderPrimitiveSorter::Phase::ms_useComparisonSort;
 bool                                       ShaderPrimitiveSorter::Phase::ms_profileByType;
 bool                                       ShaderPrimitiveSorter::Phase::ms_profilePrepareToDraw;
 bool                                       ShaderPrimitiveSorter::Phase::ms_profileDraw;
@@ -293,16 +606,30 @@ void ShaderPrimitiveSorter::Phase::install()
 	DebugFlags::registerFlag(ms_profileByType, "ClientGraphics/ShaderPrimitiveSorter", "profileByType");
 	DebugFlags::registerFlag(ms_profilePrepareToDraw, "ClientGraphics/ShaderPrimitiveSorter", "profilePrepareToDraw");
 	DebugFlags::registerFlag(ms_profileDraw, "ClientGraphics/ShaderPrimitiveSorter", "profileDraw");
+	DebugFlags::registerFlag(ms_useComparisonSort, "ClientGraphics/ShaderPrimitiveSorter", "useComparisonSort");
 #endif
 }
 
 // ----------------------------------------------------------------------
 
+#if PRODUCTION == 0
+
+bool ShaderPrimitiveSorter::Phase::getUseComparisonSort()
+{
+	return ms_useComparisonSort;
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+
 ShaderPrimitiveSorter::Phase::Phase()
 :
 #ifdef _DEBUG
 	m_drawEnable(true),
 	m_frameDrawTime(0.f),
+	m_frameSortTime(0.f),
+	m_frameSortCount(0),
 #endif
 	m_drawTime(D_unknown),
 	m_sort(&Phase::sort_unknown),
@@ -340,6 +667,8 @@ bool ShaderPrimitiveSorter::Phase::getDrawEnable() const
 void ShaderPrimitiveSorter::Phase::clearFrameDrawTime()
 {
 	m_frameDrawTime = 0.f;
+	m_frameSortTime = 0.f;
+	m_frameSortCount = 0;
 }
 
 // ----------------------------------------------------------------------
@@ -349,6 +678,20 @@ float ShaderPrimitiveSorter::Phase::getFrameDrawTime() const
 	return m_frameDrawTime;
 }
 
+// ----------------------------------------------------------------------
+
+float ShaderPrimitiveSorter::Phase::getFrameSortTime() const
+{
+	return m_frameSortTime;
+}
+
+// ----------------------------------------------------------------------
+
+int ShaderPrimitiveSorter::Phase::getFrameSortCount() const
+{
+	return m_frameSortCount;
+}
+
 #endif
 
 // ----------------------------------------------------------------------
@@ -404,6 +747,9 @@ inline void ShaderPrimitiveSorter::Phase::add(const ShaderPrimitive &shaderPrimi
 	entry.lightBitSet = lightBitSet;
 	(*m_getSortKeys)(entry);
 	m_shaderPrimitives.push_back(entry);
+
+	if (ms_currentCamera && TextureStreamer::isEnabled())
+		TextureStreamer::reportShaderPrimitive(shaderPrimitive, staticShader, *ms_currentCamera);
 }
 
 // ----------------------------------------------------------------------
@@ -437,35 +783,46 @@ void ShaderPrimitiveSorter::Phase::sort_fifo()
 
 void ShaderPrimitiveSorter::Phase::sort_shaderImplementation_shaderTemplate_vertexBuffer_texture()
 {
-	std::sort(m_shaderPrimitives.begin()  + m_stackOffsets.back(), m_shaderPrimitives.end(), Sort_ShaderImplementation_ShaderTemplate_VertexBuffer_Texture());
+	sortEntries(m_shaderPrimitives, m_stackOffsets.back(), cs_shaderImplementationShaderTemplateVertexBufferTextureDigits, static_cast<int>(sizeof(cs_shaderImplementationShaderTemplateVertexBufferTextureDigits) / sizeof(cs_shaderImplementationShaderTemplateVertexBufferTextureDigits[0])), Sort_ShaderImplementation_ShaderTemplate_VertexBuffer_Texture(), false);
 }
 
 // ----------------------------------------------------------------------
 
 void ShaderPrimitiveSorter::Phase::sort_texture_vertexBuffer()
 {
-	std::sort(m_shaderPrimitives.begin() + m_stackOffsets.back(), m_shaderPrimitives.end(), Sort_Texture_VertexBuffer());
+	sortEntries(m_shaderPrimitives, m_stackOffsets.back(), cs_textureVertexBufferDigits, static_cast<int>(sizeof(cs_textureVertexBufferDigits) / sizeof(cs_textureVertexBufferDigits[0])), Sort_Texture_VertexBuffer(), false);
 }
 
 // ----------------------------------------------------------------------
 
 void ShaderPrimitiveSorter::Phase::sort_vertexBuffer_texture()
 {
-	std::sort(m_shaderPrimitives.begin()  + m_stackOffsets.back(), m_shaderPrimitives.end(), Sort_VertexBuffer_Texture());
+	sortEntries(m_shaderPrimitives, m_stackOffsets.back(), cs_vertexBufferTextureDigits, static_cast<int>(sizeof(cs_vertexBufferTextureDigits) / sizeof(cs_vertexBufferTextureDigits[0])), Sort_VertexBuffer_Texture(), false);
 }
 
 // ----------------------------------------------------------------------
 
 void ShaderPrimitiveSorter::Phase::sort_z()
 {
-	std::stable_sort(m_shaderPrimitives.begin() + m_stackOffsets.back(), m_shaderPrimitives.end(), Sort_Depth());
+	sortEntries(m_shaderPrimitives, m_stackOffsets.back(), cs_depthDigits, static_cast<int>(sizeof(cs_depthDigits) / sizeof(cs_depthDigits[0])), Sort_Depth(), true);
 }
 
 // ----------------------------------------------------------------------
 
 inline void ShaderPrimitiveSorter::Phase::sort()
 {
+#ifdef _DEBUG
+	PerformanceTimer performanceTimer;
+	performanceTimer.start();
+#endif
+
 	(this->*m_sort)();
+
+#ifdef _DEBUG
+	performanceTimer.stop();
+	m_frameSortTime += performanceTimer.getElapsedTime();
+	m_frameSortCount += static_cast<int>(m_shaderPrimitives.size()) - m_stackOffsets.back();
+#endif
 }
 
 // ----------------------------------------------------------------------
@@ -486,6 +843,7 @@ void ShaderPrimitiveSorter::Phase::getSortKeys_none(Entry &)
 void ShaderPrimitiveSorter::Phase::getSortKeys_depth(Entry &entry)
 {
 	entry.depthSortKey = entry.shaderPrimitive->getDepthSquaredSortKey();
+	entry.sortKey      = makeDepthSortKey(entry.depthSortKey);
 }
 
 // ----------------------------------------------------------------------
@@ -496,6 +854,9 @@ void ShaderPrimitiveSorter::Phase::getSortKeys_shaderImplementation_shaderTempla
 	entry.shaderTemplateSortKey        = entry.staticShader->getShaderTemplateSortKey();
 	entry.vertexBufferSortKey          = entry.shaderPrimitive->getVertexBufferSortKey();
 	entry.textureSortKey               = entry.staticShader->getTextureSortKey();
+
+	entry.sortKey                      = makeSortKey(entry.shaderImplementationSortKey, entry.shaderTemplateSortKey);
+	entry.secondarySortKey             = makeSortKey(entry.vertexBufferSortKey, entry.textureSortKey);
 }
 
 //----------------------------------------------------------------------
@@ -686,134 +1047,339 @@ bool ShaderPrimitiveSorter::startCompositing(ShaderPrimitive const & shaderPrimi
 
 // ----------------------------------------------------------------------
 
-void ShaderPrimitiveSorter::Phase::draw()
+bool ShaderPrimitiveSorter::Phase::shouldRecord(int numberOfEntries)
 {
-#ifdef _DEBUG
-	if (!m_drawEnable)
-		return;
+	if (!s_drawRecordingEnabled || numberOfEntries < cs_minimumRecordedEntries)
+		return false;
 
-	PerformanceTimer performanceTimer;
-	performanceTimer.start();
+	// a phase drawn while something else records goes into that recording
+	if (GraphicsCommandBuffer::getRecording())
+		return false;
+
+#if PRODUCTION == 0
+	// the per-entry profiler blocks only measure the main thread
+	if (ms_profileByType || ms_profilePrepareToDraw || ms_profileDraw)
+		return false;
 #endif
 
-	NP_PROFILER_AUTO_BLOCK_DEFINE("ShaderPrimitiveSorter::Phase::draw");
+	return true;
+}
 
-	ShaderPrimitives::iterator end = m_shaderPrimitives.end();
-	for (ShaderPrimitives::iterator i = m_shaderPrimitives.begin() + m_stackOffsets.back(); i != end; ++i)
+// ----------------------------------------------------------------------
+/**
+ * Record the entries into command buffers and execute them.
+ *
+ * The entries are split into contiguous runs, one per job, and each job
+ * records its run into its own command buffer, on the worker threads when
+ * there are enough entries.  Entries that cannot be recorded are deferred:
+ * their buffer calls drawEntry() for them in their place when it executes.
+ * The buffers then execute in order on the main thread, so the rasterizer
+ * sees the same calls in the same order as when the entries draw directly.
+ */
+
+void ShaderPrimitiveSorter::Phase::drawRecorded(Entry const *entries, int numberOfEntries)
+{
+	NP_PROFILER_AUTO_BLOCK_DEFINE("ShaderPrimitiveSorter::Phase::drawRecorded");
+
+	int numberOfJobs = 1;
+
+	if (s_drawRecordingWorkerPool && !s_disableDrawRecordingThreads)
+	{
+		int const maximumNumberOfJobs = (s_drawRecordingWorkerPool->getNumberOfThreads() + 1) * cs_jobsPerThread;
+		numberOfJobs = clamp(1, numberOfEntries / cs_minimumRecordedEntries, maximumNumberOfJobs);
+	}
+
+	while (static_cast<int>(s_commandBuffers.size()) < numberOfJobs)
+		s_commandBuffers.push_back(new GraphicsCommandBuffer);
+
+	s_numberOfDeferredEntries.resize(static_cast<size_t>(numberOfJobs));
+
+	//-- record
+	PerformanceTimer recordTimer;
+	recordTimer.start();
+
+	RecordingBatch batch;
+	batch.entries = entries;
+	batch.numberOfEntries = numberOfEntries;
+	batch.numberOfJobs = numberOfJobs;
+
+	if (numberOfJobs > 1)
+		s_drawRecordingWorkerPool->run(runRecordingJob, &batch, numberOfJobs);
+	else
+		runRecordingJob(&batch, 0);
+
+	recordTimer.stop();
+
+	//-- execute
+	PerformanceTimer executeTimer;
+	executeTimer.start();
+
+	{
+		for (int i = 0; i < numberOfJobs; ++i)
+			s_commandBuffers[static_cast<size_t>(i)]->execute();
+	}
+
+	executeTimer.stop();
+
+	RecordingStatistics &statistics = getRecordingStatistics();
+
+	for (int i = 0; i < numberOfJobs; ++i)
+	{
+		GraphicsCommandBuffer const &commandBuffer = *s_commandBuffers[static_cast<size_t>(i)];
+		statistics.numberOfCommands += commandBuffer.getNumberOfCommands();
+		statistics.numberOfDrawCalls += commandBuffer.getNumberOfDrawCalls();
+		statistics.numberOfBytes += commandBuffer.getSize();
+		statistics.checksum = commandBuffer.getChecksum(statistics.checksum);
+		statistics.numberOfDeferredEntries += s_numberOfDeferredEntries[static_cast<size_t>(i)];
+	}
+
+	statistics.numberOfRecordedEntries += numberOfEntries;
+	statistics.numberOfJobs += numberOfJobs;
+	++statistics.numberOfPhases;
+	statistics.recordTime += recordTimer.getElapsedTime();
+	statistics.executeTime += executeTimer.getElapsedTime();
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderPrimitiveSorter::Phase::runRecordingJob(void *context, int jobIndex)
+{
+	NOT_NULL(context);
+
+	RecordingBatch const &batch = *static_cast<RecordingBatch const *>(context);
+
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, jobIndex, batch.numberOfJobs);
+
+	int const first = (batch.numberOfEntries * jobIndex) / batch.numberOfJobs;
+	int const end = (batch.numberOfEntries * (jobIndex + 1)) / batch.numberOfJobs;
+
+	GraphicsCommandBuffer &commandBuffer = *s_commandBuffers[static_cast<size_t>(jobIndex)];
+	int numberOfDeferredEntries = 0;
+
+	LightList lightList;
+	lightList.reserve(MAX_NUMBER_OF_LIGHTS);
+
+	commandBuffer.clear();
+	commandBuffer.beginRecording();
+
+	for (int i = first; i < end; ++i)
+	{
+		Entry const &entry = batch.entries[i];
+
+		if (canRecord(entry))
+			recordEntry(entry, lightList);
+		else
+		{
+			commandBuffer.call(drawDeferredEntry, &entry);
+			++numberOfDeferredEntries;
+		}
+	}
+
+	commandBuffer.endRecording();
+
+	s_numberOfDeferredEntries[static_cast<size_t>(jobIndex)] = numberOfDeferredEntries;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Heat passes render to and composite from the post processing buffers,
+ * which depends on the state of the main thread, so entries with them are
+ * always deferred.
+ */
+
+bool ShaderPrimitiveSorter::Phase::canRecord(Entry const &entry)
+{
+	if (!entry.shaderPrimitive->canRecordDraw())
+		return false;
+
+	StaticShader const &staticShader = *entry.staticShader;
+	int const numberOfPasses = staticShader.getNumberOfPasses();
+
+	for (int i = 0; i < numberOfPasses; ++i)
+		if (staticShader.isHeatPass(i))
+			return false;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Record what drawEntry() does for an entry without heat passes.
+ *
+ * This runs on a worker thread, so the lights are gathered into a list
+ * owned by the job instead of the shared active light list.
+ */
+
+void ShaderPrimitiveSorter::Phase::recordEntry(Entry const &entry, LightList &lightList)
+{
+	StaticShader const    &staticShader    = *entry.staticShader;
+	ShaderPrimitive const &shaderPrimitive = *entry.shaderPrimitive;
+	int const              numberOfPasses  = staticShader.getNumberOfPasses();
+
+	ShaderPrimitiveSorter::getLights(entry.lightBitSet, lightList);
+	Graphics::setLights(lightList);
+
+	shaderPrimitive.prepareToDraw();
+
+	Graphics::setAlphaFadeOpacity(entry.alphaFadeOpacityEnabled, entry.alphaFadeOpacity);
+
+	for (int i = 0; i < numberOfPasses; ++i)
 	{
-		Entry const           &entry           = *i;
-		StaticShader const    &staticShader    = *entry.staticShader;
-		ShaderPrimitive const &shaderPrimitive = *entry.shaderPrimitive;
-		bool const alphaFadeOpacityEnabled     = entry.alphaFadeOpacityEnabled;
-		float const alphaFadeOpacity           = entry.alphaFadeOpacity;
-		int const              numberOfPasses  = staticShader.getNumberOfPasses();
+		Graphics::setStaticShader(staticShader, i);
+		shaderPrimitive.draw();
+	}
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderPrimitiveSorter::Phase::drawEntry(Entry const &entry)
+{
+	StaticShader const    &staticShader    = *entry.staticShader;
+	ShaderPrimitive const &shaderPrimitive = *entry.shaderPrimitive;
+	bool const alphaFadeOpacityEnabled     = entry.alphaFadeOpacityEnabled;
+	float const alphaFadeOpacity           = entry.alphaFadeOpacity;
+	int const              numberOfPasses  = staticShader.getNumberOfPasses();
 
 #if PRODUCTION == 0
-		char const * const typeName = ms_profileByType ? typeid(shaderPrimitive).name() : NULL;
-		NP_PROFILER_BLOCK_DEFINE(profilerBlockByTime, typeName);
-		if (typeName)
-			NP_PROFILER_BLOCK_ENTER(profilerBlockByTime);
+	char const * const typeName = ms_profileByType ? typeid(shaderPrimitive).name() : NULL;
+	NP_PROFILER_BLOCK_DEFINE(profilerBlockByTime, typeName);
+	if (typeName)
+		NP_PROFILER_BLOCK_ENTER(profilerBlockByTime);
 #endif
 
-		ShaderPrimitiveSorter::setLights(i->lightBitSet);
+	ShaderPrimitiveSorter::setLights(entry.lightBitSet);
 
 #if PRODUCTION == 0
-		if (ms_profilePrepareToDraw)
-			NP_PROFILER_BLOCK_ENTER(ms_profilerBlockPrepareToDraw);
+	if (ms_profilePrepareToDraw)
+		NP_PROFILER_BLOCK_ENTER(ms_profilerBlockPrepareToDraw);
 #endif
 
-		shaderPrimitive.prepareToDraw();
+	shaderPrimitive.prepareToDraw();
 
 #if PRODUCTION == 0
-		if (ms_profilePrepareToDraw)
-			NP_PROFILER_BLOCK_LEAVE(ms_profilerBlockPrepareToDraw);
+	if (ms_profilePrepareToDraw)
+		NP_PROFILER_BLOCK_LEAVE(ms_profilerBlockPrepareToDraw);
 #endif
 
-		Texture * const primaryBuffer = PostProcessingEffectsManager::getPrimaryBuffer();
+	Texture * const primaryBuffer = PostProcessingEffectsManager::getPrimaryBuffer();
 
-		int const destinationWidth = primaryBuffer ? primaryBuffer->getWidth() : 0;
-		int const destinationHeight = primaryBuffer ? primaryBuffer->getHeight() : 0;
+	int const destinationWidth = primaryBuffer ? primaryBuffer->getWidth() : 0;
+	int const destinationHeight = primaryBuffer ? primaryBuffer->getHeight() : 0;
 
-		int sectionRectX0 = 0;
-		int sectionRectY0 = 0;
-		int sectionRectX1 = destinationWidth;
-		int sectionRectY1 = destinationHeight;
-		
-		Graphics::setAlphaFadeOpacity(alphaFadeOpacityEnabled, alphaFadeOpacity);
+	int sectionRectX0 = 0;
+	int sectionRectY0 = 0;
+	int sectionRectX1 = destinationWidth;
+	int sectionRectY1 = destinationHeight;
+	
+	Graphics::setAlphaFadeOpacity(alphaFadeOpacityEnabled, alphaFadeOpacity);
+	
+	for (int i = 0; i < numberOfPasses; ++i)
+	{
+		Graphics::setStaticShader(staticShader, i);
+					
+		bool const isHeat = entry.staticShader->isHeatPass(i);
 		
-		for (int i = 0; i < numberOfPasses; ++i)
+		if (isHeat)
 		{
-			Graphics::setStaticShader(staticShader, i);
-						
-			bool const isHeat = entry.staticShader->isHeatPass(i);
-			
-			if (isHeat)
+			if (!ms_heatShadersEnabled)
 			{
-				if (!ms_heatShadersEnabled)
-				{
-					continue;
-				}
-				
-#if PRODUCTION == 0
-				if (ms_profileDraw)
-					NP_PROFILER_BLOCK_ENTER(ms_profilerBlockCompositeStart);
-#endif
-				
-				bool const result = startCompositing(shaderPrimitive, sectionRectX0, sectionRectY0, sectionRectX1, sectionRectY1);
-				
+				continue;
+			}
+			
 #if PRODUCTION == 0
-				if (ms_profileDraw)
-					NP_PROFILER_BLOCK_LEAVE(ms_profilerBlockCompositeStart);
+			if (ms_profileDraw)
+				NP_PROFILER_BLOCK_ENTER(ms_profilerBlockCompositeStart);
 #endif
-				
-				if (!result)
-					continue;
-
-				Graphics::setAlphaFadeOpacity(false, alphaFadeOpacity);
-			}
 			
+			bool const result = startCompositing(shaderPrimitive, sectionRectX0, sectionRectY0, sectionRectX1, sectionRectY1);
 			
 #if PRODUCTION == 0
 			if (ms_profileDraw)
-				NP_PROFILER_BLOCK_ENTER(ms_profilerBlockDraw);
+				NP_PROFILER_BLOCK_LEAVE(ms_profilerBlockCompositeStart);
 #endif
-
-			shaderPrimitive.draw();
 			
+			if (!result)
+				continue;
+
+			Graphics::setAlphaFadeOpacity(false, alphaFadeOpacity);
+		}
+		
+		
 #if PRODUCTION == 0
-			if (ms_profileDraw)
-				NP_PROFILER_BLOCK_LEAVE(ms_profilerBlockDraw);
+		if (ms_profileDraw)
+			NP_PROFILER_BLOCK_ENTER(ms_profilerBlockDraw);
 #endif
 
-			if (isHeat)
+		shaderPrimitive.draw();
+		
+#if PRODUCTION == 0
+		if (ms_profileDraw)
+			NP_PROFILER_BLOCK_LEAVE(ms_profilerBlockDraw);
+#endif
+
+		if (isHeat)
+		{
+			//-- @todo: this should probably be specified by the shader primitive's shader
+			StaticShader * const compositingShader = PostProcessingEffectsManager::getHeatCompositingShader();
+			
+			if (compositingShader)
 			{
-				//-- @todo: this should probably be specified by the shader primitive's shader
-				StaticShader * const compositingShader = PostProcessingEffectsManager::getHeatCompositingShader();
-				
-				if (compositingShader)
-				{
 
 #if PRODUCTION == 0
-				if (ms_profileDraw)
-					NP_PROFILER_BLOCK_ENTER(ms_profilerBlockCompositeFinish);
+			if (ms_profileDraw)
+				NP_PROFILER_BLOCK_ENTER(ms_profilerBlockCompositeFinish);
 #endif
-					
-					finishCompositing(sectionRectX0, sectionRectY0, sectionRectX1, sectionRectY1, *compositingShader);
+				
+				finishCompositing(sectionRectX0, sectionRectY0, sectionRectX1, sectionRectY1, *compositingShader);
 
 #if PRODUCTION == 0
-				if (ms_profileDraw)
-					NP_PROFILER_BLOCK_LEAVE(ms_profilerBlockCompositeFinish);
+			if (ms_profileDraw)
+				NP_PROFILER_BLOCK_LEAVE(ms_profilerBlockCompositeFinish);
 #endif
 
-				}
-				
 			}
+			
 		}
-		
+	}
+	
 #if PRODUCTION == 0
-		if (typeName)
-			NP_PROFILER_BLOCK_LEAVE(profilerBlockByTime);
+	if (typeName)
+		NP_PROFILER_BLOCK_LEAVE(profilerBlockByTime);
 #endif
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderPrimitiveSorter::Phase::drawDeferredEntry(void const *context)
+{
+	NOT_NULL(context);
+	drawEntry(*static_cast<Entry const *>(context));
+}
+
+// ----------------------------------------------------------------------
+
+void ShaderPrimitiveSorter::Phase::draw()
+{
+#ifdef _DEBUG
+	if (!m_drawEnable)
+		return;
+
+	PerformanceTimer performanceTimer;
+	performanceTimer.start();
+#endif
+
+	NP_PROFILER_AUTO_BLOCK_DEFINE("ShaderPrimitiveSorter::Phase::draw");
+
+	int const first = m_stackOffsets.back();
+	int const numberOfEntries = static_cast<int>(m_shaderPrimitives.size()) - first;
+
+	if (shouldRecord(numberOfEntries))
+		drawRecorded(&m_shaderPrimitives[static_cast<size_t>(first)], numberOfEntries);
+	else
+	{
+		ShaderPrimitives::iterator end = m_shaderPrimitives.end();
+		for (ShaderPrimitives::iterator i = m_shaderPrimitives.begin() + first; i != end; ++i)
+			drawEntry(*i);
 	}
 
 	Graphics::setAlphaFadeOpacity(false, 1.0f);
@@ -960,6 +1526,17 @@ void ShaderPrimitiveSorter::install(int numberOfPhases)
 
 	ms_heatShadersEnabled = ms_heatShadersEnabled && getHeatShadersCapable();
 
+	DebugFlags::registerFlag(s_disableDrawRecordingThreads, "ClientGraphics/ShaderPrimitiveSorter", "disableDrawRecordingThreads");
+	DebugFlags::registerFlag(s_reportDrawRecording, "ClientGraphics/ShaderPrimitiveSorter", "reportDrawRecording", reportDrawRecording);
+
+	// a thread count of zero draws every phase directly on the main thread
+	int const drawRecordingThreadCount = ConfigClientGraphics::getDrawRecordingThreadCount();
+	if (drawRecordingThreadCount > 0)
+	{
+		s_drawRecordingWorkerPool = new WorkerPool("DrawRecording", drawRecordingThreadCount);
+		s_drawRecordingEnabled = true;
+	}
+
 	ExitChain::add(ShaderPrimitiveSorter::remove, "ShaderPrimitiveSorter::remove");
 }
 
@@ -977,6 +1554,19 @@ void ShaderPrimitiveSorter::remove()
 
 	ms_defaultEnvironmentTexture->release();
 	ms_defaultEnvironmentTexture = NULL;
+
+	std::vector<Phase::Entry>().swap(ms_radixSortScratch);
+
+	DebugFlags::unregisterFlag(s_disableDrawRecordingThreads);
+	DebugFlags::unregisterFlag(s_reportDrawRecording);
+
+	delete s_drawRecordingWorkerPool;
+	s_drawRecordingWorkerPool = NULL;
+	s_drawRecordingEnabled = false;
+
+	std::for_each(s_commandBuffers.begin(), s_commandBuffers.end(), PointerDeleter());
+	CommandBuffers().swap(s_commandBuffers);
+	std::vector<int>().swap(s_numberOfDeferredEntries);
 }
 
 // ----------------------------------------------------------------------
@@ -1129,7 +1719,21 @@ void ShaderPrimitiveSorter::disableLight(const Light &light)
 
 void ShaderPrimitiveSorter::setLights(const LightBitSet &lightBitSet)
 {
-	ms_activeLightList.clear();	
+	getLights(lightBitSet, ms_activeLightList);
+	Graphics::setLights(ms_activeLightList);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Gather the lights of the current cell that are set in a light bit set.
+ *
+ * This only reads the light list, so the threads recording a phase may
+ * call it.
+ */
+
+void ShaderPrimitiveSorter::getLights(const LightBitSet &lightBitSet, LightList &lightList)
+{
+	lightList.clear();
 
 	// check all the lights to see which ones are currently active
 	const uint offset = ms_lightListStackOffset.back();
@@ -1138,10 +1742,8 @@ void ShaderPrimitiveSorter::setLights(const LightBitSet &lightBitSet)
 		if (lightBitSet[i])
 		{
 			const Light *light = ms_lightList[offset + i];
-			ms_activeLightList.push_back(light);
+			lightList.push_back(light);
 		}
-
-	Graphics::setLights(ms_activeLightList);
 }
 
 // ----------------------------------------------------------------------
@@ -1536,6 +2138,116 @@ void ShaderPrimitiveSorter::setUseWaterTests(bool b)
 	ms_useWaterTests = b;
 }
 
+//----------------------------------------------------------------------
+/**
+ * Enable or disable recording phases into command buffers.
+ *
+ * Recording starts enabled when [ClientGraphics] drawRecordingThreadCount is
+ * positive.  Enabling it without worker threads records each phase on the
+ * main thread.
+ */
+
+void ShaderPrimitiveSorter::setDrawRecordingEnabled(bool enabled)
+{
+	s_drawRecordingEnabled = enabled;
+}
+
+//----------------------------------------------------------------------
+
+bool ShaderPrimitiveSorter::isDrawRecordingEnabled()
+{
+	return s_drawRecordingEnabled;
+}
+
+//----------------------------------------------------------------------
+
+void ShaderPrimitiveSorter::setDrawRecordingThreadsEnabled(bool enabled)
+{
+	s_disableDrawRecordingThreads = !enabled;
+}
+
+//----------------------------------------------------------------------
+
+bool ShaderPrimitiveSorter::isDrawRecordingThreadsEnabled()
+{
+	return !s_disableDrawRecordingThreads;
+}
+
+//----------------------------------------------------------------------
+
+int ShaderPrimitiveSorter::getDrawRecordingThreadCount()
+{
+	return s_drawRecordingWorkerPool ? s_drawRecordingWorkerPool->getNumberOfThreads() : 0;
+}
+
+//----------------------------------------------------------------------
+
+int ShaderPrimitiveSorter::getNumberOfRecordedEntriesLastFrame()
+{
+	IGNORE_RETURN(getRecordingStatistics());
+	return s_lastFrameRecordingStatistics.numberOfRecordedEntries;
+}
+
+//----------------------------------------------------------------------
+
+int ShaderPrimitiveSorter::getNumberOfDeferredEntriesLastFrame()
+{
+	IGNORE_RETURN(getRecordingStatistics());
+	return s_lastFrameRecordingStatistics.numberOfDeferredEntries;
+}
+
+//----------------------------------------------------------------------
+
+int ShaderPrimitiveSorter::getNumberOfRecordedCommandsLastFrame()
+{
+	IGNORE_RETURN(getRecordingStatistics());
+	return s_lastFrameRecordingStatistics.numberOfCommands;
+}
+
+//----------------------------------------------------------------------
+
+int ShaderPrimitiveSorter::getNumberOfRecordedDrawCallsLastFrame()
+{
+	IGNORE_RETURN(getRecordingStatistics());
+	return s_lastFrameRecordingStatistics.numberOfDrawCalls;
+}
+
+//----------------------------------------------------------------------
+
+int ShaderPrimitiveSorter::getRecordedBytesLastFrame()
+{
+	IGNORE_RETURN(getRecordingStatistics());
+	return s_lastFrameRecordingStatistics.numberOfBytes;
+}
+
+//----------------------------------------------------------------------
+/**
+ * Get a checksum of every command recorded in the last frame, in execution
+ * order.  It does not depend on how the phases were split between jobs.
+ */
+
+uint32 ShaderPrimitiveSorter::getRecordedChecksumLastFrame()
+{
+	IGNORE_RETURN(getRecordingStatistics());
+	return s_lastFrameRecordingStatistics.checksum;
+}
+
+//----------------------------------------------------------------------
+
+float ShaderPrimitiveSorter::getDrawRecordTimeLastFrame()
+{
+	IGNORE_RETURN(getRecordingStatistics());
+	return s_lastFrameRecordingStatistics.recordTime;
+}
+
+//----------------------------------------------------------------------
+
+float ShaderPrimitiveSorter::getDrawExecuteTimeLastFrame()
+{
+	IGNORE_RETURN(getRecordingStatistics());
+	return s_lastFrameRecordingStatistics.executeTime;
+}
+
 //----------------------------------------------------------------------
 
 bool ShaderPrimitiveSorter::getHeatShadersCapable()
@@ -1561,7 +2273,7 @@ void ShaderPrimitiveSorter::debugDump ()
 
 	for (int j = 0; j < count; ++j)
 	{
-		DEBUG_REPORT_PRINT(true, ("%20s : %1.5f %3i%%\n", ms_debugPhase[j].name, ms_phase[j].getFrameDrawTime(), static_cast<int> (100.f * ms_phase[j].getFrameDrawTime() / totalTime)));
+		DEBUG_REPORT_PRINT(true, ("%20s : %1.5f %3i%%  sort %1.5f (%d)\n", ms_debugPhase[j].name, ms_phase[j].getFrameDrawTime(), static_cast<int> (100.f * ms_phase[j].getFrameDrawTime() / totalTime), ms_phase[j].getFrameSortTime(), ms_phase[j].getFrameSortCount()));
 		ms_phase[j].clearFrameDrawTime();
 	}
 }
@@ -103,6 +103,21 @@ public:
 
 	static bool getHeatShadersCapable();
 
+	static void   setDrawRecordingEnabled(bool enabled);
+	static bool   isDrawRecordingEnabled();
+	static void   setDrawRecordingThreadsEnabled(bool enabled);
+	static bool   isDrawRecordingThreadsEnabled();
+	static int    getDrawRecordingThreadCount();
+
+	static int    getNumberOfRecordedEntriesLastFrame();
+	static int    getNumberOfDeferredEntriesLastFrame();
+	static int    getNumberOfRecordedCommandsLastFrame();
+	static int    getNumberOfRecordedDrawCallsLastFrame();
+	static int    getRecordedBytesLastFrame();
+	static uint32 getRecordedChecksumLastFrame();
+	static float  getDrawRecordTimeLastFrame();
+	static float  getDrawExecuteTimeLastFrame();
+
 	static bool startCompositing(ShaderPrimitive const & shaderPrimitive, int & sectionRectX0, int & sectionRectY0, int & sectionRectX1, int & sectionRectY1);
 	static void finishCompositing(int sectionRectX0, int sectionRectY0, int sectionRectX1, int sectionRectY1, StaticShader & compositingShader);
 
@@ -130,6 +145,7 @@ private:
 
 	static void remove();
 	static void setLights(const LightBitSet &);
+	static void getLights(const LightBitSet &, LightList &lightList);
 	static void pushCell(CellProperty const * cellProperty, Texture const * environmentTexture, bool fogEnabled, float fogDensity, PackedArgb const & fogColor);
 
 #ifdef _DEBUG
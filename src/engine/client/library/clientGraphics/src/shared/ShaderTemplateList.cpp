@@ -9,6 +9,7 @@
 #include "clientGraphics/FirstClientGraphics.h"
 #include "clientGraphics/ShaderTemplateList.h"
 
+#include "clientGraphics/ShaderCache.h"
 #include "clientGraphics/StaticShader.h"
 #include "sharedDebug/DataLint.h"
 #include "sharedFile/AsynchronousLoader.h"
@@ -220,7 +221,7 @@ const ShaderTemplate *ShaderTemplateList::fetch(const CrcString &name, bool crea
 			if (create)
 			{
 				Iff iff;
-				if (!iff.open(name.getString(), true))
+				if (!ShaderCache::open(iff, name.getString(), true))
 				{
 					error = true;
 					WARNING(true, ("could not open shader template %s", name.getString()));
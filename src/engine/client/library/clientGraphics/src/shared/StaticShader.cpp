@@ -17,6 +17,7 @@
 #include "clientGraphics/StaticShaderTemplate.h"
 #include "clientGraphics/Texture.h"
 #include "clientGraphics/TextureList.h"
+#include "clientGraphics/TextureStreamer.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/MemoryBlockManager.h"
 
@@ -562,6 +563,46 @@ bool StaticShader::getTexture(Tag tag, const Texture *&texture) const
 	return true;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Report the projected screen size of a primitive drawn with this shader to
+ * the streamed textures it uses.
+ */
+
+void StaticShader::reportTextureScreenSize(float const screenSize) const
+{
+	if (!m_textureDataMap)
+		return;
+
+	const StaticShaderTemplate::TextureDataMap::const_iterator end = m_textureDataMap->end();
+	for (StaticShaderTemplate::TextureDataMap::const_iterator i = m_textureDataMap->begin(); i != end; ++i)
+	{
+		Texture const * const texture = i->second.texture;
+		if (texture && texture->isStreamed())
+			texture->reportScreenSize(screenSize);
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Bring the streamed textures of this shader to their top level before it
+ * is drawn somewhere the streamer does not see, like a baked texture.
+ */
+
+void StaticShader::loadTextureTopMipmapLevels() const
+{
+	if (!m_textureDataMap)
+		return;
+
+	const StaticShaderTemplate::TextureDataMap::const_iterator end = m_textureDataMap->end();
+	for (StaticShaderTemplate::TextureDataMap::const_iterator i = m_textureDataMap->begin(); i != end; ++i)
+	{
+		Texture const * const texture = i->second.texture;
+		if (texture && texture->isStreamed())
+			TextureStreamer::loadTopMipmapLevel(*texture);
+	}
+}
+
 // ----------------------------------------------------------------------
 
 bool StaticShader::getTextureCoordinateSet(Tag tag, uint8 &textureCoordinateSet) const
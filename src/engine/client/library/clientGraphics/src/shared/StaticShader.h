@@ -91,6 +91,9 @@ public:
 	bool           hasTextureFactor(Tag tag) const;
 	bool           hasTextureScroll(Tag tag) const;
 
+	void           reportTextureScreenSize(float screenSize) const;
+	void           loadTextureTopMipmapLevels() const;
+
 	bool isHeatPass(int pass) const;
 
 	virtual const StaticShader *getStaticShader() const;
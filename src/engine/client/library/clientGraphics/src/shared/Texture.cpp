@@ -15,6 +15,7 @@
 #include "clientGraphics/Graphics.h"
 #include "clientGraphics/TextureFormatInfo.h"
 #include "clientGraphics/TextureList.h"
+#include "clientGraphics/TextureStreamer.h"
 #include "sharedDebug/DataLint.h"
 #include "sharedFile/Iff.h"
 #include "sharedFile/TreeFile.h"
@@ -22,6 +23,7 @@
 #include "sharedFoundation/MemoryBlockManager.h"
 #include "sharedFoundation/Production.h"
 
+#include <algorithm>
 #include <vector>
 
 #if defined(CLIENTGRAPHICS_ENABLE_LIBPNG)
@@ -213,7 +215,16 @@ Texture::Texture(CrcString const & fileName)
 	m_mipmapLevelCount(0),
 	m_graphicsData(0),
 	m_representativeColorComputed(0),
-	m_representativeColor()
+	m_representativeColor(),
+	m_streamingWidth(0),
+	m_streamingHeight(0),
+	m_streamingMipmapLevelCount(0),
+	m_streamingLowestMipmapLevel(0),
+	m_residentMipmapLevel(0),
+	m_targetMipmapLevel(0),
+	m_requestedMipmapLevel(-1),
+	m_screenSizeFrameNumber(-1),
+	m_screenSize(0.0f)
 {
 	load(m_crcString.getString());
 }
@@ -238,7 +249,16 @@ Texture::Texture(int alpha, int red, int green, int blue)
 	m_mipmapLevelCount(1),
 	m_graphicsData(0),
 	m_representativeColorComputed(0),
-	m_representativeColor()
+	m_representativeColor(),
+	m_streamingWidth(0),
+	m_streamingHeight(0),
+	m_streamingMipmapLevelCount(0),
+	m_streamingLowestMipmapLevel(0),
+	m_residentMipmapLevel(0),
+	m_targetMipmapLevel(0),
+	m_requestedMipmapLevel(-1),
+	m_screenSizeFrameNumber(-1),
+	m_screenSize(0.0f)
 {
 	TextureFormat sourceFormat = TF_ARGB_8888;
 
@@ -277,7 +297,16 @@ Texture::Texture(const void *newPixelData, TextureFormat newFormat, int newWidth
 	m_mipmapLevelCount(1),
 	m_graphicsData(0),
 	m_representativeColorComputed(0),
-	m_representativeColor()
+	m_representativeColor(),
+	m_streamingWidth(0),
+	m_streamingHeight(0),
+	m_streamingMipmapLevelCount(0),
+	m_streamingLowestMipmapLevel(0),
+	m_residentMipmapLevel(0),
+	m_targetMipmapLevel(0),
+	m_requestedMipmapLevel(-1),
+	m_screenSizeFrameNumber(-1),
+	m_screenSize(0.0f)
 {
 	m_graphicsData = Graphics::createTextureData(*this, runtimeFormatArray, runtimeFormatCount);
 
@@ -324,7 +353,16 @@ Texture::Texture(int creationFlags, int newWidth, int newHeight, int numberOfMip
 	m_mipmapLevelCount(numberOfMipMapLevels),
 	m_graphicsData(NULL),
 	m_representativeColorComputed(0),
-	m_representativeColor()
+	m_representativeColor(),
+	m_streamingWidth(0),
+	m_streamingHeight(0),
+	m_streamingMipmapLevelCount(0),
+	m_streamingLowestMipmapLevel(0),
+	m_residentMipmapLevel(0),
+	m_targetMipmapLevel(0),
+	m_requestedMipmapLevel(-1),
+	m_screenSizeFrameNumber(-1),
+	m_screenSize(0.0f)
 {
 	m_graphicsData = Graphics::createTextureData(*this, runtimeTextureFormats, textureFormatCount);
 }
@@ -333,6 +371,9 @@ Texture::Texture(int creationFlags, int newWidth, int newHeight, int numberOfMip
 
 Texture::~Texture(void)
 {
+	if (isStreamed())
+		TextureStreamer::removeTexture(this);
+
 	delete m_graphicsData;
 }
 
@@ -519,8 +560,43 @@ void Texture::load(const char * fileName)
 		DEBUG_FATAL(strcmp(fileName, TextureList::getDefaultTextureName()) == 0, ("Could not open default texture"));
 		WARNING(true, ("Could not open texture %s", fileName));
 		IGNORE_RETURN(loadDefaultTexture(fileName));
-		return;
 	}
+	else
+		load(fileName, fileInterface, -1);
+
+	//-- register with the streamer after the load, a missing file may have fallen back to the default texture
+	if (isStreamed())
+		TextureStreamer::addTexture(this);
+	else
+		TextureStreamer::removeTexture(this);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Load the texture from an open file.
+ *
+ * Streamed textures only load the levels at and below residentMipmapLevel.
+ * Passing -1 keeps the level that is already resident, or starts a new
+ * streamed texture at the lowest level it may shrink to.
+ *
+ * @param fileName             The name of the texture file.
+ * @param fileInterface        The open file, which this function deletes.
+ * @param residentMipmapLevel  The level of the file to load as level 0.
+ */
+
+void Texture::load(const char * fileName, AbstractFile *fileInterface, int residentMipmapLevel)
+{
+	NOT_NULL(fileInterface);
+
+	bool const wasStreamed = isStreamed();
+	int const  previousResidentMipmapLevel = m_residentMipmapLevel;
+	int const  previousWidth = m_width;
+	int const  previousHeight = m_height;
+	int const  previousDepth = m_depth;
+	int const  previousMipmapLevelCount = m_mipmapLevelCount;
+
+	m_streamingMipmapLevelCount = 0;
+	m_residentMipmapLevel = 0;
 
 	unsigned char signature[8] = {0};
 	const int signatureRead = fileInterface->read(signature, sizeof(signature));
@@ -813,32 +889,59 @@ void Texture::load(const char * fileName)
 	}
 #endif
 
-	// option to discard top mipmap levels for texture memory & performance
-	int pleaseDiscard = ms_discardHighestMipMapLevels;
-	if (isNormalMapName != NULL && ms_discardHighestNormalMipMapLevels > ms_discardHighestMipMapLevels)
-		pleaseDiscard = ms_discardHighestNormalMipMapLevels;
-	int numberOfHighestMipmapLevelsToDiscard = clamp(0, pleaseDiscard, m_mipmapLevelCount - 1);
-	if (numberOfHighestMipmapLevelsToDiscard)
+	int numberOfHighestMipmapLevelsToDiscard = 0;
+
+	// the streamer picks the top level of mipmapped 2d textures, dxt compressed textures can be no smaller than 4x4
+	int const lowestMipmapLevel = (!m_cube && !m_volume && m_mipmapLevelCount > 1 && TextureStreamer::isStreamable(fileName)) ? TextureStreamer::getLowestMipmapLevel(m_width, m_height, m_mipmapLevelCount, dxt ? 4 : 1) : 0;
+	if (lowestMipmapLevel > 0)
 	{
-		if (dxt)
-		{
-			// dxt compressed textures can be no smaller than 4x4
-			while (((m_width >> numberOfHighestMipmapLevelsToDiscard) < 4) || ((m_height >> numberOfHighestMipmapLevelsToDiscard) < 4) || ((m_depth >> numberOfHighestMipmapLevelsToDiscard) < 4))
-				--numberOfHighestMipmapLevelsToDiscard;
-		}
-		else
+		m_streamingWidth = m_width;
+		m_streamingHeight = m_height;
+		m_streamingMipmapLevelCount = m_mipmapLevelCount;
+		m_streamingLowestMipmapLevel = lowestMipmapLevel;
+
+		if (residentMipmapLevel < 0)
+			residentMipmapLevel = wasStreamed ? previousResidentMipmapLevel : m_streamingLowestMipmapLevel;
+
+		numberOfHighestMipmapLevelsToDiscard = clamp(0, residentMipmapLevel, m_streamingLowestMipmapLevel);
+		m_residentMipmapLevel = numberOfHighestMipmapLevelsToDiscard;
+
+		if (!wasStreamed)
 		{
-			// normal textures can be no smaller than 1x1
-			while (((m_width >> numberOfHighestMipmapLevelsToDiscard) < 1) || ((m_height >> numberOfHighestMipmapLevelsToDiscard) < 1) || ((m_depth >> numberOfHighestMipmapLevelsToDiscard) < 1))
-				--numberOfHighestMipmapLevelsToDiscard;
+			m_targetMipmapLevel = m_residentMipmapLevel;
+			m_requestedMipmapLevel = -1;
 		}
-	
-		m_width >>= numberOfHighestMipmapLevelsToDiscard;
-		m_height >>= numberOfHighestMipmapLevelsToDiscard;
-		m_depth >>= numberOfHighestMipmapLevelsToDiscard;
+	}
+	else
+	{
+		// option to discard top mipmap levels for texture memory & performance
+		int pleaseDiscard = ms_discardHighestMipMapLevels;
+		if (isNormalMapName != NULL && ms_discardHighestNormalMipMapLevels > ms_discardHighestMipMapLevels)
+			pleaseDiscard = ms_discardHighestNormalMipMapLevels;
+		numberOfHighestMipmapLevelsToDiscard = clamp(0, pleaseDiscard, m_mipmapLevelCount - 1);
+
+		// dxt compressed textures can be no smaller than 4x4, normal textures no smaller than 1x1
+		int const minimumSize = dxt ? 4 : 1;
+		while (numberOfHighestMipmapLevelsToDiscard > 0 && (((m_width >> numberOfHighestMipmapLevelsToDiscard) < minimumSize) || ((m_height >> numberOfHighestMipmapLevelsToDiscard) < minimumSize) || (m_volume && ((m_depth >> numberOfHighestMipmapLevelsToDiscard) < minimumSize))))
+			--numberOfHighestMipmapLevelsToDiscard;
+	}
+
+	if (numberOfHighestMipmapLevelsToDiscard)
+	{
+		m_width = std::max(1, m_width >> numberOfHighestMipmapLevelsToDiscard);
+		m_height = std::max(1, m_height >> numberOfHighestMipmapLevelsToDiscard);
+		m_depth = std::max(1, m_depth >> numberOfHighestMipmapLevelsToDiscard);
 		m_mipmapLevelCount -= numberOfHighestMipmapLevelsToDiscard;
 	}
 
+	// a reload or a streamed level change may need surfaces of a different size, keep the old data alive until the new data is filled
+	TextureGraphicsData *previousGraphicsData = 0;
+	if (m_graphicsData && (m_width != previousWidth || m_height != previousHeight || m_depth != previousDepth || m_mipmapLevelCount != previousMipmapLevelCount))
+	{
+		previousGraphicsData = m_graphicsData;
+		m_graphicsData = 0;
+	}
+
 	if (!m_graphicsData)
 		m_graphicsData = Graphics::createTextureData(*this, ms_conversions[sourceFormat], ms_conversionCount[sourceFormat]);
 
@@ -854,6 +957,97 @@ void Texture::load(const char * fileName)
 	}
 
 	delete fileInterface;
+	delete previousGraphicsData;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Drop the top levels of a streamed texture without reading its file.
+ *
+ * The remaining levels are copied from the current graphics data into
+ * smaller graphics data of the same native format.
+ *
+ * @param residentMipmapLevel  The level of the file to keep as level 0.
+ */
+
+void Texture::discardMipmapLevels(int const residentMipmapLevel)
+{
+	DEBUG_FATAL(!isStreamed(), ("Texture %s is not streamed", getName()));
+	NOT_NULL(m_graphicsData);
+
+	int const discardCount = std::min(residentMipmapLevel, m_streamingLowestMipmapLevel) - m_residentMipmapLevel;
+	if (discardCount <= 0 || discardCount >= m_mipmapLevelCount)
+		return;
+
+	TextureFormat const            format = m_graphicsData->getNativeFormat();
+	TextureFormatInfo const       &tfi = TextureFormatInfo::getInfo(format);
+	TextureGraphicsData *const     previousGraphicsData = m_graphicsData;
+
+	m_width = std::max(1, m_width >> discardCount);
+	m_height = std::max(1, m_height >> discardCount);
+	m_mipmapLevelCount -= discardCount;
+	m_residentMipmapLevel += discardCount;
+
+	m_graphicsData = Graphics::createTextureData(*this, &format, 1);
+
+	for (int level = 0; level < m_mipmapLevelCount; ++level)
+	{
+		int const width  = std::max(1, m_width >> level);
+		int const height = std::max(1, m_height >> level);
+
+		// compressed levels are copied in rows of blocks
+		int rowByteCount = 0;
+		int rowCount = 0;
+		if (tfi.compressed)
+		{
+			rowByteCount = (width + tfi.blockWidth - 1) / tfi.blockWidth * tfi.blockSize;
+			rowCount     = (height + tfi.blockHeight - 1) / tfi.blockHeight;
+		}
+		else
+		{
+			rowByteCount = width * tfi.pixelByteCount;
+			rowCount     = height;
+		}
+
+		LockData source(format, CF_none, level + discardCount, 0, 0, 0, width, height, 1, false);
+		source.m_readOnly = true;
+		previousGraphicsData->lock(source);
+
+		LockData destination(format, CF_none, level, 0, 0, 0, width, height, 1, true);
+		destination.m_readOnly = false;
+		m_graphicsData->lock(destination);
+
+			uint8 const *sourceRow      = reinterpret_cast<uint8 const *>(source.getPixelData());
+			uint8       *destinationRow = reinterpret_cast<uint8 *>(destination.getPixelData());
+			for (int row = 0; row < rowCount; ++row, sourceRow += source.getPitch(), destinationRow += destination.getPitch())
+				imemcpy(destinationRow, sourceRow, rowByteCount);
+
+		m_graphicsData->unlock(destination);
+		previousGraphicsData->unlock(source);
+	}
+
+	delete previousGraphicsData;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Record the projected size of a surface using this texture this frame.
+ *
+ * The TextureStreamer keeps the largest size reported during a frame.
+ *
+ * @param screenSize  The size in pixels the texture's top level would cover.
+ */
+
+void Texture::reportScreenSize(float const screenSize) const
+{
+	int const frameNumber = Graphics::getFrameNumber();
+	if (m_screenSizeFrameNumber != frameNumber)
+	{
+		m_screenSizeFrameNumber = frameNumber;
+		m_screenSize = screenSize;
+	}
+	else if (screenSize > m_screenSize)
+		m_screenSize = screenSize;
 }
 
 // ----------------------------------------------------------------------
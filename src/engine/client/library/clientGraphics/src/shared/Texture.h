@@ -107,6 +107,7 @@ class Texture
 	friend class Direct3d9;
 	friend class Direct3d9_RenderTarget;
 	friend class TextureList;
+	friend class TextureStreamer;
 	friend class Graphics;
 
 public:
@@ -132,6 +133,18 @@ private:
 	mutable uint8                            m_representativeColorComputed;
 	mutable PackedArgb                       m_representativeColor;
 
+	// Streaming state, the mipmap levels count from the top level stored in the file
+
+	int                                      m_streamingWidth;
+	int                                      m_streamingHeight;
+	int                                      m_streamingMipmapLevelCount;     // 0 if the texture is not streamed
+	int                                      m_streamingLowestMipmapLevel;    // Smallest top level the texture may shrink to
+	int                                      m_residentMipmapLevel;           // File level loaded as level 0
+	int                                      m_targetMipmapLevel;
+	int                                      m_requestedMipmapLevel;          // Level being read by the TextureStreamer, -1 if none
+	mutable int                              m_screenSizeFrameNumber;
+	mutable float                            m_screenSize;
+
 private:
 
 	// disabled
@@ -154,6 +167,8 @@ private:
 	void                  loadSurface(TextureFormat format, CubeFace face, AbstractFile *fileInterface, int numberOfHighestMipmapLevelsToDiscard, int numberOfLowestMipmapLevelsToDiscard);
 	bool                  loadDefaultTexture(char const *failedFileName);
 	void                  load(const char * fileName);
+	void                  load(const char * fileName, AbstractFile *fileInterface, int residentMipmapLevel);
+	void                  discardMipmapLevels(int residentMipmapLevel);
 
 	~Texture(void);
 
@@ -181,6 +196,10 @@ public:
 	int                   getMipmapLevelCount(void) const;
 	TextureFormat         getNativeFormat() const;
 
+	bool                  isStreamed() const;
+	int                   getResidentMipmapLevel() const;
+	void                  reportScreenSize(float screenSize) const;
+
 	void                  lock(LockData &lockData);
 	void                  lockReadOnly(LockData &lockData) const;
 	void                  unlock(LockData &lockData) const;
@@ -419,6 +438,31 @@ inline int Texture::getMipmapLevelCount(void) const
 	return m_mipmapLevelCount;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Check whether the TextureStreamer manages the mipmap levels of this texture.
+ *
+ * The width, height and mipmap level count of a streamed texture describe
+ * the levels that are currently resident, which may be smaller than the
+ * texture in the file.
+ */
+
+inline bool Texture::isStreamed() const
+{
+	return m_streamingMipmapLevelCount > 0;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the level of the file that is resident as level 0, which is 0 for
+ * textures that are not streamed.
+ */
+
+inline int Texture::getResidentMipmapLevel() const
+{
+	return m_residentMipmapLevel;
+}
+
 // ----------------------------------------------------------------------
 /**
  * Return a read-only version of the texture's name.
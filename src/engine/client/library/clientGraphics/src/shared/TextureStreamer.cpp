@@ -0,0 +1,735 @@
+// ======================================================================
+//
+// TextureStreamer.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientGraphics/FirstClientGraphics.h"
+#include "clientGraphics/TextureStreamer.h"
+
+#include "clientGraphics/Camera.h"
+#include "clientGraphics/ConfigClientGraphics.h"
+#include "clientGraphics/Graphics.h"
+#include "clientGraphics/ShaderPrimitive.h"
+#include "clientGraphics/StaticShader.h"
+#include "clientGraphics/Texture.h"
+#include "clientGraphics/TextureFormatInfo.h"
+#include "sharedDebug/DebugFlags.h"
+#include "sharedFile/MemoryFile.h"
+#include "sharedFile/TreeFile.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedSynchronization/Mutex.h"
+#include "sharedSynchronization/Semaphore.h"
+#include "sharedThread/RunThread.h"
+#include "sharedThread/ThreadHandle.h"
+
+#include <algorithm>
+#include <deque>
+#include <set>
+#include <string>
+#include <vector>
+
+// ======================================================================
+
+namespace TextureStreamerNamespace
+{
+	struct Request
+	{
+		Texture      *texture;       // NULL once the texture has been destroyed
+		std::string   fileName;
+		int           mipmapLevel;
+		AbstractFile *file;
+		bool          quit;
+	};
+
+	struct Candidate
+	{
+		Texture *texture;
+		float    priority;
+	};
+
+	typedef stdset<Texture *>::fwd        TextureSet;
+	typedef stddeque<Request *>::fwd      RequestQueue;
+	typedef stdvector<Candidate>::fwd     Candidates;
+	typedef stdvector<std::string>::fwd   ExcludedPrefixes;
+
+	int const          cs_unseenFrameCount       = 30;
+	int const          cs_maximumPendingRequests = 16;
+	char const * const cs_excludedPrefixes[]     = { "texture/ui" };
+
+	void  threadRoutine();
+	bool  sortByPriority(Candidate const &lhs, Candidate const &rhs);
+	bool  sortByPriorityDescending(Candidate const &lhs, Candidate const &rhs);
+	void  debugReport();
+
+	bool               ms_installed;
+	bool               ms_enabled;
+	bool               ms_reportTextureStreaming;
+	int                ms_memoryBudget;
+	int                ms_minimumSize;
+	int                ms_uploadBudget;
+	int                ms_mipmapBias;
+
+	TextureSet        *ms_textures;
+	ExcludedPrefixes  *ms_excludedPrefixes;
+	Candidates        *ms_candidates;
+
+	ThreadHandle       ms_threadHandle;
+	Semaphore          ms_requestsPending;
+	Mutex              ms_mutex;
+	RequestQueue      *ms_pendingRequests;
+	RequestQueue      *ms_completedRequests;
+
+	int                ms_numberOfPendingRequests;
+	int                ms_numberOfBlurryTextures;
+	int                ms_residentMemory;
+	int                ms_targetMemory;
+	int                ms_uploadedBytesLastFrame;
+	int                ms_totalUploadedBytes;
+}
+
+using namespace TextureStreamerNamespace;
+
+// ======================================================================
+
+void TextureStreamer::install()
+{
+	DEBUG_FATAL(ms_installed, ("TextureStreamer already installed"));
+
+	ms_enabled      = ConfigClientGraphics::getTextureStreamingEnabled();
+	ms_memoryBudget = clamp(1, ConfigClientGraphics::getTextureStreamingBudgetMB(), 2047) * 1024 * 1024;
+	ms_minimumSize  = std::max(1, ConfigClientGraphics::getTextureStreamingMinimumSize());
+	ms_uploadBudget = std::max(1, ConfigClientGraphics::getTextureStreamingUploadBudgetKB()) * 1024;
+	ms_mipmapBias   = ConfigClientGraphics::getTextureStreamingMipmapBias();
+
+	ms_textures          = new TextureSet;
+	ms_candidates        = new Candidates;
+	ms_pendingRequests   = new RequestQueue;
+	ms_completedRequests = new RequestQueue;
+
+	ms_excludedPrefixes = new ExcludedPrefixes;
+	for (int i = 0; i < static_cast<int>(sizeof(cs_excludedPrefixes) / sizeof(cs_excludedPrefixes[0])); ++i)
+		ms_excludedPrefixes->push_back(cs_excludedPrefixes[i]);
+
+	for (int i = 0; ; ++i)
+	{
+		char const * const prefix = ConfigFile::getKeyString("ClientGraphics", "textureStreamingExclude", i, 0);
+		if (!prefix)
+			break;
+
+		ms_excludedPrefixes->push_back(prefix);
+	}
+
+	ms_threadHandle = runNamedThread("TextureStreamer", threadRoutine);
+
+	DebugFlags::registerFlag(ms_reportTextureStreaming, "ClientGraphics", "reportTextureStreaming", debugReport);
+
+	ms_installed = true;
+	ExitChain::add(remove, "TextureStreamer::remove");
+}
+
+// ----------------------------------------------------------------------
+
+void TextureStreamer::remove()
+{
+	DEBUG_FATAL(!ms_installed, ("TextureStreamer not installed"));
+	ms_installed = false;
+
+	DebugFlags::unregisterFlag(ms_reportTextureStreaming);
+
+	//-- stop the worker after it has finished the requests ahead of the quit request
+	Request * const quitRequest = new Request;
+	quitRequest->texture = 0;
+	quitRequest->mipmapLevel = 0;
+	quitRequest->file = 0;
+	quitRequest->quit = true;
+
+	ms_mutex.enter();
+		ms_pendingRequests->push_back(quitRequest);
+	ms_mutex.leave();
+
+	ms_requestsPending.signal();
+	ms_threadHandle->wait();
+
+	while (!ms_completedRequests->empty())
+	{
+		Request * const request = ms_completedRequests->front();
+		ms_completedRequests->pop_front();
+
+		delete request->file;
+		delete request;
+	}
+
+	delete ms_completedRequests;
+	ms_completedRequests = 0;
+	delete ms_pendingRequests;
+	ms_pendingRequests = 0;
+	delete ms_excludedPrefixes;
+	ms_excludedPrefixes = 0;
+	delete ms_candidates;
+	ms_candidates = 0;
+	delete ms_textures;
+	ms_textures = 0;
+
+	ms_numberOfPendingRequests = 0;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Pick up the levels read by the worker thread, choose the level each
+ * streamed texture should have and start moving them towards it.
+ *
+ * This is called once a frame, after the frame has been drawn and every
+ * visible texture has been given its screen size.
+ */
+
+void TextureStreamer::update()
+{
+	if (!ms_installed)
+		return;
+
+	processCompletedRequests();
+
+	if (ms_textures->empty())
+	{
+		ms_numberOfBlurryTextures = 0;
+		ms_residentMemory = 0;
+		ms_targetMemory = 0;
+		return;
+	}
+
+	selectTargetMipmapLevels();
+	applyTargetMipmapLevels();
+}
+
+// ----------------------------------------------------------------------
+
+bool TextureStreamer::isEnabled()
+{
+	return ms_installed && ms_enabled;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Enable or disable streaming.
+ *
+ * Textures loaded while streaming is disabled are loaded whole, and the
+ * textures that are already streamed are brought back to their top level.
+ */
+
+void TextureStreamer::setEnabled(bool const enabled)
+{
+	ms_enabled = enabled;
+}
+
+// ----------------------------------------------------------------------
+
+int TextureStreamer::getMemoryBudget()
+{
+	return ms_memoryBudget;
+}
+
+// ----------------------------------------------------------------------
+
+void TextureStreamer::setMemoryBudget(int const memoryBudget)
+{
+	ms_memoryBudget = std::max(0, memoryBudget);
+}
+
+// ----------------------------------------------------------------------
+
+bool TextureStreamer::isStreamable(char const * const fileName)
+{
+	if (!isEnabled() || !fileName)
+		return false;
+
+	ExcludedPrefixes::const_iterator const end = ms_excludedPrefixes->end();
+	for (ExcludedPrefixes::const_iterator i = ms_excludedPrefixes->begin(); i != end; ++i)
+		if (strncmp(fileName, i->c_str(), i->size()) == 0)
+			return false;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the smallest top level a texture may be shrunk to.
+ *
+ * @param width             The width of the top level in the file.
+ * @param height            The height of the top level in the file.
+ * @param mipmapLevelCount  The number of levels in the file.
+ * @param minimumTopSize    The smallest size the format supports for a top level.
+ * @return The level, 0 if the texture is too small to stream.
+ */
+
+int TextureStreamer::getLowestMipmapLevel(int const width, int const height, int const mipmapLevelCount, int const minimumTopSize)
+{
+	int const minimumSize = std::max(ms_minimumSize, minimumTopSize);
+
+	int level = 0;
+	while (level + 1 < mipmapLevelCount && (width >> (level + 1)) >= minimumSize && (height >> (level + 1)) >= minimumSize)
+		++level;
+
+	return level;
+}
+
+// ----------------------------------------------------------------------
+
+void TextureStreamer::addTexture(Texture * const texture)
+{
+	if (!ms_installed)
+		return;
+
+	NOT_NULL(texture);
+	IGNORE_RETURN(ms_textures->insert(texture));
+}
+
+// ----------------------------------------------------------------------
+
+void TextureStreamer::removeTexture(Texture const * const texture)
+{
+	if (!ms_installed)
+		return;
+
+	if (ms_textures->erase(const_cast<Texture *>(texture)) == 0)
+		return;
+
+	//-- the worker only reads the file name, so the requests are kept and their results thrown away
+	ms_mutex.enter();
+
+		RequestQueue::iterator const pendingEnd = ms_pendingRequests->end();
+		for (RequestQueue::iterator i = ms_pendingRequests->begin(); i != pendingEnd; ++i)
+			if ((*i)->texture == texture)
+				(*i)->texture = 0;
+
+		RequestQueue::iterator const completedEnd = ms_completedRequests->end();
+		for (RequestQueue::iterator j = ms_completedRequests->begin(); j != completedEnd; ++j)
+			if ((*j)->texture == texture)
+				(*j)->texture = 0;
+
+	ms_mutex.leave();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Load the top level of a streamed texture now, reading its file on the
+ * calling thread.
+ *
+ * The level is only kept while the texture is seen, an unseen texture is
+ * lowered again by the next update().
+ */
+
+void TextureStreamer::loadTopMipmapLevel(Texture const &texture)
+{
+	if (!ms_installed || !texture.isStreamed() || texture.m_residentMipmapLevel == 0)
+		return;
+
+	Texture &streamedTexture = const_cast<Texture &>(texture);
+	std::string const fileName(texture.getName());
+
+	AbstractFile * const file = TreeFile::open(fileName.c_str(), AbstractFile::PriorityData, true);
+	if (!file)
+	{
+		WARNING(true, ("TextureStreamer: could not open %s", fileName.c_str()));
+		return;
+	}
+
+	streamedTexture.load(fileName.c_str(), file, 0);
+	streamedTexture.m_targetMipmapLevel = 0;
+
+	//-- a texture that fell back to a non-streamed load must not be left in a pending request
+	if (!streamedTexture.isStreamed())
+		removeTexture(&streamedTexture);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Report the projected size of a shader primitive to the textures it is
+ * drawn with.
+ *
+ * Primitives without a radius, or surrounding the camera, are treated as
+ * filling the viewport.
+ */
+
+void TextureStreamer::reportShaderPrimitive(ShaderPrimitive const &shaderPrimitive, StaticShader const &staticShader, Camera const &camera)
+{
+	float screenSize = static_cast<float>(std::max(camera.getViewportWidth(), camera.getViewportHeight()));
+
+	float const radius = shaderPrimitive.getRadius();
+	if (radius > 0.0f)
+	{
+		Vector const position_c = camera.rotateTranslate_p2o(shaderPrimitive.getPosition_w());
+		if (position_c.magnitudeSquared() > sqr(radius))
+		{
+			float screenRadius = 0.0f;
+			if (camera.computeRadiusInScreenSpace(position_c, radius, screenRadius))
+				screenSize = std::min(screenSize, 2.0f * screenRadius);
+		}
+	}
+
+	staticShader.reportTextureScreenSize(screenSize);
+}
+
+// ----------------------------------------------------------------------
+
+int TextureStreamer::getNumberOfStreamedTextures()
+{
+	return ms_installed ? static_cast<int>(ms_textures->size()) : 0;
+}
+
+// ----------------------------------------------------------------------
+
+int TextureStreamer::getNumberOfBlurryTextures()
+{
+	return ms_numberOfBlurryTextures;
+}
+
+// ----------------------------------------------------------------------
+
+int TextureStreamer::getNumberOfPendingRequests()
+{
+	return ms_numberOfPendingRequests;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Check whether every streamed texture had its target level resident at
+ * the last update().
+ */
+
+bool TextureStreamer::isSharp()
+{
+	return ms_numberOfBlurryTextures == 0 && ms_numberOfPendingRequests == 0;
+}
+
+// ----------------------------------------------------------------------
+
+int TextureStreamer::getResidentMemory()
+{
+	return ms_residentMemory;
+}
+
+// ----------------------------------------------------------------------
+
+int TextureStreamer::getTargetMemory()
+{
+	return ms_targetMemory;
+}
+
+// ----------------------------------------------------------------------
+
+int TextureStreamer::getUploadedBytesLastFrame()
+{
+	return ms_uploadedBytesLastFrame;
+}
+
+// ----------------------------------------------------------------------
+
+int TextureStreamer::getTotalUploadedBytes()
+{
+	return ms_totalUploadedBytes;
+}
+
+// ======================================================================
+
+void TextureStreamerNamespace::threadRoutine()
+{
+	for (;;)
+	{
+		ms_requestsPending.wait();
+
+		ms_mutex.enter();
+
+			Request * const request = ms_pendingRequests->front();
+			bool const quit = request->quit;
+			bool const wanted = request->texture != 0;
+
+		ms_mutex.leave();
+
+		if (!quit && wanted)
+		{
+			AbstractFile * const file = TreeFile::open(request->fileName.c_str(), AbstractFile::PriorityLow, true);
+			if (file)
+			{
+				if (file->isZlibCompressed())
+					request->file = file;
+				else
+				{
+					request->file = new MemoryFile(file);
+					delete file;
+				}
+			}
+		}
+
+		ms_mutex.enter();
+
+			ms_pendingRequests->pop_front();
+			if (!quit)
+				ms_completedRequests->push_back(request);
+
+		ms_mutex.leave();
+
+		if (quit)
+		{
+			delete request;
+			break;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+void TextureStreamer::submitRequest(Texture &texture, int const mipmapLevel)
+{
+	Request * const request = new Request;
+	request->texture = &texture;
+	request->fileName = texture.getName();
+	request->mipmapLevel = mipmapLevel;
+	request->file = 0;
+	request->quit = false;
+
+	texture.m_requestedMipmapLevel = mipmapLevel;
+	++ms_numberOfPendingRequests;
+
+	ms_mutex.enter();
+		ms_pendingRequests->push_back(request);
+	ms_mutex.leave();
+
+	ms_requestsPending.signal();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Load the levels read by the worker thread until the upload budget for
+ * this frame is spent.
+ */
+
+void TextureStreamer::processCompletedRequests()
+{
+	ms_uploadedBytesLastFrame = 0;
+
+	while (ms_uploadedBytesLastFrame < ms_uploadBudget)
+	{
+		ms_mutex.enter();
+
+			Request * const request = ms_completedRequests->empty() ? 0 : ms_completedRequests->front();
+			if (request)
+				ms_completedRequests->pop_front();
+
+		ms_mutex.leave();
+
+		if (!request)
+			break;
+
+		--ms_numberOfPendingRequests;
+
+		Texture * const texture = request->texture;
+		if (texture)
+		{
+			texture->m_requestedMipmapLevel = -1;
+
+			//-- the texture may have been lowered again while the file was read
+			int const mipmapLevel = std::max(request->mipmapLevel, texture->m_targetMipmapLevel);
+			if (request->file && mipmapLevel < texture->m_residentMipmapLevel)
+			{
+				texture->load(request->fileName.c_str(), request->file, mipmapLevel);
+				request->file = 0;
+
+				if (texture->isStreamed())
+				{
+					int const uploadedBytes = getMemorySize(*texture, texture->m_residentMipmapLevel);
+					ms_uploadedBytesLastFrame += uploadedBytes;
+					ms_totalUploadedBytes += uploadedBytes;
+				}
+				else
+					IGNORE_RETURN(ms_textures->erase(texture));
+			}
+			else
+				WARNING(!request->file, ("TextureStreamer: could not open %s", request->fileName.c_str()));
+		}
+
+		delete request->file;
+		delete request;
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Choose the level each texture needs for its screen size, then coarsen
+ * the least visible textures until the levels fit in the memory budget.
+ */
+
+void TextureStreamer::selectTargetMipmapLevels()
+{
+	int const frameNumber = Graphics::getFrameNumber();
+
+	ms_candidates->clear();
+	ms_targetMemory = 0;
+
+	TextureSet::const_iterator const end = ms_textures->end();
+	for (TextureSet::const_iterator i = ms_textures->begin(); i != end; ++i)
+	{
+		Texture * const texture = *i;
+
+		Candidate candidate;
+		candidate.texture = texture;
+
+		if (!ms_enabled)
+		{
+			texture->m_targetMipmapLevel = 0;
+			candidate.priority = 0.0f;
+		}
+		else if (isSeen(*texture, frameNumber))
+		{
+			texture->m_targetMipmapLevel = clamp(0, getMipmapLevelForScreenSize(*texture, texture->m_screenSize) + ms_mipmapBias, texture->m_streamingLowestMipmapLevel);
+			candidate.priority = texture->m_screenSize;
+		}
+		else
+		{
+			texture->m_targetMipmapLevel = texture->m_streamingLowestMipmapLevel;
+			candidate.priority = -1.0f;
+		}
+
+		ms_targetMemory += getMemorySize(*texture, texture->m_targetMipmapLevel);
+		ms_candidates->push_back(candidate);
+	}
+
+	if (!ms_enabled || ms_targetMemory <= ms_memoryBudget)
+		return;
+
+	std::sort(ms_candidates->begin(), ms_candidates->end(), sortByPriority);
+
+	Candidates::const_iterator const candidatesEnd = ms_candidates->end();
+	for (Candidates::const_iterator j = ms_candidates->begin(); j != candidatesEnd && ms_targetMemory > ms_memoryBudget; ++j)
+	{
+		Texture &texture = *j->texture;
+		while (texture.m_targetMipmapLevel < texture.m_streamingLowestMipmapLevel && ms_targetMemory > ms_memoryBudget)
+		{
+			ms_targetMemory -= getMemorySize(texture, texture.m_targetMipmapLevel);
+			++texture.m_targetMipmapLevel;
+			ms_targetMemory += getMemorySize(texture, texture.m_targetMipmapLevel);
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Drop the levels textures no longer need and request the levels they are
+ * missing, the most visible textures first.
+ */
+
+void TextureStreamer::applyTargetMipmapLevels()
+{
+	ms_numberOfBlurryTextures = 0;
+	ms_residentMemory = 0;
+
+	Candidates::iterator candidatesEnd = ms_candidates->begin();
+
+	Candidates::const_iterator const end = ms_candidates->end();
+	for (Candidates::const_iterator i = ms_candidates->begin(); i != end; ++i)
+	{
+		Texture &texture = *i->texture;
+
+		if (texture.m_targetMipmapLevel > texture.m_residentMipmapLevel)
+			texture.discardMipmapLevels(texture.m_targetMipmapLevel);
+		else if (texture.m_targetMipmapLevel < texture.m_residentMipmapLevel)
+		{
+			++ms_numberOfBlurryTextures;
+
+			// the candidates already visited are reused to hold the textures to upgrade
+			if (texture.m_requestedMipmapLevel < 0)
+				*candidatesEnd++ = *i;
+		}
+
+		ms_residentMemory += getMemorySize(texture, texture.m_residentMipmapLevel);
+	}
+
+	ms_candidates->erase(candidatesEnd, ms_candidates->end());
+
+	int const requestCount = std::min(static_cast<int>(ms_candidates->size()), cs_maximumPendingRequests - ms_numberOfPendingRequests);
+	if (requestCount <= 0)
+		return;
+
+	std::partial_sort(ms_candidates->begin(), ms_candidates->begin() + requestCount, ms_candidates->end(), sortByPriorityDescending);
+
+	for (int j = 0; j < requestCount; ++j)
+	{
+		Texture &texture = *(*ms_candidates)[static_cast<size_t>(j)].texture;
+		submitRequest(texture, texture.m_targetMipmapLevel);
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the memory used by a streamed texture with the given level resident.
+ */
+
+int TextureStreamer::getMemorySize(Texture const &texture, int const residentMipmapLevel)
+{
+	TextureFormatInfo const &tfi = TextureFormatInfo::getInfo(texture.getNativeFormat());
+
+	int size = 0;
+	for (int level = residentMipmapLevel; level < texture.m_streamingMipmapLevelCount; ++level)
+	{
+		int const width  = std::max(1, texture.m_streamingWidth >> level);
+		int const height = std::max(1, texture.m_streamingHeight >> level);
+
+		if (tfi.compressed)
+			size += ((width + tfi.blockWidth - 1) / tfi.blockWidth) * ((height + tfi.blockHeight - 1) / tfi.blockHeight) * tfi.blockSize;
+		else
+			size += width * height * tfi.pixelByteCount;
+	}
+
+	return size;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the smallest level that still has as many texels across as the
+ * texture covers pixels on screen.
+ */
+
+int TextureStreamer::getMipmapLevelForScreenSize(Texture const &texture, float const screenSize)
+{
+	int const size = std::max(texture.m_streamingWidth, texture.m_streamingHeight);
+
+	int level = 0;
+	while (level < texture.m_streamingLowestMipmapLevel && static_cast<float>(size >> (level + 1)) >= screenSize)
+		++level;
+
+	return level;
+}
+
+// ----------------------------------------------------------------------
+
+bool TextureStreamer::isSeen(Texture const &texture, int const frameNumber)
+{
+	return texture.m_screenSizeFrameNumber >= 0 && frameNumber - texture.m_screenSizeFrameNumber <= cs_unseenFrameCount;
+}
+
+// ----------------------------------------------------------------------
+
+bool TextureStreamerNamespace::sortByPriority(Candidate const &lhs, Candidate const &rhs)
+{
+	return lhs.priority < rhs.priority;
+}
+
+// ----------------------------------------------------------------------
+
+bool TextureStreamerNamespace::sortByPriorityDescending(Candidate const &lhs, Candidate const &rhs)
+{
+	return lhs.priority > rhs.priority;
+}
+
+// ----------------------------------------------------------------------
+
+void TextureStreamerNamespace::debugReport()
+{
+	DEBUG_REPORT_PRINT(true, ("TextureStreamer: %d textures, %d blurry, %d pending\n", TextureStreamer::getNumberOfStreamedTextures(), ms_numberOfBlurryTextures, ms_numberOfPendingRequests));
+	DEBUG_REPORT_PRINT(true, ("TextureStreamer: %d KB resident, %d KB target, %d KB budget\n", ms_residentMemory / 1024, ms_targetMemory / 1024, ms_memoryBudget / 1024));
+	DEBUG_REPORT_PRINT(true, ("TextureStreamer: %d KB uploaded this frame\n", ms_uploadedBytesLastFrame / 1024));
+}
+
+// ======================================================================
@@ -0,0 +1,95 @@
+// ======================================================================
+//
+// TextureStreamer.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_TextureStreamer_H
+#define INCLUDED_TextureStreamer_H
+
+// ======================================================================
+
+class Camera;
+class ShaderPrimitive;
+class StaticShader;
+class Texture;
+
+// ======================================================================
+/**
+ * Keeps the mipmap levels of textures resident according to how large they
+ * appear on screen.
+ *
+ * Streamed textures start with only their smallest levels resident.  Every
+ * shader primitive added to the ShaderPrimitiveSorter reports its projected
+ * size to the textures of its shader, and once a frame update() picks the
+ * level each texture needs.  When the levels wanted exceed the memory
+ * budget, the textures covering the fewest pixels are coarsened first.
+ *
+ * Dropping levels is done immediately from the resident data.  Adding
+ * levels reads the texture file on a worker thread, and the new levels are
+ * created on the main thread within a per-frame upload budget.
+ *
+ * Only mipmapped 2d textures stream.  Textures whose name starts with one
+ * of the [ClientGraphics] textureStreamingExclude prefixes are always loaded
+ * whole, because some users, like the ui, rely on the size of the top level.
+ *
+ * Screen sizes only come from the ShaderPrimitiveSorter, so a texture drawn
+ * any other way is left at its lowest level.  Texture renderers call
+ * loadTopMipmapLevel() through StaticShader::loadTextureTopMipmapLevels()
+ * before baking, which reads the file on the calling thread.  Other code
+ * that draws or locks textures outside the sorter must do the same, or have
+ * its textures listed with textureStreamingExclude.
+ */
+
+class TextureStreamer
+{
+public:
+
+	static void install();
+
+	static void update();
+
+	static bool isEnabled();
+	static void setEnabled(bool enabled);
+	static int  getMemoryBudget();
+	static void setMemoryBudget(int memoryBudget);
+
+	static bool isStreamable(char const *fileName);
+	static int  getLowestMipmapLevel(int width, int height, int mipmapLevelCount, int minimumTopSize);
+
+	static void addTexture(Texture *texture);
+	static void removeTexture(Texture const *texture);
+	static void loadTopMipmapLevel(Texture const &texture);
+
+	static void reportShaderPrimitive(ShaderPrimitive const &shaderPrimitive, StaticShader const &staticShader, Camera const &camera);
+
+	static int  getNumberOfStreamedTextures();
+	static int  getNumberOfBlurryTextures();
+	static int  getNumberOfPendingRequests();
+	static bool isSharp();
+	static int  getResidentMemory();
+	static int  getTargetMemory();
+	static int  getUploadedBytesLastFrame();
+	static int  getTotalUploadedBytes();
+
+private:
+
+	static void remove();
+	static void submitRequest(Texture &texture, int mipmapLevel);
+	static void processCompletedRequests();
+	static void selectTargetMipmapLevels();
+	static void applyTargetMipmapLevels();
+	static int  getMemorySize(Texture const &texture, int residentMipmapLevel);
+	static int  getMipmapLevelForScreenSize(Texture const &texture, float screenSize);
+	static bool isSeen(Texture const &texture, int frameNumber);
+
+	// disabled
+	TextureStreamer();
+	TextureStreamer(TextureStreamer const &);
+	TextureStreamer &operator =(TextureStreamer const &);
+};
+
+// ======================================================================
+
+#endif
@@ -16,12 +16,14 @@
 #include "clientGraphics/ConfigClientGraphics.h"
 #include "clientGraphics/Gl_dll.def"
 #include "clientGraphics/Graphics.def"
+#include "clientGraphics/GraphicsCommandBuffer.h"
 #include "clientGraphics/GraphicsOptionTags.h"
 #include "clientGraphics/TessellationOptionTags.h"
 #include "clientGraphics/StaticShader.h"
 #include "clientGraphics/Texture.h"
 #include "clientGraphics/TextureFormatInfo.h"
 #include "clientGraphics/TextureList.h"
+#include "clientGraphics/TextureStreamer.h"
 #include "clientGraphics/VertexBuffer.h"
 #include "sharedCollision/BoxExtent.h"
 #include "sharedDebug/DebugFlags.h"
@@ -978,6 +980,8 @@ void Graphics::setPointSpriteEnable(bool bEnable)
 
 void Graphics::update(float elapsedTime)
 {
+	TextureStreamer::update();
+
 	NOT_NULL(ms_api->update);
 	ms_api->update(elapsedTime);
 	++ms_frameNumber;
@@ -1222,6 +1226,13 @@ bool Graphics::getShowMipmapLevels()
 
 void Graphics::setBadVertexBufferVertexShaderCombination(bool *flag, const char *debugAppearanceName)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->setBadVertexBufferVertexShaderCombination(flag, debugAppearanceName);
+		return;
+	}
+
 	NOT_NULL(ms_api);
 	NOT_NULL(ms_api->setBadVertexBufferVertexShaderCombination);
 	ms_api->setBadVertexBufferVertexShaderCombination(flag, debugAppearanceName);
@@ -1249,6 +1260,13 @@ void Graphics::setBadVertexShaderStaticShader(const StaticShader *shader)
 
 void Graphics::setStaticShader(const StaticShader &shader, int pass)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->setStaticShader(shader, pass);
+		return;
+	}
+
 	NOT_NULL(ms_api->setStaticShader);
 
 	ms_shaderValidated = shader.isValid();
@@ -1542,6 +1560,13 @@ void Graphics::getFog(bool & enabled, float & density, PackedArgb & color)
 
 void Graphics::setObjectToWorldTransformAndScale(const Transform &objectToWorld, const Vector &scale)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->setObjectToWorldTransformAndScale(objectToWorld, scale);
+		return;
+	}
+
 	NOT_NULL(ms_api->setObjectToWorldTransformAndScale);
 	ms_api->setObjectToWorldTransformAndScale(objectToWorld, scale);
 #ifdef _DEBUG
@@ -1588,6 +1613,13 @@ void Graphics::setTextureTransform(int stage, bool enabled, int dimension, bool
 
 void Graphics::setVertexShaderUserConstants(int index, float c0, float c1, float c2, float c3)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->setVertexShaderUserConstants(index, c0, c1, c2, c3);
+		return;
+	}
+
 	NOT_NULL(ms_api->setVertexShaderUserConstants);
 	ms_api->setVertexShaderUserConstants(index, c0, c1, c2, c3);
 }
@@ -1596,6 +1628,13 @@ void Graphics::setVertexShaderUserConstants(int index, float c0, float c1, float
 
 void Graphics::setPixelShaderUserConstants(VectorRgba const * constants, int count)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->setPixelShaderUserConstants(constants, count);
+		return;
+	}
+
 	NOT_NULL(ms_api->setPixelShaderUserConstants);
 	ms_api->setPixelShaderUserConstants(constants, count);
 }
@@ -1625,6 +1664,13 @@ StaticShaderGraphicsData *Graphics::createStaticShaderGraphicsData(const StaticS
 
 void Graphics::setLights(const stdvector<const Light*>::fwd &lightList)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->setLights(lightList);
+		return;
+	}
+
 	NOT_NULL(ms_api->setLights);
 	ms_api->setLights(lightList);
 }
@@ -1633,6 +1679,13 @@ void Graphics::setLights(const stdvector<const Light*>::fwd &lightList)
 
 void Graphics::setAlphaFadeOpacity(bool enabled, float opacity)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->setAlphaFadeOpacity(enabled, opacity);
+		return;
+	}
+
 	NOT_NULL(ms_api->setAlphaFadeOpacity);
 	ms_api->setAlphaFadeOpacity(enabled, opacity);
 }
@@ -3021,6 +3074,13 @@ void Graphics::drawExtent (const Extent* extent, const VectorArgb& color)
 
 void Graphics::setVertexBuffer(const HardwareVertexBuffer &vertexBuffer)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->setVertexBuffer(vertexBuffer);
+		return;
+	}
+
 	NOT_NULL(ms_api);
 	NOT_NULL(ms_api->setVertexBuffer);
 	ms_api->setVertexBuffer(vertexBuffer);
@@ -3030,6 +3090,13 @@ void Graphics::setVertexBuffer(const HardwareVertexBuffer &vertexBuffer)
 
 void Graphics::setVertexBuffer(VertexBufferVector const & vertexBufferVector)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->setVertexBuffer(vertexBufferVector);
+		return;
+	}
+
 	NOT_NULL(ms_api);
 	NOT_NULL(ms_api->setVertexBufferVector);
 	ms_api->setVertexBufferVector(vertexBufferVector);
@@ -3039,6 +3106,13 @@ void Graphics::setVertexBuffer(VertexBufferVector const & vertexBufferVector)
 
 void Graphics::setIndexBuffer(const HardwareIndexBuffer &indexBuffer)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->setIndexBuffer(indexBuffer);
+		return;
+	}
+
 #ifdef _DEBUG
 	if (indexBuffer.getType() == HardwareIndexBuffer::T_dynamic)
 	{
@@ -3055,6 +3129,13 @@ void Graphics::setIndexBuffer(const HardwareIndexBuffer &indexBuffer)
 
 void Graphics::drawPointList()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_pointList);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPointList();
@@ -3064,6 +3145,13 @@ void Graphics::drawPointList()
 
 void Graphics::drawLineList()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_lineList);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawLineList();
@@ -3073,6 +3161,13 @@ void Graphics::drawLineList()
 
 void Graphics::drawLineStrip()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_lineStrip);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawLineStrip();
@@ -3082,6 +3177,13 @@ void Graphics::drawLineStrip()
 
 void Graphics::drawTriangleList()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_triangleList);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawTriangleList();
@@ -3091,6 +3193,13 @@ void Graphics::drawTriangleList()
 
 void Graphics::drawTriangleStrip()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_triangleStrip);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawTriangleStrip();
@@ -3100,6 +3209,13 @@ void Graphics::drawTriangleStrip()
 
 void Graphics::drawTriangleFan()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_triangleFan);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawTriangleFan();
@@ -3115,6 +3231,13 @@ void Graphics::drawTriangleFan()
 
 void Graphics::drawQuadList()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_quadList);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawQuadList();
@@ -3124,6 +3247,13 @@ void Graphics::drawQuadList()
 
 void Graphics::drawIndexedPointList()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedPointList);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawIndexedPointList();
@@ -3133,6 +3263,13 @@ void Graphics::drawIndexedPointList()
 
 void Graphics::drawIndexedLineList()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedLineList);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawIndexedLineList();
@@ -3142,6 +3279,13 @@ void Graphics::drawIndexedLineList()
 
 void Graphics::drawIndexedLineStrip()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedLineStrip);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawIndexedLineStrip();
@@ -3151,6 +3295,13 @@ void Graphics::drawIndexedLineStrip()
 
 void Graphics::drawIndexedTriangleList()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedTriangleList);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawIndexedTriangleList();
@@ -3160,6 +3311,13 @@ void Graphics::drawIndexedTriangleList()
 
 void Graphics::drawIndexedTriangleStrip()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedTriangleStrip);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawIndexedTriangleStrip();
@@ -3169,6 +3327,13 @@ void Graphics::drawIndexedTriangleStrip()
 
 void Graphics::drawIndexedTriangleFan()
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedTriangleFan);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawIndexedTriangleFan();
@@ -3186,6 +3351,13 @@ void Graphics::drawIndexedTriangleFan()
 
 void Graphics::drawPointList(int startVertex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_pointList, startVertex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialPointList(startVertex, primitiveCount);
@@ -3203,6 +3375,13 @@ void Graphics::drawPointList(int startVertex, int primitiveCount)
 
 void Graphics::drawLineList(int startVertex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_lineList, startVertex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialLineList(startVertex, primitiveCount);
@@ -3220,6 +3399,13 @@ void Graphics::drawLineList(int startVertex, int primitiveCount)
 
 void Graphics::drawLineStrip(int startVertex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_lineStrip, startVertex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialLineStrip(startVertex, primitiveCount);
@@ -3237,6 +3423,13 @@ void Graphics::drawLineStrip(int startVertex, int primitiveCount)
 
 void Graphics::drawTriangleList(int startVertex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_triangleList, startVertex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialTriangleList(startVertex, primitiveCount);
@@ -3254,6 +3447,13 @@ void Graphics::drawTriangleList(int startVertex, int primitiveCount)
 
 void Graphics::drawTriangleStrip(int startVertex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_triangleStrip, startVertex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialTriangleStrip(startVertex, primitiveCount);
@@ -3271,6 +3471,13 @@ void Graphics::drawTriangleStrip(int startVertex, int primitiveCount)
 
 void Graphics::drawTriangleFan(int startVertex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_triangleFan, startVertex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialTriangleFan(startVertex, primitiveCount);
@@ -3296,6 +3503,13 @@ void Graphics::drawTriangleFan(int startVertex, int primitiveCount)
 
 void Graphics::drawIndexedPointList(int baseIndex, int minimumVertexIndex, int numberOfVertices, int startIndex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedPointList, baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialIndexedPointList(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
@@ -3321,6 +3535,13 @@ void Graphics::drawIndexedPointList(int baseIndex, int minimumVertexIndex, int n
 
 void Graphics::drawIndexedLineList(int baseIndex, int minimumVertexIndex, int numberOfVertices, int startIndex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedLineList, baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialIndexedLineList(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
@@ -3346,6 +3567,13 @@ void Graphics::drawIndexedLineList(int baseIndex, int minimumVertexIndex, int nu
 
 void Graphics::drawIndexedLineStrip(int baseIndex, int minimumVertexIndex, int numberOfVertices, int startIndex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedLineStrip, baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialIndexedLineStrip(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
@@ -3371,6 +3599,13 @@ void Graphics::drawIndexedLineStrip(int baseIndex, int minimumVertexIndex, int n
 
 void Graphics::drawIndexedTriangleList(int baseIndex, int minimumVertexIndex, int numberOfVertices, int startIndex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedTriangleList, baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialIndexedTriangleList(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
@@ -3396,6 +3631,13 @@ void Graphics::drawIndexedTriangleList(int baseIndex, int minimumVertexIndex, in
 
 void Graphics::drawIndexedTriangleStrip(int baseIndex, int minimumVertexIndex, int numberOfVertices, int startIndex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedTriangleStrip, baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialIndexedTriangleStrip(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
@@ -3421,6 +3663,13 @@ void Graphics::drawIndexedTriangleStrip(int baseIndex, int minimumVertexIndex, i
 
 void Graphics::drawIndexedTriangleFan(int baseIndex, int minimumVertexIndex, int numberOfVertices, int startIndex, int primitiveCount)
 {
+	GraphicsCommandBuffer * const commandBuffer = GraphicsCommandBuffer::getRecording();
+	if (commandBuffer)
+	{
+		commandBuffer->draw(GraphicsCommandBuffer::DT_indexedTriangleFan, baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
+		return;
+	}
+
 	predrawCheck();
 	if (ms_shaderValidated)
 		ms_api->drawPartialIndexedTriangleFan(baseIndex, minimumVertexIndex, numberOfVertices, startIndex, primitiveCount);
@@ -9,6 +9,7 @@
 #include "clientGraphics/FirstClientGraphics.h"
 #include "clientGraphics/SetupClientGraphics.h"
 
+#include "clientGraphics/BatchCuller.h"
 #include "clientGraphics/Camera.h"
 #include "clientGraphics/ClientDebugShapeRenderer.h"
 #include "clientGraphics/ConfigClientGraphics.h"
@@ -21,6 +22,7 @@
 #include "clientGraphics/PostProcessingEffectsManager.h"
 #include "clientGraphics/RenderWorld.h"
 #include "clientGraphics/ScreenShotHelper.h"
+#include "clientGraphics/ShaderCache.h"
 #include "clientGraphics/ShaderCapability.h"
 #include "clientGraphics/ShaderEffectList.h"
 #include "clientGraphics/ShaderImplementation.h"
@@ -36,6 +38,7 @@
 #include "clientGraphics/SystemVertexBuffer.h"
 #include "clientGraphics/Texture.h"
 #include "clientGraphics/TextureList.h"
+#include "clientGraphics/TextureStreamer.h"
 #include "clientGraphics/TessellationOptionTags.h"
 #include "sharedFoundation/ConfigSharedFoundation.h"
 #include "sharedFoundation/SetupSharedFoundation.h"
@@ -147,6 +150,7 @@ bool SetupClientGraphics::install(const Data &data)
 	if (data.use3dSystem)
 	{
 		Camera::install();
+		BatchCuller::install();
 		GraphicsDebugFlags::install();
 		GraphicsOptionTags::install();
 		if (!Graphics::install())
@@ -174,6 +178,7 @@ bool SetupClientGraphics::install(const Data &data)
                 configureTessellationOptionTags();
 
                 Texture::install();
+                TextureStreamer::install();
 
 #ifdef _DEBUG
 		Line3dDebugPrimitive::install ();
@@ -280,6 +285,7 @@ bool SetupClientGraphics::install(const Data &data)
 			ShaderPrimitiveSorter::setPhaseDrawTime(12, ShaderPrimitiveSorter::D_beforeCurrentPop);
 		}
 
+		ShaderCache::install();
 		ShaderImplementation::install();
 		ShaderImplementationList::install();
 		ShaderEffectList::install();
@@ -36,12 +36,31 @@
 #include "sharedMath/Sphere.h"
 
 #include <vector>
+#include <map>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 
 //===================================================================
 
 #define SHADOW_EXTRUDE_TO_POINT 1
 
+//-------------------------------------------------------------------
+//-- the facing test uses SSE2 intrinsics on x86 and x64. the kernel is compiled for SSE2 on its own and selected at runtime
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define SHADOW_VOLUME_USE_SIMD 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SHADOW_VOLUME_TARGET_SSE2
+#else
+#define SHADOW_VOLUME_TARGET_SSE2 __attribute__((target("sse2")))
+#endif
+#else
+#define SHADOW_VOLUME_USE_SIMD 0
+#endif
+
 //===================================================================
 // anonymous
 //===================================================================
@@ -50,42 +69,44 @@ namespace ShadowVolumeNamespace
 {
 	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	struct ShadowEdgePrimitive
+	//-- an edge of one face, keyed by its vertex pair with the lower index first so the faces sharing the edge sort together
+	struct HalfEdge
 	{
 	public:
 
-		SystemVertexBuffer* shadowEdgeVertexBuffer;
-		int                 shadowEdgeVertexCount;
-
-		SystemIndexBuffer*  shadowEdgeIndexBuffer;
-		int                 shadowEdgeIndexCount;
+		uint32              key;
+		int                 sequence;
 
 	public:
 
-		ShadowEdgePrimitive () :
-			shadowEdgeVertexBuffer (0),
-			shadowEdgeVertexCount (0),
-			shadowEdgeIndexBuffer (0),
-			shadowEdgeIndexCount (0)
+		bool operator< (const HalfEdge& rhs) const
 		{
+			return key < rhs.key || (key == rhs.key && sequence < rhs.sequence);
 		}
+	};
 
-		int getMemorySize () const
-		{
-			int memorySize = 0;
+	typedef std::vector<HalfEdge> HalfEdgeList;
 
-			memorySize += isizeof (ShadowEdgePrimitive);
-			memorySize += isizeof (SystemVertexBuffer);
-			memorySize += shadowEdgeVertexBuffer ? (shadowEdgeVertexBuffer->getNumberOfVertices () * shadowEdgeVertexBuffer->getVertexSize ()) : 0;
-			memorySize += isizeof (SystemIndexBuffer);
-			memorySize += shadowEdgeIndexBuffer ? (isizeof (Index) * shadowEdgeIndexBuffer->getNumberOfIndices ()) : 0;
+	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-			return memorySize;
-		}
+	struct Statistics
+	{
+	public:
+
+		int                 numberOfVolumesRebuilt;
+		int                 numberOfVolumesReused;
+		int                 numberOfSilhouetteEdges;
 	};
 
 	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#if SHADOW_EXTRUDE_TO_POINT
+	const int   cs_verticesPerSilhouetteEdge = 3;
+#else
+	const int   cs_verticesPerSilhouetteEdge = 6;
+#endif
+
+
 	bool        ms_allowShadowSubmissions;
 	bool        ms_permanentlyDisableShadowVolumes;
 	bool        ms_viewer;
@@ -102,10 +123,87 @@ namespace ShadowVolumeNamespace
 	ShadowVolumeList ms_renderedShadowVolumeList;
 #endif
 
-	typedef std::vector<ShadowEdgePrimitive> ShadowEdgePrimitiveList;
-	ShadowEdgePrimitiveList ms_shadowEdgePrimitiveList;
+	//-- the direction the last silhouette is extruded away from
+	Vector      ms_silhouetteDirectionToLight_o;
+
+	bool        ms_simdAvailable;
+	bool        ms_disableSimd;
+	bool        ms_disableSilhouetteCache;
+	float       ms_cosSilhouetteAngle = 1.f;
+
+	//-- a caster instance that has not cast a shadow for this many frames gives back its silhouette
+	const int   cs_instanceSilhouetteLifetime = 30;
+
+	int         ms_statisticsFrameNumber = -1;
+	Statistics  ms_statistics;
+	Statistics  ms_lastFrameStatistics;
+
+	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	bool detectSimd ()
+	{
+#if SHADOW_VOLUME_USE_SIMD
+#if defined(_MSC_VER)
+		int info [4];
+		__cpuid (info, 0);
+		if (info [0] < 1)
+			return false;
+
+		__cpuid (info, 1);
+		return (info [3] & (1 << 26)) != 0;
+#else
+		__builtin_cpu_init ();
+		return __builtin_cpu_supports ("sse2") != 0;
+#endif
+#else
+		return false;
+#endif
+	}
+
+	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	//-- statistics are kept per graphics frame, the previous frame is what gets reported
+
+	Statistics& getStatistics ()
+	{
+		const int frameNumber = Graphics::getFrameNumber ();
+
+		if (frameNumber != ms_statisticsFrameNumber)
+		{
+			ms_statisticsFrameNumber = frameNumber;
+			ms_lastFrameStatistics = ms_statistics;
+			memset (&ms_statistics, 0, sizeof (ms_statistics));
+		}
+
+		return ms_statistics;
+	}
+
+	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	//-- sums the dot products in the same order as the scalar test so both give the same result. returns the number of faces tested
+
+#if SHADOW_VOLUME_USE_SIMD
+	SHADOW_VOLUME_TARGET_SSE2 int computeFaceDotTestsSimd (const float* const normalX, const float* const normalY, const float* const normalZ, const int numberOfFaces, const Vector& directionToLight_o, bool* const faceDotTestArray)
+	{
+		const __m128 directionX = _mm_set1_ps (directionToLight_o.x);
+		const __m128 directionY = _mm_set1_ps (directionToLight_o.y);
+		const __m128 directionZ = _mm_set1_ps (directionToLight_o.z);
+		const __m128 zero       = _mm_setzero_ps ();
+
+		const int end = numberOfFaces & ~3;
+
+		for (int i = 0; i < end; i += 4)
+		{
+			const __m128 dot = _mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_loadu_ps (normalX + i), directionX), _mm_mul_ps (_mm_loadu_ps (normalY + i), directionY)), _mm_mul_ps (_mm_loadu_ps (normalZ + i), directionZ));
+			const int mask = _mm_movemask_ps (_mm_cmpge_ps (dot, zero));
+
+			faceDotTestArray [i + 0] = (mask & 1) != 0;
+			faceDotTestArray [i + 1] = (mask & 2) != 0;
+			faceDotTestArray [i + 2] = (mask & 4) != 0;
+			faceDotTestArray [i + 3] = (mask & 8) != 0;
+		}
 
-	uint ms_numberOfShadowEdgePrimitives;
+		return end;
+	}
+#endif
 
 	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -165,7 +263,7 @@ public:
 	Index*              compactIndexArray;
 	Index*              compactIndexArrayToIndexArrayMap;
 	int                 compactIndexCount;
-	Vector*             compactFaceNormalArray;
+	float*              compactFaceNormalArray;
 	bool*               compactFaceDotTestArray;
 	int                 compactFaceCount;
 	Edge*               compactEdgeArray;
@@ -178,6 +276,11 @@ public:
 	SystemIndexBuffer*  shadowBackIndexBuffer;
 	int                 shadowBackIndexCount;
 
+	//-- silhouette edges as (edge index << 1) | invert for the instance last passed to computeSilhouette
+	int*                silhouetteEdgeArray;
+	int                 silhouetteEdgeCount;
+	bool                silhouetteValid;
+
 public:
 
 	ShadowPrimitive () :
@@ -196,7 +299,10 @@ public:
 		shadowFrontIndexBuffer (0),
 		shadowFrontIndexCount (0),
 		shadowBackIndexBuffer (0),
-		shadowBackIndexCount (0)
+		shadowBackIndexCount (0),
+		silhouetteEdgeArray (0),
+		silhouetteEdgeCount (0),
+		silhouetteValid (false)
 	{
 	}
 
@@ -215,9 +321,10 @@ public:
 		memorySize += isizeof (ShadowPrimitive);
 		memorySize += isizeof (Vector) * compactVertexCount;
 		memorySize += 2 * isizeof (Index) * compactIndexCount;
-		memorySize += isizeof (Vector) * compactFaceCount;
+		memorySize += 3 * isizeof (float) * compactFaceCount;
 		memorySize += isizeof (bool) * compactFaceCount;
 		memorySize += isizeof (Edge) * compactEdgeCount;
+		memorySize += isizeof (int) * compactEdgeCount;
 		memorySize += isizeof (SystemVertexBuffer);
 		memorySize += shadowVertexBuffer ? (shadowVertexBuffer->getNumberOfVertices () * shadowVertexBuffer->getVertexSize ()) : 0;
 		memorySize += 2 * isizeof (SystemIndexBuffer);
@@ -228,6 +335,71 @@ public:
 	}
 };
 
+//===================================================================
+// ShadowVolume::InstanceSilhouette
+//===================================================================
+
+struct ShadowVolume::InstanceSilhouette
+{
+public:
+
+	//-- the caps and silhouette edges of one shadow primitive
+	struct Primitive
+	{
+	public:
+
+		std::vector<Index>  capIndexList;       // the front cap indices followed by the back cap indices
+		int                 frontIndexCount;
+		std::vector<int>    silhouetteEdgeList;
+
+	public:
+
+		Primitive () :
+			capIndexList (),
+			frontIndexCount (0),
+			silhouetteEdgeList ()
+		{
+		}
+	};
+
+	typedef std::vector<Primitive> PrimitiveList;
+
+public:
+
+	//-- the object space direction the primitives' silhouettes were found for
+	Vector              directionToLight_o;
+	bool                valid;
+	int                 lastUsedFrameNumber;
+	PrimitiveList       primitiveList;
+
+public:
+
+	explicit InstanceSilhouette (const int numberOfPrimitives) :
+		directionToLight_o (),
+		valid (false),
+		lastUsedFrameNumber (0),
+		primitiveList (static_cast<size_t> (numberOfPrimitives))
+	{
+	}
+
+	int getMemorySize () const
+	{
+		int memorySize = isizeof (InstanceSilhouette);
+
+		uint i;
+		for (i = 0; i < primitiveList.size (); ++i)
+		{
+			const Primitive& primitive = primitiveList [i];
+
+			memorySize += isizeof (Primitive);
+			memorySize += isizeof (Index) * static_cast<int> (primitive.capIndexList.capacity ());
+			memorySize += isizeof (int) * static_cast<int> (primitive.silhouetteEdgeList.capacity ());
+		}
+
+		return memorySize;
+	}
+};
+
 //===================================================================
 // ProxyLocalShaderPrimitive
 //===================================================================
@@ -400,7 +572,7 @@ void ProxyLocalShaderPrimitive::prepareToDraw () const
 			static Vector skewedUnitY (0.05f, 0.95f, 0.05f);
 
 			const Vector directionToLight = (ms_viewer || m_isInWorldCell) ? ShadowVolume::getDirectionToLight () : skewedUnitY;
-			m_shadowVolume.extrudeShadowVolume(m_object.getTransform_o2c().rotate_p2l(directionToLight));			
+			m_shadowVolume.computeSilhouette (m_object.getTransform_o2c().rotate_p2l(directionToLight), &m_appearance);
 		}
 		break;
 
@@ -821,6 +993,13 @@ void ShadowVolume::install ()
 	//-- we're going to give shadow blobs a chance
 	DebugFlags::registerFlag (ms_debugReport, "ClientObject", "reportShadowVolume", debugDump);
 
+	ms_simdAvailable = detectSimd ();
+	DebugFlags::registerFlag (ms_disableSimd, "ClientObject", "disableShadowVolumeSimd");
+	DebugFlags::registerFlag (ms_disableSilhouetteCache, "ClientObject", "disableShadowVolumeSilhouetteCache");
+
+	//-- static casters reuse their silhouette until the object space light direction has turned further than this
+	ms_cosSilhouetteAngle = cos (convertDegreesToRadians (clamp (0.f, ConfigClientObject::getShadowVolumeSilhouetteAngle (), 90.f)));
+
 	ms_supportsTwoSidedStencil = Graphics::supportsTwoSidedStencil ();
 	//DEBUG_REPORT_LOG (true, ("ShadowVolume: using %i-sided stencil\n", ms_supportsTwoSidedStencil ? 2 : 1));
 	if (ms_supportsTwoSidedStencil)
@@ -846,19 +1025,12 @@ void ShadowVolume::install ()
 		DynamicVertexBuffer vertexBuffer (format);
 
 		const int numberOfLockableDynamicVertices = vertexBuffer.getNumberOfLockableDynamicVertices (true);
-		ms_maximumVertexBufferSize = numberOfLockableDynamicVertices - (numberOfLockableDynamicVertices % 4);
+		ms_maximumVertexBufferSize = numberOfLockableDynamicVertices - (numberOfLockableDynamicVertices % cs_verticesPerSilhouetteEdge);
 
 		//DEBUG_REPORT_LOG (true, ("ShadowVolume: numberOfLockableDynamicVertices = %i\n", numberOfLockableDynamicVertices));
 		//DEBUG_REPORT_LOG (true, ("ShadowVolume: maximumShadowVertexBufferSize = %i\n", ms_maximumVertexBufferSize));
 	}
 
-	{
-		ShadowEdgePrimitive shadowEdgePrimitive;
-		shadowEdgePrimitive.shadowEdgeVertexBuffer = new SystemVertexBuffer (format, ms_maximumVertexBufferSize);
-		shadowEdgePrimitive.shadowEdgeIndexBuffer = new SystemIndexBuffer ((ms_maximumVertexBufferSize / 4) * 6);
-		ms_shadowEdgePrimitiveList.push_back (shadowEdgePrimitive);
-	}
-
 	ms_crashReportInfo[0] = '\0';
 	CrashReportInformation::addDynamicText (ms_crashReportInfo);
 
@@ -871,19 +1043,6 @@ void ShadowVolume::remove ()
 {
 	CrashReportInformation::removeDynamicText (ms_crashReportInfo);
 
-	for (uint i = 0; i < ms_shadowEdgePrimitiveList.size (); ++i)
-	{
-		ShadowEdgePrimitive& shadowEdgePrimitive = ms_shadowEdgePrimitiveList [i];
-
-		delete shadowEdgePrimitive.shadowEdgeVertexBuffer;
-		shadowEdgePrimitive.shadowEdgeVertexBuffer = 0;
-
-		delete shadowEdgePrimitive.shadowEdgeIndexBuffer;
-		shadowEdgePrimitive.shadowEdgeIndexBuffer = 0;
-	}
-
-	ms_shadowEdgePrimitiveList.clear ();
-
 	if (ms_shadowVolumeOneSidedIncrementShader)
 	{
 		ms_shadowVolumeOneSidedIncrementShader->release();
@@ -916,6 +1075,8 @@ void ShadowVolume::remove ()
 	ProxyLocalShaderPrimitive::remove ();
 
 	DebugFlags::unregisterFlag (ms_debugReport);
+	DebugFlags::unregisterFlag (ms_disableSimd);
+	DebugFlags::unregisterFlag (ms_disableSilhouetteCache);
 }
 
 //-------------------------------------------------------------------
@@ -1057,6 +1218,58 @@ void ShadowVolume::setAllowShadowSubmissions (bool const allowShadowSubmissions)
 	ms_allowShadowSubmissions = allowShadowSubmissions;
 }
 
+//-------------------------------------------------------------------
+
+bool ShadowVolume::getUseSimd ()
+{
+	return ms_simdAvailable && !ms_disableSimd;
+}
+
+//-------------------------------------------------------------------
+
+void ShadowVolume::setUseSimd (bool const useSimd)
+{
+	ms_disableSimd = !useSimd;
+}
+
+//-------------------------------------------------------------------
+
+bool ShadowVolume::getSilhouetteCacheEnabled ()
+{
+	return !ms_disableSilhouetteCache;
+}
+
+//-------------------------------------------------------------------
+
+void ShadowVolume::setSilhouetteCacheEnabled (bool const silhouetteCacheEnabled)
+{
+	ms_disableSilhouetteCache = !silhouetteCacheEnabled;
+}
+
+//-------------------------------------------------------------------
+
+int ShadowVolume::getNumberOfVolumesRebuiltLastFrame ()
+{
+	IGNORE_RETURN (getStatistics ());
+	return ms_lastFrameStatistics.numberOfVolumesRebuilt;
+}
+
+//-------------------------------------------------------------------
+
+int ShadowVolume::getNumberOfVolumesReusedLastFrame ()
+{
+	IGNORE_RETURN (getStatistics ());
+	return ms_lastFrameStatistics.numberOfVolumesReused;
+}
+
+//-------------------------------------------------------------------
+
+int ShadowVolume::getNumberOfSilhouetteEdgesLastFrame ()
+{
+	IGNORE_RETURN (getStatistics ());
+	return ms_lastFrameStatistics.numberOfSilhouetteEdges;
+}
+
 //===================================================================
 // STATIC PRIVATE ShadowVolume
 //===================================================================
@@ -1074,43 +1287,169 @@ void ShadowVolume::clearProxyLocalShaderPrimitiveList ()
 
 //-------------------------------------------------------------------
 
-void ShadowVolume::addEdge (ShadowVolume::Edge* const edgeList, int& numberOfEdges, const int v0, const int v1, const int face)
+void ShadowVolume::buildEdgeConnectivity (ShadowPrimitive& shadowPrimitive)
 {
-	NOT_NULL (edgeList);
+	//-- sort the three edges of every face by vertex pair. the faces sharing an edge are paired off in face order and
+	//-- each pair (or a face left over) becomes an edge, so this gives the same edge list as adding the faces one at a time
+	const int numberOfHalfEdges = shadowPrimitive.compactFaceCount * 3;
+	const Index* const indexArray = shadowPrimitive.compactIndexArray;
+
+	HalfEdgeList halfEdgeList (static_cast<size_t> (numberOfHalfEdges));
 
 	int i;
-	for (i = 0; i < numberOfEdges; ++i)
+	for (i = 0; i < numberOfHalfEdges; ++i)
 	{
-		if (edgeList [i].numberOfFaces >= 2)
-			continue;
-
-		if (edgeList [i].v0 == v0 && edgeList [i].v1 == v1)
-			break;
+		const uint32 v0 = indexArray [i];
+		const uint32 v1 = indexArray [(i % 3 == 2) ? i - 2 : i + 1];
 
-		if (edgeList [i].v0 == v1 && edgeList [i].v1 == v0)
-			break;
+		HalfEdge& halfEdge = halfEdgeList [static_cast<size_t> (i)];
+		halfEdge.key      = v0 < v1 ? ((v0 << 16) | v1) : ((v1 << 16) | v0);
+		halfEdge.sequence = i;
 	}
 
-	if (i == numberOfEdges)
+	std::sort (halfEdgeList.begin (), halfEdgeList.end ());
+
+	//-- an edge is placed at the half edge that opened it so the edge list keeps face order
+	std::vector<Edge> edgeBySequence (static_cast<size_t> (numberOfHalfEdges));
+	for (i = 0; i < numberOfHalfEdges; ++i)
+		edgeBySequence [static_cast<size_t> (i)].numberOfFaces = 0;
+
+	int first = 0;
+	while (first < numberOfHalfEdges)
 	{
-		edgeList [i].v0 = v0;
-		edgeList [i].v1 = v1;
-		edgeList [i].numberOfFaces = 0;
+		int end = first + 1;
+		while (end < numberOfHalfEdges && halfEdgeList [static_cast<size_t> (end)].key == halfEdgeList [static_cast<size_t> (first)].key)
+			++end;
+
+		int j;
+		for (j = first; j < end; j += 2)
+		{
+			const int sequence = halfEdgeList [static_cast<size_t> (j)].sequence;
+
+			Edge& edge = edgeBySequence [static_cast<size_t> (sequence)];
+			edge.v0            = indexArray [sequence];
+			edge.v1            = indexArray [(sequence % 3 == 2) ? sequence - 2 : sequence + 1];
+			edge.numberOfFaces = 1;
+			edge.face [0]      = sequence / 3;
+			edge.face [1]      = 0;
+
+			if (j + 1 < end)
+			{
+				edge.face [1] = halfEdgeList [static_cast<size_t> (j + 1)].sequence / 3;
+				++edge.numberOfFaces;
+			}
+
 #ifdef _DEBUG
-		edgeList [i].isNonManifold = false;
+			edge.isNonManifold = end - first > 2;
 #endif
+		}
 
-		++numberOfEdges;
+		first = end;
 	}
 
-	if (edgeList [i].numberOfFaces < 2)
-		edgeList [i].face [edgeList [i].numberOfFaces++] = face;
-	else
-	{
-#ifdef _DEBUG
-		//DEBUG_REPORT_LOG_PRINT (true, ("ShadowVolume::addEdge - more than 2 faces share this edge!\n"));
-		edgeList [i].isNonManifold = true;
+	shadowPrimitive.compactEdgeCount = 0;
+	for (i = 0; i < numberOfHalfEdges; ++i)
+		if (edgeBySequence [static_cast<size_t> (i)].numberOfFaces > 0)
+			shadowPrimitive.compactEdgeArray [shadowPrimitive.compactEdgeCount++] = edgeBySequence [static_cast<size_t> (i)];
+}
+
+//-------------------------------------------------------------------
+
+void ShadowVolume::computeFaceDotTests (ShadowPrimitive& shadowPrimitive, const Vector& directionToLight_o)
+{
+	const int numberOfFaces = shadowPrimitive.compactFaceCount;
+	const float* const normalX = shadowPrimitive.compactFaceNormalArray;
+	const float* const normalY = normalX + numberOfFaces;
+	const float* const normalZ = normalY + numberOfFaces;
+	bool* const faceDotTestArray = shadowPrimitive.compactFaceDotTestArray;
+
+	int first = 0;
+
+#if SHADOW_VOLUME_USE_SIMD
+	if (getUseSimd ())
+		first = computeFaceDotTestsSimd (normalX, normalY, normalZ, numberOfFaces, directionToLight_o, faceDotTestArray);
 #endif
+
+	int i;
+	for (i = first; i < numberOfFaces; ++i)
+		faceDotTestArray [i] = normalX [i] * directionToLight_o.x + normalY [i] * directionToLight_o.y + normalZ [i] * directionToLight_o.z >= 0.f;
+}
+
+//-------------------------------------------------------------------
+
+void ShadowVolume::computeCapsAndSilhouette (ShadowPrimitive& shadowPrimitive)
+{
+	const bool* const faceDotTestArray = shadowPrimitive.compactFaceDotTestArray;
+	const Index* const indexArray = shadowPrimitive.compactIndexArray;
+
+	//-- update the caps
+	{
+		Index* sfi = shadowPrimitive.shadowFrontIndexBuffer->begin ();
+		Index* sbi = shadowPrimitive.shadowBackIndexBuffer->begin ();
+		shadowPrimitive.shadowFrontIndexCount = 0;
+		shadowPrimitive.shadowBackIndexCount = 0;
+
+		int j;
+		for (j = 0; j < shadowPrimitive.compactFaceCount; ++j)
+		{
+			if (faceDotTestArray [j])
+			{
+				*sfi++ = indexArray [j * 3 + 0];
+				*sfi++ = indexArray [j * 3 + 1];
+				*sfi++ = indexArray [j * 3 + 2];
+
+				shadowPrimitive.shadowFrontIndexCount += 3;
+			}
+			else
+			{
+				*sbi++ = indexArray [j * 3 + 0];
+				*sbi++ = indexArray [j * 3 + 1];
+				*sbi++ = indexArray [j * 3 + 2];
+
+				shadowPrimitive.shadowBackIndexCount += 3;
+			}
+		}
+	}
+
+	//-- find the silhouette edges
+	shadowPrimitive.silhouetteEdgeCount = 0;
+
+	int j;
+	for (j = 0; j < shadowPrimitive.compactEdgeCount; ++j)
+	{
+		const Edge& edge = shadowPrimitive.compactEdgeArray [j];
+
+		if ((edge.numberOfFaces == 1 && faceDotTestArray [edge.face [0]]) ||
+			(edge.numberOfFaces == 2 && faceDotTestArray [edge.face [0]] != faceDotTestArray [edge.face [1]]))
+		{
+			//-- check to see if the vertices are in the same order
+			bool invert = false;
+
+			if (edge.numberOfFaces == 2)
+			{
+				//-- which face was culled?
+				const int unculledFace = faceDotTestArray [edge.face [0]] ? edge.face [0] : edge.face [1];
+
+				int k;
+				for (k = 0; k < 3; ++k)
+				{
+					int start    = k;
+					int backward = (k + 2) % 3;
+
+					//-- find v0
+					if (indexArray [unculledFace * 3 + start] == edge.v0)
+					{
+						//-- check order to see if we need to invert the bindings
+						if (indexArray [unculledFace * 3 + backward] == edge.v1)
+							invert = true;
+
+						break;
+					}
+				}
+			}
+
+			shadowPrimitive.silhouetteEdgeArray [shadowPrimitive.silhouetteEdgeCount++] = (j << 1) | (invert ? 1 : 0);
+		}
 	}
 }
 
@@ -1130,6 +1469,10 @@ int ShadowVolume::getMemorySize () const
 	for (i = 0; i < m_shadowPrimitiveList->size (); ++i)
 		memorySize += (*m_shadowPrimitiveList) [i]->getMemorySize ();
 
+	InstanceSilhouetteMap::const_iterator iter;
+	for (iter = m_instanceSilhouetteMap->begin (); iter != m_instanceSilhouetteMap->end (); ++iter)
+		memorySize += iter->second->getMemorySize ();
+
 	memorySize += isizeof (Metrics);
 
 	return memorySize;
@@ -1146,16 +1489,18 @@ void ShadowVolume::debugDump ()
 	for (i = 0; i < ms_shadowVolumeList.size (); ++i)
 		memorySize += ms_shadowVolumeList [i]->getMemorySize ();
 
-	for (i = 0; i < ms_shadowEdgePrimitiveList.size (); ++i)
-		memorySize += ms_shadowEdgePrimitiveList [i].getMemorySize ();
-
 	DEBUG_REPORT_PRINT (true, ("-- ShadowVolume\n"));
 	DEBUG_REPORT_PRINT (true, ("    permanently disabled = %s\n", ms_permanentlyDisableShadowVolumes ? "yes" : "no"));
 	DEBUG_REPORT_PRINT (true, ("                 enabled = %s\n", getEnabled () ? "yes" : "no"));
 	DEBUG_REPORT_PRINT (true, ("                   count = %i\n", ms_shadowVolumeList.size ()));
 	DEBUG_REPORT_PRINT (true, ("              total size = %iM (%iK)\n", memorySize / (1024 * 1024), memorySize / 1024));
-	DEBUG_REPORT_PRINT (true, ("edge primitive list size = %i\n", ms_shadowEdgePrimitiveList.size ()));
 #endif
+
+	IGNORE_RETURN (getStatistics ());
+	const Statistics& statistics = ms_lastFrameStatistics;
+
+	DEBUG_REPORT_PRINT (true, ("          volumes/frame = %i rebuilt, %i reused%s\n", statistics.numberOfVolumesRebuilt, statistics.numberOfVolumesReused, ms_disableSilhouetteCache ? " (cache disabled)" : ""));
+	DEBUG_REPORT_PRINT (true, ("  silhouette edges/frame = %i%s\n", statistics.numberOfSilhouetteEdges, getUseSimd () ? "" : " (scalar)"));
 }
 
 //===================================================================
@@ -1176,6 +1521,8 @@ ShadowVolume::ShadowVolume (const ShaderType shaderType, const PrimitiveType pri
 	m_localShaderPrimitiveRenderFrontCapsTwoSided (0),
 	m_localShaderPrimitiveRenderBackCapsTwoSided (0),
 	m_shadowPrimitiveList (0),
+	m_instanceSilhouetteMap (new InstanceSilhouetteMap),
+	m_instanceSilhouettePruneFrameNumber (-1),
 	m_metrics ()
 {
 #ifdef _DEBUG
@@ -1256,6 +1603,11 @@ ShadowVolume::~ShadowVolume ()
 
 		shadowPrimitive.compactEdgeCount = 0;
 
+		delete [] shadowPrimitive.silhouetteEdgeArray;
+		shadowPrimitive.silhouetteEdgeArray = 0;
+
+		shadowPrimitive.silhouetteEdgeCount = 0;
+
 		delete shadowPrimitive.shadowVertexBuffer;
 		shadowPrimitive.shadowVertexBuffer = 0;
 
@@ -1273,6 +1625,10 @@ ShadowVolume::~ShadowVolume ()
 	delete m_shadowPrimitiveList;
 	m_shadowPrimitiveList = 0;
 
+	clearInstanceSilhouettes ();
+	delete m_instanceSilhouetteMap;
+	m_instanceSilhouetteMap = 0;
+
 	delete m_localShaderPrimitiveRenderEdgesOneSidedCullClockwise;
 	m_localShaderPrimitiveRenderEdgesOneSidedCullClockwise = 0;
 
@@ -1311,6 +1667,9 @@ void ShadowVolume::addPrimitive (const VertexBufferReadIterator& vi, const int n
 
 	NOT_NULL (indexArray);
 
+	//-- the instance silhouettes were found for the old geometry
+	clearInstanceSilhouettes ();
+
 	//-- for static shadow volumes, we can have more than one primitive. for animating shadow volumes, we can only have one primitive
 	if (m_primitiveType == PT_static || (m_primitiveType == PT_animating && m_shadowPrimitiveList->empty ()))
 		m_shadowPrimitiveList->push_back (new ShadowPrimitive ());
@@ -1406,8 +1765,9 @@ void ShadowVolume::addPrimitive (const VertexBufferReadIterator& vi, const int n
 
 		shadowPrimitive.compactFaceCount = shadowPrimitive.compactIndexCount / 3;
 
+		//-- the face normals are stored as all x, then all y, then all z so the facing test can run on four faces at a time
 		if (!shadowPrimitive.compactFaceNormalArray)
-			shadowPrimitive.compactFaceNormalArray  = new Vector [static_cast<size_t> (shadowPrimitive.compactFaceCount)];
+			shadowPrimitive.compactFaceNormalArray  = new float [static_cast<size_t> (3 * shadowPrimitive.compactFaceCount)];
 
 		if (!shadowPrimitive.compactFaceDotTestArray)
 			shadowPrimitive.compactFaceDotTestArray = new bool [static_cast<size_t> (shadowPrimitive.compactFaceCount)];
@@ -1448,48 +1808,27 @@ void ShadowVolume::addPrimitive (const VertexBufferReadIterator& vi, const int n
 		if (!shadowPrimitive.shadowBackIndexBuffer)
 			shadowPrimitive.shadowBackIndexBuffer = new SystemIndexBuffer (shadowPrimitive.compactIndexCount);
 
-		//-- compute edge connectivity
+		//-- compute edge connectivity (only needs to be done once)
 		if (!shadowPrimitive.computedEdgeConnectivity)
 		{
-			int i;
-			for (i = 0; i < shadowPrimitive.compactFaceCount; ++i)
-			{
-				//-- inverting the winding order will show streamers; may be useful to artists!
-				const int i0 = shadowPrimitive.compactIndexArray [3 * i + 0];
-				const int i1 = shadowPrimitive.compactIndexArray [3 * i + 1];
-				const int i2 = shadowPrimitive.compactIndexArray [3 * i + 2];
+			buildEdgeConnectivity (shadowPrimitive);
 
-#if 0
-				DEBUG_WARNING (i0 == i1 || i1 == i2 || i2 == i0, ("zero-area triangle detected"));
-
-				//-- do we have duplicate geometry?
-				int j;
-				for (j = 0; j < i; ++j)
-				{
-					const int j0 = shadowPrimitive.compactIndexArray [3 * j + 0];
-					const int j1 = shadowPrimitive.compactIndexArray [3 * j + 1];
-					const int j2 = shadowPrimitive.compactIndexArray [3 * j + 2];
-
-					if ((j0 == i0 && j1 == i1 && j2 == i2) ||
-						(j0 == i1 && j1 == i2 && j2 == i0) ||
-						(j0 == i2 && j1 == i0 && j2 == i1))
-						DEBUG_WARNING (true, ("duplicate geometry detected"));
-				}
-#endif
-
-				//-- compute edge array (only needs to be done once)
-				addEdge (shadowPrimitive.compactEdgeArray, shadowPrimitive.compactEdgeCount, i0, i1, i);
-				addEdge (shadowPrimitive.compactEdgeArray, shadowPrimitive.compactEdgeCount, i1, i2, i);
-				addEdge (shadowPrimitive.compactEdgeArray, shadowPrimitive.compactEdgeCount, i2, i0, i);
-			}
+			delete [] shadowPrimitive.silhouetteEdgeArray;
+			shadowPrimitive.silhouetteEdgeArray = new int [static_cast<size_t> (std::max (1, shadowPrimitive.compactEdgeCount))];
+			shadowPrimitive.silhouetteEdgeCount = 0;
 
 			shadowPrimitive.computedEdgeConnectivity = true;
 		}
 
 		//-- compute face normals
 		{
+			const int numberOfFaces = shadowPrimitive.compactFaceCount;
+			float* const normalX = shadowPrimitive.compactFaceNormalArray;
+			float* const normalY = normalX + numberOfFaces;
+			float* const normalZ = normalY + numberOfFaces;
+
 			int i;
-			for (i = 0; i < shadowPrimitive.compactFaceCount; ++i)
+			for (i = 0; i < numberOfFaces; ++i)
 			{
 				//-- inverting the winding order will show streamers; may be useful to artists!
 				const int i0 = shadowPrimitive.compactIndexArray [3 * i + 0];
@@ -1501,9 +1840,15 @@ void ShadowVolume::addPrimitive (const VertexBufferReadIterator& vi, const int n
 				const Vector& v2 = shadowPrimitive.compactVertexArray [i2];
 
 				//-- compute normal (no need to normalize because we're only using it for backface culling)
-				shadowPrimitive.compactFaceNormalArray [i] = (v0 - v2).cross (v1 - v0);
+				const Vector normal = (v0 - v2).cross (v1 - v0);
+				normalX [i] = normal.x;
+				normalY [i] = normal.y;
+				normalZ [i] = normal.z;
 			}
 		}
+
+		//-- the geometry may have changed, so the silhouette has to be found again
+		shadowPrimitive.silhouetteValid = false;
 	}
 }
 
@@ -1674,19 +2019,38 @@ void ShadowVolume::render(Object const * const object, const Appearance *const a
 	}
 }
 
-//===================================================================
-// PRIVATE ShadowVolume
-//===================================================================
+//-------------------------------------------------------------------
 
-void ShadowVolume::extrudeShadowVolume (const Vector& directionToLight_o) const
+void ShadowVolume::computeSilhouette (const Vector& directionToLight_o, const void* const instance) const
 {
-	PROFILER_AUTO_BLOCK_DEFINE("ShadowVolume::extrudeShadowVolume");
+	PROFILER_AUTO_BLOCK_DEFINE("ShadowVolume::computeSilhouette");
 
 	//-- setup CrashReportInformation string.
 	IGNORE_RETURN (snprintf (ms_crashReportInfo, sizeof (ms_crashReportInfo) - 1, "ShadowVolume: %s\n", m_debugName));
 	ms_crashReportInfo[sizeof (ms_crashReportInfo) - 1] = '\0';
 
-	ms_numberOfShadowEdgePrimitives = 0;
+	ms_silhouetteDirectionToLight_o = directionToLight_o;
+
+	//-- a static caster instance keeps its silhouette while its light has turned less than the silhouette angle
+	InstanceSilhouette* instanceSilhouette = 0;
+	bool reuse = false;
+
+	if (m_primitiveType == PT_static && instance && !ms_disableSilhouetteCache)
+	{
+		pruneInstanceSilhouettes ();
+
+		instanceSilhouette = findInstanceSilhouette (instance);
+		instanceSilhouette->lastUsedFrameNumber = Graphics::getFrameNumber ();
+
+		if (instanceSilhouette->valid)
+		{
+			const Vector& cachedDirection_o = instanceSilhouette->directionToLight_o;
+			const float dot = cachedDirection_o.dot (directionToLight_o);
+			reuse = dot >= 0.f && dot * dot >= ms_cosSilhouetteAngle * ms_cosSilhouetteAngle * cachedDirection_o.magnitudeSquared () * directionToLight_o.magnitudeSquared ();
+		}
+	}
+
+	Statistics& statistics = getStatistics ();
 
 	uint i;
 	for (i = 0; i < m_shadowPrimitiveList->size (); ++i)
@@ -1695,244 +2059,239 @@ void ShadowVolume::extrudeShadowVolume (const Vector& directionToLight_o) const
 		if (shadowPrimitive.isEmpty ())
 			continue;
 
-		//-- update the face normal array
+		if (reuse)
 		{
-			int j;
-			for (j = 0; j < shadowPrimitive.compactFaceCount; ++j)
-				shadowPrimitive.compactFaceDotTestArray [j] = shadowPrimitive.compactFaceNormalArray [j].dot (directionToLight_o) >= 0.f;
-		}
+			//-- copy the instance's caps and silhouette back into the buffers the render primitives draw from
+			const InstanceSilhouette::Primitive& primitive = instanceSilhouette->primitiveList [i];
 
-		//-- update the caps
+			shadowPrimitive.shadowFrontIndexCount = primitive.frontIndexCount;
+			shadowPrimitive.shadowBackIndexCount  = static_cast<int> (primitive.capIndexList.size ()) - primitive.frontIndexCount;
+			IGNORE_RETURN (std::copy (primitive.capIndexList.begin (), primitive.capIndexList.begin () + primitive.frontIndexCount, shadowPrimitive.shadowFrontIndexBuffer->begin ()));
+			IGNORE_RETURN (std::copy (primitive.capIndexList.begin () + primitive.frontIndexCount, primitive.capIndexList.end (), shadowPrimitive.shadowBackIndexBuffer->begin ()));
+
+			shadowPrimitive.silhouetteEdgeCount = static_cast<int> (primitive.silhouetteEdgeList.size ());
+			IGNORE_RETURN (std::copy (primitive.silhouetteEdgeList.begin (), primitive.silhouetteEdgeList.end (), shadowPrimitive.silhouetteEdgeArray));
+		}
+		else
 		{
-			Index* sfi = shadowPrimitive.shadowFrontIndexBuffer->begin ();
-			Index* sbi = shadowPrimitive.shadowBackIndexBuffer->begin ();
-			shadowPrimitive.shadowFrontIndexCount = 0;
-			shadowPrimitive.shadowBackIndexCount = 0;
+			computeFaceDotTests (shadowPrimitive, directionToLight_o);
+			computeCapsAndSilhouette (shadowPrimitive);
 
-			int j;
-			for (j = 0; j < shadowPrimitive.compactFaceCount; ++j)
+			if (instanceSilhouette)
 			{
-				if (shadowPrimitive.compactFaceDotTestArray [j])
-				{
-					*sfi++ = shadowPrimitive.compactIndexArray [j * 3 + 0];
-					*sfi++ = shadowPrimitive.compactIndexArray [j * 3 + 1];
-					*sfi++ = shadowPrimitive.compactIndexArray [j * 3 + 2];
+				InstanceSilhouette::Primitive& primitive = instanceSilhouette->primitiveList [i];
 
-					shadowPrimitive.shadowFrontIndexCount += 3;
-				}
-				else
-				{
-					*sbi++ = shadowPrimitive.compactIndexArray [j * 3 + 0];
-					*sbi++ = shadowPrimitive.compactIndexArray [j * 3 + 1];
-					*sbi++ = shadowPrimitive.compactIndexArray [j * 3 + 2];
+				const Index* const frontIndexArray = shadowPrimitive.shadowFrontIndexBuffer->begin ();
+				const Index* const backIndexArray = shadowPrimitive.shadowBackIndexBuffer->begin ();
+				primitive.capIndexList.assign (frontIndexArray, frontIndexArray + shadowPrimitive.shadowFrontIndexCount);
+				primitive.capIndexList.insert (primitive.capIndexList.end (), backIndexArray, backIndexArray + shadowPrimitive.shadowBackIndexCount);
+				primitive.frontIndexCount = shadowPrimitive.shadowFrontIndexCount;
 
-					shadowPrimitive.shadowBackIndexCount += 3;
-				}
+				primitive.silhouetteEdgeList.assign (shadowPrimitive.silhouetteEdgeArray, shadowPrimitive.silhouetteEdgeArray + shadowPrimitive.silhouetteEdgeCount);
 			}
 		}
 
-		{
-			if (ms_numberOfShadowEdgePrimitives >= ms_shadowEdgePrimitiveList.size ())
-			{
-				VertexBufferFormat format;
-				format.setPosition ();
-
-				ShadowEdgePrimitive newShadowEdgePrimitive;
-				newShadowEdgePrimitive.shadowEdgeVertexBuffer = new SystemVertexBuffer (format, ms_maximumVertexBufferSize);
-				newShadowEdgePrimitive.shadowEdgeIndexBuffer = new SystemIndexBuffer ((ms_maximumVertexBufferSize / 4) * 6);
-				ms_shadowEdgePrimitiveList.push_back (newShadowEdgePrimitive);
-			}
-
-			ShadowEdgePrimitive & shadowEdgePrimitive = ms_shadowEdgePrimitiveList [ms_numberOfShadowEdgePrimitives++];
-
-			VertexBufferWriteIterator sv = shadowEdgePrimitive.shadowEdgeVertexBuffer->begin ();
-			shadowEdgePrimitive.shadowEdgeVertexCount = 0;
-
-			Index* si = shadowEdgePrimitive.shadowEdgeIndexBuffer->begin ();
-			shadowEdgePrimitive.shadowEdgeIndexCount = 0;
+		shadowPrimitive.silhouetteValid = true;
 
-			Vector v0;
-			Vector v1;
-			Vector v2;
-			Vector v3;
-
-			const Vector infinity = directionToLight_o * ms_shadowVolumeExtrudeDistance;
-
-			int numberOfShadowVolumeQuads = 0;
+		statistics.numberOfSilhouetteEdges += shadowPrimitive.silhouetteEdgeCount;
 
+#ifdef _DEBUG
+		if (ms_showExtrudedEdges || ms_showNonManifoldEdges)
+		{
 			int j;
 			for (j = 0; j < shadowPrimitive.compactEdgeCount; ++j)
 			{
 				const Edge& edge = shadowPrimitive.compactEdgeArray [j];
 
-#ifdef _DEBUG
 				if (!ms_showExtrudedEdges && ms_showNonManifoldEdges && edge.isNonManifold)
-				{
-					v0 = shadowPrimitive.compactVertexArray [edge.v0];
-					v1 = shadowPrimitive.compactVertexArray [edge.v1];
-					ShaderPrimitiveSorter::getCurrentCamera ().addDebugPrimitive (new Line3dDebugPrimitive (Line3dDebugPrimitive::S_none, Transform::identity, v0, v1, PackedArgb::solidWhite));
-				}
+					ShaderPrimitiveSorter::getCurrentCamera ().addDebugPrimitive (new Line3dDebugPrimitive (Line3dDebugPrimitive::S_none, Transform::identity, shadowPrimitive.compactVertexArray [edge.v0], shadowPrimitive.compactVertexArray [edge.v1], PackedArgb::solidWhite));
+			}
 
-//				if (edge.isNonManifold)
-//					continue;
+			for (j = 0; j < shadowPrimitive.silhouetteEdgeCount; ++j)
+			{
+				const Edge& edge = shadowPrimitive.compactEdgeArray [shadowPrimitive.silhouetteEdgeArray [j] >> 1];
+
+				if ((!ms_showNonManifoldEdges && ms_showExtrudedEdges) || (ms_showExtrudedEdges && ms_showNonManifoldEdges && edge.isNonManifold))
+					ShaderPrimitiveSorter::getCurrentCamera ().addDebugPrimitive (new Line3dDebugPrimitive (Line3dDebugPrimitive::S_none, Transform::identity, shadowPrimitive.compactVertexArray [edge.v0], shadowPrimitive.compactVertexArray [edge.v1], PackedArgb::solidWhite));
+			}
+		}
 #endif
+	}
 
-				if ((edge.numberOfFaces == 1 && shadowPrimitive.compactFaceDotTestArray [edge.face [0]]) ||
-					(edge.numberOfFaces == 2 && shadowPrimitive.compactFaceDotTestArray [edge.face [0]] != shadowPrimitive.compactFaceDotTestArray [edge.face [1]]))
-				{
-					//-- check to see if the vertices are in the same order
-					bool invert = false;
+	if (reuse)
+		++statistics.numberOfVolumesReused;
+	else
+	{
+		++statistics.numberOfVolumesRebuilt;
 
-					if (edge.numberOfFaces == 2)
-					{
-						//-- which face was culled?
-						const int unculledFace = shadowPrimitive.compactFaceDotTestArray [edge.face [0]] ? edge.face [0] : edge.face [1];
-
-						int k;
-						for (k = 0; k < 3; ++k)
-						{
-							int start    = k;
-							int backward = (k + 2) % 3;
-
-							//-- find v0
-							if (shadowPrimitive.compactIndexArray [unculledFace * 3 + start] == edge.v0)
-							{
-								//-- check order to see if we need to invert the bindings
-								if (shadowPrimitive.compactIndexArray [unculledFace * 3 + backward] == edge.v1)
-									invert = true;
-
-								break;
-							}
-						}
-					}
+		if (instanceSilhouette)
+		{
+			instanceSilhouette->directionToLight_o = directionToLight_o;
+			instanceSilhouette->valid = true;
+		}
+	}
+}
 
-					//-- start with the edge
-					v0 = shadowPrimitive.compactVertexArray [edge.v0];
-					v1 = shadowPrimitive.compactVertexArray [edge.v1];
+//-------------------------------------------------------------------
 
+int ShadowVolume::getNumberOfShadowPrimitives () const
+{
+	return static_cast<int> (m_shadowPrimitiveList->size ());
+}
 
-					//-- instead of extending to infinity, should we clip against frustum?
-#if SHADOW_EXTRUDE_TO_POINT
-					v2 = -infinity;
-					v3 = -infinity;
-#else
-					v2 = v0 - infinity;
-					v3 = v1 - infinity;
-#endif
+//-------------------------------------------------------------------
 
-#ifdef _DEBUG
-					if ((!ms_showNonManifoldEdges && ms_showExtrudedEdges) || (ms_showExtrudedEdges && ms_showNonManifoldEdges && edge.isNonManifold))
-					{
-						ShaderPrimitiveSorter::getCurrentCamera ().addDebugPrimitive (new Line3dDebugPrimitive (Line3dDebugPrimitive::S_none, Transform::identity, v0, v1, PackedArgb::solidWhite));
-//						ShaderPrimitiveSorter::getCurrentCamera ().addDebugPrimitive (new Line3dDebugPrimitive (Line3dDebugPrimitive::S_none, Transform::identity, v1, v2, PackedArgb::solidWhite));
-//						ShaderPrimitiveSorter::getCurrentCamera ().addDebugPrimitive (new Line3dDebugPrimitive (Line3dDebugPrimitive::S_none, Transform::identity, v2, v3, PackedArgb::solidWhite));
-//						ShaderPrimitiveSorter::getCurrentCamera ().addDebugPrimitive (new Line3dDebugPrimitive (Line3dDebugPrimitive::S_none, Transform::identity, v3, v0, PackedArgb::solidWhite));
-					}
-#endif
+void ShadowVolume::getSilhouetteEdges (const int shadowPrimitiveIndex, SilhouetteEdgeList& silhouetteEdgeList) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE (0, shadowPrimitiveIndex, getNumberOfShadowPrimitives ());
 
-					//-- figure out which ShadowEdgePrimitive we're on
-					if (shadowEdgePrimitive.shadowEdgeVertexCount >= ms_maximumVertexBufferSize)
-					{
-						if (ms_numberOfShadowEdgePrimitives >= ms_shadowEdgePrimitiveList.size ())
-						{
-							VertexBufferFormat format;
-							format.setPosition ();
+	silhouetteEdgeList.clear ();
 
-							ShadowEdgePrimitive newShadowEdgePrimitive;
-							newShadowEdgePrimitive.shadowEdgeVertexBuffer = new SystemVertexBuffer (format, ms_maximumVertexBufferSize);
-							newShadowEdgePrimitive.shadowEdgeIndexBuffer = new SystemIndexBuffer ((ms_maximumVertexBufferSize / 4) * 6);
-							ms_shadowEdgePrimitiveList.push_back (newShadowEdgePrimitive);
-						}
+	const ShadowPrimitive& shadowPrimitive = *(*m_shadowPrimitiveList) [static_cast<size_t> (shadowPrimitiveIndex)];
+	if (shadowPrimitive.isEmpty () || !shadowPrimitive.silhouetteValid)
+		return;
 
-						shadowEdgePrimitive = ms_shadowEdgePrimitiveList [ms_numberOfShadowEdgePrimitives++];
+	silhouetteEdgeList.assign (shadowPrimitive.silhouetteEdgeArray, shadowPrimitive.silhouetteEdgeArray + shadowPrimitive.silhouetteEdgeCount);
+}
 
-						sv = shadowEdgePrimitive.shadowEdgeVertexBuffer->begin ();
-						shadowEdgePrimitive.shadowEdgeVertexCount = 0;
+//===================================================================
+// PRIVATE ShadowVolume
+//===================================================================
 
-						si = shadowEdgePrimitive.shadowEdgeIndexBuffer->begin ();
-						shadowEdgePrimitive.shadowEdgeIndexCount = 0;
-					}
+ShadowVolume::InstanceSilhouette* ShadowVolume::findInstanceSilhouette (const void* const instance) const
+{
+	NOT_NULL (m_instanceSilhouetteMap);
 
-					//-- add two triangles to the shadow vertex list
-					sv.setPosition (v0);
-					++sv;
-					sv.setPosition (v1);
-					++sv;
-					sv.setPosition (v2);
-					++sv;
+	InstanceSilhouetteMap::iterator iter = m_instanceSilhouetteMap->find (instance);
+	if (iter != m_instanceSilhouetteMap->end ())
+		return iter->second;
 
-#if SHADOW_EXTRUDE_TO_POINT == 0
-					sv.setPosition (v3);
-					++sv;
-#endif
+	InstanceSilhouette* const instanceSilhouette = new InstanceSilhouette (static_cast<int> (m_shadowPrimitiveList->size ()));
+	IGNORE_RETURN (m_instanceSilhouetteMap->insert (std::make_pair (instance, instanceSilhouette)));
 
-					if (invert)
-					{
-#if SHADOW_EXTRUDE_TO_POINT
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 3 + 0);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 3 + 1);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 3 + 2);
-#else
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 0);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 1);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 2);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 1);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 3);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 2);
-#endif
-					}
-					else
-					{
-#if SHADOW_EXTRUDE_TO_POINT
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 3 + 0);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 3 + 2);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 3 + 1);
-#else
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 0);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 2);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 1);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 1);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 2);
-						(*si++) = static_cast<Index> (numberOfShadowVolumeQuads * 4 + 3);
-#endif
-					}
+	return instanceSilhouette;
+}
 
-					++numberOfShadowVolumeQuads;
+//-------------------------------------------------------------------
+/**
+ * Drops the silhouettes of instances that have not cast a shadow for a
+ * while, at most once a frame.  The silhouette only depends on the object
+ * space direction to the light, so an entry left behind by a destroyed
+ * instance is still correct for a new instance at the same address.
+ */
 
-#if SHADOW_EXTRUDE_TO_POINT
-					shadowEdgePrimitive.shadowEdgeVertexCount += 3;
-					shadowEdgePrimitive.shadowEdgeIndexCount += 3;
-#else
-					shadowEdgePrimitive.shadowEdgeVertexCount += 4;
-					shadowEdgePrimitive.shadowEdgeIndexCount += 6;
-#endif
-				}
-			}
+void ShadowVolume::pruneInstanceSilhouettes () const
+{
+	const int frameNumber = Graphics::getFrameNumber ();
+	if (frameNumber == m_instanceSilhouettePruneFrameNumber)
+		return;
+
+	m_instanceSilhouettePruneFrameNumber = frameNumber;
+
+	InstanceSilhouetteMap::iterator iter = m_instanceSilhouetteMap->begin ();
+	while (iter != m_instanceSilhouetteMap->end ())
+	{
+		if (frameNumber - iter->second->lastUsedFrameNumber > cs_instanceSilhouetteLifetime)
+		{
+			delete iter->second;
+			m_instanceSilhouetteMap->erase (iter++);
 		}
+		else
+			++iter;
 	}
 }
 
 //-------------------------------------------------------------------
 
+void ShadowVolume::clearInstanceSilhouettes () const
+{
+	NOT_NULL (m_instanceSilhouetteMap);
+
+	InstanceSilhouetteMap::iterator iter;
+	for (iter = m_instanceSilhouetteMap->begin (); iter != m_instanceSilhouetteMap->end (); ++iter)
+		delete iter->second;
+
+	m_instanceSilhouetteMap->clear ();
+}
+
+//-------------------------------------------------------------------
+
 void ShadowVolume::renderShadowVolumeEdges () const
 {
 	PROFILER_AUTO_BLOCK_DEFINE("ShadowVolume::renderShadowVolumeEdges");
 
-	for (uint i = 0; i < ms_numberOfShadowEdgePrimitives; ++i)
+	//-- extrude the silhouette edges straight into a dynamic vertex buffer as a triangle list, with the winding
+	//-- of each edge's faces baked in. a silhouette that does not fit in one lock is drawn in several batches
+	VertexBufferFormat format;
+	format.setPosition ();
+
+	const Vector infinity = ms_silhouetteDirectionToLight_o * ms_shadowVolumeExtrudeDistance;
+
+	uint i;
+	for (i = 0; i < m_shadowPrimitiveList->size (); ++i)
 	{
-		const ShadowEdgePrimitive&      shadowEdgePrimitive    = ms_shadowEdgePrimitiveList [i];
-		const SystemVertexBuffer* const shadowEdgeVertexBuffer = shadowEdgePrimitive.shadowEdgeVertexBuffer;
-		int                             shadowEdgeVertexCount  = shadowEdgePrimitive.shadowEdgeVertexCount;
-		const SystemIndexBuffer* const  shadowEdgeIndexBuffer  = shadowEdgePrimitive.shadowEdgeIndexBuffer;
-		int                             shadowEdgeIndexCount   = shadowEdgePrimitive.shadowEdgeIndexCount;
+		const ShadowPrimitive& shadowPrimitive = *(*m_shadowPrimitiveList) [i];
+		if (shadowPrimitive.isEmpty ())
+			continue;
 
-		if (shadowEdgeVertexCount)
+		int first = 0;
+		while (first < shadowPrimitive.silhouetteEdgeCount)
 		{
-			DEBUG_FATAL (shadowEdgeIndexCount == 0, ("has shadow vertices but no shadow indices"));
+			const int numberOfEdges = std::min (shadowPrimitive.silhouetteEdgeCount - first, ms_maximumVertexBufferSize / cs_verticesPerSilhouetteEdge);
+			const int numberOfVertices = numberOfEdges * cs_verticesPerSilhouetteEdge;
+
+			DynamicVertexBuffer vertexBuffer (format);
+			vertexBuffer.lock (numberOfVertices);
+
+				VertexBufferWriteIterator sv = vertexBuffer.begin ();
+
+				int j;
+				for (j = first; j < first + numberOfEdges; ++j)
+				{
+					const int  silhouetteEdge = shadowPrimitive.silhouetteEdgeArray [j];
+					const Edge& edge          = shadowPrimitive.compactEdgeArray [silhouetteEdge >> 1];
+					const bool invert         = (silhouetteEdge & 1) != 0;
+
+					//-- start with the edge
+					const Vector& v0 = shadowPrimitive.compactVertexArray [edge.v0];
+					const Vector& v1 = shadowPrimitive.compactVertexArray [edge.v1];
+
+					//-- instead of extending to infinity, should we clip against frustum?
+#if SHADOW_EXTRUDE_TO_POINT
+					const Vector v2 = -infinity;
+
+					sv.setPosition (v0);
+					++sv;
+					sv.setPosition (invert ? v1 : v2);
+					++sv;
+					sv.setPosition (invert ? v2 : v1);
+					++sv;
+#else
+					const Vector v2 = v0 - infinity;
+					const Vector v3 = v1 - infinity;
+
+					sv.setPosition (v0);
+					++sv;
+					sv.setPosition (invert ? v1 : v2);
+					++sv;
+					sv.setPosition (invert ? v2 : v1);
+					++sv;
+
+					sv.setPosition (v1);
+					++sv;
+					sv.setPosition (invert ? v3 : v2);
+					++sv;
+					sv.setPosition (invert ? v2 : v3);
+					++sv;
+#endif
+				}
+
+			vertexBuffer.unlock ();
+
+			Graphics::setVertexBuffer (vertexBuffer);
+			Graphics::drawTriangleList ();
 
-			setVertexBuffer (shadowEdgeVertexBuffer, shadowEdgeVertexCount);
-			setIndexBuffer (shadowEdgeIndexBuffer, shadowEdgeIndexCount);
-			Graphics::drawIndexedTriangleList (0, 0, shadowEdgeVertexCount, 0, shadowEdgeIndexCount / 3);
+			first += numberOfEdges;
 		}
 	}
 }
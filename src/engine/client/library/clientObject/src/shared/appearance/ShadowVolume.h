@@ -44,6 +44,8 @@ public:
 		ST_vertexShader
 	};
 
+	typedef stdvector<int>::fwd SilhouetteEdgeList;
+
 public:
 
 	ShadowVolume (ShaderType shaderType, PrimitiveType primitiveType, const char* debugName);
@@ -54,6 +56,14 @@ public:
 	void addPrimitive (const StaticVertexBuffer* vertexBuffer, const StaticIndexBuffer* indexBuffer);
 	void render(Object const * object, const Appearance *appearance) const;
 
+	//-- finds the lit faces and silhouette edges for an object space direction to the light. instance identifies the caster (the proxy passes its appearance);
+	//-- static primitives reuse the silhouette last found for the same instance while its light stays within the silhouette angle. 0 always rebuilds
+	void computeSilhouette (const Vector& directionToLight_o, const void* instance) const;
+
+	//-- the silhouette edges of each primitive from the last computeSilhouette, as (edge index << 1) | 1 if the edge's winding is inverted
+	int  getNumberOfShadowPrimitives () const;
+	void getSilhouetteEdges (int shadowPrimitiveIndex, SilhouetteEdgeList& silhouetteEdgeList) const;
+
 public:
 
 	static void          install ();
@@ -77,6 +87,16 @@ public:
 
 	static void setAllowShadowSubmissions (bool allowShadowSubmissions);
 
+	static bool          getUseSimd ();
+	static void          setUseSimd (bool useSimd);
+
+	static bool          getSilhouetteCacheEnabled ();
+	static void          setSilhouetteCacheEnabled (bool silhouetteCacheEnabled);
+
+	static int           getNumberOfVolumesRebuiltLastFrame ();
+	static int           getNumberOfVolumesReusedLastFrame ();
+	static int           getNumberOfSilhouetteEdgesLastFrame ();
+
 private:
 
 	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -128,6 +148,7 @@ private:
 	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	struct ShadowPrimitive;
+	struct InstanceSilhouette;
 
 	friend class ProxyLocalShaderPrimitive;
 
@@ -166,7 +187,9 @@ private:
 private:
 
 	static void  clearProxyLocalShaderPrimitiveList ();
-	static void  addEdge (ShadowVolume::Edge* const edgeList, int& numberOfEdges, const int v0, const int v1, const int face);
+	static void  buildEdgeConnectivity (ShadowPrimitive& shadowPrimitive);
+	static void  computeFaceDotTests (ShadowPrimitive& shadowPrimitive, const Vector& directionToLight_o);
+	static void  computeCapsAndSilhouette (ShadowPrimitive& shadowPrimitive);
 
 	static void  debugDump ();
 
@@ -194,6 +217,11 @@ private:
 	typedef stdvector<ShadowPrimitive*>::fwd ShadowPrimitiveList;
 	mutable ShadowPrimitiveList*             m_shadowPrimitiveList;
 
+	//-- the last silhouette of each static caster instance, so instances at different orientations do not overwrite each other's
+	typedef stdmap<const void*, InstanceSilhouette*>::fwd InstanceSilhouetteMap;
+	mutable InstanceSilhouetteMap*           m_instanceSilhouetteMap;
+	mutable int                              m_instanceSilhouettePruneFrameNumber;
+
 	//-- used to keep track of how we're doing
 	mutable Metrics                          m_metrics;
 
@@ -201,7 +229,10 @@ private:
 
 	void addPrimitive (const VertexBufferReadIterator& vertexBufferReadIterator, int numberOfVertices, const Index* indexArray, int numberOfIndices);
 
-	void extrudeShadowVolume (const Vector& lightDirection_o) const;
+	InstanceSilhouette* findInstanceSilhouette (const void* instance) const;
+	void pruneInstanceSilhouettes () const;
+	void clearInstanceSilhouettes () const;
+
 	void renderShadowVolumeEdges () const;
 	void renderShadowVolumeCaps (const CapMode capMode) const;
 
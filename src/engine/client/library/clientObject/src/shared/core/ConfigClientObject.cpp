@@ -25,6 +25,7 @@ namespace ConfigClientObjectNamespace
         float        ms_interiorShadowAlpha             = 0.0f;
         const char * ms_screenShader                   = 0;
         bool         ms_disableMeshTestShapes           = false;
+        float        ms_shadowVolumeSilhouetteAngle     = 0.0f;
 }
 using namespace ConfigClientObjectNamespace;
 
@@ -91,6 +92,13 @@ bool ConfigClientObject::getDisableMeshTestShapes()
 	return ms_disableMeshTestShapes;
 }
 
+//----------------------------------------------------------------------
+
+float ConfigClientObject::getShadowVolumeSilhouetteAngle()
+{
+	return ms_shadowVolumeSilhouetteAngle;
+}
+
 //===================================================================
 
 namespace
@@ -126,6 +134,7 @@ void ConfigClientObject::install()
         ms_interiorShadowAlpha             = getKeyFloat("interiorShadowAlpha", 0.1f);
         ms_screenShader                    = getKeyString("screenShader", 0);
         ms_disableMeshTestShapes           = getKeyBool("disableMeshTestShapes", false);
+        ms_shadowVolumeSilhouetteAngle     = getKeyFloat("shadowVolumeSilhouetteAngle", 1.0f);
 }
 
 //===================================================================
@@ -24,6 +24,7 @@ public:
         static float        getInteriorShadowAlpha();
         static const char * getScreenShader();
         static bool         getDisableMeshTestShapes();
+        static float        getShadowVolumeSilhouetteAngle();
 };
 
 //===================================================================
@@ -0,0 +1 @@
+#include "../../src/shared/ParticleQuadPool.h"
\ No newline at end of file
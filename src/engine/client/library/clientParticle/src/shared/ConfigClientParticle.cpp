@@ -47,6 +47,7 @@ namespace ConfigClientParticleNamespace
 	float s_maxGlobalLodDistance = s_maxGlobalLodDistanceDefault;
 	float s_swooshCullDistance = 512.0f;
 	int   s_particleUserLimit = s_maxQuadParticles;
+	int   s_simulationThreadCount = 3;
 
 #ifdef _DEBUG
 	void showDebug();
@@ -127,6 +128,11 @@ void ConfigClientParticle::install()
 	// Raise the default user particle cap to match the higher pool sizes so
 	// large effect sequences can play out without early termination.
 	KEY_INT(particleUserLimit, 4096);
+
+	// Worker threads that simulate emitters in parallel, zero simulates every
+	// emitter on the main thread
+
+	KEY_INT(simulationThreadCount, s_simulationThreadCount);
 }
 
 //-----------------------------------------------------------------------------
@@ -238,4 +244,10 @@ int ConfigClientParticle::getParticleUserLimit()
 	return s_particleUserLimit;
 }
 
+//-----------------------------------------------------------------------------
+int ConfigClientParticle::getSimulationThreadCount()
+{
+	return s_simulationThreadCount;
+}
+
 // ============================================================================
@@ -33,6 +33,7 @@ public:
 	static float getSwooshCullDistance();
 
 	static int getParticleUserLimit();
+	static int getSimulationThreadCount();
 
 #ifdef _DEBUG
 	static bool isDebugEnabled();
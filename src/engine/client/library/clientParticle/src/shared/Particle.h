@@ -18,6 +18,7 @@
 class Particle
 {
 friend class ParticleEmitter;
+friend class ParticleQuadPool;
 
 public:
 
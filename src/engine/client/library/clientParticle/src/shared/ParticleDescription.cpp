@@ -124,6 +124,8 @@ void ParticleDescription::initializeDefault()
 	delete m_particleAttachmentDescriptions;
 	m_particleAttachmentDescriptions = new ParticleAttachmentDescriptions;
 	NOT_NULL(m_particleAttachmentDescriptions);
+
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
@@ -228,36 +230,42 @@ void ParticleDescription::setRandomRotationDirection(bool const randomRotationDi
 void ParticleDescription::setColor(ColorRamp const &color)
 {
 	m_color = color;
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
 void ParticleDescription::setAlpha(WaveForm const &alpha)
 {
 	m_alpha = alpha;
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
 void ParticleDescription::setSpeedScale(WaveForm const &speedScale)
 {
 	m_speedScale = speedScale;
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
 void ParticleDescription::setParticleRelativeRotationX(WaveForm const &particleRelativeRotationX)
 {
 	m_particleRelativeRotationX = particleRelativeRotationX;
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
 void ParticleDescription::setParticleRelativeRotationY(WaveForm const &particleRelativeRotationY)
 {
 	m_particleRelativeRotationY = particleRelativeRotationY;
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
 void ParticleDescription::setParticleRelativeRotationZ(WaveForm const &particleRelativeRotationZ)
 {
 	m_particleRelativeRotationZ = particleRelativeRotationZ;
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
@@ -331,6 +339,11 @@ bool const ParticleDescription::getUsesParticleRelativeRotation() const
 	return m_particleUsesRelativeRotation;
 }
 
+//--------------------------------------------------------------------------
+void ParticleDescription::curvesChanged()
+{
+}
+
 //--------------------------------------------------------------------------
 void ParticleDescription::clearParticleAttachmentDescriptions()
 {
@@ -427,6 +440,8 @@ bool ParticleDescription::load(Iff &iff)
 
 	m_alpha.clampAll(0.0f, 1.0f);
 
+	curvesChanged();
+
 	return result;
 }
 
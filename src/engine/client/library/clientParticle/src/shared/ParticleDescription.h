@@ -74,6 +74,12 @@ public:
 
 	void clearParticleAttachmentDescriptions();
 
+protected:
+
+	// Called whenever a waveform or color ramp of the description changes
+
+	virtual void                    curvesChanged();
+
 protected:
 
 	ColorRamp                       m_color;
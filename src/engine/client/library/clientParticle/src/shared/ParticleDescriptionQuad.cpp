@@ -8,6 +8,7 @@
 #include "clientParticle/FirstClientParticle.h"
 #include "clientParticle/ParticleDescriptionQuad.h"
 
+#include "clientParticle/ParticleQuadPool.h"
 #include "sharedFile/Iff.h"
 
 // ============================================================================
@@ -25,6 +26,7 @@ ParticleDescriptionQuad::ParticleDescriptionQuad()
  , m_width()
  , m_lengthAndWidthLinked(false)
  , m_particleTexture()
+ , m_curves(NULL)
 {
 }
 
@@ -36,9 +38,17 @@ ParticleDescriptionQuad::ParticleDescriptionQuad(ParticleDescriptionQuad const &
  , m_width(particleDescriptionQuad.m_width)
  , m_lengthAndWidthLinked(particleDescriptionQuad.m_lengthAndWidthLinked)
  , m_particleTexture(particleDescriptionQuad.m_particleTexture)
+ , m_curves(NULL)
 {
 }
 
+//--------------------------------------------------------------------------
+ParticleDescriptionQuad::~ParticleDescriptionQuad()
+{
+	delete m_curves;
+	m_curves = NULL;
+}
+
 //--------------------------------------------------------------------------
 ParticleDescription *ParticleDescriptionQuad::clone() const
 {
@@ -61,6 +71,8 @@ void ParticleDescriptionQuad::initializeDefault()
 	setDefaultWidth(m_width);
 	m_lengthAndWidthLinked = false;
 	m_particleTexture = ParticleTexture();
+
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
@@ -106,18 +118,21 @@ void ParticleDescriptionQuad::setDefaultWidth(WaveForm &waveForm)
 void ParticleDescriptionQuad::setRotation(WaveForm const &rotation)
 {
 	m_rotation = rotation;
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
 void ParticleDescriptionQuad::setLength(WaveForm const &length)
 {
 	m_length = length;
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
 void ParticleDescriptionQuad::setWidth(WaveForm const &width)
 {
 	m_width = width;
+	curvesChanged();
 }
 
 //--------------------------------------------------------------------------
@@ -162,6 +177,29 @@ ParticleTexture const &ParticleDescriptionQuad::getParticleTexture() const
 	return m_particleTexture;
 }
 
+//--------------------------------------------------------------------------
+/**
+ * Returns the resampled waveforms used by pooled particles, or NULL if any
+ * waveform can not be resampled.
+ */
+
+ParticleQuadCurves const *ParticleDescriptionQuad::getCurves() const
+{
+	if ((m_curves == NULL) && ParticleQuadCurves::canSample(*this))
+	{
+		m_curves = new ParticleQuadCurves(*this);
+	}
+
+	return m_curves;
+}
+
+//--------------------------------------------------------------------------
+void ParticleDescriptionQuad::curvesChanged()
+{
+	delete m_curves;
+	m_curves = NULL;
+}
+
 //--------------------------------------------------------------------------
 bool ParticleDescriptionQuad::load(Iff &iff)
 {
@@ -243,6 +281,8 @@ bool ParticleDescriptionQuad::load(Iff &iff)
 		initializeDefault();
 	}
 
+	curvesChanged();
+
 	return result;
 }
 
@@ -12,6 +12,8 @@
 #include "clientParticle/ParticleTexture.h"
 #include "sharedMath/WaveForm.h"
 
+class ParticleQuadCurves;
+
 //-----------------------------------------------------------------------------
 class ParticleDescriptionQuad : public ParticleDescription
 {
@@ -19,6 +21,7 @@ public:
 
 	ParticleDescriptionQuad();
 	ParticleDescriptionQuad(ParticleDescriptionQuad const &particleDescriptionQuad);
+	virtual ~ParticleDescriptionQuad();
 
 	static void                     setDefaultRotation(WaveForm &waveForm);
 	static void                     setDefaultLength(WaveForm &waveForm);
@@ -42,6 +45,12 @@ public:
 	bool                   isLengthAndWidthLinked() const;
 	ParticleTexture const &getParticleTexture() const;
 
+	ParticleQuadCurves const *getCurves() const;
+
+protected:
+
+	virtual void                 curvesChanged();
+
 private:
 
 	WaveForm        m_rotation;
@@ -50,6 +59,10 @@ private:
 	bool            m_lengthAndWidthLinked;
 	ParticleTexture m_particleTexture;
 
+	// Resampled waveforms for pooled particles, built on first use
+
+	mutable ParticleQuadCurves *m_curves;
+
 	void load_old_0000(Iff &iff); // These are for backwards compatibility.
 	void load_old_0001(Iff &iff);
 
@@ -56,6 +56,15 @@ namespace ParticleEffectAppearanceNamespace
 	ParticleEmitterGroupListList ms_particleEmitterGroupListList;
 	ParticleEmitterGroupList * newParticleEmitterGroupList();
 	void deleteParticleEmitterGroupList(ParticleEmitterGroupList * particleEmitterGroupList);
+
+	// Emitters simulated together by alter(), one list per alter() in progress
+	// since attachments created while committing alter their own effects
+
+	typedef stdvector<ParticleManager::ParticleEmitterList *>::fwd ParticleEmitterListList;
+
+	ParticleEmitterListList ms_particleEmitterListList;
+	ParticleManager::ParticleEmitterList * newParticleEmitterList();
+	void deleteParticleEmitterList(ParticleManager::ParticleEmitterList * particleEmitterList);
 }
 
 using namespace ParticleEffectAppearanceNamespace;
@@ -88,6 +97,27 @@ void ParticleEffectAppearanceNamespace::deleteParticleEmitterGroupList(ParticleE
 		delete particleEmitterGroupList;
 }
 
+//-----------------------------------------------------------------------------
+ParticleManager::ParticleEmitterList * ParticleEffectAppearanceNamespace::newParticleEmitterList()
+{
+	if (ms_particleEmitterListList.empty())
+	{
+		ms_particleEmitterListList.push_back(new ParticleManager::ParticleEmitterList);
+	}
+
+	ParticleManager::ParticleEmitterList * const result = ms_particleEmitterListList.back();
+	ms_particleEmitterListList.pop_back();
+
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleEffectAppearanceNamespace::deleteParticleEmitterList(ParticleManager::ParticleEmitterList * particleEmitterList)
+{
+	particleEmitterList->clear();
+	ms_particleEmitterListList.push_back(particleEmitterList);
+}
+
 // ============================================================================
 //
 // ParticleEffectAppearance
@@ -128,6 +158,12 @@ void ParticleEffectAppearance::remove()
 		ms_particleEmitterGroupListList.pop_back();
 	}
 
+	while (!ms_particleEmitterListList.empty())
+	{
+		delete ms_particleEmitterListList.back();
+		ms_particleEmitterListList.pop_back();
+	}
+
 	removeMemoryBlockManager();
 }
 
@@ -340,13 +376,15 @@ float ParticleEffectAppearance::alter(float deltaTime)
 
 		float deltaTimeLeft = deltaTime;
 		float const maxDeltaTime = 0.25f;
+		ParticleManager::ParticleEmitterList * const particleEmitterList = newParticleEmitterList();
 		
 		while (deltaTimeLeft > 0.0f)
 		{
 			float const delta = (deltaTimeLeft < maxDeltaTime) ? deltaTimeLeft : maxDeltaTime;
 
 			// Update the effects as normal after the ramp up time and
-			// start up time is over
+			// start up time is over.  The emitters of every group simulate
+			// as one batch so they can be spread over the simulation threads.
 
 			ParticleEmitterGroups::iterator current = m_particleEmitterGroups->begin();
 
@@ -354,12 +392,24 @@ float ParticleEffectAppearance::alter(float deltaTime)
 			{
 				ParticleEmitterGroup *particleEmitterGroup = (*current);
 
-				particleEmitterGroup->alter(delta * playBackRate_w);
+				particleEmitterGroup->prepareSimulation(delta * playBackRate_w, *particleEmitterList);
+			}
+
+			ParticleManager::simulate(*particleEmitterList);
+			particleEmitterList->clear();
+
+			for (current = m_particleEmitterGroups->begin(); current != m_particleEmitterGroups->end(); ++current)
+			{
+				ParticleEmitterGroup *particleEmitterGroup = (*current);
+
+				particleEmitterGroup->commitSimulation();
 			}
 
 			deltaTimeLeft -= delta;
 		}
 
+		deleteParticleEmitterList(particleEmitterList);
+
 		// Build the extent around the effect
 		
 		ParticleEmitterGroups::iterator iterParticleEmitterGroups = m_particleEmitterGroups->begin();
@@ -28,6 +28,7 @@
 #include "clientParticle/ParticleManager.h"
 #include "clientParticle/ParticleMesh.h"
 #include "clientParticle/ParticleQuad.h"
+#include "clientParticle/ParticleQuadPool.h"
 #include "clientParticle/SetupClientParticle.h"
 #include "clientParticle/SwooshAppearance.h"
 #include "sharedCollision/CollisionInfo.h"
@@ -39,6 +40,7 @@
 #include "sharedFile/FileNameUtils.h"
 #include "sharedFile/TreeFile.h"
 #include "sharedFoundation/Clock.h"
+#include "sharedFoundation/Crc.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/FloatMath.h"
 #include "sharedFoundation/FormattedString.h"
@@ -52,6 +54,7 @@
 #include "sharedObject/Object.h"
 #include "sharedObject/TextAppearance.h"
 #include "sharedRandom/Random.h"
+#include "sharedRandom/RandomGenerator.h"
 #include "sharedTerrain/TerrainObject.h"
 
 #include <algorithm>
@@ -80,6 +83,8 @@ namespace ParticleEmitterNamespace
 	void deleteParticleList(ParticleList * particleList);
 	void deleteParticleListList();
 	VectorArgb const & getDebugTextColor();
+	void applyParticleRelativeRotation(float rotationX, float rotationY, float rotationZ, Vector &upVector, Vector &sideVector);
+	void addQuadVertices(VertexBufferWriteIterator &vbwIter, Vector const &position, Vector const &upVector, Vector const &sideVector, PackedArgb const &color, float const *uvs);
 }
 
 using namespace ParticleEmitterNamespace;
@@ -140,6 +145,66 @@ VectorArgb const & ParticleEmitterNamespace::getDebugTextColor()
 	return VectorArgb::solidWhite;
 }
 
+// ----------------------------------------------------------------------------
+void ParticleEmitterNamespace::applyParticleRelativeRotation(float const rotationX, float const rotationY, float const rotationZ, Vector &upVector, Vector &sideVector)
+{
+	Vector unitZ = sideVector.cross(upVector);
+
+	Transform localTransform;
+	localTransform.setLocalFrameIJK_p(sideVector, unitZ, upVector);
+
+	localTransform.yaw_l(rotationY * PI_TIMES_2);
+	localTransform.pitch_l(rotationX * PI_TIMES_2);
+	localTransform.roll_l(rotationZ * PI_TIMES_2);
+
+	upVector = localTransform.rotate_l2p(Vector::unitZ);
+	sideVector = localTransform.rotate_l2p(Vector::unitX);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * Writes the two triangles of a particle quad.  The uvs are the a, b, c and d
+ * corners as returned by ParticleTexture::getUVs().
+ */
+
+void ParticleEmitterNamespace::addQuadVertices(VertexBufferWriteIterator &vbwIter, Vector const &position, Vector const &upVector, Vector const &sideVector, PackedArgb const &color, float const *uvs)
+{
+	Vector const a(position - upVector + sideVector);
+	Vector const b(position + upVector + sideVector);
+	Vector const c(position + upVector - sideVector);
+	Vector const d(position - upVector - sideVector);
+
+	vbwIter.setPosition(a);
+	vbwIter.setColor0(color);
+	vbwIter.setTextureCoordinates(0, uvs[0], uvs[1]);
+	++vbwIter;
+
+	vbwIter.setPosition(c);
+	vbwIter.setColor0(color);
+	vbwIter.setTextureCoordinates(0, uvs[4], uvs[5]);
+	++vbwIter;
+
+	vbwIter.setPosition(b);
+	vbwIter.setColor0(color);
+	vbwIter.setTextureCoordinates(0, uvs[2], uvs[3]);
+	++vbwIter;
+
+	vbwIter.setPosition(a);
+	vbwIter.setColor0(color);
+	vbwIter.setTextureCoordinates(0, uvs[0], uvs[1]);
+	++vbwIter;
+
+	vbwIter.setPosition(d);
+	vbwIter.setColor0(color);
+	vbwIter.setTextureCoordinates(0, uvs[6], uvs[7]);
+	++vbwIter;
+
+	vbwIter.setPosition(c);
+	vbwIter.setColor0(color);
+	vbwIter.setTextureCoordinates(0, uvs[4], uvs[5]);
+	++vbwIter;
+}
+
 // ============================================================================
 //
 // ParticleEmitter::LocalShaderPrimitive
@@ -358,6 +423,7 @@ ParticleEmitter::ParticleEmitter(ParticleEmitterDescription const &particleEmitt
  : ParticleGenerator(particleEffectAppearance)
  , m_particleEmitterDescription(particleEmitterDescription)
  , m_particles(newParticleList())
+ , m_quadPool(createQuadPool())
  , m_particleAttachments((m_particleEmitterDescription.m_particleDescription->getParticleAttachmentDescriptions().size() > 0) ? new ParticleAttachments : NULL)
  , m_lifeTime(Random::randomReal(particleEmitterDescription.getEmitterLifeTimeMin(), particleEmitterDescription.getEmitterLifeTimeMax()))
  , m_age(0.0f)
@@ -396,13 +462,23 @@ ParticleEmitter::ParticleEmitter(ParticleEmitterDescription const &particleEmitt
  , m_currentCameraPosition_w(Vector::zero)
  , m_averageParticlePosition(Vector::zero)
  , m_averageParticleVelocity(Vector::zero)
+ , m_simulationDeltaTime(0.0f)
+ , m_simulationSeed(0)
+ , m_pooledParticleBudget(0)
+ , m_pooledParticleReservation(0)
+ , m_createParticlesThisFrame(false)
+ , m_loopThisFrame(false)
 #ifdef _DEBUG
  , m_debugTextObject(NULL)
  , m_debugTextObjectAppearance(NULL)
  , m_debugTextColor()
 #endif // _DEBUG
 {
-	m_particles->reserve(static_cast<unsigned int>(particleEmitterDescription.m_emitterMaxParticles));
+	if (m_quadPool == NULL)
+	{
+		m_particles->reserve(static_cast<unsigned int>(particleEmitterDescription.m_emitterMaxParticles));
+	}
+
 	m_localShaderPrimitive = new LocalShaderPrimitive(*this);
 
 	DEBUG_FATAL(m_particleEmitterDescription.m_emitterTranslationX.getControlPointCount() < 2, ("m_particleEmitterDescription.m_emitterTranslationX.getControlPointCount() < 2"));
@@ -428,6 +504,13 @@ ParticleEmitter::~ParticleEmitter()
 {
 	removeAllParticles();
 	deleteParticleList(m_particles);
+	delete m_quadPool;
+
+	if (m_pooledParticleReservation > 0)
+	{
+		ParticleQuad::releaseReservedParticles(m_pooledParticleReservation);
+		m_pooledParticleReservation = 0;
+	}
 
 	removeAllAttachments();
 	delete m_particleAttachments;
@@ -458,6 +541,40 @@ void ParticleEmitter::removeAllParticles()
 		delete particle;
 	}
 	m_particles->clear();
+
+	if (m_quadPool != NULL)
+	{
+		m_quadPool->clear();
+		m_quadPool->updateGlobalCount();
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Quad particles are pooled unless the emitter needs per particle behavior
+ * the pool does not implement: attachments, ground collision, flocking,
+ * random direction changes and waveforms that can not be resampled.
+ */
+
+ParticleQuadPool *ParticleEmitter::createQuadPool() const
+{
+	ParticleDescription const * const particleDescription = m_particleEmitterDescription.m_particleDescription;
+
+	if (   !ParticleQuadPool::isEnabled()
+	    || (particleDescription->getParticleType() != ParticleDescription::PT_quad)
+	    || !particleDescription->getParticleAttachmentDescriptions().empty()
+	    || m_particleEmitterDescription.m_particleGroundCollision
+	    || (m_particleEmitterDescription.m_flockingType != ParticleEmitterDescription::FT_none)
+	    || (m_particleEmitterDescription.m_particleChangeDirectionRadian > 0.0f))
+	{
+		return NULL;
+	}
+
+	// Building the curves here also keeps them from being built lazily during an update
+
+	ParticleDescriptionQuad const * const particleDescriptionQuad = safe_cast<ParticleDescriptionQuad const *>(particleDescription);
+
+	return (particleDescriptionQuad->getCurves() != NULL) ? new ParticleQuadPool : NULL;
 }
 
 //-----------------------------------------------------------------------------
@@ -588,7 +705,7 @@ void ParticleEmitter::addToCameraScene(Camera const *camera, Object const *objec
 
 	// Make sure there is something to render
 
-	if (!m_particles->empty())
+	if (getParticleCount() > 0)
 	{
 		// Make sure this is a quad emitter
 
@@ -629,7 +746,14 @@ void ParticleEmitter::draw() const
 	{
 		ParticleDescriptionQuad *particleDescriptionQuad = safe_cast<ParticleDescriptionQuad *>(m_particleEmitterDescription.m_particleDescription);
 
-		drawParticlesQuad(particleDescriptionQuad);
+		if (m_quadPool != NULL)
+		{
+			drawPooledParticlesQuad(particleDescriptionQuad);
+		}
+		else
+		{
+			drawParticlesQuad(particleDescriptionQuad);
+		}
 	}
 }
 
@@ -785,23 +909,36 @@ void ParticleEmitter::drawParticlesQuad(ParticleDescriptionQuad const *particleD
 
 			float const particleWidth = particleDescriptionQuad->isLengthAndWidthLinked() ? particleLength : (particleDescriptionQuad->getWidth().getValue(particle->m_iterWidth, particleAgePercent) * effectScale);
 
+			// Get the current rotation amount
+
+			float currentRotation = (particle->m_initialRotation + particleDescriptionQuad->getRotation().getValue(particle->m_iterRotation, particleAgePercent)) * PI_TIMES_2;
+
+			if (particle->m_initialRotation < 0.0f)
+			{
+				currentRotation *= -1.0f;
+			}
+
 			// Get the render orientation
 
 			Vector upVector;
 			Vector sideVector;
 
-			calculateRenderOrientationVectors(particleDescriptionQuad, *particle, upVector, sideVector, m_object->getTransform_o2w());
+			calculateRenderOrientationVectors(particle->m_position, particle->m_positionPrevious, particle->m_upVector, particle->m_sideVector, currentRotation, upVector, sideVector, m_object->getTransform_o2w());
 
-			float au = 0.0f;
-			float av = 0.0f;
-			float bu = 0.0f;
-			float bv = 0.0f;
-			float cu = 0.0f;
-			float cv = 0.0f;
-			float du = 0.0f;
-			float dv = 0.0f;
+			if (particleDescriptionQuad->getUsesParticleRelativeRotation())
+			{
+				// Add in the particle relative rotation
 
-			particleDescriptionQuad->getParticleTexture().getUVs(particleAgePercent, particle->m_age, au, av, bu, bv, cu, cv, du, dv);
+				float const particleRelativeRotationY = particleDescriptionQuad->getParticleRelativeRotationY().getValue(particle->m_iterParticleRelativeRotationY, particleAgePercent);
+				float const particleRelativeRotationX = particleDescriptionQuad->getParticleRelativeRotationX().getValue(particle->m_iterParticleRelativeRotationX, particleAgePercent);
+				float const particleRelativeRotationZ = particleDescriptionQuad->getParticleRelativeRotationZ().getValue(particle->m_iterParticleRelativeRotationZ, particleAgePercent);
+
+				applyParticleRelativeRotation(particleRelativeRotationX, particleRelativeRotationY, particleRelativeRotationZ, upVector, sideVector);
+			}
+
+			float uvs[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+			particleDescriptionQuad->getParticleTexture().getUVs(particleAgePercent, particle->m_age, uvs[0], uvs[1], uvs[2], uvs[3], uvs[4], uvs[5], uvs[6], uvs[7]);
 
 			Vector particlePosition;
 
@@ -821,62 +958,204 @@ void ParticleEmitter::drawParticlesQuad(ParticleDescriptionQuad const *particleD
 			upVector *= particleLength;
 			sideVector *= particleWidth;
 
-			Vector const a(particlePosition - upVector + sideVector);
-			Vector const b(particlePosition + upVector + sideVector);
-			Vector const c(particlePosition + upVector - sideVector);
-			Vector const d(particlePosition - upVector - sideVector);
-
 			// Add the vertices to the vertex buffer
 
-			vbwIter.setPosition(a);
-			vbwIter.setColor0(color);
-			vbwIter.setTextureCoordinates(0, au, av);
-			++vbwIter;
+			addQuadVertices(vbwIter, particlePosition, upVector, sideVector, color, uvs);
+		}
+	}
+	m_localShaderPrimitive->m_vertexBuffer.unlock();
+	
+	Graphics::setObjectToWorldTransformAndScale(Transform::identity, Vector::xyz111);
+	Graphics::setVertexBuffer(m_localShaderPrimitive->m_vertexBuffer);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Draws the particles of a pooled emitter.  The waveforms are sampled for
+ * all the particles at once, then the quads are written far to near.
+ */
 
-			vbwIter.setPosition(c);
-			vbwIter.setColor0(color);
-			vbwIter.setTextureCoordinates(0, cu, cv);
-			++vbwIter;
+void ParticleEmitter::drawPooledParticlesQuad(ParticleDescriptionQuad const *particleDescriptionQuad) const
+{
+	NOT_NULL(m_quadPool);
+	DEBUG_WARNING((m_object == NULL), ("Rendering with a NULL m_object: %s", getParentParticleEffectAppearance().getAppearanceTemplateName()));
 
-			vbwIter.setPosition(b);
-			vbwIter.setColor0(color);
-			vbwIter.setTextureCoordinates(0, bu, bv);
-			++vbwIter;
+	if (m_object == NULL)
+	{
+		return;
+	}
+
+	ParticleQuadCurves const * const curves = particleDescriptionQuad->getCurves();
+	int const particleCount = m_quadPool->getCount();
 
-			vbwIter.setPosition(a);
-			vbwIter.setColor0(color);
-			vbwIter.setTextureCoordinates(0, au, av);
-			++vbwIter;
+	if ((curves == NULL) || (particleCount == 0))
+	{
+		return;
+	}
+
+	// Sort the particles by their camera space depth
+
+	Transform const &transform_o2w = m_object->getTransform_o2w();
+	Transform const &cameraTransform_o2w = m_localShaderPrimitive->m_camera->getTransform_o2w();
+	Vector const cameraFrameK_w(cameraTransform_o2w.getLocalFrameK_p());
+	Vector const cameraPosition_w(cameraTransform_o2w.getPosition_p());
+
+	if (m_particleEmitterDescription.m_localSpaceParticles)
+	{
+		m_quadPool->sort(transform_o2w.rotate_p2l(cameraFrameK_w), cameraFrameK_w.dot(transform_o2w.getPosition_p() - cameraPosition_w));
+	}
+	else
+	{
+		m_quadPool->sort(cameraFrameK_w, -cameraFrameK_w.dot(cameraPosition_w));
+	}
 
-			vbwIter.setPosition(d);
-			vbwIter.setColor0(color);
-			vbwIter.setTextureCoordinates(0, du, dv);
-			++vbwIter;
+	// Sample the waveforms of every particle
 
-			vbwIter.setPosition(c);
-			vbwIter.setColor0(color);
-			vbwIter.setTextureCoordinates(0, cu, cv);
-			++vbwIter;
+	bool const colorUsesAgePercent = (particleDescriptionQuad->getColor().getSampleType() == ColorRamp::ST_all);
+	bool const lengthAndWidthLinked = particleDescriptionQuad->isLengthAndWidthLinked();
+
+	m_quadPool->sampleRenderAttributes(*curves, colorUsesAgePercent, lengthAndWidthLinked);
+
+	float const * const alphas = m_quadPool->getComponent(ParticleQuadPool::C_alpha);
+	float const * const reds = m_quadPool->getComponent(ParticleQuadPool::C_red);
+	float const * const greens = m_quadPool->getComponent(ParticleQuadPool::C_green);
+	float const * const blues = m_quadPool->getComponent(ParticleQuadPool::C_blue);
+	float const * const lengths = m_quadPool->getComponent(ParticleQuadPool::C_length);
+	float const * const widths = lengthAndWidthLinked ? lengths : m_quadPool->getComponent(ParticleQuadPool::C_width);
+	float const * const rotations = m_quadPool->getComponent(ParticleQuadPool::C_rotation);
+	float const * const initialRotations = m_quadPool->getComponent(ParticleQuadPool::C_initialRotation);
+	float const * const ages = m_quadPool->getComponent(ParticleQuadPool::C_age);
+	float const * const agePercents = m_quadPool->getComponent(ParticleQuadPool::C_agePercent);
+	float const * const particleRelativeRotationXPercents = m_quadPool->getComponent(ParticleQuadPool::C_particleRelativeRotationXPercent);
+	float const * const particleRelativeRotationYPercents = m_quadPool->getComponent(ParticleQuadPool::C_particleRelativeRotationYPercent);
+	float const * const particleRelativeRotationZPercents = m_quadPool->getComponent(ParticleQuadPool::C_particleRelativeRotationZPercent);
+	bool const usesParticleRelativeRotation = particleDescriptionQuad->getUsesParticleRelativeRotation();
+
+	// Get the terrain fog color
+
+	TerrainObject const * const terrainObject = TerrainObject::getConstInstance();
+	float fogColorRed = 1.0f;
+	float fogColorGreen = 1.0f;
+	float fogColorBlue = 1.0f;
+
+	if (terrainObject != NULL)
+	{
+		fogColorRed = static_cast<float>(terrainObject->getFogColor().r) / 255.0f;
+		fogColorGreen = static_cast<float>(terrainObject->getFogColor().g) / 255.0f;
+		fogColorBlue = static_cast<float>(terrainObject->getFogColor().b) / 255.0f;
+	}
+
+	// Get the effect scale
+
+	float const effectScale = getParentParticleEffectAppearance().getScale_w();
+	float const timeOfDayColorPercent = m_particleEmitterDescription.m_particleTimeOfDayColorPercent;
+
+	m_localShaderPrimitive->m_vertexBuffer.lock(particleCount * 6);
+	{
+		VertexBufferWriteIterator vbwIter = m_localShaderPrimitive->m_vertexBuffer.begin();
+
+		VectorArgb const &colorModifier = getParentParticleEffectAppearance().getColorModifier();
+		VectorArgb const &globalColorModifier = ParticleEffectAppearance::getGlobalColorModifier();
+
+		for (int order = 0; order < particleCount; ++order)
+		{
+			int const index = m_quadPool->getSortedIndex(order);
+
+			DEBUG_FATAL((alphas[index] < 0.0f) || (alphas[index] > 1.0f), ("alpha(%f) out of range", alphas[index]));
+
+			// Add in the code driven color modifiers
+
+			float red = reds[index] * colorModifier.r * globalColorModifier.r;
+			float green = greens[index] * colorModifier.g * globalColorModifier.g;
+			float blue = blues[index] * colorModifier.b * globalColorModifier.b;
+			float const alpha = alphas[index] * colorModifier.a * globalColorModifier.a;
+
+			if (timeOfDayColorPercent > 0.0f)
+			{
+				red += (fogColorRed - red) * timeOfDayColorPercent;
+				green += (fogColorGreen - green) * timeOfDayColorPercent;
+				blue += (fogColorBlue - blue) * timeOfDayColorPercent;
+			}
+
+			PackedArgb color(VectorArgb(alpha, red, green, blue));
+
+			// Get the current rotation amount
+
+			float currentRotation = (initialRotations[index] + rotations[index]) * PI_TIMES_2;
+
+			if (initialRotations[index] < 0.0f)
+			{
+				currentRotation *= -1.0f;
+			}
+
+			// Get the render orientation
+
+			Vector const position(m_quadPool->getPosition(index));
+			Vector upVector;
+			Vector sideVector;
+
+			calculateRenderOrientationVectors(position, m_quadPool->getPositionPrevious(index), m_quadPool->getUpVector(index), m_quadPool->getSideVector(index), currentRotation, upVector, sideVector, transform_o2w);
+
+			if (usesParticleRelativeRotation)
+			{
+				float const agePercent = agePercents[index];
+				float const particleRelativeRotationX = curves->m_particleRelativeRotationX.sample(agePercent, particleRelativeRotationXPercents[index]);
+				float const particleRelativeRotationY = curves->m_particleRelativeRotationY.sample(agePercent, particleRelativeRotationYPercents[index]);
+				float const particleRelativeRotationZ = curves->m_particleRelativeRotationZ.sample(agePercent, particleRelativeRotationZPercents[index]);
+
+				applyParticleRelativeRotation(particleRelativeRotationX, particleRelativeRotationY, particleRelativeRotationZ, upVector, sideVector);
+			}
+
+			float uvs[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+			particleDescriptionQuad->getParticleTexture().getUVs(agePercents[index], ages[index], uvs[0], uvs[1], uvs[2], uvs[3], uvs[4], uvs[5], uvs[6], uvs[7]);
+
+			upVector *= lengths[index] * effectScale;
+			sideVector *= widths[index] * effectScale;
+
+			// Local or world space
+
+			Vector const particlePosition(m_particleEmitterDescription.m_localSpaceParticles ? transform_o2w.rotateTranslate_l2p(position) : position);
+
+			addQuadVertices(vbwIter, particlePosition, upVector, sideVector, color, uvs);
 		}
 	}
 	m_localShaderPrimitive->m_vertexBuffer.unlock();
-	
+
 	Graphics::setObjectToWorldTransformAndScale(Transform::identity, Vector::xyz111);
 	Graphics::setVertexBuffer(m_localShaderPrimitive->m_vertexBuffer);
 }
 
 //-----------------------------------------------------------------------------
 void ParticleEmitter::alter(float const deltaTime)
+{
+	if (prepareSimulation(deltaTime))
+	{
+		simulate();
+		commitSimulation();
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * The first step of alter(), run on the main thread in emitter order.  Moves
+ * the emitter, starts and stops its sound and decides what simulate() does.
+ *
+ * @return false if the emitter has nothing to simulate.
+ */
+
+bool ParticleEmitter::prepareSimulation(float const deltaTime)
 {
 	DEBUG_WARNING((m_object == NULL), ("Altering with a NULL m_object: %s", getParentParticleEffectAppearance().getAppearanceTemplateName()));
 
 	if (m_object == NULL)
 	{
-		return;
+		return false;
 	}
 
-	bool createParticlesThisFrame = false;
-	bool doLoop = false;
+	m_simulationDeltaTime = deltaTime;
+	m_createParticlesThisFrame = false;
+	m_loopThisFrame = false;
 
 	// Reset the extent
 
@@ -955,7 +1234,7 @@ void ParticleEmitter::alter(float const deltaTime)
 					m_accumulatedDistance += a.magnitudeBetweenSquared(b);
 				}
 
-				createParticlesThisFrame = true;
+				m_createParticlesThisFrame = true;
 
 				// Unmark the first frame
 
@@ -976,13 +1255,13 @@ void ParticleEmitter::alter(float const deltaTime)
 				{
 					// Loop immediately regardless of the number of particles alive
 
-					doLoop = true;
+					m_loopThisFrame = true;
 				}
-				else if (m_particles->empty())
+				else if (getParticleCount() == 0)
 				{
 					// Wait until all the particles are dead before we allow a loop
 
-					doLoop = true;
+					m_loopThisFrame = true;
 				}
 			}
 		}
@@ -1039,23 +1318,71 @@ void ParticleEmitter::alter(float const deltaTime)
 		m_previousTransform_o2w = m_object->getTransform_o2w();
 	}
 
+	// The object to world transforms are cached lazily, resolve them here so
+	// simulate() only reads them
+
+	IGNORE_RETURN(m_object->getTransform_o2w());
+
+	// Everything simulate() draws comes from a generator seeded here, so the
+	// particles do not depend on the thread or order emitters simulate in
+
+	m_simulationSeed = static_cast<uint32>(Random::random());
+
+	if (m_quadPool != NULL)
+	{
+		// Reserve the room simulate() may fill so the emitters simulating
+		// in the same batch can not all claim the same free quads
+
+		DEBUG_FATAL((m_pooledParticleReservation != 0), ("ParticleEmitter::prepareSimulation() - Prepared again before the last simulation was committed"));
+
+		int const emitterRoom = static_cast<int>(ceil(m_particleEmitterDescription.m_emitterMaxParticles)) - getParticleCount();
+
+		m_pooledParticleReservation = ParticleQuad::reserveParticles(m_particleEmitterDescription.m_usePriorityParticles, emitterRoom);
+		m_pooledParticleBudget = m_pooledParticleReservation;
+
+		// Rebuilds the curves if the description was edited
+
+		ParticleDescriptionQuad const * const particleDescriptionQuad = safe_cast<ParticleDescriptionQuad const *>(m_particleEmitterDescription.m_particleDescription);
+		IGNORE_RETURN(particleDescriptionQuad->getCurves());
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * The second step of alter().  Updates, creates and expires the particles
+ * and calculates the extent and lod.
+ *
+ * An emitter that canSimulateInParallel() only changes its own state here,
+ * so it can simulate on any thread once every emitter it shares a batch
+ * with has been prepared.
+ */
+
+void ParticleEmitter::simulate()
+{
+	RandomGenerator generator(m_simulationSeed);
+	RandomGenerator * const previousGenerator = Random::getThreadGenerator();
+	Random::setThreadGenerator(&generator);
+
+	float const deltaTime = m_simulationDeltaTime;
+
 	// Update existing particles
 
 	updateExistingParticles(deltaTime);
 
 	// Create new particles, new particles get their own update on their first frame
 
-	if (createParticlesThisFrame)
+	if (m_createParticlesThisFrame)
 	{
 		createNewParticles(deltaTime);
 	}
 
 	removeOldParticles();
-	removeOldAttachments();
 
 	// Update the extents
 	
-	if (   (m_particles->empty())
+	if (   (getParticleCount() == 0)
 		|| (m_object == NULL))
 	{
 		if (m_object != NULL)
@@ -1106,9 +1433,34 @@ void ParticleEmitter::alter(float const deltaTime)
 
 	calculateLod();
 
+	Random::setThreadGenerator(previousGenerator);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * The last step of alter(), run on the main thread in emitter order.
+ * Publishes the particle count and loops the emitter.
+ */
+
+void ParticleEmitter::commitSimulation()
+{
+	if (m_quadPool != NULL)
+	{
+		// Count the quads simulate() added before giving back the room they
+		// were reserved from
+
+		m_quadPool->updateGlobalCount();
+
+		ParticleQuad::releaseReservedParticles(m_pooledParticleReservation);
+		m_pooledParticleReservation = 0;
+		m_pooledParticleBudget = 0;
+	}
+
+	removeOldAttachments();
+
 	// See if we need to loop
 
-	if (doLoop)
+	if (m_loopThisFrame)
 	{
 		// Increment the number of times we have looped
 
@@ -1256,6 +1608,21 @@ void ParticleEmitter::alter(float const deltaTime)
 #endif // _DEBUG
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Emitters that keep their quads in a pool only touch their own state in
+ * simulate().  Every other emitter allocates particles from shared memory
+ * block managers, queries the terrain and collision world or creates
+ * attachment and mesh objects, so it has to simulate on the main thread.
+ */
+
+bool ParticleEmitter::canSimulateInParallel() const
+{
+	bool const snapsToTerrain = m_particleEmitterDescription.m_particleSnapToTerrainOnCreation && !m_particleEmitterDescription.m_localSpaceParticles;
+
+	return (m_quadPool != NULL) && !snapsToTerrain;
+}
+
 //-----------------------------------------------------------------------------
 bool ParticleEmitter::isDeletable() const
 {
@@ -1277,7 +1644,9 @@ bool ParticleEmitter::isDeletable() const
 //-----------------------------------------------------------------------------
 int ParticleEmitter::getParticleCount() const
 {
-	return static_cast<int>(m_particles->size());
+	int const pooledParticleCount = (m_quadPool != NULL) ? m_quadPool->getCount() : 0;
+
+	return static_cast<int>(m_particles->size()) + pooledParticleCount;
 }
 
 //-----------------------------------------------------------------------------
@@ -1379,7 +1748,7 @@ void ParticleEmitter::initializeSingleParticle(Particle &particle)
 				// Set the direction vector
 
 				float const spread = m_particleEmitterDescription.m_emitterSpread.getValue(m_iterEmitterSpread, emitterAgePercent) * PI_OVER_180;
-				float const rotation1 = (rand() % 2) ? spread : -spread;
+				float const rotation1 = (Random::random(0, 1)) ? spread : -spread;
 				float const rotation2 = Random::randomReal(-PI, PI);
 				//float const x1 = 0.0f;
 				float const y1 = 1.0f;
@@ -1567,11 +1936,11 @@ void ParticleEmitter::createSingleParticleMesh(ParticleDescriptionMesh const *pa
 		particleMesh->m_iterRotationY.reset(particleDescriptionMesh->m_rotationY.getIteratorBegin());
 		particleMesh->m_iterRotationZ.reset(particleDescriptionMesh->m_rotationZ.getIteratorBegin());
 		particleMesh->m_rotationInitial.x = (m_particleEmitterDescription.m_particleRandomInitialRotation) ? Random::randomReal(0.0f, 1.0f) : 1.0f;
-		particleMesh->m_rotationInitial.x *= (particleDescriptionMesh->isRandomRotationDirection()) ? ((rand() % 2) ? 1.0f : -1.0f) : 1.0f;
+		particleMesh->m_rotationInitial.x *= (particleDescriptionMesh->isRandomRotationDirection()) ? ((Random::random(0, 1)) ? 1.0f : -1.0f) : 1.0f;
 		particleMesh->m_rotationInitial.y = (m_particleEmitterDescription.m_particleRandomInitialRotation) ? Random::randomReal(0.0f, 1.0f) : 1.0f;
-		particleMesh->m_rotationInitial.y *= (particleDescriptionMesh->isRandomRotationDirection()) ? ((rand() % 2) ? 1.0f : -1.0f) : 1.0f;
+		particleMesh->m_rotationInitial.y *= (particleDescriptionMesh->isRandomRotationDirection()) ? ((Random::random(0, 1)) ? 1.0f : -1.0f) : 1.0f;
 		particleMesh->m_rotationInitial.z = (m_particleEmitterDescription.m_particleRandomInitialRotation) ? Random::randomReal(0.0f, 1.0f) : 1.0f;
-		particleMesh->m_rotationInitial.z *= (particleDescriptionMesh->isRandomRotationDirection()) ? ((rand() % 2) ? 1.0f : -1.0f) : 1.0f;
+		particleMesh->m_rotationInitial.z *= (particleDescriptionMesh->isRandomRotationDirection()) ? ((Random::random(0, 1)) ? 1.0f : -1.0f) : 1.0f;
 
 		// Initialize the shared values
 
@@ -1588,9 +1957,33 @@ void ParticleEmitter::createSingleParticleQuad(ParticleDescriptionQuad const *pa
 {
 	NOT_NULL(m_particles);
 
-	// Make sure the global list has room for another particle
+	if (m_quadPool != NULL)
+	{
+		// Pooled quads are limited by the room reserved when the simulation
+		// was prepared, the global list may not be read from a job
+
+		if (m_pooledParticleBudget > 0)
+		{
+			ParticleQuadCurves const * const curves = particleDescriptionQuad->getCurves();
+
+			if (curves != NULL)
+			{
+				// Initialize the particle on the stack and copy it into the pool
+
+				ParticleQuad particleQuad;
+
+				initializeSingleParticleQuad(particleDescriptionQuad, particleQuad);
+
+				int const particleIndex = m_quadPool->add(particleQuad);
+				--m_pooledParticleBudget;
+
+				// Simulate the initial delta time
 
-	if (!ParticleQuad::isParticlePoolFull(m_particleEmitterDescription.m_usePriorityParticles))
+				updatePooledParticles(*curves, particleIndex, particleIndex + 1, deltaTime);
+			}
+		}
+	}
+	else if (!ParticleQuad::isParticlePoolFull(m_particleEmitterDescription.m_usePriorityParticles))
 	{
 		// Create a new particle
 
@@ -1600,90 +1993,96 @@ void ParticleEmitter::createSingleParticleQuad(ParticleDescriptionQuad const *pa
 
 		m_particles->push_back(particleQuad);
 
-		// Initialize the quad particle values
+		initializeSingleParticleQuad(particleDescriptionQuad, *particleQuad);
 
-		particleQuad->m_initialRotation = (m_particleEmitterDescription.m_particleRandomInitialRotation) ? Random::randomReal(0.0f, 1.0f) : 1.0f;
-		particleQuad->m_initialRotation *= (!m_particleEmitterDescription.m_particleDescription->isRandomRotationDirection()) ? 1.0f : ((rand() % 2) ? 1.0f : -1.0f);
-		particleQuad->m_iterLength.reset(particleDescriptionQuad->getLength().getIteratorBegin());
-		particleQuad->m_iterWidth.reset(particleDescriptionQuad->getWidth().getIteratorBegin());
-		particleQuad->m_iterRotation.reset(particleDescriptionQuad->getRotation().getIteratorBegin());
-		particleQuad->m_iterColor.reset(m_particleEmitterDescription.m_particleDescription->getColor().getIteratorBegin());
-		particleQuad->m_iterAlpha.reset(m_particleEmitterDescription.m_particleDescription->getAlpha().getIteratorBegin());
+		// Simulate the initial delta time
 
-		// Initialize the shared values
+		updateSingleParticle(particleQuad, deltaTime);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void ParticleEmitter::initializeSingleParticleQuad(ParticleDescriptionQuad const *particleDescriptionQuad, ParticleQuad &particleQuad)
+{
+	// Initialize the quad particle values
 
-		initializeSingleParticle(*particleQuad);
+	particleQuad.m_initialRotation = (m_particleEmitterDescription.m_particleRandomInitialRotation) ? Random::randomReal(0.0f, 1.0f) : 1.0f;
+	particleQuad.m_initialRotation *= (!m_particleEmitterDescription.m_particleDescription->isRandomRotationDirection()) ? 1.0f : ((Random::random(0, 1)) ? 1.0f : -1.0f);
+	particleQuad.m_iterLength.reset(particleDescriptionQuad->getLength().getIteratorBegin());
+	particleQuad.m_iterWidth.reset(particleDescriptionQuad->getWidth().getIteratorBegin());
+	particleQuad.m_iterRotation.reset(particleDescriptionQuad->getRotation().getIteratorBegin());
+	particleQuad.m_iterColor.reset(m_particleEmitterDescription.m_particleDescription->getColor().getIteratorBegin());
+	particleQuad.m_iterAlpha.reset(m_particleEmitterDescription.m_particleDescription->getAlpha().getIteratorBegin());
 
-		// Set the direction the particle is facing
+	// Initialize the shared values
 
-		if (particleQuad->m_velocity == Vector::zero)
-		{
-			// The particle is not moving, position it facing the direction the
-			// emitter is moving
+	initializeSingleParticle(particleQuad);
+
+	// Set the direction the particle is facing
 
-			Vector a(m_object->getPosition_w());
-			Vector b(m_previousTransform_o2w.getPosition_p());
-			Vector deltaPosition(a - b);
+	if (particleQuad.m_velocity == Vector::zero)
+	{
+		// The particle is not moving, position it facing the direction the
+		// emitter is moving
+
+		Vector a(m_object->getPosition_w());
+		Vector b(m_previousTransform_o2w.getPosition_p());
+		Vector deltaPosition(a - b);
 
-			if (deltaPosition == Vector::zero)
+		if (deltaPosition == Vector::zero)
+		{
+			if (m_particleEmitterDescription.m_localSpaceParticles)
 			{
-				if (m_particleEmitterDescription.m_localSpaceParticles)
-				{
-					particleQuad->m_upVector = Vector::unitY;
-				}
-				else
-				{
-					particleQuad->m_upVector = m_object->getTransform_o2w().getLocalFrameJ_p();
-				}
+				particleQuad.m_upVector = Vector::unitY;
 			}
 			else
 			{
-				particleQuad->m_upVector = deltaPosition;
+				particleQuad.m_upVector = m_object->getTransform_o2w().getLocalFrameJ_p();
 			}
 		}
 		else
 		{
-			particleQuad->m_upVector = particleQuad->m_velocity;
+			particleQuad.m_upVector = deltaPosition;
 		}
+	}
+	else
+	{
+		particleQuad.m_upVector = particleQuad.m_velocity;
+	}
 
-		IGNORE_RETURN(particleQuad->m_upVector.normalize());
+	IGNORE_RETURN(particleQuad.m_upVector.normalize());
 
-		if (m_particleEmitterDescription.m_particleOrientation == ParticleEmitterDescription::PO_orientWithVelocity)
+	if (m_particleEmitterDescription.m_particleOrientation == ParticleEmitterDescription::PO_orientWithVelocity)
+	{
+		if (m_particleEmitterDescription.m_localSpaceParticles)
 		{
-			if (m_particleEmitterDescription.m_localSpaceParticles)
-			{
-				Vector localFrameJ_o(m_object->getTransform_o2p().getLocalFrameJ_p());
+			Vector localFrameJ_o(m_object->getTransform_o2p().getLocalFrameJ_p());
 
-				if (particleQuad->m_upVector == localFrameJ_o)
-				{
-					particleQuad->m_sideVector = particleQuad->m_upVector.cross(m_object->getTransform_o2p().getLocalFrameK_p());
-				}
-				else
-				{
-					particleQuad->m_sideVector = particleQuad->m_upVector.cross(localFrameJ_o);
-				}
+			if (particleQuad.m_upVector == localFrameJ_o)
+			{
+				particleQuad.m_sideVector = particleQuad.m_upVector.cross(m_object->getTransform_o2p().getLocalFrameK_p());
 			}
 			else
 			{
-				Vector localFrameJ_w(m_object->getTransform_o2w().getLocalFrameJ_p());
-
-				if (particleQuad->m_upVector.withinEpsilon(localFrameJ_w,0.01f)) 
-				{
-					particleQuad->m_sideVector = particleQuad->m_upVector.cross(m_object->getTransform_o2w().getLocalFrameK_p());
-				}
-				else
-				{
-					particleQuad->m_sideVector = particleQuad->m_upVector.cross(localFrameJ_w);
-				}
+				particleQuad.m_sideVector = particleQuad.m_upVector.cross(localFrameJ_o);
+			}
+		}
+		else
+		{
+			Vector localFrameJ_w(m_object->getTransform_o2w().getLocalFrameJ_p());
 
+			if (particleQuad.m_upVector.withinEpsilon(localFrameJ_w,0.01f)) 
+			{
+				particleQuad.m_sideVector = particleQuad.m_upVector.cross(m_object->getTransform_o2w().getLocalFrameK_p());
+			}
+			else
+			{
+				particleQuad.m_sideVector = particleQuad.m_upVector.cross(localFrameJ_w);
 			}
 
-			IGNORE_RETURN(particleQuad->m_sideVector.normalize());
 		}
 
-		// Simulate the initial delta time
-
-		updateSingleParticle(particleQuad, deltaTime);
+		IGNORE_RETURN(particleQuad.m_sideVector.normalize());
 	}
 }
 
@@ -1713,6 +2112,23 @@ void ParticleEmitter::updateExistingParticles(float const deltaTime)
 
 	if (deltaTime > 0.0f)
 	{
+		if (m_quadPool != NULL)
+		{
+			ParticleDescriptionQuad const * const particleDescriptionQuad = safe_cast<ParticleDescriptionQuad const *>(m_particleEmitterDescription.m_particleDescription);
+			ParticleQuadCurves const * const curves = particleDescriptionQuad->getCurves();
+
+			if (curves != NULL)
+			{
+				updatePooledParticles(*curves, 0, m_quadPool->getCount(), deltaTime);
+			}
+			else
+			{
+				// The description was edited into one the pool can not sample
+
+				m_quadPool->clear();
+			}
+		}
+
 		Particles::iterator particleListIter = m_particles->begin();
 
 #ifdef _DEBUG
@@ -1729,6 +2145,48 @@ void ParticleEmitter::updateExistingParticles(float const deltaTime)
 	}
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Updates the pooled particles in [first, end), the pooled counterpart of
+ * updateSingleParticle().
+ */
+
+void ParticleEmitter::updatePooledParticles(ParticleQuadCurves const &curves, int const first, int const end, float const deltaTime)
+{
+	NOT_NULL(m_quadPool);
+
+	ParticleDescriptionQuad const * const particleDescriptionQuad = safe_cast<ParticleDescriptionQuad const *>(m_particleEmitterDescription.m_particleDescription);
+
+	ParticleQuadPool::UpdateParameters parameters;
+
+	parameters.m_curves = &curves;
+	parameters.m_effectScale = getParentParticleEffectAppearance().getScale_w();
+	parameters.m_lengthAndWidthLinked = particleDescriptionQuad->isLengthAndWidthLinked();
+	parameters.m_orientWithVelocity = (m_particleEmitterDescription.m_particleOrientation == ParticleEmitterDescription::PO_orientWithVelocity) ||
+	                                  (m_particleEmitterDescription.m_particleOrientation == ParticleEmitterDescription::PO_orientWithVelocityBankToCamera);
+
+	if (   !m_particleEmitterDescription.m_localSpaceParticles
+	    && ParticleEffectAppearance::isGlobalWindEnabled())
+	{
+		parameters.m_wind = (1.0f - m_particleEmitterDescription.m_windResistenceGlobalPercent) * ParticleEffectAppearance::getGlobalWind();
+	}
+
+	Vector extentMin(Vector::maxXYZ);
+	Vector extentMax(Vector::negativeMaxXYZ);
+
+	m_quadPool->update(first, end, deltaTime, parameters, extentMin, extentMax);
+
+	// Only grow the emitter extents if any of the particles were alive
+
+	if (   (extentMin.x <= extentMax.x)
+	    && (extentMin.y <= extentMax.y)
+	    && (extentMin.z <= extentMax.z))
+	{
+		m_extent_w.updateMinAndMax(extentMin);
+		m_extent_w.updateMinAndMax(extentMax);
+	}
+}
+
 //-----------------------------------------------------------------------------
 void ParticleEmitter::updateSingleParticle(Particle *particle, float const deltaTime)
 {
@@ -2440,17 +2898,8 @@ void ParticleEmitter::updateSingleParticle(Particle *particle, float const delta
 }
 
 //-----------------------------------------------------------------------------
-void ParticleEmitter::calculateRenderOrientationVectors(ParticleDescriptionQuad const *particleDescriptionQuad, ParticleQuad &particle, Vector &upVector, Vector &sideVector, Transform const &transform) const
+void ParticleEmitter::calculateRenderOrientationVectors(Vector const &position, Vector const &positionPrevious, Vector const &particleUpVector, Vector const &particleSideVector, float const currentRotation, Vector &upVector, Vector &sideVector, Transform const &transform) const
 {
-	// Get the current rotation amount
-
-	float currentRotation = (particle.m_initialRotation + particleDescriptionQuad->getRotation().getValue(particle.m_iterRotation, particle.getAgePercent())) * PI_TIMES_2;
-
-	if (particle.m_initialRotation < 0.0f)
-	{
-		currentRotation *= -1.0f;
-	}
-	
 	// Get the up and side vector
 
 	switch (m_particleEmitterDescription.m_particleOrientation)
@@ -2476,45 +2925,45 @@ void ParticleEmitter::calculateRenderOrientationVectors(ParticleDescriptionQuad
 				{
 					// Up vector
 
-					upVector = transform.rotate_l2p(particle.m_position) - transform.rotate_l2p(particle.m_positionPrevious);
+					upVector = transform.rotate_l2p(position) - transform.rotate_l2p(positionPrevious);
 
 					if (upVector == Vector::zero)
 					{
-						if (particle.m_upVector == Vector::zero)
+						if (particleUpVector == Vector::zero)
 						{
 							upVector = transform.rotate_l2p(Vector::unitX);
 						}
 						else
 						{
-							upVector = transform.rotate_l2p(particle.m_upVector);
+							upVector = transform.rotate_l2p(particleUpVector);
 						}
 					}
 
 					// Side vector
 
-					sideVector = transform.rotate_l2p(particle.m_sideVector);
+					sideVector = transform.rotate_l2p(particleSideVector);
 				}
 				else
 				{
 					// Up vector
 
-					upVector = particle.m_position - particle.m_positionPrevious;
+					upVector = position - positionPrevious;
 
 					if (upVector == Vector::zero)
 					{
-						if (particle.m_upVector == Vector::zero)
+						if (particleUpVector == Vector::zero)
 						{
 							upVector = Vector::unitX;
 						}
 						else
 						{
-							upVector = particle.m_upVector;
+							upVector = particleUpVector;
 						}
 					}
 
 					// Side vector
 
-					sideVector = particle.m_sideVector;
+					sideVector = particleSideVector;
 				}
 
 				upVector.normalize();
@@ -2526,18 +2975,18 @@ void ParticleEmitter::calculateRenderOrientationVectors(ParticleDescriptionQuad
 				{
 					// Up vector
 
-					upVector = transform.rotate_l2p(particle.m_position) - transform.rotate_l2p(particle.m_positionPrevious);
+					upVector = transform.rotate_l2p(position) - transform.rotate_l2p(positionPrevious);
 
 					if (upVector == Vector::zero)
 					{
-						upVector = transform.rotate_l2p(particle.m_upVector);
+						upVector = transform.rotate_l2p(particleUpVector);
 					}
 
 					upVector.normalize();
 
 					// Side vector
 
-					Vector directionToCamera(m_localShaderPrimitive->m_camera->getPosition_w() - transform.rotateTranslate_l2p(particle.m_position));
+					Vector directionToCamera(m_localShaderPrimitive->m_camera->getPosition_w() - transform.rotateTranslate_l2p(position));
 
 					sideVector = upVector.cross(directionToCamera);
 				}
@@ -2545,11 +2994,11 @@ void ParticleEmitter::calculateRenderOrientationVectors(ParticleDescriptionQuad
 				{
 					// Up vector
 
-					upVector = particle.m_upVector;
+					upVector = particleUpVector;
 
 					// Side vector
 
-					Vector directionToCamera(m_localShaderPrimitive->m_camera->getPosition_w() - particle.m_position);
+					Vector directionToCamera(m_localShaderPrimitive->m_camera->getPosition_w() - position);
 
 					sideVector = upVector.cross(directionToCamera);
 				}
@@ -2563,29 +3012,6 @@ void ParticleEmitter::calculateRenderOrientationVectors(ParticleDescriptionQuad
 			}
 			break;
 	}
-
-	if(m_particleEmitterDescription.m_particleDescription->getUsesParticleRelativeRotation())
-	{
-	
-		// Add in the particle relative rotation
-
-		Vector unitZ = sideVector.cross(upVector);
-
-		Transform localTransform;
-		localTransform.setLocalFrameIJK_p(sideVector, unitZ, upVector);
-
-		float const particleRelativeRotationY = m_particleEmitterDescription.m_particleDescription->getParticleRelativeRotationY().getValue(particle.m_iterParticleRelativeRotationY, particle.getAgePercent());
-		localTransform.yaw_l(particleRelativeRotationY * PI_TIMES_2);
-
-		float const particleRelativeRotationX = m_particleEmitterDescription.m_particleDescription->getParticleRelativeRotationX().getValue(particle.m_iterParticleRelativeRotationX, particle.getAgePercent());
-		localTransform.pitch_l(particleRelativeRotationX * PI_TIMES_2);
-
-		float const particleRelativeRotationZ = m_particleEmitterDescription.m_particleDescription->getParticleRelativeRotationZ().getValue(particle.m_iterParticleRelativeRotationZ, particle.getAgePercent());
-		localTransform.roll_l(particleRelativeRotationZ * PI_TIMES_2);
-		
-		upVector = localTransform.rotate_l2p(Vector::unitZ);
-		sideVector = localTransform.rotate_l2p(Vector::unitX);		
-	}
 }
 
 //-----------------------------------------------------------------------------
@@ -2627,6 +3053,11 @@ void ParticleEmitter::removeOldParticles()
 		Particles::iterator iter = std::remove_if(m_particles->begin(), m_particles->end(), ParticleDead());
 		IGNORE_RETURN(m_particles->erase(iter, m_particles->end()));
 	}
+
+	if (m_quadPool != NULL)
+	{
+		m_quadPool->removeDeadParticles();
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -2676,14 +3107,14 @@ void ParticleEmitter::createNewParticles(float const deltaTime)
 		// This handles one shots that shoot one time and it handles one shots that emit groups of particles at
 		// a time.
 
-		if ((m_particles->empty()) || m_particleEmitterDescription.m_emitterLoopImmediately)
+		if ((getParticleCount() == 0) || m_particleEmitterDescription.m_emitterLoopImmediately)
 		{
 			int const generationRate = Random::random(m_particleEmitterDescription.m_emitterOneShotMin, m_particleEmitterDescription.m_emitterOneShotMax);
 
 			// Make sure there is room for all the requested one shot particles, if not it waits until there
 			// is room for the whole bunch.
 
-			if ((m_particles->size() + generationRate) <= m_particleEmitterDescription.m_emitterMaxParticles)
+			if ((getParticleCount() + generationRate) <= m_particleEmitterDescription.m_emitterMaxParticles)
 			{
 				m_newParticles = static_cast<float>(generationRate);
 			}
@@ -2729,7 +3160,7 @@ void ParticleEmitter::createNewParticles(float const deltaTime)
 	{
 		// Throw out new particles if there is no room for them in this emitter
 
-		if (m_particles->size() < m_particleEmitterDescription.m_emitterMaxParticles)
+		if (getParticleCount() < m_particleEmitterDescription.m_emitterMaxParticles)
 		{
 			if (m_particleEmitterDescription.m_emitterOneShot || (m_particleEmitterDescription.m_firstParticleImmediately && m_frameFirst))
 			{
@@ -2787,10 +3218,52 @@ void ParticleEmitter::frameLast()
 Particle const &ParticleEmitter::getParticle(int const particleIndex) const
 {
 	NOT_NULL(m_particles);
+	DEBUG_FATAL((m_quadPool != NULL), ("ParticleEmitter::getParticle() - Pooled quad particles are not stored as Particles"));
 
 	return *(*m_particles)[particleIndex];
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Folds the state of every particle into checksum, so two runs of the same
+ * effect can be compared.
+ */
+
+uint32 ParticleEmitter::calculateParticleChecksum(uint32 checksum) const
+{
+	int const particleCount = getParticleCount();
+
+	checksum = Crc::calculate(&particleCount, sizeof(particleCount), checksum);
+	checksum = Crc::calculate(&m_newParticles, sizeof(m_newParticles), checksum);
+	checksum = Crc::calculate(&m_lodPercent, sizeof(m_lodPercent), checksum);
+
+	if ((m_quadPool != NULL) && (m_quadPool->getCount() > 0))
+	{
+		// The sampled components are scratch space, only the simulated ones are compared
+
+		int const length = m_quadPool->getCount() * static_cast<int>(sizeof(float));
+
+		for (int component = 0; component < ParticleQuadPool::C_alive; ++component)
+		{
+			checksum = Crc::calculate(m_quadPool->getComponent(static_cast<ParticleQuadPool::Component>(component)), length, checksum);
+		}
+	}
+
+	Particles::const_iterator iterParticles = m_particles->begin();
+
+	for (; iterParticles != m_particles->end(); ++iterParticles)
+	{
+		Particle const &particle = *(*iterParticles);
+
+		checksum = Crc::calculate(&particle.m_position, sizeof(particle.m_position), checksum);
+		checksum = Crc::calculate(&particle.m_velocity, sizeof(particle.m_velocity), checksum);
+		checksum = Crc::calculate(&particle.m_age, sizeof(particle.m_age), checksum);
+		checksum = Crc::calculate(&particle.m_lifeTime, sizeof(particle.m_lifeTime), checksum);
+	}
+
+	return checksum;
+}
+
 //-----------------------------------------------------------------------------
 void ParticleEmitter::calculateLod()
 {
@@ -2803,7 +3276,7 @@ void ParticleEmitter::calculateLod()
 		float const extentRadius = m_extent_w.getSphere().getRadius();
 		float distance = distanceToEmitter;
 
-		if ((!m_particles->empty()) &&
+		if ((getParticleCount() > 0) &&
 		    (extentRadius > 0.0f))
 		{
 			// Verify the extent box not inverted
@@ -2917,6 +3390,19 @@ void ParticleEmitter::drawDebugVelocity() const
 
 		Graphics::drawLine(a, b, VectorArgb::solidWhite);
 	}
+
+	int const pooledParticleCount = (m_quadPool != NULL) ? m_quadPool->getCount() : 0;
+
+	for (int particleIndex = 0; particleIndex < pooledParticleCount; ++particleIndex)
+	{
+		Vector velocity(m_quadPool->getVelocity(particleIndex));
+		velocity.approximateNormalize();
+
+		Vector a(m_quadPool->getPosition(particleIndex));
+		Vector b(a + velocity);
+
+		Graphics::drawLine(a, b, VectorArgb::solidWhite);
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -2955,6 +3441,16 @@ void ParticleEmitter::drawDebugParticleOrientation() const
 			
 			Graphics::drawLine(c, d, VectorArgb::solidRed);
 		}
+
+		int const pooledParticleCount = (m_quadPool != NULL) ? m_quadPool->getCount() : 0;
+
+		for (int particleIndex = 0; particleIndex < pooledParticleCount; ++particleIndex)
+		{
+			Vector const position(m_quadPool->getPosition(particleIndex));
+
+			Graphics::drawLine(position, position + m_quadPool->getUpVector(particleIndex), VectorArgb::solidGreen);
+			Graphics::drawLine(position, position + m_quadPool->getSideVector(particleIndex), VectorArgb::solidRed);
+		}
 	}
 }
 
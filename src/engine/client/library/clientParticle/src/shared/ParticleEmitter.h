@@ -24,6 +24,8 @@ class ParticleDescriptionMesh;
 class ParticleDescriptionQuad;
 class ParticleEmitterDescription;
 class ParticleQuad;
+class ParticleQuadCurves;
+class ParticleQuadPool;
 class TextAppearance;
 class Vector;
 
@@ -53,6 +55,10 @@ public:
 
 	virtual void             addToCameraScene(Camera const *camera, Object const *object) const;
 	virtual void             alter(float const deltaTime);
+	bool                     prepareSimulation(float const deltaTime);
+	void                     simulate();
+	void                     commitSimulation();
+	bool                     canSimulateInParallel() const;
 	virtual bool             isDeletable() const;
 	virtual void             restart();
 	virtual void             setOwner(Object *newOwner);
@@ -65,6 +71,7 @@ public:
 	int                      getParticleCountIncludingAttachments() const;
 	Particle const &         getParticle(int const particleIndex) const;
 	int                      getCurrentLoopCount();
+	uint32                   calculateParticleChecksum(uint32 checksum) const;
 
 	// Get the number of alive emitters
 
@@ -82,6 +89,7 @@ private:
 
 	ParticleEmitterDescription const &m_particleEmitterDescription;
 	Particles * const m_particles;                  // Indexes of the particles into the global particle list
+	ParticleQuadPool * const          m_quadPool;                   // Quad particles kept as arrays instead of in m_particles, NULL if unused
 	ParticleAttachments *             m_particleAttachments;
 	float                             m_lifeTime;
 	float                             m_age;
@@ -120,6 +128,12 @@ private:
 	mutable Vector                    m_currentCameraPosition_w;
 	Vector                            m_averageParticlePosition;
 	Vector                            m_averageParticleVelocity;
+	float                             m_simulationDeltaTime;
+	uint32                            m_simulationSeed;             // Seeds the random numbers drawn by simulate()
+	int                               m_pooledParticleBudget;       // Pooled quads simulate() may still create
+	int                               m_pooledParticleReservation;  // Room reserved from ParticleQuad until commitSimulation()
+	bool                              m_createParticlesThisFrame;
+	bool                              m_loopThisFrame;
 
 #ifdef _DEBUG
 	Object * m_debugTextObject;
@@ -133,15 +147,18 @@ private:
 
 private:
 
-	void  calculateRenderOrientationVectors(ParticleDescriptionQuad const *particleDescriptionQuad, ParticleQuad &particle, Vector &upVector, Vector &sideVector, Transform const &transform) const;
+	void  calculateRenderOrientationVectors(Vector const &position, Vector const &positionPrevious, Vector const &particleUpVector, Vector const &particleSideVector, float const currentRotation, Vector &upVector, Vector &sideVector, Transform const &transform) const;
+	ParticleQuadPool *createQuadPool() const;
 	void  createSingleParticle(float const deltaTime);
 	void  createSingleParticleMesh(ParticleDescriptionMesh const *particleDescriptionMesh, float const deltaTime);
 	void  createSingleParticleQuad(ParticleDescriptionQuad const *particleDescriptionQuad, float const deltaTime);
 	void  createNewParticles(float const deltaTime);
 	void  draw() const;
 	void  drawParticlesQuad(ParticleDescriptionQuad const *particleDescriptionQuad) const;
+	void  drawPooledParticlesQuad(ParticleDescriptionQuad const *particleDescriptionQuad) const;
 	float getAgePercent() const;
 	void  initializeSingleParticle(Particle &particle);
+	void  initializeSingleParticleQuad(ParticleDescriptionQuad const *particleDescriptionQuad, ParticleQuad &particleQuad);
 	void  loop();
 	void  removeAllParticles();
 	void  removeAllAttachments();
@@ -149,6 +166,7 @@ private:
 	void  removeOldAttachments();
 	void  updateExistingParticles(float const deltaTime);
 	void  updateSingleParticle(Particle *particle, float const deltaTime);
+	void  updatePooledParticles(ParticleQuadCurves const &curves, int const first, int const end, float const deltaTime);
 	void  frameFirst();
 	void  frameLast();
 	void  calculateLod();
@@ -14,6 +14,7 @@
 #include "clientParticle/ParticleEmitter.h"
 #include "clientParticle/ParticleEmitterDescription.h"
 #include "clientParticle/ParticleEmitterGroupDescription.h"
+#include "clientParticle/ParticleManager.h"
 #include "sharedDebug/Profiler.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/MemoryBlockManager.h"
@@ -170,9 +171,49 @@ void ParticleEmitterGroup::addToCameraScene(Camera const *camera, Object const *
 
 //-----------------------------------------------------------------------------
 void ParticleEmitterGroup::alter(float const deltaTime)
+{
+	ParticleEmitterList * const particleEmitterList = newParticleEmitterList();
+
+	prepareSimulation(deltaTime, *particleEmitterList);
+	ParticleManager::simulate(*particleEmitterList);
+	commitSimulation();
+
+	particleEmitterList->clear();
+	deleteParticleEmitterList(particleEmitterList);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Advances the group and prepares its emitters once the start delay is over,
+ * adding the ones that have something to simulate to particleEmitterList.
+ * The list must go through ParticleManager::simulate() before
+ * commitSimulation() is called.
+ */
+
+void ParticleEmitterGroup::prepareSimulation(float const deltaTime, ParticleManager::ParticleEmitterList &particleEmitterList)
 {
 	m_currentTime += deltaTime;
 
+	if (m_currentTime > m_startDelay)
+	{
+		ParticleEmitterList::iterator iterParticleEmitterList = m_particleEmitterList->begin();
+
+		for (; iterParticleEmitterList != m_particleEmitterList->end(); ++iterParticleEmitterList)
+		{
+			ParticleEmitter *particleEmitter = (*iterParticleEmitterList);
+			NOT_NULL(particleEmitter);
+
+			if (particleEmitter->prepareSimulation(deltaTime))
+			{
+				particleEmitterList.push_back(particleEmitter);
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void ParticleEmitterGroup::commitSimulation()
+{
 	BoxExtent newBoxExtent;
 	bool addedSomeParticles = false;
 
@@ -187,8 +228,6 @@ void ParticleEmitterGroup::alter(float const deltaTime)
 			ParticleEmitter *particleEmitter = (*iterParticleEmitterList);
 			NOT_NULL(particleEmitter);
 
-			particleEmitter->alter(deltaTime);
-			
 			if (particleEmitter->hasAliveParticles())
 			{
 				newBoxExtent.grow(particleEmitter->getExtent());
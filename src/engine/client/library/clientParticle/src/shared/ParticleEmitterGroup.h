@@ -9,6 +9,7 @@
 #define INCLUDED_ParticleEmitterGroup_H
 
 #include "clientParticle/ParticleGenerator.h"
+#include "clientParticle/ParticleManager.h"
 #include "../../../../../../engine/shared/library/sharedFoundation/include/public/sharedFoundation/MemoryBlockManagerMacros.h"
 #include "../../../../../../engine/shared/library/sharedFoundation/include/public/sharedFoundation/Watcher.h"
 #include "sharedObject/MemoryBlockManagedObject.h"
@@ -34,6 +35,8 @@ public:
 
 	virtual void addToCameraScene(Camera const *camera, Object const *object) const;
 	virtual void alter(float const deltaTime);
+	void prepareSimulation(float const deltaTime, ParticleManager::ParticleEmitterList &particleEmitterList);
+	void commitSimulation();
 	virtual void restart();
 	virtual bool isDeletable() const;
 	virtual void setOwner(Object *newOwner);
@@ -8,17 +8,23 @@
 #include "clientParticle/FirstClientParticle.h"
 #include "clientParticle/ParticleManager.h"
 
+#include "clientGraphics/Graphics.h"
+#include "clientParticle/ConfigClientParticle.h"
 #include "clientParticle/ParticleEffectAppearance.h"
 #include "clientParticle/ParticleEmitter.h"
 #include "clientParticle/ParticleEmitterGroup.h"
 #include "clientParticle/ParticleMesh.h"
 #include "clientParticle/ParticleQuad.h"
 #include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedDebug/Profiler.h"
 #include "sharedFoundation/ConfigFile.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/CrcLowerString.h"
 #include "sharedObject/AppearanceTemplate.h"
+#include "sharedThread/WorkerPool.h"
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <vector>
@@ -49,6 +55,45 @@ namespace ParticleManagerNamespace
 	ParticleEffectAppearanceList s_particleEffectAppearanceList;
 #endif // _DEBUG
 
+	// Emitter simulation
+
+	struct SimulationStatistics
+	{
+		int   numberOfEmitters;
+		int   numberOfParallelEmitters;
+		int   numberOfParticles;
+		int   numberOfJobs;
+		int   numberOfPhases;
+		float phaseTime;
+	};
+
+	struct SimulationBatch
+	{
+		ParticleEmitter * const *particleEmitters;
+		int                      numberOfParticleEmitters;
+		int                      numberOfJobs;
+	};
+
+	// Each worker gets a few jobs so uneven emitters balance out, and batches
+	// smaller than a few emitters are not worth waking the workers for
+
+	int const cs_jobsPerThread = 4;
+	int const cs_minimumParallelEmitters = 4;
+
+	WorkerPool *                    s_simulationWorkerPool = NULL;
+	bool                            s_disableSimulationPhase = false;
+	bool                            s_disableSimulationThreads = false;
+	bool                            s_reportSimulation = false;
+	std::vector<ParticleEmitter *>  s_parallelParticleEmitters;
+
+	int                  s_simulationStatisticsFrameNumber = -1;
+	SimulationStatistics s_simulationStatistics;
+	SimulationStatistics s_lastFrameSimulationStatistics;
+
+	SimulationStatistics &getSimulationStatistics();
+	void runSimulationJob(void *context, int jobIndex);
+	void reportSimulation();
+
 	void remove();
 };
 
@@ -65,6 +110,64 @@ void ParticleManagerNamespace::remove()
 	DebugFlags::unregisterFlag(s_debugVelocityEnabled);
 	DebugFlags::unregisterFlag(s_debugWorldTextEnabled);
 	DebugFlags::unregisterFlag(s_debugOriginIconEnabled);
+	DebugFlags::unregisterFlag(s_disableSimulationPhase);
+	DebugFlags::unregisterFlag(s_disableSimulationThreads);
+	DebugFlags::unregisterFlag(s_reportSimulation);
+
+	delete s_simulationWorkerPool;
+	s_simulationWorkerPool = NULL;
+
+	std::vector<ParticleEmitter *>().swap(s_parallelParticleEmitters);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Statistics are kept per graphics frame, the previous frame is what gets
+ * reported.
+ */
+
+ParticleManagerNamespace::SimulationStatistics &ParticleManagerNamespace::getSimulationStatistics()
+{
+	int const frameNumber = Graphics::getFrameNumber();
+
+	if (frameNumber != s_simulationStatisticsFrameNumber)
+	{
+		s_simulationStatisticsFrameNumber = frameNumber;
+		s_lastFrameSimulationStatistics = s_simulationStatistics;
+		memset(&s_simulationStatistics, 0, sizeof(s_simulationStatistics));
+	}
+
+	return s_simulationStatistics;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleManagerNamespace::runSimulationJob(void * const context, int const jobIndex)
+{
+	NOT_NULL(context);
+
+	SimulationBatch const &batch = *static_cast<SimulationBatch const *>(context);
+
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, jobIndex, batch.numberOfJobs);
+
+	int const first = (batch.numberOfParticleEmitters * jobIndex) / batch.numberOfJobs;
+	int const end = (batch.numberOfParticleEmitters * (jobIndex + 1)) / batch.numberOfJobs;
+
+	for (int i = first; i < end; ++i)
+	{
+		batch.particleEmitters[i]->simulate();
+	}
+}
+
+//-----------------------------------------------------------------------------
+void ParticleManagerNamespace::reportSimulation()
+{
+	IGNORE_RETURN(getSimulationStatistics());
+	SimulationStatistics const &statistics = s_lastFrameSimulationStatistics;
+
+	DEBUG_REPORT_PRINT(true, ("-- ParticleManager simulation\n"));
+	DEBUG_REPORT_PRINT(true, ("  simulated emitters = %d with %d particles\n", statistics.numberOfEmitters, statistics.numberOfParticles));
+	DEBUG_REPORT_PRINT(true, ("  simulation phase   = %d emitters in %d jobs, %d phases, %1.3f ms wall\n", statistics.numberOfParallelEmitters, statistics.numberOfJobs, statistics.numberOfPhases, statistics.phaseTime * 1000.0f));
+	DEBUG_REPORT_PRINT(true, ("  worker threads     = %d%s\n", s_simulationWorkerPool ? s_simulationWorkerPool->getNumberOfThreads() : 0, (s_disableSimulationPhase || s_disableSimulationThreads) ? " (disabled)" : ""));
 }
 
 // ============================================================================
@@ -86,12 +189,168 @@ void ParticleManager::install()
 	DebugFlags::registerFlag(s_debugVelocityEnabled, "ClientParticle", "debugVelocityEnabled");
 	DebugFlags::registerFlag(s_debugWorldTextEnabled, "ClientParticle", "debugWorldTextEnabled");
 	DebugFlags::registerFlag(s_debugOriginIconEnabled, "ClientParticle", "debugOriginIconEnabled");
+	DebugFlags::registerFlag(s_disableSimulationPhase, "ClientParticle", "disableSimulationPhase");
+	DebugFlags::registerFlag(s_disableSimulationThreads, "ClientParticle", "disableSimulationThreads");
+	DebugFlags::registerFlag(s_reportSimulation, "ClientParticle", "reportSimulation", reportSimulation);
+
+	// A thread count of zero simulates every emitter on the main thread
+
+	int const simulationThreadCount = ConfigClientParticle::getSimulationThreadCount();
+
+	if (simulationThreadCount > 0)
+	{
+		s_simulationWorkerPool = new WorkerPool("ParticleSimulation", simulationThreadCount);
+	}
 
 	ExitChain::add(&remove, "ParticleManagerNamespace::remove");
 
 	s_installed = true;
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Simulates a batch of emitters that have all been prepared with
+ * ParticleEmitter::prepareSimulation().
+ *
+ * Emitters that can simulate in parallel are spread over the worker threads
+ * first.  The batch is then committed on the main thread in its original
+ * order, and the remaining emitters simulate there right before their
+ * commit, which is where their terrain queries and attachment objects
+ * happen.  Every emitter draws its random numbers from its own seed, so the
+ * particles are the same whether or not the phase and its threads are
+ * enabled.
+ */
+
+void ParticleManager::simulate(ParticleEmitterList const &particleEmitterList)
+{
+	NP_PROFILER_AUTO_BLOCK_DEFINE("ParticleManager::simulate");
+
+	bool const phaseEnabled = !s_disableSimulationPhase;
+
+	PerformanceTimer timer;
+	timer.start();
+
+	// Committing an emitter can create attachments that alter their own
+	// effects, so this list is only used until the phase has finished
+
+	s_parallelParticleEmitters.clear();
+
+	if (phaseEnabled)
+	{
+		ParticleEmitterList::const_iterator iterParticleEmitterList = particleEmitterList.begin();
+
+		for (; iterParticleEmitterList != particleEmitterList.end(); ++iterParticleEmitterList)
+		{
+			ParticleEmitter * const particleEmitter = NON_NULL(*iterParticleEmitterList);
+
+			if (particleEmitter->canSimulateInParallel())
+			{
+				s_parallelParticleEmitters.push_back(particleEmitter);
+			}
+		}
+	}
+
+	int const numberOfParallelEmitters = static_cast<int>(s_parallelParticleEmitters.size());
+	int numberOfJobs = 0;
+
+	if (   (s_simulationWorkerPool != NULL)
+	    && !s_disableSimulationThreads
+	    && (numberOfParallelEmitters >= cs_minimumParallelEmitters))
+	{
+		numberOfJobs = std::min(numberOfParallelEmitters, (s_simulationWorkerPool->getNumberOfThreads() + 1) * cs_jobsPerThread);
+
+		SimulationBatch batch;
+		batch.particleEmitters = &s_parallelParticleEmitters[0];
+		batch.numberOfParticleEmitters = numberOfParallelEmitters;
+		batch.numberOfJobs = numberOfJobs;
+
+		s_simulationWorkerPool->run(runSimulationJob, &batch, numberOfJobs);
+	}
+	else
+	{
+		for (int i = 0; i < numberOfParallelEmitters; ++i)
+		{
+			s_parallelParticleEmitters[static_cast<size_t>(i)]->simulate();
+		}
+	}
+
+	timer.stop();
+
+	// Commit
+
+	int numberOfParticles = 0;
+
+	ParticleEmitterList::const_iterator iterParticleEmitterList = particleEmitterList.begin();
+
+	for (; iterParticleEmitterList != particleEmitterList.end(); ++iterParticleEmitterList)
+	{
+		ParticleEmitter * const particleEmitter = NON_NULL(*iterParticleEmitterList);
+
+		if (!phaseEnabled || !particleEmitter->canSimulateInParallel())
+		{
+			particleEmitter->simulate();
+		}
+
+		particleEmitter->commitSimulation();
+
+		numberOfParticles += particleEmitter->getParticleCount();
+	}
+
+	SimulationStatistics &statistics = getSimulationStatistics();
+	statistics.numberOfEmitters += static_cast<int>(particleEmitterList.size());
+	statistics.numberOfParallelEmitters += numberOfParallelEmitters;
+	statistics.numberOfParticles += numberOfParticles;
+	statistics.numberOfJobs += numberOfJobs;
+	++statistics.numberOfPhases;
+	statistics.phaseTime += timer.getElapsedTime();
+}
+
+//-----------------------------------------------------------------------------
+int ParticleManager::getNumberOfSimulatedEmittersLastFrame()
+{
+	// Roll the statistics over if a new frame has started
+
+	IGNORE_RETURN(getSimulationStatistics());
+
+	return s_lastFrameSimulationStatistics.numberOfEmitters;
+}
+
+//-----------------------------------------------------------------------------
+int ParticleManager::getNumberOfParallelEmittersLastFrame()
+{
+	IGNORE_RETURN(getSimulationStatistics());
+
+	return s_lastFrameSimulationStatistics.numberOfParallelEmitters;
+}
+
+//-----------------------------------------------------------------------------
+int ParticleManager::getNumberOfSimulatedParticlesLastFrame()
+{
+	IGNORE_RETURN(getSimulationStatistics());
+
+	return s_lastFrameSimulationStatistics.numberOfParticles;
+}
+
+//-----------------------------------------------------------------------------
+float ParticleManager::getSimulationPhaseTimeLastFrame()
+{
+	IGNORE_RETURN(getSimulationStatistics());
+
+	return s_lastFrameSimulationStatistics.phaseTime;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleManager::setSimulationThreadsEnabled(bool const simulationThreadsEnabled)
+{
+	s_disableSimulationThreads = !simulationThreadsEnabled;
+}
+
+//-----------------------------------------------------------------------------
+bool ParticleManager::isSimulationThreadsEnabled()
+{
+	return !s_disableSimulationThreads;
+}
+
 //-----------------------------------------------------------------------------
 void ParticleManager::setParticlesEnabled(bool const particlesEnabled)
 {
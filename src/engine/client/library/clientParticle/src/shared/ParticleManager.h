@@ -9,14 +9,27 @@
 #define INCLUDED_ParticleManager_H
 
 class ParticleEffectAppearance;
+class ParticleEmitter;
 
 //-----------------------------------------------------------------------------
 class ParticleManager
 {
 public:
 
+	typedef stdvector<ParticleEmitter *>::fwd ParticleEmitterList;
+
 	static void install();
 
+	static void  simulate(ParticleEmitterList const &particleEmitterList);
+
+	static int   getNumberOfSimulatedEmittersLastFrame();
+	static int   getNumberOfParallelEmittersLastFrame();
+	static int   getNumberOfSimulatedParticlesLastFrame();
+	static float getSimulationPhaseTimeLastFrame();
+
+	static void setSimulationThreadsEnabled(bool const simulationThreadsEnabled);
+	static bool isSimulationThreadsEnabled();
+
 #ifdef _DEBUG
 	static void debugRegister(ParticleEffectAppearance const & particleEffectAppearance);
 	static void debugUnRegister(ParticleEffectAppearance const & particleEffectAppearance);
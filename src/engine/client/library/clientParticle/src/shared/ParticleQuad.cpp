@@ -13,6 +13,8 @@
 #include "sharedFoundation/MemoryBlockManager.h"
 #include "sharedFoundation/ExitChain.h"
 
+#include <algorithm>
+
 // ============================================================================
 //
 // ParticleQuad
@@ -26,6 +28,15 @@ namespace ParticleQuadNamespace
 	float const s_reservePriorityFactor = 2.0f;
 	int s_normalParticleMax = 0;
 	int s_priorityParticleMax = 0;
+
+	// Quads living in ParticleQuadPools rather than the memory block manager
+
+	int s_pooledParticleCount = 0;
+
+	// Room emitters took in prepareSimulation() for quads they may add to
+	// their pools before the pools are counted again
+
+	int s_reservedParticleCount = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -89,18 +100,65 @@ void ParticleQuad::operator delete(void *pointer)
 //-----------------------------------------------------------------------------
 bool ParticleQuad::isParticlePoolFull(bool priority)
 {
-	if(m_memoryBlockManager->isFull())
-		return true;
-	if(!priority)
-		return (getGlobalCount() >= ParticleEffectAppearance::getGlobalUserLimit() || getGlobalCount() >= ParticleQuadNamespace::s_normalParticleMax);
-	else
-		return (getGlobalCount() >= ParticleQuadNamespace::s_priorityParticleMax);	
+	return (getAvailableCount(priority) <= 0);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * The number of quads that can still be created before the pool is full.
+ */
+
+int ParticleQuad::getAvailableCount(bool const priority)
+{
+	if (m_memoryBlockManager->isFull())
+	{
+		return 0;
+	}
+
+	int const limit = priority ? ParticleQuadNamespace::s_priorityParticleMax : std::min(ParticleEffectAppearance::getGlobalUserLimit(), ParticleQuadNamespace::s_normalParticleMax);
+
+	return std::max(0, limit - getGlobalCount() - ParticleQuadNamespace::s_reservedParticleCount);
 }
 
 //-----------------------------------------------------------------------------
 int ParticleQuad::getGlobalCount()
 {
-	return m_memoryBlockManager->getElementCount();
+	return m_memoryBlockManager->getElementCount() + ParticleQuadNamespace::s_pooledParticleCount;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleQuad::adjustPooledCount(int const delta)
+{
+	ParticleQuadNamespace::s_pooledParticleCount += delta;
+
+	DEBUG_FATAL((ParticleQuadNamespace::s_pooledParticleCount < 0), ("ParticleQuad::adjustPooledCount() - Pooled count(%d) went negative", ParticleQuadNamespace::s_pooledParticleCount));
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Takes up to count quads of the available room so they can be added to a
+ * pool off the main thread.  The room stays taken until it is given back
+ * with releaseReservedParticles(), which the owner should do after the pool
+ * has been counted with updateGlobalCount().
+ *
+ * @return The number of quads reserved.
+ */
+
+int ParticleQuad::reserveParticles(bool const priority, int const count)
+{
+	int const reserved = std::min(std::max(0, count), getAvailableCount(priority));
+
+	ParticleQuadNamespace::s_reservedParticleCount += reserved;
+
+	return reserved;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleQuad::releaseReservedParticles(int const count)
+{
+	ParticleQuadNamespace::s_reservedParticleCount -= count;
+
+	DEBUG_FATAL((ParticleQuadNamespace::s_reservedParticleCount < 0), ("ParticleQuad::releaseReservedParticles() - Reserved count(%d) went negative", ParticleQuadNamespace::s_reservedParticleCount));
 }
 
 // ============================================================================
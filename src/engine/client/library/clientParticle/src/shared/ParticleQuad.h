@@ -17,6 +17,7 @@ class MemoryBlockManager;
 class ParticleQuad : public Particle
 {
 friend class ParticleEmitter;
+friend class ParticleQuadPool;
 
 public:
 
@@ -29,7 +30,11 @@ public:
 	static void remove();
 
 	static bool isParticlePoolFull(bool priority);
+	static int  getAvailableCount(bool priority);
 	static int  getGlobalCount();
+	static void adjustPooledCount(int delta);
+	static int  reserveParticles(bool priority, int count);
+	static void releaseReservedParticles(int count);
 
 protected:
 
@@ -0,0 +1,1271 @@
+// ============================================================================
+//
+// ParticleQuadPool.cpp
+// copyright 2026
+//
+// ============================================================================
+
+#include "clientParticle/FirstClientParticle.h"
+#include "clientParticle/ParticleQuadPool.h"
+
+#include "clientParticle/ColorRamp.h"
+#include "clientParticle/ParticleDescriptionQuad.h"
+#include "clientParticle/ParticleQuad.h"
+#include "sharedDebug/DebugFlags.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedMath/WaveForm.h"
+
+#include <algorithm>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// The SIMD kernels use SSE2 intrinsics on x86 and x64.  They are compiled
+// for SSE2 on their own and selected at runtime, so the rest of the library
+// does not require it.
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define PARTICLE_USE_SIMD 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PARTICLE_TARGET_SSE2
+#else
+#define PARTICLE_TARGET_SSE2 __attribute__((target("sse2")))
+#endif
+#else
+#define PARTICLE_USE_SIMD 0
+#endif
+
+// ============================================================================
+//
+// ParticleQuadPoolNamespace
+//
+// ============================================================================
+
+namespace ParticleQuadPoolNamespace
+{
+	// Components that belong to a particle, the rest are scratch space for the current frame
+
+	int const cs_persistentComponentCount = ParticleQuadPool::C_particleRelativeRotationZPercent + 1;
+
+	// Below this many particles a comparison sort beats the radix passes
+
+	int const cs_radixSortThreshold = 64;
+
+	void   remove();
+	bool   detectSimd();
+
+	float  getStepFraction(float percent, int &step);
+	uint32 makeDepthSortKey(float depth);
+	void   radixSortByDepth(uint64 *keys, uint64 *scratch, int count);
+
+	bool s_installed;
+	bool s_simdAvailable;
+	bool s_disableSimd;
+	bool s_disabled;
+}
+
+using namespace ParticleQuadPoolNamespace;
+
+//-----------------------------------------------------------------------------
+void ParticleQuadPoolNamespace::remove()
+{
+	DEBUG_FATAL(!s_installed, ("ParticleQuadPool::remove() - ParticleQuadPool is not installed"));
+	s_installed = false;
+
+	DebugFlags::unregisterFlag(s_disabled);
+	DebugFlags::unregisterFlag(s_disableSimd);
+}
+
+//-----------------------------------------------------------------------------
+bool ParticleQuadPoolNamespace::detectSimd()
+{
+#if PARTICLE_USE_SIMD
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 1)
+		return false;
+
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse2") != 0;
+#endif
+#else
+	return false;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Splits a [0..1] percent into a curve step and the fraction of the way
+ * through it.  The SIMD samplers do the same arithmetic four lanes at a time.
+ */
+
+inline float ParticleQuadPoolNamespace::getStepFraction(float const percent, int &step)
+{
+	float const scaled = clamp(0.0f, percent, 1.0f) * static_cast<float>(ParticleCurve::cs_stepCount);
+
+	step = static_cast<int>(std::min(scaled, static_cast<float>(ParticleCurve::cs_stepCount - 1)));
+
+	return scaled - static_cast<float>(step);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Maps a camera space depth to a key that sorts far to near as an unsigned
+ * integer.  Negative zero is folded onto zero.
+ */
+
+inline uint32 ParticleQuadPoolNamespace::makeDepthSortKey(float const depth)
+{
+	union
+	{
+		float  f;
+		uint32 u;
+	} bits;
+
+	bits.f = depth + 0.0f;
+
+	uint32 const ordered = (bits.u & 0x80000000u) ? ~bits.u : (bits.u | 0x80000000u);
+
+	return ~ordered;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Sorts keys holding a depth key in the high 32 bits and a particle index in
+ * the low 32 bits.  The passes are stable and the keys start in index order,
+ * so equal depths keep their index order, the same as a full 64 bit sort.
+ */
+
+void ParticleQuadPoolNamespace::radixSortByDepth(uint64 *keys, uint64 *scratch, int const count)
+{
+	if (count < cs_radixSortThreshold)
+	{
+		std::sort(keys, keys + count);
+		return;
+	}
+
+	int const digitCount = 4;
+	int histograms[digitCount][256];
+	memset(histograms, 0, sizeof(histograms));
+
+	for (int i = 0; i < count; ++i)
+	{
+		uint32 const depthKey = static_cast<uint32>(keys[i] >> 32);
+
+		++histograms[0][depthKey & 0xff];
+		++histograms[1][(depthKey >> 8) & 0xff];
+		++histograms[2][(depthKey >> 16) & 0xff];
+		++histograms[3][depthKey >> 24];
+	}
+
+	uint64 *source = keys;
+	uint64 *destination = scratch;
+
+	for (int digit = 0; digit < digitCount; ++digit)
+	{
+		int *const histogram = histograms[digit];
+		int const shift = 32 + digit * 8;
+
+		// Skip digits every key shares, which is common for the high bits of nearby depths
+
+		if (histogram[(source[0] >> shift) & 0xff] == count)
+			continue;
+
+		int offset = 0;
+
+		for (int bucket = 0; bucket < 256; ++bucket)
+		{
+			int const bucketCount = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += bucketCount;
+		}
+
+		for (int i = 0; i < count; ++i)
+			destination[histogram[(source[i] >> shift) & 0xff]++] = source[i];
+
+		std::swap(source, destination);
+	}
+
+	if (source != keys)
+		memcpy(keys, source, sizeof(uint64) * static_cast<size_t>(count));
+}
+
+// ============================================================================
+//
+// ParticleCurve
+//
+// ============================================================================
+
+//-----------------------------------------------------------------------------
+/**
+ * Continuous waveforms pick a new random value every time they are sampled,
+ * so they can only be resampled when they have no random range.
+ */
+
+bool ParticleCurve::canSample(WaveForm const &waveForm)
+{
+	if (waveForm.getControlPointCount() < 2)
+	{
+		return false;
+	}
+
+	if (waveForm.getSampleType() == WaveForm::ST_continuous)
+	{
+		WaveForm::ControlPointList::const_iterator iterControlPoint = waveForm.getIteratorBegin();
+
+		for (; iterControlPoint != waveForm.getIteratorEnd(); ++iterControlPoint)
+		{
+			if ((iterControlPoint->getRandomMin() != 0.0f) ||
+			    (iterControlPoint->getRandomMax() != 0.0f))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+ParticleCurve::ParticleCurve()
+ : m_steps(NULL)
+ , m_constantValue(0.0f)
+ , m_valueMin(0.0f)
+ , m_valueMax(0.0f)
+{
+}
+
+//-----------------------------------------------------------------------------
+ParticleCurve::~ParticleCurve()
+{
+	delete [] m_steps;
+	m_steps = NULL;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleCurve::bake(WaveForm const &waveForm)
+{
+	DEBUG_FATAL(!canSample(waveForm), ("ParticleCurve::bake() - The waveform can not be resampled"));
+
+	delete [] m_steps;
+	m_steps = NULL;
+
+	m_valueMin = waveForm.getValueMin();
+	m_valueMax = waveForm.getValueMax();
+
+	// Sample the waveform as a particle with the lowest and the highest initial percent
+
+	WaveFormControlPointIter lowerIter;
+	lowerIter.m_iter = waveForm.getIteratorBegin();
+	lowerIter.m_initialPercent = 0.0f;
+
+	WaveFormControlPointIter upperIter;
+	upperIter.m_iter = waveForm.getIteratorBegin();
+	upperIter.m_initialPercent = 1.0f;
+
+	float lower[cs_stepCount + 1];
+	float upper[cs_stepCount + 1];
+	bool constant = true;
+
+	for (int i = 0; i <= cs_stepCount; ++i)
+	{
+		float const percent = static_cast<float>(i) / static_cast<float>(cs_stepCount);
+
+		lower[i] = waveForm.getValue(lowerIter, percent);
+		upper[i] = waveForm.getValue(upperIter, percent);
+
+		constant = constant && (lower[i] == lower[0]) && (upper[i] == lower[0]);
+	}
+
+	m_constantValue = lower[0];
+
+	if (!constant)
+	{
+		m_steps = new float[cs_stepCount * 4];
+
+		for (int i = 0; i < cs_stepCount; ++i)
+		{
+			float *const step = m_steps + i * 4;
+
+			step[0] = lower[i];
+			step[1] = lower[i + 1] - lower[i];
+			step[2] = upper[i];
+			step[3] = upper[i + 1] - upper[i];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool ParticleCurve::isConstant() const
+{
+	return (m_steps == NULL);
+}
+
+//-----------------------------------------------------------------------------
+float ParticleCurve::sample(float const percent, float const initialPercent) const
+{
+	if (m_steps == NULL)
+	{
+		return m_constantValue;
+	}
+
+	int step = 0;
+	float const fraction = getStepFraction(percent, step);
+	float const *const values = m_steps + step * 4;
+
+	float const lower = values[0] + values[1] * fraction;
+	float const upper = values[2] + values[3] * fraction;
+
+	return clamp(m_valueMin, lower + (upper - lower) * initialPercent, m_valueMax);
+}
+
+//-----------------------------------------------------------------------------
+void ParticleCurve::sample(float const *percents, float const *initialPercents, int const first, int const end, float *results) const
+{
+	if (m_steps == NULL)
+	{
+		std::fill(results + first, results + end, m_constantValue);
+	}
+	else if (ParticleQuadPool::getUseSimd())
+	{
+		sampleSimd(percents, initialPercents, first, end, results);
+	}
+	else
+	{
+		sampleScalar(percents, initialPercents, first, end, results);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void ParticleCurve::sampleScalar(float const *percents, float const *initialPercents, int const first, int const end, float *results) const
+{
+	for (int i = first; i < end; ++i)
+	{
+		results[i] = sample(percents[i], initialPercents[i]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+#if PARTICLE_USE_SIMD
+
+PARTICLE_TARGET_SSE2 void ParticleCurve::sampleSimd(float const *percents, float const *initialPercents, int const first, int const end, float *results) const
+{
+	__m128 const zero = _mm_setzero_ps();
+	__m128 const one = _mm_set1_ps(1.0f);
+	__m128 const stepCount = _mm_set1_ps(static_cast<float>(cs_stepCount));
+	__m128 const lastStep = _mm_set1_ps(static_cast<float>(cs_stepCount - 1));
+	__m128 const valueMin = _mm_set1_ps(m_valueMin);
+	__m128 const valueMax = _mm_set1_ps(m_valueMax);
+
+	int i = first;
+
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 const scaled = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(percents + i), zero), one), stepCount);
+		__m128i const step = _mm_cvttps_epi32(_mm_min_ps(scaled, lastStep));
+		__m128 const fraction = _mm_sub_ps(scaled, _mm_cvtepi32_ps(step));
+
+		int steps[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(steps), step);
+
+		// Gather the four steps and transpose them into lower, lower slope, upper and upper slope
+
+		__m128 lower = _mm_loadu_ps(m_steps + steps[0] * 4);
+		__m128 lowerSlope = _mm_loadu_ps(m_steps + steps[1] * 4);
+		__m128 upper = _mm_loadu_ps(m_steps + steps[2] * 4);
+		__m128 upperSlope = _mm_loadu_ps(m_steps + steps[3] * 4);
+		_MM_TRANSPOSE4_PS(lower, lowerSlope, upper, upperSlope);
+
+		lower = _mm_add_ps(lower, _mm_mul_ps(lowerSlope, fraction));
+		upper = _mm_add_ps(upper, _mm_mul_ps(upperSlope, fraction));
+
+		__m128 const value = _mm_add_ps(lower, _mm_mul_ps(_mm_sub_ps(upper, lower), _mm_loadu_ps(initialPercents + i)));
+
+		_mm_storeu_ps(results + i, _mm_min_ps(_mm_max_ps(value, valueMin), valueMax));
+	}
+
+	sampleScalar(percents, initialPercents, i, end, results);
+}
+
+#else
+
+void ParticleCurve::sampleSimd(float const *percents, float const *initialPercents, int const first, int const end, float *results) const
+{
+	sampleScalar(percents, initialPercents, first, end, results);
+}
+
+#endif
+
+// ============================================================================
+//
+// ParticleColorCurve
+//
+// ============================================================================
+
+//-----------------------------------------------------------------------------
+ParticleColorCurve::ParticleColorCurve()
+ : m_steps(NULL)
+{
+}
+
+//-----------------------------------------------------------------------------
+ParticleColorCurve::~ParticleColorCurve()
+{
+	delete [] m_steps;
+	m_steps = NULL;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleColorCurve::bake(ColorRamp const &colorRamp)
+{
+	int const stepCount = ParticleCurve::cs_stepCount;
+
+	float colors[(stepCount + 1) * 3];
+
+	for (int i = 0; i <= stepCount; ++i)
+	{
+		float const percent = static_cast<float>(i) / static_cast<float>(stepCount);
+
+		colorRamp.getColorAtPercent(percent, colors[i * 3], colors[i * 3 + 1], colors[i * 3 + 2]);
+	}
+
+	if (m_steps == NULL)
+	{
+		m_steps = new float[stepCount * 8];
+	}
+
+	for (int i = 0; i < stepCount; ++i)
+	{
+		float const *const color = colors + i * 3;
+		float *const step = m_steps + i * 8;
+
+		step[0] = color[0];
+		step[1] = color[1];
+		step[2] = color[2];
+		step[3] = 0.0f;
+		step[4] = color[3] - color[0];
+		step[5] = color[4] - color[1];
+		step[6] = color[5] - color[2];
+		step[7] = 0.0f;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void ParticleColorCurve::sample(float const percent, float &red, float &green, float &blue) const
+{
+	NOT_NULL(m_steps);
+
+	int step = 0;
+	float const fraction = getStepFraction(percent, step);
+	float const *const values = m_steps + step * 8;
+
+	red = values[0] + values[4] * fraction;
+	green = values[1] + values[5] * fraction;
+	blue = values[2] + values[6] * fraction;
+}
+
+//-----------------------------------------------------------------------------
+#if PARTICLE_USE_SIMD
+
+PARTICLE_TARGET_SSE2 void ParticleColorCurve::sample(float const *percents, int const first, int const end, float *reds, float *greens, float *blues) const
+{
+	NOT_NULL(m_steps);
+
+	int i = first;
+
+	if (ParticleQuadPool::getUseSimd())
+	{
+		__m128 const zero = _mm_setzero_ps();
+		__m128 const one = _mm_set1_ps(1.0f);
+		__m128 const stepCount = _mm_set1_ps(static_cast<float>(ParticleCurve::cs_stepCount));
+		__m128 const lastStep = _mm_set1_ps(static_cast<float>(ParticleCurve::cs_stepCount - 1));
+
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 const scaled = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(percents + i), zero), one), stepCount);
+			__m128i const step = _mm_cvttps_epi32(_mm_min_ps(scaled, lastStep));
+			__m128 const fraction = _mm_sub_ps(scaled, _mm_cvtepi32_ps(step));
+
+			int steps[4];
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(steps), step);
+
+			// Gather the colors and slopes of the four steps and transpose them into channels
+
+			__m128 red = _mm_loadu_ps(m_steps + steps[0] * 8);
+			__m128 green = _mm_loadu_ps(m_steps + steps[1] * 8);
+			__m128 blue = _mm_loadu_ps(m_steps + steps[2] * 8);
+			__m128 padding = _mm_loadu_ps(m_steps + steps[3] * 8);
+			_MM_TRANSPOSE4_PS(red, green, blue, padding);
+
+			__m128 redSlope = _mm_loadu_ps(m_steps + steps[0] * 8 + 4);
+			__m128 greenSlope = _mm_loadu_ps(m_steps + steps[1] * 8 + 4);
+			__m128 blueSlope = _mm_loadu_ps(m_steps + steps[2] * 8 + 4);
+			__m128 paddingSlope = _mm_loadu_ps(m_steps + steps[3] * 8 + 4);
+			_MM_TRANSPOSE4_PS(redSlope, greenSlope, blueSlope, paddingSlope);
+
+			_mm_storeu_ps(reds + i, _mm_add_ps(red, _mm_mul_ps(redSlope, fraction)));
+			_mm_storeu_ps(greens + i, _mm_add_ps(green, _mm_mul_ps(greenSlope, fraction)));
+			_mm_storeu_ps(blues + i, _mm_add_ps(blue, _mm_mul_ps(blueSlope, fraction)));
+		}
+	}
+
+	for (; i < end; ++i)
+	{
+		sample(percents[i], reds[i], greens[i], blues[i]);
+	}
+}
+
+#else
+
+void ParticleColorCurve::sample(float const *percents, int const first, int const end, float *reds, float *greens, float *blues) const
+{
+	for (int i = first; i < end; ++i)
+	{
+		sample(percents[i], reds[i], greens[i], blues[i]);
+	}
+}
+
+#endif
+
+// ============================================================================
+//
+// ParticleQuadCurves
+//
+// ============================================================================
+
+//-----------------------------------------------------------------------------
+bool ParticleQuadCurves::canSample(ParticleDescriptionQuad const &particleDescriptionQuad)
+{
+	return (particleDescriptionQuad.getColor().getControlPointCount() >= 2)
+	    && ParticleCurve::canSample(particleDescriptionQuad.getAlpha())
+	    && ParticleCurve::canSample(particleDescriptionQuad.getSpeedScale())
+	    && ParticleCurve::canSample(particleDescriptionQuad.getLength())
+	    && ParticleCurve::canSample(particleDescriptionQuad.getWidth())
+	    && ParticleCurve::canSample(particleDescriptionQuad.getRotation())
+	    && ParticleCurve::canSample(particleDescriptionQuad.getParticleRelativeRotationX())
+	    && ParticleCurve::canSample(particleDescriptionQuad.getParticleRelativeRotationY())
+	    && ParticleCurve::canSample(particleDescriptionQuad.getParticleRelativeRotationZ());
+}
+
+//-----------------------------------------------------------------------------
+ParticleQuadCurves::ParticleQuadCurves(ParticleDescriptionQuad const &particleDescriptionQuad)
+ : m_color()
+ , m_alpha()
+ , m_speedScale()
+ , m_length()
+ , m_width()
+ , m_rotation()
+ , m_particleRelativeRotationX()
+ , m_particleRelativeRotationY()
+ , m_particleRelativeRotationZ()
+{
+	m_color.bake(particleDescriptionQuad.getColor());
+	m_alpha.bake(particleDescriptionQuad.getAlpha());
+	m_speedScale.bake(particleDescriptionQuad.getSpeedScale());
+	m_length.bake(particleDescriptionQuad.getLength());
+	m_width.bake(particleDescriptionQuad.getWidth());
+	m_rotation.bake(particleDescriptionQuad.getRotation());
+	m_particleRelativeRotationX.bake(particleDescriptionQuad.getParticleRelativeRotationX());
+	m_particleRelativeRotationY.bake(particleDescriptionQuad.getParticleRelativeRotationY());
+	m_particleRelativeRotationZ.bake(particleDescriptionQuad.getParticleRelativeRotationZ());
+}
+
+// ============================================================================
+//
+// ParticleQuadPool::UpdateParameters
+//
+// ============================================================================
+
+//-----------------------------------------------------------------------------
+ParticleQuadPool::UpdateParameters::UpdateParameters()
+ : m_curves(NULL)
+ , m_wind(Vector::zero)
+ , m_effectScale(1.0f)
+ , m_lengthAndWidthLinked(false)
+ , m_orientWithVelocity(false)
+{
+}
+
+// ============================================================================
+//
+// ParticleQuadPool
+//
+// ============================================================================
+
+//-----------------------------------------------------------------------------
+void ParticleQuadPool::install()
+{
+	DEBUG_FATAL(s_installed, ("ParticleQuadPool::install() - Already installed"));
+
+	s_simdAvailable = detectSimd();
+	s_disableSimd = false;
+	s_disabled = false;
+
+	DebugFlags::registerFlag(s_disabled, "ClientParticle", "disableQuadPool");
+	DebugFlags::registerFlag(s_disableSimd, "ClientParticle", "disableQuadPoolSimd");
+
+	ExitChain::add(&ParticleQuadPoolNamespace::remove, "ParticleQuadPool::remove()");
+
+	s_installed = true;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Whether new emitters may keep their quad particles in a pool.  Emitters
+ * already created keep the storage they started with.
+ */
+
+bool ParticleQuadPool::isEnabled()
+{
+	return !s_disabled;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleQuadPool::setEnabled(bool const enabled)
+{
+	s_disabled = !enabled;
+}
+
+//-----------------------------------------------------------------------------
+bool ParticleQuadPool::getUseSimd()
+{
+	return s_simdAvailable && !s_disableSimd;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleQuadPool::setUseSimd(bool const useSimd)
+{
+	s_disableSimd = !useSimd;
+}
+
+//-----------------------------------------------------------------------------
+ParticleQuadPool::ParticleQuadPool()
+ : m_count(0)
+ , m_globalCount(0)
+ , m_capacity(0)
+ , m_components(new FloatVector)
+ , m_sortKeys(new SortKeyVector)
+{
+}
+
+//-----------------------------------------------------------------------------
+ParticleQuadPool::~ParticleQuadPool()
+{
+	clear();
+	updateGlobalCount();
+
+	delete m_components;
+	m_components = NULL;
+
+	delete m_sortKeys;
+	m_sortKeys = NULL;
+}
+
+//-----------------------------------------------------------------------------
+float const *ParticleQuadPool::getComponent(Component const component) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, static_cast<int>(component), static_cast<int>(C_count));
+
+	return (m_capacity > 0) ? &(*m_components)[static_cast<size_t>(component * m_capacity)] : NULL;
+}
+
+//-----------------------------------------------------------------------------
+float *ParticleQuadPool::getMutableComponent(Component const component)
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, static_cast<int>(component), static_cast<int>(C_count));
+
+	return (m_capacity > 0) ? &(*m_components)[static_cast<size_t>(component * m_capacity)] : NULL;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleQuadPool::reserve(int const count)
+{
+	if (count <= m_capacity)
+	{
+		return;
+	}
+
+	// Grow geometrically and keep each component a whole number of SIMD lanes
+
+	int const capacity = (std::max(count, std::max(m_capacity * 2, 16)) + 3) & ~3;
+
+	FloatVector components(static_cast<size_t>(capacity * C_count), 0.0f);
+
+	for (int component = 0; component < C_count; ++component)
+	{
+		if (m_count > 0)
+		{
+			memcpy(&components[static_cast<size_t>(component * capacity)], getComponent(static_cast<Component>(component)), sizeof(float) * static_cast<size_t>(m_count));
+		}
+	}
+
+	m_components->swap(components);
+	m_capacity = capacity;
+}
+
+//-----------------------------------------------------------------------------
+int ParticleQuadPool::add(ParticleQuad const &particleQuad)
+{
+	reserve(m_count + 1);
+
+	int const index = m_count++;
+
+	getMutableComponent(C_positionX)[index] = particleQuad.m_position.x;
+	getMutableComponent(C_positionY)[index] = particleQuad.m_position.y;
+	getMutableComponent(C_positionZ)[index] = particleQuad.m_position.z;
+	getMutableComponent(C_positionPreviousX)[index] = particleQuad.m_positionPrevious.x;
+	getMutableComponent(C_positionPreviousY)[index] = particleQuad.m_positionPrevious.y;
+	getMutableComponent(C_positionPreviousZ)[index] = particleQuad.m_positionPrevious.z;
+	getMutableComponent(C_velocityX)[index] = particleQuad.m_velocity.x;
+	getMutableComponent(C_velocityY)[index] = particleQuad.m_velocity.y;
+	getMutableComponent(C_velocityZ)[index] = particleQuad.m_velocity.z;
+	getMutableComponent(C_upVectorX)[index] = particleQuad.m_upVector.x;
+	getMutableComponent(C_upVectorY)[index] = particleQuad.m_upVector.y;
+	getMutableComponent(C_upVectorZ)[index] = particleQuad.m_upVector.z;
+	getMutableComponent(C_sideVectorX)[index] = particleQuad.m_sideVector.x;
+	getMutableComponent(C_sideVectorY)[index] = particleQuad.m_sideVector.y;
+	getMutableComponent(C_sideVectorZ)[index] = particleQuad.m_sideVector.z;
+	getMutableComponent(C_age)[index] = particleQuad.m_age;
+	getMutableComponent(C_lifeTime)[index] = particleQuad.m_lifeTime;
+	getMutableComponent(C_agePercent)[index] = particleQuad.m_agePercent;
+	getMutableComponent(C_weight)[index] = particleQuad.m_weight;
+	getMutableComponent(C_initialRotation)[index] = particleQuad.m_initialRotation;
+	getMutableComponent(C_alphaPercent)[index] = particleQuad.m_iterAlpha.m_initialPercent;
+	getMutableComponent(C_colorPercent)[index] = particleQuad.m_iterColor.m_randomSamplePercent;
+	getMutableComponent(C_speedScalePercent)[index] = particleQuad.m_iterSpeedScale.m_initialPercent;
+	getMutableComponent(C_lengthPercent)[index] = particleQuad.m_iterLength.m_initialPercent;
+	getMutableComponent(C_widthPercent)[index] = particleQuad.m_iterWidth.m_initialPercent;
+	getMutableComponent(C_rotationPercent)[index] = particleQuad.m_iterRotation.m_initialPercent;
+	getMutableComponent(C_particleRelativeRotationXPercent)[index] = particleQuad.m_iterParticleRelativeRotationX.m_initialPercent;
+	getMutableComponent(C_particleRelativeRotationYPercent)[index] = particleQuad.m_iterParticleRelativeRotationY.m_initialPercent;
+	getMutableComponent(C_particleRelativeRotationZPercent)[index] = particleQuad.m_iterParticleRelativeRotationZ.m_initialPercent;
+
+	return index;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleQuadPool::clear()
+{
+	m_count = 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Counts the particles added and removed since the last call against the
+ * ParticleQuad budget.  Must be called from the main thread.
+ */
+
+void ParticleQuadPool::updateGlobalCount()
+{
+	ParticleQuad::adjustPooledCount(m_count - m_globalCount);
+	m_globalCount = m_count;
+}
+
+//-----------------------------------------------------------------------------
+void ParticleQuadPool::moveParticle(int const from, int const to)
+{
+	for (int component = 0; component < cs_persistentComponentCount; ++component)
+	{
+		float *const values = getMutableComponent(static_cast<Component>(component));
+
+		values[to] = values[from];
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Ages, moves and sizes the particles in [first, end).  The extent of the
+ * particles that were alive is merged into extentMin and extentMax.
+ */
+
+void ParticleQuadPool::update(int const first, int const end, float const deltaTime, UpdateParameters const &parameters, Vector &extentMin, Vector &extentMax)
+{
+	NOT_NULL(parameters.m_curves);
+	DEBUG_FATAL((first < 0) || (end > m_count), ("ParticleQuadPool::update() - Invalid range [%d, %d) of %d particles", first, end, m_count));
+
+	if (first >= end)
+	{
+		return;
+	}
+
+	bool const useSimd = getUseSimd();
+
+	if (useSimd)
+	{
+		updateAgeSimd(first, end, deltaTime);
+	}
+	else
+	{
+		updateAgeScalar(first, end, deltaTime);
+	}
+
+	ParticleQuadCurves const &curves = *parameters.m_curves;
+	float const *const agePercents = getComponent(C_agePercent);
+
+	curves.m_speedScale.sample(agePercents, getComponent(C_speedScalePercent), first, end, getMutableComponent(C_speedScale));
+	curves.m_length.sample(agePercents, getComponent(C_lengthPercent), first, end, getMutableComponent(C_length));
+
+	if (!parameters.m_lengthAndWidthLinked)
+	{
+		curves.m_width.sample(agePercents, getComponent(C_widthPercent), first, end, getMutableComponent(C_width));
+	}
+
+	if (useSimd)
+	{
+		integrateSimd(first, end, deltaTime, parameters, extentMin, extentMax);
+	}
+	else
+	{
+		integrateScalar(first, end, deltaTime, parameters, extentMin, extentMax);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void ParticleQuadPool::updateAgeScalar(int const first, int const end, float const deltaTime)
+{
+	float *const ages = getMutableComponent(C_age);
+	float *const agePercents = getMutableComponent(C_agePercent);
+	float *const alives = getMutableComponent(C_alive);
+	float const *const lifeTimes = getComponent(C_lifeTime);
+
+	for (int i = first; i < end; ++i)
+	{
+		// Particles pushed past their lifetime by the previous update die this frame without moving
+
+		if (ages[i] < lifeTimes[i])
+		{
+			float const age = std::min(ages[i] + deltaTime, lifeTimes[i]);
+
+			ages[i] = age;
+			agePercents[i] = age / lifeTimes[i];
+			alives[i] = 1.0f;
+		}
+		else
+		{
+			alives[i] = 0.0f;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void ParticleQuadPool::integrateScalar(int const first, int const end, float const deltaTime, UpdateParameters const &parameters, Vector &extentMin, Vector &extentMax)
+{
+	float *const positionsX = getMutableComponent(C_positionX);
+	float *const positionsY = getMutableComponent(C_positionY);
+	float *const positionsZ = getMutableComponent(C_positionZ);
+	float *const positionsPreviousX = getMutableComponent(C_positionPreviousX);
+	float *const positionsPreviousY = getMutableComponent(C_positionPreviousY);
+	float *const positionsPreviousZ = getMutableComponent(C_positionPreviousZ);
+	float *const velocitiesX = getMutableComponent(C_velocityX);
+	float *const velocitiesY = getMutableComponent(C_velocityY);
+	float *const velocitiesZ = getMutableComponent(C_velocityZ);
+	float *const upVectorsX = getMutableComponent(C_upVectorX);
+	float *const upVectorsY = getMutableComponent(C_upVectorY);
+	float *const upVectorsZ = getMutableComponent(C_upVectorZ);
+	float const *const weights = getComponent(C_weight);
+	float const *const alives = getComponent(C_alive);
+	float const *const speedScales = getComponent(C_speedScale);
+	float const *const lengths = getComponent(C_length);
+	float const *const widths = parameters.m_lengthAndWidthLinked ? lengths : getComponent(C_width);
+
+	Vector const wind(parameters.m_wind * deltaTime);
+
+	for (int i = first; i < end; ++i)
+	{
+		if (alives[i] == 0.0f)
+		{
+			continue;
+		}
+
+		// Integrate the position with the velocity from the last frame, then apply gravity
+
+		positionsPreviousX[i] = positionsX[i];
+		positionsPreviousY[i] = positionsY[i];
+		positionsPreviousZ[i] = positionsZ[i];
+
+		positionsX[i] = positionsX[i] + deltaTime * velocitiesX[i] * speedScales[i] + wind.x;
+		positionsY[i] = positionsY[i] + deltaTime * velocitiesY[i] * speedScales[i] + wind.y;
+		positionsZ[i] = positionsZ[i] + deltaTime * velocitiesZ[i] * speedScales[i] + wind.z;
+
+		velocitiesY[i] += -9.8f * weights[i] * deltaTime;
+
+		// Re-orient moving particles to match their velocity
+
+		if (parameters.m_orientWithVelocity)
+		{
+			Vector upVector(velocitiesX[i], velocitiesY[i], velocitiesZ[i]);
+
+			if (upVector != Vector::zero)
+			{
+				IGNORE_RETURN(upVector.normalize());
+
+				upVectorsX[i] = upVector.x;
+				upVectorsY[i] = upVector.y;
+				upVectorsZ[i] = upVector.z;
+			}
+		}
+
+		float const radius = std::max(lengths[i], widths[i]) * parameters.m_effectScale;
+
+		extentMin.x = std::min(extentMin.x, std::min(positionsX[i] - radius, positionsX[i] + radius));
+		extentMin.y = std::min(extentMin.y, std::min(positionsY[i] - radius, positionsY[i] + radius));
+		extentMin.z = std::min(extentMin.z, std::min(positionsZ[i] - radius, positionsZ[i] + radius));
+		extentMax.x = std::max(extentMax.x, std::max(positionsX[i] - radius, positionsX[i] + radius));
+		extentMax.y = std::max(extentMax.y, std::max(positionsY[i] - radius, positionsY[i] + radius));
+		extentMax.z = std::max(extentMax.z, std::max(positionsZ[i] - radius, positionsZ[i] + radius));
+	}
+}
+
+//-----------------------------------------------------------------------------
+#if PARTICLE_USE_SIMD
+
+namespace ParticleQuadPoolNamespace
+{
+	//-----------------------------------------------------------------------------
+	/**
+	 * Per lane select: mask ? a : b.
+	 */
+
+	PARTICLE_TARGET_SSE2 inline __m128 selectLanes(__m128 const &mask, __m128 const &a, __m128 const &b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	//-----------------------------------------------------------------------------
+	PARTICLE_TARGET_SSE2 inline float getMinimumLane(__m128 const &value)
+	{
+		__m128 const halves = _mm_min_ps(value, _mm_movehl_ps(value, value));
+
+		return _mm_cvtss_f32(_mm_min_ss(halves, _mm_shuffle_ps(halves, halves, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+
+	//-----------------------------------------------------------------------------
+	PARTICLE_TARGET_SSE2 inline float getMaximumLane(__m128 const &value)
+	{
+		__m128 const halves = _mm_max_ps(value, _mm_movehl_ps(value, value));
+
+		return _mm_cvtss_f32(_mm_max_ss(halves, _mm_shuffle_ps(halves, halves, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+}
+
+//-----------------------------------------------------------------------------
+PARTICLE_TARGET_SSE2 void ParticleQuadPool::updateAgeSimd(int const first, int const end, float const deltaTime)
+{
+	float *const ages = getMutableComponent(C_age);
+	float *const agePercents = getMutableComponent(C_agePercent);
+	float *const alives = getMutableComponent(C_alive);
+	float const *const lifeTimes = getComponent(C_lifeTime);
+
+	__m128 const one = _mm_set1_ps(1.0f);
+	__m128 const delta = _mm_set1_ps(deltaTime);
+
+	int i = first;
+
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 const age = _mm_loadu_ps(ages + i);
+		__m128 const lifeTime = _mm_loadu_ps(lifeTimes + i);
+		__m128 const alive = _mm_cmplt_ps(age, lifeTime);
+
+		__m128 const newAge = _mm_min_ps(_mm_add_ps(age, delta), lifeTime);
+
+		// Divide dead lanes by one so a zero lifetime does not produce a NaN that is thrown away anyway
+
+		__m128 const agePercent = _mm_div_ps(newAge, selectLanes(alive, lifeTime, one));
+
+		_mm_storeu_ps(ages + i, selectLanes(alive, newAge, age));
+		_mm_storeu_ps(agePercents + i, selectLanes(alive, agePercent, _mm_loadu_ps(agePercents + i)));
+		_mm_storeu_ps(alives + i, _mm_and_ps(alive, one));
+	}
+
+	updateAgeScalar(i, end, deltaTime);
+}
+
+//-----------------------------------------------------------------------------
+PARTICLE_TARGET_SSE2 void ParticleQuadPool::integrateSimd(int const first, int const end, float const deltaTime, UpdateParameters const &parameters, Vector &extentMin, Vector &extentMax)
+{
+	float *const positionsX = getMutableComponent(C_positionX);
+	float *const positionsY = getMutableComponent(C_positionY);
+	float *const positionsZ = getMutableComponent(C_positionZ);
+	float *const positionsPreviousX = getMutableComponent(C_positionPreviousX);
+	float *const positionsPreviousY = getMutableComponent(C_positionPreviousY);
+	float *const positionsPreviousZ = getMutableComponent(C_positionPreviousZ);
+	float *const velocitiesX = getMutableComponent(C_velocityX);
+	float *const velocitiesY = getMutableComponent(C_velocityY);
+	float *const velocitiesZ = getMutableComponent(C_velocityZ);
+	float *const upVectorsX = getMutableComponent(C_upVectorX);
+	float *const upVectorsY = getMutableComponent(C_upVectorY);
+	float *const upVectorsZ = getMutableComponent(C_upVectorZ);
+	float const *const weights = getComponent(C_weight);
+	float const *const alives = getComponent(C_alive);
+	float const *const speedScales = getComponent(C_speedScale);
+	float const *const lengths = getComponent(C_length);
+	float const *const widths = parameters.m_lengthAndWidthLinked ? lengths : getComponent(C_width);
+
+	Vector const wind(parameters.m_wind * deltaTime);
+
+	__m128 const zero = _mm_setzero_ps();
+	__m128 const one = _mm_set1_ps(1.0f);
+	__m128 const delta = _mm_set1_ps(deltaTime);
+	__m128 const gravity = _mm_set1_ps(-9.8f);
+	__m128 const windX = _mm_set1_ps(wind.x);
+	__m128 const windY = _mm_set1_ps(wind.y);
+	__m128 const windZ = _mm_set1_ps(wind.z);
+	__m128 const effectScale = _mm_set1_ps(parameters.m_effectScale);
+	__m128 const normalizeThreshold = _mm_set1_ps(Vector::NORMALIZE_THRESHOLD);
+
+	__m128 minimumX = _mm_set1_ps(extentMin.x);
+	__m128 minimumY = _mm_set1_ps(extentMin.y);
+	__m128 minimumZ = _mm_set1_ps(extentMin.z);
+	__m128 maximumX = _mm_set1_ps(extentMax.x);
+	__m128 maximumY = _mm_set1_ps(extentMax.y);
+	__m128 maximumZ = _mm_set1_ps(extentMax.z);
+
+	int i = first;
+
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 const alive = _mm_cmpneq_ps(_mm_loadu_ps(alives + i), zero);
+
+		// Integrate the position with the velocity from the last frame, then apply gravity
+
+		__m128 const positionX = _mm_loadu_ps(positionsX + i);
+		__m128 const positionY = _mm_loadu_ps(positionsY + i);
+		__m128 const positionZ = _mm_loadu_ps(positionsZ + i);
+		__m128 const velocityX = _mm_loadu_ps(velocitiesX + i);
+		__m128 const velocityZ = _mm_loadu_ps(velocitiesZ + i);
+		__m128 velocityY = _mm_loadu_ps(velocitiesY + i);
+		__m128 const speedScale = _mm_loadu_ps(speedScales + i);
+
+		__m128 const newPositionX = _mm_add_ps(_mm_add_ps(positionX, _mm_mul_ps(_mm_mul_ps(delta, velocityX), speedScale)), windX);
+		__m128 const newPositionY = _mm_add_ps(_mm_add_ps(positionY, _mm_mul_ps(_mm_mul_ps(delta, velocityY), speedScale)), windY);
+		__m128 const newPositionZ = _mm_add_ps(_mm_add_ps(positionZ, _mm_mul_ps(_mm_mul_ps(delta, velocityZ), speedScale)), windZ);
+
+		velocityY = selectLanes(alive, _mm_add_ps(velocityY, _mm_mul_ps(_mm_mul_ps(gravity, _mm_loadu_ps(weights + i)), delta)), velocityY);
+
+		_mm_storeu_ps(positionsPreviousX + i, selectLanes(alive, positionX, _mm_loadu_ps(positionsPreviousX + i)));
+		_mm_storeu_ps(positionsPreviousY + i, selectLanes(alive, positionY, _mm_loadu_ps(positionsPreviousY + i)));
+		_mm_storeu_ps(positionsPreviousZ + i, selectLanes(alive, positionZ, _mm_loadu_ps(positionsPreviousZ + i)));
+		_mm_storeu_ps(positionsX + i, selectLanes(alive, newPositionX, positionX));
+		_mm_storeu_ps(positionsY + i, selectLanes(alive, newPositionY, positionY));
+		_mm_storeu_ps(positionsZ + i, selectLanes(alive, newPositionZ, positionZ));
+		_mm_storeu_ps(velocitiesY + i, velocityY);
+
+		// Re-orient moving particles to match their velocity.  Like Vector::normalize(),
+		// velocities too short to normalize are used as they are.
+
+		if (parameters.m_orientWithVelocity)
+		{
+			__m128 const moving = _mm_or_ps(_mm_or_ps(_mm_cmpneq_ps(velocityX, zero), _mm_cmpneq_ps(velocityY, zero)), _mm_cmpneq_ps(velocityZ, zero));
+			__m128 const update = _mm_and_ps(alive, moving);
+
+			__m128 const magnitude = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(velocityX, velocityX), _mm_mul_ps(velocityY, velocityY)), _mm_mul_ps(velocityZ, velocityZ)));
+			__m128 const normalizable = _mm_cmpge_ps(magnitude, normalizeThreshold);
+			__m128 const scale = selectLanes(normalizable, _mm_div_ps(one, selectLanes(normalizable, magnitude, one)), one);
+
+			_mm_storeu_ps(upVectorsX + i, selectLanes(update, _mm_mul_ps(velocityX, scale), _mm_loadu_ps(upVectorsX + i)));
+			_mm_storeu_ps(upVectorsY + i, selectLanes(update, _mm_mul_ps(velocityY, scale), _mm_loadu_ps(upVectorsY + i)));
+			_mm_storeu_ps(upVectorsZ + i, selectLanes(update, _mm_mul_ps(velocityZ, scale), _mm_loadu_ps(upVectorsZ + i)));
+		}
+
+		// Grow the extent by the particle size, dead lanes keep the running extent
+
+		__m128 const radius = _mm_mul_ps(_mm_max_ps(_mm_loadu_ps(lengths + i), _mm_loadu_ps(widths + i)), effectScale);
+
+		__m128 const lowX = _mm_sub_ps(newPositionX, radius);
+		__m128 const lowY = _mm_sub_ps(newPositionY, radius);
+		__m128 const lowZ = _mm_sub_ps(newPositionZ, radius);
+		__m128 const highX = _mm_add_ps(newPositionX, radius);
+		__m128 const highY = _mm_add_ps(newPositionY, radius);
+		__m128 const highZ = _mm_add_ps(newPositionZ, radius);
+
+		minimumX = selectLanes(alive, _mm_min_ps(minimumX, _mm_min_ps(lowX, highX)), minimumX);
+		minimumY = selectLanes(alive, _mm_min_ps(minimumY, _mm_min_ps(lowY, highY)), minimumY);
+		minimumZ = selectLanes(alive, _mm_min_ps(minimumZ, _mm_min_ps(lowZ, highZ)), minimumZ);
+		maximumX = selectLanes(alive, _mm_max_ps(maximumX, _mm_max_ps(lowX, highX)), maximumX);
+		maximumY = selectLanes(alive, _mm_max_ps(maximumY, _mm_max_ps(lowY, highY)), maximumY);
+		maximumZ = selectLanes(alive, _mm_max_ps(maximumZ, _mm_max_ps(lowZ, highZ)), maximumZ);
+	}
+
+	extentMin.set(getMinimumLane(minimumX), getMinimumLane(minimumY), getMinimumLane(minimumZ));
+	extentMax.set(getMaximumLane(maximumX), getMaximumLane(maximumY), getMaximumLane(maximumZ));
+
+	integrateScalar(i, end, deltaTime, parameters, extentMin, extentMax);
+}
+
+//-----------------------------------------------------------------------------
+PARTICLE_TARGET_SSE2 void ParticleQuadPool::calculateSortKeysSimd(Vector const &depthAxis, float const depthOffset)
+{
+	float const *const positionsX = getComponent(C_positionX);
+	float const *const positionsY = getComponent(C_positionY);
+	float const *const positionsZ = getComponent(C_positionZ);
+	uint64 *const keys = &(*m_sortKeys)[0];
+
+	__m128 const axisX = _mm_set1_ps(depthAxis.x);
+	__m128 const axisY = _mm_set1_ps(depthAxis.y);
+	__m128 const axisZ = _mm_set1_ps(depthAxis.z);
+	__m128 const offset = _mm_set1_ps(depthOffset);
+	__m128 const zero = _mm_setzero_ps();
+	__m128i const signBit = _mm_set1_epi32(static_cast<int>(0x80000000u));
+	__m128i const allBits = _mm_set1_epi32(-1);
+
+	int i = 0;
+
+	for (; i + 4 <= m_count; i += 4)
+	{
+		__m128 const depth = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(axisX, _mm_loadu_ps(positionsX + i)), _mm_mul_ps(axisY, _mm_loadu_ps(positionsY + i))), _mm_mul_ps(axisZ, _mm_loadu_ps(positionsZ + i))), offset), zero);
+
+		// Flip negative depths entirely and positive depths' sign bit, then invert for far to near
+
+		__m128i const bits = _mm_castps_si128(depth);
+		__m128i const ordered = _mm_xor_si128(bits, _mm_or_si128(_mm_srai_epi32(bits, 31), signBit));
+		__m128i const depthKey = _mm_xor_si128(ordered, allBits);
+
+		uint32 depthKeys[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(depthKeys), depthKey);
+
+		keys[i] = (static_cast<uint64>(depthKeys[0]) << 32) | static_cast<uint64>(i);
+		keys[i + 1] = (static_cast<uint64>(depthKeys[1]) << 32) | static_cast<uint64>(i + 1);
+		keys[i + 2] = (static_cast<uint64>(depthKeys[2]) << 32) | static_cast<uint64>(i + 2);
+		keys[i + 3] = (static_cast<uint64>(depthKeys[3]) << 32) | static_cast<uint64>(i + 3);
+	}
+
+	for (; i < m_count; ++i)
+	{
+		float const depth = depthAxis.x * positionsX[i] + depthAxis.y * positionsY[i] + depthAxis.z * positionsZ[i] + depthOffset;
+
+		keys[i] = (static_cast<uint64>(makeDepthSortKey(depth)) << 32) | static_cast<uint64>(i);
+	}
+}
+
+#else
+
+void ParticleQuadPool::updateAgeSimd(int const first, int const end, float const deltaTime)
+{
+	updateAgeScalar(first, end, deltaTime);
+}
+
+void ParticleQuadPool::integrateSimd(int const first, int const end, float const deltaTime, UpdateParameters const &parameters, Vector &extentMin, Vector &extentMax)
+{
+	integrateScalar(first, end, deltaTime, parameters, extentMin, extentMax);
+}
+
+void ParticleQuadPool::calculateSortKeysSimd(Vector const &depthAxis, float const depthOffset)
+{
+	calculateSortKeysScalar(depthAxis, depthOffset);
+}
+
+#endif
+
+//-----------------------------------------------------------------------------
+/**
+ * Removes the particles that have reached their lifetime.  The last particle
+ * moves into each free slot, so the order of the survivors changes.
+ */
+
+void ParticleQuadPool::removeDeadParticles()
+{
+	float const *const ages = getComponent(C_age);
+	float const *const lifeTimes = getComponent(C_lifeTime);
+
+	// Walk backwards so the particle moved into a slot has already been checked
+
+	for (int i = m_count - 1; i >= 0; --i)
+	{
+		if (ages[i] >= lifeTimes[i])
+		{
+			--m_count;
+
+			if (i != m_count)
+			{
+				moveParticle(m_count, i);
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void ParticleQuadPool::calculateSortKeysScalar(Vector const &depthAxis, float const depthOffset)
+{
+	float const *const positionsX = getComponent(C_positionX);
+	float const *const positionsY = getComponent(C_positionY);
+	float const *const positionsZ = getComponent(C_positionZ);
+	uint64 *const keys = &(*m_sortKeys)[0];
+
+	for (int i = 0; i < m_count; ++i)
+	{
+		float const depth = depthAxis.x * positionsX[i] + depthAxis.y * positionsY[i] + depthAxis.z * positionsZ[i] + depthOffset;
+
+		keys[i] = (static_cast<uint64>(makeDepthSortKey(depth)) << 32) | static_cast<uint64>(i);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Orders the particles far to near.  The depth of a particle is
+ * dot(depthAxis, position) + depthOffset.
+ */
+
+void ParticleQuadPool::sort(Vector const &depthAxis, float const depthOffset)
+{
+	if (m_count == 0)
+	{
+		return;
+	}
+
+	// The second half of the keys is scratch space for the radix passes
+
+	m_sortKeys->resize(static_cast<size_t>(m_count * 2));
+
+	if (getUseSimd())
+	{
+		calculateSortKeysSimd(depthAxis, depthOffset);
+	}
+	else
+	{
+		calculateSortKeysScalar(depthAxis, depthOffset);
+	}
+
+	radixSortByDepth(&(*m_sortKeys)[0], &(*m_sortKeys)[static_cast<size_t>(m_count)], m_count);
+}
+
+//-----------------------------------------------------------------------------
+int ParticleQuadPool::getSortedIndex(int const order) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, order, m_count);
+
+	return static_cast<int>((*m_sortKeys)[static_cast<size_t>(order)] & 0xffffffffu);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Samples the alpha, color, length, width and rotation of every particle at
+ * its current age.  The width is not sampled when it is linked to the length.
+ */
+
+void ParticleQuadPool::sampleRenderAttributes(ParticleQuadCurves const &curves, bool const colorUsesAgePercent, bool const lengthAndWidthLinked)
+{
+	if (m_count == 0)
+	{
+		return;
+	}
+
+	float const *const agePercents = getComponent(C_agePercent);
+
+	curves.m_alpha.sample(agePercents, getComponent(C_alphaPercent), 0, m_count, getMutableComponent(C_alpha));
+	curves.m_color.sample(colorUsesAgePercent ? agePercents : getComponent(C_colorPercent), 0, m_count, getMutableComponent(C_red), getMutableComponent(C_green), getMutableComponent(C_blue));
+	curves.m_length.sample(agePercents, getComponent(C_lengthPercent), 0, m_count, getMutableComponent(C_length));
+	curves.m_rotation.sample(agePercents, getComponent(C_rotationPercent), 0, m_count, getMutableComponent(C_rotation));
+
+	if (!lengthAndWidthLinked)
+	{
+		curves.m_width.sample(agePercents, getComponent(C_widthPercent), 0, m_count, getMutableComponent(C_width));
+	}
+}
+
+// ============================================================================
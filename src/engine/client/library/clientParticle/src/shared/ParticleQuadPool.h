@@ -0,0 +1,328 @@
+// ============================================================================
+//
+// ParticleQuadPool.h
+// copyright 2026
+//
+// ============================================================================
+
+#ifndef INCLUDED_ParticleQuadPool_H
+#define INCLUDED_ParticleQuadPool_H
+
+#include "sharedMath/Vector.h"
+
+class ColorRamp;
+class ParticleDescriptionQuad;
+class ParticleQuad;
+class WaveForm;
+
+//-----------------------------------------------------------------------------
+/**
+ * A WaveForm resampled at fixed percent steps.
+ *
+ * Each step stores the lowest and highest value the waveform can take, and a
+ * particle picks its value between the two with the initial random percent
+ * of its WaveFormControlPointIter.  This gives the same result as
+ * WaveForm::getValue() at the steps and interpolates linearly between them,
+ * so whole arrays of particles can be sampled without walking the control
+ * point list.
+ */
+
+class ParticleCurve
+{
+public:
+
+	enum
+	{
+		cs_stepCount = 64
+	};
+
+	static bool canSample(WaveForm const &waveForm);
+
+public:
+
+	ParticleCurve();
+	~ParticleCurve();
+
+	void  bake(WaveForm const &waveForm);
+
+	bool  isConstant() const;
+	float sample(float percent, float initialPercent) const;
+	void  sample(float const *percents, float const *initialPercents, int first, int end, float *results) const;
+
+private:
+
+	void  sampleScalar(float const *percents, float const *initialPercents, int first, int end, float *results) const;
+	void  sampleSimd(float const *percents, float const *initialPercents, int first, int end, float *results) const;
+
+	// Disabled
+
+	ParticleCurve(ParticleCurve const &);
+	ParticleCurve &operator =(ParticleCurve const &);
+
+private:
+
+	// Lower value, lower slope, upper value and upper slope for each step, NULL if the curve is constant.
+
+	float *m_steps;
+	float  m_constantValue;
+	float  m_valueMin;
+	float  m_valueMax;
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * A ColorRamp resampled at fixed percent steps.
+ */
+
+class ParticleColorCurve
+{
+public:
+
+	ParticleColorCurve();
+	~ParticleColorCurve();
+
+	void  bake(ColorRamp const &colorRamp);
+
+	void  sample(float percent, float &red, float &green, float &blue) const;
+	void  sample(float const *percents, int first, int end, float *reds, float *greens, float *blues) const;
+
+private:
+
+	// Disabled
+
+	ParticleColorCurve(ParticleColorCurve const &);
+	ParticleColorCurve &operator =(ParticleColorCurve const &);
+
+private:
+
+	// Red, green, blue and padding followed by their slopes for each step.
+
+	float *m_steps;
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * The resampled curves of a ParticleDescriptionQuad.
+ */
+
+class ParticleQuadCurves
+{
+public:
+
+	static bool canSample(ParticleDescriptionQuad const &particleDescriptionQuad);
+
+public:
+
+	explicit ParticleQuadCurves(ParticleDescriptionQuad const &particleDescriptionQuad);
+
+	ParticleColorCurve m_color;
+	ParticleCurve      m_alpha;
+	ParticleCurve      m_speedScale;
+	ParticleCurve      m_length;
+	ParticleCurve      m_width;
+	ParticleCurve      m_rotation;
+	ParticleCurve      m_particleRelativeRotationX;
+	ParticleCurve      m_particleRelativeRotationY;
+	ParticleCurve      m_particleRelativeRotationZ;
+
+private:
+
+	// Disabled
+
+	ParticleQuadCurves();
+	ParticleQuadCurves(ParticleQuadCurves const &);
+	ParticleQuadCurves &operator =(ParticleQuadCurves const &);
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * Quad particles of one ParticleEmitter stored as structure-of-arrays.
+ *
+ * Emitters whose particles only need integration, waveform sampling and a
+ * depth sort keep them here instead of allocating a ParticleQuad for each
+ * one.  Every particle attribute is a contiguous array of floats, so the
+ * update and sampling kernels run four particles at a time with SSE2 when
+ * the cpu supports it.  Expired particles are removed by moving the last
+ * particle into their slot, and the draw order comes from sorting packed
+ * 64 bit depth and index keys.
+ *
+ * Particles are counted against the ParticleQuad budget so pooled and
+ * allocated quads share the same global limit.  Adding and removing
+ * particles only changes the pool, the budget catches up when the owner
+ * calls updateGlobalCount(), so emitters on different threads can update
+ * their pools at the same time.  Owners reserve the room they may fill with
+ * ParticleQuad::reserveParticles() before adding off the main thread.
+ */
+
+class ParticleQuadPool
+{
+public:
+
+	enum Component
+	{
+		C_positionX,
+		C_positionY,
+		C_positionZ,
+		C_positionPreviousX,
+		C_positionPreviousY,
+		C_positionPreviousZ,
+		C_velocityX,
+		C_velocityY,
+		C_velocityZ,
+		C_upVectorX,
+		C_upVectorY,
+		C_upVectorZ,
+		C_sideVectorX,
+		C_sideVectorY,
+		C_sideVectorZ,
+		C_age,
+		C_lifeTime,
+		C_agePercent,
+		C_weight,
+		C_initialRotation,
+
+		// Initial random percents of the waveform iterators
+
+		C_alphaPercent,
+		C_colorPercent,
+		C_speedScalePercent,
+		C_lengthPercent,
+		C_widthPercent,
+		C_rotationPercent,
+		C_particleRelativeRotationXPercent,
+		C_particleRelativeRotationYPercent,
+		C_particleRelativeRotationZPercent,
+
+		// Sampled by update() and sampleRenderAttributes(), only valid until the next call
+
+		C_alive,
+		C_speedScale,
+		C_length,
+		C_width,
+		C_alpha,
+		C_red,
+		C_green,
+		C_blue,
+		C_rotation,
+
+		C_count
+	};
+
+	class UpdateParameters
+	{
+	public:
+
+		UpdateParameters();
+
+		ParticleQuadCurves const *m_curves;
+		Vector                    m_wind;
+		float                     m_effectScale;
+		bool                      m_lengthAndWidthLinked;
+		bool                      m_orientWithVelocity;
+	};
+
+	static void install();
+
+	static bool isEnabled();
+	static void setEnabled(bool enabled);
+	static bool getUseSimd();
+	static void setUseSimd(bool useSimd);
+
+public:
+
+	ParticleQuadPool();
+	~ParticleQuadPool();
+
+	int          getCount() const;
+	float const *getComponent(Component component) const;
+
+	Vector       getPosition(int index) const;
+	Vector       getPositionPrevious(int index) const;
+	Vector       getVelocity(int index) const;
+	Vector       getUpVector(int index) const;
+	Vector       getSideVector(int index) const;
+
+	int          add(ParticleQuad const &particleQuad);
+	void         clear();
+	void         updateGlobalCount();
+
+	void         update(int first, int end, float deltaTime, UpdateParameters const &parameters, Vector &extentMin, Vector &extentMax);
+	void         removeDeadParticles();
+
+	void         sort(Vector const &depthAxis, float depthOffset);
+	int          getSortedIndex(int order) const;
+
+	void         sampleRenderAttributes(ParticleQuadCurves const &curves, bool colorUsesAgePercent, bool lengthAndWidthLinked);
+
+private:
+
+	typedef stdvector<float>::fwd  FloatVector;
+	typedef stdvector<uint64>::fwd SortKeyVector;
+
+private:
+
+	float       *getMutableComponent(Component component);
+	void         reserve(int count);
+	void         moveParticle(int from, int to);
+
+	void         updateAgeScalar(int first, int end, float deltaTime);
+	void         updateAgeSimd(int first, int end, float deltaTime);
+	void         integrateScalar(int first, int end, float deltaTime, UpdateParameters const &parameters, Vector &extentMin, Vector &extentMax);
+	void         integrateSimd(int first, int end, float deltaTime, UpdateParameters const &parameters, Vector &extentMin, Vector &extentMax);
+	void         calculateSortKeysScalar(Vector const &depthAxis, float depthOffset);
+	void         calculateSortKeysSimd(Vector const &depthAxis, float depthOffset);
+
+	// Disabled
+
+	ParticleQuadPool(ParticleQuadPool const &);
+	ParticleQuadPool &operator =(ParticleQuadPool const &);
+
+private:
+
+	int            m_count;
+	int            m_globalCount;  // Particles counted against the ParticleQuad budget
+	int            m_capacity;
+	FloatVector   *m_components;   // C_count arrays of m_capacity floats
+	SortKeyVector *m_sortKeys;
+};
+
+// ============================================================================
+
+inline int ParticleQuadPool::getCount() const
+{
+	return m_count;
+}
+
+//-----------------------------------------------------------------------------
+inline Vector ParticleQuadPool::getPosition(int const index) const
+{
+	return Vector(getComponent(C_positionX)[index], getComponent(C_positionY)[index], getComponent(C_positionZ)[index]);
+}
+
+//-----------------------------------------------------------------------------
+inline Vector ParticleQuadPool::getPositionPrevious(int const index) const
+{
+	return Vector(getComponent(C_positionPreviousX)[index], getComponent(C_positionPreviousY)[index], getComponent(C_positionPreviousZ)[index]);
+}
+
+//-----------------------------------------------------------------------------
+inline Vector ParticleQuadPool::getVelocity(int const index) const
+{
+	return Vector(getComponent(C_velocityX)[index], getComponent(C_velocityY)[index], getComponent(C_velocityZ)[index]);
+}
+
+//-----------------------------------------------------------------------------
+inline Vector ParticleQuadPool::getUpVector(int const index) const
+{
+	return Vector(getComponent(C_upVectorX)[index], getComponent(C_upVectorY)[index], getComponent(C_upVectorZ)[index]);
+}
+
+//-----------------------------------------------------------------------------
+inline Vector ParticleQuadPool::getSideVector(int const index) const
+{
+	return Vector(getComponent(C_sideVectorX)[index], getComponent(C_sideVectorY)[index], getComponent(C_sideVectorZ)[index]);
+}
+
+// ============================================================================
+
+#endif // INCLUDED_ParticleQuadPool_H
@@ -18,6 +18,7 @@
 #include "clientParticle/ParticleEmitterGroup.h"
 #include "clientParticle/ParticleMesh.h"
 #include "clientParticle/ParticleQuad.h"
+#include "clientParticle/ParticleQuadPool.h"
 #include "clientParticle/ParticleManager.h"
 #include "clientParticle/SwooshAppearanceTemplate.h"
 #include "sharedDebug/InstallTimer.h"
@@ -37,6 +38,7 @@ void SetupClientParticle::install ()
 	ParticleEmitter::install();
 	ParticleMesh::install();
 	ParticleQuad::install();
+	ParticleQuadPool::install();
 	ParticleAttachment::install();
 	ConfigClientParticle::install();
 	ParticleManager::install();
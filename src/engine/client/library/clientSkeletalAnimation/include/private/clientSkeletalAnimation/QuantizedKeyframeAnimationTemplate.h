@@ -0,0 +1 @@
+#include "../../src/shared/animation/QuantizedKeyframeAnimationTemplate.h"
@@ -0,0 +1 @@
+#include "../../src/shared/animation/AnimationRecompressor.h"
@@ -0,0 +1 @@
+#include "../../src/shared/core/AnimationUpdateScheduler.h"
@@ -0,0 +1 @@
+#include "../../src/shared/appearance/FlatSkeletonHierarchy.h"
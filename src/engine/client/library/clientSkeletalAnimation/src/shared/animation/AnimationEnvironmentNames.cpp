@@ -21,5 +21,6 @@ const ConstCharCrcLowerString AnimationEnvironmentNames::cms_animatingSkill("ski
 const ConstCharCrcLowerString AnimationEnvironmentNames::cms_gender("gender");
 const ConstCharCrcLowerString AnimationEnvironmentNames::cms_riderPose("rider_pose");
 const ConstCharCrcLowerString AnimationEnvironmentNames::cms_mountedCreature("mounted_creature");
+const ConstCharCrcLowerString AnimationEnvironmentNames::cms_posePhaseOffset("pose_phase");
 
 // ======================================================================
@@ -45,6 +45,9 @@ public:
 
 	/// Mounted creature: used on the mount appearance, set to 0 when not mounted, set to 1 when mounted.
 	static const ConstCharCrcLowerString  cms_mountedCreature;
+
+	/// Time in seconds added to keyframe animation poses, snapped to the PoseCache frame quantum.  Used to desynchronize crowds playing the same looping idle. (float)
+	static const ConstCharCrcLowerString  cms_posePhaseOffset;
 };
 
 // ======================================================================
@@ -0,0 +1,949 @@
+// ======================================================================
+//
+// AnimationRecompressor.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientSkeletalAnimation/FirstClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/AnimationRecompressor.h"
+
+#include "clientSkeletalAnimation/AnimationEnvironment.h"
+#include "clientSkeletalAnimation/AnimationEnvironmentNames.h"
+#include "clientSkeletalAnimation/CompressedKeyframeAnimationTemplate.h"
+#include "clientSkeletalAnimation/KeyframeSkeletalAnimationTemplate.h"
+#include "clientSkeletalAnimation/PoseCache.h"
+#include "clientSkeletalAnimation/QuantizedKeyframeAnimationTemplate.h"
+#include "clientSkeletalAnimation/SkeletalAnimation.h"
+#include "clientSkeletalAnimation/SkeletalAnimationTemplateList.h"
+#include "clientSkeletalAnimation/TransformNameMap.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedFile/Iff.h"
+#include "sharedFile/TreeFile.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/CrcLowerString.h"
+#include "sharedFoundation/CrcString.h"
+#include "sharedMath/CompressedQuaternion.h"
+#include "sharedMath/Quaternion.h"
+#include "sharedMath/Vector.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <string.h>
+#include <vector>
+
+// ======================================================================
+
+#ifdef _DEBUG
+
+// ======================================================================
+
+namespace AnimationRecompressorNamespace
+{
+	typedef QuantizedKeyframeAnimationTemplate  QKAT;
+
+	typedef std::vector<CrcString const*>       CrcStringVector;
+	typedef std::vector<float>                  FloatVector;
+	typedef std::vector<int>                    IntVector;
+	typedef std::vector<Quaternion>             QuaternionVector;
+	typedef std::vector<uint8>                  Uint8Vector;
+	typedef std::vector<uint16>                 Uint16Vector;
+	typedef std::vector<Vector>                 VectorVector;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct MessageInfo
+	{
+		std::string  m_name;
+		IntVector    m_frameNumbers;
+	};
+
+	typedef std::vector<MessageInfo>            MessageInfoVector;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Track
+	{
+		uint8  m_type;
+		float  m_value0;
+		float  m_value1;
+	};
+
+	typedef std::vector<Track>                  TrackVector;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct LessCrcStringPointer
+	{
+		bool operator ()(CrcString const *lhs, CrcString const *rhs) const
+		{
+			return *lhs < *rhs;
+		}
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	/**
+	 * Maps the sorted transform names of the source animation onto a
+	 * skeleton-less pose, so both animations are evaluated in joint-local space.
+	 */
+
+	class SortedTransformNameMap: public TransformNameMap
+	{
+	public:
+
+		explicit SortedTransformNameMap(CrcStringVector const &transformNames);
+
+		virtual void             findTransformIndex(CrcString const &name, int *transformIndex, bool *found) const;
+		virtual int              getTransformIndex(CrcString const &name) const;
+		virtual int              getTransformCount() const;
+		virtual CrcString const &getTransformName(int index) const;
+
+	private:
+
+		// disabled
+		SortedTransformNameMap();
+		SortedTransformNameMap(SortedTransformNameMap const &);
+		SortedTransformNameMap &operator =(SortedTransformNameMap const &);
+
+	private:
+
+		CrcStringVector const &m_transformNames;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	const Tag TAG_CKAT = TAG(C,K,A,T);
+	const Tag TAG_KFAT = TAG(K,F,A,T);
+	const Tag TAG_LOCR = TAG(L,O,C,R);
+	const Tag TAG_LOCT = TAG(L,O,C,T);
+	const Tag TAG_MESG = TAG(M,E,S,G);
+	const Tag TAG_MSGS = TAG(M,S,G,S);
+	const Tag TAG_NSMP = TAG(N,S,M,P);
+	const Tag TAG_QCHN = TAG(Q,C,H,N);
+	const Tag TAG_QKAT = TAG(Q,K,A,T);
+	const Tag TAG_WSMP = TAG(W,S,M,P);
+	const Tag TAG_XFRM = TAG(X,F,R,M);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	int const   cs_componentCount  = QKAT::C_componentCount;
+	int const   cs_narrowSampleMax = 255;
+	int const   cs_wideSampleMax   = 65535;
+	int const   cs_timingPoseCount = 256;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	float  s_rotationTolerance;
+	float  s_translationTolerance;
+
+	int    s_convertedCount;
+	int    s_skipCount;
+	int    s_trackTypeCounts[QKAT::TT_wide + 1];
+
+	int    s_totalSourceFileBytes;
+	int    s_totalRecompressedFileBytes;
+	int    s_totalSourceResidentBytes;
+	int    s_totalRecompressedResidentBytes;
+
+	float  s_worstRotationErrorDegrees;
+	float  s_worstTranslationError;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	bool   readChomp(FILE *file, char *buffer, size_t bufferLength);
+
+	template <typename SourceTemplate>
+	void   collectSourceInfo(SourceTemplate const &sourceTemplate, float &framesPerSecond, int &frameCount, CrcStringVector &transformNames, MessageInfoVector &messages);
+
+	void   evaluatePose(SkeletalAnimation &animation, float frameNumber, Quaternion *rotations, Vector *translations);
+	void   sampleComponents(SkeletalAnimation &animation, int transformCount, int sampleCount, FloatVector &samples);
+
+	bool   buildTrack(float const *values, int sampleCount, float tolerance, Track &track);
+	int    quantize(float value, Track const &track, int maximumSample);
+
+	bool   writeRecompressedIff(Iff &sourceIff, float framesPerSecond, int frameCount, CrcStringVector const &transformNames, FloatVector const &samples, MessageInfoVector const &messages, Iff &outputIff);
+	void   writeMessages(MessageInfoVector const &messages, Iff &outputIff);
+	void   copyLocomotion(Iff &sourceIff, Iff &outputIff);
+
+	void   compareAnimations(SkeletalAnimation &sourceAnimation, SkeletalAnimation &recompressedAnimation, int transformCount, int frameCount, float &maxRotationErrorDegrees, int &maxRotationErrorTransform, float &maxTranslationError, int &maxTranslationErrorTransform);
+	float  timePoseEvaluation(SkeletalAnimation &animation, int transformCount, int frameCount);
+
+	void   recompressFile(char const *pathname, std::string const &outputDirectory);
+}
+
+using namespace AnimationRecompressorNamespace;
+
+// ======================================================================
+// class AnimationRecompressorNamespace::SortedTransformNameMap
+// ======================================================================
+
+AnimationRecompressorNamespace::SortedTransformNameMap::SortedTransformNameMap(CrcStringVector const &transformNames) :
+	TransformNameMap(),
+	m_transformNames(transformNames)
+{
+}
+
+// ----------------------------------------------------------------------
+
+void AnimationRecompressorNamespace::SortedTransformNameMap::findTransformIndex(CrcString const &name, int *transformIndex, bool *found) const
+{
+	NOT_NULL(transformIndex);
+	NOT_NULL(found);
+
+	CrcStringVector::const_iterator const it = std::lower_bound(m_transformNames.begin(), m_transformNames.end(), &name, LessCrcStringPointer());
+
+	*found          = (it != m_transformNames.end()) && (**it == name);
+	*transformIndex = *found ? static_cast<int>(std::distance(m_transformNames.begin(), it)) : -1;
+}
+
+// ----------------------------------------------------------------------
+
+int AnimationRecompressorNamespace::SortedTransformNameMap::getTransformIndex(CrcString const &name) const
+{
+	int  transformIndex = -1;
+	bool found          = false;
+
+	findTransformIndex(name, &transformIndex, &found);
+	FATAL(!found, ("transform [%s] is not in the animation.", name.getString()));
+
+	return transformIndex;
+}
+
+// ----------------------------------------------------------------------
+
+int AnimationRecompressorNamespace::SortedTransformNameMap::getTransformCount() const
+{
+	return static_cast<int>(m_transformNames.size());
+}
+
+// ----------------------------------------------------------------------
+
+CrcString const &AnimationRecompressorNamespace::SortedTransformNameMap::getTransformName(int index) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, index, getTransformCount());
+	return *m_transformNames[static_cast<CrcStringVector::size_type>(index)];
+}
+
+// ======================================================================
+// namespace AnimationRecompressorNamespace
+// ======================================================================
+
+bool AnimationRecompressorNamespace::readChomp(FILE *file, char *buffer, size_t bufferLength)
+{
+	char const *const resultString = fgets(buffer, static_cast<int>(bufferLength), file);
+	if (!resultString)
+		return false;
+
+	// Chop off trailing newline if present.
+	size_t const readLength = strlen(buffer);
+	if ((readLength > 0) && (buffer[readLength - 1] == '\n'))
+		buffer[readLength - 1] = '\0';
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Gather what the recompressed file needs from a CKAT or KFAT template.
+ *
+ * Transform names come back sorted by CrcString, the order the QKAT loader
+ * expects.  Messages keep the source message order.
+ */
+
+template <typename SourceTemplate>
+void AnimationRecompressorNamespace::collectSourceInfo(SourceTemplate const &sourceTemplate, float &framesPerSecond, int &frameCount, CrcStringVector &transformNames, MessageInfoVector &messages)
+{
+	framesPerSecond = sourceTemplate.getFramesPerSecond();
+	frameCount      = sourceTemplate.getFrameCount();
+
+	//-- Collect the transform names.
+	int const transformCount = sourceTemplate.getTransformCount();
+
+	transformNames.clear();
+	transformNames.reserve(static_cast<CrcStringVector::size_type>(transformCount));
+
+	for (int i = 0; i < transformCount; ++i)
+		transformNames.push_back(&sourceTemplate.getName(sourceTemplate.getTransformInfo(i)));
+
+	std::sort(transformNames.begin(), transformNames.end(), LessCrcStringPointer());
+
+	//-- Collect every signal over the whole animation.
+	int const messageCount = sourceTemplate.getMessageCount();
+
+	messages.clear();
+	messages.resize(static_cast<MessageInfoVector::size_type>(messageCount));
+
+	for (int i = 0; i < messageCount; ++i)
+		messages[static_cast<MessageInfoVector::size_type>(i)].m_name = sourceTemplate.getMessageName(i).getString();
+
+	IntVector   signaledMessageIndices;
+	FloatVector signaledMessageFrameNumbers;
+
+	sourceTemplate.getSignaledMessages(0, frameCount + 1, signaledMessageIndices, signaledMessageFrameNumbers);
+
+	for (IntVector::size_type i = 0; i < signaledMessageIndices.size(); ++i)
+	{
+		int const messageIndex = signaledMessageIndices[i];
+		VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, messageIndex, messageCount);
+
+		messages[static_cast<MessageInfoVector::size_type>(messageIndex)].m_frameNumbers.push_back(static_cast<int>(signaledMessageFrameNumbers[i]));
+	}
+}
+
+// ----------------------------------------------------------------------
+
+void AnimationRecompressorNamespace::evaluatePose(SkeletalAnimation &animation, float frameNumber, Quaternion *rotations, Vector *translations)
+{
+	float const playbackFramesPerSecond = animation.getPlaybackFramesPerSecond();
+
+	SkeletalAnimation *replacementAnimation = 0;
+	float              deltaTimeRemaining   = 0.0f;
+
+	animation.startNewCycle();
+	IGNORE_RETURN(animation.alterSingleCycle((playbackFramesPerSecond > 0.0f) ? frameNumber / playbackFramesPerSecond : 0.0f, replacementAnimation, deltaTimeRemaining));
+	animation.evaluateAllTransformComponents(rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Sample every transform component of an animation once per frame.
+ *
+ * The samples are stored component-major: all samples of component n precede
+ * those of component n + 1.  Each rotation is kept in the same hemisphere as
+ * its previous sample so interpolating neighbouring samples takes the short
+ * way round.
+ */
+
+void AnimationRecompressorNamespace::sampleComponents(SkeletalAnimation &animation, int transformCount, int sampleCount, FloatVector &samples)
+{
+	QuaternionVector rotations(static_cast<QuaternionVector::size_type>(transformCount));
+	VectorVector     translations(static_cast<VectorVector::size_type>(transformCount));
+
+	samples.assign(static_cast<FloatVector::size_type>(transformCount * cs_componentCount * sampleCount), 0.0f);
+
+	for (int sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
+	{
+		evaluatePose(animation, static_cast<float>(sampleIndex), &rotations[0], &translations[0]);
+
+		for (int transformIndex = 0; transformIndex < transformCount; ++transformIndex)
+		{
+			float *const components = &samples[static_cast<FloatVector::size_type>(transformIndex * cs_componentCount * sampleCount + sampleIndex)];
+
+			Quaternion rotation = rotations[static_cast<QuaternionVector::size_type>(transformIndex)];
+			if (sampleIndex > 0)
+			{
+				Quaternion const previousRotation(components[QKAT::C_rotationW * sampleCount - 1], components[QKAT::C_rotationX * sampleCount - 1], components[QKAT::C_rotationY * sampleCount - 1], components[QKAT::C_rotationZ * sampleCount - 1]);
+				if (previousRotation.dot(rotation) < 0.0f)
+					rotation = Quaternion(-rotation.w, -rotation.x, -rotation.y, -rotation.z);
+			}
+
+			Vector const &translation = translations[static_cast<VectorVector::size_type>(transformIndex)];
+
+			components[QKAT::C_rotationW    * sampleCount] = rotation.w;
+			components[QKAT::C_rotationX    * sampleCount] = rotation.x;
+			components[QKAT::C_rotationY    * sampleCount] = rotation.y;
+			components[QKAT::C_rotationZ    * sampleCount] = rotation.z;
+			components[QKAT::C_translationX * sampleCount] = translation.x;
+			components[QKAT::C_translationY * sampleCount] = translation.y;
+			components[QKAT::C_translationZ * sampleCount] = translation.z;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Pick the cheapest track that reproduces every sample within tolerance.
+ *
+ * @return  false if even the 16-bit track cannot; track is then left as
+ *          the 16-bit track that came closest.
+ */
+
+bool AnimationRecompressorNamespace::buildTrack(float const *values, int sampleCount, float tolerance, Track &track)
+{
+	NOT_NULL(values);
+	DEBUG_FATAL(sampleCount < 1, ("bad sample count %d", sampleCount));
+
+	float const minimum = *std::min_element(values, values + sampleCount);
+	float const maximum = *std::max_element(values, values + sampleCount);
+	float const range   = maximum - minimum;
+
+	//-- Constant: the midpoint is within half the range of every sample.
+	if (range * 0.5f <= tolerance)
+	{
+		track.m_type   = static_cast<uint8>(QKAT::TT_constant);
+		track.m_value0 = minimum + range * 0.5f;
+		track.m_value1 = 0.0f;
+		return true;
+	}
+
+	//-- Linear: the line through the first and last sample passes close to all others.
+	if (sampleCount > 1)
+	{
+		float const deltaPerFrame = (values[sampleCount - 1] - values[0]) / static_cast<float>(sampleCount - 1);
+
+		bool fits = true;
+		for (int i = 1; fits && (i < sampleCount - 1); ++i)
+			fits = (fabs(values[0] + deltaPerFrame * static_cast<float>(i) - values[i]) <= tolerance);
+
+		if (fits)
+		{
+			track.m_type   = static_cast<uint8>(QKAT::TT_linear);
+			track.m_value0 = values[0];
+			track.m_value1 = deltaPerFrame;
+			return true;
+		}
+	}
+
+	//-- Quantized: rounding to the nearest step is off by at most half a step.
+	track.m_value0 = minimum;
+
+	if (range / static_cast<float>(2 * cs_narrowSampleMax) <= tolerance)
+	{
+		track.m_type   = static_cast<uint8>(QKAT::TT_narrow);
+		track.m_value1 = range / static_cast<float>(cs_narrowSampleMax);
+		return true;
+	}
+
+	track.m_type   = static_cast<uint8>(QKAT::TT_wide);
+	track.m_value1 = range / static_cast<float>(cs_wideSampleMax);
+
+	return range / static_cast<float>(2 * cs_wideSampleMax) <= tolerance;
+}
+
+// ----------------------------------------------------------------------
+
+int AnimationRecompressorNamespace::quantize(float value, Track const &track, int maximumSample)
+{
+	if (track.m_value1 <= 0.0f)
+		return 0;
+
+	double const step = floor(static_cast<double>((value - track.m_value0) / track.m_value1) + 0.5);
+	return static_cast<int>(clamp(0.0, step, static_cast<double>(maximumSample)));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Build the QKAT file for the sampled animation.
+ *
+ * @return  false, with nothing written, if some component spans too wide a
+ *          range for the 16-bit track to stay within tolerance.
+ */
+
+bool AnimationRecompressorNamespace::writeRecompressedIff(Iff &sourceIff, float framesPerSecond, int frameCount, CrcStringVector const &transformNames, FloatVector const &samples, MessageInfoVector const &messages, Iff &outputIff)
+{
+	int const transformCount = static_cast<int>(transformNames.size());
+	int const componentCount = transformCount * cs_componentCount;
+	int const sampleCount    = frameCount + 1;
+
+	//-- Choose a track for every component.  Track indices are numbered in order of appearance.
+	TrackVector tracks(static_cast<TrackVector::size_type>(componentCount));
+	IntVector   trackIndices(static_cast<IntVector::size_type>(componentCount), -1);
+
+	int trackCounts[QKAT::TT_wide + 1] = { 0, 0, 0, 0 };
+
+	for (int componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+	{
+		bool const  isRotation = ((componentIndex % cs_componentCount) < QKAT::C_translationX);
+		float const tolerance  = isRotation ? s_rotationTolerance : s_translationTolerance;
+
+		Track &track = tracks[static_cast<TrackVector::size_type>(componentIndex)];
+		if (!buildTrack(&samples[static_cast<FloatVector::size_type>(componentIndex * sampleCount)], sampleCount, tolerance, track))
+		{
+			DEBUG_REPORT_LOG(true, ("  component %d of [%s] changes by %.4f per 16-bit step, over twice the tolerance of %.5f.\n", componentIndex % cs_componentCount, transformNames[static_cast<CrcStringVector::size_type>(componentIndex / cs_componentCount)]->getString(), track.m_value1, tolerance));
+			return false;
+		}
+
+		trackIndices[static_cast<IntVector::size_type>(componentIndex)] = trackCounts[track.m_type]++;
+	}
+
+	for (int trackType = 0; trackType <= QKAT::TT_wide; ++trackType)
+		s_trackTypeCounts[trackType] += trackCounts[trackType];
+
+	int const narrowTrackCount = trackCounts[QKAT::TT_narrow];
+	int const wideTrackCount   = trackCounts[QKAT::TT_wide];
+
+	//-- Quantize the samples into frame-major rows.
+	Uint8Vector  narrowSamples(static_cast<Uint8Vector::size_type>(sampleCount * narrowTrackCount));
+	Uint16Vector wideSamples(static_cast<Uint16Vector::size_type>(sampleCount * wideTrackCount));
+
+	for (int componentIndex = 0; componentIndex < componentCount; ++componentIndex)
+	{
+		Track const &track      = tracks[static_cast<TrackVector::size_type>(componentIndex)];
+		int const    trackIndex = trackIndices[static_cast<IntVector::size_type>(componentIndex)];
+		float const *values     = &samples[static_cast<FloatVector::size_type>(componentIndex * sampleCount)];
+
+		if (track.m_type == QKAT::TT_narrow)
+		{
+			for (int sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
+				narrowSamples[static_cast<Uint8Vector::size_type>(sampleIndex * narrowTrackCount + trackIndex)] = static_cast<uint8>(quantize(values[sampleIndex], track, cs_narrowSampleMax));
+		}
+		else if (track.m_type == QKAT::TT_wide)
+		{
+			for (int sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
+				wideSamples[static_cast<Uint16Vector::size_type>(sampleIndex * wideTrackCount + trackIndex)] = static_cast<uint16>(quantize(values[sampleIndex], track, cs_wideSampleMax));
+		}
+	}
+
+	//-- Write the file.
+	outputIff.insertForm(TAG_QKAT);
+		outputIff.insertForm(TAG_0000);
+
+			outputIff.insertChunk(TAG_INFO);
+
+				outputIff.insertChunkData(framesPerSecond);
+				outputIff.insertChunkData(static_cast<int16>(frameCount));
+				outputIff.insertChunkData(static_cast<int16>(transformCount));
+				outputIff.insertChunkData(static_cast<int16>(trackCounts[QKAT::TT_linear]));
+				outputIff.insertChunkData(static_cast<int16>(narrowTrackCount));
+				outputIff.insertChunkData(static_cast<int16>(wideTrackCount));
+
+			outputIff.exitChunk(TAG_INFO);
+
+			outputIff.insertChunk(TAG_XFRM);
+
+				for (int transformIndex = 0; transformIndex < transformCount; ++transformIndex)
+				{
+					outputIff.insertChunkString(transformNames[static_cast<CrcStringVector::size_type>(transformIndex)]->getString());
+
+					for (int component = 0; component < cs_componentCount; ++component)
+					{
+						Track const &track = tracks[static_cast<TrackVector::size_type>(transformIndex * cs_componentCount + component)];
+
+						outputIff.insertChunkData(track.m_type);
+						outputIff.insertChunkData(track.m_value0);
+						if (track.m_type != QKAT::TT_constant)
+							outputIff.insertChunkData(track.m_value1);
+					}
+				}
+
+			outputIff.exitChunk(TAG_XFRM);
+
+			if (narrowTrackCount > 0)
+			{
+				outputIff.insertChunk(TAG_NSMP);
+					outputIff.insertChunkArray(&narrowSamples[0], static_cast<int>(narrowSamples.size()));
+				outputIff.exitChunk(TAG_NSMP);
+			}
+
+			if (wideTrackCount > 0)
+			{
+				outputIff.insertChunk(TAG_WSMP);
+					outputIff.insertChunkArray(&wideSamples[0], static_cast<int>(wideSamples.size()));
+				outputIff.exitChunk(TAG_WSMP);
+			}
+
+			writeMessages(messages, outputIff);
+			copyLocomotion(sourceIff, outputIff);
+
+		outputIff.exitForm(TAG_0000);
+	outputIff.exitForm(TAG_QKAT);
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+void AnimationRecompressorNamespace::writeMessages(MessageInfoVector const &messages, Iff &outputIff)
+{
+	//-- Messages that are never signaled carry no information.
+	int signaledMessageCount = 0;
+
+	MessageInfoVector::const_iterator const endIt = messages.end();
+	for (MessageInfoVector::const_iterator it = messages.begin(); it != endIt; ++it)
+	{
+		if (!it->m_frameNumbers.empty())
+			++signaledMessageCount;
+	}
+
+	if (signaledMessageCount < 1)
+		return;
+
+	outputIff.insertForm(TAG_MSGS);
+
+		outputIff.insertChunk(TAG_INFO);
+			outputIff.insertChunkData(static_cast<int16>(signaledMessageCount));
+		outputIff.exitChunk(TAG_INFO);
+
+		for (MessageInfoVector::const_iterator it = messages.begin(); it != endIt; ++it)
+		{
+			if (it->m_frameNumbers.empty())
+				continue;
+
+			outputIff.insertChunk(TAG_MESG);
+
+				outputIff.insertChunkData(static_cast<int16>(it->m_frameNumbers.size()));
+				outputIff.insertChunkString(it->m_name.c_str());
+
+				IntVector::const_iterator const frameEndIt = it->m_frameNumbers.end();
+				for (IntVector::const_iterator frameIt = it->m_frameNumbers.begin(); frameIt != frameEndIt; ++frameIt)
+					outputIff.insertChunkData(static_cast<int16>(*frameIt));
+
+			outputIff.exitChunk(TAG_MESG);
+		}
+
+	outputIff.exitForm(TAG_MSGS);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Copy the locomotion keys of a CKAT 0001 or KFAT 0003 file.
+ *
+ * LOCT has the same layout in all three formats and is copied verbatim.
+ * KFAT LOCR is copied verbatim; the CKAT QCHN locomotion channel is expanded
+ * back to full quaternions.
+ */
+
+void AnimationRecompressorNamespace::copyLocomotion(Iff &sourceIff, Iff &outputIff)
+{
+	Tag const sourceTag = sourceIff.getCurrentName();
+	sourceIff.enterForm(sourceTag);
+
+	Tag const versionTag = sourceIff.getCurrentName();
+	sourceIff.enterForm(versionTag);
+
+		while (!sourceIff.atEndOfForm())
+		{
+			Tag const blockName = sourceIff.getCurrentName();
+
+			if (sourceIff.isCurrentForm() || ((blockName != TAG_LOCT) && (blockName != TAG_LOCR) && (blockName != TAG_QCHN)))
+			{
+				IGNORE_RETURN(sourceIff.goForward());
+				continue;
+			}
+
+			sourceIff.enterChunk(blockName);
+
+				if (blockName == TAG_QCHN)
+				{
+					outputIff.insertChunk(TAG_LOCR);
+
+						int const   keyCount = static_cast<int>(sourceIff.read_int16());
+						uint8 const xFormat  = sourceIff.read_uint8();
+						uint8 const yFormat  = sourceIff.read_uint8();
+						uint8 const zFormat  = sourceIff.read_uint8();
+
+						outputIff.insertChunkData(static_cast<int16>(keyCount));
+
+						for (int i = 0; i < keyCount; ++i)
+						{
+							outputIff.insertChunkData(sourceIff.read_int16());
+							outputIff.insertChunkFloatQuaternion(CompressedQuaternion(sourceIff.read_uint32()).expand(xFormat, yFormat, zFormat));
+						}
+
+					outputIff.exitChunk(TAG_LOCR);
+				}
+				else
+				{
+					outputIff.insertChunk(blockName);
+
+						while (sourceIff.getChunkLengthLeft(1))
+							outputIff.insertChunkData(sourceIff.read_uint8());
+
+					outputIff.exitChunk(blockName);
+				}
+
+			sourceIff.exitChunk(blockName);
+		}
+
+	sourceIff.exitForm(versionTag);
+	sourceIff.exitForm(sourceTag);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Find the worst rotation and translation error between two animations.
+ *
+ * Both are evaluated on the same transform name map, at every frame and
+ * halfway between frames so interpolation error is included.
+ */
+
+void AnimationRecompressorNamespace::compareAnimations(SkeletalAnimation &sourceAnimation, SkeletalAnimation &recompressedAnimation, int transformCount, int frameCount, float &maxRotationErrorDegrees, int &maxRotationErrorTransform, float &maxTranslationError, int &maxTranslationErrorTransform)
+{
+	QuaternionVector sourceRotations(static_cast<QuaternionVector::size_type>(transformCount));
+	VectorVector     sourceTranslations(static_cast<VectorVector::size_type>(transformCount));
+	QuaternionVector recompressedRotations(static_cast<QuaternionVector::size_type>(transformCount));
+	VectorVector     recompressedTranslations(static_cast<VectorVector::size_type>(transformCount));
+
+	maxRotationErrorDegrees      = 0.0f;
+	maxRotationErrorTransform    = 0;
+	maxTranslationError          = 0.0f;
+	maxTranslationErrorTransform = 0;
+
+	for (int step = 0; step <= 2 * frameCount; ++step)
+	{
+		float const frameNumber = 0.5f * static_cast<float>(step);
+
+		evaluatePose(sourceAnimation, frameNumber, &sourceRotations[0], &sourceTranslations[0]);
+		evaluatePose(recompressedAnimation, frameNumber, &recompressedRotations[0], &recompressedTranslations[0]);
+
+		for (int i = 0; i < transformCount; ++i)
+		{
+			QuaternionVector::size_type const index = static_cast<QuaternionVector::size_type>(i);
+
+			float const cosHalfAngle = std::min(1.0f, static_cast<float>(fabs(sourceRotations[index].dot(recompressedRotations[index]))));
+			float const rotationErrorDegrees = convertRadiansToDegrees(2.0f * acos(cosHalfAngle));
+			if (rotationErrorDegrees > maxRotationErrorDegrees)
+			{
+				maxRotationErrorDegrees   = rotationErrorDegrees;
+				maxRotationErrorTransform = i;
+			}
+
+			float const translationError = sourceTranslations[index].magnitudeBetween(recompressedTranslations[index]);
+			if (translationError > maxTranslationError)
+			{
+				maxTranslationError          = translationError;
+				maxTranslationErrorTransform = i;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Return the average time in microseconds to evaluate one pose.
+ */
+
+float AnimationRecompressorNamespace::timePoseEvaluation(SkeletalAnimation &animation, int transformCount, int frameCount)
+{
+	QuaternionVector rotations(static_cast<QuaternionVector::size_type>(transformCount));
+	VectorVector     translations(static_cast<VectorVector::size_type>(transformCount));
+
+	PerformanceTimer timer;
+	timer.start();
+
+		for (int i = 0; i < cs_timingPoseCount; ++i)
+			evaluatePose(animation, static_cast<float>(frameCount * i) / static_cast<float>(cs_timingPoseCount), &rotations[0], &translations[0]);
+
+	timer.stop();
+
+	return timer.getElapsedTime() * 1.0e6f / static_cast<float>(cs_timingPoseCount);
+}
+
+// ----------------------------------------------------------------------
+
+void AnimationRecompressorNamespace::recompressFile(char const *pathname, std::string const &outputDirectory)
+{
+	NOT_NULL(pathname);
+
+	//-- The recompressed file keeps the source's filename in the output directory.
+	char const *filename = pathname;
+	for (char const *c = pathname; *c; ++c)
+	{
+		if ((*c == '\\') || (*c == '/'))
+			filename = c + 1;
+	}
+
+	std::string const outputPathname = outputDirectory + filename;
+	FATAL(_stricmp(outputPathname.c_str(), pathname) == 0, ("output file [%s] would overwrite its source, use a different output directory.", outputPathname.c_str()));
+
+	Iff sourceIff(pathname);
+
+	Tag const sourceTag = sourceIff.getCurrentName();
+	if ((sourceTag != TAG_CKAT) && (sourceTag != TAG_KFAT))
+	{
+		DEBUG_REPORT_LOG(true, ("SKIPPING:%s (not a CKAT or KFAT animation)\n", pathname));
+		++s_skipCount;
+		return;
+	}
+
+	//-- Load the source animation.
+	SkeletalAnimationTemplate const *const sourceTemplate = SkeletalAnimationTemplateList::fetch(CrcLowerString(pathname));
+	NOT_NULL(sourceTemplate);
+
+	float             framesPerSecond = 0.0f;
+	int               frameCount      = 0;
+	CrcStringVector   transformNames;
+	MessageInfoVector messages;
+	int               sourceResidentBytes = 0;
+
+	CompressedKeyframeAnimationTemplate const *const compressedTemplate = dynamic_cast<CompressedKeyframeAnimationTemplate const*>(sourceTemplate);
+	KeyframeSkeletalAnimationTemplate const *const   keyframeTemplate   = dynamic_cast<KeyframeSkeletalAnimationTemplate const*>(sourceTemplate);
+
+	if (compressedTemplate)
+	{
+		collectSourceInfo(*compressedTemplate, framesPerSecond, frameCount, transformNames, messages);
+		sourceResidentBytes = compressedTemplate->getResidentByteCount();
+	}
+	else if (keyframeTemplate)
+		collectSourceInfo(*keyframeTemplate, framesPerSecond, frameCount, transformNames, messages);
+
+	int const transformCount = static_cast<int>(transformNames.size());
+	if (transformCount < 1)
+	{
+		DEBUG_REPORT_LOG(true, ("SKIPPING:%s (no transforms)\n", pathname));
+		++s_skipCount;
+		sourceTemplate->release();
+		return;
+	}
+
+	//-- Sample the source animation once per frame.
+	SortedTransformNameMap const transformNameMap(transformNames);
+
+	AnimationEnvironment animationEnvironment;
+	animationEnvironment.getFloat(AnimationEnvironmentNames::cms_appearanceScale) = 1.0f;
+
+	SkeletalAnimation *const sourceAnimation = sourceTemplate->fetchSkeletalAnimation(animationEnvironment, transformNameMap);
+	NOT_NULL(sourceAnimation);
+
+	FloatVector samples;
+	sampleComponents(*sourceAnimation, transformCount, frameCount + 1, samples);
+
+	//-- Write the recompressed file.  A clip that can't meet the error bound keeps its source format.
+	Iff outputIff(sourceIff.getRawDataSize());
+	if (!writeRecompressedIff(sourceIff, framesPerSecond, frameCount, transformNames, samples, messages, outputIff))
+	{
+		DEBUG_REPORT_LOG(true, ("SKIPPING:%s (a track exceeds the error tolerance even with 16-bit samples; kept the source format)\n", pathname));
+		++s_skipCount;
+		sourceAnimation->release();
+		sourceTemplate->release();
+		return;
+	}
+
+	bool const success = outputIff.write(outputPathname.c_str());
+	FATAL(!success, ("failed to write animation file [%s].", outputPathname.c_str()));
+
+	//-- Reload the new file and measure it against the source.
+	Iff recompressedIff(outputPathname.c_str());
+
+	SkeletalAnimationTemplate const *const recompressedTemplate = SkeletalAnimationTemplateList::fetch(recompressedIff);
+	NOT_NULL(recompressedTemplate);
+
+	QKAT const *const quantizedTemplate = dynamic_cast<QKAT const*>(recompressedTemplate);
+	NOT_NULL(quantizedTemplate);
+
+	SkeletalAnimation *const recompressedAnimation = recompressedTemplate->fetchSkeletalAnimation(animationEnvironment, transformNameMap);
+	NOT_NULL(recompressedAnimation);
+
+	float maxRotationErrorDegrees      = 0.0f;
+	int   maxRotationErrorTransform    = 0;
+	float maxTranslationError          = 0.0f;
+	int   maxTranslationErrorTransform = 0;
+
+	compareAnimations(*sourceAnimation, *recompressedAnimation, transformCount, frameCount, maxRotationErrorDegrees, maxRotationErrorTransform, maxTranslationError, maxTranslationErrorTransform);
+
+	float const sourceMicroseconds       = timePoseEvaluation(*sourceAnimation, transformCount, frameCount);
+	float const recompressedMicroseconds = timePoseEvaluation(*recompressedAnimation, transformCount, frameCount);
+
+	int const sourceFileBytes             = sourceIff.getRawDataSize();
+	int const recompressedFileBytes       = outputIff.getRawDataSize();
+	int const recompressedResidentBytes   = quantizedTemplate->getResidentByteCount();
+
+	DEBUG_REPORT_LOG(true, ("  file bytes %d -> %d, resident bytes %d -> %d, pose time %.2f -> %.2f us.\n", sourceFileBytes, recompressedFileBytes, sourceResidentBytes, recompressedResidentBytes, sourceMicroseconds, recompressedMicroseconds));
+	DEBUG_REPORT_LOG(true, ("  max rotation error %.4f degrees at [%s], max translation error %.5f at [%s].\n", maxRotationErrorDegrees, transformNames[static_cast<CrcStringVector::size_type>(maxRotationErrorTransform)]->getString(), maxTranslationError, transformNames[static_cast<CrcStringVector::size_type>(maxTranslationErrorTransform)]->getString()));
+
+	++s_convertedCount;
+
+	s_totalSourceFileBytes           += sourceFileBytes;
+	s_totalRecompressedFileBytes     += recompressedFileBytes;
+	s_totalSourceResidentBytes       += sourceResidentBytes;
+	s_totalRecompressedResidentBytes += recompressedResidentBytes;
+
+	s_worstRotationErrorDegrees = std::max(s_worstRotationErrorDegrees, maxRotationErrorDegrees);
+	s_worstTranslationError     = std::max(s_worstTranslationError, maxTranslationError);
+
+	//-- Cleanup.
+	recompressedAnimation->release();
+	recompressedTemplate->release();
+
+	sourceAnimation->release();
+	sourceTemplate->release();
+}
+
+// ======================================================================
+
+void AnimationRecompressor::recompressAnimations(char const *responseFilename)
+{
+	DEBUG_REPORT_LOG(true, ("AnimationRecompression: START.\n"));
+
+	// input response file format:
+	//   full path to output directory, including trailing backslash.
+	//   [repeat 1..number of animation files to convert]
+	//     full path to CKAT or KFAT animation file; the QKAT version is written to the output directory under the same filename.
+
+	s_rotationTolerance    = ConfigFile::getKeyFloat("ClientSkeletalAnimation", "recompressionRotationTolerance", 0.0005f);
+	s_translationTolerance = ConfigFile::getKeyFloat("ClientSkeletalAnimation", "recompressionTranslationTolerance", 0.0005f);
+
+	s_convertedCount                 = 0;
+	s_skipCount                      = 0;
+	s_totalSourceFileBytes           = 0;
+	s_totalRecompressedFileBytes     = 0;
+	s_totalSourceResidentBytes       = 0;
+	s_totalRecompressedResidentBytes = 0;
+	s_worstRotationErrorDegrees      = 0.0f;
+	s_worstTranslationError          = 0.0f;
+
+	for (int i = 0; i <= QKAT::TT_wide; ++i)
+		s_trackTypeCounts[i] = 0;
+
+	//-- Evaluate exact frames; the pose cache would snap them and hide the error being measured.
+	bool const poseCacheWasEnabled = PoseCache::isEnabled();
+	PoseCache::setEnabled(false);
+
+	//-- Open the response file.
+	FILE *const responseFile = fopen(responseFilename, "r");
+	FATAL(!responseFile, ("failed to open response file [%s].", responseFilename));
+
+	//-- Tell TreeFile system we want to enable full pathname loading.
+	TreeFile::addSearchAbsolute(1024);
+
+	//-- Load the output directory and input filenames first so we can print out completion percentage.
+	typedef std::vector<std::string>  StringVector;
+	StringVector                      inputFilenameVector;
+	std::string                       outputDirectory;
+
+	{
+		char sourcePathname[2 * MAX_PATH];
+
+		if (readChomp(responseFile, sourcePathname, sizeof(sourcePathname)))
+			outputDirectory = sourcePathname;
+
+		FATAL(outputDirectory.empty(), ("response file [%s] does not start with an output directory.", responseFilename));
+
+		char const lastCharacter = outputDirectory[outputDirectory.length() - 1];
+		if ((lastCharacter != '\\') && (lastCharacter != '/'))
+			outputDirectory += '\\';
+
+		while (readChomp(responseFile, sourcePathname, sizeof(sourcePathname)))
+		{
+			if (sourcePathname[0] != '\0')
+				inputFilenameVector.push_back(sourcePathname);
+		}
+	}
+
+	fclose(responseFile);
+
+	//-- Do the recompression for each file.
+	int const sourceCount = static_cast<int>(inputFilenameVector.size());
+
+	for (int i = 0; i < sourceCount; ++i)
+	{
+		char const *const inputPathname = inputFilenameVector[static_cast<StringVector::size_type>(i)].c_str();
+
+		DEBUG_REPORT_LOG(true, ("Recompressing [%s] (%.2f %% of total %d files complete).\n", inputPathname, 100.0f * static_cast<float>(i) / static_cast<float>(sourceCount), sourceCount));
+		recompressFile(inputPathname, outputDirectory);
+	}
+
+	DEBUG_REPORT_LOG(true, ("  Track usage: constant %d, linear %d, narrow %d, wide %d.\n", s_trackTypeCounts[QKAT::TT_constant], s_trackTypeCounts[QKAT::TT_linear], s_trackTypeCounts[QKAT::TT_narrow], s_trackTypeCounts[QKAT::TT_wide]));
+	DEBUG_REPORT_LOG(true, ("  Total file bytes %d -> %d, resident bytes %d -> %d (resident source bytes are only known for CKAT).\n", s_totalSourceFileBytes, s_totalRecompressedFileBytes, s_totalSourceResidentBytes, s_totalRecompressedResidentBytes));
+	DEBUG_REPORT_LOG(true, ("  Worst rotation error %.4f degrees, worst translation error %.5f.\n", s_worstRotationErrorDegrees, s_worstTranslationError));
+
+	PoseCache::setEnabled(poseCacheWasEnabled);
+
+	DEBUG_REPORT_LOG(true, ("AnimationRecompression: END (%d converted, %d skipped).\n", s_convertedCount, s_skipCount));
+}
+
+// ======================================================================
+
+#endif
+
+namespace
+{
+void suppress_warning_LNK4221_AnimationRecompressor()
+{
+}
+}
+
+// ======================================================================
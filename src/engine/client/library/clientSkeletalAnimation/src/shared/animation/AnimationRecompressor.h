@@ -0,0 +1,37 @@
+// ======================================================================
+//
+// AnimationRecompressor.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_AnimationRecompressor_H
+#define INCLUDED_AnimationRecompressor_H
+
+// ======================================================================
+
+#ifdef _DEBUG
+
+/**
+ * Converts CKAT and KFAT keyframe animations into the quantized QKAT format.
+ * The converted files are written to an output directory and the sources
+ * are left untouched.
+ *
+ * Each converted animation is reloaded and compared against its source, and
+ * the worst joint error, pose evaluation time and memory use of both are
+ * logged.
+ */
+
+class AnimationRecompressor
+{
+public:
+
+	static void recompressAnimations(char const *responseFilename);
+
+};
+
+#endif
+
+// ======================================================================
+
+#endif
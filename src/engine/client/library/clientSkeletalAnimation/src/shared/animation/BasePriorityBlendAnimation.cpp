@@ -234,6 +234,38 @@ void BasePriorityBlendAnimation::evaluateTransformComponents(int index, Quaterni
 	}
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Only a blender that plays one of its animations for every transform
+ * can share its pose; mid-blend poses depend on per-transform blend state.
+ */
+
+bool BasePriorityBlendAnimation::addPoseCacheKey(PoseCache::Key &key) const
+{
+	int const animationIndex = getPoseCacheAnimationIndex();
+	if (animationIndex < 0)
+		return false;
+
+	SkeletalAnimation const *const animation = getAnimation(animationIndex);
+	return animation && animation->addPoseCacheKey(key);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * A cached pose is the pose of the animation played for every transform.
+ */
+
+void BasePriorityBlendAnimation::receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations)
+{
+	int const animationIndex = getPoseCacheAnimationIndex();
+	if (animationIndex < 0)
+		return;
+
+	SkeletalAnimation *const animation = getAnimation(animationIndex);
+	if (animation)
+		animation->receiveCachedPose(transformCount, rotations, translations);
+}
+
 // ----------------------------------------------------------------------
 
 int BasePriorityBlendAnimation::getTransformPriority(int index) const
@@ -490,6 +522,24 @@ bool BasePriorityBlendAnimation::allBlendStatesMatch(BlendState blendState) cons
 	return true;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Get the index of the animation played for every transform.
+ *
+ * @return  0 or 1 when one animation is played for every transform, -1
+ *          while any transform is blending or plays the other animation.
+ */
+
+int BasePriorityBlendAnimation::getPoseCacheAnimationIndex() const
+{
+	if (allBlendStatesMatch(BS_playA))
+		return 0;
+	else if (allBlendStatesMatch(BS_playB))
+		return 1;
+	else
+		return -1;
+}
+
 // ======================================================================
 // class BasePriorityBlendAnimation: PRIVATE
 // ======================================================================
@@ -42,6 +42,8 @@ public:
 
 	virtual int                      getTransformCount() const;
 	virtual void                     evaluateTransformComponents(int index, Quaternion &rotation, Vector &translation);
+	virtual bool                     addPoseCacheKey(PoseCache::Key &key) const;
+	virtual void                     receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations);
 
 	virtual int                      getTransformPriority(int index) const;
 	virtual int                      getLocomotionPriority() const;
@@ -77,6 +79,7 @@ protected:
 	virtual void                     doEvaluateTransformComponents(int animationIndex, int transformIndex, Quaternion &rotation, Vector &translation);
 
 	virtual bool                     allBlendStatesMatch(BlendState blendState) const;
+	int                              getPoseCacheAnimationIndex() const;
 
 private:
 
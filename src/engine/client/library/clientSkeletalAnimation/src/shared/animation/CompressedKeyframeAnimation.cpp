@@ -9,26 +9,20 @@
 #include "clientSkeletalAnimation/FirstClientSkeletalAnimation.h"
 #include "clientSkeletalAnimation/CompressedKeyframeAnimation.h"
 
-#include "clientGraphics/GraphicsDebugFlags.h"
 #include "clientSkeletalAnimation/AnimationEnvironment.h"
 #include "clientSkeletalAnimation/AnimationEnvironmentNames.h"
 #include "clientSkeletalAnimation/TransformNameMap.h"
 #include "clientSkeletalAnimation/CompressedKeyframeAnimationTemplate.h"
+#include "clientSkeletalAnimation/PoseCache.h"
 #include "sharedDebug/DebugFlags.h"
 #include "sharedDebug/Profiler.h"
-#include "sharedFoundation/ConstCharCrcLowerString.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/MemoryBlockManager.h"
-#include "sharedFoundation/MemoryBlockManagerMacros.h"
-#include "sharedFoundation/PointerDeleter.h"
-#include "sharedFoundation/VoidMemberFunction.h"
 #include "sharedMath/Quaternion.h"
 #include "sharedMath/Vector.h"
 
 #include <algorithm>
-#include <map>
 #include <vector>
-#include <cstdio>
 
 // ======================================================================
 // lint supression
@@ -46,68 +40,59 @@ MemoryBlockManager *CompressedKeyframeAnimation::ms_skeletalAnimationMemoryBlock
 bool                              CompressedKeyframeAnimation::ms_testInvariants;
 
 // ======================================================================
-
-class CompressedKeyframeAnimation::QuaternionOperation
-{
-public:
-
-	virtual      ~QuaternionOperation();
-	virtual void  evaluateCurrentTime(float animationFrameNumber, Quaternion &result) const = 0;
-
-};
-
+// class CompressedKeyframeAnimation::ChannelData
 // ======================================================================
+/**
+ * The channels of the animation, laid out as parallel arrays so that every
+ * channel can be evaluated in one pass.
+ *
+ * Transforms that are not animated (and the non-animated components of
+ * animated translations) take their values from the static pose.  The
+ * animated channels then overwrite the entries of their transform.
+ */
 
-class CompressedKeyframeAnimation::StaticQuaternionOperation: public CompressedKeyframeAnimation::QuaternionOperation
+struct CompressedKeyframeAnimation::ChannelData
 {
-	MEMORY_BLOCK_MANAGER_INTERFACE_WITH_INSTALL;
-
 public:
 
-	explicit StaticQuaternionOperation(const Quaternion &quaternion);
-	virtual void  evaluateCurrentTime(float animationFrameNumber, Quaternion &result) const;
-
-private:
+	typedef CompressedKeyframeAnimationTemplate::RotationChannel    RotationChannel;
+	typedef CompressedKeyframeAnimationTemplate::RealKeyDataVector  RealKeyDataVector;
 
-	// disabled
-	StaticQuaternionOperation();
+	typedef std::vector<int>                                         IntVector;
+	typedef std::vector<Quaternion>                                  QuaternionVector;
+	typedef std::vector<RealKeyDataVector const*>                    RealKeyDataVectorVector;
+	typedef std::vector<RotationChannel const*>                      RotationChannelVector;
+	typedef std::vector<Vector>                                      VectorVector;
 
-private:
-
-	Quaternion  m_quaternion;
-
-};
-
-// ======================================================================
-
-class CompressedKeyframeAnimation::VectorOperation
-{
 public:
 
-	virtual      ~VectorOperation();
-	virtual void  evaluateCurrentTime(float animationFrameNumber, Vector &result) const = 0;
-
-};
-
-// ======================================================================
-
-class CompressedKeyframeAnimation::StaticVectorOperation: public CompressedKeyframeAnimation::VectorOperation
-{
-	MEMORY_BLOCK_MANAGER_INTERFACE_WITH_INSTALL;
+	explicit ChannelData(int transformCount);
 
 public:
 
-	explicit StaticVectorOperation(const Vector &position);
-	virtual void  evaluateCurrentTime(float animationFrameNumber, Vector &result) const;
+	//-- Indexed by transform.
+	QuaternionVector         m_staticRotations;
+	VectorVector             m_staticTranslations;
+	IntVector                m_rotationChannelIndices;
+	IntVector                m_translationChannelIndices;
 
-private:
+	//-- Indexed by animated rotation channel.
+	RotationChannelVector    m_rotationChannels;
+	IntVector                m_rotationTransformIndices;
+	IntVector                m_rotationStartKeyIndices;
 
-	// disabled
-	StaticVectorOperation();
+	//-- Indexed by animated translation component channel.
+	RealKeyDataVectorVector  m_translationChannels;
+	IntVector                m_translationTransformIndices;
+	IntVector                m_translationComponents;
+	IntVector                m_translationStartKeyIndices;
 
 private:
 
-	Vector  m_vector;
+	// disabled
+	ChannelData();
+	ChannelData(ChannelData const &);
+	ChannelData &operator =(ChannelData const &);
 
 };
 
@@ -122,577 +107,59 @@ namespace CompressedKeyframeAnimationNamespace
 		C_xTranslation,
 		C_yTranslation,
 		C_zTranslation,
-		C_xRotation,
-		C_yRotation,
-		C_zRotation
-	};
-
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-	MemoryBlockManager *FindOrCreateMemoryBlockManager(size_t elementSize);
-
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-	class StaticEvaluator
-	{
-	public:
-		StaticEvaluator(Component component, const CompressedKeyframeAnimation &skeletalAnimation, const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfo);
-
-		real evaluate(float animationFrameNumber) const
-			{
-				UNREF(animationFrameNumber);
-				return m_value;
-			}
-
-	private:
-
-		real m_value;
-
-	private:
-		// disabled
-		StaticEvaluator();
-	};
-
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-	class KeyframeEvaluator
-	{
-	public:
-		KeyframeEvaluator(Component component, const CompressedKeyframeAnimation &skeletalAnimation, const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfo);
-		~KeyframeEvaluator();
-
-		real evaluate(float animationFrameNumber) const;
-
-	private:
-
-		const CompressedKeyframeAnimationTemplate::RealKeyDataVector *m_keyDataVector;
-		mutable int                                                 m_lastLowerKeyframeIndex;
-
-	private:
-		// disabled
-		KeyframeEvaluator();
-	};
-
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-	class KeyframeRotationOperation: public CompressedKeyframeAnimation::QuaternionOperation
-	{
-	private:
-
-		static MemoryBlockManager *ms_memoryBlockManager;
-
-	private:
-
-		const CompressedKeyframeAnimationTemplate::RotationChannel &m_rotationChannel;
-		mutable int                                                 m_lastLowerKeyframeIndex;
-
-	public:
-
-		static void install();
-		static void *operator new(size_t size);
-		static void  operator delete(void *data, size_t size);
-
-	public:
-
-		explicit KeyframeRotationOperation(const CompressedKeyframeAnimationTemplate::RotationChannel &rotationChannel);
-
-		virtual void evaluateCurrentTime(float animationFrameNumber, Quaternion &result) const;
-
-	private:
-
-		// disabled
-		KeyframeRotationOperation();
-		KeyframeRotationOperation(const KeyframeRotationOperation &);
-		KeyframeRotationOperation &operator =(const KeyframeRotationOperation&);
-
-	};
-
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-	template <class EvaluatorX, class EvaluatorY, class EvaluatorZ>
-	class KeyframeTranslationOperation: public CompressedKeyframeAnimation::VectorOperation
-	{
-	private:
-
-		static MemoryBlockManager *ms_memoryBlockManager;
-
-	private:
-
-		EvaluatorX                       m_xEvaluator;
-		EvaluatorY                       m_yEvaluator;
-		EvaluatorZ                       m_zEvaluator;
-
-	public:
-
-		static void install()
-			{
-				ms_memoryBlockManager = FindOrCreateMemoryBlockManager(sizeof(KeyframeTranslationOperation<EvaluatorX, EvaluatorY, EvaluatorZ>));
-			}
-
-		static void *operator new(size_t size)
-			{
-				UNREF(size);
-				NOT_NULL(ms_memoryBlockManager);
-				DEBUG_FATAL(size != sizeof(KeyframeTranslationOperation<EvaluatorX, EvaluatorY, EvaluatorZ>), ("appears that derived class is trying to new with our allocator"));
-				return ms_memoryBlockManager->allocate();
-			}
-
-		static void  operator delete(void *data, size_t size)
-			{
-				UNREF(size);
-				NOT_NULL(ms_memoryBlockManager);
-				DEBUG_FATAL(size != sizeof(KeyframeTranslationOperation<EvaluatorX, EvaluatorY, EvaluatorZ>), ("appears that derived class is trying to new with our allocator"));
-				ms_memoryBlockManager->free(data);
-			}
-
-	public:
-
-		KeyframeTranslationOperation(const CompressedKeyframeAnimation &skeletalAnimation, const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfo) :
-				VectorOperation(), //lint !e1769 // no base class constructor // yes, maybe today, but...
-				m_xEvaluator(C_xTranslation, skeletalAnimation, transformInfo),
-				m_yEvaluator(C_yTranslation, skeletalAnimation, transformInfo),
-				m_zEvaluator(C_zTranslation, skeletalAnimation, transformInfo)
-			{
-			}
-
-		virtual void evaluateCurrentTime(float animationFrameNumber, Vector &result) const
-			{
-				result.x = m_xEvaluator.evaluate(animationFrameNumber);
-				result.y = m_yEvaluator.evaluate(animationFrameNumber);
-				result.z = m_zEvaluator.evaluate(animationFrameNumber);
-			}
-
-	private:
-
-		// disabled
-		KeyframeTranslationOperation();
-		KeyframeTranslationOperation(const KeyframeTranslationOperation&);
-		KeyframeTranslationOperation &operator =(const KeyframeTranslationOperation&);
 
+		C_translationComponentCount
 	};
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	typedef CompressedKeyframeAnimation::VectorOperation *(*TranslationOperationCreator)(const void *skeletalAnimation, const void *transformInfo);
-
-	typedef std::map<size_t, MemoryBlockManager*> MBMContainer;
-	typedef std::vector<char*>                                  StringContainer;
+	void setComponent(Vector &vector, int component, float value);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	bool                         ms_installed;
-	TranslationOperationCreator  ms_translationCreators[8];
-
-	MBMContainer                *ms_memoryBlockManagers;
-
-	MemoryBlockManager *KeyframeRotationOperation::ms_memoryBlockManager;
-
-	MemoryBlockManager *KeyframeTranslationOperation<StaticEvaluator,   StaticEvaluator,   StaticEvaluator>::ms_memoryBlockManager;
-	MemoryBlockManager *KeyframeTranslationOperation<KeyframeEvaluator, StaticEvaluator,   StaticEvaluator>::ms_memoryBlockManager;
-	MemoryBlockManager *KeyframeTranslationOperation<StaticEvaluator,   KeyframeEvaluator, StaticEvaluator>::ms_memoryBlockManager;
-	MemoryBlockManager *KeyframeTranslationOperation<KeyframeEvaluator, KeyframeEvaluator, StaticEvaluator>::ms_memoryBlockManager;
-	MemoryBlockManager *KeyframeTranslationOperation<StaticEvaluator,   StaticEvaluator,   KeyframeEvaluator>::ms_memoryBlockManager;
-	MemoryBlockManager *KeyframeTranslationOperation<KeyframeEvaluator, StaticEvaluator,   KeyframeEvaluator>::ms_memoryBlockManager;
-	MemoryBlockManager *KeyframeTranslationOperation<StaticEvaluator,   KeyframeEvaluator, KeyframeEvaluator>::ms_memoryBlockManager;
-	MemoryBlockManager *KeyframeTranslationOperation<KeyframeEvaluator, KeyframeEvaluator, KeyframeEvaluator>::ms_memoryBlockManager;
-
-	StringContainer *ms_mbmNames;
+	bool  ms_installed;
 }
 
 using namespace CompressedKeyframeAnimationNamespace;
 
-// ======================================================================
-// class CompressedKeyframeAnimation::QuaternionOperation
-// ======================================================================
-
-CompressedKeyframeAnimation::QuaternionOperation::~QuaternionOperation()
-{
-}
-
-
-// ======================================================================
-// class CompressedKeyframeAnimation::StaticQuaternionOperation
-// ======================================================================
-
-MEMORY_BLOCK_MANAGER_IMPLEMENTATION_WITH_INSTALL(CompressedKeyframeAnimation::StaticQuaternionOperation, true, 0, 0, 0);
-
-// ======================================================================
-
-CompressedKeyframeAnimation::StaticQuaternionOperation::StaticQuaternionOperation(const Quaternion &quaternion) :
-	m_quaternion(quaternion)
-{
-}
-
-// ----------------------------------------------------------------------
-
-void CompressedKeyframeAnimation::StaticQuaternionOperation::evaluateCurrentTime(float animationFrameNumber, Quaternion &result) const
-{
-	UNREF(animationFrameNumber);
-	result = m_quaternion;
-}
-
-// ======================================================================
-// class CompressedKeyframeAnimation::VectorOperation
 // ======================================================================
 
-CompressedKeyframeAnimation::VectorOperation::~VectorOperation()
+inline void CompressedKeyframeAnimationNamespace::setComponent(Vector &vector, int component, float value)
 {
-}
-
-// ======================================================================
-// class CompressedKeyframeAnimation::StaticVectorOperation
-// ======================================================================
-
-MEMORY_BLOCK_MANAGER_IMPLEMENTATION_WITH_INSTALL(CompressedKeyframeAnimation::StaticVectorOperation, true, 0, 0, 0);
-
-// ======================================================================
-
-CompressedKeyframeAnimation::StaticVectorOperation::StaticVectorOperation(const Vector &position) :
-	m_vector(position)
-{
-}
-
-// ----------------------------------------------------------------------
-
-void CompressedKeyframeAnimation::StaticVectorOperation::evaluateCurrentTime(float animationFrameNumber, Vector &result) const
-{
-	UNREF(animationFrameNumber);
-	result = m_vector;
-}
-
-// ======================================================================
-// class CompressedKeyframeAnimationNamespace::StaticEvaluator
-// ======================================================================
-
-CompressedKeyframeAnimationNamespace::StaticEvaluator::StaticEvaluator(Component component, const CompressedKeyframeAnimation &skeletalAnimation, const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfo) :
-	m_value(CONST_REAL(0))
-{
-	const CompressedKeyframeAnimationTemplate *const sat = NON_NULL(skeletalAnimation.getOurTemplate());
-
 	switch (component)
 	{
 		case C_xTranslation:
-			m_value = sat->getStaticXTranslation(transformInfo);
-			break;
-		case C_yTranslation:
-			m_value = sat->getStaticYTranslation(transformInfo);
-			break;
-		case C_zTranslation:
-			m_value = sat->getStaticZTranslation(transformInfo);
-			break;
-		case C_xRotation:
-		case C_yRotation:
-		case C_zRotation:
-			DEBUG_FATAL(true, ("you shouldn't get here\n"));
-			break;
-
-		default:
-			FATAL(true, ("unknown component value [%u]", component));
-	}
-}
-
-// ======================================================================
-// class KeyframeEvaluator
-// ======================================================================
-
-CompressedKeyframeAnimationNamespace::KeyframeEvaluator::KeyframeEvaluator(Component component, const CompressedKeyframeAnimation &skeletalAnimation, const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfo) :
-	m_keyDataVector(0),
-	m_lastLowerKeyframeIndex(0)
-{
-	const CompressedKeyframeAnimationTemplate *const sat = NON_NULL(skeletalAnimation.getOurTemplate());
-
-	switch (component)
-	{
-		case C_xTranslation:
-			m_keyDataVector = &(sat->getXTranslationChannelData(transformInfo));
+			vector.x = value;
 			break;
 
 		case C_yTranslation:
-			m_keyDataVector = &(sat->getYTranslationChannelData(transformInfo));
+			vector.y = value;
 			break;
 
 		case C_zTranslation:
-			m_keyDataVector = &(sat->getZTranslationChannelData(transformInfo));
-			break;
-
-		case C_xRotation:
-		case C_yRotation:
-		case C_zRotation:
-			DEBUG_FATAL(true, ("you should not get here.\n"));
+			vector.z = value;
 			break;
 
 		default:
-			FATAL(true, ("unknown component value [%u]", component));
-	}
-
-	NOT_NULL(m_keyDataVector);
-}
-
-// ----------------------------------------------------------------------
-
-CompressedKeyframeAnimationNamespace::KeyframeEvaluator::~KeyframeEvaluator()
-{
-	// we don't own this
-	m_keyDataVector = 0;
-}
-
-// ----------------------------------------------------------------------
-
-real CompressedKeyframeAnimationNamespace::KeyframeEvaluator::evaluate(float animationFrameNumber) const
-{
-	const int   keyCount = static_cast<int>(m_keyDataVector->size());
-	int         lowerKeyframeIndex;
-
-	//-- find closest keyframe occurring on or before animation frame number
-	{
-		// check if we should try to use our keyframe index helper
-		if ((*m_keyDataVector)[static_cast<size_t>(m_lastLowerKeyframeIndex)].m_frameNumber <= animationFrameNumber)
-			lowerKeyframeIndex = m_lastLowerKeyframeIndex;
-		else
-			lowerKeyframeIndex = 0;
-
-		for (; lowerKeyframeIndex < keyCount - 1; ++lowerKeyframeIndex)
-		{
-			if ((*m_keyDataVector)[static_cast<size_t>(lowerKeyframeIndex + 1)].m_frameNumber > animationFrameNumber)
-				break;
-		}
-
-		m_lastLowerKeyframeIndex = lowerKeyframeIndex;
+			DEBUG_FATAL(true, ("unknown component value [%d]", component));
 	}
-
-	//-- get frame distance to next key
-	const real oneOverFrameDistance = (*m_keyDataVector)[static_cast<size_t>(lowerKeyframeIndex)].m_oneOverDistanceToNextKeyframe;
-	if (oneOverFrameDistance == 0.0f)
-	{
-		// the animation frame number must be exactly on a keyframe
-		return (*m_keyDataVector)[static_cast<size_t>(lowerKeyframeIndex)].m_keyValue;
-	}
-	else
-	{
-		//-- find closest keyframe occurring on or after animation frame number
-		int upperKeyframeIndex = lowerKeyframeIndex + 1;
-		VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, upperKeyframeIndex, keyCount);
-		VALIDATE_RANGE_INCLUSIVE_INCLUSIVE((*m_keyDataVector)[static_cast<size_t>(lowerKeyframeIndex)].m_frameNumber, animationFrameNumber, (*m_keyDataVector)[static_cast<size_t>(upperKeyframeIndex)].m_frameNumber);
-
-		const float lowerKeyframeWeight = ((*m_keyDataVector)[static_cast<size_t>(upperKeyframeIndex)].m_frameNumber - animationFrameNumber) * oneOverFrameDistance;
-		const float blendedValue        = (lowerKeyframeWeight * (*m_keyDataVector)[static_cast<size_t>(lowerKeyframeIndex)].m_keyValue) + ((1.0f - lowerKeyframeWeight) * (*m_keyDataVector)[static_cast<size_t>(upperKeyframeIndex)].m_keyValue);
-
-		return blendedValue;
-	}
-}
-
-// ======================================================================
-// class KeyframeRotationOperation
-// ======================================================================
-
-void CompressedKeyframeAnimationNamespace::KeyframeRotationOperation::install()
-{
-	ms_memoryBlockManager = FindOrCreateMemoryBlockManager(sizeof(KeyframeRotationOperation));
-}
-
-// ----------------------------------------------------------------------
-
-void *CompressedKeyframeAnimationNamespace::KeyframeRotationOperation::operator new(size_t size)
-{
-	UNREF(size);
-	NOT_NULL(ms_memoryBlockManager);
-	DEBUG_FATAL(size != sizeof(KeyframeRotationOperation), ("appears that derived class is trying to new with our allocator"));
-	return ms_memoryBlockManager->allocate();
-}
-
-// ----------------------------------------------------------------------
-
-void CompressedKeyframeAnimationNamespace::KeyframeRotationOperation::operator delete(void *data, size_t size)
-{
-	UNREF(size);
-	NOT_NULL(ms_memoryBlockManager);
-	DEBUG_FATAL(size != sizeof(KeyframeRotationOperation), ("appears that derived class is trying to new with our allocator"));
-	ms_memoryBlockManager->free(data);
 }
 
 // ======================================================================
 
-CompressedKeyframeAnimationNamespace::KeyframeRotationOperation::KeyframeRotationOperation(const CompressedKeyframeAnimationTemplate::RotationChannel &rotationChannel) :
-	QuaternionOperation(),
-	m_rotationChannel(rotationChannel),
-	m_lastLowerKeyframeIndex(0)
-{
-}
-
-// ----------------------------------------------------------------------
-
-void CompressedKeyframeAnimationNamespace::KeyframeRotationOperation::evaluateCurrentTime(float animationFrameNumber, Quaternion &result) const
-{
-	result = CompressedKeyframeAnimationTemplate::computeQuaternionFromKeys(m_rotationChannel, animationFrameNumber, m_lastLowerKeyframeIndex);
-}
-
-// ======================================================================
-// creation-related stand-alone functions
-// ======================================================================
-
-namespace CompressedKeyframeAnimationNamespace
-{
-	MemoryBlockManager *FindOrCreateMemoryBlockManager(size_t elementSize)
-	{
-		NOT_NULL(ms_memoryBlockManagers);
-
-		MBMContainer::iterator it = ms_memoryBlockManagers->find(elementSize);
-		if (it != ms_memoryBlockManagers->end())
-			return it->second;
-
-		//-- need to create it
-		char nameBuffer[256];
-		sprintf(nameBuffer, "CompressedKeyframeAnimation<%u>", elementSize);
-
-		// -TRF- this is so goofy, if only MBM copied the name (I tried, causes problems with DLL).
-		char *name = DuplicateString(nameBuffer);
-		ms_mbmNames->push_back(name);
-
-		MemoryBlockManager *mbm = new MemoryBlockManager(name, true, static_cast<int>(elementSize), 0, 0, 0);
-
-		//-- add it to container
-		std::pair<MBMContainer::iterator, bool> insertResult = ms_memoryBlockManagers->insert(MBMContainer::value_type(elementSize, mbm));
-		DEBUG_FATAL(!insertResult.second, ("both find and insert failed"));
-		UNREF(insertResult);
-
-		return mbm;
-	}
-}
-
-// ----------------------------------------------------------------------
-
-#if 0
-
-template <class EvaluatorX, class EvaluatorY, class EvaluatorZ>
-static CompressedKeyframeAnimation::QuaternionOperation *CreateRotationOperation(void *skeletalAnimation, void *transformInfo)
-{
-	NOT_NULL(skeletalTemplate);
-	NOT_NULL(transformInfo);
-
-	const CompressedKeyframeAnimation                        &skeletalAnimationRef = *(reinterpret_cast<const CompressedKeyframeAnimation*>(skeletalAnimation));
-	const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfoRef     = *(reinterpret_cast<const CompressedKeyframeAnimationTemplate::TransformInfo*>(transformInfo));
-
-	return new KeyframeRotationOperation<EvaluatorX, EvaluatorY, EvaluatorZ>(skeletalAnimationRef, transformInfoRef);
-}
-
-#endif
-
-// ----------------------------------------------------------------------
-
-template <class EvaluatorX, class EvaluatorY, class EvaluatorZ>
-static CompressedKeyframeAnimation::VectorOperation *CreateTranslationOperation(void *skeletalAnimation, void *transformInfo)
-{
-	NOT_NULL(skeletalAnimation);
-	NOT_NULL(transformInfo);
-
-	const CompressedKeyframeAnimation                        &skeletalAnimationRef = *(reinterpret_cast<const CompressedKeyframeAnimation*>(skeletalAnimation));
-	const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfoRef     = *(reinterpret_cast<const CompressedKeyframeAnimationTemplate::TransformInfo*>(transformInfo));
-
-	return new KeyframeTranslationOperation<EvaluatorX, EvaluatorY, EvaluatorZ>(skeletalAnimationRef, transformInfoRef);
-}
-
-// ----------------------------------------------------------------------
-
-static CompressedKeyframeAnimation::VectorOperation *CreateTranslationOperation_SSS(const void *skeletalAnimation, const void *transformInfo)
-{
-	NOT_NULL(skeletalAnimation);
-	NOT_NULL(transformInfo);
-
-	const CompressedKeyframeAnimation                        &skeletalAnimationRef = *(reinterpret_cast<const CompressedKeyframeAnimation*>(skeletalAnimation));
-	const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfoRef     = *(reinterpret_cast<const CompressedKeyframeAnimationTemplate::TransformInfo*>(transformInfo));
-
-	return new KeyframeTranslationOperation<StaticEvaluator, StaticEvaluator, StaticEvaluator>(skeletalAnimationRef, transformInfoRef);
-}
-
-// ----------------------------------------------------------------------
-
-static CompressedKeyframeAnimation::VectorOperation *CreateTranslationOperation_KSS(const void *skeletalAnimation, const void *transformInfo)
-{
-	NOT_NULL(skeletalAnimation);
-	NOT_NULL(transformInfo);
-
-	const CompressedKeyframeAnimation                        &skeletalAnimationRef = *(reinterpret_cast<const CompressedKeyframeAnimation*>(skeletalAnimation));
-	const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfoRef     = *(reinterpret_cast<const CompressedKeyframeAnimationTemplate::TransformInfo*>(transformInfo));
-
-	return new KeyframeTranslationOperation<KeyframeEvaluator, StaticEvaluator, StaticEvaluator>(skeletalAnimationRef, transformInfoRef);
-}
-
-// ----------------------------------------------------------------------
-
-static CompressedKeyframeAnimation::VectorOperation *CreateTranslationOperation_SKS(const void *skeletalAnimation, const void *transformInfo)
-{
-	NOT_NULL(skeletalAnimation);
-	NOT_NULL(transformInfo);
-
-	const CompressedKeyframeAnimation                        &skeletalAnimationRef = *(reinterpret_cast<const CompressedKeyframeAnimation*>(skeletalAnimation));
-	const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfoRef     = *(reinterpret_cast<const CompressedKeyframeAnimationTemplate::TransformInfo*>(transformInfo));
-
-	return new KeyframeTranslationOperation<StaticEvaluator, KeyframeEvaluator, StaticEvaluator>(skeletalAnimationRef, transformInfoRef);
-}
-
-// ----------------------------------------------------------------------
-
-static CompressedKeyframeAnimation::VectorOperation *CreateTranslationOperation_KKS(const void *skeletalAnimation, const void *transformInfo)
-{
-	NOT_NULL(skeletalAnimation);
-	NOT_NULL(transformInfo);
-
-	const CompressedKeyframeAnimation                        &skeletalAnimationRef = *(reinterpret_cast<const CompressedKeyframeAnimation*>(skeletalAnimation));
-	const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfoRef     = *(reinterpret_cast<const CompressedKeyframeAnimationTemplate::TransformInfo*>(transformInfo));
-
-	return new KeyframeTranslationOperation<KeyframeEvaluator, KeyframeEvaluator, StaticEvaluator>(skeletalAnimationRef, transformInfoRef);
-}
-
-// ----------------------------------------------------------------------
-
-static CompressedKeyframeAnimation::VectorOperation *CreateTranslationOperation_SSK(const void *skeletalAnimation, const void *transformInfo)
-{
-	NOT_NULL(skeletalAnimation);
-	NOT_NULL(transformInfo);
-
-	const CompressedKeyframeAnimation                        &skeletalAnimationRef = *(reinterpret_cast<const CompressedKeyframeAnimation*>(skeletalAnimation));
-	const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfoRef     = *(reinterpret_cast<const CompressedKeyframeAnimationTemplate::TransformInfo*>(transformInfo));
-
-	return new KeyframeTranslationOperation<StaticEvaluator, StaticEvaluator, KeyframeEvaluator>(skeletalAnimationRef, transformInfoRef);
-}
-
-// ----------------------------------------------------------------------
-
-static CompressedKeyframeAnimation::VectorOperation *CreateTranslationOperation_KSK(const void *skeletalAnimation, const void *transformInfo)
-{
-	NOT_NULL(skeletalAnimation);
-	NOT_NULL(transformInfo);
-
-	const CompressedKeyframeAnimation                        &skeletalAnimationRef = *(reinterpret_cast<const CompressedKeyframeAnimation*>(skeletalAnimation));
-	const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfoRef     = *(reinterpret_cast<const CompressedKeyframeAnimationTemplate::TransformInfo*>(transformInfo));
-
-	return new KeyframeTranslationOperation<KeyframeEvaluator, StaticEvaluator, KeyframeEvaluator>(skeletalAnimationRef, transformInfoRef);
-}
-
-// ----------------------------------------------------------------------
-
-static CompressedKeyframeAnimation::VectorOperation *CreateTranslationOperation_SKK(const void *skeletalAnimation, const void *transformInfo)
-{
-	NOT_NULL(skeletalAnimation);
-	NOT_NULL(transformInfo);
-
-	const CompressedKeyframeAnimation                        &skeletalAnimationRef = *(reinterpret_cast<const CompressedKeyframeAnimation*>(skeletalAnimation));
-	const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfoRef     = *(reinterpret_cast<const CompressedKeyframeAnimationTemplate::TransformInfo*>(transformInfo));
-
-	return new KeyframeTranslationOperation<StaticEvaluator, KeyframeEvaluator, KeyframeEvaluator>(skeletalAnimationRef, transformInfoRef);
-}
-
-// ----------------------------------------------------------------------
-
-static CompressedKeyframeAnimation::VectorOperation *CreateTranslationOperation_KKK(const void *skeletalAnimation, const void *transformInfo)
+CompressedKeyframeAnimation::ChannelData::ChannelData(int transformCount) :
+	m_staticRotations(static_cast<QuaternionVector::size_type>(transformCount), Quaternion::identity),
+	m_staticTranslations(static_cast<VectorVector::size_type>(transformCount), Vector::zero),
+	m_rotationChannelIndices(static_cast<IntVector::size_type>(transformCount), -1),
+	m_translationChannelIndices(static_cast<IntVector::size_type>(transformCount * C_translationComponentCount), -1),
+	m_rotationChannels(),
+	m_rotationTransformIndices(),
+	m_rotationStartKeyIndices(),
+	m_translationChannels(),
+	m_translationTransformIndices(),
+	m_translationComponents(),
+	m_translationStartKeyIndices()
 {
-	NOT_NULL(skeletalAnimation);
-	NOT_NULL(transformInfo);
-
-	const CompressedKeyframeAnimation                        &skeletalAnimationRef = *(reinterpret_cast<const CompressedKeyframeAnimation*>(skeletalAnimation));
-	const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfoRef     = *(reinterpret_cast<const CompressedKeyframeAnimationTemplate::TransformInfo*>(transformInfo));
-
-	return new KeyframeTranslationOperation<KeyframeEvaluator, KeyframeEvaluator, KeyframeEvaluator>(skeletalAnimationRef, transformInfoRef);
 }
 
 // ======================================================================
@@ -703,36 +170,6 @@ void CompressedKeyframeAnimation::install()
 {
 	DEBUG_FATAL(ms_installed, ("CompressedKeyframeAnimation already installed"));
 
-	CompressedKeyframeAnimation::StaticQuaternionOperation::install();
-	CompressedKeyframeAnimation::StaticVectorOperation::install();
-
-	//-- setup the translation operation node creation functions
-	//   for these, , ..._XYZ is replaced with (K) for keyframed and (S) for static value
-	ms_translationCreators[0] = CreateTranslationOperation_SSS;
-	ms_translationCreators[1] = CreateTranslationOperation_KSS;
-	ms_translationCreators[2] = CreateTranslationOperation_SKS;
-	ms_translationCreators[3] = CreateTranslationOperation_KKS;
-	ms_translationCreators[4] = CreateTranslationOperation_SSK;
-	ms_translationCreators[5] = CreateTranslationOperation_KSK;
-	ms_translationCreators[6] = CreateTranslationOperation_SKK;
-	ms_translationCreators[7] = CreateTranslationOperation_KKK;
-
-	ms_memoryBlockManagers = new MBMContainer;
-	ms_mbmNames            = new StringContainer;
-
-	//-- install the rotation operation
-	KeyframeRotationOperation::install();
-
-	//-- install the translation operations
-	KeyframeTranslationOperation<StaticEvaluator,   StaticEvaluator,   StaticEvaluator>::install();
-	KeyframeTranslationOperation<KeyframeEvaluator, StaticEvaluator,   StaticEvaluator>::install();
-	KeyframeTranslationOperation<StaticEvaluator,   KeyframeEvaluator, StaticEvaluator>::install();
-	KeyframeTranslationOperation<KeyframeEvaluator, KeyframeEvaluator, StaticEvaluator>::install();
-	KeyframeTranslationOperation<StaticEvaluator,   StaticEvaluator,   KeyframeEvaluator>::install();
-	KeyframeTranslationOperation<KeyframeEvaluator, StaticEvaluator,   KeyframeEvaluator>::install();
-	KeyframeTranslationOperation<StaticEvaluator,   KeyframeEvaluator, KeyframeEvaluator>::install();
-	KeyframeTranslationOperation<KeyframeEvaluator, KeyframeEvaluator, KeyframeEvaluator>::install();
-
 	ms_skeletalAnimationMemoryBlockManager = new MemoryBlockManager("CompressedKeyframeAnimation", true, sizeof(CompressedKeyframeAnimation), 0, 0, 0);
 
 	DebugFlags::registerFlag(ms_testInvariants, "ClientSkeletalAnimation/Character", "checkCompressedKeyframeInvariants");
@@ -747,26 +184,7 @@ void CompressedKeyframeAnimation::remove()
 {
 	DEBUG_FATAL(!ms_installed, ("CompressedKeyframeAnimation not installed"));
 
-	NOT_NULL(ms_memoryBlockManagers);
-
-	DEBUG_REPORT_LOG(GraphicsDebugFlags::logCharacterSystem, ("CompressedKeyframeAnimation: %u MBMs created during execution\n", ms_memoryBlockManagers->size()));
-
-#ifdef _DEBUG
-	if (GraphicsDebugFlags::logCharacterSystem)
-	{
-		MBMContainer::iterator itEnd = ms_memoryBlockManagers->end();
-		for (MBMContainer::iterator it = ms_memoryBlockManagers->begin(); it != itEnd; ++it)
-			(it->second)->debugDump();
-	}
-#endif
-
-	IGNORE_RETURN( std::for_each(ms_memoryBlockManagers->begin(), ms_memoryBlockManagers->end(), PointerDeleterPairSecond()) );
-	delete ms_memoryBlockManagers;
-	ms_memoryBlockManagers = 0;
-
-	IGNORE_RETURN( std::for_each(ms_mbmNames->begin(), ms_mbmNames->end(), ArrayPointerDeleter()) );
-	delete ms_mbmNames;
-	ms_mbmNames = 0;
+	DebugFlags::unregisterFlag(ms_testInvariants);
 
 	ms_installed = false;
 
@@ -839,10 +257,8 @@ bool CompressedKeyframeAnimation::alterSingleCycle(float deltaTime, SkeletalAnim
 
 int CompressedKeyframeAnimation::getTransformCount() const
 {
-	const int rotationCount = static_cast<int>(m_rotationOperations.size());
-	DEBUG_FATAL(rotationCount != static_cast<int>(m_translationOperations.size()), ("rotation/translation vector has different # entries."));
-
-	return rotationCount;
+	NOT_NULL(m_channelData);
+	return static_cast<int>(m_channelData->m_rotationChannelIndices.size());
 }
 
 // ----------------------------------------------------------------------
@@ -852,9 +268,81 @@ void CompressedKeyframeAnimation::evaluateTransformComponents(int index, Quatern
 	NP_PROFILER_AUTO_BLOCK_DEFINE("CompressedKeyframeAnimation::evaluateTransformComponents");
 
 	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, index, getTransformCount());
+	NOT_NULL(m_channelData);
 
-	m_rotationOperations[static_cast<QuaternionOperationVector::size_type>(index)]->evaluateCurrentTime(m_currentFrameNumber, rotation);
-	m_translationOperations[static_cast<VectorOperationVector::size_type>(index)]->evaluateCurrentTime(m_currentFrameNumber, translation);
+	ChannelData &channelData = *m_channelData;
+	float const frameNumber  = getPoseFrameNumber();
+
+	//-- Evaluate the rotation.
+	int const rotationChannelIndex = channelData.m_rotationChannelIndices[static_cast<size_t>(index)];
+	if (rotationChannelIndex < 0)
+		rotation = channelData.m_staticRotations[static_cast<size_t>(index)];
+	else
+		rotation = CompressedKeyframeAnimationTemplate::computeQuaternionFromKeys(*channelData.m_rotationChannels[static_cast<size_t>(rotationChannelIndex)], frameNumber, channelData.m_rotationStartKeyIndices[static_cast<size_t>(rotationChannelIndex)]);
+
+	//-- Evaluate the translation.
+	translation = channelData.m_staticTranslations[static_cast<size_t>(index)];
+
+	for (int component = 0; component < C_translationComponentCount; ++component)
+	{
+		int const translationChannelIndex = channelData.m_translationChannelIndices[static_cast<size_t>(index * C_translationComponentCount + component)];
+		if (translationChannelIndex >= 0)
+		{
+			size_t const channelIndex = static_cast<size_t>(translationChannelIndex);
+			setComponent(translation, component, CompressedKeyframeAnimationTemplate::computeRealFromKeys(*channelData.m_translationChannels[channelIndex], frameNumber, channelData.m_translationStartKeyIndices[channelIndex]));
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Evaluate every transform of the animation in one pass.
+ *
+ * Static values are copied in as a block, then each animated channel is
+ * evaluated in turn.  Rotation keys are decompressed in batches.
+ */
+
+void CompressedKeyframeAnimation::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	NP_PROFILER_AUTO_BLOCK_DEFINE("CompressedKeyframeAnimation::evaluateAllTransformComponents");
+
+	NOT_NULL(rotations);
+	NOT_NULL(translations);
+	NOT_NULL(m_channelData);
+
+	ChannelData const &channelData = *m_channelData;
+	float const        frameNumber = getPoseFrameNumber();
+
+	//-- Start with the static pose.
+	IGNORE_RETURN(std::copy(channelData.m_staticRotations.begin(), channelData.m_staticRotations.end(), rotations));
+	IGNORE_RETURN(std::copy(channelData.m_staticTranslations.begin(), channelData.m_staticTranslations.end(), translations));
+
+	//-- Overwrite with the animated rotations.
+	int const rotationChannelCount = static_cast<int>(channelData.m_rotationChannels.size());
+	if (rotationChannelCount > 0)
+		CompressedKeyframeAnimationTemplate::computeQuaternionsFromKeys(rotationChannelCount, &channelData.m_rotationChannels[0], &channelData.m_rotationTransformIndices[0], frameNumber, &m_channelData->m_rotationStartKeyIndices[0], rotations);
+
+	//-- Overwrite with the animated translation components.
+	size_t const translationChannelCount = channelData.m_translationChannels.size();
+	for (size_t i = 0; i < translationChannelCount; ++i)
+	{
+		float const value = CompressedKeyframeAnimationTemplate::computeRealFromKeys(*channelData.m_translationChannels[i], frameNumber, m_channelData->m_translationStartKeyIndices[i]);
+		setComponent(translations[channelData.m_translationTransformIndices[i]], channelData.m_translationComponents[i], value);
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * The pose of a keyframe animation only depends on the animation template,
+ * the skeleton it is bound to and the frame it is evaluated at.
+ */
+
+bool CompressedKeyframeAnimation::addPoseCacheKey(PoseCache::Key &key) const
+{
+	key.addPointer(getSkeletalAnimationTemplate());
+	key.addInt(PoseCache::getFrameNumberKey(getPoseFrameNumber()));
+
+	return true;
 }
 
 // ----------------------------------------------------------------------
@@ -1042,74 +530,100 @@ CompressedKeyframeAnimation::CompressedKeyframeAnimation(const CompressedKeyfram
 	m_playbackFramesPerSecond(30.0f),
 	m_ooPlaybackFramesPerSecond(1.0f / 30.0f),
 	m_frameCount(static_cast<float>(NON_NULL(skeletalAnimationTemplate)->getFrameCount())),
-	m_rotationOperations(static_cast<QuaternionOperationVector::size_type>(skeletonTransformNameMap.getTransformCount())),
-	m_translationOperations(static_cast<VectorOperationVector::size_type>(skeletonTransformNameMap.getTransformCount())),
+	m_channelData(new ChannelData(skeletonTransformNameMap.getTransformCount())),
 	m_rotationStartKeyIndex(0),
 	m_translationStartKeyIndex(0),
-	m_scale(animationEnvironment.getConstFloat(AnimationEnvironmentNames::cms_appearanceScale))
+	m_scale(animationEnvironment.getConstFloat(AnimationEnvironmentNames::cms_appearanceScale)),
+	m_posePhaseOffset(animationEnvironment.getConstFloat(AnimationEnvironmentNames::cms_posePhaseOffset))
 {
 	DEBUG_FATAL(!ms_installed, ("CompressedKeyframeAnimation not installed"));
 	NOT_NULL(skeletalAnimationTemplate);
 
 	CompressedKeyframeAnimation::setPlaybackFramesPerSecond(CompressedKeyframeAnimation::getRecordedFramesPerSecond());
 
-	//-- Construct the operations.
+	//-- Build the channel data.
+	ChannelData &channelData = *m_channelData;
 
-	// Reserve appropriate size.
+	// Lookup the channels for each transform in the skeleton (i.e. in the associated .skt).
 	const int transformCount = skeletonTransformNameMap.getTransformCount();
 
-	// Lookup and create operations per transform in the skeleton (i.e. in the associated .skt).
 	for (int i = 0; i < transformCount; ++i)
 	{
-		QuaternionOperation *& currentRotationOperation    = m_rotationOperations[static_cast<QuaternionOperationVector::size_type>(i)];
-		VectorOperation     *& currentTranslationOperation = m_translationOperations[static_cast<VectorOperationVector::size_type>(i)];
-
 		//-- Lookup the transform data in the animation file for the given .skt transform.
 		const int animationTransformIndex = skeletalAnimationTemplate->getTransformIndex(skeletonTransformNameMap.getTransformName(i));
 		if (animationTransformIndex < 0)
 		{
-			// This skeleton transform is not present in this animation file.  In this case the animation returns static zero values.
-			currentRotationOperation    = new StaticQuaternionOperation(Quaternion::identity);
-			currentTranslationOperation = new StaticVectorOperation(Vector::zero);
+			// This skeleton transform is not present in this animation file.  In this case the animation returns static zero values,
+			// which is what the channel data starts with.
+			continue;
 		}
-		else
-		{
-			const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfo = skeletalAnimationTemplate->getTransformInfo(animationTransformIndex);
 
-			//-- Create the rotation operation.
-			// Determine proper operation to create based on animation/static properties of this transform
-			if (skeletalAnimationTemplate->hasAnimatedRotation(transformInfo))
-			{
-				// Create a KeyframeRotationOperation
-				currentRotationOperation = new KeyframeRotationOperation(skeletalAnimationTemplate->getAnimatedRotationChannel(transformInfo));
-			}
-			else
-			{
-				// Create a static rotation operation
-				// @todo consider accessing static rotations in compressed format rather than in expanded format.  This would
-				//       save more memory.
-				currentRotationOperation = new StaticQuaternionOperation(skeletalAnimationTemplate->getStaticRotation(transformInfo));
-			}
+		const CompressedKeyframeAnimationTemplate::TransformInfo &transformInfo = skeletalAnimationTemplate->getTransformInfo(animationTransformIndex);
 
-			//-- Create the translation operation.
-			// Determine proper operation to create based on animation/static properties of this transform
-			unsigned creatorIndex;
+		//-- Setup the rotation.
+		if (skeletalAnimationTemplate->hasAnimatedRotation(transformInfo))
+		{
+			channelData.m_rotationChannelIndices[static_cast<size_t>(i)] = static_cast<int>(channelData.m_rotationChannels.size());
 
-			if (skeletalAnimationTemplate->animatesTranslationX(transformInfo))
-				creatorIndex = 0x01;
-			else
-				creatorIndex = 0;
+			channelData.m_rotationChannels.push_back(&skeletalAnimationTemplate->getAnimatedRotationChannel(transformInfo));
+			channelData.m_rotationTransformIndices.push_back(i);
+			channelData.m_rotationStartKeyIndices.push_back(0);
+		}
+		else
+		{
+			// @todo consider accessing static rotations in compressed format rather than in expanded format.  This would
+			//       save more memory.
+			channelData.m_staticRotations[static_cast<size_t>(i)] = skeletalAnimationTemplate->getStaticRotation(transformInfo);
+		}
 
-			if (skeletalAnimationTemplate->animatesTranslationY(transformInfo))
-				creatorIndex |= 0x02;
+		//-- Setup the translation, one component at a time.
+		Vector &staticTranslation = channelData.m_staticTranslations[static_cast<size_t>(i)];
 
-			if (skeletalAnimationTemplate->animatesTranslationZ(transformInfo))
-				creatorIndex |= 0x04;
+		for (int component = 0; component < C_translationComponentCount; ++component)
+		{
+			bool                                    animated      = false;
+			ChannelData::RealKeyDataVector const   *keyDataVector = 0;
 
-			VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, static_cast<int>(creatorIndex), 8);
+			switch (component)
+			{
+				case C_xTranslation:
+					animated = skeletalAnimationTemplate->animatesTranslationX(transformInfo);
+					if (animated)
+						keyDataVector = &skeletalAnimationTemplate->getXTranslationChannelData(transformInfo);
+					else
+						staticTranslation.x = skeletalAnimationTemplate->getStaticXTranslation(transformInfo);
+					break;
+
+				case C_yTranslation:
+					animated = skeletalAnimationTemplate->animatesTranslationY(transformInfo);
+					if (animated)
+						keyDataVector = &skeletalAnimationTemplate->getYTranslationChannelData(transformInfo);
+					else
+						staticTranslation.y = skeletalAnimationTemplate->getStaticYTranslation(transformInfo);
+					break;
+
+				case C_zTranslation:
+					animated = skeletalAnimationTemplate->animatesTranslationZ(transformInfo);
+					if (animated)
+						keyDataVector = &skeletalAnimationTemplate->getZTranslationChannelData(transformInfo);
+					else
+						staticTranslation.z = skeletalAnimationTemplate->getStaticZTranslation(transformInfo);
+					break;
+
+				default:
+					FATAL(true, ("unknown component value [%d]", component));
+			}
 
-			//-- Create the operation.
-			currentTranslationOperation = (*ms_translationCreators[creatorIndex])(this, &transformInfo); //lint !e826 // (Info -- Suspicious pointer-to-pointer conversion (area too small)) // Lint is confused.  This is a pointer assignment.
+			if (animated)
+			{
+				NOT_NULL(keyDataVector);
+				channelData.m_translationChannelIndices[static_cast<size_t>(i * C_translationComponentCount + component)] = static_cast<int>(channelData.m_translationChannels.size());
+
+				channelData.m_translationChannels.push_back(keyDataVector);
+				channelData.m_translationTransformIndices.push_back(i);
+				channelData.m_translationComponents.push_back(component);
+				channelData.m_translationStartKeyIndices.push_back(0);
+			}
 		}
 	}
 }
@@ -1118,8 +632,8 @@ CompressedKeyframeAnimation::CompressedKeyframeAnimation(const CompressedKeyfram
 
 CompressedKeyframeAnimation::~CompressedKeyframeAnimation()
 {
-	std::for_each(m_rotationOperations.begin(), m_rotationOperations.end(), PointerDeleter());
-	std::for_each(m_translationOperations.begin(), m_translationOperations.end(), PointerDeleter());
+	delete m_channelData;
+	m_channelData = 0;
 }
 
 // ----------------------------------------------------------------------
@@ -1161,4 +675,34 @@ bool CompressedKeyframeAnimation::validateInvariantsWarn() const
 	return true;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Get the frame number the pose is evaluated at.
+ *
+ * The phase offset from the animation environment is applied here, wrapped
+ * around the end of the animation, so it only shifts the pose; locomotion and
+ * message timing still follow the real frame number.  While the PoseCache is
+ * snapping, the offset and the frame number are snapped to its frame quantum.
+ */
+
+float CompressedKeyframeAnimation::getPoseFrameNumber() const
+{
+	float frameNumber = m_currentFrameNumber;
+
+	bool const snap = PoseCache::isSnapping();
+
+	if ((m_posePhaseOffset != 0.0f) && (m_frameCount > 0.0f))
+	{
+		float const phaseFrameOffset = m_posePhaseOffset * m_playbackFramesPerSecond;
+		frameNumber = static_cast<float>(fmod(static_cast<double>(frameNumber + (snap ? PoseCache::snapFrameNumber(phaseFrameOffset) : phaseFrameOffset)), static_cast<double>(m_frameCount)));
+		if (frameNumber < 0.0f)
+			frameNumber += m_frameCount;
+	}
+
+	if (snap)
+		frameNumber = std::min(PoseCache::snapFrameNumber(frameNumber), m_frameCount);
+
+	return frameNumber;
+}
+
 // ======================================================================
@@ -29,11 +29,6 @@ class CompressedKeyframeAnimation: public SkeletalAnimation
 {
 friend class CompressedKeyframeAnimationTemplate;
 
-public:
-
-	class QuaternionOperation;
-	class VectorOperation;
-
 public:
 
 	static void install();
@@ -50,6 +45,8 @@ public:
 
 	virtual int                      getTransformCount() const;
 	virtual void                     evaluateTransformComponents(int index, Quaternion &rotation, Vector &translation);
+	virtual void                     evaluateAllTransformComponents(Quaternion *rotations, Vector *translations);
+	virtual bool                     addPoseCacheKey(PoseCache::Key &key) const;
 
 	virtual int                      getTransformPriority(int index) const;
 	virtual int                      getLocomotionPriority() const;
@@ -71,14 +68,7 @@ public:
 
 private:
 
-	class StaticQuaternionOperation;
-	friend class StaticQuaternionOperation;
-
-	class StaticVectorOperation;
-	friend class StaticVectorOperation;
-
-	typedef stdvector<QuaternionOperation*>::fwd  QuaternionOperationVector;
-	typedef stdvector<VectorOperation*>::fwd      VectorOperationVector;
+	struct ChannelData;
 
 private:
 
@@ -90,6 +80,7 @@ private:
 	virtual ~CompressedKeyframeAnimation();
 
 	bool  validateInvariantsWarn() const;
+	float getPoseFrameNumber() const;
 
 	// disabled
 	CompressedKeyframeAnimation();
@@ -112,13 +103,13 @@ private:
 	float                      m_ooPlaybackFramesPerSecond;
 	float                      m_frameCount;
 
-	QuaternionOperationVector  m_rotationOperations;
-	VectorOperationVector      m_translationOperations;
+	ChannelData               *m_channelData;
 
 	mutable int                m_rotationStartKeyIndex;
 	mutable int                m_translationStartKeyIndex;
 
 	const float               &m_scale;
+	const float               &m_posePhaseOffset;
 };
 
 // ======================================================================
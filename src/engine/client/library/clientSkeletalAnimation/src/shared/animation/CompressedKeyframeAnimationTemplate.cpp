@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <limits>
 #include <set>
+#include <string.h>
 
 // ======================================================================
 // Lint supression
@@ -58,6 +59,33 @@ namespace CompressedKeyframeAnimationTemplateNamespace
 	{
 		return !WithinEpsilonInclusive(previousValue, nextValue, s_translationFixEpsilon);
 	}
+
+	// Number of rotation channels expanded together by computeQuaternionsFromKeys().
+	int const cs_quaternionBatchSize = 16;
+
+	//-- Find the closest keyframe occurring on or before frameTime.  The search starts at
+	//   startKeyIndex when possible, so playing forward costs O(1) per call.
+	template <typename KeyDataVector>
+	inline int findLowerKeyframeIndex(KeyDataVector const &keyDataVector, float const frameTime, int &startKeyIndex)
+	{
+		int const keyCount = static_cast<int>(keyDataVector.size());
+		int       lowerKeyframeIndex;
+
+		// check if we should try to use our keyframe index helper
+		if (keyDataVector[static_cast<size_t>(startKeyIndex)].m_frameNumber <= frameTime)
+			lowerKeyframeIndex = startKeyIndex;
+		else
+			lowerKeyframeIndex = 0;
+
+		for (; lowerKeyframeIndex < keyCount - 1; ++lowerKeyframeIndex)
+		{
+			if (keyDataVector[static_cast<size_t>(lowerKeyframeIndex + 1)].m_frameNumber > frameTime)
+				break;
+		}
+
+		startKeyIndex = lowerKeyframeIndex;
+		return lowerKeyframeIndex;
+	}
 }
 
 using namespace CompressedKeyframeAnimationTemplateNamespace;
@@ -718,22 +746,7 @@ Quaternion CompressedKeyframeAnimationTemplate::computeQuaternionFromKeys(const
 	const int keyCount = static_cast<int>(keyDataVector.size());
 
 	//-- find closest keyframe occurring on or before animation frame number
-	int  lowerKeyframeIndex;
-	{
-		// check if we should try to use our keyframe index helper
-		if (keyDataVector[static_cast<size_t>(startKeyIndex)].m_frameNumber <= frameTime)
-			lowerKeyframeIndex = startKeyIndex;
-		else
-			lowerKeyframeIndex = 0;
-
-		for (; lowerKeyframeIndex < keyCount - 1; ++lowerKeyframeIndex)
-		{
-			if (keyDataVector[static_cast<size_t>(lowerKeyframeIndex + 1)].m_frameNumber > frameTime)
-				break;
-		}
-
-		startKeyIndex = lowerKeyframeIndex;
-	}
+	int const lowerKeyframeIndex = findLowerKeyframeIndex(keyDataVector, frameTime, startKeyIndex);
 
 	//-- Retrieve compression format.
 	const uint8 xCompressionFormat = rotationChannel.getXCompressionFormat();
@@ -764,30 +777,134 @@ Quaternion CompressedKeyframeAnimationTemplate::computeQuaternionFromKeys(const
 }
 
 // ----------------------------------------------------------------------
+/**
+ * Evaluate a set of rotation channels at the same frame time.
+ *
+ * This gives the same results as calling computeQuaternionFromKeys() for
+ * each channel, but it decompresses the bracketing keys of many channels
+ * together with CompressedQuaternion::expandArray().
+ *
+ * @param channelCount      the number of channels to evaluate.
+ * @param rotationChannels  the channels to evaluate.
+ * @param transformIndices  the index in rotations that receives the result for each channel.
+ * @param frameTime         the animation frame number to evaluate.
+ * @param startKeyIndices   the keyframe cursor for each channel, updated on return.
+ * @param rotations         the destination rotation array.
+ */
 
-Vector CompressedKeyframeAnimationTemplate::computeVectorFromKeys(const VectorKeyDataVector &keyDataVector, float frameTime, int &startKeyIndex)
+void CompressedKeyframeAnimationTemplate::computeQuaternionsFromKeys(int channelCount, RotationChannel const *const *rotationChannels, int const *transformIndices, float frameTime, int *startKeyIndices, Quaternion *rotations)
 {
-	DEBUG_FATAL(keyDataVector.empty(), ("No keys in this animation channel's data."));
+	uint32 compressedValues[2 * cs_quaternionBatchSize];
+	uint8  xFormats[2 * cs_quaternionBatchSize];
+	uint8  yFormats[2 * cs_quaternionBatchSize];
+	uint8  zFormats[2 * cs_quaternionBatchSize];
 
-	const int keyCount = static_cast<int>(keyDataVector.size());
+	float  w[2 * cs_quaternionBatchSize];
+	float  x[2 * cs_quaternionBatchSize];
+	float  y[2 * cs_quaternionBatchSize];
+	float  z[2 * cs_quaternionBatchSize];
 
-	//-- find closest keyframe occurring on or before animation frame number
-	int lowerKeyframeIndex;
+	bool   onKeyframe[cs_quaternionBatchSize];
+	float  upperKeyframeWeights[cs_quaternionBatchSize];
+
+	for (int batchStart = 0; batchStart < channelCount; batchStart += cs_quaternionBatchSize)
 	{
-		// check if we should try to use our keyframe index helper
-		if (keyDataVector[static_cast<size_t>(startKeyIndex)].m_frameNumber <= frameTime)
-			lowerKeyframeIndex = startKeyIndex;
-		else
-			lowerKeyframeIndex = 0;
+		int const batchCount = std::min(cs_quaternionBatchSize, channelCount - batchStart);
 
-		for (; lowerKeyframeIndex < keyCount - 1; ++lowerKeyframeIndex)
+		//-- Gather the lower keys into [0, batchCount) and the upper keys into [batchCount, 2 * batchCount).
+		for (int i = 0; i < batchCount; ++i)
 		{
-			if (keyDataVector[static_cast<size_t>(lowerKeyframeIndex + 1)].m_frameNumber > frameTime)
-				break;
+			RotationChannel const &rotationChannel = *NON_NULL(rotationChannels[batchStart + i]);
+
+			const QuaternionKeyDataVector &keyDataVector = rotationChannel.getKeyDataVector();
+			DEBUG_FATAL(keyDataVector.empty(), ("No keys in this animation channel's data."));
+
+			int const               lowerKeyframeIndex = findLowerKeyframeIndex(keyDataVector, frameTime, startKeyIndices[batchStart + i]);
+			QuaternionKeyData const &lowerKeyData      = keyDataVector[static_cast<size_t>(lowerKeyframeIndex)];
+
+			int upperKeyframeIndex = lowerKeyframeIndex;
+
+			onKeyframe[i] = (lowerKeyData.m_oneOverDistanceToNextKeyframe == 0.0f);
+			if (onKeyframe[i])
+				upperKeyframeWeights[i] = 0.0f;
+			else
+			{
+				upperKeyframeIndex = lowerKeyframeIndex + 1;
+				VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, upperKeyframeIndex, static_cast<int>(keyDataVector.size()));
+				VALIDATE_RANGE_INCLUSIVE_INCLUSIVE(lowerKeyData.m_frameNumber, frameTime, keyDataVector[static_cast<size_t>(upperKeyframeIndex)].m_frameNumber);
+
+				upperKeyframeWeights[i] = (frameTime - lowerKeyData.m_frameNumber) * lowerKeyData.m_oneOverDistanceToNextKeyframe;
+			}
+
+			compressedValues[i]              = lowerKeyData.m_rotation.getCompressedValue();
+			compressedValues[batchCount + i] = keyDataVector[static_cast<size_t>(upperKeyframeIndex)].m_rotation.getCompressedValue();
+
+			xFormats[i] = xFormats[batchCount + i] = rotationChannel.getXCompressionFormat();
+			yFormats[i] = yFormats[batchCount + i] = rotationChannel.getYCompressionFormat();
+			zFormats[i] = zFormats[batchCount + i] = rotationChannel.getZCompressionFormat();
 		}
 
-		startKeyIndex = lowerKeyframeIndex;
+		//-- Decompress all of the keys at once.
+		CompressedQuaternion::expandArray(2 * batchCount, compressedValues, xFormats, yFormats, zFormats, w, x, y, z);
+
+		//-- Interpolate.
+		for (int j = 0; j < batchCount; ++j)
+		{
+			Quaternion const lowerKeyframeRotation(w[j], x[j], y[j], z[j]);
+			Quaternion &rotation = rotations[transformIndices[batchStart + j]];
+
+			if (onKeyframe[j])
+			{
+				// the animation frame number must be exactly on a keyframe
+				rotation = lowerKeyframeRotation;
+			}
+			else
+			{
+				int const upperIndex = batchCount + j;
+				rotation = lowerKeyframeRotation.slerp(Quaternion(w[upperIndex], x[upperIndex], y[upperIndex], z[upperIndex]), upperKeyframeWeights[j]);
+			}
+		}
 	}
+}
+
+// ----------------------------------------------------------------------
+
+float CompressedKeyframeAnimationTemplate::computeRealFromKeys(const RealKeyDataVector &keyDataVector, float frameTime, int &startKeyIndex)
+{
+	DEBUG_FATAL(keyDataVector.empty(), ("No keys in this animation channel's data."));
+
+	//-- find closest keyframe occurring on or before animation frame number
+	int const lowerKeyframeIndex = findLowerKeyframeIndex(keyDataVector, frameTime, startKeyIndex);
+
+	//-- get frame distance to next key
+	const real oneOverFrameDistance = keyDataVector[static_cast<size_t>(lowerKeyframeIndex)].m_oneOverDistanceToNextKeyframe;
+	if (oneOverFrameDistance == 0.0f)
+	{
+		// the animation frame number must be exactly on a keyframe
+		return keyDataVector[static_cast<size_t>(lowerKeyframeIndex)].m_keyValue;
+	}
+	else
+	{
+		//-- find closest keyframe occurring on or after animation frame number
+		int upperKeyframeIndex = lowerKeyframeIndex + 1;
+		VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, upperKeyframeIndex, static_cast<int>(keyDataVector.size()));
+		VALIDATE_RANGE_INCLUSIVE_INCLUSIVE(keyDataVector[static_cast<size_t>(lowerKeyframeIndex)].m_frameNumber, frameTime, keyDataVector[static_cast<size_t>(upperKeyframeIndex)].m_frameNumber);
+
+		const float lowerKeyframeWeight = (keyDataVector[static_cast<size_t>(upperKeyframeIndex)].m_frameNumber - frameTime) * oneOverFrameDistance;
+		return (lowerKeyframeWeight * keyDataVector[static_cast<size_t>(lowerKeyframeIndex)].m_keyValue) + ((1.0f - lowerKeyframeWeight) * keyDataVector[static_cast<size_t>(upperKeyframeIndex)].m_keyValue);
+	}
+}
+
+// ----------------------------------------------------------------------
+
+Vector CompressedKeyframeAnimationTemplate::computeVectorFromKeys(const VectorKeyDataVector &keyDataVector, float frameTime, int &startKeyIndex)
+{
+	DEBUG_FATAL(keyDataVector.empty(), ("No keys in this animation channel's data."));
+
+	const int keyCount = static_cast<int>(keyDataVector.size());
+
+	//-- find closest keyframe occurring on or before animation frame number
+	int const lowerKeyframeIndex = findLowerKeyframeIndex(keyDataVector, frameTime, startKeyIndex);
 
 	//-- get frame distance to next key
 	const real oneOverFrameDistance = keyDataVector[static_cast<size_t>(lowerKeyframeIndex)].m_oneOverDistanceToNextKeyframe;
@@ -1089,6 +1206,59 @@ void CompressedKeyframeAnimationTemplate::getSignaledMessages(int beginFrameNumb
 	std::for_each(m_messages->begin(), m_messages->end(), SignaledMessageReporter(signaledMessageIndices, signaledMessageFrameNumbers, beginFrameNumber, endFrameNumber));
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Return the number of bytes of memory this template keeps resident.
+ *
+ * Used by the AnimationRecompressor report.
+ */
+
+int CompressedKeyframeAnimationTemplate::getResidentByteCount() const
+{
+	size_t byteCount = sizeof(*this);
+
+	byteCount += m_transformInfoVector.capacity() * sizeof(TransformInfo*);
+	{
+		TransformInfoVector::const_iterator const endIt = m_transformInfoVector.end();
+		for (TransformInfoVector::const_iterator it = m_transformInfoVector.begin(); it != endIt; ++it)
+			byteCount += sizeof(TransformInfo) + strlen((*it)->getTransformName().getString()) + 1;
+	}
+
+	byteCount += m_rotationChannels.capacity() * sizeof(RotationChannel);
+	{
+		RotationChannelVector::const_iterator const endIt = m_rotationChannels.end();
+		for (RotationChannelVector::const_iterator it = m_rotationChannels.begin(); it != endIt; ++it)
+			byteCount += it->getKeyDataVector().capacity() * sizeof(QuaternionKeyData);
+	}
+
+	byteCount += m_translationChannels.capacity() * sizeof(TranslationChannel);
+	{
+		TranslationChannelVector::const_iterator const endIt = m_translationChannels.end();
+		for (TranslationChannelVector::const_iterator it = m_translationChannels.begin(); it != endIt; ++it)
+			byteCount += it->getKeyDataVector().capacity() * sizeof(RealKeyData);
+	}
+
+	byteCount += m_staticRotations.capacity() * sizeof(FullCompressedQuaternion);
+	byteCount += m_staticTranslations.capacity() * sizeof(float);
+
+	if (m_messages)
+	{
+		byteCount += sizeof(*m_messages) + m_messages->capacity() * sizeof(Message*);
+
+		MessageVector::const_iterator const endIt = m_messages->end();
+		for (MessageVector::const_iterator it = m_messages->begin(); it != endIt; ++it)
+			byteCount += sizeof(Message) + strlen((*it)->getName().getString()) + 1 + (*it)->getSignaledFrameNumbers().capacity() * sizeof(int);
+	}
+
+	if (m_locomotionRotationChannel)
+		byteCount += sizeof(RotationChannel) + m_locomotionRotationChannel->getKeyDataVector().capacity() * sizeof(QuaternionKeyData);
+
+	if (m_locomotionTranslationKeys)
+		byteCount += sizeof(*m_locomotionTranslationKeys) + m_locomotionTranslationKeys->capacity() * sizeof(VectorKeyData);
+
+	return static_cast<int>(byteCount);
+}
+
 // ======================================================================
 // CompressedKeyframeAnimationTemplate private static member functions
 // ======================================================================
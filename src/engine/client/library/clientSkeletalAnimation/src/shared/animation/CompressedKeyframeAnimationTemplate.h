@@ -117,6 +117,8 @@ public:
 	static void  operator delete(void *data);
 
 	static Quaternion  computeQuaternionFromKeys(const RotationChannel &rotationChannel, float frameTime, int &startKeyIndex);
+	static void        computeQuaternionsFromKeys(int channelCount, RotationChannel const *const *rotationChannels, int const *transformIndices, float frameTime, int *startKeyIndices, Quaternion *rotations);
+	static float       computeRealFromKeys(const RealKeyDataVector &keyDataVector, float frameTime, int &startKeyIndex);
 	static Vector      computeVectorFromKeys(const VectorKeyDataVector &keyDataVector, float frameTime, int &startKeyIndex);
 
 	// ignore these: they are intended for implementation only
@@ -166,6 +168,8 @@ public:
 
 	float                          getAverageTranslationSpeed() const;
 
+	int                            getResidentByteCount() const;
+
 private:
 
 	class FullCompressedQuaternion;
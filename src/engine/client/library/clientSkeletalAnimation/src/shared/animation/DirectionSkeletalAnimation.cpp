@@ -171,6 +171,27 @@ void DirectionSkeletalAnimation::evaluateTransformComponents(int index, Quaterni
 
 // ----------------------------------------------------------------------
 
+void DirectionSkeletalAnimation::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	m_currentAnimation->evaluateAllTransformComponents(rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
+bool DirectionSkeletalAnimation::addPoseCacheKey(PoseCache::Key &key) const
+{
+	return m_currentAnimation->addPoseCacheKey(key);
+}
+
+// ----------------------------------------------------------------------
+
+void DirectionSkeletalAnimation::receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations)
+{
+	m_currentAnimation->receiveCachedPose(transformCount, rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
 int DirectionSkeletalAnimation::getTransformPriority(int index) const
 {
 	return m_currentAnimation->getTransformPriority(index);
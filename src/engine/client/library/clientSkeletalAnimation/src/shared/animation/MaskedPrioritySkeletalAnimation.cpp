@@ -76,6 +76,27 @@ void MaskedPrioritySkeletalAnimation::evaluateTransformComponents(int index, Qua
 
 // ----------------------------------------------------------------------
 
+void MaskedPrioritySkeletalAnimation::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	m_animation.evaluateAllTransformComponents(rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
+bool MaskedPrioritySkeletalAnimation::addPoseCacheKey(PoseCache::Key &key) const
+{
+	return m_animation.addPoseCacheKey(key);
+}
+
+// ----------------------------------------------------------------------
+
+void MaskedPrioritySkeletalAnimation::receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations)
+{
+	m_animation.receiveCachedPose(transformCount, rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
 void MaskedPrioritySkeletalAnimation::getScaledLocomotion(Quaternion &rotation, Vector &translation) const
 {
 	m_animation.getScaledLocomotion(rotation, translation);
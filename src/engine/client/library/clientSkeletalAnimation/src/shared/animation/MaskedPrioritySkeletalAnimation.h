@@ -35,6 +35,9 @@ public:
 
 	virtual int                      getTransformCount() const;
 	virtual void                     evaluateTransformComponents(int index, Quaternion &rotation, Vector &translation);
+	virtual void                     evaluateAllTransformComponents(Quaternion *rotations, Vector *translations);
+	virtual bool                     addPoseCacheKey(PoseCache::Key &key) const;
+	virtual void                     receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations);
 
 	virtual void                     getScaledLocomotion(Quaternion &rotation, Vector &translation) const;
 
@@ -0,0 +1,459 @@
+// ======================================================================
+//
+// PoseCache.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientSkeletalAnimation/FirstClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/PoseCache.h"
+
+#include "clientSkeletalAnimation/ConfigClientSkeletalAnimation.h"
+#include "sharedDebug/DebugFlags.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedFoundation/Os.h"
+#include "sharedFoundation/PointerDeleter.h"
+#include "sharedMath/Quaternion.h"
+#include "sharedMath/Vector.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+// ======================================================================
+
+namespace PoseCacheNamespace
+{
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	typedef std::vector<Quaternion>  QuaternionVector;
+	typedef std::vector<Vector>      VectorVector;
+
+	struct Entry
+	{
+		QuaternionVector  rotations;
+		VectorVector      translations;
+		int               lastUsedFrameNumber;
+	};
+
+	typedef std::map<PoseCache::Key, Entry*>  EntryMap;
+	typedef std::vector<Entry*>               EntryVector;
+
+	struct FrameStatistics
+	{
+		int   lookupCount;
+		int   hitCount;
+		int   storeCount;
+		int   evictionCount;
+		int   rejectedCount;
+		float missEvaluationTime;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	void   remove();
+	void   rollFrame();
+	Entry *allocateEntry(PoseCache::Key const &key);
+	void   freeEntry(EntryMap::iterator it);
+	void   clearEntries();
+	void   reportStatistics();
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	int const   cs_blendFractionStepCount = 16;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	bool             s_installed;
+
+	bool             s_enabled;
+	bool             s_reportStatistics;
+	int              s_maxEntryCount;
+	float            s_frameQuantum;
+	float            s_ooFrameQuantum;
+	int              s_snappingDepth;
+
+	EntryMap         s_entries;
+	EntryVector      s_freeEntries;
+
+	int              s_frameNumber;
+	int              s_entriesUsedThisFrame;
+	FrameStatistics  s_currentFrame;
+	FrameStatistics  s_previousFrame;
+}
+
+using namespace PoseCacheNamespace;
+
+// ======================================================================
+// namespace PoseCacheNamespace
+// ======================================================================
+
+void PoseCacheNamespace::remove()
+{
+	DEBUG_FATAL(!s_installed, ("PoseCache not installed."));
+	s_installed = false;
+
+	DebugFlags::unregisterFlag(s_enabled);
+	DebugFlags::unregisterFlag(s_reportStatistics);
+
+	clearEntries();
+
+	std::for_each(s_freeEntries.begin(), s_freeEntries.end(), PointerDeleter());
+	EntryVector().swap(s_freeEntries);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Evict entries that went unused for a full frame.
+ *
+ * Animation is evaluated once per frame, so a pose that no skeleton asked
+ * for during the previous frame is not going to be asked for again.
+ */
+
+void PoseCacheNamespace::rollFrame()
+{
+	int const frameNumber = Os::getNumberOfUpdates();
+	if (frameNumber == s_frameNumber)
+		return;
+
+	s_frameNumber          = frameNumber;
+	s_entriesUsedThisFrame = 0;
+	s_previousFrame        = s_currentFrame;
+	memset(&s_currentFrame, 0, sizeof(s_currentFrame));
+
+	for (EntryMap::iterator it = s_entries.begin(); it != s_entries.end(); )
+	{
+		if (it->second->lastUsedFrameNumber < frameNumber - 1)
+		{
+			++s_currentFrame.evictionCount;
+			freeEntry(it++);
+		}
+		else
+			++it;
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Make room for a new entry, replacing the least recently used one if needed.
+ *
+ * @return  the new entry, or NULL if every entry was used this frame.
+ */
+
+Entry *PoseCacheNamespace::allocateEntry(PoseCache::Key const &key)
+{
+	int const entryCount = static_cast<int>(s_entries.size());
+	if (entryCount >= s_maxEntryCount)
+	{
+		if (s_entriesUsedThisFrame >= entryCount)
+			return NULL;
+
+		EntryMap::iterator lruIt = s_entries.begin();
+		for (EntryMap::iterator it = s_entries.begin(); it != s_entries.end(); ++it)
+		{
+			if (it->second->lastUsedFrameNumber < lruIt->second->lastUsedFrameNumber)
+				lruIt = it;
+		}
+
+		if (lruIt->second->lastUsedFrameNumber >= s_frameNumber)
+			return NULL;
+
+		++s_currentFrame.evictionCount;
+		freeEntry(lruIt);
+	}
+
+	Entry *entry;
+	if (!s_freeEntries.empty())
+	{
+		entry = s_freeEntries.back();
+		s_freeEntries.pop_back();
+	}
+	else
+		entry = new Entry;
+
+	IGNORE_RETURN(s_entries.insert(EntryMap::value_type(key, entry)));
+	return entry;
+}
+
+// ----------------------------------------------------------------------
+
+void PoseCacheNamespace::freeEntry(EntryMap::iterator it)
+{
+	s_freeEntries.push_back(it->second);
+	s_entries.erase(it);
+}
+
+// ----------------------------------------------------------------------
+
+void PoseCacheNamespace::clearEntries()
+{
+	while (!s_entries.empty())
+		freeEntry(s_entries.begin());
+
+	s_entriesUsedThisFrame = 0;
+}
+
+// ----------------------------------------------------------------------
+
+void PoseCacheNamespace::reportStatistics()
+{
+	FrameStatistics const &frame = s_previousFrame;
+
+	int const   missCount     = frame.lookupCount - frame.hitCount;
+	float const hitPercent    = (frame.lookupCount > 0) ? 100.0f * static_cast<float>(frame.hitCount) / static_cast<float>(frame.lookupCount) : 0.0f;
+	float const missCost      = (missCount > 0) ? frame.missEvaluationTime / static_cast<float>(missCount) : 0.0f;
+	float const savedTime     = missCost * static_cast<float>(frame.hitCount);
+
+	DEBUG_REPORT_PRINT(true, ("-- PoseCache %s\n", s_enabled ? "" : "(disabled)"));
+	DEBUG_REPORT_PRINT(true, ("  entries = %d/%d, lookups = %d, hits = %d (%1.1f%%)\n", static_cast<int>(s_entries.size()), s_maxEntryCount, frame.lookupCount, frame.hitCount, hitPercent));
+	DEBUG_REPORT_PRINT(true, ("  stored = %d, evicted = %d, rejected = %d\n", frame.storeCount, frame.evictionCount, frame.rejectedCount));
+	DEBUG_REPORT_PRINT(true, ("  evaluation = %1.3f ms, ~%1.3f ms saved\n", frame.missEvaluationTime * 1000.0f, savedTime * 1000.0f));
+}
+
+// ======================================================================
+// class PoseCache::Key
+// ======================================================================
+
+PoseCache::Key::Key() :
+	m_valueCount(0),
+	m_overflow(false)
+{
+}
+
+// ----------------------------------------------------------------------
+
+void PoseCache::Key::addPointer(void const *pointer)
+{
+	if (m_valueCount >= cs_maxValueCount)
+	{
+		m_overflow = true;
+		return;
+	}
+
+	m_values[m_valueCount++] = reinterpret_cast<size_t>(pointer);
+}
+
+// ----------------------------------------------------------------------
+
+void PoseCache::Key::addInt(int value)
+{
+	if (m_valueCount >= cs_maxValueCount)
+	{
+		m_overflow = true;
+		return;
+	}
+
+	m_values[m_valueCount++] = static_cast<size_t>(static_cast<unsigned int>(value));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * A key is valid if every value that was added to it fit.
+ */
+
+bool PoseCache::Key::isValid() const
+{
+	return !m_overflow && (m_valueCount > 0);
+}
+
+// ----------------------------------------------------------------------
+
+bool PoseCache::Key::operator <(Key const &rhs) const
+{
+	if (m_valueCount != rhs.m_valueCount)
+		return m_valueCount < rhs.m_valueCount;
+
+	return std::lexicographical_compare(m_values, m_values + m_valueCount, rhs.m_values, rhs.m_values + rhs.m_valueCount);
+}
+
+// ======================================================================
+// class PoseCache: PUBLIC STATIC
+// ======================================================================
+
+void PoseCache::install()
+{
+	DEBUG_FATAL(s_installed, ("PoseCache already installed."));
+
+	s_enabled        = ConfigClientSkeletalAnimation::getPoseCacheEnable();
+	s_maxEntryCount  = std::max(1, ConfigClientSkeletalAnimation::getPoseCacheMaxEntries());
+	s_frameQuantum   = std::max(0.01f, ConfigClientSkeletalAnimation::getPoseCacheFrameQuantum());
+	s_ooFrameQuantum = 1.0f / s_frameQuantum;
+
+	s_frameNumber          = -1;
+	s_entriesUsedThisFrame = 0;
+	memset(&s_currentFrame, 0, sizeof(s_currentFrame));
+	memset(&s_previousFrame, 0, sizeof(s_previousFrame));
+
+	DebugFlags::registerFlag(s_enabled, "ClientSkeletalAnimation/PoseCache", "enabled");
+	DebugFlags::registerFlag(s_reportStatistics, "ClientSkeletalAnimation/PoseCache", "reportStatistics", reportStatistics);
+
+	s_installed = true;
+	ExitChain::add(PoseCacheNamespace::remove, "PoseCache");
+}
+
+// ----------------------------------------------------------------------
+
+bool PoseCache::isEnabled()
+{
+	return s_enabled;
+}
+
+// ----------------------------------------------------------------------
+
+void PoseCache::setEnabled(bool enabled)
+{
+	s_enabled = enabled;
+
+	if (!enabled)
+		clearEntries();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Snap the animations evaluated until the matching endSnapping() call.
+ *
+ * Calls nest, so a track evaluated inside a cached tree stays snapped.
+ */
+
+void PoseCache::beginSnapping()
+{
+	++s_snappingDepth;
+}
+
+// ----------------------------------------------------------------------
+
+void PoseCache::endSnapping()
+{
+	DEBUG_FATAL(s_snappingDepth <= 0, ("PoseCache::endSnapping() without beginSnapping()."));
+	--s_snappingDepth;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Check whether animations should snap their frame numbers and blend
+ * fractions the way the cache keys them.
+ */
+
+bool PoseCache::isSnapping()
+{
+	return s_snappingDepth > 0;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Snap a frame number to the nearest multiple of the frame quantum.
+ */
+
+float PoseCache::snapFrameNumber(float frameNumber)
+{
+	return static_cast<float>(getFrameNumberKey(frameNumber)) * s_frameQuantum;
+}
+
+// ----------------------------------------------------------------------
+
+int PoseCache::getFrameNumberKey(float snappedFrameNumber)
+{
+	return static_cast<int>(floor(static_cast<double>(snappedFrameNumber * s_ooFrameQuantum + 0.5f)));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Snap a blend fraction to the nearest of a fixed number of steps in [0, 1].
+ */
+
+float PoseCache::snapBlendFraction(float blendFraction)
+{
+	return static_cast<float>(getBlendFractionKey(blendFraction)) / static_cast<float>(cs_blendFractionStepCount);
+}
+
+// ----------------------------------------------------------------------
+
+int PoseCache::getBlendFractionKey(float snappedBlendFraction)
+{
+	int const step = static_cast<int>(floor(static_cast<double>(snappedBlendFraction * static_cast<float>(cs_blendFractionStepCount) + 0.5f)));
+	return std::max(0, std::min(cs_blendFractionStepCount, step));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Copy a cached pose into the caller's arrays.
+ *
+ * @return  true if the pose was cached; false if the caller must evaluate
+ *          it (and should then call storePose()).
+ */
+
+bool PoseCache::fetchPose(Key const &key, int transformCount, Quaternion *rotations, Vector *translations)
+{
+	DEBUG_FATAL(!s_installed, ("PoseCache not installed."));
+	NOT_NULL(rotations);
+	NOT_NULL(translations);
+
+	if (!s_enabled || !key.isValid())
+		return false;
+
+	rollFrame();
+	++s_currentFrame.lookupCount;
+
+	EntryMap::iterator const it = s_entries.find(key);
+	if (it == s_entries.end())
+		return false;
+
+	Entry &entry = *it->second;
+	if (static_cast<int>(entry.rotations.size()) != transformCount)
+	{
+		DEBUG_WARNING(true, ("PoseCache: cached pose has %d transforms, caller expects %d.", static_cast<int>(entry.rotations.size()), transformCount));
+		return false;
+	}
+
+	if (entry.lastUsedFrameNumber != s_frameNumber)
+	{
+		entry.lastUsedFrameNumber = s_frameNumber;
+		++s_entriesUsedThisFrame;
+	}
+
+	IGNORE_RETURN(std::copy(entry.rotations.begin(), entry.rotations.end(), rotations));
+	IGNORE_RETURN(std::copy(entry.translations.begin(), entry.translations.end(), translations));
+
+	++s_currentFrame.hitCount;
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Cache a pose the caller just evaluated after a fetchPose() miss.
+ *
+ * @param evaluationTime  the time the caller spent evaluating the pose,
+ *                        used to estimate the time saved by later hits.
+ */
+
+void PoseCache::storePose(Key const &key, int transformCount, Quaternion const *rotations, Vector const *translations, float evaluationTime)
+{
+	DEBUG_FATAL(!s_installed, ("PoseCache not installed."));
+	NOT_NULL(rotations);
+	NOT_NULL(translations);
+
+	if (!s_enabled || !key.isValid())
+		return;
+
+	rollFrame();
+	s_currentFrame.missEvaluationTime += evaluationTime;
+
+	if (s_entries.find(key) != s_entries.end())
+		return;
+
+	Entry *const entry = allocateEntry(key);
+	if (!entry)
+	{
+		++s_currentFrame.rejectedCount;
+		return;
+	}
+
+	entry->rotations.assign(rotations, rotations + transformCount);
+	entry->translations.assign(translations, translations + transformCount);
+	entry->lastUsedFrameNumber = s_frameNumber;
+
+	++s_entriesUsedThisFrame;
+	++s_currentFrame.storeCount;
+}
+
+// ======================================================================
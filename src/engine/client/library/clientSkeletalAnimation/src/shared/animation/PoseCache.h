@@ -0,0 +1,96 @@
+// ======================================================================
+//
+// PoseCache.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_PoseCache_H
+#define INCLUDED_PoseCache_H
+
+// ======================================================================
+
+class Quaternion;
+class Vector;
+
+// ======================================================================
+/**
+ * Shares evaluated animation poses between skeletons that play the same
+ * animation at the same point in time.
+ *
+ * Crowds of NPCs tend to play a handful of idle animations.  While an
+ * animation tree's key is built and its pose is evaluated for the cache, the
+ * tree is snapped: frame numbers to the frame quantum and blend fractions to
+ * a fixed number of steps.  Any two skeletons built from the same skeleton
+ * template whose trees resolve to the same key therefore get bit-identical
+ * poses.  The first one to evaluate stores its pose, the others copy it.
+ * Trees that decline a key are evaluated at their exact time.
+ *
+ * Entries that were not used during the previous frame are evicted when the
+ * frame rolls over.  When the cache is full, the least recently used entry
+ * is replaced if it belongs to an older frame; otherwise the new pose is not
+ * cached.
+ *
+ * The cache is only touched by the thread that evaluates animation.
+ */
+
+class PoseCache
+{
+public:
+
+	/**
+	 * Identifies a pose.  Animations describe themselves by appending the
+	 * values their pose depends on; see SkeletalAnimation::addPoseCacheKey().
+	 */
+	class Key
+	{
+	public:
+
+		Key();
+
+		void  addPointer(void const *pointer);
+		void  addInt(int value);
+
+		bool  isValid() const;
+
+		bool  operator <(Key const &rhs) const;
+
+	private:
+
+		enum
+		{
+			cs_maxValueCount = 16
+		};
+
+	private:
+
+		size_t m_values[cs_maxValueCount];
+		int    m_valueCount;
+		bool   m_overflow;
+	};
+
+public:
+
+	static void  install();
+
+	static bool  isEnabled();
+	static void  setEnabled(bool enabled);
+
+	static void  beginSnapping();
+	static void  endSnapping();
+	static bool  isSnapping();
+
+	static float snapFrameNumber(float frameNumber);
+	static int   getFrameNumberKey(float snappedFrameNumber);
+
+	static float snapBlendFraction(float blendFraction);
+	static int   getBlendFractionKey(float snappedBlendFraction);
+
+	static bool  fetchPose(Key const &key, int transformCount, Quaternion *rotations, Vector *translations);
+	static void  storePose(Key const &key, int transformCount, Quaternion const *rotations, Vector const *translations, float evaluationTime);
+
+};
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,382 @@
+// ======================================================================
+//
+// QuantizedKeyframeAnimation.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientSkeletalAnimation/FirstClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/QuantizedKeyframeAnimation.h"
+
+#include "clientSkeletalAnimation/AnimationEnvironment.h"
+#include "clientSkeletalAnimation/AnimationEnvironmentNames.h"
+#include "clientSkeletalAnimation/PoseCache.h"
+#include "clientSkeletalAnimation/QuantizedKeyframeAnimationTemplate.h"
+#include "clientSkeletalAnimation/TransformNameMap.h"
+#include "sharedDebug/Profiler.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedFoundation/MemoryBlockManager.h"
+#include "sharedMath/Quaternion.h"
+#include "sharedMath/Vector.h"
+
+#include <algorithm>
+#include <vector>
+
+// ======================================================================
+
+namespace QuantizedKeyframeAnimationNamespace
+{
+	bool  s_installed;
+}
+
+using namespace QuantizedKeyframeAnimationNamespace;
+
+// ======================================================================
+
+MemoryBlockManager *QuantizedKeyframeAnimation::ms_memoryBlockManager;
+
+// ======================================================================
+// class QuantizedKeyframeAnimation: public static member functions
+// ======================================================================
+
+void QuantizedKeyframeAnimation::install()
+{
+	DEBUG_FATAL(s_installed, ("QuantizedKeyframeAnimation already installed"));
+
+	ms_memoryBlockManager = new MemoryBlockManager("QuantizedKeyframeAnimation", true, sizeof(QuantizedKeyframeAnimation), 0, 0, 0);
+
+	s_installed = true;
+	ExitChain::add(remove, "QuantizedKeyframeAnimation");
+}
+
+// ----------------------------------------------------------------------
+
+void *QuantizedKeyframeAnimation::operator new(size_t size)
+{
+	DEBUG_FATAL(!s_installed, ("QuantizedKeyframeAnimation not installed"));
+	DEBUG_FATAL(size != sizeof(QuantizedKeyframeAnimation), ("derived types not supported with this operator new"));
+	UNREF(size);
+
+	return ms_memoryBlockManager->allocate();
+}
+
+// ----------------------------------------------------------------------
+
+void QuantizedKeyframeAnimation::operator delete(void *data)
+{
+	ms_memoryBlockManager->free(data);
+}
+
+// ======================================================================
+// class QuantizedKeyframeAnimation: public member functions
+// ======================================================================
+
+bool QuantizedKeyframeAnimation::alterSingleCycle(float deltaTime, SkeletalAnimation *&replacementAnimation, float &deltaTimeRemaining)
+{
+	UNREF(replacementAnimation);
+
+	m_previousFrameNumber = m_currentFrameNumber;
+
+	//-- Apply time up to the end of the cycle.
+	m_currentCycleTime += deltaTime;
+	if (m_currentCycleTime > m_cyclePeriod)
+	{
+		deltaTimeRemaining = m_currentCycleTime - m_cyclePeriod;
+		m_currentCycleTime = m_cyclePeriod;
+
+		//-- A single-frame animation eats up all of the time.
+		if (m_cyclePeriod <= 0.0f)
+			deltaTimeRemaining = 0.0f;
+	}
+	else
+		deltaTimeRemaining = 0.0f;
+
+	m_currentFrameNumber = std::min(m_currentCycleTime * m_playbackFramesPerSecond, m_frameCount);
+
+	return true;
+} //lint !e1764 // make replacementAnimation const ref // sorry, part of contract.
+
+// ----------------------------------------------------------------------
+
+void QuantizedKeyframeAnimation::startNewCycle()
+{
+	m_currentCycleTime    = 0.0f;
+	m_previousFrameNumber = 0.0f;
+	m_currentFrameNumber  = 0.0f;
+}
+
+// ----------------------------------------------------------------------
+
+int QuantizedKeyframeAnimation::getTransformCount() const
+{
+	return static_cast<int>(m_animationTransformIndices->size());
+}
+
+// ----------------------------------------------------------------------
+
+void QuantizedKeyframeAnimation::evaluateTransformComponents(int index, Quaternion &rotation, Vector &translation)
+{
+	NP_PROFILER_AUTO_BLOCK_DEFINE("QuantizedKeyframeAnimation::evaluateTransformComponents");
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, index, getTransformCount());
+
+	int const animationTransformIndex = (*m_animationTransformIndices)[static_cast<size_t>(index)];
+	if (animationTransformIndex < 0)
+	{
+		rotation    = Quaternion::identity;
+		translation = Vector::zero;
+	}
+	else
+		NON_NULL(getOurTemplate())->evaluateTransform(animationTransformIndex, getPoseFrameNumber(), rotation, translation);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Evaluate every transform of the animation in one pass.
+ *
+ * The template expands all of its tracks at once into the component
+ * buffer, then each skeleton transform picks up its components.
+ */
+
+void QuantizedKeyframeAnimation::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	NP_PROFILER_AUTO_BLOCK_DEFINE("QuantizedKeyframeAnimation::evaluateAllTransformComponents");
+
+	NOT_NULL(rotations);
+	NOT_NULL(translations);
+
+	float *const components = m_components->empty() ? 0 : &(*m_components)[0];
+	if (components)
+		NON_NULL(getOurTemplate())->evaluateAllComponents(getPoseFrameNumber(), components);
+
+	int const transformCount = getTransformCount();
+	for (int i = 0; i < transformCount; ++i)
+	{
+		int const animationTransformIndex = (*m_animationTransformIndices)[static_cast<size_t>(i)];
+		if (animationTransformIndex < 0)
+		{
+			rotations[i]    = Quaternion::identity;
+			translations[i] = Vector::zero;
+		}
+		else
+			QuantizedKeyframeAnimationTemplate::getTransformFromComponents(components + animationTransformIndex * QuantizedKeyframeAnimationTemplate::C_componentCount, rotations[i], translations[i]);
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * The pose of a keyframe animation only depends on the animation template,
+ * the skeleton it is bound to and the frame it is evaluated at.
+ */
+
+bool QuantizedKeyframeAnimation::addPoseCacheKey(PoseCache::Key &key) const
+{
+	key.addPointer(getSkeletalAnimationTemplate());
+	key.addInt(PoseCache::getFrameNumberKey(getPoseFrameNumber()));
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+int QuantizedKeyframeAnimation::getTransformPriority(int index) const
+{
+	UNREF(index);
+	return 0;
+}
+
+// ----------------------------------------------------------------------
+
+int QuantizedKeyframeAnimation::getLocomotionPriority() const
+{
+	return 0;
+}
+
+// ----------------------------------------------------------------------
+
+void QuantizedKeyframeAnimation::getScaledLocomotion(Quaternion &rotation, Vector &translation) const
+{
+	NON_NULL(getOurTemplate())->getLocomotion(m_previousFrameNumber, m_currentFrameNumber, m_rotationStartKeyIndex, m_translationStartKeyIndex, rotation, translation);
+
+	//-- Scale translation appropriately.  Rotation is ignored.
+	translation *= m_scale;
+}
+
+// ----------------------------------------------------------------------
+
+float QuantizedKeyframeAnimation::getCycleScaledLocomotionDistance() const
+{
+	int        tempRotationKey    = 0;
+	int        tempTranslationKey = 0;
+	Quaternion tempRotation;
+	Vector     tempTranslation;
+
+	NON_NULL(getOurTemplate())->getLocomotion(0.0f, m_frameCount, tempRotationKey, tempTranslationKey, tempRotation, tempTranslation);
+
+	return tempTranslation.magnitude() * m_scale;
+}
+
+// ----------------------------------------------------------------------
+
+int QuantizedKeyframeAnimation::getFrameCount() const
+{
+	return NON_NULL(getOurTemplate())->getFrameCount();
+}
+
+// ----------------------------------------------------------------------
+
+float QuantizedKeyframeAnimation::getRecordedFramesPerSecond() const
+{
+	return NON_NULL(getOurTemplate())->getFramesPerSecond();
+}
+
+// ----------------------------------------------------------------------
+
+void QuantizedKeyframeAnimation::setPlaybackFramesPerSecond(float playbackFramesPerSecond)
+{
+	if (playbackFramesPerSecond <= 0.0f)
+		return;
+
+	m_playbackFramesPerSecond   = playbackFramesPerSecond;
+	m_ooPlaybackFramesPerSecond = 1.0f / m_playbackFramesPerSecond;
+
+	//-- Calculate cycle period.
+	if (m_frameCount > 0.0f)
+	{
+		m_cyclePeriod      = m_frameCount / playbackFramesPerSecond;
+		m_currentCycleTime = (m_currentFrameNumber / m_frameCount) * m_cyclePeriod;
+	}
+	else
+		m_cyclePeriod = 0.0f;
+}
+
+// ----------------------------------------------------------------------
+
+float QuantizedKeyframeAnimation::getPlaybackFramesPerSecond() const
+{
+	return m_playbackFramesPerSecond;
+}
+
+// ----------------------------------------------------------------------
+
+int QuantizedKeyframeAnimation::getMessageCount() const
+{
+	return NON_NULL(getOurTemplate())->getMessageCount();
+}
+
+// ----------------------------------------------------------------------
+
+const CrcLowerString &QuantizedKeyframeAnimation::getMessageName(int index) const
+{
+	return NON_NULL(getOurTemplate())->getMessageName(index);
+}
+
+// ----------------------------------------------------------------------
+
+void QuantizedKeyframeAnimation::getSignaledMessages(stdvector<int>::fwd &signaledMessageIndices, stdvector<float>::fwd &elapsedTimeSinceSignal) const
+{
+	//-- Calculate integral range [begin message scan, endMessageScan), an (inclusive, exclusive) range.
+	const int beginRange = static_cast<int>(ceil(static_cast<double>(m_previousFrameNumber)));
+	const int endRange   = static_cast<int>(ceil(static_cast<double>(m_currentFrameNumber)));
+
+	NON_NULL(getOurTemplate())->getSignaledMessages(beginRange, endRange, signaledMessageIndices, elapsedTimeSinceSignal);
+	DEBUG_FATAL(signaledMessageIndices.size() != elapsedTimeSinceSignal.size(), ("getSignaledMessages(): returned unbalanced data [%d/%d].", static_cast<int>(signaledMessageIndices.size()), static_cast<int>(elapsedTimeSinceSignal.size())));
+
+	//-- ElapsedTimeSinceSignal contains the frame numbers of signals right now.  Convert from frames to time.
+	size_t const entryCount = elapsedTimeSinceSignal.size();
+	for (size_t i = 0; i < entryCount; ++i)
+	{
+		float const signalFrameNumber = elapsedTimeSinceSignal[i];
+
+		if (signalFrameNumber <= m_currentFrameNumber)
+			elapsedTimeSinceSignal[i] = (m_currentFrameNumber - signalFrameNumber) * m_ooPlaybackFramesPerSecond;
+		else
+			elapsedTimeSinceSignal[i] = ((m_frameCount - signalFrameNumber) + m_currentFrameNumber) * m_ooPlaybackFramesPerSecond;
+	}
+}
+
+// ----------------------------------------------------------------------
+
+SkeletalAnimation *QuantizedKeyframeAnimation::resolveSkeletalAnimation()
+{
+	// I'm at a leaf animation, so return NULL.
+	return 0;
+}
+
+// ======================================================================
+// class QuantizedKeyframeAnimation: private static member functions
+// ======================================================================
+
+void QuantizedKeyframeAnimation::remove()
+{
+	DEBUG_FATAL(!s_installed, ("QuantizedKeyframeAnimation not installed"));
+
+	s_installed = false;
+
+	delete ms_memoryBlockManager;
+	ms_memoryBlockManager = 0;
+}
+
+// ======================================================================
+// class QuantizedKeyframeAnimation: private member functions
+// ======================================================================
+
+QuantizedKeyframeAnimation::QuantizedKeyframeAnimation(const QuantizedKeyframeAnimationTemplate *skeletalAnimationTemplate, const AnimationEnvironment &animationEnvironment, const TransformNameMap &skeletonTransformNameMap) :
+	SkeletalAnimation(skeletalAnimationTemplate),
+	m_currentFrameNumber(0.0f),
+	m_previousFrameNumber(0.0f),
+	m_currentCycleTime(0.0f),
+	m_cyclePeriod(1.0f),
+	m_playbackFramesPerSecond(30.0f),
+	m_ooPlaybackFramesPerSecond(1.0f / 30.0f),
+	m_frameCount(static_cast<float>(NON_NULL(skeletalAnimationTemplate)->getFrameCount())),
+	m_animationTransformIndices(new IntVector(static_cast<size_t>(skeletonTransformNameMap.getTransformCount()), -1)),
+	m_components(new FloatVector(static_cast<size_t>(skeletalAnimationTemplate->getTransformCount() * QuantizedKeyframeAnimationTemplate::C_componentCount))),
+	m_rotationStartKeyIndex(0),
+	m_translationStartKeyIndex(0),
+	m_scale(animationEnvironment.getConstFloat(AnimationEnvironmentNames::cms_appearanceScale)),
+	m_posePhaseOffset(animationEnvironment.getConstFloat(AnimationEnvironmentNames::cms_posePhaseOffset))
+{
+	QuantizedKeyframeAnimation::setPlaybackFramesPerSecond(QuantizedKeyframeAnimation::getRecordedFramesPerSecond());
+
+	//-- Map each skeleton transform to its transform in the animation.
+	int const transformCount = skeletonTransformNameMap.getTransformCount();
+	for (int i = 0; i < transformCount; ++i)
+		(*m_animationTransformIndices)[static_cast<size_t>(i)] = skeletalAnimationTemplate->getTransformIndex(skeletonTransformNameMap.getTransformName(i));
+}
+
+// ----------------------------------------------------------------------
+
+QuantizedKeyframeAnimation::~QuantizedKeyframeAnimation()
+{
+	delete m_components;
+	delete m_animationTransformIndices;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the frame number the pose is evaluated at.
+ *
+ * @see CompressedKeyframeAnimation::getPoseFrameNumber()
+ */
+
+float QuantizedKeyframeAnimation::getPoseFrameNumber() const
+{
+	float frameNumber = m_currentFrameNumber;
+
+	bool const snap = PoseCache::isSnapping();
+
+	if ((m_posePhaseOffset != 0.0f) && (m_frameCount > 0.0f))
+	{
+		float const phaseFrameOffset = m_posePhaseOffset * m_playbackFramesPerSecond;
+		frameNumber = static_cast<float>(fmod(static_cast<double>(frameNumber + (snap ? PoseCache::snapFrameNumber(phaseFrameOffset) : phaseFrameOffset)), static_cast<double>(m_frameCount)));
+		if (frameNumber < 0.0f)
+			frameNumber += m_frameCount;
+	}
+
+	if (snap)
+		frameNumber = std::min(PoseCache::snapFrameNumber(frameNumber), m_frameCount);
+
+	return frameNumber;
+}
+
+// ======================================================================
@@ -0,0 +1,123 @@
+// PRIVATE
+
+// ======================================================================
+//
+// QuantizedKeyframeAnimation.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_QuantizedKeyframeAnimation_H
+#define INCLUDED_QuantizedKeyframeAnimation_H
+
+// ======================================================================
+
+#include "clientSkeletalAnimation/SkeletalAnimation.h"
+
+class AnimationEnvironment;
+class MemoryBlockManager;
+class QuantizedKeyframeAnimationTemplate;
+
+// ======================================================================
+/**
+ * Plays a QuantizedKeyframeAnimationTemplate on a skeleton.
+ */
+
+class QuantizedKeyframeAnimation: public SkeletalAnimation
+{
+friend class QuantizedKeyframeAnimationTemplate;
+
+public:
+
+	static void install();
+
+	static void *operator new(size_t size);
+	static void  operator delete(void *data);
+
+public:
+
+	const QuantizedKeyframeAnimationTemplate *getOurTemplate() const;
+
+	virtual bool                     alterSingleCycle(float deltaTime, SkeletalAnimation *&replacementAnimation, float &deltaTimeRemaining);
+	virtual void                     startNewCycle();
+
+	virtual int                      getTransformCount() const;
+	virtual void                     evaluateTransformComponents(int index, Quaternion &rotation, Vector &translation);
+	virtual void                     evaluateAllTransformComponents(Quaternion *rotations, Vector *translations);
+	virtual bool                     addPoseCacheKey(PoseCache::Key &key) const;
+
+	virtual int                      getTransformPriority(int index) const;
+	virtual int                      getLocomotionPriority() const;
+
+	virtual void                     getScaledLocomotion(Quaternion &rotation, Vector &translation) const;
+
+	virtual float                    getCycleScaledLocomotionDistance() const;
+	virtual int                      getFrameCount() const;
+	virtual float                    getRecordedFramesPerSecond() const;
+
+	virtual void                     setPlaybackFramesPerSecond(float playbackFramesPerSecond);
+	virtual float                    getPlaybackFramesPerSecond() const;
+
+	virtual int                      getMessageCount() const;
+	virtual const CrcLowerString    &getMessageName(int index) const;
+	virtual void                     getSignaledMessages(stdvector<int>::fwd &signaledMessageIndices, stdvector<float>::fwd &elapsedTimeSinceSignal) const;
+
+	virtual SkeletalAnimation       *resolveSkeletalAnimation();
+
+private:
+
+	typedef stdvector<int>::fwd    IntVector;
+	typedef stdvector<float>::fwd  FloatVector;
+
+private:
+
+	static void remove();
+
+private:
+
+	QuantizedKeyframeAnimation(const QuantizedKeyframeAnimationTemplate *skeletalAnimationTemplate, const AnimationEnvironment &animationEnvironment, const TransformNameMap &skeletonTransformNameMap);
+	virtual ~QuantizedKeyframeAnimation();
+
+	float getPoseFrameNumber() const;
+
+	// disabled
+	QuantizedKeyframeAnimation();
+	QuantizedKeyframeAnimation(const QuantizedKeyframeAnimation&);
+	QuantizedKeyframeAnimation &operator =(const QuantizedKeyframeAnimation&);
+
+private:
+
+	static MemoryBlockManager *ms_memoryBlockManager;
+
+private:
+
+	float                      m_currentFrameNumber;
+	float                      m_previousFrameNumber;
+
+	float                      m_currentCycleTime;
+	float                      m_cyclePeriod;
+	float                      m_playbackFramesPerSecond;
+	float                      m_ooPlaybackFramesPerSecond;
+	float                      m_frameCount;
+
+	// The animation transform index of each skeleton transform, -1 if the animation does not contain it.
+	IntVector                 *m_animationTransformIndices;
+	FloatVector               *m_components;
+
+	mutable int                m_rotationStartKeyIndex;
+	mutable int                m_translationStartKeyIndex;
+
+	const float               &m_scale;
+	const float               &m_posePhaseOffset;
+};
+
+// ======================================================================
+
+inline const QuantizedKeyframeAnimationTemplate *QuantizedKeyframeAnimation::getOurTemplate() const
+{
+	return reinterpret_cast<const QuantizedKeyframeAnimationTemplate*>(getSkeletalAnimationTemplate());
+}
+
+// ======================================================================
+
+#endif
@@ -0,0 +1,922 @@
+// ======================================================================
+//
+// QuantizedKeyframeAnimationTemplate.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientSkeletalAnimation/FirstClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/QuantizedKeyframeAnimationTemplate.h"
+
+#include "clientSkeletalAnimation/ConfigClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/QuantizedKeyframeAnimation.h"
+#include "clientSkeletalAnimation/SkeletalAnimationTemplateList.h"
+#include "sharedFile/Iff.h"
+#include "sharedFoundation/CrcLowerString.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedFoundation/MemoryBlockManager.h"
+#include "sharedFoundation/PersistentCrcString.h"
+#include "sharedFoundation/PointerDeleter.h"
+#include "sharedFoundation/Tag.h"
+#include "sharedMath/Quaternion.h"
+#include "sharedMath/Transform.h"
+#include "sharedMath/Vector.h"
+
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+// ======================================================================
+// File format
+// ======================================================================
+//
+// FORM QKAT
+//   FORM 0000
+//     CHUNK INFO
+//       float  frames per second
+//       int16  frame count
+//       int16  transform count
+//       int16  linear track count
+//       int16  narrow track count
+//       int16  wide track count
+//     CHUNK XFRM
+//       [transform count, sorted by CrcString]
+//         string  transform name
+//         [C_componentCount]
+//           uint8  track type
+//           float  constant value, linear start value or quantized minimum
+//           float  linear delta per frame or quantized scale (omitted for constant tracks)
+//     CHUNK NSMP  (optional) uint8  samples, (frame count + 1) rows of narrow track count
+//     CHUNK WSMP  (optional) uint16 samples, (frame count + 1) rows of wide track count
+//     FORM MSGS   (optional)
+//       CHUNK INFO: int16 message count
+//       CHUNK MESG: int16 signal count, string name, int16 signaled frame numbers
+//     CHUNK LOCT  (optional) float average speed, int16 key count, [int16 frame, floatVector]
+//     CHUNK LOCR  (optional) int16 key count, [int16 frame, floatQuaternion]
+//
+// Tracks of each type are numbered in the order their components appear.
+//
+// ======================================================================
+
+struct QuantizedKeyframeAnimationTemplate::LinearTrack
+{
+	float  m_start;
+	float  m_deltaPerFrame;
+	int    m_componentIndex;
+};
+
+// ----------------------------------------------------------------------
+
+struct QuantizedKeyframeAnimationTemplate::QuantizedTrack
+{
+	float  m_minimum;
+	float  m_scale;
+	int    m_componentIndex;
+};
+
+// ----------------------------------------------------------------------
+
+struct QuantizedKeyframeAnimationTemplate::RotationKey
+{
+	float       m_frameNumber;
+	Quaternion  m_rotation;
+};
+
+// ----------------------------------------------------------------------
+
+struct QuantizedKeyframeAnimationTemplate::TranslationKey
+{
+	float   m_frameNumber;
+	Vector  m_translation;
+};
+
+// ----------------------------------------------------------------------
+
+class QuantizedKeyframeAnimationTemplate::Message
+{
+public:
+
+	explicit Message(Iff &iff);
+
+	CrcLowerString const &getName() const;
+	IntVector const      &getSignaledFrameNumbers() const;
+
+private:
+
+	// disabled
+	Message();
+	Message(Message const &);
+	Message &operator =(Message const &);
+
+private:
+
+	CrcLowerString  m_name;
+	IntVector       m_signaledFrameNumbers;
+
+};
+
+// ======================================================================
+
+namespace QuantizedKeyframeAnimationTemplateNamespace
+{
+	Tag const TAG_LOCR = TAG(L,O,C,R);
+	Tag const TAG_LOCT = TAG(L,O,C,T);
+	Tag const TAG_MESG = TAG(M,E,S,G);
+	Tag const TAG_MSGS = TAG(M,S,G,S);
+	Tag const TAG_NSMP = TAG(N,S,M,P);
+	Tag const TAG_QKAT = TAG(Q,K,A,T);
+	Tag const TAG_WSMP = TAG(W,S,M,P);
+	Tag const TAG_XFRM = TAG(X,F,R,M);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct LessNameComparator
+	{
+		bool operator ()(PersistentCrcString const *lhs, CrcString const &rhs) const
+		{
+			return *NON_NULL(lhs) < rhs;
+		}
+
+		bool operator ()(CrcString const &lhs, PersistentCrcString const *rhs) const
+		{
+			return lhs < *NON_NULL(rhs);
+		}
+
+		bool operator ()(PersistentCrcString const *lhs, PersistentCrcString const *rhs) const
+		{
+			return *NON_NULL(lhs) < *NON_NULL(rhs);
+		}
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	//-- Find the key at or before frameTime and the weight of the key after it.  The search
+	//   starts at startKeyIndex when possible, so playing forward costs O(1) per call.
+	template <typename KeyVector>
+	int findLowerKeyIndex(KeyVector const &keys, float const frameTime, int &startKeyIndex, float &upperKeyWeight)
+	{
+		int const keyCount = static_cast<int>(keys.size());
+		DEBUG_FATAL(keyCount < 1, ("no locomotion keys."));
+
+		int lowerKeyIndex = ((startKeyIndex >= 0) && (startKeyIndex < keyCount) && (keys[static_cast<size_t>(startKeyIndex)].m_frameNumber <= frameTime)) ? startKeyIndex : 0;
+		for (; lowerKeyIndex < keyCount - 1; ++lowerKeyIndex)
+		{
+			if (keys[static_cast<size_t>(lowerKeyIndex + 1)].m_frameNumber > frameTime)
+				break;
+		}
+
+		startKeyIndex = lowerKeyIndex;
+
+		if (lowerKeyIndex >= keyCount - 1)
+			upperKeyWeight = 0.0f;
+		else
+		{
+			float const lowerFrameNumber = keys[static_cast<size_t>(lowerKeyIndex)].m_frameNumber;
+			float const upperFrameNumber = keys[static_cast<size_t>(lowerKeyIndex + 1)].m_frameNumber;
+			upperKeyWeight = clamp(0.0f, (frameTime - lowerFrameNumber) / (upperFrameNumber - lowerFrameNumber), 1.0f);
+		}
+
+		return lowerKeyIndex;
+	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename T>
+	int getVectorByteCount(std::vector<T> const &values)
+	{
+		return static_cast<int>(sizeof(values) + values.capacity() * sizeof(T));
+	}
+}
+
+using namespace QuantizedKeyframeAnimationTemplateNamespace;
+
+// ======================================================================
+// static member definitions
+// ======================================================================
+
+bool                QuantizedKeyframeAnimationTemplate::ms_installed;
+MemoryBlockManager *QuantizedKeyframeAnimationTemplate::ms_memoryBlockManager;
+
+// ======================================================================
+// class QuantizedKeyframeAnimationTemplate::Message
+// ======================================================================
+
+QuantizedKeyframeAnimationTemplate::Message::Message(Iff &iff) :
+	m_name(""),
+	m_signaledFrameNumbers()
+{
+	iff.enterChunk(TAG_MESG);
+
+		int const signalCount = static_cast<int>(iff.read_int16());
+		DEBUG_FATAL(signalCount < 1, ("bad signal count %d", signalCount));
+
+		char name[1024];
+		iff.read_string(name, sizeof(name) - 1);
+		m_name.setString(name);
+
+		m_signaledFrameNumbers.reserve(static_cast<size_t>(signalCount));
+		for (int i = 0; i < signalCount; ++i)
+			m_signaledFrameNumbers.push_back(static_cast<int>(iff.read_int16()));
+
+	iff.exitChunk(TAG_MESG);
+}
+
+// ----------------------------------------------------------------------
+
+inline CrcLowerString const &QuantizedKeyframeAnimationTemplate::Message::getName() const
+{
+	return m_name;
+}
+
+// ----------------------------------------------------------------------
+
+inline QuantizedKeyframeAnimationTemplate::IntVector const &QuantizedKeyframeAnimationTemplate::Message::getSignaledFrameNumbers() const
+{
+	return m_signaledFrameNumbers;
+}
+
+// ======================================================================
+// class QuantizedKeyframeAnimationTemplate: public static member functions
+// ======================================================================
+
+void QuantizedKeyframeAnimationTemplate::install()
+{
+	DEBUG_FATAL(ms_installed, ("QuantizedKeyframeAnimationTemplate already installed"));
+
+	const bool success = SkeletalAnimationTemplateList::registerCreateFunction(TAG_QKAT, create);
+	DEBUG_FATAL(!success, ("failed to register QuantizedKeyframeAnimationTemplate"));
+	UNREF(success);
+
+	ms_memoryBlockManager = new MemoryBlockManager("QuantizedKeyframeAnimationTemplate", true, sizeof(QuantizedKeyframeAnimationTemplate), 0, 0, 0);
+
+	ms_installed = true;
+	ExitChain::add(remove, "QuantizedKeyframeAnimationTemplate");
+}
+
+// ----------------------------------------------------------------------
+
+void *QuantizedKeyframeAnimationTemplate::operator new(size_t size)
+{
+	DEBUG_FATAL(!ms_installed, ("QuantizedKeyframeAnimationTemplate not installed"));
+	DEBUG_FATAL(size != sizeof(QuantizedKeyframeAnimationTemplate), ("derived classes not supported by this operator new"));
+	UNREF(size);
+
+	return ms_memoryBlockManager->allocate();
+}
+
+// ----------------------------------------------------------------------
+
+void QuantizedKeyframeAnimationTemplate::operator delete(void *data)
+{
+	ms_memoryBlockManager->free(data);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Build the rotation and translation of a transform from the
+ * C_componentCount components evaluateAllComponents() wrote for it.
+ */
+
+void QuantizedKeyframeAnimationTemplate::getTransformFromComponents(float const *components, Quaternion &rotation, Vector &translation)
+{
+	NOT_NULL(components);
+
+	rotation.w = components[C_rotationW];
+	rotation.x = components[C_rotationX];
+	rotation.y = components[C_rotationY];
+	rotation.z = components[C_rotationZ];
+	rotation.normalize();
+
+	translation.x = components[C_translationX];
+	translation.y = components[C_translationY];
+	translation.z = components[C_translationZ];
+}
+
+// ======================================================================
+// class QuantizedKeyframeAnimationTemplate: public member functions
+// ======================================================================
+
+SkeletalAnimation *QuantizedKeyframeAnimationTemplate::fetchSkeletalAnimation(AnimationEnvironment &animationEnvironment, const TransformNameMap &transformNameMap) const
+{
+	QuantizedKeyframeAnimation *const skeletalAnimation = new QuantizedKeyframeAnimation(this, animationEnvironment, transformNameMap);
+	NOT_NULL(skeletalAnimation);
+
+	// get initial reference for caller
+	skeletalAnimation->fetch();
+
+	return skeletalAnimation;
+}
+
+// ----------------------------------------------------------------------
+
+int QuantizedKeyframeAnimationTemplate::getTransformCount() const
+{
+	return static_cast<int>(m_transformNames->size());
+}
+
+// ----------------------------------------------------------------------
+
+CrcString const &QuantizedKeyframeAnimationTemplate::getTransformName(int index) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, index, getTransformCount());
+	return *NON_NULL((*m_transformNames)[static_cast<size_t>(index)]);
+}
+
+// ----------------------------------------------------------------------
+
+int QuantizedKeyframeAnimationTemplate::getTransformIndex(CrcString const &transformName) const
+{
+	//-- Transform names are stored in CrcString order, so we can do a binary search lookup.
+	NameVector::const_iterator const it = std::lower_bound(m_transformNames->begin(), m_transformNames->end(), transformName, LessNameComparator());
+	if ((it == m_transformNames->end()) || (transformName < **it))
+		return -1;
+
+	return static_cast<int>(std::distance(m_transformNames->begin(), it));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Evaluate a single transform of the animation.
+ *
+ * @param index        the animation transform index.
+ * @param frameNumber  the fractional frame number to evaluate.
+ */
+
+void QuantizedKeyframeAnimationTemplate::evaluateTransform(int index, float frameNumber, Quaternion &rotation, Vector &translation) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, index, getTransformCount());
+
+	int   lowerSampleIndex;
+	int   upperSampleIndex;
+	float upperSampleWeight;
+
+	getSamplePosition(frameNumber, lowerSampleIndex, upperSampleIndex, upperSampleWeight);
+
+	float components[C_componentCount];
+
+	int const firstComponentIndex = index * C_componentCount;
+	for (int i = 0; i < C_componentCount; ++i)
+		components[i] = evaluateComponent(firstComponentIndex + i, lowerSampleIndex, upperSampleIndex, upperSampleWeight);
+
+	getTransformFromComponents(components, rotation, translation);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Evaluate every component of every transform of the animation.
+ *
+ * The constant components are copied in as a block, then each track type
+ * is expanded in a single pass over its tracks.  Pass the components of a
+ * transform to getTransformFromComponents() to build its rotation and
+ * translation.
+ *
+ * @param frameNumber  the fractional frame number to evaluate.
+ * @param components   receives getTransformCount() * C_componentCount values.
+ */
+
+void QuantizedKeyframeAnimationTemplate::evaluateAllComponents(float frameNumber, float *components) const
+{
+	NOT_NULL(components);
+
+	int   lowerSampleIndex;
+	int   upperSampleIndex;
+	float upperSampleWeight;
+
+	getSamplePosition(frameNumber, lowerSampleIndex, upperSampleIndex, upperSampleWeight);
+
+	//-- Start with the constant components.
+	if (!m_constantComponents->empty())
+		memcpy(components, &(*m_constantComponents)[0], m_constantComponents->size() * sizeof(float));
+
+	//-- Linear tracks.
+	float const clampedFrameNumber = static_cast<float>(lowerSampleIndex) + upperSampleWeight;
+
+	LinearTrackVector::const_iterator const linearEndIt = m_linearTracks->end();
+	for (LinearTrackVector::const_iterator linearIt = m_linearTracks->begin(); linearIt != linearEndIt; ++linearIt)
+		components[linearIt->m_componentIndex] = linearIt->m_start + linearIt->m_deltaPerFrame * clampedFrameNumber;
+
+	//-- Narrow tracks: interpolate between the two sample rows, then scale into range.
+	int const narrowTrackCount = static_cast<int>(m_narrowTracks->size());
+	if (narrowTrackCount > 0)
+	{
+		QuantizedTrack const *const tracks   = &(*m_narrowTracks)[0];
+		uint8 const *const          lowerRow = &(*m_narrowSamples)[static_cast<size_t>(lowerSampleIndex * narrowTrackCount)];
+		uint8 const *const          upperRow = &(*m_narrowSamples)[static_cast<size_t>(upperSampleIndex * narrowTrackCount)];
+
+		for (int i = 0; i < narrowTrackCount; ++i)
+		{
+			float const lowerSample = static_cast<float>(lowerRow[i]);
+			float const sample      = lowerSample + (static_cast<float>(upperRow[i]) - lowerSample) * upperSampleWeight;
+
+			components[tracks[i].m_componentIndex] = tracks[i].m_minimum + sample * tracks[i].m_scale;
+		}
+	}
+
+	//-- Wide tracks.
+	int const wideTrackCount = static_cast<int>(m_wideTracks->size());
+	if (wideTrackCount > 0)
+	{
+		QuantizedTrack const *const tracks   = &(*m_wideTracks)[0];
+		uint16 const *const         lowerRow = &(*m_wideSamples)[static_cast<size_t>(lowerSampleIndex * wideTrackCount)];
+		uint16 const *const         upperRow = &(*m_wideSamples)[static_cast<size_t>(upperSampleIndex * wideTrackCount)];
+
+		for (int i = 0; i < wideTrackCount; ++i)
+		{
+			float const lowerSample = static_cast<float>(lowerRow[i]);
+			float const sample      = lowerSample + (static_cast<float>(upperRow[i]) - lowerSample) * upperSampleWeight;
+
+			components[tracks[i].m_componentIndex] = tracks[i].m_minimum + sample * tracks[i].m_scale;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+int QuantizedKeyframeAnimationTemplate::getMessageCount() const
+{
+	return m_messages ? static_cast<int>(m_messages->size()) : 0;
+}
+
+// ----------------------------------------------------------------------
+
+const CrcLowerString &QuantizedKeyframeAnimationTemplate::getMessageName(int index) const
+{
+	NOT_NULL(m_messages);
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, index, static_cast<int>(m_messages->size()));
+
+	return NON_NULL((*m_messages)[static_cast<size_t>(index)])->getName();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Return the index and frame number of each message signaled during the
+ * frame range [beginFrameNumber, endFrameNumber).
+ *
+ * The vectors are appended to, not cleared.
+ *
+ * @see CompressedKeyframeAnimationTemplate::getSignaledMessages()
+ */
+
+void QuantizedKeyframeAnimationTemplate::getSignaledMessages(int beginFrameNumber, int endFrameNumber, IntVector &signaledMessageIndices, FloatVector &signaledMessageFrameNumbers) const
+{
+	if (!m_messages)
+		return;
+
+	int const messageCount = static_cast<int>(m_messages->size());
+	for (int messageIndex = 0; messageIndex < messageCount; ++messageIndex)
+	{
+		IntVector const &signaledFrameNumbers = (*m_messages)[static_cast<size_t>(messageIndex)]->getSignaledFrameNumbers();
+
+		IntVector::const_iterator const lowerBoundIt = std::lower_bound(signaledFrameNumbers.begin(), signaledFrameNumbers.end(), beginFrameNumber);
+		IntVector::const_iterator const upperBoundIt = std::upper_bound(signaledFrameNumbers.begin(), signaledFrameNumbers.end(), endFrameNumber - 1);
+
+		for (IntVector::const_iterator it = lowerBoundIt; it < upperBoundIt; ++it)
+		{
+			signaledMessageIndices.push_back(messageIndex);
+			signaledMessageFrameNumbers.push_back(static_cast<float>(*it));
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Retrieve the change in Object-space rotation and translation that should
+ * be applied to the Object between two fractional frame numbers.
+ *
+ * @see CompressedKeyframeAnimationTemplate::getLocomotion()
+ */
+
+void QuantizedKeyframeAnimationTemplate::getLocomotion(float beginFrameTime, float endFrameTime, int &rotationStartKeyIndex, int &translationStartKeyIndex, Quaternion &rotation, Vector &translation) const
+{
+	rotation    = Quaternion::identity;
+	translation = Vector::zero;
+
+	Quaternion endRotation_mayaWorld = Quaternion::identity;
+
+	if (m_locomotionRotationKeys)
+	{
+		RotationKeyVector const &keys = *m_locomotionRotationKeys;
+		float                    upperKeyWeight;
+
+		int const beginKeyIndex = findLowerKeyIndex(keys, beginFrameTime, rotationStartKeyIndex, upperKeyWeight);
+		Quaternion const beginRotation_mayaWorld = (upperKeyWeight > 0.0f) ? keys[static_cast<size_t>(beginKeyIndex)].m_rotation.slerp(keys[static_cast<size_t>(beginKeyIndex + 1)].m_rotation, upperKeyWeight) : keys[static_cast<size_t>(beginKeyIndex)].m_rotation;
+
+		int const endKeyIndex = findLowerKeyIndex(keys, endFrameTime, rotationStartKeyIndex, upperKeyWeight);
+		endRotation_mayaWorld = (upperKeyWeight > 0.0f) ? keys[static_cast<size_t>(endKeyIndex)].m_rotation.slerp(keys[static_cast<size_t>(endKeyIndex + 1)].m_rotation, upperKeyWeight) : keys[static_cast<size_t>(endKeyIndex)].m_rotation;
+
+		//-- calculate delta rotation relative to begin time rotation
+		rotation = endRotation_mayaWorld * beginRotation_mayaWorld.getComplexConjugate();
+	}
+
+	if (m_locomotionTranslationKeys)
+	{
+		TranslationKeyVector const &keys = *m_locomotionTranslationKeys;
+		float                       upperKeyWeight;
+
+		int const beginKeyIndex = findLowerKeyIndex(keys, beginFrameTime, translationStartKeyIndex, upperKeyWeight);
+		Vector const beginPosition_mayaWorld = keys[static_cast<size_t>(beginKeyIndex)].m_translation + (upperKeyWeight > 0.0f ? (keys[static_cast<size_t>(beginKeyIndex + 1)].m_translation - keys[static_cast<size_t>(beginKeyIndex)].m_translation) * upperKeyWeight : Vector::zero);
+
+		int const endKeyIndex = findLowerKeyIndex(keys, endFrameTime, translationStartKeyIndex, upperKeyWeight);
+		Vector const endPosition_mayaWorld = keys[static_cast<size_t>(endKeyIndex)].m_translation + (upperKeyWeight > 0.0f ? (keys[static_cast<size_t>(endKeyIndex + 1)].m_translation - keys[static_cast<size_t>(endKeyIndex)].m_translation) * upperKeyWeight : Vector::zero);
+
+		Vector const deltaPosition_mayaWorld = endPosition_mayaWorld - beginPosition_mayaWorld;
+
+		if (m_locomotionRotationKeys)
+		{
+			//-- the delta rotation is applied before the translation, so express the translation in post-rotation space.
+			Transform objectToMayaWorld(Transform::IF_none);
+			endRotation_mayaWorld.getTransformPreserveTranslation(&objectToMayaWorld);
+
+			translation = objectToMayaWorld.rotate_p2l(deltaPosition_mayaWorld);
+		}
+		else
+			translation = deltaPosition_mayaWorld;
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Return the number of bytes of memory this template keeps resident.
+ */
+
+int QuantizedKeyframeAnimationTemplate::getResidentByteCount() const
+{
+	int byteCount = static_cast<int>(sizeof(*this));
+
+	byteCount += getVectorByteCount(*m_transformNames);
+	{
+		NameVector::const_iterator const endIt = m_transformNames->end();
+		for (NameVector::const_iterator it = m_transformNames->begin(); it != endIt; ++it)
+			byteCount += static_cast<int>(sizeof(PersistentCrcString) + strlen((*it)->getString()) + 1);
+	}
+
+	byteCount += getVectorByteCount(*m_componentTrackTypes);
+	byteCount += getVectorByteCount(*m_componentTrackIndices);
+	byteCount += getVectorByteCount(*m_constantComponents);
+	byteCount += getVectorByteCount(*m_linearTracks);
+	byteCount += getVectorByteCount(*m_narrowTracks);
+	byteCount += getVectorByteCount(*m_wideTracks);
+	byteCount += getVectorByteCount(*m_narrowSamples);
+	byteCount += getVectorByteCount(*m_wideSamples);
+
+	if (m_messages)
+	{
+		byteCount += getVectorByteCount(*m_messages);
+
+		MessageVector::const_iterator const endIt = m_messages->end();
+		for (MessageVector::const_iterator it = m_messages->begin(); it != endIt; ++it)
+		{
+			Message const &message = **it;
+			byteCount += static_cast<int>(sizeof(Message) + strlen(message.getName().getString()) + 1 + message.getSignaledFrameNumbers().capacity() * sizeof(int));
+		}
+	}
+
+	if (m_locomotionRotationKeys)
+		byteCount += getVectorByteCount(*m_locomotionRotationKeys);
+
+	if (m_locomotionTranslationKeys)
+		byteCount += getVectorByteCount(*m_locomotionTranslationKeys);
+
+	return byteCount;
+}
+
+// ======================================================================
+// class QuantizedKeyframeAnimationTemplate: private static member functions
+// ======================================================================
+
+void QuantizedKeyframeAnimationTemplate::remove()
+{
+	DEBUG_FATAL(!ms_installed, ("QuantizedKeyframeAnimationTemplate not installed"));
+
+	const bool success = SkeletalAnimationTemplateList::deregisterCreateFunction(TAG_QKAT);
+	DEBUG_FATAL(!success, ("failed to deregister QuantizedKeyframeAnimationTemplate"));
+	UNREF(success);
+
+	delete ms_memoryBlockManager;
+	ms_memoryBlockManager = 0;
+
+	ms_installed = false;
+}
+
+// ----------------------------------------------------------------------
+
+SkeletalAnimationTemplate *QuantizedKeyframeAnimationTemplate::create(const CrcLowerString &name, Iff &iff)
+{
+	return new QuantizedKeyframeAnimationTemplate(name, iff);
+}
+
+// ======================================================================
+// class QuantizedKeyframeAnimationTemplate: private member functions
+// ======================================================================
+
+QuantizedKeyframeAnimationTemplate::QuantizedKeyframeAnimationTemplate(const CrcLowerString &name, Iff &iff) :
+	SkeletalAnimationTemplate(name),
+	m_framesPerSecond(0.0f),
+	m_frameCount(0),
+	m_sampleCount(1),
+	m_transformNames(new NameVector()),
+	m_componentTrackTypes(new Uint8Vector()),
+	m_componentTrackIndices(new IntVector()),
+	m_constantComponents(new FloatVector()),
+	m_linearTracks(new LinearTrackVector()),
+	m_narrowTracks(new QuantizedTrackVector()),
+	m_wideTracks(new QuantizedTrackVector()),
+	m_narrowSamples(new Uint8Vector()),
+	m_wideSamples(new Uint16Vector()),
+	m_messages(0),
+	m_locomotionRotationKeys(0),
+	m_locomotionTranslationKeys(0),
+	m_averageTranslationSpeed(0.0f)
+{
+	iff.enterForm(TAG_QKAT);
+
+		switch (iff.getCurrentName())
+		{
+			case TAG_0000:
+				load_0000(iff);
+				break;
+
+			default:
+			{
+				char tagName[5];
+				ConvertTagToString(iff.getCurrentName(), tagName);
+				FATAL(true, ("unknown or unsupported QuantizedKeyframeAnimationTemplate version [%s]", tagName));
+			}
+		}
+
+	iff.exitForm(TAG_QKAT);
+
+	DEBUG_REPORT_LOG(ConfigClientSkeletalAnimation::getLogSktCreateDestroy(), ("QKAT: CREATE [%s].\n", SkeletalAnimationTemplate::getName().getString()));
+}
+
+// ----------------------------------------------------------------------
+
+QuantizedKeyframeAnimationTemplate::~QuantizedKeyframeAnimationTemplate()
+{
+	DEBUG_REPORT_LOG(ConfigClientSkeletalAnimation::getLogSktCreateDestroy(), ("QKAT: DESTROY [%s].\n", SkeletalAnimationTemplate::getName().getString()));
+
+	delete m_locomotionTranslationKeys;
+	delete m_locomotionRotationKeys;
+
+	if (m_messages)
+	{
+		std::for_each(m_messages->begin(), m_messages->end(), PointerDeleter());
+		delete m_messages;
+	}
+
+	delete m_wideSamples;
+	delete m_narrowSamples;
+	delete m_wideTracks;
+	delete m_narrowTracks;
+	delete m_linearTracks;
+	delete m_constantComponents;
+	delete m_componentTrackIndices;
+	delete m_componentTrackTypes;
+
+	std::for_each(m_transformNames->begin(), m_transformNames->end(), PointerDeleter());
+	delete m_transformNames;
+}
+
+// ----------------------------------------------------------------------
+
+void QuantizedKeyframeAnimationTemplate::load_0000(Iff &iff)
+{
+	iff.enterForm(TAG_0000);
+
+		//-- Load general animation information.
+		iff.enterChunk(TAG_INFO);
+
+			m_framesPerSecond = iff.read_float();
+			m_frameCount      = static_cast<int>(iff.read_int16());
+			m_sampleCount     = m_frameCount + 1;
+
+			int const transformCount   = static_cast<int>(iff.read_int16());
+			int const linearTrackCount = static_cast<int>(iff.read_int16());
+			int const narrowTrackCount = static_cast<int>(iff.read_int16());
+			int const wideTrackCount   = static_cast<int>(iff.read_int16());
+
+		iff.exitChunk(TAG_INFO);
+
+		//-- Load the transforms and their component tracks.
+		int const componentCount = transformCount * C_componentCount;
+
+		m_transformNames->reserve(static_cast<size_t>(transformCount));
+		m_componentTrackTypes->resize(static_cast<size_t>(componentCount), static_cast<uint8>(TT_constant));
+		m_componentTrackIndices->resize(static_cast<size_t>(componentCount), -1);
+		m_constantComponents->resize(static_cast<size_t>(componentCount), 0.0f);
+		m_linearTracks->reserve(static_cast<size_t>(linearTrackCount));
+		m_narrowTracks->reserve(static_cast<size_t>(narrowTrackCount));
+		m_wideTracks->reserve(static_cast<size_t>(wideTrackCount));
+
+		iff.enterChunk(TAG_XFRM);
+
+			for (int transformIndex = 0; transformIndex < transformCount; ++transformIndex)
+			{
+				char nameBuffer[MAX_PATH];
+				iff.read_string(nameBuffer, MAX_PATH - 1);
+
+				m_transformNames->push_back(new PersistentCrcString(nameBuffer, false));
+				DEBUG_FATAL((transformIndex > 0) && !(*(*m_transformNames)[static_cast<size_t>(transformIndex - 1)] < *m_transformNames->back()), ("transforms in [%s] are not sorted by name.", iff.getFileName()));
+
+				for (int component = 0; component < C_componentCount; ++component)
+				{
+					size_t const componentIndex = static_cast<size_t>(transformIndex * C_componentCount + component);
+
+					uint8 const trackType = iff.read_uint8();
+					float const value0    = iff.read_float();
+
+					(*m_componentTrackTypes)[componentIndex] = trackType;
+
+					switch (trackType)
+					{
+						case TT_constant:
+							(*m_constantComponents)[componentIndex] = value0;
+							break;
+
+						case TT_linear:
+							{
+								LinearTrack const track = { value0, iff.read_float(), static_cast<int>(componentIndex) };
+
+								(*m_componentTrackIndices)[componentIndex] = static_cast<int>(m_linearTracks->size());
+								m_linearTracks->push_back(track);
+							}
+							break;
+
+						case TT_narrow:
+						case TT_wide:
+							{
+								QuantizedTrack const    track  = { value0, iff.read_float(), static_cast<int>(componentIndex) };
+								QuantizedTrackVector &tracks = (trackType == TT_narrow) ? *m_narrowTracks : *m_wideTracks;
+
+								(*m_componentTrackIndices)[componentIndex] = static_cast<int>(tracks.size());
+								tracks.push_back(track);
+							}
+							break;
+
+						default:
+							FATAL(true, ("unknown track type [%d] in [%s].", static_cast<int>(trackType), iff.getFileName()));
+					}
+				}
+			}
+
+		iff.exitChunk(TAG_XFRM);
+
+		FATAL(static_cast<int>(m_linearTracks->size()) != linearTrackCount, ("linear track count mismatch [%d/%d] in [%s].", static_cast<int>(m_linearTracks->size()), linearTrackCount, iff.getFileName()));
+		FATAL(static_cast<int>(m_narrowTracks->size()) != narrowTrackCount, ("narrow track count mismatch [%d/%d] in [%s].", static_cast<int>(m_narrowTracks->size()), narrowTrackCount, iff.getFileName()));
+		FATAL(static_cast<int>(m_wideTracks->size()) != wideTrackCount, ("wide track count mismatch [%d/%d] in [%s].", static_cast<int>(m_wideTracks->size()), wideTrackCount, iff.getFileName()));
+
+		//-- Load the samples.
+		if (narrowTrackCount > 0)
+		{
+			int const sampleCount = m_sampleCount * narrowTrackCount;
+			m_narrowSamples->resize(static_cast<size_t>(sampleCount));
+
+			iff.enterChunk(TAG_NSMP);
+				iff.read_uint8(sampleCount, &(*m_narrowSamples)[0]);
+			iff.exitChunk(TAG_NSMP);
+		}
+
+		if (wideTrackCount > 0)
+		{
+			int const sampleCount = m_sampleCount * wideTrackCount;
+			m_wideSamples->resize(static_cast<size_t>(sampleCount));
+
+			iff.enterChunk(TAG_WSMP);
+				iff.read_uint16(sampleCount, &(*m_wideSamples)[0]);
+			iff.exitChunk(TAG_WSMP);
+		}
+
+		//-- Load animation messages.
+		if (iff.enterForm(TAG_MSGS, true))
+		{
+			iff.enterChunk(TAG_INFO);
+				int const messageCount = static_cast<int>(iff.read_int16());
+			iff.exitChunk(TAG_INFO);
+
+			if (messageCount > 0)
+			{
+				m_messages = new MessageVector();
+				m_messages->reserve(static_cast<size_t>(messageCount));
+
+				for (int i = 0; i < messageCount; ++i)
+					m_messages->push_back(new Message(iff));
+			}
+
+			iff.exitForm(TAG_MSGS);
+		}
+
+		//-- Load locomotion translation.
+		if (iff.enterChunk(TAG_LOCT, true))
+		{
+			m_averageTranslationSpeed = iff.read_float();
+
+			int const keyCount = static_cast<int>(iff.read_int16());
+			if (keyCount > 0)
+			{
+				m_locomotionTranslationKeys = new TranslationKeyVector(static_cast<size_t>(keyCount));
+
+				for (int i = 0; i < keyCount; ++i)
+				{
+					TranslationKey &key = (*m_locomotionTranslationKeys)[static_cast<size_t>(i)];
+
+					key.m_frameNumber = static_cast<float>(iff.read_int16());
+					key.m_translation = iff.read_floatVector();
+				}
+			}
+
+			iff.exitChunk(TAG_LOCT);
+		}
+
+		//-- Load locomotion rotation.
+		if (iff.enterChunk(TAG_LOCR, true))
+		{
+			int const keyCount = static_cast<int>(iff.read_int16());
+			if (keyCount > 0)
+			{
+				m_locomotionRotationKeys = new RotationKeyVector(static_cast<size_t>(keyCount));
+
+				for (int i = 0; i < keyCount; ++i)
+				{
+					RotationKey &key = (*m_locomotionRotationKeys)[static_cast<size_t>(i)];
+
+					key.m_frameNumber = static_cast<float>(iff.read_int16());
+					key.m_rotation    = iff.read_floatQuaternion();
+				}
+			}
+
+			iff.exitChunk(TAG_LOCR);
+		}
+
+	iff.exitForm(TAG_0000);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Find the two sample rows bracketing a frame number.
+ *
+ * The frame number is clamped to [0, frame count].
+ */
+
+void QuantizedKeyframeAnimationTemplate::getSamplePosition(float frameNumber, int &lowerSampleIndex, int &upperSampleIndex, float &upperSampleWeight) const
+{
+	float const clampedFrameNumber = clamp(0.0f, frameNumber, static_cast<float>(m_frameCount));
+
+	lowerSampleIndex = static_cast<int>(clampedFrameNumber);
+	if (lowerSampleIndex >= m_sampleCount - 1)
+	{
+		lowerSampleIndex  = m_sampleCount - 1;
+		upperSampleIndex  = lowerSampleIndex;
+		upperSampleWeight = 0.0f;
+	}
+	else
+	{
+		upperSampleIndex  = lowerSampleIndex + 1;
+		upperSampleWeight = clampedFrameNumber - static_cast<float>(lowerSampleIndex);
+	}
+}
+
+// ----------------------------------------------------------------------
+
+float QuantizedKeyframeAnimationTemplate::evaluateComponent(int componentIndex, int lowerSampleIndex, int upperSampleIndex, float upperSampleWeight) const
+{
+	size_t const componentSlot = static_cast<size_t>(componentIndex);
+	int const    trackIndex    = (*m_componentTrackIndices)[componentSlot];
+
+	switch ((*m_componentTrackTypes)[componentSlot])
+	{
+		case TT_constant:
+			return (*m_constantComponents)[componentSlot];
+
+		case TT_linear:
+			{
+				LinearTrack const &track = (*m_linearTracks)[static_cast<size_t>(trackIndex)];
+				return track.m_start + track.m_deltaPerFrame * (static_cast<float>(lowerSampleIndex) + upperSampleWeight);
+			}
+
+		case TT_narrow:
+			{
+				int const             trackCount  = static_cast<int>(m_narrowTracks->size());
+				QuantizedTrack const &track       = (*m_narrowTracks)[static_cast<size_t>(trackIndex)];
+				float const           lowerSample = static_cast<float>((*m_narrowSamples)[static_cast<size_t>(lowerSampleIndex * trackCount + trackIndex)]);
+				float const           upperSample = static_cast<float>((*m_narrowSamples)[static_cast<size_t>(upperSampleIndex * trackCount + trackIndex)]);
+
+				return track.m_minimum + (lowerSample + (upperSample - lowerSample) * upperSampleWeight) * track.m_scale;
+			}
+
+		case TT_wide:
+			{
+				int const             trackCount  = static_cast<int>(m_wideTracks->size());
+				QuantizedTrack const &track       = (*m_wideTracks)[static_cast<size_t>(trackIndex)];
+				float const           lowerSample = static_cast<float>((*m_wideSamples)[static_cast<size_t>(lowerSampleIndex * trackCount + trackIndex)]);
+				float const           upperSample = static_cast<float>((*m_wideSamples)[static_cast<size_t>(upperSampleIndex * trackCount + trackIndex)]);
+
+				return track.m_minimum + (lowerSample + (upperSample - lowerSample) * upperSampleWeight) * track.m_scale;
+			}
+
+		default:
+			DEBUG_FATAL(true, ("unknown track type."));
+			return 0.0f;
+	}
+}
+
+// ======================================================================
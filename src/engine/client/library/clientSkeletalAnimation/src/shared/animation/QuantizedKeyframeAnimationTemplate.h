@@ -0,0 +1,201 @@
+// PRIVATE
+
+// ======================================================================
+//
+// QuantizedKeyframeAnimationTemplate.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_QuantizedKeyframeAnimationTemplate_H
+#define INCLUDED_QuantizedKeyframeAnimationTemplate_H
+
+// ======================================================================
+
+#include "clientSkeletalAnimation/SkeletalAnimationTemplate.h"
+
+class CrcLowerString;
+class CrcString;
+class Iff;
+class MemoryBlockManager;
+class Quaternion;
+class Vector;
+
+// ======================================================================
+/**
+ * A keyframe animation stored as uniformly sampled, quantized tracks.
+ *
+ * Every transform is described by seven scalar components: the four
+ * components of its rotation quaternion followed by the three components of
+ * its translation.  AnimationRecompressor reduces each component to the
+ * cheapest track that stays within its error bound:
+ *
+ *   - constant:  a single value for the whole animation.
+ *   - linear:    a start value and a per-frame delta.
+ *   - narrow:    one 8-bit sample per frame, scaled into [minimum, minimum + 255 * scale].
+ *   - wide:      one 16-bit sample per frame, scaled into [minimum, minimum + 65535 * scale].
+ *
+ * The samples of all narrow tracks for a frame are stored next to each other,
+ * as are the samples of all wide tracks, so evaluating a pose reads two
+ * contiguous rows per sample size instead of searching a key list per
+ * channel.  Rotations are normalized after interpolation.
+ *
+ * Locomotion and animation messages are carried over from the source
+ * animation unchanged.
+ */
+
+class QuantizedKeyframeAnimationTemplate: public SkeletalAnimationTemplate
+{
+public:
+
+	enum Component
+	{
+		C_rotationW,
+		C_rotationX,
+		C_rotationY,
+		C_rotationZ,
+		C_translationX,
+		C_translationY,
+		C_translationZ,
+
+		C_componentCount
+	};
+
+	enum TrackType
+	{
+		TT_constant,
+		TT_linear,
+		TT_narrow,
+		TT_wide
+	};
+
+	typedef stdvector<int>::fwd    IntVector;
+	typedef stdvector<float>::fwd  FloatVector;
+
+public:
+
+	static void  install();
+
+	static void *operator new(size_t size);
+	static void  operator delete(void *data);
+
+	static void  getTransformFromComponents(float const *components, Quaternion &rotation, Vector &translation);
+
+public:
+
+	virtual SkeletalAnimation *fetchSkeletalAnimation(AnimationEnvironment &animationEnvironment, const TransformNameMap &transformNameMap) const;
+
+	float                      getFramesPerSecond() const;
+	int                        getFrameCount() const;
+
+	int                        getTransformCount() const;
+	CrcString const           &getTransformName(int index) const;
+	int                        getTransformIndex(CrcString const &transformName) const;
+
+	void                       evaluateTransform(int index, float frameNumber, Quaternion &rotation, Vector &translation) const;
+	void                       evaluateAllComponents(float frameNumber, float *components) const;
+
+	int                        getMessageCount() const;
+	const CrcLowerString      &getMessageName(int index) const;
+	void                       getSignaledMessages(int beginFrameNumber, int endFrameNumber, IntVector &signaledMessageIndices, FloatVector &signaledMessageFrameNumbers) const;
+
+	void                       getLocomotion(float beginFrameTime, float endFrameTime, int &rotationStartKeyIndex, int &translationStartKeyIndex, Quaternion &rotation, Vector &translation) const;
+	float                      getAverageTranslationSpeed() const;
+
+	int                        getResidentByteCount() const;
+
+private:
+
+	struct LinearTrack;
+	struct QuantizedTrack;
+	struct RotationKey;
+	struct TranslationKey;
+	class  Message;
+
+	typedef stdvector<LinearTrack>::fwd          LinearTrackVector;
+	typedef stdvector<Message*>::fwd             MessageVector;
+	typedef stdvector<PersistentCrcString*>::fwd NameVector;
+	typedef stdvector<QuantizedTrack>::fwd       QuantizedTrackVector;
+	typedef stdvector<RotationKey>::fwd          RotationKeyVector;
+	typedef stdvector<TranslationKey>::fwd       TranslationKeyVector;
+	typedef stdvector<uint8>::fwd                Uint8Vector;
+	typedef stdvector<uint16>::fwd               Uint16Vector;
+
+private:
+
+	static void                       remove();
+	static SkeletalAnimationTemplate *create(const CrcLowerString &name, Iff &iff);
+
+private:
+
+	QuantizedKeyframeAnimationTemplate(const CrcLowerString &name, Iff &iff);
+	virtual ~QuantizedKeyframeAnimationTemplate();
+
+	void   load_0000(Iff &iff);
+
+	void   getSamplePosition(float frameNumber, int &lowerSampleIndex, int &upperSampleIndex, float &upperSampleWeight) const;
+	float  evaluateComponent(int componentIndex, int lowerSampleIndex, int upperSampleIndex, float upperSampleWeight) const;
+
+	// disabled
+	QuantizedKeyframeAnimationTemplate();
+	QuantizedKeyframeAnimationTemplate(const QuantizedKeyframeAnimationTemplate&);
+	QuantizedKeyframeAnimationTemplate &operator =(const QuantizedKeyframeAnimationTemplate&);
+
+private:
+
+	static bool                ms_installed;
+	static MemoryBlockManager *ms_memoryBlockManager;
+
+private:
+
+	float                  m_framesPerSecond;
+	int                    m_frameCount;
+	int                    m_sampleCount;
+
+	NameVector            *m_transformNames;
+
+	//-- Indexed by transform index * C_componentCount + component.
+	Uint8Vector           *m_componentTrackTypes;
+	IntVector             *m_componentTrackIndices;
+	FloatVector           *m_constantComponents;
+
+	LinearTrackVector     *m_linearTracks;
+	QuantizedTrackVector  *m_narrowTracks;
+	QuantizedTrackVector  *m_wideTracks;
+
+	//-- Frame-major: all samples of frame n precede those of frame n + 1.
+	Uint8Vector           *m_narrowSamples;
+	Uint16Vector          *m_wideSamples;
+
+	MessageVector         *m_messages;
+
+	RotationKeyVector     *m_locomotionRotationKeys;
+	TranslationKeyVector  *m_locomotionTranslationKeys;
+	float                  m_averageTranslationSpeed;
+
+};
+
+// ======================================================================
+
+inline float QuantizedKeyframeAnimationTemplate::getFramesPerSecond() const
+{
+	return m_framesPerSecond;
+}
+
+// ----------------------------------------------------------------------
+
+inline int QuantizedKeyframeAnimationTemplate::getFrameCount() const
+{
+	return m_frameCount;
+}
+
+// ----------------------------------------------------------------------
+
+inline float QuantizedKeyframeAnimationTemplate::getAverageTranslationSpeed() const
+{
+	return m_averageTranslationSpeed;
+}
+
+// ======================================================================
+
+#endif
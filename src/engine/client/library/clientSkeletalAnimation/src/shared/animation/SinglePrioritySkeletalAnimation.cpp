@@ -75,6 +75,27 @@ void SinglePrioritySkeletalAnimation::evaluateTransformComponents(int index, Qua
 
 // ----------------------------------------------------------------------
 
+void SinglePrioritySkeletalAnimation::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	m_animation.evaluateAllTransformComponents(rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
+bool SinglePrioritySkeletalAnimation::addPoseCacheKey(PoseCache::Key &key) const
+{
+	return m_animation.addPoseCacheKey(key);
+}
+
+// ----------------------------------------------------------------------
+
+void SinglePrioritySkeletalAnimation::receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations)
+{
+	m_animation.receiveCachedPose(transformCount, rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
 void SinglePrioritySkeletalAnimation::getScaledLocomotion(Quaternion &rotation, Vector &translation) const
 {
 	m_animation.getScaledLocomotion(rotation, translation);
@@ -204,6 +204,66 @@ void SkeletalAnimation::getMinMaxTransformPriority(int &min, int &max) const
 	}
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Evaluate the rotation and translation of every transform.
+ *
+ * The default implementation calls evaluateTransformComponents() for
+ * each transform.  Leaf animations override this to evaluate all of
+ * their channels in one pass.
+ *
+ * @param rotations     getTransformCount() rotations are returned here.
+ * @param translations  getTransformCount() translations are returned here.
+ */
+
+void SkeletalAnimation::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	NOT_NULL(rotations);
+	NOT_NULL(translations);
+
+	int const transformCount = getTransformCount();
+	for (int i = 0; i < transformCount; ++i)
+		evaluateTransformComponents(i, rotations[i], translations[i]);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Append the values that determine this animation's current pose.
+ *
+ * Two animation trees that append the same values, for skeletons built
+ * from the same skeleton template, must evaluate to identical poses.
+ * The default implementation declines, which keeps the pose out of the
+ * PoseCache.
+ *
+ * @return  true if the pose can be shared through the PoseCache.
+ */
+
+bool SkeletalAnimation::addPoseCacheKey(PoseCache::Key &key) const
+{
+	UNREF(key);
+	return false;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Called instead of evaluateAllTransformComponents() when the PoseCache
+ * serves this animation's pose.
+ *
+ * Animations that keep state from evaluating their pose update it here.
+ * The default implementation keeps nothing.
+ *
+ * @param transformCount  the number of transforms in the pose.
+ * @param rotations       the cached rotations.
+ * @param translations    the cached translations.
+ */
+
+void SkeletalAnimation::receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations)
+{
+	UNREF(transformCount);
+	UNREF(rotations);
+	UNREF(translations);
+}
+
 // ----------------------------------------------------------------------
 /**
  * Retrieve the name of the animation template for this animation or
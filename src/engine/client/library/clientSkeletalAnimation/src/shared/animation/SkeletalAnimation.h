@@ -11,6 +11,8 @@
 
 // ======================================================================
 
+#include "clientSkeletalAnimation/PoseCache.h"
+
 class AnimationNotification;
 class CrcLowerString;
 class CrcString;
@@ -77,6 +79,9 @@ public:
 
 	virtual int                      getTransformCount() const = 0;
 	virtual void                     evaluateTransformComponents(int index, Quaternion &rotation, Vector &translation) = 0;
+	virtual void                     evaluateAllTransformComponents(Quaternion *rotations, Vector *translations);
+	virtual bool                     addPoseCacheKey(PoseCache::Key &key) const;
+	virtual void                     receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations);
 
 	virtual int                      getTransformPriority(int index) const = 0;
 	virtual int                      getLocomotionPriority() const = 0;
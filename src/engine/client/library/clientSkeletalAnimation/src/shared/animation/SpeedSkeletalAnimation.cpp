@@ -413,6 +413,27 @@ void SpeedSkeletalAnimation::evaluateTransformComponents(int index, Quaternion &
 
 // ----------------------------------------------------------------------
 
+void SpeedSkeletalAnimation::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	m_evaluationAnimation->evaluateAllTransformComponents(rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
+bool SpeedSkeletalAnimation::addPoseCacheKey(PoseCache::Key &key) const
+{
+	return m_evaluationAnimation->addPoseCacheKey(key);
+}
+
+// ----------------------------------------------------------------------
+
+void SpeedSkeletalAnimation::receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations)
+{
+	m_evaluationAnimation->receiveCachedPose(transformCount, rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
 int SpeedSkeletalAnimation::getTransformPriority(int index) const
 {
 	const SkeletalAnimation *const animation = getFocusAnimation();
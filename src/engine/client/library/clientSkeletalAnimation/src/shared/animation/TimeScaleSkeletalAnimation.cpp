@@ -57,6 +57,27 @@ void TimeScaleSkeletalAnimation::evaluateTransformComponents(int index, Quaterni
 
 // ----------------------------------------------------------------------
 
+void TimeScaleSkeletalAnimation::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	m_baseAnimation->evaluateAllTransformComponents(rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
+bool TimeScaleSkeletalAnimation::addPoseCacheKey(PoseCache::Key &key) const
+{
+	return m_baseAnimation->addPoseCacheKey(key);
+}
+
+// ----------------------------------------------------------------------
+
+void TimeScaleSkeletalAnimation::receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations)
+{
+	m_baseAnimation->receiveCachedPose(transformCount, rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
 int TimeScaleSkeletalAnimation::getTransformPriority(int index) const
 {
 	return m_baseAnimation->getTransformPriority(index);
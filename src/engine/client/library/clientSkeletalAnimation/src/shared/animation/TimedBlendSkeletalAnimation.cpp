@@ -9,6 +9,7 @@
 #include "clientSkeletalAnimation/FirstClientSkeletalAnimation.h"
 #include "clientSkeletalAnimation/TimedBlendSkeletalAnimation.h"
 
+#include "clientSkeletalAnimation/PoseCache.h"
 #include "clientSkeletalAnimation/SkeletalAnimation.h"
 #include "sharedFoundation/CrcLowerString.h"
 #include "sharedMath/Quaternion.h"
@@ -191,7 +192,9 @@ int TimedBlendSkeletalAnimation::getTransformCount() const
 
 void TimedBlendSkeletalAnimation::evaluateTransformComponents(int index, Quaternion &rotation, Vector &translation)
 {
-	if (m_blendFraction >= 1.0f)
+	float const blendFraction = getPoseBlendFraction();
+
+	if (blendFraction >= 1.0f)
 	{
 		//-- Only need to grab from animation 2.
 		if (m_animation2)
@@ -220,8 +223,8 @@ void TimedBlendSkeletalAnimation::evaluateTransformComponents(int index, Quatern
 			m_animation2->evaluateTransformComponents(index, rotation2, translation2);
 			
 			//-- Blend the result.
-			translation = (translation1 * (1.0f - m_blendFraction)) + (translation2 * m_blendFraction);
-			rotation    = rotation1.slerp(rotation2, m_blendFraction);
+			translation = (translation1 * (1.0f - blendFraction)) + (translation2 * blendFraction);
+			rotation    = rotation1.slerp(rotation2, blendFraction);
 		}
 		else if(m_animation1)
 		{
@@ -239,6 +242,57 @@ void TimedBlendSkeletalAnimation::evaluateTransformComponents(int index, Quatern
 	}
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Mirrors the choices made by evaluateTransformComponents().
+ */
+
+bool TimedBlendSkeletalAnimation::addPoseCacheKey(PoseCache::Key &key) const
+{
+	float const blendFraction = getPoseBlendFraction();
+
+	if (blendFraction >= 1.0f)
+		return m_animation2 && m_animation2->addPoseCacheKey(key);
+
+	if (m_animation1 && m_animation2 && (m_animation1 != m_animation2))
+	{
+		//-- Leaves always start their key with a non-NULL template, so a NULL marks a blend.
+		key.addPointer(NULL);
+
+		if (!m_animation1->addPoseCacheKey(key) || !m_animation2->addPoseCacheKey(key))
+			return false;
+
+		key.addInt(PoseCache::getBlendFractionKey(blendFraction));
+		return true;
+	}
+
+	if (m_animation1)
+		return m_animation1->addPoseCacheKey(key);
+
+	return m_animation2 && m_animation2->addPoseCacheKey(key);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * A cached pose is only handed on when it is the pose of one animation,
+ * a mid-blend pose is neither animation's.
+ */
+
+void TimedBlendSkeletalAnimation::receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations)
+{
+	if (getPoseBlendFraction() >= 1.0f)
+	{
+		if (m_animation2)
+			m_animation2->receiveCachedPose(transformCount, rotations, translations);
+	}
+	else if (m_animation1 && m_animation2 && (m_animation1 != m_animation2))
+		return;
+	else if (m_animation1)
+		m_animation1->receiveCachedPose(transformCount, rotations, translations);
+	else if (m_animation2)
+		m_animation2->receiveCachedPose(transformCount, rotations, translations);
+}
+
 // ----------------------------------------------------------------------
 
 int TimedBlendSkeletalAnimation::getTransformPriority(int index) const
@@ -558,6 +612,21 @@ void TimedBlendSkeletalAnimation::alterBlendTime(float deltaTime)
 	}
 }
 
+// ======================================================================
+// class TimedBlendSkeletalAnimation: private member functions
+// ======================================================================
+/**
+ * Get the blend fraction used to evaluate the pose.
+ *
+ * While the PoseCache is snapping the blend fraction is snapped to the
+ * steps the cache keys on, so cached and evaluated poses agree.
+ */
+
+float TimedBlendSkeletalAnimation::getPoseBlendFraction() const
+{
+	return PoseCache::isSnapping() ? PoseCache::snapBlendFraction(m_blendFraction) : m_blendFraction;
+}
+
 // ======================================================================
 // class TimedBlendSkeletalAnimation: private static member functions
 // ======================================================================
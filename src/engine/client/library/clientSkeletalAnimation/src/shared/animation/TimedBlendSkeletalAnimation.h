@@ -48,6 +48,8 @@ public:
 
 	virtual int                      getTransformCount() const;
 	virtual void                     evaluateTransformComponents(int index, Quaternion &rotation, Vector &translation);
+	virtual bool                     addPoseCacheKey(PoseCache::Key &key) const;
+	virtual void                     receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations);
 
 	virtual int                      getTransformPriority(int index) const;
 	virtual int                      getLocomotionPriority() const;
@@ -77,6 +79,10 @@ private:
 
 	static void  doAnimationAlter(SkeletalAnimation *&animation, float deltaTime);
 
+private:
+
+	float        getPoseBlendFraction() const;
+
 private:
 
 	// disabled
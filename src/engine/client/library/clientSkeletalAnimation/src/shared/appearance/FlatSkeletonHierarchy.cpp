@@ -0,0 +1,749 @@
+// ======================================================================
+//
+// FlatSkeletonHierarchy.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientSkeletalAnimation/FirstClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/FlatSkeletonHierarchy.h"
+
+#include "clientSkeletalAnimation/TransformAnimationResolver.h"
+#include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/Profiler.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedMath/Quaternion.h"
+#include "sharedMath/Transform.h"
+#include "sharedMath/Vector.h"
+
+#include <algorithm>
+#include <vector>
+
+//-----------------------------------
+// The SIMD kernels use SSE2 intrinsics on x86 and x64.  They are compiled
+// for SSE2 on their own and selected at runtime, so the rest of the library
+// does not require it.
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define HIERARCHY_USE_SIMD 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define HIERARCHY_TARGET_SSE2
+#else
+#define HIERARCHY_TARGET_SSE2 __attribute__((target("sse2")))
+#endif
+#else
+#define HIERARCHY_USE_SIMD 0
+#endif
+
+// ======================================================================
+
+namespace FlatSkeletonHierarchyNamespace
+{
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	enum TransformType
+	{
+		TT_unset,
+		TT_joint,
+		TT_missingJoint,
+		TT_hardpoint
+	};
+
+	/// Per-joint components, each stored as its own array of m_jointSlotCount floats.
+	enum JointComponent
+	{
+		JC_bindPoseRotationW,
+		JC_bindPoseRotationX,
+		JC_bindPoseRotationY,
+		JC_bindPoseRotationZ,
+		JC_preMultiplyRotationW,
+		JC_preMultiplyRotationX,
+		JC_preMultiplyRotationY,
+		JC_preMultiplyRotationZ,
+		JC_postMultiplyRotationW,
+		JC_postMultiplyRotationX,
+		JC_postMultiplyRotationY,
+		JC_postMultiplyRotationZ,
+		JC_bindPoseTranslationX,
+		JC_bindPoseTranslationY,
+		JC_bindPoseTranslationZ,
+		JC_animationRotationW,
+		JC_animationRotationX,
+		JC_animationRotationY,
+		JC_animationRotationZ,
+		JC_animationTranslationX,
+		JC_animationTranslationY,
+		JC_animationTranslationZ,
+
+		JC_count
+	};
+
+	int const cs_matrixFloatCount = 12;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	void  remove();
+	bool  detectSimd();
+
+	void  multiply3x4(float *out, float const *left, float const *right);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	bool  s_installed;
+	bool  s_simdAvailable;
+	bool  s_disableSimd;
+}
+
+using namespace FlatSkeletonHierarchyNamespace;
+
+// ======================================================================
+// namespace FlatSkeletonHierarchyNamespace
+// ======================================================================
+
+void FlatSkeletonHierarchyNamespace::remove()
+{
+	DEBUG_FATAL(!s_installed, ("FlatSkeletonHierarchy not installed."));
+	s_installed = false;
+
+	DebugFlags::unregisterFlag(s_disableSimd);
+}
+
+// ----------------------------------------------------------------------
+
+bool FlatSkeletonHierarchyNamespace::detectSimd()
+{
+#if HIERARCHY_USE_SIMD
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 1)
+		return false;
+
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse2") != 0;
+#endif
+#else
+	return false;
+#endif
+}
+
+// ----------------------------------------------------------------------
+/**
+ * out = left * right for 3x4 row major matrices laid out like Transform.
+ *
+ * The terms are summed in the same order as Transform::multiply() so the
+ * scalar path reproduces the segmented walk exactly.
+ */
+
+inline void FlatSkeletonHierarchyNamespace::multiply3x4(float *out, float const *left, float const *right)
+{
+	for (int row = 0; row < 3; ++row)
+	{
+		float const *const l = left + row * 4;
+		float *const       o = out + row * 4;
+
+		o[0] = l[0] * right[0] + l[1] * right[4] + l[2] * right[8];
+		o[1] = l[0] * right[1] + l[1] * right[5] + l[2] * right[9];
+		o[2] = l[0] * right[2] + l[1] * right[6] + l[2] * right[10];
+		o[3] = l[0] * right[3] + l[1] * right[7] + l[2] * right[11] + l[3];
+	}
+}
+
+// ======================================================================
+// SIMD kernels
+// ======================================================================
+
+#if HIERARCHY_USE_SIMD
+
+namespace FlatSkeletonHierarchyNamespace
+{
+	// ----------------------------------------------------------------------
+	/**
+	 * Per lane select: mask ? a : b.
+	 */
+
+	HIERARCHY_TARGET_SSE2 inline __m128 selectLanes(__m128 const &mask, __m128 const &a, __m128 const &b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	// ----------------------------------------------------------------------
+	/**
+	 * Four Quaternion::operator *() calls at once, including its shortcuts for
+	 * identity operands.
+	 */
+
+	HIERARCHY_TARGET_SSE2 inline void multiplyQuaternions(__m128 const &lw, __m128 const &lx, __m128 const &ly, __m128 const &lz, __m128 const &rw, __m128 const &rx, __m128 const &ry, __m128 const &rz, __m128 &ow, __m128 &ox, __m128 &oy, __m128 &oz)
+	{
+		__m128 const one              = _mm_set1_ps(1.0f);
+		__m128 const rhsIsIdentity    = _mm_cmpge_ps(rw, one);
+		__m128 const lhsIsIdentity    = _mm_cmpge_ps(lw, one);
+
+		__m128 const w = _mm_sub_ps(_mm_mul_ps(lw, rw), _mm_add_ps(_mm_add_ps(_mm_mul_ps(lx, rx), _mm_mul_ps(ly, ry)), _mm_mul_ps(lz, rz)));
+		__m128 const x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lw, rx), _mm_mul_ps(rw, lx)), _mm_sub_ps(_mm_mul_ps(ly, rz), _mm_mul_ps(lz, ry)));
+		__m128 const y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lw, ry), _mm_mul_ps(rw, ly)), _mm_sub_ps(_mm_mul_ps(lz, rx), _mm_mul_ps(lx, rz)));
+		__m128 const z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lw, rz), _mm_mul_ps(rw, lz)), _mm_sub_ps(_mm_mul_ps(lx, ry), _mm_mul_ps(ly, rx)));
+
+		ow = selectLanes(rhsIsIdentity, lw, selectLanes(lhsIsIdentity, rw, w));
+		ox = selectLanes(rhsIsIdentity, lx, selectLanes(lhsIsIdentity, rx, x));
+		oy = selectLanes(rhsIsIdentity, ly, selectLanes(lhsIsIdentity, ry, y));
+		oz = selectLanes(rhsIsIdentity, lz, selectLanes(lhsIsIdentity, rz, z));
+	}
+
+	// ----------------------------------------------------------------------
+
+	HIERARCHY_TARGET_SSE2 inline void storeMatrixRow(__m128 const &lane0, __m128 const &lane1, __m128 const &lane2, __m128 const &lane3, int const *transformIndices, int row, float *matrices)
+	{
+		__m128 const *const lanes[4] = { &lane0, &lane1, &lane2, &lane3 };
+
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			int const transformIndex = transformIndices[lane];
+			if (transformIndex >= 0)
+				_mm_storeu_ps(matrices + transformIndex * cs_matrixFloatCount + row * 4, *lanes[lane]);
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Build the jointToParent matrices of four joints per iteration from the
+ * structure-of-arrays joint data.
+ */
+
+HIERARCHY_TARGET_SSE2 void FlatSkeletonHierarchy::calculateJointToParentTransformsSimd(int const firstJointSlot, int const endJointSlot)
+{
+	float const *const data       = &(*m_jointData)[0];
+	int const          stride     = m_jointSlotCount;
+	float *const       matrices   = &(*m_jointToParentMatrices)[0];
+	int const *const   transforms = &(*m_jointTransformIndices)[0];
+
+	__m128 const one  = _mm_set1_ps(1.0f);
+	__m128 const zero = _mm_setzero_ps();
+	__m128 const two  = _mm_set1_ps(2.0f);
+
+	for (int slot = firstJointSlot; slot < endJointSlot; slot += 4)
+	{
+#define LOAD_COMPONENT(component) _mm_loadu_ps(data + (component) * stride + slot)
+
+		//-- animations are relative to bind pose.  calculate absolute animated rotation and translation.
+		__m128 aw, ax, ay, az;
+		multiplyQuaternions(
+			LOAD_COMPONENT(JC_animationRotationW), LOAD_COMPONENT(JC_animationRotationX), LOAD_COMPONENT(JC_animationRotationY), LOAD_COMPONENT(JC_animationRotationZ),
+			LOAD_COMPONENT(JC_bindPoseRotationW), LOAD_COMPONENT(JC_bindPoseRotationX), LOAD_COMPONENT(JC_bindPoseRotationY), LOAD_COMPONENT(JC_bindPoseRotationZ),
+			aw, ax, ay, az);
+
+		__m128 tx = _mm_add_ps(LOAD_COMPONENT(JC_bindPoseTranslationX), LOAD_COMPONENT(JC_animationTranslationX));
+		__m128 ty = _mm_add_ps(LOAD_COMPONENT(JC_bindPoseTranslationY), LOAD_COMPONENT(JC_animationTranslationY));
+		__m128 tz = _mm_add_ps(LOAD_COMPONENT(JC_bindPoseTranslationZ), LOAD_COMPONENT(JC_animationTranslationZ));
+
+		//-- apply pre-animated and post-animated rotations.
+		__m128 pw, px, py, pz;
+		multiplyQuaternions(
+			aw, ax, ay, az,
+			LOAD_COMPONENT(JC_preMultiplyRotationW), LOAD_COMPONENT(JC_preMultiplyRotationX), LOAD_COMPONENT(JC_preMultiplyRotationY), LOAD_COMPONENT(JC_preMultiplyRotationZ),
+			pw, px, py, pz);
+
+		__m128 w, x, y, z;
+		multiplyQuaternions(
+			LOAD_COMPONENT(JC_postMultiplyRotationW), LOAD_COMPONENT(JC_postMultiplyRotationX), LOAD_COMPONENT(JC_postMultiplyRotationY), LOAD_COMPONENT(JC_postMultiplyRotationZ),
+			pw, px, py, pz,
+			w, x, y, z);
+
+#undef LOAD_COMPONENT
+
+		//-- convert to rotation matrices the way Quaternion::getTransformPreserveTranslation() does.
+		__m128 const yyTimes2 = _mm_mul_ps(_mm_mul_ps(y, y), two);
+		__m128 const zzTimes2 = _mm_mul_ps(_mm_mul_ps(z, z), two);
+		__m128 const xyTimes2 = _mm_mul_ps(_mm_mul_ps(x, y), two);
+		__m128 const wzTimes2 = _mm_mul_ps(_mm_mul_ps(w, z), two);
+		__m128 const xzTimes2 = _mm_mul_ps(_mm_mul_ps(x, z), two);
+		__m128 const wyTimes2 = _mm_mul_ps(_mm_mul_ps(w, y), two);
+		__m128 const xxTimes2 = _mm_mul_ps(_mm_mul_ps(x, x), two);
+		__m128 const yzTimes2 = _mm_mul_ps(_mm_mul_ps(y, z), two);
+		__m128 const wxTimes2 = _mm_mul_ps(_mm_mul_ps(w, x), two);
+
+		__m128 const isIdentity = _mm_cmpge_ps(w, one);
+
+		__m128 m00 = selectLanes(isIdentity, one,  _mm_sub_ps(_mm_sub_ps(one, yyTimes2), zzTimes2));
+		__m128 m01 = selectLanes(isIdentity, zero, _mm_sub_ps(xyTimes2, wzTimes2));
+		__m128 m02 = selectLanes(isIdentity, zero, _mm_add_ps(xzTimes2, wyTimes2));
+
+		__m128 m10 = selectLanes(isIdentity, zero, _mm_add_ps(xyTimes2, wzTimes2));
+		__m128 m11 = selectLanes(isIdentity, one,  _mm_sub_ps(_mm_sub_ps(one, xxTimes2), zzTimes2));
+		__m128 m12 = selectLanes(isIdentity, zero, _mm_sub_ps(yzTimes2, wxTimes2));
+
+		__m128 m20 = selectLanes(isIdentity, zero, _mm_sub_ps(xzTimes2, wyTimes2));
+		__m128 m21 = selectLanes(isIdentity, zero, _mm_add_ps(yzTimes2, wxTimes2));
+		__m128 m22 = selectLanes(isIdentity, one,  _mm_sub_ps(_mm_sub_ps(one, xxTimes2), yyTimes2));
+
+		//-- transpose each matrix row from one component per register to one joint per register.
+		_MM_TRANSPOSE4_PS(m00, m01, m02, tx);
+		_MM_TRANSPOSE4_PS(m10, m11, m12, ty);
+		_MM_TRANSPOSE4_PS(m20, m21, m22, tz);
+
+		storeMatrixRow(m00, m01, m02, tx, transforms + slot, 0, matrices);
+		storeMatrixRow(m10, m11, m12, ty, transforms + slot, 1, matrices);
+		storeMatrixRow(m20, m21, m22, tz, transforms + slot, 2, matrices);
+	}
+}
+
+// ----------------------------------------------------------------------
+
+HIERARCHY_TARGET_SSE2 void FlatSkeletonHierarchy::calculateJointToRootTransformsSimd(float const *rootToSkeleton, int const firstTransformIndex, int const endTransformIndex, float *jointToRoot) const
+{
+	int const *const   parentIndices  = &(*m_parentIndices)[0];
+	int const *const   transformTypes = &(*m_transformTypes)[0];
+	float const *const jointToParent  = &(*m_jointToParentMatrices)[0];
+
+	for (int i = firstTransformIndex; i < endTransformIndex; ++i)
+	{
+		if (transformTypes[i] != TT_joint)
+			continue;
+
+		int const          parentIndex = parentIndices[i];
+		float const *const parent      = (parentIndex < 0) ? rootToSkeleton : jointToRoot + parentIndex * cs_matrixFloatCount;
+		float const *const local       = jointToParent + i * cs_matrixFloatCount;
+		float *const       dest        = jointToRoot + i * cs_matrixFloatCount;
+
+		__m128 const localRow0 = _mm_loadu_ps(local);
+		__m128 const localRow1 = _mm_loadu_ps(local + 4);
+		__m128 const localRow2 = _mm_loadu_ps(local + 8);
+
+		for (int row = 0; row < 3; ++row)
+		{
+			float const *const p = parent + row * 4;
+
+			__m128 result = _mm_mul_ps(_mm_set1_ps(p[0]), localRow0);
+			result        = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(p[1]), localRow1));
+			result        = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(p[2]), localRow2));
+			result        = _mm_add_ps(result, _mm_setr_ps(0.0f, 0.0f, 0.0f, p[3]));
+
+			_mm_storeu_ps(dest + row * 4, result);
+		}
+	}
+}
+
+#else
+
+// ----------------------------------------------------------------------
+
+void FlatSkeletonHierarchy::calculateJointToParentTransformsSimd(int const firstJointSlot, int const endJointSlot)
+{
+	calculateJointToParentTransformsScalar(firstJointSlot, endJointSlot);
+}
+
+// ----------------------------------------------------------------------
+
+void FlatSkeletonHierarchy::calculateJointToRootTransformsSimd(float const *rootToSkeleton, int const firstTransformIndex, int const endTransformIndex, float *jointToRoot) const
+{
+	calculateJointToRootTransformsScalar(rootToSkeleton, firstTransformIndex, endTransformIndex, jointToRoot);
+}
+
+#endif
+
+// ======================================================================
+// class FlatSkeletonHierarchy: PUBLIC STATIC
+// ======================================================================
+
+void FlatSkeletonHierarchy::install()
+{
+	DEBUG_FATAL(s_installed, ("FlatSkeletonHierarchy already installed."));
+
+	//-- the kernels read and write Transform arrays as packed 3x4 float matrices.
+	FATAL(sizeof(Transform) != cs_matrixFloatCount * sizeof(float), ("Transform is not a packed 3x4 float matrix (%d bytes).", static_cast<int>(sizeof(Transform))));
+
+	s_simdAvailable = detectSimd();
+	s_disableSimd   = false;
+
+	DebugFlags::registerFlag(s_disableSimd, "ClientSkeletalAnimation/Skeleton", "disableSimdHierarchy");
+
+	s_installed = true;
+	ExitChain::add(remove, "FlatSkeletonHierarchy");
+}
+
+// ----------------------------------------------------------------------
+
+bool FlatSkeletonHierarchy::getUseSimd()
+{
+	return s_simdAvailable && !s_disableSimd;
+}
+
+// ----------------------------------------------------------------------
+
+void FlatSkeletonHierarchy::setUseSimd(bool useSimd)
+{
+	s_disableSimd = !useSimd;
+}
+
+// ======================================================================
+// class FlatSkeletonHierarchy: PUBLIC
+// ======================================================================
+
+FlatSkeletonHierarchy::FlatSkeletonHierarchy() :
+	m_transformCount(0),
+	m_jointCount(0),
+	m_jointSlotCount(0),
+	m_parentIndices(new IntVector),
+	m_transformTypes(new IntVector),
+	m_jointTransformIndices(new IntVector),
+	m_jointAnimationResolverIndices(new IntVector),
+	m_jointData(new FloatVector),
+	m_jointToParentMatrices(new FloatVector)
+{
+}
+
+// ----------------------------------------------------------------------
+
+FlatSkeletonHierarchy::~FlatSkeletonHierarchy()
+{
+	delete m_jointToParentMatrices;
+	delete m_jointData;
+	delete m_jointAnimationResolverIndices;
+	delete m_jointTransformIndices;
+	delete m_transformTypes;
+	delete m_parentIndices;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Start compiling a hierarchy of the given number of transforms.
+ *
+ * Every transform index must then be set exactly once with setJoint() or
+ * setHardpoint() before finish() is called.
+ */
+
+void FlatSkeletonHierarchy::clear(int transformCount)
+{
+	DEBUG_FATAL(transformCount < 0, ("invalid transform count %d", transformCount));
+
+	m_transformCount = transformCount;
+	m_jointCount     = 0;
+
+	//-- pad the joint slots to a multiple of the SIMD width.
+	m_jointSlotCount = (transformCount + 3) & ~3;
+
+	size_t const transformCountSize = static_cast<size_t>(transformCount);
+	size_t const jointSlotCountSize = static_cast<size_t>(m_jointSlotCount);
+
+	m_parentIndices->assign(transformCountSize, -1);
+	m_transformTypes->assign(transformCountSize, static_cast<int>(TT_unset));
+
+	m_jointTransformIndices->assign(jointSlotCountSize, -1);
+	m_jointAnimationResolverIndices->assign(jointSlotCountSize, -1);
+
+	//-- unused slots hold identity rotations and zero translations.
+	m_jointData->assign(jointSlotCountSize * static_cast<size_t>(JC_count), 0.0f);
+	std::fill(m_jointData->begin() + JC_bindPoseRotationW     * m_jointSlotCount, m_jointData->begin() + (JC_bindPoseRotationW + 1)     * m_jointSlotCount, 1.0f);
+	std::fill(m_jointData->begin() + JC_preMultiplyRotationW  * m_jointSlotCount, m_jointData->begin() + (JC_preMultiplyRotationW + 1)  * m_jointSlotCount, 1.0f);
+	std::fill(m_jointData->begin() + JC_postMultiplyRotationW * m_jointSlotCount, m_jointData->begin() + (JC_postMultiplyRotationW + 1) * m_jointSlotCount, 1.0f);
+	std::fill(m_jointData->begin() + JC_animationRotationW    * m_jointSlotCount, m_jointData->begin() + (JC_animationRotationW + 1)    * m_jointSlotCount, 1.0f);
+
+	m_jointToParentMatrices->assign(transformCountSize * static_cast<size_t>(cs_matrixFloatCount), 0.0f);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Add a joint to the hierarchy.
+ *
+ * @param transformIndex          the skeleton global transform index of the joint.
+ * @param parentIndex             the skeleton global transform index of its parent,
+ *                                or -1 for the root of the skeleton.
+ * @param animationResolverIndex  the joint's index in the animation resolver, or -1
+ *                                if the resolver has no entry.  Such joints are not
+ *                                evaluated.
+ */
+
+void FlatSkeletonHierarchy::setJoint(int transformIndex, int parentIndex, int animationResolverIndex, Quaternion const &bindPoseRotation, Vector const &bindPoseTranslation, Quaternion const &preMultiplyRotation, Quaternion const &postMultiplyRotation)
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, transformIndex, m_transformCount);
+	DEBUG_FATAL(parentIndex >= transformIndex, ("invalid: child transform [%d] exists before parent transform [%d]", transformIndex, parentIndex));
+	DEBUG_FATAL((*m_transformTypes)[static_cast<size_t>(transformIndex)] != TT_unset, ("transform [%d] set twice", transformIndex));
+
+	(*m_parentIndices)[static_cast<size_t>(transformIndex)] = parentIndex;
+
+	if (animationResolverIndex < 0)
+	{
+		(*m_transformTypes)[static_cast<size_t>(transformIndex)] = TT_missingJoint;
+		return;
+	}
+
+	(*m_transformTypes)[static_cast<size_t>(transformIndex)] = TT_joint;
+
+	int const    slot     = m_jointCount++;
+	size_t const slotSize = static_cast<size_t>(slot);
+
+	(*m_jointTransformIndices)[slotSize]         = transformIndex;
+	(*m_jointAnimationResolverIndices)[slotSize] = animationResolverIndex;
+
+	float *const data = &(*m_jointData)[slotSize];
+
+	data[JC_bindPoseRotationW * m_jointSlotCount]     = bindPoseRotation.w;
+	data[JC_bindPoseRotationX * m_jointSlotCount]     = bindPoseRotation.x;
+	data[JC_bindPoseRotationY * m_jointSlotCount]     = bindPoseRotation.y;
+	data[JC_bindPoseRotationZ * m_jointSlotCount]     = bindPoseRotation.z;
+
+	data[JC_preMultiplyRotationW * m_jointSlotCount]  = preMultiplyRotation.w;
+	data[JC_preMultiplyRotationX * m_jointSlotCount]  = preMultiplyRotation.x;
+	data[JC_preMultiplyRotationY * m_jointSlotCount]  = preMultiplyRotation.y;
+	data[JC_preMultiplyRotationZ * m_jointSlotCount]  = preMultiplyRotation.z;
+
+	data[JC_postMultiplyRotationW * m_jointSlotCount] = postMultiplyRotation.w;
+	data[JC_postMultiplyRotationX * m_jointSlotCount] = postMultiplyRotation.x;
+	data[JC_postMultiplyRotationY * m_jointSlotCount] = postMultiplyRotation.y;
+	data[JC_postMultiplyRotationZ * m_jointSlotCount] = postMultiplyRotation.z;
+
+	data[JC_bindPoseTranslationX * m_jointSlotCount]  = bindPoseTranslation.x;
+	data[JC_bindPoseTranslationY * m_jointSlotCount]  = bindPoseTranslation.y;
+	data[JC_bindPoseTranslationZ * m_jointSlotCount]  = bindPoseTranslation.z;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Add a hardpoint to the hierarchy.  Hardpoints are not animated, so their
+ * hardpointToParent transform is stored once here.
+ */
+
+void FlatSkeletonHierarchy::setHardpoint(int transformIndex, int parentIndex, Transform const &hardpointToParent)
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, transformIndex, m_transformCount);
+	DEBUG_FATAL(parentIndex < 0, ("hardpoint [%d] has no parent", transformIndex));
+	DEBUG_FATAL(parentIndex >= transformIndex, ("invalid: child transform [%d] exists before parent transform [%d]", transformIndex, parentIndex));
+	DEBUG_FATAL((*m_transformTypes)[static_cast<size_t>(transformIndex)] != TT_unset, ("transform [%d] set twice", transformIndex));
+
+	(*m_parentIndices)[static_cast<size_t>(transformIndex)]  = parentIndex;
+	(*m_transformTypes)[static_cast<size_t>(transformIndex)] = TT_hardpoint;
+
+	memcpy(&(*m_jointToParentMatrices)[static_cast<size_t>(transformIndex * cs_matrixFloatCount)], hardpointToParent.getMatrix(), cs_matrixFloatCount * sizeof(float));
+}
+
+// ----------------------------------------------------------------------
+
+void FlatSkeletonHierarchy::finish()
+{
+#ifdef _DEBUG
+	for (int i = 0; i < m_transformCount; ++i)
+		DEBUG_FATAL((*m_transformTypes)[static_cast<size_t>(i)] == TT_unset, ("transform [%d] of [%d] was never set", i, m_transformCount));
+#endif
+}
+
+// ----------------------------------------------------------------------
+
+int FlatSkeletonHierarchy::getParentIndex(int transformIndex) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, transformIndex, m_transformCount);
+	return (*m_parentIndices)[static_cast<size_t>(transformIndex)];
+}
+
+// ----------------------------------------------------------------------
+
+bool FlatSkeletonHierarchy::isJoint(int transformIndex) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, transformIndex, m_transformCount);
+
+	int const transformType = (*m_transformTypes)[static_cast<size_t>(transformIndex)];
+	return (transformType == TT_joint) || (transformType == TT_missingJoint);
+}
+
+// ----------------------------------------------------------------------
+
+bool FlatSkeletonHierarchy::isHardpoint(int transformIndex) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, transformIndex, m_transformCount);
+	return (*m_transformTypes)[static_cast<size_t>(transformIndex)] == TT_hardpoint;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Joints the animation resolver has no entry for are skipped, leaving
+ * their jointToRoot transforms untouched.
+ */
+
+bool FlatSkeletonHierarchy::isEvaluated(int transformIndex) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, transformIndex, m_transformCount);
+	return (*m_transformTypes)[static_cast<size_t>(transformIndex)] != TT_missingJoint;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Gather this frame's animated transform components and rebuild the
+ * jointToParent matrices of every joint.
+ */
+
+void FlatSkeletonHierarchy::calculateJointToParentTransforms(TransformAnimationResolver const &animationResolver)
+{
+	NP_PROFILER_AUTO_BLOCK_DEFINE("FlatSkeletonHierarchy::calculateJointToParentTransforms");
+
+	if (m_jointCount <= 0)
+		return;
+
+	//-- gather the animation resolver output into the structure-of-arrays storage.
+	{
+		float *const rotationW    = &(*m_jointData)[static_cast<size_t>(JC_animationRotationW * m_jointSlotCount)];
+		float *const rotationX    = rotationW + m_jointSlotCount;
+		float *const rotationY    = rotationX + m_jointSlotCount;
+		float *const rotationZ    = rotationY + m_jointSlotCount;
+		float *const translationX = rotationZ + m_jointSlotCount;
+		float *const translationY = translationX + m_jointSlotCount;
+		float *const translationZ = translationY + m_jointSlotCount;
+
+		int const *const resolverIndices = &(*m_jointAnimationResolverIndices)[0];
+
+		Quaternion  rotation;
+		Vector      translation;
+
+		for (int slot = 0; slot < m_jointCount; ++slot)
+		{
+			animationResolver.getTransformComponents(resolverIndices[slot], rotation, translation);
+
+			rotationW[slot]    = rotation.w;
+			rotationX[slot]    = rotation.x;
+			rotationY[slot]    = rotation.y;
+			rotationZ[slot]    = rotation.z;
+			translationX[slot] = translation.x;
+			translationY[slot] = translation.y;
+			translationZ[slot] = translation.z;
+		}
+	}
+
+	//-- build the matrices.
+	int const endJointSlot = (m_jointCount + 3) & ~3;
+
+	if (getUseSimd())
+		calculateJointToParentTransformsSimd(0, endJointSlot);
+	else
+		calculateJointToParentTransformsScalar(0, m_jointCount);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Retrieve the jointToParent transform built by the most recent call to
+ * calculateJointToParentTransforms().  Used to feed transform modifiers.
+ */
+
+void FlatSkeletonHierarchy::getJointToParentTransform(int transformIndex, Transform &jointToParent) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, transformIndex, m_transformCount);
+
+	float const *const m = &(*m_jointToParentMatrices)[static_cast<size_t>(transformIndex * cs_matrixFloatCount)];
+
+	jointToParent.setLocalFrameIJK_p(Vector(m[0], m[4], m[8]), Vector(m[1], m[5], m[9]), Vector(m[2], m[6], m[10]));
+	jointToParent.setPosition_p(Vector(m[3], m[7], m[11]));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Compose the jointToRoot transforms of a range of the hierarchy.
+ *
+ * Parents of the range must already have been calculated.  Ranges let the
+ * caller stop after a transform to apply transform modifiers to it.
+ *
+ * @param rootToSkeleton         the parent transform of the skeleton root.
+ * @param firstTransformIndex    the first transform to calculate.
+ * @param endTransformIndex      one past the last transform to calculate.
+ * @param jointToRootTransforms  the skeleton's jointToRoot transform array.
+ */
+
+void FlatSkeletonHierarchy::calculateJointToRootTransforms(Transform const &rootToSkeleton, int firstTransformIndex, int endTransformIndex, Transform *jointToRootTransforms) const
+{
+	NOT_NULL(jointToRootTransforms);
+	DEBUG_FATAL((firstTransformIndex < 0) || (endTransformIndex > m_transformCount) || (firstTransformIndex > endTransformIndex), ("invalid transform range [%d, %d) of %d", firstTransformIndex, endTransformIndex, m_transformCount));
+
+	if (firstTransformIndex >= endTransformIndex)
+		return;
+
+	float const *const root        = &rootToSkeleton.getMatrix()[0][0];
+	float *const       jointToRoot = reinterpret_cast<float *>(jointToRootTransforms);
+
+	if (getUseSimd())
+		calculateJointToRootTransformsSimd(root, firstTransformIndex, endTransformIndex, jointToRoot);
+	else
+		calculateJointToRootTransformsScalar(root, firstTransformIndex, endTransformIndex, jointToRoot);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Compose the hardpointToRoot transform of a single hardpoint.
+ *
+ * calculateJointToRootTransforms() skips hardpoints.  The hardpoint's
+ * parent must already have been calculated; if the parent is itself a
+ * hardpoint the caller resolves it first.
+ */
+
+void FlatSkeletonHierarchy::calculateHardpointToRootTransform(int transformIndex, Transform *jointToRootTransforms) const
+{
+	NOT_NULL(jointToRootTransforms);
+	DEBUG_FATAL(!isHardpoint(transformIndex), ("transform [%d] is not a hardpoint", transformIndex));
+
+	int const    parentIndex = (*m_parentIndices)[static_cast<size_t>(transformIndex)];
+	float *const jointToRoot = reinterpret_cast<float *>(jointToRootTransforms);
+
+	multiply3x4(jointToRoot + transformIndex * cs_matrixFloatCount, jointToRoot + parentIndex * cs_matrixFloatCount, &(*m_jointToParentMatrices)[static_cast<size_t>(transformIndex * cs_matrixFloatCount)]);
+}
+
+// ======================================================================
+// class FlatSkeletonHierarchy: PRIVATE
+// ======================================================================
+
+void FlatSkeletonHierarchy::calculateJointToParentTransformsScalar(int const firstJointSlot, int const endJointSlot)
+{
+	float const *const data = &(*m_jointData)[0];
+	int const          stride = m_jointSlotCount;
+
+	Transform jointToParentTransform(Transform::IF_none);
+
+	for (int slot = firstJointSlot; slot < endJointSlot; ++slot)
+	{
+		int const transformIndex = (*m_jointTransformIndices)[static_cast<size_t>(slot)];
+		if (transformIndex < 0)
+			continue;
+
+#define COMPONENT(component) data[(component) * stride + slot]
+
+		Quaternion const animationRotation(COMPONENT(JC_animationRotationW), COMPONENT(JC_animationRotationX), COMPONENT(JC_animationRotationY), COMPONENT(JC_animationRotationZ));
+		Quaternion const bindPoseRotation(COMPONENT(JC_bindPoseRotationW), COMPONENT(JC_bindPoseRotationX), COMPONENT(JC_bindPoseRotationY), COMPONENT(JC_bindPoseRotationZ));
+		Quaternion const preMultiplyRotation(COMPONENT(JC_preMultiplyRotationW), COMPONENT(JC_preMultiplyRotationX), COMPONENT(JC_preMultiplyRotationY), COMPONENT(JC_preMultiplyRotationZ));
+		Quaternion const postMultiplyRotation(COMPONENT(JC_postMultiplyRotationW), COMPONENT(JC_postMultiplyRotationX), COMPONENT(JC_postMultiplyRotationY), COMPONENT(JC_postMultiplyRotationZ));
+
+		Vector const bindPoseTranslation(COMPONENT(JC_bindPoseTranslationX), COMPONENT(JC_bindPoseTranslationY), COMPONENT(JC_bindPoseTranslationZ));
+		Vector const animationTranslation(COMPONENT(JC_animationTranslationX), COMPONENT(JC_animationTranslationY), COMPONENT(JC_animationTranslationZ));
+
+#undef COMPONENT
+
+		Quaternion const animatedRotation      = animationRotation * bindPoseRotation;
+		Quaternion const localToParentRotation = postMultiplyRotation * (animatedRotation * preMultiplyRotation);
+
+		localToParentRotation.getTransformPreserveTranslation(&jointToParentTransform);
+		jointToParentTransform.setPosition_p(bindPoseTranslation + animationTranslation);
+
+		memcpy(&(*m_jointToParentMatrices)[static_cast<size_t>(transformIndex * cs_matrixFloatCount)], jointToParentTransform.getMatrix(), cs_matrixFloatCount * sizeof(float));
+	}
+}
+
+// ----------------------------------------------------------------------
+
+void FlatSkeletonHierarchy::calculateJointToRootTransformsScalar(float const *rootToSkeleton, int const firstTransformIndex, int const endTransformIndex, float *jointToRoot) const
+{
+	int const *const   parentIndices  = &(*m_parentIndices)[0];
+	int const *const   transformTypes = &(*m_transformTypes)[0];
+	float const *const jointToParent  = &(*m_jointToParentMatrices)[0];
+
+	for (int i = firstTransformIndex; i < endTransformIndex; ++i)
+	{
+		if (transformTypes[i] != TT_joint)
+			continue;
+
+		int const          parentIndex = parentIndices[i];
+		float const *const parent      = (parentIndex < 0) ? rootToSkeleton : jointToRoot + parentIndex * cs_matrixFloatCount;
+
+		multiply3x4(jointToRoot + i * cs_matrixFloatCount, parent, jointToParent + i * cs_matrixFloatCount);
+	}
+}
+
+// ======================================================================
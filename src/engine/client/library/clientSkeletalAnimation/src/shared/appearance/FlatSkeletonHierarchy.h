@@ -0,0 +1,113 @@
+// ======================================================================
+//
+// FlatSkeletonHierarchy.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_FlatSkeletonHierarchy_H
+#define INCLUDED_FlatSkeletonHierarchy_H
+
+// ======================================================================
+
+class Quaternion;
+class Transform;
+class TransformAnimationResolver;
+class Vector;
+
+// ======================================================================
+/**
+ * The joints and hardpoints of every segment of a Skeleton flattened into
+ * a single array of transforms ordered parent before child.
+ *
+ * Skeleton compiles this when its segments or hardpoints change.  Each frame
+ * the animated rotations and translations are gathered from the animation
+ * resolver into structure-of-arrays storage, four joints at a time are turned
+ * into jointToParent matrices, and the joints are composed into jointToRoot
+ * transforms with one linear walk over the parent index array.
+ *
+ * Hardpoints are skipped by the walk.  Most are never queried in a given
+ * frame, so Skeleton resolves each one on demand with
+ * calculateHardpointToRootTransform().
+ *
+ * The SIMD kernels are used on x86 and x64 when the cpu supports SSE2.  The
+ * scalar kernels use the same Quaternion and Transform math as the segment
+ * by segment walk they replace.
+ */
+
+class FlatSkeletonHierarchy
+{
+public:
+
+	static void  install();
+
+	static bool  getUseSimd();
+	static void  setUseSimd(bool useSimd);
+
+public:
+
+	FlatSkeletonHierarchy();
+	~FlatSkeletonHierarchy();
+
+	// building
+	void  clear(int transformCount);
+	void  setJoint(int transformIndex, int parentIndex, int animationResolverIndex, Quaternion const &bindPoseRotation, Vector const &bindPoseTranslation, Quaternion const &preMultiplyRotation, Quaternion const &postMultiplyRotation);
+	void  setHardpoint(int transformIndex, int parentIndex, Transform const &hardpointToParent);
+	void  finish();
+
+	int   getTransformCount() const;
+	int   getParentIndex(int transformIndex) const;
+	bool  isJoint(int transformIndex) const;
+	bool  isHardpoint(int transformIndex) const;
+	bool  isEvaluated(int transformIndex) const;
+
+	// evaluation
+	void  calculateJointToParentTransforms(TransformAnimationResolver const &animationResolver);
+	void  getJointToParentTransform(int transformIndex, Transform &jointToParent) const;
+	void  calculateJointToRootTransforms(Transform const &rootToSkeleton, int firstTransformIndex, int endTransformIndex, Transform *jointToRootTransforms) const;
+	void  calculateHardpointToRootTransform(int transformIndex, Transform *jointToRootTransforms) const;
+
+private:
+
+	typedef stdvector<int>::fwd    IntVector;
+	typedef stdvector<float>::fwd  FloatVector;
+
+private:
+
+	void  calculateJointToParentTransformsScalar(int firstJointSlot, int endJointSlot);
+	void  calculateJointToParentTransformsSimd(int firstJointSlot, int endJointSlot);
+
+	void  calculateJointToRootTransformsScalar(float const *rootToSkeleton, int firstTransformIndex, int endTransformIndex, float *jointToRoot) const;
+	void  calculateJointToRootTransformsSimd(float const *rootToSkeleton, int firstTransformIndex, int endTransformIndex, float *jointToRoot) const;
+
+	// disabled
+	FlatSkeletonHierarchy(FlatSkeletonHierarchy const &);
+	FlatSkeletonHierarchy &operator =(FlatSkeletonHierarchy const &);
+
+private:
+
+	int           m_transformCount;
+	int           m_jointCount;
+	int           m_jointSlotCount;
+
+	IntVector    *m_parentIndices;
+	IntVector    *m_transformTypes;
+
+	IntVector    *m_jointTransformIndices;
+	IntVector    *m_jointAnimationResolverIndices;
+	FloatVector  *m_jointData;
+
+	FloatVector  *m_jointToParentMatrices;
+
+};
+
+// ======================================================================
+
+inline int FlatSkeletonHierarchy::getTransformCount() const
+{
+	return m_transformCount;
+}
+
+// ======================================================================
+
+#endif
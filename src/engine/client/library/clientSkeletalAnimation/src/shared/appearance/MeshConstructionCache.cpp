@@ -0,0 +1,666 @@
+// ======================================================================
+//
+// MeshConstructionCache.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientSkeletalAnimation/FirstClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/MeshConstructionCache.h"
+
+#include "clientSkeletalAnimation/ConfigClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/MeshConstructionHelper.h"
+#include "clientSkeletalAnimation/SkeletalMeshGeneratorTemplate.h"
+#include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedFile/AsynchronousLoader.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedFoundation/Os.h"
+#include "sharedSynchronization/Mutex.h"
+#include "sharedSynchronization/Semaphore.h"
+#include "sharedThread/RunThread.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <stdio.h>
+#include <vector>
+
+// ======================================================================
+
+namespace MeshConstructionCacheNamespace
+{
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	typedef std::vector<int>   IntVector;
+	typedef std::vector<bool>  BoolVector;
+
+	struct Key
+	{
+		Key();
+
+		bool  operator <(Key const &rhs) const;
+
+		SkeletalMeshGeneratorTemplate const *meshGeneratorTemplate;
+		bool                                 hasBlendValues;
+		IntVector                            blendValues;
+		IntVector                            transformIndices;
+		BoolVector                           combinationsOccluded;
+	};
+
+	typedef MeshConstructionCache::Request           Entry;
+	typedef MeshConstructionCache::RequestVector     RequestVector;
+
+	typedef std::map<Key, Entry*>                   EntryMap;
+	typedef std::deque<Entry*>                      EntryQueue;
+	typedef std::vector<EntryMap::iterator>         EntryIteratorVector;
+	typedef std::vector<FuncPtrThreadZero::Handle>  ThreadVector;
+
+	struct Statistics
+	{
+		int   hitCount;
+		int   synchronousBuildCount;
+		int   deferredBuildCount;
+		int   workerBuildCount;
+		int   evictionCount;
+		float synchronousBuildTime;
+		float workerBuildTime;
+
+		int   frameCount;
+		int   rebuildFrameCount;
+		int   hitchFrameCount;
+		float rebuildTime;
+		float longestRebuildFrameTime;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	void    remove();
+	void    threadRoutine();
+	void    rollFrame();
+	void    evictEntries(int maxEntryCount);
+	Entry  *insertEntry(Key const &key);
+	void    addRequest(Entry &entry);
+	void    freeEntry(EntryMap::iterator it);
+	void    reportStatistics();
+	void    resetStatistics();
+
+	bool    compareLastUsedFrameNumber(EntryMap::iterator const &lhs, EntryMap::iterator const &rhs);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	bool                     s_installed;
+
+	bool                     s_enabled;
+	bool                     s_disableAsynchronousBuilds;
+	bool                     s_reportStatistics;
+	bool                     s_resetStatistics;
+	int                      s_maxEntryCount;
+	float                    s_hitchSeconds;
+
+	EntryMap                 s_entries;
+	MeshConstructionHelper  *s_synchronousMesh;
+
+	RequestVector           *s_deferredRequests;
+
+	// shared with the worker threads, guarded by s_mutex
+	Mutex                    s_mutex;
+	Semaphore               *s_requestSemaphore;
+	ThreadVector             s_threads;
+	EntryQueue               s_requestQueue;
+	bool                     s_quit;
+	int                      s_workerBuildCount;
+	float                    s_workerBuildTime;
+
+	int                      s_frameNumber;
+	float                    s_currentFrameRebuildTime;
+	Statistics               s_statistics;
+}
+
+using namespace MeshConstructionCacheNamespace;
+
+// ======================================================================
+
+struct MeshConstructionCache::Request
+{
+	Key const               *key;
+	MeshConstructionHelper  *mesh;
+	bool                     built;
+	int                      lastUsedFrameNumber;
+
+	/// The number of outstanding requests for this entry.  Pinned entries are not evicted.
+	int                      pinCount;
+};
+
+// ======================================================================
+// namespace MeshConstructionCacheNamespace
+// ======================================================================
+
+MeshConstructionCacheNamespace::Key::Key() :
+	meshGeneratorTemplate(0),
+	hasBlendValues(false),
+	blendValues(),
+	transformIndices(),
+	combinationsOccluded()
+{
+}
+
+// ----------------------------------------------------------------------
+
+bool MeshConstructionCacheNamespace::Key::operator <(Key const &rhs) const
+{
+	if (meshGeneratorTemplate != rhs.meshGeneratorTemplate)
+		return meshGeneratorTemplate < rhs.meshGeneratorTemplate;
+
+	if (hasBlendValues != rhs.hasBlendValues)
+		return !hasBlendValues;
+
+	if (blendValues != rhs.blendValues)
+		return blendValues < rhs.blendValues;
+
+	if (transformIndices != rhs.transformIndices)
+		return transformIndices < rhs.transformIndices;
+
+	return combinationsOccluded < rhs.combinationsOccluded;
+}
+
+// ----------------------------------------------------------------------
+
+void MeshConstructionCacheNamespace::remove()
+{
+	DEBUG_FATAL(!s_installed, ("MeshConstructionCache not installed."));
+	s_installed = false;
+
+	DebugFlags::unregisterFlag(s_enabled);
+	DebugFlags::unregisterFlag(s_disableAsynchronousBuilds);
+	DebugFlags::unregisterFlag(s_reportStatistics);
+	DebugFlags::unregisterFlag(s_resetStatistics);
+
+	//-- Stop the workers.  Queued requests are dropped; their entries are freed below.
+	if (!s_threads.empty())
+	{
+		s_mutex.enter();
+			s_quit = true;
+			s_requestQueue.clear();
+		s_mutex.leave();
+
+		NOT_NULL(s_requestSemaphore);
+		s_requestSemaphore->signal(static_cast<int>(s_threads.size()));
+
+		for (ThreadVector::iterator it = s_threads.begin(); it != s_threads.end(); ++it)
+			(*it)->wait();
+
+		ThreadVector().swap(s_threads);
+	}
+
+	delete s_requestSemaphore;
+	s_requestSemaphore = 0;
+
+	while (!s_entries.empty())
+		freeEntry(s_entries.begin());
+
+	delete s_synchronousMesh;
+	s_synchronousMesh = 0;
+}
+
+// ----------------------------------------------------------------------
+
+void MeshConstructionCacheNamespace::threadRoutine()
+{
+	for (;;)
+	{
+		s_requestSemaphore->wait();
+
+		s_mutex.enter();
+
+			if (s_quit)
+			{
+				s_mutex.leave();
+				return;
+			}
+
+			Entry *const entry = s_requestQueue.empty() ? 0 : s_requestQueue.front();
+			if (entry)
+				s_requestQueue.pop_front();
+
+		s_mutex.leave();
+
+		if (!entry)
+			continue;
+
+		//-- The key and the template it references stay put until the entry is built.
+		Key const &key = *NON_NULL(entry->key);
+
+		PerformanceTimer timer;
+		timer.start();
+
+		MeshConstructionHelper *const mesh = new MeshConstructionHelper();
+		key.meshGeneratorTemplate->buildMeshConstructionHelper(*mesh, key.hasBlendValues ? &key.blendValues : 0, key.transformIndices, key.combinationsOccluded);
+		mesh->prepareForReading();
+
+		timer.stop();
+
+		s_mutex.enter();
+
+			entry->mesh  = mesh;
+			entry->built = true;
+
+			++s_workerBuildCount;
+			s_workerBuildTime += timer.getElapsedTime();
+
+		s_mutex.leave();
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Close out the rebuild statistics of the previous frame and trim the cache
+ * when the frame number changes.
+ */
+
+void MeshConstructionCacheNamespace::rollFrame()
+{
+	int const frameNumber = Os::getNumberOfUpdates();
+	if (frameNumber == s_frameNumber)
+		return;
+
+	if (s_frameNumber >= 0)
+	{
+		s_statistics.frameCount += frameNumber - s_frameNumber;
+
+		if (s_currentFrameRebuildTime > 0.0f)
+		{
+			++s_statistics.rebuildFrameCount;
+			if (s_currentFrameRebuildTime > s_hitchSeconds)
+				++s_statistics.hitchFrameCount;
+
+			s_statistics.rebuildTime             += s_currentFrameRebuildTime;
+			s_statistics.longestRebuildFrameTime  = std::max(s_statistics.longestRebuildFrameTime, s_currentFrameRebuildTime);
+		}
+	}
+
+	s_frameNumber             = frameNumber;
+	s_currentFrameRebuildTime = 0.0f;
+
+	evictEntries(s_enabled ? s_maxEntryCount : 0);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Free the least recently used built entries until no more than
+ * maxEntryCount remain.
+ *
+ * Entries used during the current frame, entries still waiting on a worker
+ * and entries with outstanding requests are never evicted, so the cache may
+ * temporarily hold more.
+ */
+
+void MeshConstructionCacheNamespace::evictEntries(int const maxEntryCount)
+{
+	if (static_cast<int>(s_entries.size()) <= maxEntryCount)
+		return;
+
+	EntryIteratorVector candidates;
+	candidates.reserve(s_entries.size());
+
+	s_mutex.enter();
+
+		EntryMap::iterator const endIt = s_entries.end();
+		for (EntryMap::iterator it = s_entries.begin(); it != endIt; ++it)
+		{
+			Entry const &entry = *it->second;
+			if (entry.built && (entry.pinCount == 0) && (entry.lastUsedFrameNumber != s_frameNumber))
+				candidates.push_back(it);
+		}
+
+	s_mutex.leave();
+
+	std::sort(candidates.begin(), candidates.end(), compareLastUsedFrameNumber);
+
+	int excessCount = static_cast<int>(s_entries.size()) - maxEntryCount;
+	for (EntryIteratorVector::iterator it = candidates.begin(); (it != candidates.end()) && (excessCount > 0); ++it, --excessCount)
+	{
+		freeEntry(*it);
+		++s_statistics.evictionCount;
+	}
+}
+
+// ----------------------------------------------------------------------
+
+Entry *MeshConstructionCacheNamespace::insertEntry(Key const &key)
+{
+	Entry *const entry = new Entry;
+
+	std::pair<EntryMap::iterator, bool> const result = s_entries.insert(EntryMap::value_type(key, entry));
+	DEBUG_FATAL(!result.second, ("MeshConstructionCache: entry already exists."));
+
+	entry->key                 = &result.first->first;
+	entry->mesh                = 0;
+	entry->built               = false;
+	entry->lastUsedFrameNumber = s_frameNumber;
+	entry->pinCount            = 0;
+
+	//-- Keep the template alive for as long as the key refers to it.
+	key.meshGeneratorTemplate->fetch();
+
+	return entry;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Hand the entry to the innermost BuildScope's caller as a pending request.
+ */
+
+void MeshConstructionCacheNamespace::addRequest(Entry &entry)
+{
+	NOT_NULL(s_deferredRequests);
+
+	++entry.pinCount;
+	s_deferredRequests->push_back(&entry);
+}
+
+// ----------------------------------------------------------------------
+
+void MeshConstructionCacheNamespace::freeEntry(EntryMap::iterator it)
+{
+	Entry *const entry = it->second;
+	NOT_NULL(entry);
+
+	it->first.meshGeneratorTemplate->release();
+
+	delete entry->mesh;
+	delete entry;
+
+	s_entries.erase(it);
+}
+
+// ----------------------------------------------------------------------
+
+bool MeshConstructionCacheNamespace::compareLastUsedFrameNumber(EntryMap::iterator const &lhs, EntryMap::iterator const &rhs)
+{
+	return lhs->second->lastUsedFrameNumber < rhs->second->lastUsedFrameNumber;
+}
+
+// ----------------------------------------------------------------------
+
+void MeshConstructionCacheNamespace::reportStatistics()
+{
+	s_mutex.enter();
+		int const   pendingCount     = static_cast<int>(s_requestQueue.size());
+		int const   workerBuildCount = s_workerBuildCount;
+		float const workerBuildTime  = s_workerBuildTime;
+	s_mutex.leave();
+
+	float const hitchPercent = (s_statistics.frameCount > 0) ? 100.0f * static_cast<float>(s_statistics.hitchFrameCount) / static_cast<float>(s_statistics.frameCount) : 0.0f;
+
+	DEBUG_REPORT_PRINT(true, ("-- MeshConstructionCache %s%s\n", s_enabled ? "" : "(disabled)", MeshConstructionCache::isAsynchronous() ? "" : "(synchronous)"));
+	DEBUG_REPORT_PRINT(true, ("  entries = %d/%d, queued = %d, threads = %d\n", static_cast<int>(s_entries.size()), s_maxEntryCount, pendingCount, static_cast<int>(s_threads.size())));
+	DEBUG_REPORT_PRINT(true, ("  hits = %d, deferred = %d, evicted = %d\n", s_statistics.hitCount, s_statistics.deferredBuildCount, s_statistics.evictionCount));
+	DEBUG_REPORT_PRINT(true, ("  main thread builds = %d in %1.2f ms, worker builds = %d in %1.2f ms\n", s_statistics.synchronousBuildCount, s_statistics.synchronousBuildTime * 1000.0f, workerBuildCount, workerBuildTime * 1000.0f));
+	DEBUG_REPORT_PRINT(true, ("  frames = %d, with rebuilds = %d, hitches (> %1.1f ms) = %d (%1.2f%%)\n", s_statistics.frameCount, s_statistics.rebuildFrameCount, s_hitchSeconds * 1000.0f, s_statistics.hitchFrameCount, hitchPercent));
+	DEBUG_REPORT_PRINT(true, ("  rebuild time = %1.2f ms, longest frame = %1.2f ms\n", s_statistics.rebuildTime * 1000.0f, s_statistics.longestRebuildFrameTime * 1000.0f));
+}
+
+// ----------------------------------------------------------------------
+
+void MeshConstructionCacheNamespace::resetStatistics()
+{
+	//-- one shot
+	s_resetStatistics = false;
+
+	memset(&s_statistics, 0, sizeof(s_statistics));
+
+	s_mutex.enter();
+		s_workerBuildCount = 0;
+		s_workerBuildTime  = 0.0f;
+	s_mutex.leave();
+}
+
+// ======================================================================
+// class MeshConstructionCache::BuildScope
+// ======================================================================
+
+MeshConstructionCache::BuildScope::BuildScope(RequestVector *const deferredRequests) :
+	m_previousDeferredRequests(s_deferredRequests)
+{
+	s_deferredRequests = deferredRequests;
+}
+
+// ----------------------------------------------------------------------
+
+MeshConstructionCache::BuildScope::~BuildScope()
+{
+	s_deferredRequests = m_previousDeferredRequests;
+}
+
+// ======================================================================
+// class MeshConstructionCache: PUBLIC STATIC
+// ======================================================================
+
+void MeshConstructionCache::install()
+{
+	DEBUG_FATAL(s_installed, ("MeshConstructionCache already installed."));
+
+	s_enabled       = ConfigClientSkeletalAnimation::getMeshConstructionCacheEnable();
+	s_maxEntryCount = std::max(1, ConfigClientSkeletalAnimation::getMeshConstructionCacheMaxEntries());
+	s_hitchSeconds  = std::max(0.0f, ConfigClientSkeletalAnimation::getMeshConstructionHitchMilliseconds()) * 0.001f;
+
+	s_synchronousMesh = new MeshConstructionHelper();
+
+	s_deferredRequests        = 0;
+	s_quit                    = false;
+	s_workerBuildCount        = 0;
+	s_workerBuildTime         = 0.0f;
+	s_frameNumber             = -1;
+	s_currentFrameRebuildTime = 0.0f;
+	memset(&s_statistics, 0, sizeof(s_statistics));
+
+	int const threadCount = std::max(0, ConfigClientSkeletalAnimation::getMeshConstructionThreadCount());
+	if (threadCount > 0)
+	{
+		s_requestSemaphore = new Semaphore();
+
+		s_threads.reserve(static_cast<size_t>(threadCount));
+		for (int i = 0; i < threadCount; ++i)
+		{
+			char threadName[64];
+			IGNORE_RETURN(snprintf(threadName, sizeof(threadName), "MeshConstruction%d", i));
+			threadName[sizeof(threadName) - 1] = '\0';
+
+			s_threads.push_back(runNamedThread(threadName, threadRoutine));
+			s_threads.back()->setPriority(Thread::kLow);
+		}
+	}
+
+	DebugFlags::registerFlag(s_enabled, "ClientSkeletalAnimation/MeshConstructionCache", "enabled");
+	DebugFlags::registerFlag(s_disableAsynchronousBuilds, "ClientSkeletalAnimation/MeshConstructionCache", "disableAsynchronousBuilds");
+	DebugFlags::registerFlag(s_reportStatistics, "ClientSkeletalAnimation/MeshConstructionCache", "reportStatistics", reportStatistics);
+	DebugFlags::registerFlag(s_resetStatistics, "ClientSkeletalAnimation/MeshConstructionCache", "resetStatistics", resetStatistics);
+
+	s_installed = true;
+	ExitChain::add(MeshConstructionCacheNamespace::remove, "MeshConstructionCache");
+}
+
+// ----------------------------------------------------------------------
+
+bool MeshConstructionCache::isEnabled()
+{
+	return s_enabled;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * @return  true if cache misses inside a deferring BuildScope go to the
+ *          worker threads.  Builds stay synchronous when there are no
+ *          workers or when asynchronous loading is disabled, since code
+ *          that disables it expects appearances to be complete at once.
+ */
+
+bool MeshConstructionCache::isAsynchronous()
+{
+	return s_enabled && !s_disableAsynchronousBuilds && !s_threads.empty() && AsynchronousLoader::isEnabled();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * @return  true if the worker threads have finished every mesh in requests.
+ */
+
+bool MeshConstructionCache::isReady(RequestVector const &requests)
+{
+	bool ready = true;
+
+	s_mutex.enter();
+
+		RequestVector::const_iterator const endIt = requests.end();
+		for (RequestVector::const_iterator it = requests.begin(); ready && (it != endIt); ++it)
+			ready = NON_NULL(*it)->built;
+
+	s_mutex.leave();
+
+	return ready;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Give back requests collected by a BuildScope and clear the vector.  The
+ * entries they refer to become eligible for eviction again.
+ */
+
+void MeshConstructionCache::releaseRequests(RequestVector &requests)
+{
+	//-- Appearances can outlive the cache at exit; its entries are gone by then.
+	if (s_installed)
+	{
+		RequestVector::const_iterator const endIt = requests.end();
+		for (RequestVector::const_iterator it = requests.begin(); it != endIt; ++it)
+		{
+			Entry &entry = *NON_NULL(*it);
+			DEBUG_FATAL(entry.pinCount <= 0, ("MeshConstructionCache: released an entry that was not requested."));
+			--entry.pinCount;
+		}
+	}
+
+	requests.clear();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Retrieve the mesh built from the given inputs.
+ *
+ * The returned mesh is prepared for reading and remains valid until the
+ * next call into the cache.
+ *
+ * @return  the mesh, or NULL if it has been queued for a worker thread.
+ *          NULL is only returned inside a BuildScope that collects
+ *          deferred requests; the request is added to its vector.
+ */
+
+MeshConstructionHelper const *MeshConstructionCache::fetchMesh(SkeletalMeshGeneratorTemplate const &meshGeneratorTemplate, IntVector const *blendValues, IntVector const &localToOutputTransformIndices, BoolVector const &combinationsOccluded)
+{
+	DEBUG_FATAL(!s_installed, ("MeshConstructionCache not installed."));
+
+	rollFrame();
+
+	Key key;
+	key.meshGeneratorTemplate = &meshGeneratorTemplate;
+	key.hasBlendValues        = (blendValues != 0);
+	if (blendValues)
+		key.blendValues = *blendValues;
+	key.transformIndices     = localToOutputTransformIndices;
+	key.combinationsOccluded = combinationsOccluded;
+
+	bool const deferMisses = (s_deferredRequests != 0) && isAsynchronous();
+
+	EntryMap::iterator const it = s_entries.find(key);
+	if (it != s_entries.end())
+	{
+		Entry &entry = *it->second;
+
+		s_mutex.enter();
+			bool const built = entry.built;
+		s_mutex.leave();
+
+		entry.lastUsedFrameNumber = s_frameNumber;
+
+		if (built)
+		{
+			++s_statistics.hitCount;
+			return NON_NULL(entry.mesh);
+		}
+
+		//-- Still being built.
+		if (deferMisses)
+		{
+			addRequest(entry);
+			return 0;
+		}
+
+		//-- The caller can't wait.  Build a private copy; the worker's result is kept for later.
+		PerformanceTimer timer;
+		timer.start();
+
+		s_synchronousMesh->clearAllData();
+		meshGeneratorTemplate.buildMeshConstructionHelper(*s_synchronousMesh, blendValues, localToOutputTransformIndices, combinationsOccluded);
+		s_synchronousMesh->prepareForReading();
+
+		timer.stop();
+
+		++s_statistics.synchronousBuildCount;
+		s_statistics.synchronousBuildTime += timer.getElapsedTime();
+
+		return s_synchronousMesh;
+	}
+
+	Entry *const entry = insertEntry(key);
+
+	if (deferMisses)
+	{
+		s_mutex.enter();
+			s_requestQueue.push_back(entry);
+		s_mutex.leave();
+
+		s_requestSemaphore->signal();
+
+		++s_statistics.deferredBuildCount;
+		addRequest(*entry);
+		return 0;
+	}
+
+	PerformanceTimer timer;
+	timer.start();
+
+	MeshConstructionHelper *const mesh = new MeshConstructionHelper();
+	meshGeneratorTemplate.buildMeshConstructionHelper(*mesh, blendValues, localToOutputTransformIndices, combinationsOccluded);
+	mesh->prepareForReading();
+
+	timer.stop();
+
+	++s_statistics.synchronousBuildCount;
+	s_statistics.synchronousBuildTime += timer.getElapsedTime();
+
+	//-- No worker knows about this entry, but the flag is read under the lock elsewhere.
+	s_mutex.enter();
+		entry->mesh  = mesh;
+		entry->built = true;
+	s_mutex.leave();
+
+	return mesh;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Charge the main thread time an appearance spent rebuilding a detail level
+ * to the current frame.  Frames whose total exceeds the hitch threshold are
+ * counted as hitches.
+ */
+
+void MeshConstructionCache::addRebuildTime(float const elapsedTime)
+{
+	DEBUG_FATAL(!s_installed, ("MeshConstructionCache not installed."));
+
+	rollFrame();
+	s_currentFrameRebuildTime += elapsedTime;
+}
+
+// ======================================================================
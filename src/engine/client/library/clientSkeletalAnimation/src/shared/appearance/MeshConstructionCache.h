@@ -0,0 +1,99 @@
+// ======================================================================
+//
+// MeshConstructionCache.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_MeshConstructionCache_H
+#define INCLUDED_MeshConstructionCache_H
+
+// ======================================================================
+
+class MeshConstructionHelper;
+class SkeletalMeshGeneratorTemplate;
+
+// ======================================================================
+/**
+ * Builds the mesh data of skeletal mesh generators on background threads
+ * and keeps the results for reuse.
+ *
+ * The MeshConstructionHelper a SkeletalMeshGeneratorTemplate fills depends
+ * only on the template (each one holds a single detail level), the blend
+ * values its CustomizationData selects, the skeleton transform each of its
+ * joints maps to and the occlusion zone combinations hidden by the layers
+ * worn over it.  NPCs wearing the same outfit with the same body shape
+ * produce identical inputs, so the mesh is built once and each of them
+ * creates its shader primitives from the cached copy.
+ *
+ * Inside a BuildScope that collects deferred requests, a mesh that is not
+ * cached yet is queued for a worker thread and fetchMesh() returns NULL.
+ * The scope hands the caller a Request for each such mesh.  The appearance
+ * leaves that detail level dirty, keeps drawing what it had (or waits to
+ * fade in, exactly as it does while assets are asynchronously loading) and
+ * rebuilds once isReady() reports all of its requests finished.  Outside
+ * such a scope a miss is built right away on the calling thread.
+ *
+ * A cache entry with an outstanding Request is never evicted, so the
+ * rebuild that follows is guaranteed to hit.
+ *
+ * Only the geometry is built on the workers.  Shaders, vertex buffers and
+ * texture renderers are created on the main thread from the cached mesh.
+ */
+
+class MeshConstructionCache
+{
+public:
+
+	struct Request;
+
+	typedef stdvector<int>::fwd       IntVector;
+	typedef stdvector<bool>::fwd      BoolVector;
+	typedef stdvector<Request*>::fwd  RequestVector;
+
+	/**
+	 * Allows meshes fetched during its lifetime to be built asynchronously
+	 * when given a vector to collect the requests in; with NULL every miss
+	 * is built right away.  Scopes nest; the innermost one decides.
+	 *
+	 * The collected requests belong to the caller, which must hand them
+	 * back with releaseRequests().
+	 */
+	class BuildScope
+	{
+	public:
+
+		explicit BuildScope(RequestVector *deferredRequests);
+		~BuildScope();
+
+	private:
+
+		// disabled
+		BuildScope();
+		BuildScope(BuildScope const &);
+		BuildScope &operator =(BuildScope const &);
+
+	private:
+
+		RequestVector *const  m_previousDeferredRequests;
+	};
+
+public:
+
+	static void  install();
+
+	static bool  isEnabled();
+	static bool  isAsynchronous();
+
+	static bool  isReady(RequestVector const &requests);
+	static void  releaseRequests(RequestVector &requests);
+
+	static MeshConstructionHelper const *fetchMesh(SkeletalMeshGeneratorTemplate const &meshGeneratorTemplate, IntVector const *blendValues, IntVector const &localToOutputTransformIndices, BoolVector const &combinationsOccluded);
+
+	static void  addRebuildTime(float elapsedTime);
+
+};
+
+// ======================================================================
+
+#endif
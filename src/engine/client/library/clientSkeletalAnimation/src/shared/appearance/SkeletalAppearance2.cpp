@@ -21,12 +21,14 @@
 #include "clientGraphics/Texture.h"
 #include "clientSkeletalAnimation/AnimationEnvironment.h"
 #include "clientSkeletalAnimation/AnimationEnvironmentNames.h"
+#include "clientSkeletalAnimation/AnimationUpdateScheduler.h"
 #include "clientSkeletalAnimation/BasicMeshGeneratorTemplate.h"
 #include "clientSkeletalAnimation/BasicSkeletonTemplate.h"
 #include "clientSkeletalAnimation/CharacterLodManager.h"
 #include "clientSkeletalAnimation/CompositeMesh.h"
 #include "clientSkeletalAnimation/ConfigClientSkeletalAnimation.h"
 #include "clientSkeletalAnimation/FullGeometrySkeletalAppearanceBatchRenderer.h"
+#include "clientSkeletalAnimation/MeshConstructionCache.h"
 #include "clientSkeletalAnimation/MeshGenerator.h"
 #include "clientSkeletalAnimation/MeshGeneratorTemplateList.h"
 #include "clientSkeletalAnimation/SkeletalAppearanceTemplate.h"
@@ -42,6 +44,7 @@
 #include "sharedCollision/CollideParameters.h"
 #include "sharedCollision/CollisionInfo.h"
 #include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/PerformanceTimer.h"
 #include "sharedDebug/Profiler.h"
 #include "sharedDebug/ProfilerTimer.h"
 #include "sharedFoundation/ConstCharCrcLowerString.h"
@@ -110,9 +113,14 @@ namespace SkeletalAppearance2Namespace
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+	typedef std::vector<uint32>  CrcVector;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 	void reportAllocations();
 
 	void fixBoxExtentMinMax(BoxExtent &boxExtent);
+	void getTransformNameCrcs(Skeleton const &skeleton, CrcVector &transformNameCrcs);
 
 #if PRODUCTION == 0
 	void printRenderStatistics();
@@ -153,11 +161,13 @@ namespace SkeletalAppearance2Namespace
 
 	int  s_alterAllocationAmount;
 	int  s_rebuildMeshAllocationAmount;
+	int  s_rebuildMeshDepth;
 	int  s_shaderPrimitiveAllocationAmount;
 
 	float  s_twoOverScreenLength;
 
 	SkeletalAppearance2::ContainsDestroyedAttachmentWearableCallback  s_destroyedAttachmentWearableCallback;
+	SkeletalAppearance2::BuildMeshSynchronouslyCallback               s_buildMeshSynchronouslyCallback;
 
 	bool  s_maximumDesiredDetailLevelEnabled;
 	int   s_maximumDesiredDetailLevelIndex;
@@ -306,6 +316,24 @@ void SkeletalAppearance2Namespace::fixBoxExtentMinMax(BoxExtent &boxExtent)
 	boxExtent.setMax(newMaxVector);
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Collect the name of every transform in the skeleton in index order.
+ * Shader primitives address joints by index, so two skeletons with the
+ * same list can skin each other's primitives.
+ */
+
+void SkeletalAppearance2Namespace::getTransformNameCrcs(Skeleton const &skeleton, CrcVector &transformNameCrcs)
+{
+	int const transformCount = skeleton.getTransformCount();
+
+	transformNameCrcs.clear();
+	transformNameCrcs.reserve(static_cast<CrcVector::size_type>(transformCount));
+
+	for (int i = 0; i < transformCount; ++i)
+		transformNameCrcs.push_back(skeleton.getTransformName(i).getCrc());
+}
+
 // ----------------------------------------------------------------------
 
 #if PRODUCTION == 0
@@ -447,6 +475,41 @@ private:
 
 };
 
+// ======================================================================
+// class SkeletalAppearance2::PendingMeshConstruction
+// ======================================================================
+
+class SkeletalAppearance2::PendingMeshConstruction
+{
+public:
+
+	explicit PendingMeshConstruction(int detailLevelCount);
+	~PendingMeshConstruction();
+
+	bool                                  isPending(int lodIndex) const;
+	bool                                  isReady(int lodIndex) const;
+	MeshConstructionCache::RequestVector &getRequests(int lodIndex);
+
+	void                                  release(int lodIndex);
+	void                                  releaseAll();
+
+private:
+
+	typedef std::vector<MeshConstructionCache::RequestVector>  RequestVectorVector;
+
+private:
+
+	// Disabled.
+	PendingMeshConstruction();
+	PendingMeshConstruction(PendingMeshConstruction const &rhs);
+	PendingMeshConstruction &operator =(PendingMeshConstruction const &rhs);
+
+private:
+
+	RequestVectorVector  m_perLodRequests;
+
+};
+
 // ======================================================================
 
 class SkeletalAppearance2::SkeletonSegmentDescriptor
@@ -540,6 +603,17 @@ void SkeletalAppearance2::setContainsDestroyedAttachmentWearableCallback(Contain
 	s_destroyedAttachmentWearableCallback = callback;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Set the function that picks out appearances whose mesh must never wait
+ * on the MeshConstruction worker threads, such as the player's.
+ */
+
+void SkeletalAppearance2::setBuildMeshSynchronouslyCallback(BuildMeshSynchronouslyCallback callback)
+{
+	s_buildMeshSynchronouslyCallback = callback;
+}
+
 // ----------------------------------------------------------------------
 
 void SkeletalAppearance2::getMaximumDesiredDetailLevel(bool &enabled, int &lodIndex)
@@ -692,6 +766,70 @@ inline TransformModifier const *SkeletalAppearance2::AttachedTransformModifier::
 	return m_transformModifier;
 }
 
+// ======================================================================
+// class SkeletalAppearance2::PendingMeshConstruction
+// ======================================================================
+
+SkeletalAppearance2::PendingMeshConstruction::PendingMeshConstruction(int detailLevelCount) :
+	m_perLodRequests(static_cast<RequestVectorVector::size_type>(std::max(0, detailLevelCount)))
+{
+}
+
+// ----------------------------------------------------------------------
+
+SkeletalAppearance2::PendingMeshConstruction::~PendingMeshConstruction()
+{
+	releaseAll();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * @return  true if mesh data requested for the detail level is still
+ *          outstanding.
+ */
+
+bool SkeletalAppearance2::PendingMeshConstruction::isPending(int lodIndex) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, static_cast<int>(m_perLodRequests.size()));
+	return !m_perLodRequests[static_cast<RequestVectorVector::size_type>(lodIndex)].empty();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * @return  true if the worker threads have finished all of the mesh data
+ *          requested for the detail level.
+ */
+
+bool SkeletalAppearance2::PendingMeshConstruction::isReady(int lodIndex) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, static_cast<int>(m_perLodRequests.size()));
+	return MeshConstructionCache::isReady(m_perLodRequests[static_cast<RequestVectorVector::size_type>(lodIndex)]);
+}
+
+// ----------------------------------------------------------------------
+
+MeshConstructionCache::RequestVector &SkeletalAppearance2::PendingMeshConstruction::getRequests(int lodIndex)
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, static_cast<int>(m_perLodRequests.size()));
+	return m_perLodRequests[static_cast<RequestVectorVector::size_type>(lodIndex)];
+}
+
+// ----------------------------------------------------------------------
+
+void SkeletalAppearance2::PendingMeshConstruction::release(int lodIndex)
+{
+	MeshConstructionCache::releaseRequests(getRequests(lodIndex));
+}
+
+// ----------------------------------------------------------------------
+
+void SkeletalAppearance2::PendingMeshConstruction::releaseAll()
+{
+	RequestVectorVector::iterator const endIt = m_perLodRequests.end();
+	for (RequestVectorVector::iterator it = m_perLodRequests.begin(); it != endIt; ++it)
+		MeshConstructionCache::releaseRequests(*it);
+}
+
 // ======================================================================
 // class SkeletalAppearance2::SkeletonSegmentDescriptor
 // ======================================================================
@@ -1030,6 +1168,7 @@ SkeletalAppearance2::SkeletalAppearance2(const SkeletalAppearanceTemplate *newAp
 	m_showMeshExtent(false),
 	m_displayLodIndex(0),
 	m_lodIsReady(false),
+	m_pendingMeshConstruction(0),
 	m_userControlledDetailLevel(false),
 	m_maxAvailableDetailLevelIndex(0),
 	m_animationLocomotionVelocity(m_animationEnvironment->getVector(AnimationEnvironmentNames::cms_locomotionVelocity)),
@@ -1051,6 +1190,12 @@ SkeletalAppearance2::SkeletalAppearance2(const SkeletalAppearanceTemplate *newAp
 	m_plannedLodSetFrameNumber(-100),
 	m_everyOtherFrameSkinningEnabled(false),
 	m_forceHardSkinningEnabled(false),
+	m_animationElapsedTime(0.0f),
+	m_animationUpdateElapsedTime(0.0f),
+	m_framesSinceAnimationUpdate(Random::random(0, 7)),
+	m_animationRenderFrameNumber(-100),
+	m_animationScreenFraction(0.0f),
+	m_animationCameraDistance(FLT_MAX),
 	m_extentDelegateObject(0),
 	m_extentDelegateTransformed(),
 	m_unloadUnusedResourcesTimer(Random::randomReal(1.f, 2.f)),
@@ -1258,6 +1403,10 @@ SkeletalAppearance2::~SkeletalAppearance2(void)
 	delete m_animationResolver;
 	m_animationResolver=0;
 
+	//-- give back mesh data still being constructed
+	delete m_pendingMeshConstruction;
+	m_pendingMeshConstruction = 0;
+
 	//-- release skeleton instances
 	std::for_each(m_skeletons->begin(), m_skeletons->end(), PointerDeleter());
 	delete m_skeletons;
@@ -1460,7 +1609,7 @@ float SkeletalAppearance2::alter(float deltaTime)
 	// alter the animation resolver.  this will move the animation forward
 	// for the skeleton.  still needs evaluate called to evaluate the
 	// animation.
-	m_animationResolver->alter(deltaTime);
+	alterAnimation(deltaTime);
 
 	//-- Stop memory usage tracking.
 #ifdef _DEBUG
@@ -1541,6 +1690,25 @@ void SkeletalAppearance2::render() const
 	
 	bool skipRender = (screenDiameterFraction <= ConfigClientSkeletalAnimation::getNoRenderScreenFraction());
 
+	//-- Remember how large and how far away we were for the animation update scheduler.  Keep the largest
+	//   of this frame's renders.
+	{
+		int const   frameNumber    = Os::getNumberOfUpdates();
+		float const cameraDistance = camera->getPosition_w().magnitudeBetween(object->getAppearanceSphereCenter_w());
+
+		if (m_animationRenderFrameNumber != frameNumber)
+		{
+			m_animationRenderFrameNumber = frameNumber;
+			m_animationScreenFraction    = screenDiameterFraction;
+			m_animationCameraDistance    = cameraDistance;
+		}
+		else
+		{
+			m_animationScreenFraction = std::max(m_animationScreenFraction, screenDiameterFraction);
+			m_animationCameraDistance = std::min(m_animationCameraDistance, cameraDistance);
+		}
+	}
+
 	/*if(s_maximumDesiredDetailLevelEnabled)
 	{
 		skipRender = false;
@@ -1765,6 +1933,9 @@ void SkeletalAppearance2::render() const
 						else
 							ShaderPrimitiveSorter::addWithAlphaFadeOpacity(*shaderPrimitive, true, m_fadeFraction, true, m_fadeFraction);
 
+						//-- Skin it in the parallel skinning phase before it is drawn.
+						sbsShaderPrimitive->queueSkinning();
+
 #if PRODUCTION == 0
 						//-- Track # shader primitives rendered at each LOD (separate batched from standard rendering).
 						++s_perLodRenderedShaderPrimitiveCount[m_displayLodIndex];
@@ -1786,8 +1957,8 @@ void SkeletalAppearance2::render() const
 				//-- Render attachments.
 				if (m_attachedAppearances && !m_attachedAppearances->empty() && m_showAttachments)
 				{
-					const Transform *const transformToRoot = NON_NULL(getDisplayLodSkeleton())->getJointToRootTransformArray();
-					Transform              transformToWorld(Transform::IF_none);
+					const Skeleton *const skeleton = NON_NULL(getDisplayLodSkeleton());
+					Transform             transformToWorld(Transform::IF_none);
 
 					//-- Be prepared to delete entries where the attached Object has been deleted.
 					bool deletedAnyAttachments = false;
@@ -1813,7 +1984,7 @@ void SkeletalAppearance2::render() const
 							NOT_NULL(attachedObject);
 
 							// Construct hardpointToWorld.
-							transformToWorld.multiply(object->getTransform_o2w(), transformToRoot[aaData->getTransformIndex(m_displayLodIndex)]);
+							transformToWorld.multiply(object->getTransform_o2w(), skeleton->getTransformToRoot(aaData->getTransformIndex(m_displayLodIndex)));
 							attachedAppearance->setTransform_w(transformToWorld);
 
 							// The following line assumes the Object for the attachment is not in the world (reasonable for an attachment).  
@@ -2050,7 +2221,7 @@ bool SkeletalAppearance2::findHardpoint(CrcString const &hardpointName, Transfor
 		skeleton->findTransformIndex(hardpointName, &transformIndex, &foundTransform);
 		if (foundTransform)
 		{
-			hardpointTransform = skeleton->getJointToRootTransformArray()[transformIndex];
+			hardpointTransform = skeleton->getTransformToRoot(transformIndex);
 			return true;
 		}
 	}
@@ -2078,7 +2249,7 @@ bool SkeletalAppearance2::findHardpoint(CrcString const &hardpointName, Transfor
 				transformIndex = (*it)->getTransformIndex(m_displayLodIndex);
 
 				if (skeleton)
-					hardpointTransform.multiply(skeleton->getJointToRootTransformArray()[transformIndex], attachedTransform);
+					hardpointTransform.multiply(skeleton->getTransformToRoot(transformIndex), attachedTransform);
 				else
 					hardpointTransform = attachedTransform;
 
@@ -2142,6 +2313,57 @@ bool SkeletalAppearance2::rebuildIfDirtyAndAvailable()
 // ------------------------------------------------------------------
 
 void SkeletalAppearance2::rebuildMesh(int lodIndex)
+{
+	IGNORE_RETURN(rebuildMesh(lodIndex, false));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Skin the current display detail level now, the same way rendering it
+ * would, without submitting anything to be drawn.
+ *
+ * This is intended for tools that measure the CPU cost of skinning.
+ *
+ * @return  the number of shader primitives that were prepared; 0 if the
+ *          display detail level is not available yet.
+ */
+
+int SkeletalAppearance2::prepareDisplayLodToDraw()
+{
+	if ((m_maxAvailableDetailLevelIndex < 0) || !rebuildIfDirtyAndAvailable())
+		return 0;
+
+	ShaderPrimitiveVector const &shaderPrimitives = getDisplayLodShaderPrimitives();
+	ShaderPrimitiveVector::const_iterator const endIt = shaderPrimitives.end();
+	for (ShaderPrimitiveVector::const_iterator it = shaderPrimitives.begin(); it != endIt; ++it)
+	{
+		ShaderPrimitive const *const primitive = *it;
+		NOT_NULL(primitive);
+
+		primitive->prepareToDraw();
+	}
+
+	return static_cast<int>(shaderPrimitives.size());
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Rebuild the skeleton and shader primitives of a detail level.
+ *
+ * When mesh data is queued for the worker threads the skeleton is rebuilt
+ * right away but the detail level keeps its previous shader primitives and
+ * stays dirty.  The rebuild that follows once the data is ready only builds
+ * the shader primitives.
+ *
+ * @param allowDeferredConstruction  if true, mesh data that is not in the
+ *                                   MeshConstructionCache yet may be queued for
+ *                                   a worker thread instead of built now.
+ *
+ * @return  true if the detail level was rebuilt; false if its mesh data is
+ *          still being constructed, in which case it stays dirty.
+ */
+
+bool SkeletalAppearance2::rebuildMesh(int lodIndex, bool allowDeferredConstruction)
 {
 	NP_PROFILER_AUTO_BLOCK_DEFINE("SkeletalAppearance2::rebuildMesh");
 
@@ -2186,9 +2408,19 @@ void SkeletalAppearance2::rebuildMesh(int lodIndex)
 	//-- Can't do anything if there are no Skeleton instances.
 	if (m_skeletons->empty())
 	{
-		return;
+		return true;
 	}
 
+	//-- Time the rebuild for the hitch statistics.  Rebuilds nested in this one are part of its time.
+	PerformanceTimer  rebuildTimer;
+	rebuildTimer.start();
+	++s_rebuildMeshDepth;
+
+	//-- If this detail level was waiting on mesh construction, its skeleton was rebuilt when the mesh data was
+	//   requested.  Anything that changed the inputs since then marked the appearance dirty and dropped the request.
+	bool const skeletonIsCurrent = (m_pendingMeshConstruction != 0) && m_pendingMeshConstruction->isPending(lodIndex);
+	bool       allowDeferral     = allowDeferredConstruction && !skeletonIsCurrent && !mustBuildMeshSynchronously();
+
 	//-- build the composite mesh from this base appearance and all wearables
 	//   Note: this must happen before we apply each MeshGenerator's skeleton
 	//   modifications below.
@@ -2209,23 +2441,47 @@ void SkeletalAppearance2::rebuildMesh(int lodIndex)
 	Skeleton *const skeleton          = (*m_skeletons)[static_cast<SkeletonVector::size_type>(usedSkeletonIndex)];
 	NOT_NULL(skeleton);
 
-	//-- Modify the LOD skeleton as necessary for each MeshGenerator.
-	skeleton->beginSkeletonModification();
+	if (!skeletonIsCurrent)
+	{
+		//-- The previous shader primitives are drawn while mesh data is being constructed, which only works if
+		//   they still find their joints at the same indices.  Remember the layout they were built against.
+		bool const keepPreviousMesh = allowDeferral && (lodIndex < static_cast<int>(m_perLodShaderPrimitives->size())) && !(*m_perLodShaderPrimitives)[static_cast<ShaderPrimitiveVectorVector::size_type>(lodIndex)].empty();
+
+		CrcVector  previousTransformNameCrcs;
+		if (keepPreviousMesh)
+			getTransformNameCrcs(*skeleton, previousTransformNameCrcs);
+
+		//-- Modify the LOD skeleton as necessary for each MeshGenerator.
+		skeleton->beginSkeletonModification();
 
-	// Build the LOD skeleton from this base appearance and all wearables.
-	addSkeletonSegments(*skeleton, usedSkeletonIndex);
+		// Build the LOD skeleton from this base appearance and all wearables.
+		addSkeletonSegments(*skeleton, usedSkeletonIndex);
 
-	// Apply the skeleton modifications.
-	compositeMesh.applySkeletonModifications(*skeleton);
+		// Apply the skeleton modifications.
+		compositeMesh.applySkeletonModifications(*skeleton);
 
-	// We're done modifying the LOD skeleton
-	skeleton->endSkeletonModification();
+		// We're done modifying the LOD skeleton
+		skeleton->endSkeletonModification();
+
+		// Find the transform indices for all attached appearances at this detail level.  The indices
+		// may have changed when we rebuilt the skeleton if any hardpoints or segments were added or removed.
+		lookupAttachmentTransformIndices(lodIndex);
+
+		//-- Segments or hardpoints came or went.  Build now rather than draw the old primitives on the wrong joints.
+		if (keepPreviousMesh)
+		{
+			CrcVector  transformNameCrcs;
+			getTransformNameCrcs(*skeleton, transformNameCrcs);
 
-	// Find the transform indices for all attached appearances at this detail level.  The indices
-	// may have changed when we rebuilt the skeleton if any hardpoints or segments were added or removed.
-	lookupAttachmentTransformIndices(lodIndex);
+			if (transformNameCrcs != previousTransformNameCrcs)
+				allowDeferral = false;
+		}
+	}
 
 	//-- Handle building the mesh data for shader primitives so long as there's any mesh detail levels.
+	MeshConstructionCache::RequestVector  deferredRequests;
+	bool                                  meshConstructionDeferred = false;
+
 	if (!m_perLodShaderPrimitives->empty())
 	{
 		//-- Build the new shader primitives.  we do this before releasing the old ones so
@@ -2238,7 +2494,13 @@ void SkeletalAppearance2::rebuildMesh(int lodIndex)
 		unsigned long const spBytesAllocatedBefore = MemoryManager::getCurrentNumberOfBytesAllocated();
 #endif
 
-		compositeMesh.addShaderPrimitives(*this, lodIndex, skeleton->getTransformNameMap(), workingShaderPrimitives);
+		{
+			MeshConstructionCache::BuildScope  buildScope(allowDeferral ? &deferredRequests : 0);
+
+			compositeMesh.addShaderPrimitives(*this, lodIndex, skeleton->getTransformNameMap(), workingShaderPrimitives);
+		}
+
+		meshConstructionDeferred = !deferredRequests.empty();
 
 		// Stop tracking memory usage.
 #ifdef _DEBUG
@@ -2249,29 +2511,47 @@ void SkeletalAppearance2::rebuildMesh(int lodIndex)
 		bytesAllocatedBefore += std::max(0, static_cast<int>(spBytesAllocatedAfter - spBytesAllocatedBefore));
 #endif
 
-		//-- swap the new and old --- now m_shaderPrimitives holds the valid shader primitives
+		//-- swap the new and old --- now m_shaderPrimitives holds the valid shader primitives.  If some of the
+		//   mesh data is still being constructed, keep the old ones and throw away the partial set instead.
 		NOT_NULL(m_perLodShaderPrimitives);
 		VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, static_cast<int>(m_perLodShaderPrimitives->size()));
 
-		ShaderPrimitiveVector &shaderPrimitives = (*m_perLodShaderPrimitives)[static_cast<ShaderPrimitiveVectorVector::size_type>(lodIndex)];
-		shaderPrimitives.swap(workingShaderPrimitives);
+		if (!meshConstructionDeferred)
+		{
+			ShaderPrimitiveVector &shaderPrimitives = (*m_perLodShaderPrimitives)[static_cast<ShaderPrimitiveVectorVector::size_type>(lodIndex)];
+			shaderPrimitives.swap(workingShaderPrimitives);
+		}
 
 		//-- release the old shader primitives
 		std::for_each(workingShaderPrimitives.begin(), workingShaderPrimitives.end(), PointerDeleter());
 	}
 
-	//-- Mark as clean.
-	m_appearanceDirty[static_cast<BoolVector::size_type>(lodIndex)] = false; //lint !e1058 // error 1058: (Error -- Initializing a non-const reference '_STL::_Bit_reference &' with a non-lvalue) // This is the class interface.
+	//-- The cache hits above used the mesh data this detail level was waiting on; it may be evicted again.
+	releasePendingMeshConstruction(lodIndex);
 
-	//-- Reset most recently used frame so we don't pitch it as soon as we create it.  Chances
-	//   are we created it because we're going to need it in the next few frames.
-	m_perLodMruFrameVector[static_cast<BoolVector::size_type>(lodIndex)] = Os::getNumberOfUpdates();
+	if (meshConstructionDeferred)
+	{
+		//-- Stay dirty and rebuild once the worker threads have finished all of this detail level's mesh data.
+		if (!m_pendingMeshConstruction)
+			m_pendingMeshConstruction = new PendingMeshConstruction(static_cast<int>(m_appearanceDirty.size()));
+
+		m_pendingMeshConstruction->getRequests(lodIndex).swap(deferredRequests);
+	}
+	else
+	{
+		//-- Mark as clean.
+		m_appearanceDirty[static_cast<BoolVector::size_type>(lodIndex)] = false; //lint !e1058 // error 1058: (Error -- Initializing a non-const reference '_STL::_Bit_reference &' with a non-lvalue) // This is the class interface.
+
+		//-- Reset most recently used frame so we don't pitch it as soon as we create it.  Chances
+		//   are we created it because we're going to need it in the next few frames.
+		m_perLodMruFrameVector[static_cast<BoolVector::size_type>(lodIndex)] = Os::getNumberOfUpdates();
+	}
 
 	//-- Clear out all MeshGenerator instances so we don't leak these MeshGenerator instances.
 	compositeMesh.removeAllMeshGenerators();
 
-	//-- Attach transform modifiers.
-	if (m_attachedTransformModifiers)
+	//-- Attach transform modifiers.  A skeleton that was not rebuilt still has them.
+	if (m_attachedTransformModifiers && !skeletonIsCurrent)
 	{
 		AttachedTransformModifierVector::iterator const endIt = m_attachedTransformModifiers->end();
 		for (AttachedTransformModifierVector::iterator it = m_attachedTransformModifiers->begin(); it != endIt; ++it)
@@ -2293,15 +2573,18 @@ void SkeletalAppearance2::rebuildMesh(int lodIndex)
 		}
 	}
 
-	//-- Build mesh extent/skeleton extent deltas.
-	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, static_cast<int>(m_perLodMeshExtentMinDelta.size()));
-	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, static_cast<int>(m_perLodMeshExtentMaxDelta.size()));
+	//-- Build mesh extent/skeleton extent deltas.  A deferred detail level has no shader primitives to measure yet.
+	if (!meshConstructionDeferred)
+	{
+		VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, static_cast<int>(m_perLodMeshExtentMinDelta.size()));
+		VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, static_cast<int>(m_perLodMeshExtentMaxDelta.size()));
 
-	//-- Update extent deltas.
-	calculateExtentDeltas(lodIndex, m_perLodMeshExtentMinDelta[static_cast<VectorVector::size_type>(lodIndex)], m_perLodMeshExtentMaxDelta[static_cast<VectorVector::size_type>(lodIndex)]);
+		//-- Update extent deltas.
+		calculateExtentDeltas(lodIndex, m_perLodMeshExtentMinDelta[static_cast<VectorVector::size_type>(lodIndex)], m_perLodMeshExtentMaxDelta[static_cast<VectorVector::size_type>(lodIndex)]);
 
-	//-- Update extent.
-	updateExtentWithLod(m_extent, lodIndex);
+		//-- Update extent.
+		updateExtentWithLod(m_extent, lodIndex);
+	}
 
 #if PRODUCTION == 0
 	//-- Stop recording time spent in function.
@@ -2311,11 +2594,17 @@ void SkeletalAppearance2::rebuildMesh(int lodIndex)
 	s_rebuildMeshCallTime += (stopTime - startTime);
 #endif
 
+	rebuildTimer.stop();
+	if (--s_rebuildMeshDepth == 0)
+		MeshConstructionCache::addRebuildTime(rebuildTimer.getElapsedTime());
+
 	//-- Stop memory usage tracking.
 #ifdef _DEBUG
 	unsigned long const bytesAllocatedAfter = MemoryManager::getCurrentNumberOfBytesAllocated();
 	s_rebuildMeshAllocationAmount += std::max(0, static_cast<int>(bytesAllocatedAfter - bytesAllocatedBefore));
 #endif
+
+	return !meshConstructionDeferred;
 }
 
 // ----------------------------------------------------------------------
@@ -2368,8 +2657,8 @@ const Skeleton &SkeletalAppearance2::getSkeleton(int lodIndex) const
 {
 	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, getSkeletonLodCount());
 
-	//-- Ensure skeleton is properly initialized.
-	if (m_appearanceDirty[static_cast<BoolVector::size_type>(lodIndex)])
+	//-- Ensure skeleton is properly initialized.  A detail level waiting on mesh construction already has its new skeleton.
+	if (m_appearanceDirty[static_cast<BoolVector::size_type>(lodIndex)] && !isDrawingPreviousMesh(lodIndex))
 		const_cast<SkeletalAppearance2*>(this)->rebuildMesh(m_displayLodIndex);
 
 	const Skeleton *const skeleton = (*m_skeletons)[static_cast<size_t>(lodIndex)];
@@ -4010,6 +4299,10 @@ void SkeletalAppearance2::markAsDirty()
 	const BoolVector::iterator endIt = m_appearanceDirty.end();
 	for (BoolVector::iterator it = m_appearanceDirty.begin(); it != endIt; ++it)
 		*it = true; //lint !e1058 // error 1058: (Error -- Initializing a non-const reference '_STL::_Bit_reference &' with a non-lvalue) // This is the class interface.
+
+	//-- Mesh data requested for the old inputs is no longer wanted; the next rebuild starts over.
+	if (m_pendingMeshConstruction)
+		m_pendingMeshConstruction->releaseAll();
 }
 
 // ----------------------------------------------------------------------
@@ -4180,7 +4473,7 @@ void SkeletalAppearance2::updateExtentWithLod(BoxExtent &extent, int lodIndex) c
 			const float   radius         = attachedSphere.getRadius();
 
 			const int        transformIndex = (*it)->getTransformIndex(lodIndex);
-			const Transform &transform      = skeleton->getJointToRootTransformArray()[transformIndex];
+			const Transform &transform      = skeleton->getTransformToRoot(transformIndex);
 
 			// Note: this is a cheesed calculation.  Ideally I would deal directly with a box extent.
 			extent.updateMinAndMax(transform.rotateTranslate_l2p(Vector(center.x - radius, center.y - radius, center.z - radius)));
@@ -4239,9 +4532,12 @@ bool SkeletalAppearance2::rebuildIfDirtyAndAvailable(int lodIndex)
 		if (!available)
 			return false;
 
+		//-- Keep using what this detail level had until the worker threads finish all of its mesh data.
+		if (m_pendingMeshConstruction && m_pendingMeshConstruction->isPending(lodIndex) && !m_pendingMeshConstruction->isReady(lodIndex))
+			return isDrawingPreviousMesh(lodIndex);
+
 		//-- Rebuild the mesh.
-		rebuildMesh(lodIndex);
-		return true;
+		return rebuildMesh(lodIndex, true) || isDrawingPreviousMesh(lodIndex);
 	}
 	else
 	{
@@ -4250,6 +4546,46 @@ bool SkeletalAppearance2::rebuildIfDirtyAndAvailable(int lodIndex)
 	}
 }
 
+// ----------------------------------------------------------------------
+/**
+ * @return  true if this appearance's mesh data must be built on the calling
+ *          thread instead of queued for the MeshConstruction workers.
+ */
+
+bool SkeletalAppearance2::mustBuildMeshSynchronously() const
+{
+	//-- The UI draws its appearances when asked, with nothing to fall back on.
+	if (s_uiContextEnabled)
+		return true;
+
+	Object const *const owner = getOwner();
+	return (owner != 0) && (s_buildMeshSynchronouslyCallback != 0) && (*s_buildMeshSynchronouslyCallback)(*owner);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * @return  true if the detail level is dirty and waiting on mesh
+ *          construction but still has the shader primitives it was built
+ *          with before, which remain valid for drawing.
+ */
+
+bool SkeletalAppearance2::isDrawingPreviousMesh(int lodIndex) const
+{
+	if (!m_pendingMeshConstruction || !m_pendingMeshConstruction->isPending(lodIndex))
+		return false;
+
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, static_cast<int>(m_perLodShaderPrimitives->size()));
+	return !(*m_perLodShaderPrimitives)[static_cast<ShaderPrimitiveVectorVector::size_type>(lodIndex)].empty();
+}
+
+// ----------------------------------------------------------------------
+
+void SkeletalAppearance2::releasePendingMeshConstruction(int lodIndex)
+{
+	if (m_pendingMeshConstruction)
+		m_pendingMeshConstruction->release(lodIndex);
+}
+
 // ----------------------------------------------------------------------
 /**
  * If the current display LOD index is dirty, rebuild the current display
@@ -4273,7 +4609,7 @@ bool SkeletalAppearance2::rebuildOrAdjustDisplayLodIndex()
 	do
 	{
 		//-- Check if detail level being tested needs to be built.
-		meshIsDirty = ((testDetailIndex >= 0) && (testDetailIndex <= m_maxAvailableDetailLevelIndex) && m_appearanceDirty[static_cast<BoolVector::size_type>(testDetailIndex)]);
+		meshIsDirty = ((testDetailIndex >= 0) && (testDetailIndex <= m_maxAvailableDetailLevelIndex) && m_appearanceDirty[static_cast<BoolVector::size_type>(testDetailIndex)] && !isDrawingPreviousMesh(testDetailIndex));
 		if (!meshIsDirty)
 			shaderPrimitivesAreReady = areShaderPrimitivesReadyForDetailLevel(testDetailIndex);
 		else
@@ -4404,6 +4740,8 @@ void SkeletalAppearance2::unloadUnusedResources()
 				std::for_each(spVector.begin(), spVector.end(), PointerDeleter());
 				spVector.clear();
 
+				releasePendingMeshConstruction(lodIndex);
+
 				//-- Mark this lod as dirty so we know we have to rebuild the shader primitives when needed.
 				VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, lodIndex, static_cast<int>(m_appearanceDirty.size()));
 				m_appearanceDirty[static_cast<BoolVector::size_type>(lodIndex)] = true; //lint !e1058 // error 1058: (Error -- Initializing a non-const reference '_STL::_Bit_reference &' with a non-lvalue) // This is the class interface. 
@@ -4496,6 +4834,58 @@ void SkeletalAppearance2::handleFade(float elapsedTime)
 	}
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Alter the animation resolver at the rate chosen by the AnimationUpdateScheduler.
+ *
+ * Skipped frames accumulate their elapsed time for the next update.  When
+ * interpolation is enabled, visible appearances below full rate blend
+ * between their two most recent updates on the skipped frames.
+ */
+
+void SkeletalAppearance2::alterAnimation(float elapsedTime)
+{
+	m_animationElapsedTime += elapsedTime;
+
+	//-- Characters in the UI always animate at full rate.
+	bool update         = true;
+	int  updateInterval = 1;
+	bool visible        = true;
+
+	if (!s_uiContextEnabled && AnimationUpdateScheduler::isEnabled())
+	{
+		//-- Render happens after alter, so look at the previous frame's render.
+		visible = (m_animationRenderFrameNumber + 2 >= Os::getNumberOfUpdates());
+		update  = AnimationUpdateScheduler::scheduleUpdate(getOwner(), visible, m_animationScreenFraction, m_animationCameraDistance, m_framesSinceAnimationUpdate, updateInterval);
+	}
+
+	if (update)
+	{
+		PerformanceTimer timer;
+		timer.start();
+
+		if (visible && (updateInterval > 1) && AnimationUpdateScheduler::getInterpolationEnabled())
+			m_animationResolver->alterWithInterpolation(m_animationElapsedTime);
+		else
+			m_animationResolver->alter(m_animationElapsedTime);
+
+		timer.stop();
+		AnimationUpdateScheduler::addUpdateTime(timer.getElapsedTime());
+
+		m_animationUpdateElapsedTime = m_animationElapsedTime;
+		m_animationElapsedTime       = 0.0f;
+		m_framesSinceAnimationUpdate = 0;
+	}
+	else
+	{
+		//-- Blend towards the most recent update over the time that update covered.
+		float const interpolationFraction = (m_animationUpdateElapsedTime > 0.0f) ? (m_animationElapsedTime / m_animationUpdateElapsedTime) : 1.0f;
+		m_animationResolver->skipAlter(elapsedTime, interpolationFraction);
+
+		++m_framesSinceAnimationUpdate;
+	}
+}
+
 // ----------------------------------------------------------------------
 
 void SkeletalAppearance2::updateDpvsTestObjectWithExtents() const
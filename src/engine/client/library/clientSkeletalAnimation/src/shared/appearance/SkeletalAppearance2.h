@@ -65,6 +65,7 @@ public:
 	typedef stdvector<int>::fwd                  IntVector;
 
 	typedef void (*ContainsDestroyedAttachmentWearableCallback)(Object &object);
+	typedef bool (*BuildMeshSynchronouslyCallback)(Object const &object);
 
 	class AttachedAppearance;
 
@@ -81,6 +82,7 @@ public:
 	static void   setShowSkeleton(bool showIt);
 
 	static void   setContainsDestroyedAttachmentWearableCallback(ContainsDestroyedAttachmentWearableCallback callback);
+	static void   setBuildMeshSynchronouslyCallback(BuildMeshSynchronouslyCallback callback);
 
 	static void   getMaximumDesiredDetailLevel(bool &enabled, int &lodIndex);
 	static void   setMaximumDesiredDetailLevel(bool enabled, int lodIndex);
@@ -142,6 +144,7 @@ public:
 
 	bool                                rebuildIfDirtyAndAvailable();
 	void                                rebuildMesh(int lodIndex);
+	int                                 prepareDisplayLodToDraw();
 
 	void                                setShowMesh(bool showIt);
 	void                                setShowAttachments(bool enabled);
@@ -310,6 +313,7 @@ protected:
 private:
 
 	class AttachedTransformModifier;
+	class PendingMeshConstruction;
 	class SkeletonSegmentDescriptor;
 
 	typedef stdvector<AttachedAppearance*>::fwd           AttachedAppearanceVector;
@@ -369,10 +373,15 @@ private:
 	void                              updateExtentWithLod(BoxExtent &extent, int lodIndex) const;
 
 	bool                              rebuildIfDirtyAndAvailable(int lodIndex);
+	bool                              rebuildMesh(int lodIndex, bool allowDeferredConstruction);
+	bool                              mustBuildMeshSynchronously() const;
+	bool                              isDrawingPreviousMesh(int lodIndex) const;
+	void                              releasePendingMeshConstruction(int lodIndex);
 	bool                              rebuildOrAdjustDisplayLodIndex();
 	void                              unloadUnusedResources();
 
 	void                              handleFade(float elapsedTime);
+	void                              alterAnimation(float elapsedTime);
 
 	void                              updateDpvsTestObjectWithExtents() const;
 
@@ -434,6 +443,7 @@ private:
 
 	mutable int                               m_displayLodIndex;
 	mutable bool                              m_lodIsReady;
+	PendingMeshConstruction                  *m_pendingMeshConstruction;
 	bool                                      m_userControlledDetailLevel;
 	int                                       m_maxAvailableDetailLevelIndex;
 
@@ -464,6 +474,16 @@ private:
 	bool                                      m_everyOtherFrameSkinningEnabled;
 	bool                                      m_forceHardSkinningEnabled;
 
+	/// Animation time not yet applied to the resolver and the time applied by its most recent update.
+	float                                     m_animationElapsedTime;
+	float                                     m_animationUpdateElapsedTime;
+	int                                       m_framesSinceAnimationUpdate;
+
+	/// Screen fraction and camera distance from the most recent render, used to schedule animation updates.
+	mutable int                               m_animationRenderFrameNumber;
+	mutable float                             m_animationScreenFraction;
+	mutable float                             m_animationCameraDistance;
+
 	ConstWatcher<Object>                      m_extentDelegateObject;
 	mutable BoxExtent                         m_extentDelegateTransformed;
 
@@ -18,6 +18,7 @@
 #include "clientGraphics/ShaderTemplateList.h"
 #include "clientGraphics/StaticShader.h"
 #include "clientGraphics/Texture.h"
+#include "clientSkeletalAnimation/MeshConstructionCache.h"
 #include "clientSkeletalAnimation/MeshConstructionHelper.h"
 #include "clientSkeletalAnimation/MeshGeneratorTemplateList.h"
 #include "clientSkeletalAnimation/OcclusionZoneSet.h"
@@ -106,8 +107,6 @@ SkeletalMeshGeneratorTemplate::IntVector         SkeletalMeshGeneratorTemplate::
 SkeletalMeshGeneratorTemplate::VectorVector      SkeletalMeshGeneratorTemplate::ms_dynamicHardpointPositions;
 SkeletalMeshGeneratorTemplate::QuaternionVector  SkeletalMeshGeneratorTemplate::ms_dynamicHardpointRotations;
 
-SkeletalMeshGeneratorTemplate::Dot3VectorVector *SkeletalMeshGeneratorTemplate::ms_blendedDot3Vectors;
-
 // ======================================================================
 
 namespace SkeletalMeshGeneratorTemplateNamespace
@@ -211,12 +210,9 @@ namespace SkeletalMeshGeneratorTemplateNamespace
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 
-	// scratchpad data needed during construction.
-
-	// -TRF- if we ever handle creating multiple fixed meshes concurrently (multiple creation threads),
-	// this has to change.
-
-	MCHPSDContainer   *ms_perShaderDataScratchpad;
+	// scratchpad data needed on the main thread while resolving a mesh's inputs.
+	// buildMeshConstructionHelper() keeps its scratch data on the stack so the
+	// MeshConstructionCache worker threads can run it concurrently.
 
 	std::vector<bool> *ms_combinationsOccluded;
 
@@ -1877,10 +1873,8 @@ void SkeletalMeshGeneratorTemplate::install()
 	DEBUG_FATAL(!success, ("failed to register SkeletalMeshGeneratorTemplate class"));
 	UNREF(success);
 
-	ms_perShaderDataScratchpad  = new MCHPSDContainer;
 	ms_combinationsOccluded     = new std::vector<bool>;
 	ms_meshConstructionHelper   = new MeshConstructionHelper();
-	ms_blendedDot3Vectors       = new Dot3VectorVector();
 
 	// install subsystems
 	BlendTarget::install();
@@ -1912,18 +1906,12 @@ void SkeletalMeshGeneratorTemplate::remove()
 	Hardpoint::remove();
 	BlendTarget::remove();
 
-	delete ms_blendedDot3Vectors;
-	ms_blendedDot3Vectors = 0;
-
 	delete ms_meshConstructionHelper;
 	ms_meshConstructionHelper = 0;
 
 	delete ms_combinationsOccluded;
 	ms_combinationsOccluded = 0;
 
-	delete ms_perShaderDataScratchpad;
-	ms_perShaderDataScratchpad = 0;
-
 	const bool success = MeshGeneratorTemplateList::deregisterMeshGeneratorTemplate(TAG_SKMG);
 	DEBUG_FATAL(!success, ("failed to deregister SkeletalMeshGeneratorTemplate class"));
 	UNREF(success);
@@ -2205,11 +2193,6 @@ void SkeletalMeshGeneratorTemplate::load(Iff &iff)
 		}
 	}
 
-	// Ensure the dot3 vector buffer used during blending is large enough.
-	if (m_dot3Vectors)
-		if (m_blendTargets && !m_blendTargets->empty())
-			ms_blendedDot3Vectors->reserve(m_dot3Vectors->size());
-
 	//-- If asynchronous loading is enabled, we definitely want to load
 	//   shader template and texture renderer template assets now.
 	//   To generate async data (with async loading disabled) we need to
@@ -2269,10 +2252,6 @@ void SkeletalMeshGeneratorTemplate::load_0002(Iff &iff)
 
 		iff.exitChunk(TAG_INFO);
 
-		//-- make sure our PerShaderData scratchpad array has enough space
-		NOT_NULL(ms_perShaderDataScratchpad);
-		ms_perShaderDataScratchpad->reserve(static_cast<size_t>(perShaderDataCount));
-
 		//-- load skeleton template names required on the skeleton to which this mesh is bound
 		iff.enterChunk(TAG_SKTM);
 		{
@@ -2562,10 +2541,6 @@ void SkeletalMeshGeneratorTemplate::load_0003(Iff &iff)
 
 		iff.exitChunk(TAG_INFO);
 
-		//-- make sure our PerShaderData scratchpad array has enough space
-		NOT_NULL(ms_perShaderDataScratchpad);
-		ms_perShaderDataScratchpad->reserve(static_cast<size_t>(perShaderDataCount));
-
 		//-- load skeleton template names required on the skeleton to which this mesh is bound
 		iff.enterChunk(TAG_SKTM);
 		{
@@ -2898,10 +2873,6 @@ void SkeletalMeshGeneratorTemplate::load_0004(Iff &iff)
 
 		iff.exitChunk(TAG_INFO);
 
-		//-- make sure our PerShaderData scratchpad array has enough space
-		NOT_NULL(ms_perShaderDataScratchpad);
-		ms_perShaderDataScratchpad->reserve(static_cast<size_t>(perShaderDataCount));
-
 		//-- load skeleton template names required on the skeleton to which this mesh is bound
 		iff.enterChunk(TAG_SKTM);
 		{
@@ -3423,12 +3394,37 @@ void SkeletalMeshGeneratorTemplate::addShaderPrimitives(
 {
 	//-- -TRF- handle adding static mesh data here
 
+	//-- resolve the transforms and occluded zone combinations the mesh data depends on
+	if (!prepareMeshConstruction(transformNameMap, zonesCurrentlyOccluded, zonesOccludedByThisLayer))
+		return;
+
+	//-- share mesh data with every other appearance that resolved to the same inputs
+	if (MeshConstructionCache::isEnabled())
+	{
+		const MeshConstructionHelper *const meshConstructionHelper = MeshConstructionCache::fetchMesh(*this, blendValues, ms_localToOutputTransformIndices, *ms_combinationsOccluded);
+
+		// A NULL mesh is being built by a worker thread.  The appearance notices and keeps this detail level dirty.
+		if (meshConstructionHelper)
+			createShaderPrimitives(appearance, lodIndex, customizationData, *meshConstructionHelper, shaderPrimitives);
+
+		return;
+	}
+
 	//-- fill mesh construction helper with dynamic data
-	fillMeshConstructionHelper(*ms_meshConstructionHelper, blendValues, transformNameMap, zonesCurrentlyOccluded, zonesOccludedByThisLayer);
+	buildMeshConstructionHelper(*ms_meshConstructionHelper, blendValues, ms_localToOutputTransformIndices, *ms_combinationsOccluded);
 
 	//-- generate the shader primitives
 	ms_meshConstructionHelper->prepareForReading();
+	createShaderPrimitives(appearance, lodIndex, customizationData, *ms_meshConstructionHelper, shaderPrimitives);
+
+	//-- Clean up MeshConstructionHelper for next caller usage.
+	ms_meshConstructionHelper->clearAllData();
+}
+
+// ----------------------------------------------------------------------
 
+void SkeletalMeshGeneratorTemplate::createShaderPrimitives(Appearance &appearance, int lodIndex, CustomizationData *customizationData, const MeshConstructionHelper &meshConstructionHelper, ShaderPrimitiveVector &shaderPrimitives) const
+{
 	const size_t shaderPrimitiveBaseIndex = shaderPrimitives.size();
 
 	{
@@ -3436,11 +3432,11 @@ void SkeletalMeshGeneratorTemplate::addShaderPrimitives(
 		SkeletalAppearance2 *skeletalAppearance = appearance.asSkeletalAppearance2();
 		NOT_NULL(skeletalAppearance);
 
-		const int shaderCount = ms_meshConstructionHelper->getShaderCount();
+		const int shaderCount = meshConstructionHelper.getShaderCount();
 		for (int i = 0; i < shaderCount; ++i)
 		{
 			//-- create the shader primitive
-			ShaderPrimitive *const newShaderPrimitive = new SoftwareBlendSkeletalShaderPrimitive(*skeletalAppearance, lodIndex, *ms_meshConstructionHelper, i);
+			ShaderPrimitive *const newShaderPrimitive = new SoftwareBlendSkeletalShaderPrimitive(*skeletalAppearance, lodIndex, meshConstructionHelper, i);
 
 			//-- set its customization data
 			newShaderPrimitive->setCustomizationData(customizationData);
@@ -3452,12 +3448,12 @@ void SkeletalMeshGeneratorTemplate::addShaderPrimitives(
 
 	//-- properly handle texture renderers
 	{
-		const int textureRendererCount = ms_meshConstructionHelper->getTextureRendererCount();
+		const int textureRendererCount = meshConstructionHelper.getTextureRendererCount();
 		for (int i = 0; i < textureRendererCount; ++i)
 		{
 			//-- get the TextureRendererTemplate
-			const MeshConstructionHelper::PerTextureRendererData *ptrd = ms_meshConstructionHelper->getPerTextureRendererData(i);
-			const TextureRendererTemplate *textureRendererTemplate = TextureRendererList::fetch(ms_meshConstructionHelper->getTextureRendererTemplateName(ptrd));
+			const MeshConstructionHelper::PerTextureRendererData *ptrd = meshConstructionHelper.getPerTextureRendererData(i);
+			const TextureRendererTemplate *textureRendererTemplate = TextureRendererList::fetch(meshConstructionHelper.getTextureRendererTemplateName(ptrd));
 
 			if (!textureRendererTemplate)
 			{
@@ -3466,7 +3462,7 @@ void SkeletalMeshGeneratorTemplate::addShaderPrimitives(
 			}
 
 			//-- create a new texture renderer and assign its texture for each shader to which the TR template is applied
-			const int affectedShaderCount = ms_meshConstructionHelper->getAffectedShaderCount(ptrd);
+			const int affectedShaderCount = meshConstructionHelper.getAffectedShaderCount(ptrd);
 
 			for (int affectedShaderIndex = 0; affectedShaderIndex < affectedShaderCount; ++affectedShaderIndex)
 			{
@@ -3474,8 +3470,8 @@ void SkeletalMeshGeneratorTemplate::addShaderPrimitives(
 				int  shaderIndex      = -1;
 				Tag  shaderTextureTag = TAG(N,O,N,E);
 
-				ms_meshConstructionHelper->getAffectedShaderData(ptrd, affectedShaderIndex, &shaderIndex, &shaderTextureTag);
-				VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, shaderIndex, ms_meshConstructionHelper->getShaderCount());
+				meshConstructionHelper.getAffectedShaderData(ptrd, affectedShaderIndex, &shaderIndex, &shaderTextureTag);
+				VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, shaderIndex, meshConstructionHelper.getShaderCount());
 
 				//-- piggy-back the TextureRendererShaderPrimitive if it doesn't already exist
 				const size_t  shaderPrimitiveIndex = shaderPrimitiveBaseIndex + static_cast<size_t>(shaderIndex);
@@ -3554,9 +3550,6 @@ void SkeletalMeshGeneratorTemplate::addShaderPrimitives(
 			textureRendererTemplate->release();
 		}
 	}
-
-	//-- Clean up MeshConstructionHelper for next caller usage.
-	ms_meshConstructionHelper->clearAllData();
 }
 
 // ----------------------------------------------------------------------
@@ -3694,9 +3687,20 @@ void SkeletalMeshGeneratorTemplate::fillIndexedTriangleList(IndexedTriangleList
 
 // ----------------------------------------------------------------------
 
-void SkeletalMeshGeneratorTemplate::fillMeshConstructionHelper(
-	MeshConstructionHelper &meshConstructionHelper,
-	const IntVector        *blendValues,
+/**
+ * Resolve the inputs of buildMeshConstructionHelper() that depend on the
+ * appearance wearing this mesh.
+ *
+ * Fills ms_localToOutputTransformIndices with the skeleton transform index
+ * of each transform referenced by this mesh and ms_combinationsOccluded with
+ * the occlusion zone combinations hidden by the layers above this one, then
+ * adds the zones this mesh occludes to zonesOccludedByThisLayer.
+ *
+ * @return  false if the mesh is fully occluded or cannot be bound to the
+ *          skeleton, in which case it contributes nothing.
+ */
+
+bool SkeletalMeshGeneratorTemplate::prepareMeshConstruction(
 	const TransformNameMap &transformNameMap,
 	const OcclusionZoneSet &zonesCurrentlyOccluded,
 	OcclusionZoneSet       &zonesOccludedByThisLayer
@@ -3722,7 +3726,7 @@ void SkeletalMeshGeneratorTemplate::fillMeshConstructionHelper(
 		// Bump up count for this frame.
 		++thisCallCount;
 
-		DEBUG_REPORT_LOG(true, ("fillMeshConstructionHelper: template [%s] frame [%d] call #[%d].\n", getName().getString(), currentFrameNumber, thisCallCount));
+		DEBUG_REPORT_LOG(true, ("prepareMeshConstruction: template [%s] frame [%d] call #[%d].\n", getName().getString(), currentFrameNumber, thisCallCount));
 	}
 #endif
 
@@ -3733,7 +3737,7 @@ void SkeletalMeshGeneratorTemplate::fillMeshConstructionHelper(
 		{
 			//-- fully occluded.
 			// -TRF- might want to add all of the zones this mesh occludes to zonesThisOccludes; however, that should be redundant.
-			return;
+			return false;
 		}
 	}
 
@@ -3755,6 +3759,8 @@ void SkeletalMeshGeneratorTemplate::fillMeshConstructionHelper(
 		// lookup transform names
 		int i = 0;
 
+		ms_localToOutputTransformIndices.resize(m_transformNames.size());
+
 		const CrcLowerStringVector::const_iterator itEnd = m_transformNames.end();
 		for (CrcLowerStringVector::const_iterator it = m_transformNames.begin(); it != itEnd; ++it, ++i)
 		{
@@ -3767,13 +3773,48 @@ void SkeletalMeshGeneratorTemplate::fillMeshConstructionHelper(
 				//-- yikes, didn't find a transform referenced by this mesh.  there's no way we can draw this properly,
 				//   so drop the mesh.
 				DEBUG_WARNING(true, ("skeletal mesh [%s] references non-existent joint [%s] -- is a required skeleton segment missing?", getName().getString(), (*it).getString()));
-				return;
+				return false;
 			}
 
 			ms_localToOutputTransformIndices[static_cast<size_t>(i)] = transformIndex;
 		}
 	}
 
+	//-- specify zones this mesh occludes
+	{
+		const IntVector::const_iterator itEnd = m_zonesThisOccludes.end();
+		for (IntVector::const_iterator it = m_zonesThisOccludes.begin(); it != itEnd; ++it)
+			zonesOccludedByThisLayer.addZone(*it);
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Fill a MeshConstructionHelper with this mesh's geometry, morphed by the
+ * given blend values.
+ *
+ * Everything this depends on is passed in and all scratch data lives on the
+ * stack, so it may run on any thread, concurrently with other builds, as
+ * long as the template stays loaded.
+ *
+ * @param localToOutputTransformIndices  the output transform index of each transform
+ *                                       referenced by this mesh.
+ * @param combinationsOccluded           one flag per occlusion zone combination;
+ *                                       true if that combination is hidden.
+ */
+
+void SkeletalMeshGeneratorTemplate::buildMeshConstructionHelper(
+	MeshConstructionHelper &meshConstructionHelper,
+	const IntVector        *blendValues,
+	const IntVector        &localToOutputTransformIndices,
+	const BoolVector       &combinationsOccluded
+	) const
+{
+	DEBUG_FATAL(localToOutputTransformIndices.size() < m_transformNames.size(), ("skeletal mesh [%s] needs [%d] transform indices, got [%d].", getName().getString(), static_cast<int>(m_transformNames.size()), static_cast<int>(localToOutputTransformIndices.size())));
+	DEBUG_FATAL(combinationsOccluded.size() != m_occlusionZoneCombinations.size(), ("skeletal mesh [%s] has [%d] occlusion zone combinations, got [%d].", getName().getString(), static_cast<int>(m_occlusionZoneCombinations.size()), static_cast<int>(combinationsOccluded.size())));
+
 	//-- add position vectors
 	const size_t  positionCount = m_positions.size();
 
@@ -3811,7 +3852,7 @@ void SkeletalMeshGeneratorTemplate::fillMeshConstructionHelper(
 			for (int j = 0; j < transformWeightCount; ++j)
 			{
 				const TransformWeightData &twd = m_transformWeightData[static_cast<size_t>(currentTransformWeightIndex + j)];
-				meshConstructionHelper.addPositionWeight(firstPositionIndex + i, ms_localToOutputTransformIndices[static_cast<size_t>(twd.m_transformIndex)], twd.m_transformWeight);
+				meshConstructionHelper.addPositionWeight(firstPositionIndex + i, localToOutputTransformIndices[static_cast<size_t>(twd.m_transformIndex)], twd.m_transformWeight);
 			}
 
 			currentTransformWeightIndex += transformWeightCount;
@@ -3864,15 +3905,17 @@ void SkeletalMeshGeneratorTemplate::fillMeshConstructionHelper(
 	}
 
 	//-- Prepare the dot3 vectors used by this mesh.
-	const Dot3VectorVector *const preparedDot3Vectors = (m_dot3Vectors ? prepareDot3Vectors(blendValues) : 0);
+	Dot3VectorVector              blendedDot3Vectors;
+	const Dot3VectorVector *const preparedDot3Vectors = (m_dot3Vectors ? prepareDot3Vectors(blendValues, blendedDot3Vectors) : 0);
 
 	//-- add per shader data
+	MCHPSDContainer  outputPerShaderData(m_perShaderData.size(), static_cast<MeshConstructionHelper::PerShaderData*>(0));
 	{
 		int i = 0;
 
 		const PerShaderDataVector::const_iterator itEnd = m_perShaderData.end();
 		for (PerShaderDataVector::const_iterator it = m_perShaderData.begin(); it != itEnd; ++it, ++i)
-			(*it)->addPerShaderData(meshConstructionHelper, firstPositionIndex, firstNormalIndex, preparedDot3Vectors, *ms_combinationsOccluded, (*ms_perShaderDataScratchpad)[static_cast<size_t>(i)]);
+			(*it)->addPerShaderData(meshConstructionHelper, firstPositionIndex, firstNormalIndex, preparedDot3Vectors, combinationsOccluded, outputPerShaderData[static_cast<size_t>(i)]);
 	}
 
 	//-- add texture renderer info
@@ -3892,23 +3935,17 @@ void SkeletalMeshGeneratorTemplate::fillMeshConstructionHelper(
 				VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, entryIndex, static_cast<int>(m_textureRendererEntries->size()));
 				const TextureRendererEntry &entry = (*m_textureRendererEntries)[static_cast<size_t>(entryIndex)];
 
-				MeshConstructionHelper::PerShaderData *const outputPsd = (*ms_perShaderDataScratchpad)[static_cast<size_t>(entry.m_shaderIndex)];
+				VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, entry.m_shaderIndex, static_cast<int>(outputPerShaderData.size()));
+				MeshConstructionHelper::PerShaderData *const outputPsd = outputPerShaderData[static_cast<size_t>(entry.m_shaderIndex)];
 				meshConstructionHelper.addAffectedShaderTemplate(ptrd, entry.m_shaderTextureTag, outputPsd);
 			}
 		}
 	}
-
-	//-- specify zones this mesh occludes
-	{
-		const IntVector::const_iterator itEnd = m_zonesThisOccludes.end();
-		for (IntVector::const_iterator it = m_zonesThisOccludes.begin(); it != itEnd; ++it)
-			zonesOccludedByThisLayer.addZone(*it);
-	}
 }
 
 // ----------------------------------------------------------------------
 
-const SkeletalMeshGeneratorTemplate::Dot3VectorVector *SkeletalMeshGeneratorTemplate::prepareDot3Vectors(const IntVector *blendValues) const
+const SkeletalMeshGeneratorTemplate::Dot3VectorVector *SkeletalMeshGeneratorTemplate::prepareDot3Vectors(const IntVector *blendValues, Dot3VectorVector &blendedDot3Vectors) const
 {
 	if (!m_dot3Vectors)
 		return 0;
@@ -3922,8 +3959,7 @@ const SkeletalMeshGeneratorTemplate::Dot3VectorVector *SkeletalMeshGeneratorTemp
 	//-- Apply blend target morphing to the dot3 vectors.
 
 	// Initialize dot3 vectors with pristine values.
-	ms_blendedDot3Vectors->clear();
-	*ms_blendedDot3Vectors = *m_dot3Vectors;
+	blendedDot3Vectors = *m_dot3Vectors;
 
 	int blendTargetIndex = 0;
 	int appliedDot3Count = 0;
@@ -3938,7 +3974,7 @@ const SkeletalMeshGeneratorTemplate::Dot3VectorVector *SkeletalMeshGeneratorTemp
 
 			if ((weight > ms_applyWeightThreshold) || (weight < -ms_applyWeightThreshold))
 			{
-				(*it)->applyDot3VectorDeformation(weight, *ms_blendedDot3Vectors);
+				(*it)->applyDot3VectorDeformation(weight, blendedDot3Vectors);
 				++appliedDot3Count;
 			}
 		}
@@ -3948,12 +3984,12 @@ const SkeletalMeshGeneratorTemplate::Dot3VectorVector *SkeletalMeshGeneratorTemp
 	//-- normalize normals if we applied any deformation
 	if (appliedDot3Count)
 	{
-		const Dot3VectorVector::iterator endIt = ms_blendedDot3Vectors->end();
-		for (Dot3VectorVector::iterator it = ms_blendedDot3Vectors->begin(); it != endIt; ++it)
+		const Dot3VectorVector::iterator endIt = blendedDot3Vectors.end();
+		for (Dot3VectorVector::iterator it = blendedDot3Vectors.begin(); it != endIt; ++it)
 			IGNORE_RETURN(it->m_dot3Vector.normalize());
 	}
 
-	return ms_blendedDot3Vectors;
+	return &blendedDot3Vectors;
 }
 
 // ----------------------------------------------------------------------
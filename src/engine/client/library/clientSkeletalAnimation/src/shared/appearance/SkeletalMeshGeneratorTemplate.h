@@ -50,6 +50,7 @@ public:
 	struct BlendVector;
 	class  PerShaderData;
 
+	typedef stdvector<bool>::fwd               BoolVector;
 	typedef stdvector<int>::fwd                IntVector;
 	typedef stdvector<ShaderPrimitive *>::fwd  ShaderPrimitiveVector;
 
@@ -74,6 +75,7 @@ public:
 	int                            getOcclusionLayer() const;
 	void                           applySkeletonModifications(const IntVector *blendValues, Skeleton &skeleton) const;
 	void                           addShaderPrimitives(Appearance &appearance, int lodIndex, CustomizationData *customizationData, const IntVector *blendValues, const TransformNameMap &transformNameMap, const OcclusionZoneSet &zonesCurrentlyOccluded, OcclusionZoneSet &zonesOccludedByThisLayer, ShaderPrimitiveVector &shaderPrimitives) const;
+	void                           buildMeshConstructionHelper(MeshConstructionHelper &meshConstructionHelper, const IntVector *blendValues, const IntVector &localToOutputTransformIndices, const BoolVector &combinationsOccluded) const;
 
 	Appearance                    *createAppearance() const;
 
@@ -138,8 +140,9 @@ private:
 
 	void asynchronousLoadCallback();
 
-	void fillMeshConstructionHelper(MeshConstructionHelper &meshConstructionHelper, const IntVector *blendValues, const TransformNameMap &transformNameMap, const OcclusionZoneSet &zonesCurrentlyOccluded, OcclusionZoneSet &zonesOccludedByThisLayer) const;
-	const Dot3VectorVector *prepareDot3Vectors(const IntVector *blendValues) const;
+	bool prepareMeshConstruction(const TransformNameMap &transformNameMap, const OcclusionZoneSet &zonesCurrentlyOccluded, OcclusionZoneSet &zonesOccludedByThisLayer) const;
+	const Dot3VectorVector *prepareDot3Vectors(const IntVector *blendValues, Dot3VectorVector &blendedDot3Vectors) const;
+	void createShaderPrimitives(Appearance &appearance, int lodIndex, CustomizationData *customizationData, const MeshConstructionHelper &meshConstructionHelper, ShaderPrimitiveVector &shaderPrimitives) const;
 
 	void removeAsynchronouslyLoadedMeshGenerator(SkeletalMeshGenerator *meshGenerator) const;
 
@@ -159,8 +162,6 @@ private:
 	static VectorVector                      ms_dynamicHardpointPositions;
 	static QuaternionVector                  ms_dynamicHardpointRotations;
 
-	static Dot3VectorVector                 *ms_blendedDot3Vectors;
-
 private:
 
 	bool                         m_isLoaded;
@@ -15,6 +15,8 @@
 #include "clientGraphics/ShaderTemplateList.h"
 #include "clientGraphics/StaticShader.h"
 #include "clientSkeletalAnimation/BasicSkeletonTemplate.h"
+#include "clientSkeletalAnimation/ConfigClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/FlatSkeletonHierarchy.h"
 #include "clientSkeletalAnimation/SkeletalAppearance2.h"
 #include "clientSkeletalAnimation/SkeletalAppearanceTemplate.h"
 #include "clientSkeletalAnimation/SkeletonTransformNameMap.h"
@@ -23,6 +25,7 @@
 #include "clientSkeletalAnimation/PoseModelTransform.h"
 #include "sharedCollision/BoxExtent.h"
 #include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/PerformanceTimer.h"
 #include "sharedDebug/Profiler.h"
 #include "sharedFoundation/PersistentCrcString.h"
 #include "sharedFoundation/ExitChain.h"
@@ -52,13 +55,39 @@ namespace SkeletonNamespace
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+	/// Reused by every rebuild so the chains and their strings keep their storage.
+	AttachmentChainVector  s_attachmentChains;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#if PRODUCTION == 0
+	struct HierarchyBenchmarkRecord
+	{
+		int   segmentCount;
+		int   transformCount;
+		int   evaluationCount;
+		float segmentedTime;
+		float flatTime;
+		float maximumError;
+	};
+
+	typedef std::map<std::string, HierarchyBenchmarkRecord>  HierarchyBenchmarkRecordMap;
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 #if PRODUCTION == 0
 	void  reportStatistics();
+
+	float computeMaximumError(Transform const *reference, Transform const *result, int transformCount);
+	void  reportHierarchyBenchmark();
+	void  resetHierarchyBenchmark();
 #endif
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	bool  s_installed;
+	bool  s_useSegmentedHierarchy;
 
 #if PRODUCTION == 0
 	bool  s_reportStatistics;
@@ -66,11 +95,19 @@ namespace SkeletonNamespace
 	int   s_calculateJointToRootTransformsCallCount;
 	int   s_calculateBindPoseModelToRootTransformsCallCount;
 	int   s_calculateExtentCallCount;
+	int   s_calculateHardpointToRootTransformsCallCount;
 
 	int   s_calculateJointToRootTransformsEvalCount;
 	int   s_calculateBindPoseModelToRootTransformsEvalCount;
 	int   s_calculateExtentEvalCount;
-
+	int   s_calculateHardpointToRootTransformsEvalCount;
+
+	bool                         s_benchmarkHierarchy;
+	bool                         s_reportHierarchyBenchmark;
+	bool                         s_resetHierarchyBenchmark;
+	HierarchyBenchmarkRecordMap  s_hierarchyBenchmarkRecords;
+	std::vector<Transform>       s_segmentedBenchmarkTransforms;
+	std::vector<Transform>       s_flatBenchmarkTransforms;
 #endif
 
 }
@@ -84,19 +121,76 @@ using namespace SkeletonNamespace;
 void SkeletonNamespace::reportStatistics()
 {
 	//-- Report.
-	REPORT_PRINT(true, ("Skeleton:(called/evaluated): extent=[%d/%d],jointToRoot=[%d/%d],bindPoseModelToRoot=[%d/%d]\n", 
+	REPORT_PRINT(true, ("Skeleton:(called/evaluated): extent=[%d/%d],jointToRoot=[%d/%d],bindPoseModelToRoot=[%d/%d],hardpointToRoot=[%d/%d]\n", 
 		s_calculateExtentCallCount, s_calculateExtentEvalCount, 
 		s_calculateJointToRootTransformsCallCount, s_calculateJointToRootTransformsEvalCount, 
-		s_calculateBindPoseModelToRootTransformsCallCount, s_calculateBindPoseModelToRootTransformsEvalCount));
+		s_calculateBindPoseModelToRootTransformsCallCount, s_calculateBindPoseModelToRootTransformsEvalCount,
+		s_calculateHardpointToRootTransformsCallCount, s_calculateHardpointToRootTransformsEvalCount));
+
+	//-- Hardpoints resolved per evaluated skeleton, the per-character cost of the hardpoint phase.
+	if (s_calculateJointToRootTransformsEvalCount > 0)
+		REPORT_PRINT(true, ("Skeleton: hardpoints resolved per skeleton=[%.2f]\n", static_cast<float>(s_calculateHardpointToRootTransformsEvalCount) / static_cast<float>(s_calculateJointToRootTransformsEvalCount)));
 
 	//-- Print.
 	s_calculateExtentCallCount                        = 0;
 	s_calculateJointToRootTransformsCallCount         = 0;
 	s_calculateBindPoseModelToRootTransformsCallCount = 0;
+	s_calculateHardpointToRootTransformsCallCount     = 0;
 
 	s_calculateExtentEvalCount                        = 0;
 	s_calculateJointToRootTransformsEvalCount         = 0;
 	s_calculateBindPoseModelToRootTransformsEvalCount = 0;
+	s_calculateHardpointToRootTransformsEvalCount     = 0;
+}
+
+// ----------------------------------------------------------------------
+
+float SkeletonNamespace::computeMaximumError(Transform const *reference, Transform const *result, int transformCount)
+{
+	float maximumError = 0.0f;
+
+	for (int i = 0; i < transformCount; ++i)
+	{
+		Transform::matrix_t const &a = reference[i].getMatrix();
+		Transform::matrix_t const &b = result[i].getMatrix();
+
+		for (int row = 0; row < 3; ++row)
+			for (int column = 0; column < 4; ++column)
+				maximumError = std::max(maximumError, fabsf(a[row][column] - b[row][column]));
+	}
+
+	return maximumError;
+}
+
+// ----------------------------------------------------------------------
+
+void SkeletonNamespace::reportHierarchyBenchmark()
+{
+	DEBUG_REPORT_PRINT(true, ("-- skeleton hierarchy: using %s walk, simd %s\n", s_useSegmentedHierarchy ? "segmented" : "flat", FlatSkeletonHierarchy::getUseSimd() ? "on" : "off"));
+
+	HierarchyBenchmarkRecordMap::const_iterator const itEnd = s_hierarchyBenchmarkRecords.end();
+	for (HierarchyBenchmarkRecordMap::const_iterator it = s_hierarchyBenchmarkRecords.begin(); it != itEnd; ++it)
+	{
+		HierarchyBenchmarkRecord const &record = it->second;
+		if (record.evaluationCount <= 0)
+			continue;
+
+		float const segmentedMicroseconds = record.segmentedTime * 1000000.0f / static_cast<float>(record.evaluationCount);
+		float const flatMicroseconds      = record.flatTime * 1000000.0f / static_cast<float>(record.evaluationCount);
+		float const speedup               = (flatMicroseconds > 0.0f) ? segmentedMicroseconds / flatMicroseconds : 0.0f;
+
+		DEBUG_REPORT_PRINT(true, ("  %-48s %d segments %3d transforms: segmented %7.2f us, flat %7.2f us (%4.2fx), max error %g\n", it->first.c_str(), record.segmentCount, record.transformCount, segmentedMicroseconds, flatMicroseconds, speedup, record.maximumError));
+	}
+}
+
+// ----------------------------------------------------------------------
+
+void SkeletonNamespace::resetHierarchyBenchmark()
+{
+	//-- one shot
+	s_resetHierarchyBenchmark = false;
+
+	s_hierarchyBenchmarkRecords.clear();
 }
 
 #endif
@@ -184,7 +278,7 @@ public:
 	void                         addHardpoint(CrcString const &hardpointName, int localParentIndex, const Transform &hardpointToParent);
 	void                         removeAllHardpoints();
 
-	void                         calculateHardpointToRootTransforms(int firstSegmentTransformIndex, Transform *jointToRootTransforms) const;
+	void                         addHardpointsToFlatHierarchy(FlatSkeletonHierarchy &flatHierarchy) const;
 
 	void                         drawHardpointsNow(const Transform &skeletonToWorld, const Vector &scale, int firstSegmentTransformIndex, const Transform *jointToRootTransforms) const;
 
@@ -573,13 +667,13 @@ void Skeleton::Segment::removeAllHardpoints()
 
 // ----------------------------------------------------------------------
 
-void Skeleton::Segment::calculateHardpointToRootTransforms(int firstSegmentTransformIndex, Transform *jointToRootTransforms) const
+void Skeleton::Segment::addHardpointsToFlatHierarchy(FlatSkeletonHierarchy &flatHierarchy) const
 {
 	if (m_hardpoints)
 	{
-		const size_t baseHardpointIndex = static_cast<size_t>(firstSegmentTransformIndex + m_skeletonTemplate.getJointCount());
+		const int baseHardpointIndex = m_firstTransformIndex + m_skeletonTemplate.getJointCount();
 
-		size_t localHardpointIndex = 0;
+		int localHardpointIndex = 0;
 
 		const HardpointVector::const_iterator itEnd = m_hardpoints->end();
 		for (HardpointVector::const_iterator it = m_hardpoints->begin(); it != itEnd; ++it, ++localHardpointIndex)
@@ -587,10 +681,7 @@ void Skeleton::Segment::calculateHardpointToRootTransforms(int firstSegmentTrans
 			NOT_NULL(*it);
 			const Hardpoint &hardpoint = *(*it);
 
-			const Transform &parentToRoot = jointToRootTransforms[firstSegmentTransformIndex + hardpoint.getParentLocalTransformIndex()];
-			Transform &destTransform      = jointToRootTransforms[baseHardpointIndex + localHardpointIndex];
-
-			destTransform.multiply(parentToRoot, hardpoint.getLocalToParent());
+			flatHierarchy.setHardpoint(baseHardpointIndex + localHardpointIndex, m_firstTransformIndex + hardpoint.getParentLocalTransformIndex(), hardpoint.getLocalToParent());
 		}
 	}
 }
@@ -755,6 +846,17 @@ void Skeleton::install()
 	DebugFlags::registerFlag(s_reportStatistics, "ClientSkeletalAnimation/Skeleton", "reportStatistics", reportStatistics);
 #endif
 
+	s_useSegmentedHierarchy = ConfigClientSkeletalAnimation::getDisableFlatSkeletonHierarchy();
+	DebugFlags::registerFlag(s_useSegmentedHierarchy, "ClientSkeletalAnimation/Skeleton", "useSegmentedHierarchy");
+
+#if PRODUCTION == 0
+	DebugFlags::registerFlag(s_benchmarkHierarchy,       "ClientSkeletalAnimation/Skeleton", "benchmarkHierarchy");
+	DebugFlags::registerFlag(s_reportHierarchyBenchmark, "ClientSkeletalAnimation/Skeleton", "reportHierarchyBenchmark", reportHierarchyBenchmark);
+	DebugFlags::registerFlag(s_resetHierarchyBenchmark,  "ClientSkeletalAnimation/Skeleton", "resetHierarchyBenchmark", resetHierarchyBenchmark);
+#endif
+
+	FlatSkeletonHierarchy::install();
+
 	// Child classes go on exit chain.
 	Hardpoint::install();
 	Segment::install();
@@ -776,13 +878,16 @@ Skeleton::Skeleton(const BasicSkeletonTemplate &rootSkeletonTemplate, TransformA
 	m_frameLastJointToRootCalculate(-1),
 	m_frameLastBindPoseModelToRootCalculate(-1),
 	m_frameLastExtentCalculate(-1),
+	m_jointToRootEvaluationCount(0),
+	m_hardpointEvaluationStamps(new IntVector),
 	m_transformNameMap(0),
 	m_extent(new BoxExtent()),
 	m_modifyingSkeleton(false),
 	m_shaderPrimitive(0),
 	m_scaleTransform(new Transform),
 	m_scale(1.0f),
-	m_transformModifierMap(0)
+	m_transformModifierMap(0),
+	m_flatHierarchy(new FlatSkeletonHierarchy)
 {
 	//-- Setup the m_jointToRootTransform array.
 	allocateTransformArrays(m_transformCount);
@@ -808,7 +913,9 @@ Skeleton::Skeleton(const BasicSkeletonTemplate &rootSkeletonTemplate, TransformA
 
 Skeleton::~Skeleton()
 {
+	delete m_flatHierarchy;
 	delete m_transformModifierMap;
+	delete m_hardpointEvaluationStamps;
 
 	delete m_scaleTransform;
 	delete m_shaderPrimitive;
@@ -1148,11 +1255,13 @@ void Skeleton::rebuildLinkedSkeletonDefinition()
 	//       that implies that attached skeleton segments should be added after the
 	//       the skeleton segment to which they attach.
 
-	AttachmentChainVector attachmentChains;
-	attachmentChains.resize(m_skeletonSegments->size());
-
 	const size_t segmentCount = m_skeletonSegments->size();
 
+	//-- the chains keep their storage between rebuilds, so only the first few rebuilds allocate.
+	AttachmentChainVector &attachmentChains = s_attachmentChains;
+	if (attachmentChains.size() < segmentCount)
+		attachmentChains.resize(segmentCount);
+
 	int nextSegmentBaseTransformIndex = 0;
 	for (size_t segmentIndex = 0; segmentIndex < segmentCount; ++segmentIndex)
 	{
@@ -1192,6 +1301,7 @@ void Skeleton::rebuildLinkedSkeletonDefinition()
 		else
 		{
 			// segment is not attached to a parent skeleton
+			attachmentChains[segmentIndex].clear();
 			segment.setupBindPoseModelToJointTransforms(attachmentChains[segmentIndex], Transform::identity);
 		}
 
@@ -1211,6 +1321,59 @@ void Skeleton::rebuildLinkedSkeletonDefinition()
 		//-- Rebuild the segment's transform resolver joint index lookup
 		segment.buildTransformResolverJointIndexMap(m_animationResolver);
 	}
+
+	rebuildFlatHierarchy();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Compile the segments and their hardpoints into the flat hierarchy used
+ * to calculate the jointToRoot transforms.
+ *
+ * Global transform indices list each segment's joints then its hardpoints,
+ * and segments are stored after the segment they attach to, so every
+ * transform comes after its parent.
+ */
+
+void Skeleton::rebuildFlatHierarchy()
+{
+	NOT_NULL(m_flatHierarchy);
+
+	m_flatHierarchy->clear(m_transformCount);
+
+	const SegmentVector::const_iterator itEnd = m_skeletonSegments->end();
+	for (SegmentVector::const_iterator it = m_skeletonSegments->begin(); it != itEnd; ++it)
+	{
+		const Segment &segment = *NON_NULL(*it);
+
+		const std::vector<int>      &jointIndexMap       = segment.getTransformResolverJointIndexMap();
+		const BasicSkeletonTemplate &skeletonTemplate    = segment.getSkeletonTemplate();
+		const int                    jointCount          = skeletonTemplate.getJointCount();
+		const int                    firstTransformIndex = segment.getFirstTransformIndex();
+
+		const int        *localParentIndexArray  = NON_NULL(skeletonTemplate.getJointParentIndexArray());
+		const Quaternion *preMultiplyRotations   = NON_NULL(skeletonTemplate.getPreMultiplyRotations());
+		const Quaternion *postMultiplyRotations  = NON_NULL(skeletonTemplate.getPostMultiplyRotations());
+
+		const Vector     *bindPoseTranslations   = NON_NULL(skeletonTemplate.getBindPoseTranslations());
+		const Quaternion *bindPoseRotations      = NON_NULL(skeletonTemplate.getBindPoseRotations());
+
+		for (int localJointIndex = 0; localJointIndex < jointCount; ++localJointIndex)
+		{
+			//-- the root joint of a segment links to the joint of the parent segment it attaches to.
+			const int localParentIndex = localParentIndexArray[localJointIndex];
+			const int parentIndex      = (localParentIndex < 0) ? segment.getParentGlobalTransformIndex() : firstTransformIndex + localParentIndex;
+
+			const int animationResolverTransformIndex = jointIndexMap[static_cast<std::vector<int>::size_type>(localJointIndex)];
+			DEBUG_WARNING(animationResolverTransformIndex < 0, ("animation resolver has no entry for appearance [%s],joint [%s], skeleton transform count [%d].", m_animationResolver.getSkeletalAppearanceTemplate().getName(), segment.getTransformName(localJointIndex).getString(), m_transformCount));
+
+			m_flatHierarchy->setJoint(firstTransformIndex + localJointIndex, parentIndex, animationResolverTransformIndex, bindPoseRotations[localJointIndex], bindPoseTranslations[localJointIndex], preMultiplyRotations[localJointIndex], postMultiplyRotations[localJointIndex]);
+		}
+
+		segment.addHardpointsToFlatHierarchy(*m_flatHierarchy);
+	}
+
+	m_flatHierarchy->finish();
 }
 
 // ----------------------------------------------------------------------
@@ -1353,6 +1516,37 @@ void Skeleton::calculateJointToRootTransforms() const
 	++s_calculateJointToRootTransformsEvalCount;
 #endif
 
+	if (s_useSegmentedHierarchy)
+		calculateJointToRootTransformsSegmented(m_jointToRootTransforms, true);
+	else
+		calculateJointToRootTransformsFlat(m_jointToRootTransforms, true);
+
+#if PRODUCTION == 0
+	if (s_benchmarkHierarchy)
+		benchmarkJointToRootTransforms();
+#endif
+
+	//-- remember that we calculated this for this frame.  This also invalidates every resolved hardpoint.
+	m_frameLastJointToRootCalculate = frameNumber;
+	++m_jointToRootEvaluationCount;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Calculate the jointToRoot transforms by walking the skeleton segment by
+ * segment.
+ *
+ * This is the reference for the flat hierarchy.  It is used when the flat
+ * hierarchy is disabled and by the hierarchy benchmark.
+ *
+ * Like the flat walk, this skips hardpoints; they are resolved on demand by
+ * calculateHardpointToRootTransform().
+ */
+
+void Skeleton::calculateJointToRootTransformsSegmented(Transform *jointToRootTransforms, bool applyTransformModifiers) const
+{
+	NOT_NULL(jointToRootTransforms);
+
 	//-- Get alter's elapsed time.  Needed for transform modifiers.
 	float const elapsedTime = getAnimationResolver().getMostRecentAlterElapsedTime();
 
@@ -1384,7 +1578,7 @@ void Skeleton::calculateJointToRootTransforms() const
 		TransformModifierMap::iterator  modifierIt;
 		TransformModifierMap::iterator *modifierItPtr;
 
-		if (m_transformModifierMap && !m_transformModifierMap->empty())
+		if (applyTransformModifiers && m_transformModifierMap && !m_transformModifierMap->empty())
 		{
 			modifierEndIt = m_transformModifierMap->end();
 			modifierIt    = m_transformModifierMap->begin();
@@ -1431,7 +1625,7 @@ void Skeleton::calculateJointToRootTransforms() const
 
 			//-- build jointToRoot through parentToRoot * jointToParent
 			// get dest transform location
-			Transform &destTransform = m_jointToRootTransforms[globalTransformIndex];
+			Transform &destTransform = jointToRootTransforms[globalTransformIndex];
 
 			// get parent transform index
 			const int localParentIndex = localParentIndexArray[localJointIndex];
@@ -1450,14 +1644,14 @@ void Skeleton::calculateJointToRootTransforms() const
 				else
 				{
 					// link root of this skeleton segment to joint of parent skeleton
-					parentToRootTransform = &(m_jointToRootTransforms[segment->getParentGlobalTransformIndex()]);
+					parentToRootTransform = &(jointToRootTransforms[segment->getParentGlobalTransformIndex()]);
 				}
 			}
 			else
 			{
 				// this is a typical non-root joint for the skeleton template
 				size_t const parentTransformIndex  = static_cast<size_t>(segment->getFirstTransformIndex() + localParentIndex);
-				parentToRootTransform = &(m_jointToRootTransforms[parentTransformIndex]);
+				parentToRootTransform = &(jointToRootTransforms[parentTransformIndex]);
 			}
 
 			// build the joint to root (i.e. joint to object) transform.
@@ -1484,13 +1678,181 @@ void Skeleton::calculateJointToRootTransforms() const
 				}
 			}
 		}
+	}
+}
 
-		//-- handle segment hardpoints
-		segment->calculateHardpointToRootTransforms(segment->getFirstTransformIndex(), m_jointToRootTransforms);
+// ----------------------------------------------------------------------
+/**
+ * Calculate the jointToRoot transforms with the flat hierarchy compiled by
+ * rebuildFlatHierarchy().
+ *
+ * The hierarchy is composed in runs that end at transforms with modifiers
+ * so each modifier sees its parent's final jointToRoot transform, as it
+ * does in the segmented walk.
+ */
+
+void Skeleton::calculateJointToRootTransformsFlat(Transform *jointToRootTransforms, bool applyTransformModifiers) const
+{
+	NOT_NULL(jointToRootTransforms);
+	NOT_NULL(m_flatHierarchy);
+
+	FlatSkeletonHierarchy &flatHierarchy = *m_flatHierarchy;
+
+	flatHierarchy.calculateJointToParentTransforms(m_animationResolver);
+
+	int firstTransformIndex = 0;
+
+	if (applyTransformModifiers && m_transformModifierMap && !m_transformModifierMap->empty())
+	{
+		//-- Get alter's elapsed time.  Needed for transform modifiers.
+		float const elapsedTime = getAnimationResolver().getMostRecentAlterElapsedTime();
+
+		Transform jointToParentTransform(Transform::IF_none);
+
+		const TransformModifierMap::const_iterator itEnd = m_transformModifierMap->end();
+		for (TransformModifierMap::const_iterator it = m_transformModifierMap->begin(); it != itEnd; ++it)
+		{
+			//-- Modifiers only apply to animated joints.
+			const int transformIndex = it->first;
+			if ((transformIndex < 0) || (transformIndex >= m_transformCount) || !flatHierarchy.isJoint(transformIndex) || !flatHierarchy.isEvaluated(transformIndex))
+				continue;
+
+			//-- Compose up to and including the modified joint.  Several modifiers can share a joint.
+			if (transformIndex >= firstTransformIndex)
+			{
+				flatHierarchy.calculateJointToRootTransforms(*m_scaleTransform, firstTransformIndex, transformIndex + 1, jointToRootTransforms);
+				firstTransformIndex = transformIndex + 1;
+			}
+
+			const int        parentIndex           = flatHierarchy.getParentIndex(transformIndex);
+			Transform const &parentToRootTransform = (parentIndex < 0) ? *m_scaleTransform : jointToRootTransforms[parentIndex];
+
+			flatHierarchy.getJointToParentTransform(transformIndex, jointToParentTransform);
+
+			// Apply modifier.
+			TransformModifier *const modifier = it->second;
+			NOT_NULL(modifier);
+
+			bool const transformModified = modifier->modifyTransform(elapsedTime, *this, getTransformName(transformIndex), parentToRootTransform, jointToParentTransform, jointToRootTransforms[transformIndex]);
+			UNREF(transformModified);
+		}
 	}
 
-	//-- remember that we calculated this for this frame
-	m_frameLastJointToRootCalculate = frameNumber;
+	flatHierarchy.calculateJointToRootTransforms(*m_scaleTransform, firstTransformIndex, m_transformCount, jointToRootTransforms);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Resolve a hardpoint against this frame's jointToRoot transforms if it
+ * has not been resolved since they were last evaluated.
+ *
+ * The joints must already be calculated.  Hardpoints may hang off other
+ * hardpoints, so the parent is resolved first.
+ */
+
+void Skeleton::calculateHardpointToRootTransform(int transformIndex) const
+{
+	NOT_NULL(m_flatHierarchy);
+
+#if PRODUCTION == 0
+	++s_calculateHardpointToRootTransformsCallCount;
+#endif
+
+	int &evaluationStamp = (*m_hardpointEvaluationStamps)[static_cast<size_t>(transformIndex)];
+	if (evaluationStamp == m_jointToRootEvaluationCount)
+		return;
+
+	const int parentIndex = m_flatHierarchy->getParentIndex(transformIndex);
+	if (m_flatHierarchy->isHardpoint(parentIndex))
+		calculateHardpointToRootTransform(parentIndex);
+
+#if PRODUCTION == 0
+	++s_calculateHardpointToRootTransformsEvalCount;
+#endif
+
+	m_flatHierarchy->calculateHardpointToRootTransform(transformIndex, m_jointToRootTransforms);
+	evaluationStamp = m_jointToRootEvaluationCount;
+}
+
+// ----------------------------------------------------------------------
+
+void Skeleton::calculateAllHardpointToRootTransforms() const
+{
+	NOT_NULL(m_flatHierarchy);
+
+	NP_PROFILER_AUTO_BLOCK_DEFINE("Skeleton::calculateAllHardpointToRootTransforms");
+
+	for (int transformIndex = 0; transformIndex < m_transformCount; ++transformIndex)
+	{
+		if (m_flatHierarchy->isHardpoint(transformIndex))
+			calculateHardpointToRootTransform(transformIndex);
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Time the segmented and flat walks on this skeleton's current pose into
+ * scratch arrays and compare their results.
+ *
+ * Results are accumulated per root skeleton template and segment count, so
+ * humanoids, creatures and mounts with riders attached show up separately.
+ * Transform modifiers are not applied.
+ */
+
+void Skeleton::benchmarkJointToRootTransforms() const
+{
+#if PRODUCTION == 0
+	if (m_transformCount <= 0)
+		return;
+
+	size_t const transformCount = static_cast<size_t>(m_transformCount);
+	if (s_segmentedBenchmarkTransforms.size() < transformCount)
+	{
+		s_segmentedBenchmarkTransforms.resize(transformCount);
+		s_flatBenchmarkTransforms.resize(transformCount);
+	}
+
+	//-- Skipped joints keep their previous values, so start both from the same state.
+	std::copy(m_jointToRootTransforms, m_jointToRootTransforms + m_transformCount, s_segmentedBenchmarkTransforms.begin());
+	std::copy(m_jointToRootTransforms, m_jointToRootTransforms + m_transformCount, s_flatBenchmarkTransforms.begin());
+
+	PerformanceTimer segmentedTimer;
+	segmentedTimer.start();
+
+		calculateJointToRootTransformsSegmented(&s_segmentedBenchmarkTransforms[0], false);
+
+	segmentedTimer.stop();
+
+	PerformanceTimer flatTimer;
+	flatTimer.start();
+
+		calculateJointToRootTransformsFlat(&s_flatBenchmarkTransforms[0], false);
+
+	flatTimer.stop();
+
+	//-- Record.
+	Segment const &rootSegment = *NON_NULL(m_skeletonSegments->front());
+
+	char buffer[32];
+	sprintf(buffer, " (%d segments)", static_cast<int>(m_skeletonSegments->size()));
+	std::string const name = std::string(rootSegment.getSkeletonTemplate().getName().getString()) + buffer;
+
+	HierarchyBenchmarkRecordMap::iterator it = s_hierarchyBenchmarkRecords.find(name);
+	if (it == s_hierarchyBenchmarkRecords.end())
+	{
+		HierarchyBenchmarkRecord record;
+		memset(&record, 0, sizeof(record));
+		it = s_hierarchyBenchmarkRecords.insert(HierarchyBenchmarkRecordMap::value_type(name, record)).first;
+	}
+
+	HierarchyBenchmarkRecord &record = it->second;
+	record.segmentCount    = static_cast<int>(m_skeletonSegments->size());
+	record.transformCount  = m_transformCount;
+	record.evaluationCount += 1;
+	record.segmentedTime   += segmentedTimer.getElapsedTime();
+	record.flatTime        += flatTimer.getElapsedTime();
+	record.maximumError     = std::max(record.maximumError, computeMaximumError(&s_segmentedBenchmarkTransforms[0], &s_flatBenchmarkTransforms[0], m_transformCount));
+#endif
 }
 
 // ----------------------------------------------------------------------
@@ -1573,6 +1935,7 @@ void Skeleton::drawNow(const Transform &skeletonToWorld, const Vector &scale) co
 
 	//-- make sure we've computed our transforms this frame
 	calculateJointToRootTransforms();
+	calculateAllHardpointToRootTransforms();
 
 	//-- render the skeleton hierarchy
 	Transform  jointToWorldTransform(Transform::IF_none);
@@ -1675,6 +2038,14 @@ void Skeleton::drawNow(const Transform &skeletonToWorld, const Vector &scale) co
 
 // ----------------------------------------------------------------------
 
+/**
+ * Retrieve the jointToRoot transforms of every transform in the skeleton,
+ * hardpoints included.
+ *
+ * This resolves every hardpoint.  Callers interested in a few transforms,
+ * typically hardpoints found by name, should use getTransformToRoot().
+ */
+
 const Transform *Skeleton::getJointToRootTransformArray() const
 {
 	NOT_NULL(m_jointToRootTransforms);
@@ -1687,10 +2058,38 @@ const Transform *Skeleton::getJointToRootTransformArray() const
 
 	// this caches values for frame
 	calculateJointToRootTransforms();
+	calculateAllHardpointToRootTransforms();
 
 	return m_jointToRootTransforms;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Retrieve the jointToRoot transform of a single joint or hardpoint.
+ *
+ * A hardpoint is only resolved the first time it is queried after the
+ * joints are evaluated for the frame.
+ */
+
+const Transform &Skeleton::getTransformToRoot(int transformIndex) const
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, transformIndex, m_transformCount);
+	NOT_NULL(m_jointToRootTransforms);
+	NOT_NULL(m_flatHierarchy);
+
+#if PRODUCTION == 0
+	++s_calculateJointToRootTransformsCallCount;
+#endif
+
+	// this caches values for frame
+	calculateJointToRootTransforms();
+
+	if (m_flatHierarchy->isHardpoint(transformIndex))
+		calculateHardpointToRootTransform(transformIndex);
+
+	return m_jointToRootTransforms[transformIndex];
+}
+
 // ----------------------------------------------------------------------
 
 const PoseModelTransform *Skeleton::getBindPoseModelToRootTransforms() const
@@ -1747,9 +2146,12 @@ void Skeleton::calculateExtent() const
 		const Vector     rootPosition  = rootTransform.rotateTranslate_l2p(Vector::zero);
 		m_extent->set(rootPosition, rootPosition, rootPosition, CONST_REAL(0));
 
-		// note: we're spinning through all transforms, including any hardpoints
+		// note: hardpoints are skipped so the extent does not force them to be resolved
 		for (int transformIndex = 1; transformIndex < m_transformCount; ++transformIndex)
 		{
+			if (m_flatHierarchy->isHardpoint(transformIndex))
+				continue;
+
 			const Transform &transform = m_jointToRootTransforms[transformIndex];
 			const Vector     position  = transform.rotateTranslate_l2p(Vector::zero);
 			m_extent->updateMinAndMax(position);
@@ -1855,6 +2257,20 @@ void Skeleton::remove()
 	DEBUG_FATAL(!s_installed, ("Skeleton not installed."));
 	s_installed = false;
 
+	DebugFlags::unregisterFlag(s_useSegmentedHierarchy);
+
+#if PRODUCTION == 0
+	DebugFlags::unregisterFlag(s_benchmarkHierarchy);
+	DebugFlags::unregisterFlag(s_reportHierarchyBenchmark);
+	DebugFlags::unregisterFlag(s_resetHierarchyBenchmark);
+
+	s_hierarchyBenchmarkRecords.clear();
+	std::vector<Transform>().swap(s_segmentedBenchmarkTransforms);
+	std::vector<Transform>().swap(s_flatBenchmarkTransforms);
+#endif
+
+	AttachmentChainVector().swap(s_attachmentChains);
+
 	removeMemoryBlockManager();
 }
 
@@ -1898,6 +2314,8 @@ void Skeleton::allocateTransformArrays(int transformCount)
 	m_frameLastExtentCalculate              = -1;
 	m_frameLastJointToRootCalculate         = -1;
 	m_frameLastBindPoseModelToRootCalculate = -1;
+
+	m_hardpointEvaluationStamps->assign(static_cast<size_t>(transformCount), -1);
 }
 
 //----------------------------------------------------------------------
@@ -1911,7 +2329,7 @@ const Transform * Skeleton::findTransform(CrcString const &name) const
 	findTransformIndex (name, &transformIndex, &found);
 
 	if (found)
-		return &getJointToRootTransformArray()[transformIndex];
+		return &getTransformToRoot(transformIndex);
 	else
 		return 0;
 }
@@ -15,6 +15,7 @@
 
 class BoxExtent;
 class CrcString;
+class FlatSkeletonHierarchy;
 class Object;
 class SkeletalAppearance2;
 class BasicSkeletonTemplate;
@@ -76,6 +77,7 @@ public:
 
 	int                       getTransformCount() const;
 	const Transform          *getJointToRootTransformArray() const;
+	const Transform          &getTransformToRoot(int transformIndex) const;
 	const PoseModelTransform *getBindPoseModelToRootTransforms() const;
 
 	void                    addShaderPrimitives(const SkeletalAppearance2 &appearance) const;
@@ -103,6 +105,7 @@ public:
 
 private:
 
+	typedef stdvector<int>::fwd                    IntVector;
 	typedef stdmap<int, TransformModifier *>::fwd  TransformModifierMap;
 	typedef stdvector<Segment*>::fwd               SegmentVector;
 
@@ -118,9 +121,15 @@ private:
 	void                    findSegmentLocalTransformIndex(CrcString const &transformName, int &segmentIndex, int &segmentLocalTransformIndex, bool &foundIt) const;
 
 	void                    rebuildLinkedSkeletonDefinition();
+	void                    rebuildFlatHierarchy();
 
 	void                    drawJointFramesNow(const Transform &skeletonToWorld, const Vector &scale) const;
 	void                    calculateJointToRootTransforms() const;
+	void                    calculateJointToRootTransformsSegmented(Transform *jointToRootTransforms, bool applyTransformModifiers) const;
+	void                    calculateJointToRootTransformsFlat(Transform *jointToRootTransforms, bool applyTransformModifiers) const;
+	void                    calculateHardpointToRootTransform(int transformIndex) const;
+	void                    calculateAllHardpointToRootTransforms() const;
+	void                    benchmarkJointToRootTransforms() const;
 	void                    calculateBindPoseModelToRootTransforms() const;
 	void                    calculateExtent() const;
 
@@ -140,6 +149,10 @@ private:
 	mutable int                   m_frameLastBindPoseModelToRootCalculate;
 	mutable int                   m_frameLastExtentCalculate;
 
+	// hardpoints are resolved on demand; each remembers the jointToRoot evaluation it was resolved against.
+	mutable int                   m_jointToRootEvaluationCount;
+	IntVector                    *m_hardpointEvaluationStamps;
+
 	SkeletonTransformNameMap     *m_transformNameMap;
 	mutable BoxExtent            *m_extent;
 
@@ -152,6 +165,8 @@ private:
 
 	TransformModifierMap         *m_transformModifierMap;
 
+	FlatSkeletonHierarchy        *m_flatHierarchy;
+
 private:
 
 	// disabled
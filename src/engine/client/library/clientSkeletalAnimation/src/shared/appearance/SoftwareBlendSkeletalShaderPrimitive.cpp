@@ -35,15 +35,17 @@
 #include "clientSkeletalAnimation/Skeleton.h"
 #include "clientSkeletalAnimation/PoseModelTransform.h"
 #include "sharedCollision/CollisionInfo.h"
+#include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/PerformanceTimer.h"
 #include "sharedDebug/Profiler.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/MemoryBlockManager.h"
 #include "sharedFoundation/Os.h"
 #include "sharedFoundation/PointerDeleter.h"
 #include "sharedFoundation/VoidMemberFunction.h"
+#include "sharedThread/WorkerPool.h"
 #include "sharedMath/PaletteArgb.h"
 #include "sharedMath/Plane.h"
-#include "sharedMath/SSeMath.h"
 #include "sharedMath/VectorArgb.h"
 #include "sharedObject/AppearanceTemplate.h"
 #include "sharedObject/ConfigSharedObject.h"
@@ -58,11 +60,23 @@
 #include <malloc.h>
 
 //-----------------------------------
-#undef TRY_FOR_SSE
-#define TRY_FOR_SSE WIN32
-
-#if TRY_FOR_SSE
-#include "sharedMath/SseMath.h"
+// The hard skinning kernels use SSE4.1 and AVX2 intrinsics on x86 and x64.
+// Each kernel is compiled for its own instruction set and selected at
+// runtime, so the rest of the library does not require those instruction sets.
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define SKINNING_USE_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SKINNING_TARGET_SSE41
+#define SKINNING_TARGET_AVX2
+#else
+#define SKINNING_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define SKINNING_TARGET_AVX2  __attribute__((target("avx2,fma")))
+#endif
+#else
+#define SKINNING_USE_SIMD 0
 #endif
 
 // ==============================================================================
@@ -86,9 +100,58 @@ namespace SofwareBlendSkeletalShaderPrimitiveNamespace
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+	typedef stdvector<byte>::fwd                ByteVector;
 	typedef stdvector<PackedArgb>::fwd          PackedArgbVector;
 	typedef stdvector<std::string const*>::fwd  StringVector;
 
+	typedef stdvector<SoftwareBlendSkeletalShaderPrimitive const*>::fwd  PrimitiveVector;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct SkinningJob
+	{
+		SoftwareBlendSkeletalShaderPrimitive const *primitive;
+		int                                         transformCount;
+		PoseModelTransform const                   *transformArray;
+	};
+
+	typedef stdvector<SkinningJob>::fwd  SkinningJobVector;
+
+	struct SkinningStatistics
+	{
+		int   numberOfVertices;
+		int   numberOfPrimitives;
+		int   numberOfPhaseVertices;
+		int   numberOfPhaseJobs;
+		int   numberOfPhases;
+		float phaseTime;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	enum SkinningKernel
+	{
+		SK_reference,
+		SK_sse41,
+		SK_avx2,
+
+		SK_count
+	};
+
+	char const * const cs_skinningKernelNames[SK_count] =
+	{
+		"reference",
+		"sse4.1",
+		"avx2"
+	};
+
+	struct SkinningBenchmarkRecord
+	{
+		int   numberOfVertices;
+		float time;
+		float maximumError;
+	};
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	Tag const TAG_MAIN = TAG(M,A,I,N);
@@ -102,7 +165,47 @@ namespace SofwareBlendSkeletalShaderPrimitiveNamespace
 	PackedArgbVector  s_hueColors;
 	StringVector      s_hueVariableNames;
 
-	bool              s_useSSE;
+	SkinningKernel    s_bestSkinningKernel;
+	SkinningKernel    s_skinningKernel;
+
+	bool              s_useReferenceSkinning;
+	bool              s_benchmarkSkinning;
+	bool              s_reportSkinningBenchmark;
+	bool              s_resetSkinningBenchmark;
+
+	SkinningBenchmarkRecord s_skinningBenchmarkRecords[SK_count];
+	ByteVector              s_referenceVertexData;
+	ByteVector              s_benchmarkVertexData;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	WorkerPool        *s_skinningWorkerPool;
+	PrimitiveVector    s_skinningQueue;
+	SkinningJobVector  s_skinningJobs;
+
+	bool               s_disableSkinningPhase;
+	bool               s_disableSkinningThreads;
+	bool               s_reportSkinning;
+
+	int                s_skinningStatisticsFrameNumber;
+	SkinningStatistics s_skinningStatistics;
+	SkinningStatistics s_lastFrameSkinningStatistics;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	//-- statistics are kept per graphics frame; the previous frame is what gets reported.
+	SkinningStatistics &getSkinningStatistics()
+	{
+		int const frameNumber = Graphics::getFrameNumber();
+		if (frameNumber != s_skinningStatisticsFrameNumber)
+		{
+			s_skinningStatisticsFrameNumber = frameNumber;
+			s_lastFrameSkinningStatistics   = s_skinningStatistics;
+			memset(&s_skinningStatistics, 0, sizeof(s_skinningStatistics));
+		}
+
+		return s_skinningStatistics;
+	}
 }
 
 using namespace SofwareBlendSkeletalShaderPrimitiveNamespace;
@@ -136,7 +239,6 @@ struct SoftwareBlendSkeletalShaderPrimitive::Dot3Vector
 	Vector  m_dot3Vector;
 	float   m_flipState;
 };
-#define SOURCE_DOT3_SIZE 16
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 struct SoftwareBlendSkeletalShaderPrimitive::SourceVertex
 {
@@ -145,7 +247,6 @@ struct SoftwareBlendSkeletalShaderPrimitive::SourceVertex
 	Vector        m_position;
 	Vector        m_normal;
 };
-#define SOURCE_VERTEX_SIZE 36 // TODO: this is lame.  Need to figure out how to get the inline assembler to do this
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 class SoftwareBlendSkeletalShaderPrimitive::RenderCommand
@@ -182,11 +283,6 @@ private:
 };
 
 // ======================================================================
-struct fill_vb_work;
-
-void _fillDot3VertexBufferHard_sse(const fill_vb_work *w);
-void _fillVertexBufferHard_sse(const fill_vb_work *w);
-
 struct fill_vb_work
 {
 	void construct(
@@ -208,11 +304,9 @@ struct fill_vb_work
 		dot3viter            = i_dot3viter;
 		//------------------------------------------
 		m_sourceVectorsEnd     = m_sourceVectors + vertexCount;
-		m_sourceVectorPrefetch = ((uint8 *)m_sourceVectors) + 256;
 		if (m_sourceDot3Vectors)
 		{
 			m_sourceDot3VectorsEnd = m_sourceDot3Vectors + vertexCount;
-			m_sourceVectorDot3Prefetch = ((uint8 *)m_sourceDot3Vectors) + 256;
 		}
 		xf=0;
 		identity.makeIdentity();
@@ -225,11 +319,6 @@ struct fill_vb_work
 	void fillDot3VertexBufferHard() const;
 	void fillVertexBufferHard() const;
 
-#if TRY_FOR_SSE
-	void fillDot3VertexBufferHard_sse() const { _fillDot3VertexBufferHard_sse(this); }
-	void fillVertexBufferHard_sse() const { _fillVertexBufferHard_sse(this); }
-#endif
-
 	PoseModelTransform identity;
 
 	mutable PaddedVector        position;
@@ -241,9 +330,7 @@ struct fill_vb_work
 	mutable byte               *viter;
 	mutable byte               *dot3viter;
 	mutable const SourceVertex *m_sourceVectors;
-	mutable const uint8        *m_sourceVectorPrefetch;
 	mutable const Dot3Vector   *m_sourceDot3Vectors;
-	mutable const uint8        *m_sourceVectorDot3Prefetch;
 
 	const PoseModelTransform *transformArray;
 	int                 vertexCount;
@@ -252,7 +339,359 @@ struct fill_vb_work
 	int                 vertexSize;
 };
 
-// ======================================================================
+// ============================================================================
+// SIMD hard skinning kernels.
+//
+// PoseModelTransform is column-major, so a transformed vector is
+// c0*x + c1*y + c2*z (+ c3 for positions) where cN is matrix[N].  The
+// kernels use unaligned loads throughout so they do not depend on the
+// alignment of the source data or the transform array.
+//
+// The SSE4.1 kernel adds the terms in the same order as the reference
+// implementation and produces identical results.  The AVX2 kernel skins
+// two vertices per iteration with fused multiply-adds, so its results can
+// differ from the reference in the last bit.
+// ============================================================================
+
+#if SKINNING_USE_SIMD
+
+namespace SofwareBlendSkeletalShaderPrimitiveNamespace
+{
+	// ----------------------------------------------------------------------
+	// Writes position and normal as 6 contiguous floats.  Exactly 24 bytes
+	// are written so the rest of the vertex is left untouched.
+
+	SKINNING_TARGET_SSE41 inline void storePositionNormal_sse41(byte *const destination, __m128 const position, __m128 const normal)
+	{
+		_mm_storeu_ps(reinterpret_cast<float *>(destination), _mm_insert_ps(position, normal, 0x30));
+		_mm_storel_pi(reinterpret_cast<__m64 *>(destination + 16), _mm_shuffle_ps(normal, normal, _MM_SHUFFLE(3, 3, 2, 1)));
+	}
+
+	// ----------------------------------------------------------------------
+
+	SKINNING_TARGET_SSE41 inline void skinVertex_sse41(PoseModelTransform const &transform, SourceVertex const &sourceVertex, Dot3Vector const *const sourceDot3, byte *const destination, byte *const dot3Destination, __m128 &minVector, __m128 &maxVector)
+	{
+		__m128 const c0 = _mm_loadu_ps(transform.matrix[0]);
+		__m128 const c1 = _mm_loadu_ps(transform.matrix[1]);
+		__m128 const c2 = _mm_loadu_ps(transform.matrix[2]);
+		__m128 const c3 = _mm_loadu_ps(transform.matrix[3]);
+
+		//-- p = px py pz nx, n = pz nx ny nz.  Both loads stay within the source vertex.
+		__m128 const p = _mm_loadu_ps(&sourceVertex.m_position.x);
+		__m128 const n = _mm_loadu_ps(&sourceVertex.m_position.z);
+
+		__m128 position = _mm_mul_ps(c0, _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0)));
+		position = _mm_add_ps(position, _mm_mul_ps(c1, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1))));
+		position = _mm_add_ps(position, _mm_mul_ps(c2, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2))));
+		position = _mm_add_ps(position, c3);
+
+		__m128 normal = _mm_mul_ps(c0, _mm_shuffle_ps(n, n, _MM_SHUFFLE(1, 1, 1, 1)));
+		normal = _mm_add_ps(normal, _mm_mul_ps(c1, _mm_shuffle_ps(n, n, _MM_SHUFFLE(2, 2, 2, 2))));
+		normal = _mm_add_ps(normal, _mm_mul_ps(c2, _mm_shuffle_ps(n, n, _MM_SHUFFLE(3, 3, 3, 3))));
+
+		minVector = _mm_min_ps(minVector, position);
+		maxVector = _mm_max_ps(maxVector, position);
+
+		storePositionNormal_sse41(destination, position, normal);
+
+		if (sourceDot3)
+		{
+			//-- rotate the dot3 vector and carry the flip state through in w.
+			__m128 const d = _mm_loadu_ps(&sourceDot3->m_dot3Vector.x);
+
+			__m128 dot3 = _mm_mul_ps(c0, _mm_shuffle_ps(d, d, _MM_SHUFFLE(0, 0, 0, 0)));
+			dot3 = _mm_add_ps(dot3, _mm_mul_ps(c1, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 1, 1, 1))));
+			dot3 = _mm_add_ps(dot3, _mm_mul_ps(c2, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 2, 2, 2))));
+
+			_mm_storeu_ps(reinterpret_cast<float *>(dot3Destination), _mm_blend_ps(dot3, d, 0x8));
+		}
+	}
+
+	// ----------------------------------------------------------------------
+
+	SKINNING_TARGET_SSE41 void skinHard_sse41(fill_vb_work const &w)
+	{
+		SourceVertex const *sourceVertex = w.m_sourceVectors;
+		Dot3Vector const   *sourceDot3   = w.m_sourceDot3Vectors;
+		byte               *destination  = w.viter;
+		byte               *dot3Destination = w.dot3viter;
+
+		__m128 minVector = _mm_set1_ps( std::numeric_limits<float>::max());
+		__m128 maxVector = _mm_set1_ps(-std::numeric_limits<float>::max());
+
+		for (int i = 0; i < w.vertexCount; ++i)
+		{
+			skinVertex_sse41(w.transformArray[sourceVertex->m_firstTransformData.m_transformIndex], *sourceVertex, sourceDot3, destination, dot3Destination, minVector, maxVector);
+
+			++sourceVertex;
+			destination += w.vertexSize;
+
+			if (sourceDot3)
+			{
+				++sourceDot3;
+				dot3Destination += w.vertexSize;
+			}
+		}
+
+		_mm_storeu_ps(&w.minVector.x, minVector);
+		_mm_storeu_ps(&w.maxVector.x, maxVector);
+	}
+
+	// ----------------------------------------------------------------------
+
+	SKINNING_TARGET_AVX2 inline __m256 loadPair_avx2(float const *const low, float const *const high)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+	}
+
+	// ----------------------------------------------------------------------
+
+	SKINNING_TARGET_AVX2 void skinHard_avx2(fill_vb_work const &w)
+	{
+		SourceVertex const *sourceVertex = w.m_sourceVectors;
+		Dot3Vector const   *sourceDot3   = w.m_sourceDot3Vectors;
+		byte               *destination  = w.viter;
+		byte               *dot3Destination = w.dot3viter;
+		int const           vertexSize   = w.vertexSize;
+
+		__m256 minVector2 = _mm256_set1_ps( std::numeric_limits<float>::max());
+		__m256 maxVector2 = _mm256_set1_ps(-std::numeric_limits<float>::max());
+
+		//-- skin two vertices per iteration, one in each 128 bit lane.
+		int i = 0;
+		for (; i + 1 < w.vertexCount; i += 2)
+		{
+			PoseModelTransform const &transform0 = w.transformArray[sourceVertex[0].m_firstTransformData.m_transformIndex];
+			PoseModelTransform const &transform1 = w.transformArray[sourceVertex[1].m_firstTransformData.m_transformIndex];
+
+			__m256 const c0 = loadPair_avx2(transform0.matrix[0], transform1.matrix[0]);
+			__m256 const c1 = loadPair_avx2(transform0.matrix[1], transform1.matrix[1]);
+			__m256 const c2 = loadPair_avx2(transform0.matrix[2], transform1.matrix[2]);
+			__m256 const c3 = loadPair_avx2(transform0.matrix[3], transform1.matrix[3]);
+
+			__m256 const p = loadPair_avx2(&sourceVertex[0].m_position.x, &sourceVertex[1].m_position.x);
+			__m256 const n = loadPair_avx2(&sourceVertex[0].m_position.z, &sourceVertex[1].m_position.z);
+
+			__m256 position = _mm256_fmadd_ps(c0, _mm256_permute_ps(p, _MM_SHUFFLE(0, 0, 0, 0)), c3);
+			position = _mm256_fmadd_ps(c1, _mm256_permute_ps(p, _MM_SHUFFLE(1, 1, 1, 1)), position);
+			position = _mm256_fmadd_ps(c2, _mm256_permute_ps(p, _MM_SHUFFLE(2, 2, 2, 2)), position);
+
+			__m256 normal = _mm256_mul_ps(c0, _mm256_permute_ps(n, _MM_SHUFFLE(1, 1, 1, 1)));
+			normal = _mm256_fmadd_ps(c1, _mm256_permute_ps(n, _MM_SHUFFLE(2, 2, 2, 2)), normal);
+			normal = _mm256_fmadd_ps(c2, _mm256_permute_ps(n, _MM_SHUFFLE(3, 3, 3, 3)), normal);
+
+			minVector2 = _mm256_min_ps(minVector2, position);
+			maxVector2 = _mm256_max_ps(maxVector2, position);
+
+			storePositionNormal_sse41(destination,              _mm256_castps256_ps128(position), _mm256_castps256_ps128(normal));
+			storePositionNormal_sse41(destination + vertexSize, _mm256_extractf128_ps(position, 1), _mm256_extractf128_ps(normal, 1));
+
+			if (sourceDot3)
+			{
+				__m256 const d = loadPair_avx2(&sourceDot3[0].m_dot3Vector.x, &sourceDot3[1].m_dot3Vector.x);
+
+				__m256 dot3 = _mm256_mul_ps(c0, _mm256_permute_ps(d, _MM_SHUFFLE(0, 0, 0, 0)));
+				dot3 = _mm256_fmadd_ps(c1, _mm256_permute_ps(d, _MM_SHUFFLE(1, 1, 1, 1)), dot3);
+				dot3 = _mm256_fmadd_ps(c2, _mm256_permute_ps(d, _MM_SHUFFLE(2, 2, 2, 2)), dot3);
+				dot3 = _mm256_blend_ps(dot3, d, 0x88);
+
+				_mm_storeu_ps(reinterpret_cast<float *>(dot3Destination),              _mm256_castps256_ps128(dot3));
+				_mm_storeu_ps(reinterpret_cast<float *>(dot3Destination + vertexSize), _mm256_extractf128_ps(dot3, 1));
+
+				sourceDot3 += 2;
+				dot3Destination += 2 * vertexSize;
+			}
+
+			sourceVertex += 2;
+			destination += 2 * vertexSize;
+		}
+
+		__m128 minVector = _mm_min_ps(_mm256_castps256_ps128(minVector2), _mm256_extractf128_ps(minVector2, 1));
+		__m128 maxVector = _mm_max_ps(_mm256_castps256_ps128(maxVector2), _mm256_extractf128_ps(maxVector2, 1));
+
+		//-- odd vertex
+		if (i < w.vertexCount)
+			skinVertex_sse41(w.transformArray[sourceVertex->m_firstTransformData.m_transformIndex], *sourceVertex, sourceDot3, destination, dot3Destination, minVector, maxVector);
+
+		_mm_storeu_ps(&w.minVector.x, minVector);
+		_mm_storeu_ps(&w.maxVector.x, maxVector);
+
+		_mm256_zeroupper();
+	}
+}
+
+#endif
+
+// ============================================================================
+// Skinning kernel selection and benchmarking.
+// ============================================================================
+
+namespace SofwareBlendSkeletalShaderPrimitiveNamespace
+{
+	void skinHard_reference(fill_vb_work const &w)
+	{
+		if (w.m_sourceDot3Vectors)
+			w.fillDot3VertexBufferHard();
+		else
+			w.fillVertexBufferHard();
+	}
+
+	// ----------------------------------------------------------------------
+
+	typedef void (*SkinHardFunction)(fill_vb_work const &w);
+
+	SkinHardFunction const cs_skinHardFunctions[SK_count] =
+	{
+		skinHard_reference,
+#if SKINNING_USE_SIMD
+		skinHard_sse41,
+		skinHard_avx2
+#else
+		skinHard_reference,
+		skinHard_reference
+#endif
+	};
+
+	// ----------------------------------------------------------------------
+
+	SkinningKernel detectSkinningKernel()
+	{
+#if SKINNING_USE_SIMD
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		int const maximumLeaf = info[0];
+		if (maximumLeaf < 1)
+			return SK_reference;
+
+		__cpuid(info, 1);
+		bool const hasSse41   = (info[2] & (1 << 19)) != 0;
+		bool const hasFma     = (info[2] & (1 << 12)) != 0;
+		bool const hasOsxsave = (info[2] & (1 << 27)) != 0;
+		bool const hasAvx     = (info[2] & (1 << 28)) != 0;
+
+		//-- AVX also needs the OS to save the ymm registers.
+		bool hasAvx2 = false;
+		if (maximumLeaf >= 7 && hasAvx && hasFma && hasOsxsave && (_xgetbv(0) & 0x6) == 0x6)
+		{
+			__cpuidex(info, 7, 0);
+			hasAvx2 = (info[1] & (1 << 5)) != 0;
+		}
+#else
+		__builtin_cpu_init();
+		bool const hasSse41 = __builtin_cpu_supports("sse4.1") != 0;
+		bool const hasAvx2  = (__builtin_cpu_supports("avx2") != 0) && (__builtin_cpu_supports("fma") != 0);
+#endif
+
+		if (hasAvx2)
+			return SK_avx2;
+
+		if (hasSse41)
+			return SK_sse41;
+#endif
+
+		return SK_reference;
+	}
+
+	// ----------------------------------------------------------------------
+
+	float computeMaximumError(byte const *const reference, byte const *const result, int const vertexCount, int const vertexSize, int const dot3Offset)
+	{
+		float maximumError = 0.0f;
+
+		for (int i = 0; i < vertexCount; ++i)
+		{
+			int const offset = i * vertexSize;
+
+			//-- position and normal
+			float const *a = reinterpret_cast<float const *>(reference + offset);
+			float const *b = reinterpret_cast<float const *>(result + offset);
+			int j;
+			for (j = 0; j < 6; ++j)
+				maximumError = std::max(maximumError, fabsf(a[j] - b[j]));
+
+			//-- dot3 vector and flip state
+			if (dot3Offset > 0)
+			{
+				a = reinterpret_cast<float const *>(reference + offset + dot3Offset);
+				b = reinterpret_cast<float const *>(result + offset + dot3Offset);
+				for (j = 0; j < 4; ++j)
+					maximumError = std::max(maximumError, fabsf(a[j] - b[j]));
+			}
+		}
+
+		return maximumError;
+	}
+
+	// ----------------------------------------------------------------------
+	/**
+	 * Skin a mesh with every kernel the cpu supports into scratch buffers,
+	 * timing each one and comparing its output against the reference kernel.
+	 */
+
+	void benchmarkSkinning(int const vertexCount, SourceVertex const *const sourceVectors, Dot3Vector const *const sourceDot3Vectors, PoseModelTransform const *const transformArray, int const vertexSize, int const dot3Offset)
+	{
+		if (vertexCount <= 0)
+			return;
+
+		size_t const bufferSize = static_cast<size_t>(vertexCount * vertexSize);
+		s_referenceVertexData.resize(bufferSize);
+		s_benchmarkVertexData.resize(bufferSize);
+
+		fill_vb_work *const w = reinterpret_cast<fill_vb_work *>(STACK_ALLOC_ALIGN_16(sizeof(fill_vb_work)));
+
+		for (int kernel = 0; kernel <= static_cast<int>(s_bestSkinningKernel); ++kernel)
+		{
+			ByteVector &vertexData = (kernel == SK_reference) ? s_referenceVertexData : s_benchmarkVertexData;
+			byte *const viter = &vertexData[0];
+
+			memset(w, 0, sizeof(*w));
+			w->construct(vertexCount, sourceVectors, sourceDot3Vectors, transformArray, vertexSize, viter, sourceDot3Vectors ? viter + dot3Offset : 0);
+
+			PerformanceTimer timer;
+			timer.start();
+
+				(*cs_skinHardFunctions[kernel])(*w);
+
+			timer.stop();
+
+			SkinningBenchmarkRecord &record = s_skinningBenchmarkRecords[kernel];
+			record.numberOfVertices += vertexCount;
+			record.time             += timer.getElapsedTime();
+
+			if (kernel != SK_reference)
+				record.maximumError = std::max(record.maximumError, computeMaximumError(&s_referenceVertexData[0], viter, vertexCount, vertexSize, sourceDot3Vectors ? dot3Offset : 0));
+		}
+	}
+
+	// ----------------------------------------------------------------------
+
+	void reportSkinningBenchmark()
+	{
+		DEBUG_REPORT_PRINT(true, ("-- software skinning: using %s kernel, best available %s\n", cs_skinningKernelNames[s_useReferenceSkinning ? SK_reference : s_skinningKernel], cs_skinningKernelNames[s_bestSkinningKernel]));
+
+		for (int kernel = 0; kernel <= static_cast<int>(s_bestSkinningKernel); ++kernel)
+		{
+			SkinningBenchmarkRecord const &record = s_skinningBenchmarkRecords[kernel];
+			float const verticesPerSecond = (record.time > 0.0f) ? static_cast<float>(record.numberOfVertices) / record.time : 0.0f;
+
+			DEBUG_REPORT_PRINT(true, ("  %-9s %12.0f vertices/s  %10d vertices  max error %g\n", cs_skinningKernelNames[kernel], verticesPerSecond, record.numberOfVertices, record.maximumError));
+		}
+	}
+
+	// ----------------------------------------------------------------------
+
+	void resetSkinningBenchmark()
+	{
+		//-- one shot
+		s_resetSkinningBenchmark = false;
+
+		memset(s_skinningBenchmarkRecords, 0, sizeof(s_skinningBenchmarkRecords));
+	}
+}
+
+// ============================================================================
+
 
 // ======================================================================
 // class SoftwareBlendSkeletalShaderPrimitive::RenderCommand
@@ -333,11 +772,21 @@ void SoftwareBlendSkeletalShaderPrimitive::install()
 		&& !ConfigClientGraphics::getDisableMultiStreamVertexBuffers()
 		;
 
-#if TRY_FOR_SSE
-	s_useSSE = SseMath::canDoSseMath();
-#else
-	s_useSSE = false;
-#endif
+	s_bestSkinningKernel = detectSkinningKernel();
+	s_skinningKernel     = ConfigClientSkeletalAnimation::getDisableSimdSkinning() ? SK_reference : s_bestSkinningKernel;
+
+	DebugFlags::registerFlag(s_useReferenceSkinning,    "ClientSkeletalAnimation/Skinning", "useReferenceSkinning");
+	DebugFlags::registerFlag(s_benchmarkSkinning,       "ClientSkeletalAnimation/Skinning", "benchmarkSkinning");
+	DebugFlags::registerFlag(s_reportSkinningBenchmark, "ClientSkeletalAnimation/Skinning", "reportSkinningBenchmark", reportSkinningBenchmark);
+	DebugFlags::registerFlag(s_resetSkinningBenchmark,  "ClientSkeletalAnimation/Skinning", "resetSkinningBenchmark", resetSkinningBenchmark);
+	DebugFlags::registerFlag(s_disableSkinningPhase,    "ClientSkeletalAnimation/Skinning", "disableSkinningPhase");
+	DebugFlags::registerFlag(s_disableSkinningThreads,  "ClientSkeletalAnimation/Skinning", "disableSkinningThreads");
+	DebugFlags::registerFlag(s_reportSkinning,          "ClientSkeletalAnimation/Skinning", "reportSkinning", reportSkinning);
+
+	//-- a thread count of zero skins every primitive serially in prepareToDraw, as before.
+	int const skinningThreadCount = ConfigClientSkeletalAnimation::getSkinningThreadCount();
+	if (skinningThreadCount > 0)
+		s_skinningWorkerPool = new WorkerPool("Skinning", skinningThreadCount);
 
 	ms_installed = true;
 	ExitChain::add(remove, "SoftwareBlendSkeletalShaderPrimitive");
@@ -349,9 +798,150 @@ void SoftwareBlendSkeletalShaderPrimitive::remove()
 {
 	DEBUG_FATAL(!ms_installed, ("SoftwareBlendSkeletalShaderPrimitive not installed"));
 
+	DebugFlags::unregisterFlag(s_useReferenceSkinning);
+	DebugFlags::unregisterFlag(s_benchmarkSkinning);
+	DebugFlags::unregisterFlag(s_reportSkinningBenchmark);
+	DebugFlags::unregisterFlag(s_resetSkinningBenchmark);
+	DebugFlags::unregisterFlag(s_disableSkinningPhase);
+	DebugFlags::unregisterFlag(s_disableSkinningThreads);
+	DebugFlags::unregisterFlag(s_reportSkinning);
+
+	delete s_skinningWorkerPool;
+	s_skinningWorkerPool = 0;
+
+	DEBUG_WARNING(!s_skinningQueue.empty(), ("SoftwareBlendSkeletalShaderPrimitive::remove: %d primitives still queued for skinning", static_cast<int>(s_skinningQueue.size())));
+	PrimitiveVector().swap(s_skinningQueue);
+	SkinningJobVector().swap(s_skinningJobs);
+
+	ByteVector().swap(s_referenceVertexData);
+	ByteVector().swap(s_benchmarkVertexData);
+
 	removeMemoryBlockManager();
 }
 
+// ----------------------------------------------------------------------
+
+int SoftwareBlendSkeletalShaderPrimitive::getNumberOfSkinnedVerticesLastFrame()
+{
+	//-- roll the statistics over if a new frame has started
+	IGNORE_RETURN(getSkinningStatistics());
+
+	return s_lastFrameSkinningStatistics.numberOfVertices;
+}
+
+// ----------------------------------------------------------------------
+
+float SoftwareBlendSkeletalShaderPrimitive::getSkinningPhaseTimeLastFrame()
+{
+	//-- roll the statistics over if a new frame has started
+	IGNORE_RETURN(getSkinningStatistics());
+
+	return s_lastFrameSkinningStatistics.phaseTime;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Skin every queued primitive that skins into its system vertex buffer.
+ *
+ * The skinning decision and the skeleton transforms are evaluated here on
+ * the main thread, the skinning itself runs on the worker pool.  Locking
+ * and filling the dynamic vertex buffers stays in prepareToDraw on the
+ * main thread.
+ */
+
+void SoftwareBlendSkeletalShaderPrimitive::runSkinningPhase()
+{
+	NP_PROFILER_AUTO_BLOCK_DEFINE("SoftwareBlendSkeletalShaderPrimitive::runSkinningPhase");
+
+	PerformanceTimer timer;
+	timer.start();
+
+	int const frameNumber = Graphics::getFrameNumber();
+	int numberOfVertices  = 0;
+
+	s_skinningJobs.clear();
+
+	PrimitiveVector::const_iterator const iEnd = s_skinningQueue.end();
+	for (PrimitiveVector::const_iterator i = s_skinningQueue.begin(); i != iEnd; ++i)
+	{
+		SoftwareBlendSkeletalShaderPrimitive const *const primitive = NON_NULL(*i);
+		primitive->m_skinningQueued = false;
+
+		//-- primitives without a system stream skin straight into their locked dynamic vertex buffer.
+		if (!primitive->m_systemStream)
+			continue;
+
+		primitive->m_skinningPhaseFrameNumber = frameNumber;
+
+		if (!primitive->needsSkinning())
+			continue;
+
+		Skeleton const &skeleton = primitive->m_appearance.getSkeleton(primitive->m_lodIndex);
+
+		SkinningJob job;
+		job.primitive      = primitive;
+		job.transformCount = skeleton.getTransformCount();
+		job.transformArray = skeleton.getBindPoseModelToRootTransforms();
+		s_skinningJobs.push_back(job);
+
+		numberOfVertices += primitive->m_vertexCount;
+	}
+
+	s_skinningQueue.clear();
+
+	int const numberOfJobs = static_cast<int>(s_skinningJobs.size());
+
+	//-- the benchmark and the vertex matrix debug rendering use shared state, so they run serially.
+	bool multiThreaded = (s_skinningWorkerPool != 0) && !s_disableSkinningThreads && !s_benchmarkSkinning;
+#ifdef _DEBUG
+	multiThreaded = multiThreaded && !GraphicsDebugFlags::renderVertexMatrices;
+#endif
+
+	if (multiThreaded)
+		s_skinningWorkerPool->run(runSkinningJob, 0, numberOfJobs);
+	else
+	{
+		for (int jobIndex = 0; jobIndex < numberOfJobs; ++jobIndex)
+			runSkinningJob(0, jobIndex);
+	}
+
+	timer.stop();
+
+	SkinningStatistics &statistics = getSkinningStatistics();
+	statistics.numberOfVertices      += numberOfVertices;
+	statistics.numberOfPrimitives    += numberOfJobs;
+	statistics.numberOfPhaseVertices += numberOfVertices;
+	statistics.numberOfPhaseJobs     += numberOfJobs;
+	++statistics.numberOfPhases;
+	statistics.phaseTime             += timer.getElapsedTime();
+}
+
+// ----------------------------------------------------------------------
+
+void SoftwareBlendSkeletalShaderPrimitive::runSkinningJob(void * /* context */, int const jobIndex)
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, jobIndex, static_cast<int>(s_skinningJobs.size()));
+
+	SkinningJob const &job = s_skinningJobs[static_cast<size_t>(jobIndex)];
+	SoftwareBlendSkeletalShaderPrimitive const &primitive = *NON_NULL(job.primitive);
+
+	VertexBufferWriteIterator writeIterator = primitive.m_systemStream->beginWriteOnly();
+	primitive.performSkinning(job.transformCount, job.transformArray, writeIterator);
+}
+
+// ----------------------------------------------------------------------
+
+void SoftwareBlendSkeletalShaderPrimitive::reportSkinning()
+{
+	IGNORE_RETURN(getSkinningStatistics());
+	SkinningStatistics const &statistics = s_lastFrameSkinningStatistics;
+
+	DEBUG_REPORT_PRINT(true, ("-- SoftwareBlendSkeletalShaderPrimitive skinning\n"));
+	DEBUG_REPORT_PRINT(true, ("  skinned vertices = %d in %d primitives\n", statistics.numberOfVertices, statistics.numberOfPrimitives));
+	DEBUG_REPORT_PRINT(true, ("  skinning phase   = %d vertices in %d jobs, %d phases, %1.3f ms wall\n", statistics.numberOfPhaseVertices, statistics.numberOfPhaseJobs, statistics.numberOfPhases, statistics.phaseTime * 1000.0f));
+	DEBUG_REPORT_PRINT(true, ("  worker threads   = %d%s\n", s_skinningWorkerPool ? s_skinningWorkerPool->getNumberOfThreads() : 0, (s_disableSkinningPhase || s_disableSkinningThreads) ? " (disabled)" : ""));
+}
+
 // ======================================================================
 
 SoftwareBlendSkeletalShaderPrimitive::SoftwareBlendSkeletalShaderPrimitive(class SkeletalAppearance2 &appearance, int lodIndex, const MeshConstructionHelper &mesh, int shaderIndex) :
@@ -373,6 +963,8 @@ SoftwareBlendSkeletalShaderPrimitive::SoftwareBlendSkeletalShaderPrimitive(class
 	m_shadowVolume(0),
 	m_skinningMode(SM_softSkinning),
 	m_hasBeenSkinned(false),
+	m_skinningQueued(false),
+	m_skinningPhaseFrameNumber(-1),
 	m_hasDot3Vector(false),
 	m_dot3TextureCoordinateSetIndex(-1),
 	m_haveRepresentativeColor(false),
@@ -397,6 +989,13 @@ SoftwareBlendSkeletalShaderPrimitive::SoftwareBlendSkeletalShaderPrimitive(class
 
 SoftwareBlendSkeletalShaderPrimitive::~SoftwareBlendSkeletalShaderPrimitive()
 {
+	if (m_skinningQueued)
+	{
+		PrimitiveVector::iterator const it = std::find(s_skinningQueue.begin(), s_skinningQueue.end(), this);
+		if (it != s_skinningQueue.end())
+			IGNORE_RETURN(s_skinningQueue.erase(it));
+	}
+
 	m_shader->release();
 	m_shader = 0;
 
@@ -462,12 +1061,23 @@ void SoftwareBlendSkeletalShaderPrimitive::prepareToDraw() const
 	const Transform &transform_apw = m_appearance.getTransform_w();
 	Graphics::setObjectToWorldTransformAndScale(transform_apw, Vector::xyz111);
 
-	//-- Get skeleton.
-	const Skeleton &skeleton = m_appearance.getSkeleton(m_lodIndex);
+	//-- Run the skinning phase if this primitive is waiting for it.
+	if (m_skinningQueued)
+		runSkinningPhase();
 
-	//-- Get transforms
-	const int                 transformCount = skeleton.getTransformCount();
-	const PoseModelTransform *transformArray = skeleton.getBindPoseModelToRootTransforms();
+	bool const skinnedByPhase = (m_skinningPhaseFrameNumber == Graphics::getFrameNumber());
+
+	//-- Get skeleton and transforms, unless the skinning phase already took care of this primitive.
+	int                       transformCount = 0;
+	const PoseModelTransform *transformArray = 0;
+
+	if (!skinnedByPhase)
+	{
+		const Skeleton &skeleton = m_appearance.getSkeleton(m_lodIndex);
+
+		transformCount = skeleton.getTransformCount();
+		transformArray = skeleton.getBindPoseModelToRootTransforms();
+	}
 
 	//-- Setup which vertex buffers will be used for rendering and compute vertex buffer data.
 	if (ms_useMultiStreamVertexBuffers)
@@ -476,8 +1086,11 @@ void SoftwareBlendSkeletalShaderPrimitive::prepareToDraw() const
 
 		// Perform skinning on the system vertex buffer.  Collision and shadows require CPU
 		// access to the position info.
-		VertexBufferWriteIterator  writeIterator = m_systemStream->beginWriteOnly();
-		skinData(transformCount, transformArray, writeIterator);
+		if (!skinnedByPhase)
+		{
+			VertexBufferWriteIterator  writeIterator = m_systemStream->beginWriteOnly();
+			skinData(transformCount, transformArray, writeIterator);
+		}
 
 		m_dynamicStream->lock(m_vertexCount);
 		{
@@ -510,8 +1123,11 @@ void SoftwareBlendSkeletalShaderPrimitive::prepareToDraw() const
 
 			// Compute and fill the system vertex buffer with skinned data.  The system vertex buffer
 			// also stores any non-skinned (static) data (e.g. UVs, color).
-			VertexBufferWriteIterator  writeIterator = m_systemStream->beginWriteOnly();
-			skinData(transformCount, transformArray, writeIterator);
+			if (!skinnedByPhase)
+			{
+				VertexBufferWriteIterator  writeIterator = m_systemStream->beginWriteOnly();
+				skinData(transformCount, transformArray, writeIterator);
+			}
 
 			// Copy the system vertex buffer in one chunk into the dynamic vertex buffer that we render with.
 			// This is how the geometry gets into a buffer readable by the GPU.  We can't render out of system
@@ -713,6 +1329,24 @@ bool SoftwareBlendSkeletalShaderPrimitive::getEveryOtherFrameSkinningEnabled() c
 	return m_everyOtherFrameSkinningEnabled;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Queue this primitive for the next skinning phase.
+ *
+ * Call once the primitive has passed culling and has been submitted for
+ * rendering.  The first prepareToDraw of a queued primitive skins all
+ * queued primitives in parallel.
+ */
+
+void SoftwareBlendSkeletalShaderPrimitive::queueSkinning() const
+{
+	if (s_disableSkinningPhase || !s_skinningWorkerPool || m_skinningQueued)
+		return;
+
+	m_skinningQueued = true;
+	s_skinningQueue.push_back(this);
+}
+
 // ----------------------------------------------------------------------
 
 bool SoftwareBlendSkeletalShaderPrimitive::collide(const Vector &start_o, const Vector &end_o, CollisionInfo &result) const
@@ -1374,7 +2008,7 @@ void SoftwareBlendSkeletalShaderPrimitive::fillConstantVertexBufferData(const Me
 
 // ===========================================================================
 
-void SoftwareBlendSkeletalShaderPrimitive::skinData(int transformCount, const PoseModelTransform *transformArray, VertexBufferWriteIterator &iterator) const
+bool SoftwareBlendSkeletalShaderPrimitive::needsSkinning() const
 {
 	//-- Initialize doSkinning to true only on the first render.
 	bool doSkinning = true;
@@ -1398,14 +2032,43 @@ void SoftwareBlendSkeletalShaderPrimitive::skinData(int transformCount, const Po
 
 	if (!doSkinning)
 	{
-		return;
+		return false;
 	}
 
 	if (m_skinningMode==SM_noSkinning && m_hasBeenSkinned)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+void SoftwareBlendSkeletalShaderPrimitive::skinData(int transformCount, const PoseModelTransform *transformArray, VertexBufferWriteIterator &iterator) const
+{
+	if (!needsSkinning())
 	{
 		return;
 	}
 
+	performSkinning(transformCount, transformArray, iterator);
+
+	SkinningStatistics &statistics = getSkinningStatistics();
+	statistics.numberOfVertices += m_vertexCount;
+	++statistics.numberOfPrimitives;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Skin the mesh into the given iterator.
+ *
+ * Only touches this primitive's own state, so the skinning phase runs it
+ * on the worker threads.
+ */
+
+void SoftwareBlendSkeletalShaderPrimitive::performSkinning(int transformCount, const PoseModelTransform *transformArray, VertexBufferWriteIterator &iterator) const
+{
 	//-- Handle skinning if we're going to do it.
 	switch (m_skinningMode)
 	{
@@ -1429,10 +2092,13 @@ void SoftwareBlendSkeletalShaderPrimitive::skinData(int transformCount, const Po
 			fill_vb_work *w = (fill_vb_work *)STACK_ALLOC_ALIGN_16(sizeof(fill_vb_work));
 			memset(w, 0, sizeof(*w));
 
+			SkinHardFunction const skinHard = cs_skinHardFunctions[s_useReferenceSkinning ? SK_reference : s_skinningKernel];
+			int dot3Offset = 0;
+
 			if (m_hasDot3Vector)
 			{
 				NOT_NULL(m_sourceDot3Vectors);
-				const int dot3Offset = vbi->offsetTextureCoordinateSet[m_dot3TextureCoordinateSetIndex];
+				dot3Offset = vbi->offsetTextureCoordinateSet[m_dot3TextureCoordinateSetIndex];
 				DEBUG_FATAL(dot3Offset<=0, ("Vertex buffer has an unsupported format."));
 
 				w->construct(
@@ -1444,17 +2110,6 @@ void SoftwareBlendSkeletalShaderPrimitive::skinData(int transformCount, const Po
 					viter, 
 					viter + dot3Offset
 				);
-
-			#if TRY_FOR_SSE
-				if (s_useSSE)
-				{
-					w->fillDot3VertexBufferHard_sse();
-				}
-				else
-			#endif
-				{
-					w->fillDot3VertexBufferHard();
-				}
 			}
 			else
 			{
@@ -1467,17 +2122,13 @@ void SoftwareBlendSkeletalShaderPrimitive::skinData(int transformCount, const Po
 					viter, 
 					0
 				);
+			}
 
-			#if TRY_FOR_SSE
-				if (s_useSSE)
-				{
-					w->fillVertexBufferHard_sse();
-				}
-				else
-			#endif
-				{
-					w->fillVertexBufferHard();
-				}
+			(*skinHard)(*w);
+
+			if (s_benchmarkSkinning)
+			{
+				benchmarkSkinning(m_vertexCount, m_sourceVectors, m_hasDot3Vector ? m_sourceDot3Vectors : 0, transformArray, vertexSize, dot3Offset);
 			}
 
 			const Vector &minVector=w->minVector;
@@ -1610,512 +2261,8 @@ void SoftwareBlendSkeletalShaderPrimitive::fillVertexBuffer(int transformCount,
 }
 
 // ============================================================================
-#if TRY_FOR_SSE
-// ============================================================================
-void _fillDot3VertexBufferHard_sse(const fill_vb_work *const w)
-{
-	uint32 mxcsrSave, mxcsrTemp;
-
-	_asm {
-		mov	esi, w // "this" pointer
-
-		mov	eax, [esi]fill_vb_work.m_sourceVectors
-		mov	ebx, [esi]fill_vb_work.m_sourceVectorsEnd
-		mov	ecx, [esi]fill_vb_work.m_sourceDot3Vectors
-		mov	edx, [esi]fill_vb_work.m_sourceDot3VectorsEnd
-
-		sub	ebx, eax // length of sourceVectors array
-		sub	edx, ecx // length of sourceDot3Vectors array
-
-		// ----------------------------------------------------
-		// check the length of sourceVectors array.  If it is
-		// greater than 256, pre-fetch all the cache lines
-		// for the first 256 bytes.
-		cmp	      ebx, 256
-		jl		      skip_vec_prefetch
-		prefetchnta [eax+  0]
-		prefetchnta [eax+ 32]
-		prefetchnta [eax+ 64]
-		prefetchnta [eax+ 96]
-		prefetchnta [eax+128]
-		prefetchnta [eax+160]
-		prefetchnta [eax+192]
-		prefetchnta [eax+224]
-	skip_vec_prefetch:		
-		// ----------------------------------------------------
-
-		// ----------------------------------------------------
-		// check the length of sourceDot3Vectors data array.  If it is
-		// greater than 256, pre-fetch all the cache lines
-		// for the first 256 bytes.
-		cmp	      edx, 256
-		jl		      skip_dot3_prefetch
-		prefetchnta [ecx+  0]
-		prefetchnta [ecx+ 32]
-		prefetchnta [ecx+ 64]
-		prefetchnta [ecx+ 96]
-		prefetchnta [ecx+128]
-		prefetchnta [ecx+160]
-		prefetchnta [ecx+192]
-		prefetchnta [ecx+224]
-	skip_dot3_prefetch:
-		// ----------------------------------------------------
-
-		// ----------------------------------------------------
-		// save the mxcsr register then mask exceptions and enable 
-		// "flush-to_zero" mode.
-		stmxcsr     mxcsrSave
-		mov         eax, mxcsrSave
-		or          eax, (MXCSR_FLUSH_TO_ZERO|MXCSR_PRECISION_MASK|MXCSR_UNDERFLOW_MASK|MXCSR_OVERFLOW_MASK|MXCSR_DENORMAL_MASK)
-		mov         mxcsrTemp, eax
-		ldmxcsr     mxcsrTemp
-		// ----------------------------------------------------
-
-		// ----------------------------------------------------
-		//-- Skin position, normal and dot3.
-		mov         ebx, [esi]fill_vb_work.m_sourceVectors      // current vertex pointer
-		jmp	main_loop_test
-	main_loop_top:
-			// ----------------------------------------------------
-			// pre-fectch sourceVector data
-
-			// check to make sure the pre-fetcher is at least 32 bytes 
-			// from the end of the array.
-			mov	eax, [esi]fill_vb_work.m_sourceVectorPrefetch
-			mov	ebx, [esi]fill_vb_work.m_sourceVectorsEnd
-			sub	ebx, eax
-			cmp	ebx, 32
-			jl		skip_vec_prefetch2
-				// ----------------------------------------------
-				// while the pre-fetcher is less than 256 bytes away
-				// from the current source location, pre-fetch in
-				// 32 byte (cache line) increments
-				//
-				// eax contains m_sourceVectorPrefetch from above
-				mov	      ebx, [esi]fill_vb_work.m_sourceVectors
-				lea	      ebx, [ebx + 256]	// pointer 256 bytes ahead of current source
-				jmp	      vec_prefetch_loop
-			vec_prefetch2:
-				prefetchnta [eax]                 // pre-fetch
-				lea			eax, [eax + 32]       // advance pre-fetcher by cache line
-			vec_prefetch_loop:
-				cmp         eax, ebx              // compare pre-fetch to source+256
-				jl          vec_prefetch2         // if less, pre-fetch
-				mov         [esi]fill_vb_work.m_sourceVectorPrefetch, eax // update pre-fetcher var
-				// ----------------------------------------------
-		skip_vec_prefetch2:
-			// ----------------------------------------------------
-
-			// ----------------------------------------------------
-			// pre-fectch m_sourceVectorDot3 data
-
-			// check to make sure the pre-fetcher is at least 32 bytes 
-			// from the end of the array.
-			mov	eax, [esi]fill_vb_work.m_sourceVectorDot3Prefetch
-			mov	ebx, [esi]fill_vb_work.m_sourceDot3VectorsEnd
-			sub	ebx, eax
-			cmp	ebx, 32
-			jl		skip_dot3_prefetch2
-
-				// ----------------------------------------------
-				// while the dot3 pre-fetcher is less than 256 bytes away
-				// from the current source location, pre-fetch in
-				// 32 byte (cache line) increments
-				//
-				// eax contains m_sourceVectorDot3Prefetch from above
-				mov	      ebx, [esi]fill_vb_work.m_sourceDot3Vectors
-				lea	      ebx, [ebx + 256]   	// pointer 256 bytes ahead of current source
-				jmp	      dot3_prefetch_loop
-			dot3_prefetch2:
-				prefetchnta [eax]                 // pre-fetch
-				lea			eax, [eax + 32]       // advance pre-fetcher by cache line
-			dot3_prefetch_loop:
-				cmp         eax, ebx              // compare pre-fetch to source+256
-				jl          dot3_prefetch2         // if less, pre-fetch
-				mov         [esi]fill_vb_work.m_sourceVectorDot3Prefetch, eax // update dot3 pre-fetcher var
-				// ----------------------------------------------
-		skip_dot3_prefetch2:
-			// ----------------------------------------------------
-
-			mov         ebx, [esi]fill_vb_work.m_sourceVectors      // current vertex pointer
-
-			// ----------------------------------------------------
-			// Initialize first position and normal.
-			mov         edi, [ebx]TransformData.m_transformIndex    // current vertex transform index
-			shl         edi, 6                                      // current vertex transform offset
-			mov         edx, [esi]fill_vb_work.transformArray       // transfrom array
-			lea         eax, [edx + edi]
-			// ----------------------------------------------------
-
-			///////////////////////////////////////////////////////////////
-			// rotateTranslate the source position
-			//----------------------------------------------------------
-			// rotateTranslate_l2p
-			// eax -> 4x4 column-major float transform (16 byte aligned).
-			// ebx -> source vertex
-			movaps xmm0, [eax +  0]                          // column 0 (Cx_)
-			movss  xmm4, [ebx +  0]SourceVertex.m_position   // source vector x
-			movaps xmm1, [eax + 16]                          // column 1 (Cy_)
-			movss  xmm5, [ebx +  4]SourceVertex.m_position   // source vector y
-			movaps xmm2, [eax + 32]                          // column 2 (Cz_)
-			movss  xmm6, [ebx +  8]SourceVertex.m_position   // source vector z
-			movaps xmm3, [eax + 48]                          // column 3 (O_)
-
-			shufps xmm4, xmm4, 0      // x -> x.x.x.x
-			shufps xmm5, xmm5, 0      // y -> y.y.y.y
-			shufps xmm6, xmm6, 0      // z -> z.z.z.z
-
-			mulps  xmm0, xmm4         // col0 * x.x.x.x
-			mulps  xmm1, xmm5         // col1 * y.y.y.y
-			mulps  xmm2, xmm6         // col2 * z.z.z.z
-
-			addps  xmm0, xmm1         // col0*x + col1*y
-			addps  xmm2, xmm3         // col2*z + col3
-			addps  xmm0, xmm2         // col0*x + col1*y + col2*z + col3
-
-			movaps [esi]fill_vb_work.position, xmm0           // save result out
-			///////////////////////////////////////////////////////////////
-
-			///////////////////////////////////////////////////////////////
-			// update the bounding box with the position currently in xmm0
-			movaps	xmm1, xmm0      // save off a copy of the position for the "min" test
-			maxps		xmm0, [esi]fill_vb_work.maxVector
-			minps		xmm1, [esi]fill_vb_work.minVector
-			movaps	[esi]fill_vb_work.maxVector, xmm0
-			movaps	[esi]fill_vb_work.minVector, xmm1
-			///////////////////////////////////////////////////////////////
-
-			///////////////////////////////////////////
-			// rotate the source normal
-			//----------------------------------------------------------
-			// rotate_l2p
-			// eax -> 4x4 column-major float transform (16 byte aligned).
-			// ebx -> source vertex
-			movaps xmm0, [eax +  0]                        // column 0 (Cx_)
-			movss  xmm4, [ebx +  0]SourceVertex.m_normal   // source vector x
-			movaps xmm1, [eax + 16]                        // column 1 (Cy_)
-			movss  xmm5, [ebx +  4]SourceVertex.m_normal   // source vector y
-			movaps xmm2, [eax + 32]                        // column 2 (Cz_)
-			movss  xmm6, [ebx +  8]SourceVertex.m_normal   // source vector z
-
-			shufps xmm4, xmm4, 0      // x -> x.x.x.x
-			shufps xmm5, xmm5, 0      // y -> y.y.y.y
-			shufps xmm6, xmm6, 0      // z -> z.z.z.z
-
-			mulps  xmm0, xmm4         // col0 * x.x.x.x
-			mulps  xmm1, xmm5         // col1 * y.y.y.y
-			mulps  xmm2, xmm6         // col2 * z.z.z.z
-
-			addps  xmm0, xmm1         // col0*x + col1*y
-			addps  xmm0, xmm2         // col0*x + col1*y + col2*z
-
-			movaps [esi]fill_vb_work.normal, xmm0           // save result out
-			///////////////////////////////////////////////////////////////
-
-			///////////////////////////////////////////////////////////////
-			// rotate the source dot3 vector
-			mov	ebx, [esi]fill_vb_work.m_sourceDot3Vectors
-			//----------------------------------------------------------
-			// rotate_l2p
-			// eax -> 4x4 column-major float transform (16 byte aligned).
-			// ebx -> 3 float source vector
-			movaps xmm0, [eax +  0]                          // column 0 (Cx_)
-			movss  xmm4, [ebx +  0]Dot3Vector.m_dot3Vector   // source vector x
-			movaps xmm1, [eax + 16]                          // column 1 (Cy_)
-			movss  xmm5, [ebx +  4]Dot3Vector.m_dot3Vector   // source vector y
-			movaps xmm2, [eax + 32]                          // column 2 (Cz_)
-			movss  xmm6, [ebx +  8]Dot3Vector.m_dot3Vector   // source vector z
-
-			shufps xmm4, xmm4, 0      // x -> x.x.x.x
-			shufps xmm5, xmm5, 0      // y -> y.y.y.y
-			shufps xmm6, xmm6, 0      // z -> z.z.z.z
-
-			mulps  xmm0, xmm4         // col0 * x.x.x.x
-			mulps  xmm1, xmm5         // col1 * y.y.y.y
-			mulps  xmm2, xmm6         // col2 * z.z.z.z
-
-			addps  xmm0, xmm1         // col0*x + col1*y
-			addps  xmm0, xmm2         // col0*x + col1*y + col2*z
-
-			movaps [esi]fill_vb_work.dot3, xmm0           // save result out
-			///////////////////////////////////////////////////////////////
-
-			///////////////////////////////////////////////////////////////
-			//-- Write out render geometry.
-			//*(Vector *)(w->viter +  0) = w->position;
-			//*(Vector *)(w->viter + 12) = w->normal;
-			//*(float *)(w->dot3viter + 0) = w->dot3.x;
-			//*(float *)(w->dot3viter + 4) = w->dot3.y;
-			//*(float *)(w->dot3viter + 8) = w->dot3.z;
-			//*(float *)(w->dot3viter +12) = w->m_sourceDot3Vectors->m_flipState;
-			//
-			// ebx contains m_sourceDot3Vectors from above
-
-			mov         eax, [esi]fill_vb_work.dot3viter    // destination dot3 pointer
-			mov         edi, [esi]fill_vb_work.viter        // destination pointer
-
-			// position and normal
-			mov         ecx, [esi + 0]fill_vb_work.position // xf'ed position.x
-			mov         edx, [esi + 4]fill_vb_work.position // xf'ed position.y
-			mov         [edi + 0], ecx
-			mov         [edi + 4], edx
-			mov         ecx, [esi + 8]fill_vb_work.position // xf'ed position.z
-			mov         edx, [esi + 0]fill_vb_work.normal   // xf'ed normal.x
-			mov         [edi + 8], ecx
-			mov         [edi +12], edx
-			mov         ecx, [esi + 4]fill_vb_work.normal   // xf'ed normal.y
-			mov         edx, [esi + 8]fill_vb_work.normal   // xf'ed normal.z
-			mov         [edi +16], ecx
-			mov         [edi +20], edx
-
-			// dot-3
-			mov         ecx, [esi + 0]fill_vb_work.dot3     // xf'ed dot3.x
-			mov         edx, [esi + 4]fill_vb_work.dot3     // xf'ed dot3.y
-			mov         [eax + 0], ecx
-			mov         [eax + 4], edx
-			mov         ecx, [esi + 8]fill_vb_work.dot3     // xf'ed dot3.z
-			mov         edx, [ebx]Dot3Vector.m_flipState    // source Dot3Vector flip-state
-			mov         [eax + 8], ecx
-			mov         [eax +12], edx
-			///////////////////////////////////////////////////////////////
-
-			// ------------------------------
-			//w->m_sourceVectors++;
-			//w->m_sourceDot3Vectors++;
-			//w->viter+=w->vertexSize;
-			//w->dot3viter+=w->vertexSize;
-			//
-			// eax contains dot3viter from above
-			// edi contains viter from above
-			add         eax, [esi]fill_vb_work.vertexSize
-			add         edi, [esi]fill_vb_work.vertexSize
-			mov         [esi]fill_vb_work.dot3viter, eax
-			mov         [esi]fill_vb_work.viter, edi
-
-			mov         ebx, [esi]fill_vb_work.m_sourceVectors      // current vertex pointer
-			mov         ecx, [esi]fill_vb_work.m_sourceDot3Vectors  // current dot3 pointer
-
-			lea         ebx, BYTE PTR [ebx + SOURCE_VERTEX_SIZE]
-			add         ecx, SOURCE_DOT3_SIZE
-
-			mov         [esi]fill_vb_work.m_sourceVectors, ebx
-			mov         [esi]fill_vb_work.m_sourceDot3Vectors, ecx
-			// ------------------------------
-
-		// end of main loop body
-		// ------------------------------
-	main_loop_test:
-		//while (w->m_sourceVectors!=w->m_sourceVectorsEnd)
-		cmp            ebx, [esi]fill_vb_work.m_sourceVectorsEnd
-		jnz            main_loop_top
-
-		// -----------------------------------
-		// restore mxcsr
-		ldmxcsr mxcsrSave
-		// -----------------------------------
-	}
-	//--------------------------------------------------------------------------------------------
-}
-// ============================================================================
-void _fillVertexBufferHard_sse(const fill_vb_work *const w)
-{
-	uint32 mxcsrSave, mxcsrTemp;
-
-	_asm {
-		mov	esi, w // "this" pointer
-
-		mov	eax, [esi]fill_vb_work.m_sourceVectors
-		mov	ebx, [esi]fill_vb_work.m_sourceVectorsEnd
-
-		sub	ebx, eax // length of sourceVectors array
-
-		// ----------------------------------------------------
-		// check the length of sourceVectors array.  If it is
-		// greater than 256, pre-fetch all the cache lines
-		// for the first 256 bytes.
-		cmp	      ebx, 256
-		jl		      skip_vec_prefetch
-		prefetchnta [eax+  0]
-		prefetchnta [eax+ 32]
-		prefetchnta [eax+ 64]
-		prefetchnta [eax+ 96]
-		prefetchnta [eax+128]
-		prefetchnta [eax+160]
-		prefetchnta [eax+192]
-		prefetchnta [eax+224]
-	skip_vec_prefetch:		
-		// ----------------------------------------------------
-
-		// ----------------------------------------------------
-		// save the mxcsr register then mask exceptions and enable 
-		// "flush-to_zero" mode.
-		stmxcsr     mxcsrSave
-		mov         eax, mxcsrSave
-		or          eax, (MXCSR_FLUSH_TO_ZERO|MXCSR_PRECISION_MASK|MXCSR_UNDERFLOW_MASK|MXCSR_OVERFLOW_MASK|MXCSR_DENORMAL_MASK)
-		mov         mxcsrTemp, eax
-		ldmxcsr     mxcsrTemp
-		// ----------------------------------------------------
-
-		// ----------------------------------------------------
-		//-- Skin position, normal and dot3.
-		mov         ebx, [esi]fill_vb_work.m_sourceVectors      // current vertex pointer
-		jmp	      main_loop_test
-	main_loop_top:
-			// ----------------------------------------------------
-			// pre-fectch sourceVector data
-
-			// check to make sure the pre-fetcher is at least 32 bytes 
-			// from the end of the array.
-			mov	eax, [esi]fill_vb_work.m_sourceVectorPrefetch
-			mov	ebx, [esi]fill_vb_work.m_sourceVectorsEnd
-			sub	ebx, eax
-			cmp	ebx, 32
-			jl		skip_vec_prefetch2
-				// ----------------------------------------------
-				// while the pre-fetcher is less than 256 bytes away
-				// from the current source location, pre-fetch in
-				// 32 byte (cache line) increments
-				//
-				// eax contains m_sourceVectorPrefetch from above
-				mov	      ebx, [esi]fill_vb_work.m_sourceVectors
-				lea	      ebx, [ebx + 256]	// pointer 256 bytes ahead of current source
-				jmp	      vec_prefetch_loop
-			vec_prefetch2:
-				prefetchnta [eax]                 // pre-fetch
-				lea			eax, [eax + 32]       // advance pre-fetcher by cache line
-			vec_prefetch_loop:
-				cmp         eax, ebx              // compare pre-fetch to source+256
-				jl          vec_prefetch2         // if less, pre-fetch
-				mov         [esi]fill_vb_work.m_sourceVectorPrefetch, eax // update pre-fetcher var
-				// ----------------------------------------------
-		skip_vec_prefetch2:
-			// ----------------------------------------------------
-
-			mov         ebx, [esi]fill_vb_work.m_sourceVectors      // current vertex pointer
-
-			// ----------------------------------------------------
-			// Initialize first position and normal.
-			mov         edi, [ebx]TransformData.m_transformIndex    // current vertex transform index
-			shl         edi, 6                                      // current vertex transform offset
-			mov         edx, [esi]fill_vb_work.transformArray       // transfrom array
-			lea         eax, [edx + edi]
-			// ----------------------------------------------------
-
-			///////////////////////////////////////////////////////////////
-			// rotateTranslate the source position
-			//----------------------------------------------------------
-			// rotateTranslate_l2p
-			// eax -> 4x4 column-major float transform (16 byte aligned).
-			// ebx -> source vertex
-			movaps xmm0, [eax +  0]                          // column 0 (Cx_)
-			movss  xmm4, [ebx +  0]SourceVertex.m_position   // source vector x
-			movaps xmm1, [eax + 16]                          // column 1 (Cy_)
-			movss  xmm5, [ebx +  4]SourceVertex.m_position   // source vector y
-			movaps xmm2, [eax + 32]                          // column 2 (Cz_)
-			movss  xmm6, [ebx +  8]SourceVertex.m_position   // source vector z
-			movaps xmm3, [eax + 48]                          // column 3 (O_)
-
-			shufps xmm4, xmm4, 0      // x -> x.x.x.x
-			shufps xmm5, xmm5, 0      // y -> y.y.y.y
-			shufps xmm6, xmm6, 0      // z -> z.z.z.z
-
-			mulps  xmm0, xmm4         // col0 * x.x.x.x
-			mulps  xmm1, xmm5         // col1 * y.y.y.y
-			mulps  xmm2, xmm6         // col2 * z.z.z.z
-
-			addps  xmm0, xmm1         // col0*x + col1*y
-			addps  xmm2, xmm3         // col2*z + col3
-			addps  xmm0, xmm2         // col0*x + col1*y + col2*z + col3
-
-			movaps [esi]fill_vb_work.position, xmm0           // save result out
-			///////////////////////////////////////////////////////////////
-
-			///////////////////////////////////////////////////////////////
-			// update the bounding box with the position currently in xmm0
-			movaps	xmm1, xmm0      // save off a copy of the position for the "min" test
-			maxps		xmm0, [esi]fill_vb_work.maxVector
-			minps		xmm1, [esi]fill_vb_work.minVector
-			movaps	[esi]fill_vb_work.maxVector, xmm0
-			movaps	[esi]fill_vb_work.minVector, xmm1
-			///////////////////////////////////////////////////////////////
-
-			///////////////////////////////////////////
-			// rotate the source normal
-			//----------------------------------------------------------
-			// rotate_l2p
-			// eax -> 4x4 column-major float transform (16 byte aligned).
-			// ebx -> source vertex
-			movaps xmm0, [eax +  0]                        // column 0 (Cx_)
-			movss  xmm4, [ebx +  0]SourceVertex.m_normal   // source vector x
-			movaps xmm1, [eax + 16]                        // column 1 (Cy_)
-			movss  xmm5, [ebx +  4]SourceVertex.m_normal   // source vector y
-			movaps xmm2, [eax + 32]                        // column 2 (Cz_)
-			movss  xmm6, [ebx +  8]SourceVertex.m_normal   // source vector z
-
-			shufps xmm4, xmm4, 0      // x -> x.x.x.x
-			shufps xmm5, xmm5, 0      // y -> y.y.y.y
-			shufps xmm6, xmm6, 0      // z -> z.z.z.z
-
-			mulps  xmm0, xmm4         // col0 * x.x.x.x
-			mulps  xmm1, xmm5         // col1 * y.y.y.y
-			mulps  xmm2, xmm6         // col2 * z.z.z.z
-
-			addps  xmm0, xmm1         // col0*x + col1*y
-			addps  xmm0, xmm2         // col0*x + col1*y + col2*z
-
-			movaps [esi]fill_vb_work.normal, xmm0           // save result out
-			///////////////////////////////////////////////////////////////
-
-			///////////////////////////////////////////////////////////////
-			//-- Write out render geometry.
-			//*(Vector *)(w->viter +  0) = w->position;
-			//*(Vector *)(w->viter + 12) = w->normal;
-			mov         edi, [esi]fill_vb_work.viter        // destination pointer
-
-			// position and normal
-			mov         ecx, [esi + 0]fill_vb_work.position // xf'ed position.x
-			mov         edx, [esi + 4]fill_vb_work.position // xf'ed position.y
-			mov         [edi + 0], ecx
-			mov         [edi + 4], edx
-			mov         ecx, [esi + 8]fill_vb_work.position // xf'ed position.z
-			mov         edx, [esi + 0]fill_vb_work.normal   // xf'ed normal.x
-			mov         [edi + 8], ecx
-			mov         [edi +12], edx
-			mov         ecx, [esi + 4]fill_vb_work.normal   // xf'ed normal.y
-			mov         edx, [esi + 8]fill_vb_work.normal   // xf'ed normal.z
-			mov         [edi +16], ecx
-			mov         [edi +20], edx
-			///////////////////////////////////////////////////////////////
-
-			// ------------------------------
-			//w->m_sourceVectors++;
-			//w->viter+=w->vertexSize;
-			//
-			// edi contains viter from above
-			add         edi, [esi]fill_vb_work.vertexSize
-			mov         [esi]fill_vb_work.viter, edi
-
-			mov         ebx, [esi]fill_vb_work.m_sourceVectors      // current vertex pointer
-			lea         ebx, BYTE PTR [ebx + SOURCE_VERTEX_SIZE]
-			mov         [esi]fill_vb_work.m_sourceVectors, ebx
-			// ------------------------------
-
-		// end of main loop body
-		// ------------------------------
-	main_loop_test:
-		//while (w->m_sourceVectors!=w->m_sourceVectorsEnd)
-		cmp            ebx, [esi]fill_vb_work.m_sourceVectorsEnd
-		jnz            main_loop_top
-
-		// -----------------------------------
-		// restore mxcsr
-		ldmxcsr mxcsrSave
-		// -----------------------------------
-	}
-	//--------------------------------------------------------------------------------------------
-}
+// Reference hard skinning.
 // ============================================================================
-#endif
 
 void fill_vb_work::fillDot3VertexBufferHard() const
 {
@@ -46,6 +46,9 @@ public:
 
 	static void install();
 
+	static int   getNumberOfSkinnedVerticesLastFrame();
+	static float getSkinningPhaseTimeLastFrame();
+
 public:
 
 	SoftwareBlendSkeletalShaderPrimitive(class SkeletalAppearance2 &appearance, int lodIndex, const MeshConstructionHelper &mesh, int shaderIndex);
@@ -80,6 +83,8 @@ public:
 	void                        setEveryOtherFrameSkinningEnabled(bool enabled);
 	bool                        getEveryOtherFrameSkinningEnabled() const;
 
+	void                        queueSkinning() const;
+
 public:
 
 	struct Dot3Vector;
@@ -96,6 +101,9 @@ private:
 private:
 
 	static void remove();
+	static void runSkinningPhase();
+	static void runSkinningJob(void *context, int jobIndex);
+	static void reportSkinning();
 
 private:
 
@@ -104,7 +112,9 @@ private:
 	void buildIndexBufferAndRenderCommands(const MeshConstructionHelper &mesh, int perShaderDataIndex);
 	void fillConstantVertexBufferData(const MeshConstructionHelper &mesh, int shaderIndex, VertexBufferWriteIterator &destVertexIt);
 
+	bool needsSkinning() const;
 	void skinData(int transformCount, const PoseModelTransform *transformArray, VertexBufferWriteIterator &iterator) const;
+	void performSkinning(int transformCount, const PoseModelTransform *transformArray, VertexBufferWriteIterator &iterator) const;
 
 	void fillVertexBuffer(int transformCount, const PoseModelTransform *transformArray, VertexBufferWriteIterator &destVertexIt) const;
 
@@ -154,6 +164,8 @@ private:
 
 	SkinningMode            m_skinningMode;
 	mutable bool            m_hasBeenSkinned;
+	mutable bool            m_skinningQueued;
+	mutable int             m_skinningPhaseFrameNumber;
 
 	int                     m_dot3TextureCoordinateSetIndex;
 	bool                    m_hasDot3Vector;
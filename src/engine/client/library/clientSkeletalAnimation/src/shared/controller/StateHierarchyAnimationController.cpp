@@ -169,6 +169,13 @@ void StateHierarchyAnimationController::evaluateTransformComponents(int localTra
 
 // ----------------------------------------------------------------------
 
+void StateHierarchyAnimationController::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	m_trackAnimationController->evaluateAllTransformComponents(rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
 void StateHierarchyAnimationController::getObjectLocomotion(Quaternion &rotation, Vector &translation) const
 {
 	m_trackAnimationController->getObjectLocomotion(rotation, translation);
@@ -45,6 +45,7 @@ public:
 	virtual void                           alter(real time);
 
 	virtual void                           evaluateTransformComponents(int localTransformIndex, Quaternion &rotation, Vector &translation);
+	virtual void                           evaluateAllTransformComponents(Quaternion *rotations, Vector *translations);
 	virtual void                           getObjectLocomotion(Quaternion &rotation, Vector &translation) const;
 
 	virtual int                            addAnimationMessageListener(AnimationMessageCallback callback, void *context);
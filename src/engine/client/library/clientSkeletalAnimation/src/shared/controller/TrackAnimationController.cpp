@@ -809,6 +809,19 @@ void TrackAnimationController::evaluateTransformComponents(int localTransformInd
 
 // ----------------------------------------------------------------------
 
+void TrackAnimationController::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	PROFILER_AUTO_BLOCK_DEFINE("Animation::evaluateAllComponents");
+
+	//-- get the root track
+	Track &track = getTrack(ms_logicalRootTrackId);
+
+	//-- return the operations
+	track.evaluateAllTransformComponents(rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
 void TrackAnimationController::getObjectLocomotion(Quaternion &rotation, Vector &translation) const
 {
 	//-- get the root track
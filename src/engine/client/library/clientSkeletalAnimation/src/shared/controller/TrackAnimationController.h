@@ -139,6 +139,7 @@ public:
 	virtual void                           alter(float time);
 
 	virtual void                           evaluateTransformComponents(int localTransformIndex, Quaternion &rotation, Vector &translation);
+	virtual void                           evaluateAllTransformComponents(Quaternion *rotations, Vector *translations);
 	virtual void                           getObjectLocomotion(Quaternion &rotation, Vector &translation) const;
 
 	virtual TrackAnimationController      *asTrackAnimationController();
@@ -75,6 +75,24 @@ void TrackAnimationController::PriorityBlendAnimation::startNewCycle()
 	DEBUG_WARNING(true, ("PriorityBlendAnimation: unexpected: calling startNewCycle()."));
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Hand a cached pose to the track played for every transform so it keeps
+ * its most recent values, which are blended out of after its animation ends.
+ */
+
+void TrackAnimationController::PriorityBlendAnimation::receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations)
+{
+	int const animationIndex = getPoseCacheAnimationIndex();
+	if (animationIndex < 0)
+		return;
+
+	Track *const track = (animationIndex == 0) ? m_track1 : m_track2;
+	NOT_NULL(track);
+
+	track->receiveCachedPose(transformCount, rotations, translations);
+}
+
 // ======================================================================
 // class TrackAnimationController::PriorityBlendAnimation: PROTECTED
 // ======================================================================
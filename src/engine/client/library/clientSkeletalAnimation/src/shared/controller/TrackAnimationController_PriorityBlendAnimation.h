@@ -28,6 +28,7 @@ public:
 	const Track                     &getLocomotionPriorityTrack() const;
 
 	virtual void                     startNewCycle();
+	virtual void                     receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations);
 
 protected:
 
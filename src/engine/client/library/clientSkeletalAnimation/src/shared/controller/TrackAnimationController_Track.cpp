@@ -11,11 +11,13 @@
 
 #include "clientGraphics/GraphicsDebugFlags.h"
 #include "clientSkeletalAnimation/ConfigClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/PoseCache.h"
 #include "clientSkeletalAnimation/SkeletalAnimation.h"
 #include "clientSkeletalAnimation/TimedBlendSkeletalAnimation.h"
 #include "clientSkeletalAnimation/TrackAnimationController_PhysicalTrackTemplate.h"
 #include "clientSkeletalAnimation/TrackAnimationController_PriorityBlendAnimation.h"
 #include "clientSkeletalAnimation/TransformNameMap.h"
+#include "sharedDebug/PerformanceTimer.h"
 #include "sharedDebug/Profiler.h"
 #include "sharedFoundation/PointerDeleter.h"
 #include "sharedMath/Vector.h"
@@ -259,6 +261,92 @@ void TrackAnimationController::Track::evaluateTransformComponents(int transformI
 
 // ----------------------------------------------------------------------
 
+void TrackAnimationController::Track::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	NP_PROFILER_AUTO_BLOCK_DEFINE("TrackAnimationController::Track::evaluateAllTransformComponents");
+
+	NOT_NULL(rotations);
+	NOT_NULL(translations);
+
+	int const transformCount = static_cast<int>(m_mostRecentRotations->size());
+
+	if (m_currentAnimation)
+	{
+		if (m_currentAnimation->getTransformCount() == transformCount)
+		{
+			//-- Skeletons built from the same template that play the same animations at the same point share their pose.
+			PoseCache::Key key;
+			key.addPointer(&m_controller.getTransformNameMap());
+
+			//-- Only a tree whose key is used is snapped, everything else plays at its exact time.
+			bool cacheable = false;
+			if (PoseCache::isEnabled())
+			{
+				PoseCache::beginSnapping();
+				cacheable = m_currentAnimation->addPoseCacheKey(key);
+				if (!cacheable)
+					PoseCache::endSnapping();
+			}
+
+			if (cacheable && PoseCache::fetchPose(key, transformCount, rotations, translations))
+			{
+				//-- The tracks below this one were not evaluated, give them the pose to blend out of.
+				m_currentAnimation->receiveCachedPose(transformCount, rotations, translations);
+			}
+			else
+			{
+				PerformanceTimer timer;
+				timer.start();
+
+				m_currentAnimation->evaluateAllTransformComponents(rotations, translations);
+
+				timer.stop();
+				if (cacheable)
+					PoseCache::storePose(key, transformCount, rotations, translations, timer.getElapsedTime());
+			}
+
+			if (cacheable)
+				PoseCache::endSnapping();
+
+			//-- Keep track of the most recently evaluated data.  See evaluateTransformComponents().
+			IGNORE_RETURN(std::copy(rotations, rotations + transformCount, m_mostRecentRotations->begin()));
+			IGNORE_RETURN(std::copy(translations, translations + transformCount, m_mostRecentTranslations->begin()));
+		}
+		else
+		{
+			for (int i = 0; i < transformCount; ++i)
+				evaluateTransformComponents(i, rotations[i], translations[i]);
+		}
+	}
+	else
+	{
+		IGNORE_RETURN(std::copy(m_mostRecentRotations->begin(), m_mostRecentRotations->end(), rotations));
+		IGNORE_RETURN(std::copy(m_mostRecentTranslations->begin(), m_mostRecentTranslations->end(), translations));
+	}
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Keep a pose served by the PoseCache as this track's most recent values,
+ * as if the track had evaluated it.
+ */
+
+void TrackAnimationController::Track::receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations)
+{
+	NOT_NULL(rotations);
+	NOT_NULL(translations);
+
+	if (!m_currentAnimation || (transformCount != static_cast<int>(m_mostRecentRotations->size())))
+		return;
+
+	IGNORE_RETURN(std::copy(rotations, rotations + transformCount, m_mostRecentRotations->begin()));
+	IGNORE_RETURN(std::copy(translations, translations + transformCount, m_mostRecentTranslations->begin()));
+
+	m_currentAnimation->receiveCachedPose(transformCount, rotations, translations);
+}
+
+// ----------------------------------------------------------------------
+
 void TrackAnimationController::Track::getMostRecentAnimationTransformComponents(int transformIndex, Quaternion &rotation, Vector &translation)
 {
 	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, transformIndex, static_cast<int>(m_mostRecentRotations->size()));
@@ -35,6 +35,8 @@ public:
 
 	void               alter(float deltaTime, bool processAnimationMessages = true);
 	void               evaluateTransformComponents(int transformIndex, Quaternion &rotation, Vector &translation);
+	void               evaluateAllTransformComponents(Quaternion *rotations, Vector *translations);
+	void               receiveCachedPose(int transformCount, Quaternion const *rotations, Vector const *translations);
 	void               getMostRecentAnimationTransformComponents(int transformIndex, Quaternion &rotation, Vector &translation);
 
 	int                playAnimation(SkeletalAnimation *skeletalAnimation, PlayMode playMode, bool loop, BlendMode transitionBlendMode, float blendInTime, AnimationNotification *notification);
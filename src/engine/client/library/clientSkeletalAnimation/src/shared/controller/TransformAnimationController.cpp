@@ -12,6 +12,7 @@
 #include "clientSkeletalAnimation/AnimationEnvironment.h"
 #include "clientSkeletalAnimation/SkeletalAnimationDebugging.h"
 #include "clientSkeletalAnimation/SkeletalAppearance2.h"
+#include "clientSkeletalAnimation/TransformNameMap.h"
 #include "sharedFoundation/CrcLowerString.h"
 #include "sharedFoundation/PointerDeleter.h"
 #include "sharedMath/Quaternion.h"
@@ -312,6 +313,28 @@ TransformAnimationController::Bookmark *TransformAnimationController::createBook
 	return 0;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Evaluate the rotation and translation, relative to bind pose, for every
+ * transform under control of this animation controller.
+ *
+ * This default implementation calls evaluateTransformComponents() for each
+ * transform in the controller's TransformNameMap.
+ *
+ * @param rotations     the rotation of each transform is returned here.
+ * @param translations  the translation of each transform is returned here.
+ */
+
+void TransformAnimationController::evaluateAllTransformComponents(Quaternion *rotations, Vector *translations)
+{
+	NOT_NULL(rotations);
+	NOT_NULL(translations);
+
+	int const transformCount = getTransformNameMap().getTransformCount();
+	for (int i = 0; i < transformCount; ++i)
+		evaluateTransformComponents(i, rotations[i], translations[i]);
+}
+
 // ----------------------------------------------------------------------
 /**
  * Restore this animation controller instance to the state previously
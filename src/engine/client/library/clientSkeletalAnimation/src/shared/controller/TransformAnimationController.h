@@ -78,6 +78,7 @@ public:
 	 * @param translation          the translation (relative to bind pose) is returned in this parameter.
 	 */
 	virtual void  evaluateTransformComponents(int localTransformIndex, Quaternion &rotation, Vector &translation) = 0;
+	virtual void  evaluateAllTransformComponents(Quaternion *rotations, Vector *translations);
 
 	/**
 	 * Retrieve the Object rotation and translation that has occurred, due to animation, 
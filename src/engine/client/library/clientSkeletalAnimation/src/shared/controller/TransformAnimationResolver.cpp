@@ -13,6 +13,7 @@
 #include "clientSkeletalAnimation/AnimationNotification.h"
 #include "clientSkeletalAnimation/AnimationStateNameIdManager.h"
 #include "clientSkeletalAnimation/BasicSkeletonTemplate.h"
+#include "clientSkeletalAnimation/ConfigClientSkeletalAnimation.h"
 #include "clientSkeletalAnimation/SkeletalAppearance2.h"
 #include "clientSkeletalAnimation/SkeletalAppearanceTemplate.h"
 #include "clientSkeletalAnimation/SkeletonTemplate.h"
@@ -75,6 +76,7 @@ public:
 	void  alter(float deltaTime);
 
 	void  evaluateTransformComponents(int globalTransformIndex, Quaternion &rotation, Vector &translation);
+	bool  evaluateAllTransformComponents(Quaternion *globalRotations, Vector *globalTranslations, int8 *globalEvaluatedFlags);
 	void  getObjectLocomotion(Quaternion &rotation, Vector &translation) const;
 
 	void  setDestinationState(const AnimationStatePath &destinationStatePath, bool skipTraversal, bool skipWithDelay);
@@ -311,6 +313,51 @@ void TransformAnimationResolver::SkeletonTemplateData::evaluateTransformComponen
 	}
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Evaluate all of this skeleton template's transforms in one call.
+ *
+ * The arrays are indexed by global transform index.  Nothing is done if
+ * any of the transforms has already been evaluated or overridden since the
+ * last alter, since that would overwrite the override.
+ *
+ * @return  true if the transforms were evaluated; false if the caller must evaluate them one at a time.
+ */
+
+bool TransformAnimationResolver::SkeletonTemplateData::evaluateAllTransformComponents(Quaternion *globalRotations, Vector *globalTranslations, int8 *globalEvaluatedFlags)
+{
+	int const transformCount = getTransformCount();
+	if (transformCount <= 0)
+		return false;
+
+	Quaternion *const rotations      = globalRotations + m_firstGlobalTransformIndex;
+	Vector *const     translations   = globalTranslations + m_firstGlobalTransformIndex;
+	int8 *const       evaluatedFlags = globalEvaluatedFlags + m_firstGlobalTransformIndex;
+
+	for (int i = 0; i < transformCount; ++i)
+	{
+		if (evaluatedFlags[i])
+			return false;
+	}
+
+	if (m_animationController)
+	{
+		if (m_animationController->getTransformNameMap().getTransformCount() != transformCount)
+			return false;
+
+		m_animationController->evaluateAllTransformComponents(rotations, translations);
+	}
+	else
+	{
+		//-- No animation controller, return no delta from bind pose.
+		std::fill(rotations, rotations + transformCount, Quaternion::identity);
+		std::fill(translations, translations + transformCount, Vector::zero);
+	}
+
+	memset(evaluatedFlags, 1, static_cast<size_t>(transformCount));
+	return true;
+}
+
 // ----------------------------------------------------------------------
 
 void TransformAnimationResolver::SkeletonTemplateData::getObjectLocomotion(Quaternion &rotation, Vector &translation) const
@@ -505,6 +552,12 @@ TransformAnimationResolver::TransformAnimationResolver(const SkeletalAppearanceT
 	m_translations(0),
 	m_transformEvaluatedFlags(0),
 	m_mostRecentAlterElapsedTime(0.0f),
+	m_sourceRotations(0),
+	m_sourceTranslations(0),
+	m_targetRotations(0),
+	m_targetTranslations(0),
+	m_interpolationTargetValid(false),
+	m_alterSkipped(false),
 	m_mostRecentAnimationStatePath(),
 	m_callbackInfoVector()
 {
@@ -520,6 +573,11 @@ TransformAnimationResolver::TransformAnimationResolver(const SkeletalAppearanceT
 
 TransformAnimationResolver::~TransformAnimationResolver()
 {
+	delete m_targetTranslations;
+	delete m_targetRotations;
+	delete m_sourceTranslations;
+	delete m_sourceRotations;
+
 	delete [] m_transformEvaluatedFlags;
 	delete m_translations;
 	delete m_rotations;
@@ -615,6 +673,9 @@ void TransformAnimationResolver::specifySkeletonTemplates(const SkeletonTemplate
 		startingGlobalTransformIndex = (*it)->setFirstGlobalTransformIndex(startingGlobalTransformIndex);
 	}
 
+	//-- The interpolation poses no longer match the skeleton.
+	m_interpolationTargetValid = false;
+
 	//-- Keep track of transform count.
 	const bool sizeChanged = (startingGlobalTransformIndex != m_transformCount);
 	m_transformCount       = startingGlobalTransformIndex;
@@ -692,11 +753,16 @@ void TransformAnimationResolver::getTransformComponents(int transformIndex, Quat
 		getSkeletonTemplateData(transformIndex, stData);
 		NOT_NULL(stData);
 
-		// Evaluate the transform components.
-		stData->evaluateTransformComponents(transformIndex, (*m_rotations)[static_cast<QuaternionVector::size_type>(transformIndex)], (*m_translations)[static_cast<VectorVector::size_type>(transformIndex)]);
+		// Evaluate all of the skeleton template's transform components at once, which marks them as evaluated.
+		bool const evaluatedAll = !ConfigClientSkeletalAnimation::getDisableBatchedAnimationEvaluation() && stData->evaluateAllTransformComponents(&(*m_rotations)[0], &(*m_translations)[0], m_transformEvaluatedFlags);
+		if (!evaluatedAll)
+		{
+			// Evaluate the transform components.
+			stData->evaluateTransformComponents(transformIndex, (*m_rotations)[static_cast<QuaternionVector::size_type>(transformIndex)], (*m_translations)[static_cast<VectorVector::size_type>(transformIndex)]);
 
-		// Mark transform as evaluated since last alter.
-		m_transformEvaluatedFlags[transformIndex] = 1;
+			// Mark transform as evaluated since last alter.
+			m_transformEvaluatedFlags[transformIndex] = 1;
+		}
 	}
 
 	//-- Return evaluated components.
@@ -813,6 +879,114 @@ void TransformAnimationResolver::alter(float deltaTime)
 
 	//-- Save the most recent alter elapsed time so other entities (e.g. skeleton) can learn about it.
 	m_mostRecentAlterElapsedTime = deltaTime;
+
+	//-- A regular alter ends any interpolation.
+	m_interpolationTargetValid = false;
+	m_alterSkipped             = false;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Alter the animation controllers and start interpolating towards the
+ * resulting pose.
+ *
+ * Used for appearances that do not alter every frame.  The pose is shown
+ * one update late: this call shows the pose of the previous update, and
+ * subsequent skipAlter() calls blend from it to the pose evaluated here.
+ * This keeps the motion smooth at the cost of one update interval of lag.
+ *
+ * @param deltaTime  the time elapsed since the previous alter.
+ */
+
+void TransformAnimationResolver::alterWithInterpolation(float deltaTime)
+{
+	NP_PROFILER_AUTO_BLOCK_DEFINE("TransformAnimationResolver::alterWithInterpolation");
+
+	if (!m_rotations || !m_translations || (m_transformCount <= 0))
+	{
+		alter(deltaTime);
+		return;
+	}
+
+	QuaternionVector::size_type const transformCount = static_cast<QuaternionVector::size_type>(m_transformCount);
+
+	if (!m_sourceRotations)
+	{
+		m_sourceRotations    = new QuaternionVector();
+		m_sourceTranslations = new VectorVector();
+		m_targetRotations    = new QuaternionVector();
+		m_targetTranslations = new VectorVector();
+	}
+
+	//-- The previous target becomes the new source.  Without one, start from the current pose.
+	if (m_interpolationTargetValid && (m_targetRotations->size() == transformCount))
+	{
+		m_sourceRotations->swap(*m_targetRotations);
+		m_sourceTranslations->swap(*m_targetTranslations);
+	}
+	else
+	{
+		evaluateAllTransforms();
+		*m_sourceRotations    = *m_rotations;
+		*m_sourceTranslations = *m_translations;
+	}
+
+	//-- Alter the controllers and capture the new pose as the target.
+	alter(deltaTime);
+
+	evaluateAllTransforms();
+	*m_targetRotations    = *m_rotations;
+	*m_targetTranslations = *m_translations;
+
+	//-- Show the source pose this frame.
+	*m_rotations    = *m_sourceRotations;
+	*m_translations = *m_sourceTranslations;
+
+	m_interpolationTargetValid = true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Leave the animation controllers untouched this frame.
+ *
+ * If alterWithInterpolation() set up a target pose, the pose is blended
+ * from the source pose towards it.  Otherwise the current pose is held.
+ * Animation driven locomotion is not reported for skipped frames; the
+ * next alter accounts for the skipped time.
+ *
+ * @param deltaTime              the time elapsed this frame.
+ * @param interpolationFraction  how far to blend from the source pose to
+ *                               the target pose, in the range [0, 1].
+ */
+
+void TransformAnimationResolver::skipAlter(float deltaTime, float interpolationFraction)
+{
+	NP_PROFILER_AUTO_BLOCK_DEFINE("TransformAnimationResolver::skipAlter");
+
+	//-- Transform modifiers still run every frame, so keep their elapsed time current.
+	m_mostRecentAlterElapsedTime = deltaTime;
+	m_alterSkipped               = true;
+
+	if (!m_interpolationTargetValid || !m_rotations || !m_translations)
+		return;
+
+	QuaternionVector::size_type const transformCount = static_cast<QuaternionVector::size_type>(m_transformCount);
+	if ((m_targetRotations->size() != transformCount) || (m_sourceRotations->size() != transformCount))
+	{
+		m_interpolationTargetValid = false;
+		return;
+	}
+
+	float const fraction = clamp(0.0f, interpolationFraction, 1.0f);
+
+	for (QuaternionVector::size_type i = 0; i < transformCount; ++i)
+	{
+		(*m_rotations)[i]    = (*m_sourceRotations)[i].slerp((*m_targetRotations)[i], fraction);
+		(*m_translations)[i] = (*m_sourceTranslations)[i] + ((*m_targetTranslations)[i] - (*m_sourceTranslations)[i]) * fraction;
+	}
+
+	NOT_NULL(m_transformEvaluatedFlags);
+	memset(m_transformEvaluatedFlags, 1, static_cast<size_t>(m_transformCount));
 }
 
 // ----------------------------------------------------------------------
@@ -823,7 +997,16 @@ void TransformAnimationResolver::getObjectLocomotion(Quaternion &rotation, Vecto
 	// the body skeleton which will have locomotion.  Later we will need a way to indicate which .skt gives
 	// us locomotion.
 	if (m_skeletonTemplateDataVector && !m_skeletonTemplateDataVector->empty())
-		(*m_skeletonTemplateDataVector->front()).getObjectLocomotion(rotation, translation);
+	{
+		//-- The controllers still hold the locomotion of their last alter, which has already been applied.
+		if (m_alterSkipped)
+		{
+			rotation    = Quaternion::identity;
+			translation = Vector::zero;
+		}
+		else
+			(*m_skeletonTemplateDataVector->front()).getObjectLocomotion(rotation, translation);
+	}
 	else
 	{
 		//-- Apply translation at requested rate.  There is no animations to play, so failing to do this
@@ -1176,4 +1359,21 @@ void TransformAnimationResolver::getSkeletonTemplateData(int globalTransformInde
 	skeletonTemplateData = 0;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Make sure every transform has been evaluated since the last alter.
+ */
+
+void TransformAnimationResolver::evaluateAllTransforms() const
+{
+	Quaternion rotation;
+	Vector     translation;
+
+	for (int i = 0; i < m_transformCount; ++i)
+	{
+		if (!m_transformEvaluatedFlags[i])
+			getTransformComponents(i, rotation, translation);
+	}
+}
+
 // ======================================================================
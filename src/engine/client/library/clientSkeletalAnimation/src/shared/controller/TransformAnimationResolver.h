@@ -52,6 +52,8 @@ public:
 	void              copyTransformsFrom(const TransformAnimationResolver &sourceResolver);
 
 	void              alter(float deltaTime);
+	void              alterWithInterpolation(float deltaTime);
+	void              skipAlter(float deltaTime, float interpolationFraction);
 	float             getMostRecentAlterElapsedTime() const;
 	void              getObjectLocomotion(Quaternion &rotation, Vector &translation, float elapsedTime) const;
 
@@ -104,6 +106,7 @@ private:
 private:
 
 	void getSkeletonTemplateData(int globalTransformIndex, SkeletonTemplateData *& skeletonTemplateData) const;
+	void evaluateAllTransforms() const;
 
 	// disabled
 	TransformAnimationResolver();
@@ -135,6 +138,18 @@ private:
 
 	float                               m_mostRecentAlterElapsedTime;
 
+	/// The poses interpolated between by skipAlter(), created by the first alterWithInterpolation() call.
+	QuaternionVector                   *m_sourceRotations;
+	VectorVector                       *m_sourceTranslations;
+	QuaternionVector                   *m_targetRotations;
+	VectorVector                       *m_targetTranslations;
+
+	/// True if the target pose is the result of the most recent alter.
+	bool                                m_interpolationTargetValid;
+
+	/// True if the animation controllers were not altered this frame.
+	bool                                m_alterSkipped;
+
 	AnimationStatePath                  m_mostRecentAnimationStatePath;
 	CallbackInfoVector                  m_callbackInfoVector;
 };
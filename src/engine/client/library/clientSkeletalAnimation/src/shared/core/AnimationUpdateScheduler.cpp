@@ -0,0 +1,254 @@
+// ======================================================================
+//
+// AnimationUpdateScheduler.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "clientSkeletalAnimation/FirstClientSkeletalAnimation.h"
+#include "clientSkeletalAnimation/AnimationUpdateScheduler.h"
+
+#include "clientSkeletalAnimation/ConfigClientSkeletalAnimation.h"
+#include "sharedDebug/DebugFlags.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedFoundation/Os.h"
+#include "sharedObject/Object.h"
+
+#include <algorithm>
+
+// ======================================================================
+
+namespace AnimationUpdateSchedulerNamespace
+{
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct FrameStatistics
+	{
+		int   bucketCount[AnimationUpdateScheduler::B_count];
+		int   updateCount[AnimationUpdateScheduler::B_count];
+		int   forcedCount;
+		int   deferredCount;
+		float updateTime;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	void  remove();
+	void  rollFrame();
+	void  reportStatistics();
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	int const         cs_updateIntervals[AnimationUpdateScheduler::B_count] = { 1, 2, 4, 8 };
+	char const *const cs_bucketNames[AnimationUpdateScheduler::B_count]     = { "full", "half", "quarter", "eighth" };
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	bool                                             s_installed;
+	AnimationUpdateScheduler::ForceFullRateCallback  s_forceFullRateCallback;
+
+	bool                                             s_enabled;
+	bool                                             s_interpolationEnabled;
+	float                                            s_budgetMilliseconds;
+	bool                                             s_reportStatistics;
+
+	int                                              s_frameNumber;
+	FrameStatistics                                  s_currentFrame;
+	FrameStatistics                                  s_previousFrame;
+}
+
+using namespace AnimationUpdateSchedulerNamespace;
+
+// ======================================================================
+// namespace AnimationUpdateSchedulerNamespace
+// ======================================================================
+
+void AnimationUpdateSchedulerNamespace::remove()
+{
+	DEBUG_FATAL(!s_installed, ("AnimationUpdateScheduler not installed."));
+	s_installed = false;
+
+	DebugFlags::unregisterFlag(s_enabled);
+	DebugFlags::unregisterFlag(s_interpolationEnabled);
+	DebugFlags::unregisterFlag(s_reportStatistics);
+
+	s_forceFullRateCallback = NULL;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Start collecting statistics for a new frame when the frame number changes.
+ *
+ * Appearances are altered from the object update loop, so the first
+ * scheduleUpdate() call of a frame closes out the statistics of the
+ * previous one.
+ */
+
+void AnimationUpdateSchedulerNamespace::rollFrame()
+{
+	int const frameNumber = Os::getNumberOfUpdates();
+	if (frameNumber == s_frameNumber)
+		return;
+
+	s_frameNumber   = frameNumber;
+	s_previousFrame = s_currentFrame;
+	memset(&s_currentFrame, 0, sizeof(s_currentFrame));
+}
+
+// ----------------------------------------------------------------------
+
+void AnimationUpdateSchedulerNamespace::reportStatistics()
+{
+	DEBUG_REPORT_PRINT(true, ("-- AnimationUpdateScheduler %s\n", s_enabled ? "" : "(disabled)"));
+	DEBUG_REPORT_PRINT(true, ("  budget = %1.2f ms, used = %1.2f ms, deferred = %d, forced = %d\n", s_budgetMilliseconds, s_previousFrame.updateTime * 1000.0f, s_previousFrame.deferredCount, s_previousFrame.forcedCount));
+
+	for (int i = 0; i < AnimationUpdateScheduler::B_count; ++i)
+		DEBUG_REPORT_PRINT(true, ("  %-7s (1/%d): %3d appearances, %3d updated\n", cs_bucketNames[i], cs_updateIntervals[i], s_previousFrame.bucketCount[i], s_previousFrame.updateCount[i]));
+}
+
+// ======================================================================
+// class AnimationUpdateScheduler: PUBLIC STATIC
+// ======================================================================
+
+void AnimationUpdateScheduler::install()
+{
+	DEBUG_FATAL(s_installed, ("AnimationUpdateScheduler already installed."));
+
+	s_enabled              = ConfigClientSkeletalAnimation::getAnimationSchedulerEnable();
+	s_interpolationEnabled = ConfigClientSkeletalAnimation::getAnimationSchedulerInterpolate();
+	s_budgetMilliseconds   = ConfigClientSkeletalAnimation::getAnimationSchedulerBudgetMilliseconds();
+
+	s_frameNumber = -1;
+	memset(&s_currentFrame, 0, sizeof(s_currentFrame));
+	memset(&s_previousFrame, 0, sizeof(s_previousFrame));
+
+	DebugFlags::registerFlag(s_enabled, "ClientSkeletalAnimation/AnimationUpdateScheduler", "enabled");
+	DebugFlags::registerFlag(s_interpolationEnabled, "ClientSkeletalAnimation/AnimationUpdateScheduler", "interpolate");
+	DebugFlags::registerFlag(s_reportStatistics, "ClientSkeletalAnimation/AnimationUpdateScheduler", "reportStatistics", reportStatistics);
+
+	s_installed = true;
+	ExitChain::add(remove, "AnimationUpdateScheduler");
+}
+
+// ----------------------------------------------------------------------
+
+void AnimationUpdateScheduler::setForceFullRateCallback(ForceFullRateCallback callback)
+{
+	s_forceFullRateCallback = callback;
+}
+
+// ----------------------------------------------------------------------
+
+bool AnimationUpdateScheduler::isEnabled()
+{
+	return s_enabled;
+}
+
+// ----------------------------------------------------------------------
+
+void AnimationUpdateScheduler::setEnabled(bool enabled)
+{
+	s_enabled = enabled;
+}
+
+// ----------------------------------------------------------------------
+
+bool AnimationUpdateScheduler::getInterpolationEnabled()
+{
+	return s_interpolationEnabled;
+}
+
+// ----------------------------------------------------------------------
+
+float AnimationUpdateScheduler::getBudgetMilliseconds()
+{
+	return s_budgetMilliseconds;
+}
+
+// ----------------------------------------------------------------------
+
+void AnimationUpdateScheduler::setBudgetMilliseconds(float budgetMilliseconds)
+{
+	s_budgetMilliseconds = std::max(0.0f, budgetMilliseconds);
+}
+
+// ----------------------------------------------------------------------
+
+int AnimationUpdateScheduler::getUpdateInterval(Bucket bucket)
+{
+	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, static_cast<int>(bucket), static_cast<int>(B_count));
+	return cs_updateIntervals[bucket];
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Decide whether an appearance should alter its animation this frame.
+ *
+ * @param owner              the appearance's owner, or NULL if it has none.
+ *                           Appearances without an owner always run at full rate.
+ * @param visible            true if the appearance was rendered recently.
+ * @param screenFraction     the largest fraction of the screen the appearance
+ *                           covered during its most recent render.
+ * @param cameraDistance     the distance from the camera during its most recent render.
+ * @param framesSinceUpdate  the number of frames the appearance has skipped
+ *                           since it last altered its animation.
+ * @param updateInterval     returns the number of frames between updates for
+ *                           the bucket the appearance was assigned.
+ *
+ * @return  true if the appearance should alter its animation this frame.
+ */
+
+bool AnimationUpdateScheduler::scheduleUpdate(Object const *owner, bool visible, float screenFraction, float cameraDistance, int framesSinceUpdate, int &updateInterval)
+{
+	DEBUG_FATAL(!s_installed, ("AnimationUpdateScheduler not installed."));
+
+	rollFrame();
+
+	//-- Pick the bucket.  Either a large screen fraction or a short distance is enough to earn a rate.
+	bool const forced = !owner || (s_forceFullRateCallback && (*s_forceFullRateCallback)(*owner));
+
+	Bucket bucket = B_eighthRate;
+	if (forced)
+		bucket = B_fullRate;
+	else if (visible)
+	{
+		if ((screenFraction >= ConfigClientSkeletalAnimation::getAnimationSchedulerFullRateScreenFraction()) || (cameraDistance <= ConfigClientSkeletalAnimation::getAnimationSchedulerFullRateDistance()))
+			bucket = B_fullRate;
+		else if ((screenFraction >= ConfigClientSkeletalAnimation::getAnimationSchedulerHalfRateScreenFraction()) || (cameraDistance <= ConfigClientSkeletalAnimation::getAnimationSchedulerHalfRateDistance()))
+			bucket = B_halfRate;
+		else if ((screenFraction >= ConfigClientSkeletalAnimation::getAnimationSchedulerQuarterRateScreenFraction()) || (cameraDistance <= ConfigClientSkeletalAnimation::getAnimationSchedulerQuarterRateDistance()))
+			bucket = B_quarterRate;
+	}
+
+	updateInterval = cs_updateIntervals[bucket];
+
+	++s_currentFrame.bucketCount[bucket];
+	if (forced)
+		++s_currentFrame.forcedCount;
+
+	//-- Wait for the bucket's interval to elapse.
+	if (framesSinceUpdate + 1 < updateInterval)
+		return false;
+
+	//-- Defer due updates once the budget is spent, but never starve an appearance.
+	if (!forced && (s_currentFrame.updateTime * 1000.0f >= s_budgetMilliseconds) && (framesSinceUpdate + 1 < 2 * updateInterval))
+	{
+		++s_currentFrame.deferredCount;
+		return false;
+	}
+
+	++s_currentFrame.updateCount[bucket];
+	return true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Charge the time an appearance spent updating its animation against this frame's budget.
+ */
+
+void AnimationUpdateScheduler::addUpdateTime(float elapsedTime)
+{
+	s_currentFrame.updateTime += elapsedTime;
+}
+
+// ======================================================================
@@ -0,0 +1,68 @@
+// ======================================================================
+//
+// AnimationUpdateScheduler.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_AnimationUpdateScheduler_H
+#define INCLUDED_AnimationUpdateScheduler_H
+
+// ======================================================================
+
+class Object;
+
+// ======================================================================
+/**
+ * Decides how often each SkeletalAppearance2 ticks its animation controllers.
+ *
+ * Every appearance is put in a rate bucket each frame based on the screen
+ * fraction and camera distance recorded during its most recent render.
+ * Appearances that were not rendered recently use the lowest rate.  The
+ * game can force full rate for specific objects (player, target, combatants)
+ * through the force full rate callback.
+ *
+ * Updates are charged against a per-frame time budget.  Once the budget
+ * is spent, due updates are deferred, but never beyond twice the bucket's
+ * interval.  Forced appearances are never deferred.
+ */
+
+class AnimationUpdateScheduler
+{
+public:
+
+	enum Bucket
+	{
+		B_fullRate,
+		B_halfRate,
+		B_quarterRate,
+		B_eighthRate,
+
+		B_count
+	};
+
+	typedef bool (*ForceFullRateCallback)(Object const &object);
+
+public:
+
+	static void  install();
+
+	static void  setForceFullRateCallback(ForceFullRateCallback callback);
+
+	static bool  isEnabled();
+	static void  setEnabled(bool enabled);
+	static bool  getInterpolationEnabled();
+
+	static float getBudgetMilliseconds();
+	static void  setBudgetMilliseconds(float budgetMilliseconds);
+
+	static int   getUpdateInterval(Bucket bucket);
+
+	static bool  scheduleUpdate(Object const *owner, bool visible, float screenFraction, float cameraDistance, int framesSinceUpdate, int &updateInterval);
+	static void  addUpdateTime(float elapsedTime);
+
+};
+
+// ======================================================================
+
+#endif
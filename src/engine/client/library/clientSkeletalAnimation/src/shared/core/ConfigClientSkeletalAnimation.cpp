@@ -61,6 +61,29 @@ namespace
 	bool  s_skeletonSegmentSanityCheckerEnabled;
 	
 	bool  s_optimizeSkinnedIndexBuffers;
+	bool  s_disableSimdSkinning;
+	int   s_skinningThreadCount;
+	bool  s_disableBatchedAnimationEvaluation;
+	bool  s_disableFlatSkeletonHierarchy;
+
+	bool  s_animationSchedulerEnable;
+	bool  s_animationSchedulerInterpolate;
+	float s_animationSchedulerBudgetMilliseconds;
+	float s_animationSchedulerFullRateScreenFraction;
+	float s_animationSchedulerHalfRateScreenFraction;
+	float s_animationSchedulerQuarterRateScreenFraction;
+	float s_animationSchedulerFullRateDistance;
+	float s_animationSchedulerHalfRateDistance;
+	float s_animationSchedulerQuarterRateDistance;
+
+	bool  s_poseCacheEnable;
+	int   s_poseCacheMaxEntries;
+	float s_poseCacheFrameQuantum;
+
+	bool  s_meshConstructionCacheEnable;
+	int   s_meshConstructionCacheMaxEntries;
+	int   s_meshConstructionThreadCount;
+	float s_meshConstructionHitchMilliseconds;
 
 	float s_blendTime;
 }
@@ -141,6 +164,28 @@ void ConfigClientSkeletalAnimation::install()
 	KEY_BOOL      (skeletonSegmentSanityCheckerEnabled, false);
 	
 	KEY_BOOL      (optimizeSkinnedIndexBuffers, false);
+	KEY_BOOL      (disableSimdSkinning, false);
+	KEY_INT       (skinningThreadCount, 3);
+	KEY_BOOL      (disableBatchedAnimationEvaluation, false);
+	KEY_BOOL      (disableFlatSkeletonHierarchy, false);
+
+	KEY_BOOL      (animationSchedulerEnable, true);
+	KEY_BOOL      (animationSchedulerInterpolate, true);
+	KEY_FLOAT     (animationSchedulerBudgetMilliseconds, 2.0f);
+	KEY_FLOAT     (animationSchedulerFullRateScreenFraction,    4.0f / 20.0f);
+	KEY_FLOAT     (animationSchedulerHalfRateScreenFraction,    2.0f / 20.0f);
+	KEY_FLOAT     (animationSchedulerQuarterRateScreenFraction, 1.0f / 20.0f);
+	KEY_FLOAT     (animationSchedulerFullRateDistance,    16.0f);
+	KEY_FLOAT     (animationSchedulerHalfRateDistance,    32.0f);
+	KEY_FLOAT     (animationSchedulerQuarterRateDistance, 64.0f);
+	KEY_BOOL      (poseCacheEnable, true);
+	KEY_INT       (poseCacheMaxEntries, 256);
+	KEY_FLOAT     (poseCacheFrameQuantum, 0.5f);
+	KEY_BOOL      (meshConstructionCacheEnable, true);
+	KEY_INT       (meshConstructionCacheMaxEntries, 128);
+	KEY_INT       (meshConstructionThreadCount, 1);
+	KEY_FLOAT     (meshConstructionHitchMilliseconds, 8.0f);
+
 	KEY_FLOAT     (blendTime, 0.25f);
 #ifdef _DEBUG
 	char const *const compressionResponseFilename = ConfigFile::getKeyString("ClientSkeletalAnimation", "compressionResponseFilename", "");
@@ -365,6 +410,146 @@ bool ConfigClientSkeletalAnimation::getOptimizeSkinnedIndexBuffers()
 
 //----------------------------------------------------------------------
 
+bool ConfigClientSkeletalAnimation::getDisableSimdSkinning()
+{
+	return s_disableSimdSkinning;
+}
+
+//----------------------------------------------------------------------
+
+int ConfigClientSkeletalAnimation::getSkinningThreadCount()
+{
+	return s_skinningThreadCount;
+}
+
+//----------------------------------------------------------------------
+
+bool ConfigClientSkeletalAnimation::getDisableBatchedAnimationEvaluation()
+{
+	return s_disableBatchedAnimationEvaluation;
+}
+
+//----------------------------------------------------------------------
+
+bool ConfigClientSkeletalAnimation::getDisableFlatSkeletonHierarchy()
+{
+	return s_disableFlatSkeletonHierarchy;
+}
+
+//----------------------------------------------------------------------
+
+bool ConfigClientSkeletalAnimation::getAnimationSchedulerEnable()
+{
+	return s_animationSchedulerEnable;
+}
+
+//----------------------------------------------------------------------
+
+bool ConfigClientSkeletalAnimation::getAnimationSchedulerInterpolate()
+{
+	return s_animationSchedulerInterpolate;
+}
+
+//----------------------------------------------------------------------
+
+float ConfigClientSkeletalAnimation::getAnimationSchedulerBudgetMilliseconds()
+{
+	return s_animationSchedulerBudgetMilliseconds;
+}
+
+//----------------------------------------------------------------------
+
+float ConfigClientSkeletalAnimation::getAnimationSchedulerFullRateScreenFraction()
+{
+	return s_animationSchedulerFullRateScreenFraction;
+}
+
+//----------------------------------------------------------------------
+
+float ConfigClientSkeletalAnimation::getAnimationSchedulerHalfRateScreenFraction()
+{
+	return s_animationSchedulerHalfRateScreenFraction;
+}
+
+//----------------------------------------------------------------------
+
+float ConfigClientSkeletalAnimation::getAnimationSchedulerQuarterRateScreenFraction()
+{
+	return s_animationSchedulerQuarterRateScreenFraction;
+}
+
+//----------------------------------------------------------------------
+
+float ConfigClientSkeletalAnimation::getAnimationSchedulerFullRateDistance()
+{
+	return s_animationSchedulerFullRateDistance;
+}
+
+//----------------------------------------------------------------------
+
+float ConfigClientSkeletalAnimation::getAnimationSchedulerHalfRateDistance()
+{
+	return s_animationSchedulerHalfRateDistance;
+}
+
+//----------------------------------------------------------------------
+
+float ConfigClientSkeletalAnimation::getAnimationSchedulerQuarterRateDistance()
+{
+	return s_animationSchedulerQuarterRateDistance;
+}
+
+//----------------------------------------------------------------------
+
+bool ConfigClientSkeletalAnimation::getPoseCacheEnable()
+{
+	return s_poseCacheEnable;
+}
+
+//----------------------------------------------------------------------
+
+int ConfigClientSkeletalAnimation::getPoseCacheMaxEntries()
+{
+	return s_poseCacheMaxEntries;
+}
+
+//----------------------------------------------------------------------
+
+float ConfigClientSkeletalAnimation::getPoseCacheFrameQuantum()
+{
+	return s_poseCacheFrameQuantum;
+}
+
+//----------------------------------------------------------------------
+
+bool ConfigClientSkeletalAnimation::getMeshConstructionCacheEnable()
+{
+	return s_meshConstructionCacheEnable;
+}
+
+//----------------------------------------------------------------------
+
+int ConfigClientSkeletalAnimation::getMeshConstructionCacheMaxEntries()
+{
+	return s_meshConstructionCacheMaxEntries;
+}
+
+//----------------------------------------------------------------------
+
+int ConfigClientSkeletalAnimation::getMeshConstructionThreadCount()
+{
+	return s_meshConstructionThreadCount;
+}
+
+//----------------------------------------------------------------------
+
+float ConfigClientSkeletalAnimation::getMeshConstructionHitchMilliseconds()
+{
+	return s_meshConstructionHitchMilliseconds;
+}
+
+//----------------------------------------------------------------------
+
 bool ConfigClientSkeletalAnimation::getWarningTooManyLods()
 {
 	return s_warningTooManyLods;
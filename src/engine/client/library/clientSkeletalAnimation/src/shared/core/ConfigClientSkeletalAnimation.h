@@ -59,6 +59,29 @@ public:
 	static bool  getSkeletonSegmentSanityCheckerEnabled();
 
 	static bool  getOptimizeSkinnedIndexBuffers();
+	static bool  getDisableSimdSkinning();
+	static int   getSkinningThreadCount();
+	static bool  getDisableBatchedAnimationEvaluation();
+	static bool  getDisableFlatSkeletonHierarchy();
+
+	static bool  getAnimationSchedulerEnable();
+	static bool  getAnimationSchedulerInterpolate();
+	static float getAnimationSchedulerBudgetMilliseconds();
+	static float getAnimationSchedulerFullRateScreenFraction();
+	static float getAnimationSchedulerHalfRateScreenFraction();
+	static float getAnimationSchedulerQuarterRateScreenFraction();
+	static float getAnimationSchedulerFullRateDistance();
+	static float getAnimationSchedulerHalfRateDistance();
+	static float getAnimationSchedulerQuarterRateDistance();
+
+	static bool  getPoseCacheEnable();
+	static int   getPoseCacheMaxEntries();
+	static float getPoseCacheFrameQuantum();
+
+	static bool  getMeshConstructionCacheEnable();
+	static int   getMeshConstructionCacheMaxEntries();
+	static int   getMeshConstructionThreadCount();
+	static float getMeshConstructionHitchMilliseconds();
 
 	static bool getWarningTooManyLods();
 
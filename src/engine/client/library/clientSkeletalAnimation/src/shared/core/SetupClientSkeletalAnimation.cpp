@@ -16,8 +16,10 @@
 #include "clientSkeletalAnimation/AnimationNotification.h"
 #include "clientSkeletalAnimation/AnimationPostureMapper.h"
 #include "clientSkeletalAnimation/AnimationPriorityMap.h"
+#include "clientSkeletalAnimation/AnimationRecompressor.h"
 #include "clientSkeletalAnimation/AnimationStateNameIdManager.h"
 #include "clientSkeletalAnimation/AnimationStateHierarchyTemplateList.h"
+#include "clientSkeletalAnimation/AnimationUpdateScheduler.h"
 #include "clientSkeletalAnimation/BasicSkeletonTemplate.h"
 #include "clientSkeletalAnimation/CallbackAnimationNotification.h"
 #include "clientSkeletalAnimation/CharacterLodManager.h"
@@ -39,13 +41,17 @@
 #include "clientSkeletalAnimation/LogicalAnimationTableTemplate.h"
 #include "clientSkeletalAnimation/LogicalAnimationTableTemplateList.h"
 #include "clientSkeletalAnimation/LookAtTransformModifier.h"
+#include "clientSkeletalAnimation/MeshConstructionCache.h"
 #include "clientSkeletalAnimation/MeshGeneratorTemplateList.h"
 #include "clientSkeletalAnimation/OcclusionZoneSet.h"
 #include "clientSkeletalAnimation/OwnerProxyShader.h"
 #include "clientSkeletalAnimation/OwnerProxyShaderTemplate.h"
+#include "clientSkeletalAnimation/PoseCache.h"
 #include "clientSkeletalAnimation/PriorityBlendAnimation.h"
 #include "clientSkeletalAnimation/PriorityBlendAnimationTemplate.h"
 #include "clientSkeletalAnimation/ProxySkeletalAnimationTemplate.h"
+#include "clientSkeletalAnimation/QuantizedKeyframeAnimation.h"
+#include "clientSkeletalAnimation/QuantizedKeyframeAnimationTemplate.h"
 #include "clientSkeletalAnimation/ShowAttachedObjectAction.h"
 #include "clientSkeletalAnimation/ShowAttachedObjectActionTemplate.h"
 #include "clientSkeletalAnimation/SinglePrioritySkeletalAnimation.h"
@@ -71,6 +77,10 @@
 #include "clientSkeletalAnimation/TransformMaskList.h"
 #include "clientSkeletalAnimation/YawSkeletalAnimationTemplate.h"
 #include "sharedDebug/InstallTimer.h"
+#include "sharedFoundation/ConfigFile.h"
+
+#include <stdlib.h>
+#include <string.h>
 
 // ======================================================================
 
@@ -142,6 +152,8 @@ void SetupClientSkeletalAnimation::install(Data const &data)
 	CompressedKeyframeAnimation::install();
 	KeyframeSkeletalAnimationTemplate::install();
 	KeyframeSkeletalAnimation::install();
+	QuantizedKeyframeAnimationTemplate::install();
+	QuantizedKeyframeAnimation::install();
 	ProxySkeletalAnimationTemplate::install();
 	DirectionSkeletalAnimationTemplate::install();
 	DirectionSkeletalAnimation::install();
@@ -165,6 +177,7 @@ void SetupClientSkeletalAnimation::install(Data const &data)
 	SkeletalMeshGenerator::install();
 	SkeletalMeshGeneratorTemplate::install();
 	LodMeshGeneratorTemplate::install(data.allowLod0Skipping);
+	MeshConstructionCache::install();
 
 	AnimationMessageActionTemplate::install();
 	ShowAttachedObjectAction::install();
@@ -190,6 +203,18 @@ void SetupClientSkeletalAnimation::install(Data const &data)
 	TargetPitchTransformModifier::install();
 
 	CharacterLodManager::install();
+	AnimationUpdateScheduler::install();
+	PoseCache::install();
+
+#ifdef _DEBUG
+	//-- The recompressor loads animations through the template list, so it can only run once everything above is installed.
+	char const *const recompressionResponseFilename = ConfigFile::getKeyString("ClientSkeletalAnimation", "recompressionResponseFilename", "");
+	if (strlen(recompressionResponseFilename) > 0)
+	{
+		AnimationRecompressor::recompressAnimations(recompressionResponseFilename);
+		exit(0);
+	}
+#endif
 }
 
 // ======================================================================
@@ -514,6 +514,8 @@ ClientProceduralTerrainAppearance::ClientProceduralTerrainAppearance (const Proc
 
 ClientProceduralTerrainAppearance::~ClientProceduralTerrainAppearance ()
 {
+	waitForFloraGather ();
+
 	m_levelOfDetail->removeAllObjectsFromWorld(getChunkTree()->getTopNode());
 
 	delete m_levelOfDetail;
@@ -855,6 +857,8 @@ void ClientProceduralTerrainAppearance::createChunk (const int x, const int z, c
 	if (findChunk (x, z, chunkSize))
 		return;
 
+	waitForFloraGather ();
+
 	// build the chunk immediately
 	ClientChunk* chunk = createClientChunk(x, z, chunkSize, hasLargerNeighborFlags);
 	createFlora (chunk);
@@ -869,6 +873,9 @@ float ClientProceduralTerrainAppearance::alter (const float elapsedTime)
 {
 	PROFILER_AUTO_BLOCK_DEFINE ("ClientProceduralTerrainAppearance::alter");
 
+	//-- The flora gathers read the chunk tree, which is about to change
+	waitForFloraGather ();
+
 	//-- Chain up
 	ProceduralTerrainAppearance::alter (elapsedTime);
 
@@ -905,6 +912,13 @@ float ClientProceduralTerrainAppearance::alter (const float elapsedTime)
 
 //-------------------------------------------------------------------
 
+void ClientProceduralTerrainAppearance::waitForFloraGather () const
+{
+	std::for_each (m_floraManagerList->begin (), m_floraManagerList->end (), VoidMemberFunction (&ClientRadialFloraManager::waitForGather));
+}
+
+//-------------------------------------------------------------------
+
 void ClientProceduralTerrainAppearance::calculateLod () const
 {
 	//-- we at least need a camera
@@ -1557,6 +1571,8 @@ void ClientProceduralTerrainAppearance::createRadarShader (const Vector& center,
 
 void ClientProceduralTerrainAppearance::purgeChunks ()
 {
+	waitForFloraGather ();
+
 	m_requestCriticalSection.enter();
 
 	REPORT_LOG_PRINT (m_totalNumberOfChunksCreated, ("average chunk create: %1.3f generate, %1.3f client\n", m_totalChunkGenerationTime / m_totalNumberOfChunksCreated, m_totalChunkCreationTime / m_totalNumberOfChunksCreated));
@@ -1918,6 +1934,8 @@ void ClientProceduralTerrainAppearance::addChunk (Chunk* const chunk, int /*chun
 {
 	verifyChunk (chunk);
 
+	waitForFloraGather ();
+
 	const float mapWidthInMeters = proceduralTerrainAppearanceTemplate->getMapWidthInMeters ();
 
 	IGNORE_RETURN (getChunkTree ()->addChunk (chunk, static_cast<int> (mapWidthInMeters / chunk->getChunkWidthInMeters ())));
@@ -328,6 +328,7 @@ private:
 	const LevelOfDetail& getLevelOfDetail () const;
 	
 	void                 calculateLod () const;
+	void                 waitForFloraGather () const;
 
 private:
 
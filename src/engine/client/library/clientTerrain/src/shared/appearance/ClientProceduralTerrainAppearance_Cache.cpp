@@ -101,9 +101,9 @@ namespace CacheNamespace
 
 	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	Array2d<Vector>* localCreateNormalMap (const int width, const int height)
+	Array2d<uint32>* localCreateNormalMap (const int width, const int height)
 	{
-		Array2d<Vector>* const map = new Array2d<Vector>;
+		Array2d<uint32>* const map = new Array2d<uint32>;
 		map->allocate (width, height);
 
 		return map;
@@ -352,12 +352,12 @@ void ClientProceduralTerrainAppearance::Cache::destroyEnvironmentMap (Array2d<En
 
 //-------------------------------------------------------------------
 
-Array2d<Vector>* ClientProceduralTerrainAppearance::Cache::createNormalMap (int width, int height)
+Array2d<uint32>* ClientProceduralTerrainAppearance::Cache::createNormalMap (int width, int height)
 {
 	DEBUG_FATAL (!ms_installed, ("not installed"));
 	DEBUG_FATAL (!ms_locked, ("not locked"));
 
-	Array2d<Vector>* map = 0;
+	Array2d<uint32>* map = 0;
 
 	//-- just take one off the list
 	if (!ms_normalMapList.empty ())
@@ -379,7 +379,7 @@ Array2d<Vector>* ClientProceduralTerrainAppearance::Cache::createNormalMap (int
 
 //-------------------------------------------------------------------
 
-void ClientProceduralTerrainAppearance::Cache::destroyNormalMap (Array2d<Vector>* map)
+void ClientProceduralTerrainAppearance::Cache::destroyNormalMap (Array2d<uint32>* map)
 {
 	DEBUG_FATAL (!ms_installed, ("not installed"));
 	DEBUG_FATAL (!ms_locked, ("not locked"));
@@ -26,7 +26,7 @@ public:
 	typedef stdvector<Array2d<FloraGroup::Info>*>::fwd       FloraGroupList;
 	typedef stdvector<Array2d<RadialGroup::Info>*>::fwd      RadialGroupList;
 	typedef stdvector<Array2d<EnvironmentGroup::Info>*>::fwd EnvironmentGroupList;
-	typedef stdvector<Array2d<Vector>*>::fwd                 NormalMapList;
+	typedef stdvector<Array2d<uint32>*>::fwd                 NormalMapList;
 
 public:
 
@@ -46,8 +46,8 @@ public:
 	static void                             destroyRadialMap (Array2d<RadialGroup::Info>* map);
 	static Array2d<EnvironmentGroup::Info>* createEnvironmentMap (int width, int height);
 	static void                             destroyEnvironmentMap (Array2d<EnvironmentGroup::Info>* map);
-	static Array2d<Vector>*                 createNormalMap (int width, int height);
-	static void                             destroyNormalMap (Array2d<Vector>* map);
+	static Array2d<uint32>*                 createNormalMap (int width, int height);
+	static void                             destroyNormalMap (Array2d<uint32>* map);
 
 	static void garbageCollect ();
 
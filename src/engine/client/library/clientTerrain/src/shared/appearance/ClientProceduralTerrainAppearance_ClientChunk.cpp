@@ -634,7 +634,11 @@ void ClientProceduralTerrainAppearance::ClientChunk::create (const ClientCreateC
 	ClientProceduralTerrainAppearance::Cache::unlock ();
 
 	shaderMap->makeCopy (*ccd_shaderMap);
-	vertexNormalMap->makeCopy (*ccd_vertexNormalMap);
+	{
+		for (int z = 0; z < vertexNormalMap->getHeight (); ++z)
+			for (int x = 0; x < vertexNormalMap->getWidth (); ++x)
+				vertexNormalMap->setData (x, z, ShaderSet::Primitive::encodeNormal (ccd_vertexNormalMap->getData (x, z)));
+	}
 	//floraStaticCollidableMap->makeCopy (*ccd_floraStaticCollidableMap);
 	floraStaticNonCollidableMap->makeCopy (*ccd_floraStaticNonCollidableMap);
 	floraDynamicNearMap->makeCopy (*ccd_floraDynamicNearMap);
@@ -11,6 +11,7 @@
 // ======================================================================
 
 #include "clientTerrain/ClientProceduralTerrainAppearance.h"
+#include "clientTerrain/ClientProceduralTerrainAppearance_ShaderSet.h"
 
 #include <vector>
 
@@ -63,8 +64,8 @@ private:
 	//-- 
 	Array2d<EnvironmentGroup::Info>* environmentMap;
 
-	//--
-	Array2d<Vector>*           vertexNormalMap;
+	//-- octahedral encoded, see ShaderSet::Primitive::encodeNormal
+	Array2d<uint32>*           vertexNormalMap;
 
 	//-- used for occlusion
 	IndexedTriangleList*       m_writeIndexedTriangleList;
@@ -92,7 +93,7 @@ public:
 	
 	const PackedRgb&      getColorAt  (int x, int z) const;
 	bool                  getHeightAt (const Vector& pos, float * height) const;
-	const Vector&         getNormalAt (int x, int z) const;
+	Vector                getNormalAt (int x, int z) const;
 	bool                  getHeightAt (const Vector& pos, float * height, Vector * normal) const;
 	virtual bool collide(Vector const & start_o, Vector const & end_o, CollideParameters const & collideParameters, CollisionInfo & result) const;
 
@@ -127,9 +128,9 @@ inline const PackedRgb& ClientProceduralTerrainAppearance::ClientChunk::getColor
 
 //----------------------------------------------------------------------
 
-inline const Vector& ClientProceduralTerrainAppearance::ClientChunk::getNormalAt  (int x, int z) const
+inline Vector ClientProceduralTerrainAppearance::ClientChunk::getNormalAt  (int x, int z) const
 {
-	return vertexNormalMap->getData (x, z);
+	return ShaderSet::Primitive::decodeNormal (vertexNormalMap->getData (x, z));
 }
 
 // ======================================================================
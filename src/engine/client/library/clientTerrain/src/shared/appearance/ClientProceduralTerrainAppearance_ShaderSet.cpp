@@ -20,6 +20,7 @@
 #include "clientTerrain/ClientTerrainSorter.h"
 #include "clientTerrain/ConfigClientTerrain.h"
 #include "sharedCollision/CollisionInfo.h"
+#include "sharedDebug/DebugFlags.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/MemoryBlockManager.h"
 #include "sharedMath/IndexedTriangleList.h"
@@ -274,6 +275,38 @@ namespace ClientProceduralTerrainAppearanceShaderSetNamespace
 	IndexBufferList * ms_indexBufferList;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	//-- grid column and row of each primitive vertex, matching the construction indirection array in ClientChunk
+	int const cms_vertexColumn[9] = { 1, 0, 0, 1, 2, 2, 2, 1, 0 };
+	int const cms_vertexRow[9]    = { 1, 1, 2, 2, 2, 1, 0, 0, 0 };
+
+	//-- heights snap to a global grid so vertices shared by neighboring tiles and chunks decode identically.
+	//   The step only grows (by powers of two) for tiles whose height range does not fit in 16 bits.
+	float const cms_minimumHeightStep = 1.f / 64.f;
+	int const   cms_maximumHeightOffset = 65535;
+
+	inline int computeHeightIndex (float const height, float const heightStep)
+	{
+		return static_cast<int> (floorf (height / heightStep + 0.5f));
+	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	inline int16 encodeNormalComponent (float const value)
+	{
+		return static_cast<int16> (floorf (clamp (-1.f, value, 1.f) * 32767.f + 0.5f));
+	}
+
+	inline float signNotZero (float const value)
+	{
+		return value >= 0.f ? 1.f : -1.f;
+	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	bool ms_reportPrimitiveMemory;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 }
 
 using namespace ClientProceduralTerrainAppearanceShaderSetNamespace;
@@ -347,6 +380,8 @@ void ClientProceduralTerrainAppearance::ShaderSet::install ()
 
 	Primitive::install ();
 
+	DebugFlags::registerFlag (ms_reportPrimitiveMemory, "ClientTerrain", "reportPrimitiveMemory", debugReport);
+
 	ms_indexBufferList = new IndexBufferList;
 
 	//-- create index buffer data
@@ -369,6 +404,8 @@ void ClientProceduralTerrainAppearance::ShaderSet::install ()
 
 void ClientProceduralTerrainAppearance::ShaderSet::remove ()
 {
+	DebugFlags::unregisterFlag (ms_reportPrimitiveMemory);
+
 	removeMemoryBlockManager();
 
 	Primitive::remove ();
@@ -385,6 +422,23 @@ void ClientProceduralTerrainAppearance::ShaderSet::remove ()
 	ms_indexBufferList = 0;
 }
 
+//-------------------------------------------------------------------
+
+void ClientProceduralTerrainAppearance::ShaderSet::debugReport ()
+{
+	//-- compare the resident primitives against the full float layout (9 positions and 9 normals per primitive)
+	int const numberOfPrimitives = Primitive::ms_memoryBlockManager->getElementCount ();
+	int const quantizedVertexSize = static_cast<int> (sizeof (Primitive::m_positionX) + sizeof (Primitive::m_positionZ) + sizeof (Primitive::m_heightBase) + sizeof (Primitive::m_heightStep) + sizeof (Primitive::m_heightList) + sizeof (Primitive::m_normalList));
+	int const floatVertexSize = static_cast<int> (18 * sizeof (Vector));
+	int const primitiveSize = static_cast<int> (sizeof (Primitive) + sizeof (Primitive::PlaneArray));
+	int const floatPrimitiveSize = primitiveSize - quantizedVertexSize + floatVertexSize;
+
+	DEBUG_REPORT_PRINT (true, ("-- ClientProceduralTerrainAppearance::ShaderSet\n"));
+	DEBUG_REPORT_PRINT (true, ("  primitives               = %i\n", numberOfPrimitives));
+	DEBUG_REPORT_PRINT (true, ("  vertex data/primitive    = %i bytes (%i as floats)\n", quantizedVertexSize, floatVertexSize));
+	DEBUG_REPORT_PRINT (true, ("  resident primitive data  = %i KB (%i KB as floats)\n", (numberOfPrimitives * primitiveSize) / 1024, (numberOfPrimitives * floatPrimitiveSize) / 1024));
+}
+
 //===================================================================
 
 ClientProceduralTerrainAppearance::ShaderSet::ShaderSet (const Shader* shader) :
@@ -420,8 +474,40 @@ void ClientProceduralTerrainAppearance::ShaderSet::addPrimitive(int const primit
 	primitive->m_excluded       = excluded;
 	primitive->m_x              = primitiveX;
 	primitive->m_z              = primitiveZ;
-	memcpy(&primitive->m_positionList, primitivePositionList, sizeof(primitive->m_positionList));
-	memcpy(&primitive->m_normalList, primitiveNormalList, sizeof(primitive->m_normalList));
+
+	//-- quantize the positions
+	{
+		float minimumHeight = primitivePositionList[0].y;
+		float maximumHeight = primitivePositionList[0].y;
+
+		int i;
+		for (i = 0; i < 9; ++i)
+		{
+			Vector const & position = primitivePositionList[i];
+			primitive->m_positionX[cms_vertexColumn[i]] = position.x;
+			primitive->m_positionZ[cms_vertexRow[i]] = position.z;
+			minimumHeight = std::min(minimumHeight, position.y);
+			maximumHeight = std::max(maximumHeight, position.y);
+		}
+
+		float heightStep = cms_minimumHeightStep;
+		while (computeHeightIndex(maximumHeight, heightStep) - computeHeightIndex(minimumHeight, heightStep) > cms_maximumHeightOffset)
+			heightStep *= 2.f;
+
+		int const heightBase = computeHeightIndex(minimumHeight, heightStep);
+		primitive->m_heightBase = heightBase;
+		primitive->m_heightStep = heightStep;
+
+		for (i = 0; i < 9; ++i)
+			primitive->m_heightList[i] = static_cast<uint16>(computeHeightIndex(primitivePositionList[i].y, heightStep) - heightBase);
+	}
+
+	//-- encode the normals
+	{
+		for (int i = 0; i < 9; ++i)
+			primitive->m_normalList[i] = Primitive::encodeNormal(primitiveNormalList[i]);
+	}
+
 	memcpy(&primitive->m_colorList, primitiveColorList, sizeof(primitive->m_colorList));
 	primitive->m_numberOfTextureCoordinateSets = numberOfTextureCoordinateSets;
 	primitive->m_baseUvScale = baseUvScale;
@@ -513,7 +599,8 @@ void ClientProceduralTerrainAppearance::ShaderSet::chooseIndexBuffer(unsigned ne
 		Primitive* const primitive = m_primitiveList[i];
 
 		//-- select which index buffer based on neighbor information
-		Vector const * const vertices = &primitive->m_positionList[0];
+		Vector vertices[9];
+		primitive->getPositionList(vertices);
 		int tilePatternIndex = getTilePatternIndex(primitive->m_x, primitive->m_z, numberOfTilesPerChunk - 1, newHasLargerNeighborFlags);
 		const SystemIndexBuffer* const  indexBuffer  = (*ms_indexBufferList)[static_cast<uint> (tilePatternIndex)];
 		Index const * indices = indexBuffer->beginReadOnly();
@@ -639,6 +726,9 @@ bool ClientProceduralTerrainAppearance::ShaderSet::collide (const Vector& start_
 
 	bool found = false;
 
+	//-- a hit lies on the segment, so only tiles whose extent overlaps the segment's can be hit
+	const Rectangle2d segmentExtent2d (std::min (start_o.x, end_o.x), std::min (start_o.z, end_o.z), std::max (start_o.x, end_o.x), std::max (start_o.z, end_o.z));
+
 	uint i;
 	for (i = 0; i < m_primitiveList.size(); ++i)
 	{
@@ -646,7 +736,13 @@ bool ClientProceduralTerrainAppearance::ShaderSet::collide (const Vector& start_
 		if (primitive->m_excluded)
 			continue;
 
-		Vector const * const vertices = &primitive->m_positionList[0];
+		if (!segmentExtent2d.intersects (primitive->m_extent2d))
+			continue;
+
+		//-- the vertices are only decoded once a plane is hit
+		Vector vertices[9];
+		bool decoded = false;
+
 		const SystemIndexBuffer* const  indexBuffer    = primitive->m_indexBuffer;  // indexBuffer is always locked
 		const Plane* const              planeArray     = NON_NULL (primitive->m_planeArray->getPlaneArray ());
 		const int                       numberOfPlanes = indexBuffer->getNumberOfIndices () / 3;
@@ -660,16 +756,22 @@ bool ClientProceduralTerrainAppearance::ShaderSet::collide (const Vector& start_
 			Vector normal;
 
 			int k;
-			for (k = 0; k < numberOfPlanes; k++)
+			for (k = 0; k < numberOfPlanes; k++, indices += 3)
 			{
-				Vector const & v0 = vertices[*indices++];
-				Vector const & v1 = vertices[*indices++];
-				Vector const & v2 = vertices[*indices++];
-
 				normal = planeArray [k].getNormal ();
 
 				if ((dir.dot (normal) <= 0.f) && (planeArray [k].findIntersection (start_o, end_o, intersection)))
 				{
+					if (!decoded)
+					{
+						primitive->getPositionList(vertices);
+						decoded = true;
+					}
+
+					Vector const & v0 = vertices[indices [0]];
+					Vector const & v1 = vertices[indices [1]];
+					Vector const & v2 = vertices[indices [2]];
+
 					if (intersection.inPolygon (v0, v1, v2) && (start_o.magnitudeBetweenSquared (intersection) < start_o.magnitudeBetweenSquared (result.getPoint())))
 					{
 						found         = true;
@@ -711,7 +813,12 @@ bool ClientProceduralTerrainAppearance::ShaderSet::getHeightAt (const Vector& st
 		if (primitive->m_excluded)
 			continue;
 
-		Vector const * const vertices = &primitive->m_positionList[0];
+		//-- every triangle of the tile lies within the tile's extent
+		if (!primitive->m_extent2d.isWithin (start_o.x, start_o.z))
+			continue;
+
+		Vector vertices[9];
+		primitive->getPositionList(vertices);
 		const SystemIndexBuffer* const  indexBuffer    = primitive->m_indexBuffer;  // indexBuffer is always locked
 		Index const * indices = indexBuffer->beginReadOnly();
 		const Plane* const              planeArray     = NON_NULL (primitive->m_planeArray)->getPlaneArray ();
@@ -789,8 +896,11 @@ void ClientProceduralTerrainAppearance::ShaderSet::getPolygonSoup (const Rectang
 			{
 				std::vector<Vector> & vertices = indexedTriangleList.getVertices();
 
+				Vector positionList[9];
+				primitive->getPositionList(positionList);
+
 				for (int j = 0; j < 9; ++j)
-					vertices.push_back(primitive->m_positionList[j]);
+					vertices.push_back(positionList[j]);
 			}
 
 			//-- copy index buffer contents (with offset)
@@ -826,7 +936,8 @@ void ClientProceduralTerrainAppearance::ShaderSet::renderShadowBlob (const Vecto
 
 		if (extent2d.intersects (primitive->m_extent2d))
 		{
-			Vector const * const positionList = &primitive->m_positionList[0];
+			Vector positionList[9];
+			primitive->getPositionList(positionList);
 			const SystemIndexBuffer* const indexBuffer = primitive->m_indexBuffer;
 			Index const * indices = indexBuffer->beginReadOnly();
 
@@ -861,7 +972,8 @@ void ClientProceduralTerrainAppearance::ShaderSet::renderReticle (const Vector&
 
 		if (extent2d.intersects (primitive->m_extent2d))
 		{
-			Vector const * const positionList = &primitive->m_positionList[0];
+			Vector positionList[9];
+			primitive->getPositionList(positionList);
 			const SystemIndexBuffer* const indexBuffer = primitive->m_indexBuffer;
 			Index const * indices = indexBuffer->beginReadOnly();
 
@@ -910,13 +1022,84 @@ void ClientProceduralTerrainAppearance::ShaderSet::Primitive::getUv(RotationType
 	v = uv.m_v;
 }
 
+//-------------------------------------------------------------------
+
+uint32 ClientProceduralTerrainAppearance::ShaderSet::Primitive::encodeNormal(Vector const & normal)
+{
+	//-- project onto the octahedron and fold the lower hemisphere over the upper one (y is up)
+	float const length = fabsf(normal.x) + fabsf(normal.y) + fabsf(normal.z);
+	if (length <= 0.f)
+		return encodeNormal(Vector::unitY);
+
+	float u = normal.x / length;
+	float v = normal.z / length;
+
+	if (normal.y < 0.f)
+	{
+		float const foldedU = (1.f - fabsf(v)) * signNotZero(u);
+		float const foldedV = (1.f - fabsf(u)) * signNotZero(v);
+		u = foldedU;
+		v = foldedV;
+	}
+
+	return (static_cast<uint32>(static_cast<uint16>(encodeNormalComponent(u))) << 16) | static_cast<uint32>(static_cast<uint16>(encodeNormalComponent(v)));
+}
+
+//-------------------------------------------------------------------
+
+Vector ClientProceduralTerrainAppearance::ShaderSet::Primitive::decodeNormal(uint32 const encodedNormal)
+{
+	float const u = static_cast<float>(static_cast<int16>(encodedNormal >> 16)) * (1.f / 32767.f);
+	float const v = static_cast<float>(static_cast<int16>(encodedNormal & 0xffff)) * (1.f / 32767.f);
+
+	Vector normal(u, 1.f - fabsf(u) - fabsf(v), v);
+	if (normal.y < 0.f)
+	{
+		normal.x = (1.f - fabsf(v)) * signNotZero(u);
+		normal.z = (1.f - fabsf(u)) * signNotZero(v);
+	}
+
+	IGNORE_RETURN(normal.normalize());
+
+	return normal;
+}
+
+//-------------------------------------------------------------------
+
+void ClientProceduralTerrainAppearance::ShaderSet::Primitive::getPositionList(Vector * const positionList) const
+{
+	NOT_NULL(positionList);
+
+	for (int i = 0; i < 9; ++i)
+	{
+		Vector & position = positionList[i];
+		position.x = m_positionX[cms_vertexColumn[i]];
+		position.y = static_cast<float>(m_heightBase + static_cast<int>(m_heightList[i])) * m_heightStep;
+		position.z = m_positionZ[cms_vertexRow[i]];
+	}
+}
+
+//-------------------------------------------------------------------
+
+void ClientProceduralTerrainAppearance::ShaderSet::Primitive::getNormalList(Vector * const normalList) const
+{
+	NOT_NULL(normalList);
+
+	for (int i = 0; i < 9; ++i)
+		normalList[i] = decodeNormal(m_normalList[i]);
+}
+
 // ======================================================================
 
 ClientProceduralTerrainAppearance::ShaderSet::Primitive::Primitive () :
 	m_excluded (false),
 	m_x (0),
 	m_z (0),
-	m_positionList(),
+	m_positionX(),
+	m_positionZ(),
+	m_heightBase(0),
+	m_heightStep(1.f),
+	m_heightList(),
 	m_normalList(),
 	m_colorList(),
 	m_numberOfTextureCoordinateSets(0),
@@ -924,7 +1107,8 @@ ClientProceduralTerrainAppearance::ShaderSet::Primitive::Primitive () :
 	m_indexBuffer (0),
 	m_planeArray (0),
 	m_sphere (),
-	m_extent2d ()
+	m_extent2d (),
+	m_decodedVerticesIndex (-1)
 {
 }
 
@@ -932,6 +1116,9 @@ ClientProceduralTerrainAppearance::ShaderSet::Primitive::Primitive () :
 
 ClientProceduralTerrainAppearance::ShaderSet::Primitive::~Primitive ()
 {
+	if (m_decodedVerticesIndex >= 0)
+		ClientTerrainSorter::releaseDecodedVertices (*this);
+
 	m_indexBuffer    = 0;
 	m_planeArray     = 0;
 }
@@ -16,6 +16,7 @@
 
 #include <vector>
 
+class ClientTerrainSorter;
 class CollisionInfo;
 class IndexedTriangleList;
 class Plane;
@@ -55,6 +56,10 @@ public:
 	static void  install (void);
 	static void  remove (void);
 
+private:
+
+	static void  debugReport (void);
+
 public:
 
 	class Primitive
@@ -62,6 +67,7 @@ public:
 		MEMORY_BLOCK_MANAGER_INTERFACE_WITHOUT_INSTALL;
 
 		friend class ShaderSet;
+		friend class ClientTerrainSorter;
 
 	public:
 
@@ -74,13 +80,16 @@ public:
 
 		static void getUv(RotationType rotationType, int index, float & u, float & v);
 
+		static uint32 encodeNormal(Vector const & normal);
+		static Vector decodeNormal(uint32 encodedNormal);
+
 	public:
 
 		Primitive (void);
 		~Primitive (void);
 
-		Vector const * getPositionList() const;
-		Vector const * getNormalList() const;
+		void getPositionList(Vector * positionList) const;
+		void getNormalList(Vector * normalList) const;
 		PackedArgb const * getColorList() const;
 		int getNumberOfTextureCoordinateSets() const;
 		float getBaseUvScale() const;
@@ -94,8 +103,15 @@ public:
 		bool                      m_excluded;
 		int                       m_x;
 		int                       m_z;
-		Vector m_positionList[9];
-		Vector m_normalList[9];
+		//-- the tile vertices lie on a 3x3 grid of poles, so only the grid lines are kept for x and z
+		float m_positionX[3];
+		float m_positionZ[3];
+		//-- heights are 16 bit offsets on a global grid of m_heightStep, starting at m_heightBase
+		int m_heightBase;
+		float m_heightStep;
+		uint16 m_heightList[9];
+		//-- normals are octahedral encoded
+		uint32 m_normalList[9];
 		PackedArgb m_colorList[9];
 		int m_numberOfTextureCoordinateSets;
 		float m_baseUvScale;
@@ -104,6 +120,8 @@ public:
 		PlaneArray*               m_planeArray;
 		Sphere                    m_sphere;
 		Rectangle2d               m_extent2d;
+		//-- the terrain sorter's decoded copy of the vertices while the primitive is being drawn, -1 if there is none
+		mutable int               m_decodedVerticesIndex;
 	};
 
 	typedef std::vector<Primitive*> PrimitiveList;
@@ -137,20 +155,6 @@ inline Rectangle2d const & ClientProceduralTerrainAppearance::ShaderSet::Primiti
 
 //----------------------------------------------------------------------
 
-inline Vector const * ClientProceduralTerrainAppearance::ShaderSet::Primitive::getPositionList() const
-{
-	return m_positionList;
-}
-
-// ----------------------------------------------------------------------
-
-inline Vector const * ClientProceduralTerrainAppearance::ShaderSet::Primitive::getNormalList() const
-{
-	return m_normalList;
-}
-
-// ----------------------------------------------------------------------
-
 inline PackedArgb const * ClientProceduralTerrainAppearance::ShaderSet::Primitive::getColorList() const
 {
 	return m_colorList;
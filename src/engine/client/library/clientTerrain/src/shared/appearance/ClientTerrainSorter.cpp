@@ -22,6 +22,7 @@
 #include "sharedDebug/DebugFlags.h"
 #include "sharedDebug/Profiler.h"
 #include "sharedFoundation/MemoryBlockManager.h"
+#include "sharedFoundation/Os.h"
 #include "sharedMath/Transform.h"
 #include "sharedTerrain/ConfigSharedTerrain.h"
 #include "sharedTerrain/TerrainObject.h"
@@ -47,6 +48,9 @@ ClientTerrainSorter::FvfList*                ClientTerrainSorter::ms_fvfList;
 ClientTerrainSorter::FvfMetricsList*         ClientTerrainSorter::ms_fvfMetricsList;
 ClientTerrainSorter::PrimitiveListCache*     ClientTerrainSorter::ms_primitiveListCache;
 ClientTerrainSorter::PrimitiveNodeListCache* ClientTerrainSorter::ms_primitiveNodeListCache;
+ClientTerrainSorter::DecodedVerticesList*    ClientTerrainSorter::ms_decodedVerticesList;
+int                                          ClientTerrainSorter::ms_numberOfDecodedVertices;
+int                                          ClientTerrainSorter::ms_decodedVerticesPruneFrameNumber = -1;
 ShaderPrimitiveSorter::LightBitSet           ClientTerrainSorter::ms_lightBitSet;
 
 namespace ClientTerrainSorterNamespace
@@ -138,6 +142,36 @@ void ClientTerrainSorter::FvfMetrics::reset ()
 
 //===================================================================
 
+/*
+ * The decoded positions and normals of a primitive in the draw set.  A
+ * primitive keeps its decoded vertices while it is drawn every frame, so
+ * the quantized data is only decoded when a tile comes into view.
+ */
+
+class ClientTerrainSorter::DecodedVertices
+{
+public:
+
+	const ClientProceduralTerrainAppearance::ShaderSet::Primitive* primitive;  //lint !e1925  // public data member
+	int    lastUsedFrameNumber;  //lint !e1925  // public data member
+	Vector positionList [9];     //lint !e1925  // public data member
+	Vector normalList [9];       //lint !e1925  // public data member
+
+public:
+
+	DecodedVertices ();
+};
+
+//-------------------------------------------------------------------
+
+ClientTerrainSorter::DecodedVertices::DecodedVertices () :
+	primitive (0),
+	lastUsedFrameNumber (0)
+{
+}
+
+//===================================================================
+
 class ClientTerrainSorter::PrimitiveNode : public ShaderPrimitive
 {
 public:
@@ -313,9 +347,10 @@ void ClientTerrainSorter::PrimitiveNode::prepareToDraw () const
 				const ClientProceduralTerrainAppearance::ShaderSet::Primitive* const primitive = (*primitiveList) [i];
 
 				//-- Copy vertex buffer data
-				Vector const * const positionList = primitive->getPositionList();
-				Vector const * const normalList = primitive->getNormalList();
-				PackedArgb const * const colorList = primitive->getColorList();				
+				const DecodedVertices& decodedVertices = getDecodedVertices (*primitive);
+				Vector const * const positionList = decodedVertices.positionList;
+				Vector const * const normalList = decodedVertices.normalList;
+				PackedArgb const * const colorList = primitive->getColorList();
 				float const uvScale = primitive->getBaseUvScale();
 
 				{
@@ -438,6 +473,9 @@ void ClientTerrainSorter::install ()
 
 	ms_dynamicIndexBuffer = new DynamicIndexBuffer();
 
+	ms_decodedVerticesList = new DecodedVerticesList;
+	ms_numberOfDecodedVertices = 0;
+
 #ifdef _DEBUG
 	DebugFlags::registerFlag(ms_debugReport, "ClientTerrain", "reportClientTerrainSorter", debugReport);
 #endif
@@ -457,6 +495,24 @@ void ClientTerrainSorter::remove ()
 
 	clear ();
 
+	//-- remove the decoded vertices
+	{
+		uint i;
+		for (i = 0; i < ms_decodedVerticesList->size (); ++i)
+		{
+			DecodedVertices* const decodedVertices = (*ms_decodedVerticesList) [i];
+
+			if (static_cast<int> (i) < ms_numberOfDecodedVertices)
+				decodedVertices->primitive->m_decodedVerticesIndex = -1;
+
+			delete decodedVertices;
+		}
+
+		delete ms_decodedVerticesList;
+		ms_decodedVerticesList = 0;
+		ms_numberOfDecodedVertices = 0;
+	}
+
 	//-- remove caches
 	{
 		while (!ms_primitiveNodeListCache->empty ())
@@ -549,6 +605,8 @@ void ClientTerrainSorter::clear ()
 	}
 
 	ms_lightBitSet.reset();
+
+	pruneDecodedVertices ();
 }
 
 //-------------------------------------------------------------------
@@ -683,6 +741,87 @@ void ClientTerrainSorter::draw ()
 	}
 }
 
+//-------------------------------------------------------------------
+/**
+ * Gives back the decoded vertices of a primitive that is being destroyed.
+ * The last decoded vertices in use take its place.
+ */
+
+void ClientTerrainSorter::releaseDecodedVertices (const ClientProceduralTerrainAppearance::ShaderSet::Primitive& primitive)
+{
+	DEBUG_FATAL (!Os::isMainThread (), ("ClientTerrainSorter::releaseDecodedVertices - not on the main thread"));
+
+	const int index = primitive.m_decodedVerticesIndex;
+	if (index < 0 || !ms_decodedVerticesList)
+		return;
+
+	DEBUG_FATAL (index >= ms_numberOfDecodedVertices, ("ClientTerrainSorter::releaseDecodedVertices - index %i out of range [0..%i)", index, ms_numberOfDecodedVertices));
+	primitive.m_decodedVerticesIndex = -1;
+
+	const int last = --ms_numberOfDecodedVertices;
+	if (index != last)
+	{
+		std::swap ((*ms_decodedVerticesList) [static_cast<uint> (index)], (*ms_decodedVerticesList) [static_cast<uint> (last)]);
+		(*ms_decodedVerticesList) [static_cast<uint> (index)]->primitive->m_decodedVerticesIndex = index;
+	}
+
+	(*ms_decodedVerticesList) [static_cast<uint> (last)]->primitive = 0;
+}
+
+//-------------------------------------------------------------------
+
+const ClientTerrainSorter::DecodedVertices& ClientTerrainSorter::getDecodedVertices (const ClientProceduralTerrainAppearance::ShaderSet::Primitive& primitive)
+{
+	NOT_NULL (ms_decodedVerticesList);
+
+	int index = primitive.m_decodedVerticesIndex;
+	if (index < 0)
+	{
+		//-- reuse a spare entry if there is one
+		index = ms_numberOfDecodedVertices++;
+		if (index == static_cast<int> (ms_decodedVerticesList->size ()))
+			ms_decodedVerticesList->push_back (new DecodedVertices);
+
+		DecodedVertices& decodedVertices = *(*ms_decodedVerticesList) [static_cast<uint> (index)];
+		decodedVertices.primitive = &primitive;
+		primitive.getPositionList (decodedVertices.positionList);
+		primitive.getNormalList (decodedVertices.normalList);
+
+		primitive.m_decodedVerticesIndex = index;
+	}
+
+	DecodedVertices& decodedVertices = *(*ms_decodedVerticesList) [static_cast<uint> (index)];
+	decodedVertices.lastUsedFrameNumber = Graphics::getFrameNumber ();
+
+	return decodedVertices;
+}
+
+//-------------------------------------------------------------------
+/**
+ * Gives back the decoded vertices of the primitives that were not drawn
+ * this frame or the last, once a frame.
+ */
+
+void ClientTerrainSorter::pruneDecodedVertices ()
+{
+	const int frameNumber = Graphics::getFrameNumber ();
+	if (frameNumber == ms_decodedVerticesPruneFrameNumber)
+		return;
+
+	ms_decodedVerticesPruneFrameNumber = frameNumber;
+
+	int i = 0;
+	while (i < ms_numberOfDecodedVertices)
+	{
+		const DecodedVertices& decodedVertices = *(*ms_decodedVerticesList) [static_cast<uint> (i)];
+
+		if (frameNumber - decodedVertices.lastUsedFrameNumber > 1)
+			releaseDecodedVertices (*decodedVertices.primitive);
+		else
+			++i;
+	}
+}
+
 //-------------------------------------------------------------------
 
 void ClientTerrainSorter::debugReport ()
@@ -723,11 +862,12 @@ void ClientTerrainSorter::debugReport ()
 		metrics->reset ();
 	}
 
-	DEBUG_REPORT_PRINT (ms_debugReport, ("totalgs=%3iK  totals=%6i  totalip=%6i  totalop=%6i\n", 
+	DEBUG_REPORT_PRINT (ms_debugReport, ("totalgs=%3iK  totals=%6i  totalip=%6i  totalop=%6i  decoded=%6i\n", 
 		totalGeometrySize >> 10, 
 		totalNumberOfShaders,
 		totalNumberOfInputPrimitives, 
-		totalNumberOfOutputPrimitives));
+		totalNumberOfOutputPrimitives,
+		ms_numberOfDecodedVertices));
 
 	static int s_maximumNumberOfShaders          = 0;
 	static int s_maximumNumberOfInputPrimitives  = 0;
@@ -35,9 +35,18 @@ public:
 	static void                    queue (const Shader* shader, const ClientProceduralTerrainAppearance::ShaderSet::Primitive* primitive);
 	static void                    draw ();
 
+	static void                    releaseDecodedVertices (const ClientProceduralTerrainAppearance::ShaderSet::Primitive& primitive);
+
 private:
 
-	static void debugReport ();
+	class DecodedVertices;
+
+private:
+
+	static void                    debugReport ();
+
+	static const DecodedVertices&  getDecodedVertices (const ClientProceduralTerrainAppearance::ShaderSet::Primitive& primitive);
+	static void                    pruneDecodedVertices ();
 
 private:
 
@@ -52,6 +61,7 @@ private:
 	typedef stdvector<PrimitiveNodeList*>::fwd             PrimitiveNodeListCache;
 	class FvfMetrics;
 	typedef stdvector<FvfMetrics*>::fwd                    FvfMetricsList;
+	typedef stdvector<DecodedVertices*>::fwd               DecodedVerticesList;
 
 	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -66,6 +76,9 @@ private:
 	static FvfMetricsList*                    ms_fvfMetricsList;
 	static PrimitiveListCache*                ms_primitiveListCache;
 	static PrimitiveNodeListCache*            ms_primitiveNodeListCache;
+	static DecodedVerticesList*               ms_decodedVerticesList;
+	static int                                ms_numberOfDecodedVertices;
+	static int                                ms_decodedVerticesPruneFrameNumber;
 	static ShaderPrimitiveSorter::LightBitSet ms_lightBitSet;
 
 private:
@@ -26,6 +26,8 @@ namespace
 	bool  ms_terrainMultiThreaded;
 
 	bool  ms_radialFloraSortFrontToBack;
+	bool  ms_radialFloraMultiThreaded;
+	int   ms_maximumNumberOfRadialFloraUpdatesPerFrame;
 
 	float ms_threshold;
 	bool  ms_showChunkExtents;
@@ -128,6 +130,20 @@ bool ConfigClientTerrain::getRadialFloraSortFrontToBack ()
 	return ms_radialFloraSortFrontToBack;
 }
 
+// ----------------------------------------------------------------------
+
+bool ConfigClientTerrain::getRadialFloraMultiThreaded ()
+{
+	return ms_radialFloraMultiThreaded;
+}
+
+// ----------------------------------------------------------------------
+
+int ConfigClientTerrain::getMaximumNumberOfRadialFloraUpdatesPerFrame ()
+{
+	return ms_maximumNumberOfRadialFloraUpdatesPerFrame;
+}
+
 //-------------------------------------------------------------------
 
 float ConfigClientTerrain::getThreshold ()
@@ -341,6 +357,8 @@ void ConfigClientTerrain::install()
 
 	// Flora rendering improvements
 	KEY_BOOL(radialFloraSortFrontToBack, true);
+	KEY_BOOL(radialFloraMultiThreaded, true);    // Look up flora and heights off the main thread
+	KEY_INT(maximumNumberOfRadialFloraUpdatesPerFrame, 1024);    // Per flora manager, the rest are deferred
 
 	// Level of detail threshold (LOD) and terrain bias settings
 	KEY_FLOAT(threshold, 4.f);      // LOD transition threshold
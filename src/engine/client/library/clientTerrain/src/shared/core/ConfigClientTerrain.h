@@ -24,6 +24,8 @@ public:
 	static bool  getTerrainMultiThreaded ();
 
 	static bool  getRadialFloraSortFrontToBack ();
+	static bool  getRadialFloraMultiThreaded ();
+	static int   getMaximumNumberOfRadialFloraUpdatesPerFrame ();
 
 	static float getThreshold ();
 	static bool  getShowChunkExtents ();
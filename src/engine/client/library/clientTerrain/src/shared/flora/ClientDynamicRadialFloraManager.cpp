@@ -10,6 +10,7 @@
 #include "clientTerrain/FirstClientTerrain.h"
 #include "clientTerrain/ClientDynamicRadialFloraManager.h"
 
+#include "clientGraphics/BatchCuller.h"
 #include "clientGraphics/Camera.h"
 #include "clientGraphics/StaticIndexBuffer.h"
 #include "clientGraphics/DynamicVertexBuffer.h"
@@ -23,6 +24,7 @@
 #include "sharedDebug/DebugFlags.h"
 #include "sharedDebug/Profiler.h"
 #include "sharedFoundation/ExitChain.h"
+#include "sharedMath/Sphere.h"
 #include "sharedMath/Transform.h"
 #include "sharedFoundation/MemoryBlockManagerMacros.h"
 #include "sharedFoundation/MemoryBlockManager.h"
@@ -33,6 +35,7 @@
 #include <algorithm>
 #include <map>
 #include <string>
+#include <vector>
 
 //===================================================================
 
@@ -41,6 +44,11 @@ namespace
 	const Tag TAG_WABV = TAG (W,A,B,V);
 	const Tag TAG_WBLW = TAG (W,B,L,W);
 
+	//-- flora spheres culled together each draw, and the radial node list index of each sphere
+	BatchCuller::Batch  s_cullingBatch;
+	BatchCuller::Result s_cullingResult;
+	std::vector<int>    s_cullingNodeIndices;
+
 	//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	static inline float scurve (float t)
@@ -242,6 +250,8 @@ public:
 	////////////////////////////////////////////////////////////////////////////
 
 	void                     draw () const;
+	const Sphere             getCullingSphere () const;
+	void                     addToBucket (float depth) const;
 
 	const Transform &        transform()                                   const { return m_transform;        }
 	      Transform &        transform()                                         { return m_transform;        }
@@ -752,18 +762,29 @@ void ClientDynamicRadialFloraManager::DynamicRadialNode::setTransform (const Tra
 
 void ClientDynamicRadialFloraManager::DynamicRadialNode::draw () const
 {
-	const Camera& camera      = ShaderPrimitiveSorter::getCurrentCamera ();
+	const Camera& camera = ShaderPrimitiveSorter::getCurrentCamera ();
+
+	if (camera.testVisibility_w (getCullingSphere ()))
+		addToBucket (camera.getPosition_w ().magnitudeBetween (m_transform.getPosition_p ()));
+}
+
+//-------------------------------------------------------------------
+
+const Sphere ClientDynamicRadialFloraManager::DynamicRadialNode::getCullingSphere () const
+{
 	const float   width       = m_dynamicFloraData.familyChildData->maxWidth;
 	const float   height      = m_dynamicFloraData.familyChildData->maxHeight;
 	const float   floraRadius = std::max (width, height);
 	const Vector  position    = m_transform.getPosition_p ();
-	const Vector  center (position.x, position.y + height * 0.5f, position.z);
 
-	if (camera.testVisibility_w (Sphere (center, floraRadius)))
-	{
-		float depth = camera.getPosition_w().magnitudeBetween(position);
-		safe_cast<ClientDynamicRadialFloraManager*> (m_manager)->addToBucket (position, depth, this);
-	}
+	return Sphere (Vector (position.x, position.y + height * 0.5f, position.z), floraRadius);
+}
+
+//-------------------------------------------------------------------
+
+void ClientDynamicRadialFloraManager::DynamicRadialNode::addToBucket (const float depth) const
+{
+	safe_cast<ClientDynamicRadialFloraManager*> (m_manager)->addToBucket (m_transform.getPosition_p (), depth, this);
 }
 
 //===================================================================
@@ -806,7 +827,8 @@ ClientDynamicRadialFloraManager::ClientDynamicRadialFloraManager (const ClientPr
 	ClientRadialFloraManager (terrainAppearance, enabled, minimumDistance, maximumDistance),
 	m_floraSwayAngle(0),
 	m_findFloraFunction (findFloraFunction),
-	m_applyColor (applyColor)
+	m_applyColor (applyColor),
+	m_floraDataList ()
 {
 	internalInitialize ();
 }
@@ -815,6 +837,9 @@ ClientDynamicRadialFloraManager::ClientDynamicRadialFloraManager (const ClientPr
 
 ClientDynamicRadialFloraManager::~ClientDynamicRadialFloraManager ()
 {
+	//-- the gather thread may still be calling findFlora
+	waitForGather ();
+
 	freeBuckets();
 	m_findFloraFunction = 0;
 }
@@ -966,16 +991,51 @@ void ClientDynamicRadialFloraManager::draw () const
 
 	////////////////////////////////////////////////////////////
 	//-- queue up radial nodes into flora node buckets
-	RadialNodeList::const_iterator rni;
-	for (rni=m_radialNodeList.begin();rni!=m_radialNodeList.end();++rni)
+	if (BatchCuller::isEnabled ())
+	{
+		//-- cull the flora spheres in one batch, the depth is measured from the node position as in DynamicRadialNode::draw
+		s_cullingBatch.clear ();
+		s_cullingNodeIndices.clear ();
+
+		const int numberOfRadialNodes = static_cast<int> (m_radialNodeList.size ());
+		for (int i = 0; i < numberOfRadialNodes; ++i)
+		{
+			const RadialNodeReference &reference = m_radialNodeList [static_cast<size_t> (i)];
+		#ifdef _DEBUG
+			_verifyRadialNodeReference(reference);
+		#endif
+			if (reference.hasFlora)
+			{
+				const Sphere sphere = safe_cast<const DynamicRadialNode *>(reference.nodePointer)->getCullingSphere ();
+				IGNORE_RETURN (s_cullingBatch.addSphere (sphere.getCenter (), sphere.getRadius ()));
+				s_cullingNodeIndices.push_back (i);
+			}
+		}
+
+		BatchCuller::cull (s_cullingBatch, camera, s_cullingResult);
+
+		const Vector cameraPosition_w = camera.getPosition_w ();
+		const int numberOfVisible = s_cullingResult.getNumberOfVisible ();
+		for (int i = 0; i < numberOfVisible; ++i)
+		{
+			const int nodeIndex = s_cullingNodeIndices [static_cast<size_t> (s_cullingResult.getIndex (i))];
+			const DynamicRadialNode *rn = safe_cast<const DynamicRadialNode *>(m_radialNodeList [static_cast<size_t> (nodeIndex)].nodePointer);
+			rn->addToBucket (cameraPosition_w.magnitudeBetween (rn->getTransform ().getPosition_p ()));
+		}
+	}
+	else
 	{
-	#ifdef _DEBUG
-		_verifyRadialNodeReference(*rni);
-	#endif
-		if (rni->hasFlora)
+		RadialNodeList::const_iterator rni;
+		for (rni=m_radialNodeList.begin();rni!=m_radialNodeList.end();++rni)
 		{
-			DynamicRadialNode *rn = safe_cast<DynamicRadialNode *>(rni->nodePointer);
-			rn->draw();
+		#ifdef _DEBUG
+			_verifyRadialNodeReference(*rni);
+		#endif
+			if (rni->hasFlora)
+			{
+				DynamicRadialNode *rn = safe_cast<DynamicRadialNode *>(rni->nodePointer);
+				rn->draw();
+			}
 		}
 	}
 	////////////////////////////////////////////////////////////
@@ -988,21 +1048,30 @@ void ClientDynamicRadialFloraManager::draw () const
 
 //-------------------------------------------------------------------
 
-bool ClientDynamicRadialFloraManager::createFlora (float positionX, float positionZ, RadialNode* radialNode, bool& floraAllowed) const
+void ClientDynamicRadialFloraManager::resizeFloraData (int const numberOfEntries) const
+{
+	m_floraDataList.resize (static_cast<size_t> (numberOfEntries));
+}
+
+//-------------------------------------------------------------------
+
+bool ClientDynamicRadialFloraManager::findFlora (float const positionX, float const positionZ, int const entryIndex, bool& floraAllowed, bool& floats) const
 {
-	ClientProceduralTerrainAppearance::DynamicFloraData dynamicFloraData;
 	NOT_NULL (m_findFloraFunction);
 
-	if ((m_terrainAppearance.*m_findFloraFunction) (positionX, positionZ, dynamicFloraData, floraAllowed))
-	{
-		DynamicRadialNode *const dynamicRadialNode = safe_cast<DynamicRadialNode*> (radialNode);
-		dynamicRadialNode->setFloraData(dynamicFloraData);
-		dynamicRadialNode->setColor(dynamicFloraData.color);
+	floats = false;
+	return (m_terrainAppearance.*m_findFloraFunction) (positionX, positionZ, m_floraDataList [static_cast<size_t> (entryIndex)], floraAllowed);
+}
 
-		return true;
-	}
+//-------------------------------------------------------------------
 
-	return false;
+void ClientDynamicRadialFloraManager::applyFlora (float /*positionX*/, float /*positionZ*/, RadialNode* const radialNode, int const entryIndex) const
+{
+	const ClientProceduralTerrainAppearance::DynamicFloraData& dynamicFloraData = m_floraDataList [static_cast<size_t> (entryIndex)];
+
+	DynamicRadialNode *const dynamicRadialNode = safe_cast<DynamicRadialNode*> (radialNode);
+	dynamicRadialNode->setFloraData(dynamicFloraData);
+	dynamicRadialNode->setColor(dynamicFloraData.color);
 }
 
 //-------------------------------------------------------------------
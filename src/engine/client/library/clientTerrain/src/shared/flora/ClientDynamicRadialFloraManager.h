@@ -59,6 +59,7 @@ private:
 	};
 
 	typedef std::vector<FloraBucket> FloraBucketList;
+	typedef std::vector<ClientProceduralTerrainAppearance::DynamicFloraData> FloraDataList;
 
 private:
 
@@ -75,7 +76,9 @@ private:
 
 	void                internalInitialize ();
 	virtual RadialNode* createRadialNode (const Vector& position) const;
-	virtual bool        createFlora (float positionX, float positionZ, RadialNode* radialNode, bool& floraAllowed) const;
+	virtual void        resizeFloraData (int numberOfEntries) const;
+	virtual bool        findFlora (float positionX, float positionZ, int entryIndex, bool& floraAllowed, bool& floats) const;
+	virtual void        applyFlora (float positionX, float positionZ, RadialNode* radialNode, int entryIndex) const;
 	void                addToBucket (const Vector& position, float depth, const DynamicRadialNode* const dynamicRadialNode);
 
 private:
@@ -97,6 +100,7 @@ private:
 	FloraBucketList            m_floraBucketList;
 	FindFloraFunction          m_findFloraFunction;
 	const bool                 m_applyColor;
+	mutable FloraDataList      m_floraDataList;
 
 private:
 
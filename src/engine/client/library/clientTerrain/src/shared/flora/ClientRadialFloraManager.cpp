@@ -12,6 +12,7 @@
 
 #include "sharedCollision/BoxExtent.h"
 #include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/PerformanceTimer.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/VoidBindSecond.h"
 #include "sharedFoundation/VoidMemberFunction.h"
@@ -23,10 +24,12 @@
 #include "sharedRandom/RandomGenerator.h"
 #include "sharedTerrain/ConfigSharedTerrain.h"
 #include "sharedTerrain/TerrainObject.h"
+#include "sharedThread/RunThread.h"
 #include "clientGraphics/Camera.h"
 #include "clientGraphics/DebugPrimitive.h"
 #include "clientGraphics/ShaderPrimitiveSorter.h"
 #include "clientTerrain/ClientProceduralTerrainAppearance.h"
+#include "clientTerrain/ConfigClientTerrain.h"
 
 #include <algorithm>
 #include <map>
@@ -78,6 +81,76 @@ ClientRadialFloraManager::ClearFloraEntry::~ClearFloraEntry ()
 	m_clearFloraEntryList = 0;
 }
 
+//===================================================================
+// ClientRadialFloraManager::ClearFloraGrid
+//===================================================================
+
+//
+// ClearFloraGrid buckets the clear flora circles around the flora origin
+// into a uniform grid so a flora position only tests the circles that
+// overlap its own cell. The grid covers the flora radius plus some slack
+// so it only needs to be rebuilt when the origin moves past the slack or
+// when a clear flora object is added or removed.
+//
+
+class ClientRadialFloraManager::ClearFloraGrid
+{
+public:
+
+	ClearFloraGrid ();
+
+	bool needsRebuild (const Vector& origin, float maximumDistance) const;
+	void build (const Vector& origin, float maximumDistance);
+	bool isCleared (float positionX, float positionZ) const;
+
+	int  getNumberOfCells () const;
+	int  getNumberOfCircles () const;
+
+private:
+
+	struct Circle
+	{
+		float x;
+		float z;
+		float radiusSquared;
+	};
+
+	struct CellRange
+	{
+		Circle circle;
+		int    x0;
+		int    z0;
+		int    x1;
+		int    z1;
+	};
+
+	typedef std::vector<Circle>    CircleList;
+	typedef std::vector<CellRange> CellRangeList;
+	typedef std::vector<int>       CellList;
+
+private:
+
+	ClearFloraGrid (const ClearFloraGrid&);
+	ClearFloraGrid& operator= (const ClearFloraGrid&);
+
+private:
+
+	int        m_revision;
+	float      m_centerX;
+	float      m_centerZ;
+	float      m_maximumDistance;
+
+	float      m_x0;
+	float      m_z0;
+	float      m_cellSize;
+	float      m_oneOverCellSize;
+	int        m_width;
+
+	//-- m_cellList [i] .. m_cellList [i + 1] index the circles in m_circleList that overlap cell i
+	CellList   m_cellList;
+	CircleList m_circleList;
+};
+
 //===================================================================
 // PUBLIC ClientRadialFloraManager::RadialNode
 //===================================================================
@@ -148,25 +221,30 @@ namespace ClientRadialFloraManagerNamespace
 	typedef std::map<const Object*, ClientRadialFloraManager::ClearFloraEntry*> ClearFloraEntryMap;
 	ClearFloraEntryMap ms_clearFloraEntryMap;
 
-	// ----------------------------------------------------------------------------------------------
-
-	struct TestClearFloraEntry
-	{
-		ClientRadialFloraManager::ClearFloraEntry *entry;
-		Vector m_center_w;
-		float  m_radius;
-	};
+	//-- bumped whenever ms_clearFloraEntryMap changes so the clear flora grids know to rebuild
+	int                ms_clearFloraEntryMapRevision;
 
-	typedef std::vector<TestClearFloraEntry> TestClearFloraEntryVector;
-
-	void _updateClearFloraEntryVector(Vector origin, float maximumDistance);
+	// ----------------------------------------------------------------------------------------------
 
-	static TestClearFloraEntryVector clearFloraEntries_w;
+	int const          cms_maximumClearFloraGridWidth = 64;
+	float const        cms_minimumClearFloraGridCellSize = 8.f;
 
 	// ----------------------------------------------------------------------------------------------
 
+	bool               ms_multiThreaded;
+	int                ms_maximumNumberOfGatherEntries;
+
 	bool               ms_renderClearFloraEntryMap;
 	bool               ms_debugReport;
+	bool               ms_disableGatherThread;
+
+	//-- per frame statistics, reset by debugReport ()
+	float              ms_mainThreadTime;
+	float              ms_gatherStallTime;
+	float              ms_gatherThreadTime;
+	int                ms_numberOfGatherEntries;
+	int                ms_numberOfDeferredUpdates;
+	int                ms_numberOfClearFloraGridRebuilds;
 
 	void debugReport ();
 }
@@ -178,8 +256,27 @@ using namespace ClientRadialFloraManagerNamespace;
 void ClientRadialFloraManager::install ()
 {
 	ClearFloraEntry::install ();
+
+	ms_multiThreaded = ConfigClientTerrain::getRadialFloraMultiThreaded ();
+	ms_maximumNumberOfGatherEntries = std::max (1, ConfigClientTerrain::getMaximumNumberOfRadialFloraUpdatesPerFrame ());
+
 	DebugFlags::registerFlag (ms_renderClearFloraEntryMap, "ClientTerrain", "renderClearFloraEntryMap");
 	DebugFlags::registerFlag (ms_debugReport, "ClientTerrain", "reportClientRadialFloraManager", debugReport);
+	DebugFlags::registerFlag (ms_disableGatherThread, "ClientTerrain", "disableRadialFloraGatherThread");
+}
+
+//-------------------------------------------------------------------
+
+bool ClientRadialFloraManager::getMultiThreaded ()
+{
+	return ms_multiThreaded;
+}
+
+//-------------------------------------------------------------------
+
+void ClientRadialFloraManager::setMultiThreaded (bool const multiThreaded)
+{
+	ms_multiThreaded = multiThreaded;
 }
 
 //-------------------------------------------------------------------
@@ -225,8 +322,7 @@ void ClientRadialFloraManager::addClearFloraObject (const Object* const object,
 
 	//-- insert into the flora map
 	ms_clearFloraEntryMap.insert (std::make_pair (object, clearFloraEntry));
-
-	clearFloraEntries_w.clear(); // safety fallback to avoid crashes. This *shouldn't* be needed.
+	++ms_clearFloraEntryMapRevision;
 }
 
 //-------------------------------------------------------------------
@@ -238,9 +334,8 @@ void ClientRadialFloraManager::removeClearFloraObject (const Object* const objec
 	{
 		delete iter->second;
 		ms_clearFloraEntryMap.erase (iter);
+		++ms_clearFloraEntryMapRevision;
 	}
-
-	clearFloraEntries_w.clear(); // safety fallback to avoid crashes. This *shouldn't* be needed.
 }
 
 //===================================================================
@@ -260,7 +355,19 @@ ClientRadialFloraManager::ClientRadialFloraManager (const ClientProceduralTerrai
 	m_floraTileSize (8.f),
 	m_floraTileBorderIgnoreDistance (2.f),
 	m_seed (0),
-	m_oldOrigin (Vector (maximumDistance * 2.f, 0.f, maximumDistance * 2.f))
+	m_oldOrigin (Vector (maximumDistance * 2.f, 0.f, maximumDistance * 2.f)),
+	m_gatherEntryList (),
+	m_hasPendingNodes (false),
+	m_nextGatherIndex (0),
+	m_clearFloraGrid (new ClearFloraGrid),
+	m_gatherCriticalSection (),
+	m_gatherRequestGate (false),
+	m_gatherCompleteGate (true),
+	m_gatherThread (),
+	m_gatherRequested (false),
+	m_gatherInProgress (false),
+	m_quitGatherThread (false),
+	m_gatherTime (0.f)
 {
 	DEBUG_FATAL (minimumDistance >= maximumDistance, ("minimumDistance (%1.2f) >= maximumDistance (%1.2f)", minimumDistance, maximumDistance));
 }
@@ -269,6 +376,21 @@ ClientRadialFloraManager::ClientRadialFloraManager (const ClientProceduralTerrai
 	
 ClientRadialFloraManager::~ClientRadialFloraManager ()
 {
+	//-- wait for the gather thread to die
+	if (m_gatherThread)
+	{
+		waitForGather ();
+
+		m_gatherCriticalSection.enter ();
+			m_quitGatherThread = true;
+			m_gatherRequestGate.open ();
+		m_gatherCriticalSection.leave ();
+		m_gatherThread->wait ();
+	}
+
+	m_gatherEntryList.clear ();
+	delete m_clearFloraGrid;
+
 	delete m_debugName;
 	m_debugName = 0;
 
@@ -304,6 +426,8 @@ void ClientRadialFloraManager::_constructRadialNodeReference(RadialNodeReference
 	o_ref.position_z = position.z;
 	o_ref.floraAllowed = node->getFloraAllowed();
 	o_ref.hasFlora = node->getHasFlora();
+	o_ref.pendingFlora = false;
+	o_ref.pendingHeight = false;
 }
 
 //-------------------------------------------------------------------
@@ -415,6 +539,9 @@ void ClientRadialFloraManager::markExtentDirty (const BoxExtent* const extent)
 
 void ClientRadialFloraManager::maximumDistanceChanged ()
 {
+	//-- the pending gather refers to the nodes we are about to delete
+	discardGather ();
+
 	m_regionList.clear ();
 
 	RadialNodeList::iterator rni;
@@ -516,69 +643,10 @@ bool ClientRadialFloraManager::approximateCollide (const Vector& /*start_w*/, co
 	return false;
 }
 
-//===================================================================
-// STATIC PROTECTED ClientRadialFloraManager
-//===================================================================
-
-bool ClientRadialFloraManager::shouldClearFlora(float positionX, float positionZ, float mapHalfWidthInMeters)
-{
-	//-- check x and z
-	if (  positionX> mapHalfWidthInMeters 
-		|| positionZ> mapHalfWidthInMeters
-		|| positionX<-mapHalfWidthInMeters
-		|| positionZ<-mapHalfWidthInMeters
-		)
-	{
-		return false;
-	}
-
-	if (clearFloraEntries_w.empty())
-	{
-		return false;
-	}
-
-	const Vector position2d (positionX, 0.f, positionZ);
-
-	TestClearFloraEntry * iter = &clearFloraEntries_w[0];
-	TestClearFloraEntry * stop = iter + clearFloraEntries_w.size();
-
-	for (;iter!=stop; ++iter)
-	{
-		const TestClearFloraEntry &testEntry = *iter;
-
-		//-- check to see if within the global sphere
-		if (testEntry.m_center_w.magnitudeBetweenSquared (position2d) < sqr (testEntry.m_radius))
-		{
-			const ClearFloraEntry* const clearFloraEntry = testEntry.entry;
-
-			//-- check to see if within any of the smaller spheres
-			uint i;
-			for (i = 0; i < clearFloraEntry->m_clearFloraEntryList_w.size (); ++i)
-				if (clearFloraEntry->m_clearFloraEntryList_w [i].first.magnitudeBetweenSquared (position2d) < sqr (clearFloraEntry->m_clearFloraEntryList_w [i].second))
-					return true;
-		}
-	}
-
-	return false;
-}
-
 //===================================================================
 // PROTECTED ClientRadialFloraManager
 //===================================================================
 
-bool ClientRadialFloraManager::createFlora (float positionX, float positionZ, RadialNode* radialNode, bool& floraAllowed) const
-{
-	UNREF (positionX);
-	UNREF (positionZ);
-	UNREF (radialNode);
-	UNREF (floraAllowed);
-	DEBUG_FATAL (true, ("this should not be called"));
-
-	return false;  //lint !e527  //-- unreachable
-}  //lint !e1764  //-- floraAllowed could be made a const reference
-
-//-------------------------------------------------------------------
-
 ClientRadialFloraManager::RadialNode* ClientRadialFloraManager::createRadialNode (const Vector& position) const
 {
 	UNREF (position);
@@ -609,178 +677,557 @@ bool ClientRadialFloraManager::isWithinDirtyRegion (float x, float y) const
 
 //-------------------------------------------------------------------
 
-void ClientRadialFloraManagerNamespace::_updateClearFloraEntryVector(Vector origin, float maximumDistance)
+void ClientRadialFloraManager::update (const Vector& origin) const
 {
-	clearFloraEntries_w.clear();
+	PerformanceTimer timer;
+	timer.start ();
 
-	const Vector position2d (origin.x, 0.f, origin.z);
+	//-- apply the flora found by the last gather before looking at the nodes again
+	finishGather ();
 
-	ClearFloraEntryMap::iterator iter = ms_clearFloraEntryMap.begin ();
-	for (; iter != ms_clearFloraEntryMap.end (); ++iter)
+	const Vector newOrigin (origin.x, 0.f, origin.z);
+	if (m_radialNodeList.empty())
 	{
-		ClientRadialFloraManager::ClearFloraEntry* const clearFloraEntry = iter->second;
+		m_oldOrigin = newOrigin;
+	}
+	else if (newOrigin != m_oldOrigin || !m_regionList.empty () || m_hasPendingNodes)
+	{
+		collect (newOrigin);
 
-		float dist = clearFloraEntry->m_center_w.magnitudeBetween(position2d);
+		m_oldOrigin = newOrigin;
 
-		//-- check to see if within the global sphere
-		if (dist - maximumDistance < clearFloraEntry->m_radius)
+		if (!m_gatherEntryList.empty ())
 		{
-			TestClearFloraEntry testEntry;
-			testEntry.entry=clearFloraEntry;
-			testEntry.m_center_w=clearFloraEntry->m_center_w;
-			testEntry.m_radius=clearFloraEntry->m_radius;
-			clearFloraEntries_w.push_back(testEntry);
+			if (m_clearFloraGrid->needsRebuild (newOrigin, m_maximumDistance))
+			{
+				m_clearFloraGrid->build (newOrigin, m_maximumDistance);
+				++ms_numberOfClearFloraGridRebuilds;
+			}
+
+			resizeFloraData (static_cast<int> (m_gatherEntryList.size ()));
+
+			if (ms_multiThreaded && !ms_disableGatherThread)
+				startGather ();
+			else
+			{
+				gather ();
+				apply ();
+			}
 		}
 	}
+
+	timer.stop ();
+	ms_mainThreadTime += timer.getElapsedTime ();
 }
 
 //-------------------------------------------------------------------
 
-void ClientRadialFloraManager::update (const Vector& origin) const
+void ClientRadialFloraManager::waitForGather () const
 {
-	const Vector newOrigin (origin.x, 0.f, origin.z);
-	if (m_radialNodeList.empty())
-	{
-		m_oldOrigin = newOrigin;
+	if (!m_gatherInProgress)
 		return;
-	}
 
-	if (newOrigin == m_oldOrigin && m_regionList.empty ())
+	PerformanceTimer timer;
+	timer.start ();
+
+	m_gatherCompleteGate.wait ();
+	m_gatherInProgress = false;
+
+	timer.stop ();
+	ms_gatherStallTime += timer.getElapsedTime ();
+	ms_gatherThreadTime += m_gatherTime;
+}
+
+//===================================================================
+// PRIVATE ClientRadialFloraManager
+//===================================================================
+
+bool ClientRadialFloraManager::shouldClearFlora (float const positionX, float const positionZ) const
+{
+	//-- check x and z
+	if (  positionX> m_mapHalfWidthInMeters 
+		|| positionZ> m_mapHalfWidthInMeters
+		|| positionX<-m_mapHalfWidthInMeters
+		|| positionZ<-m_mapHalfWidthInMeters
+		)
 	{
-		return;
+		return false;
 	}
 
-	float mapHalfWidthInMeters = m_mapHalfWidthInMeters;
-	float maxDistSqr = sqr(m_maximumDistance);
-	RadialNodeReference *ri = &m_radialNodeList[0];
-	RadialNodeReference *const ristop = ri + m_radialNodeList.size();
+	return m_clearFloraGrid->isCleared (positionX, positionZ);
+}
+
+//-------------------------------------------------------------------
+/**
+ * Moves the nodes that fell out of the circle, strips their old flora and
+ * queues the nodes that need a flora lookup or a new height. At most
+ * ms_maximumNumberOfGatherEntries nodes are queued per update; the rest
+ * stay pending and are picked up by the following updates, starting
+ * where this one stopped.
+ */
+
+void ClientRadialFloraManager::collect (const Vector& newOrigin) const
+{
+	DEBUG_FATAL (m_gatherInProgress, ("ClientRadialFloraManager::collect - gather in progress"));
 
-	_updateClearFloraEntryVector(origin, m_maximumDistance);
+	m_gatherEntryList.clear ();
+	m_hasPendingNodes = false;
 
-	for (;ri!=ristop;++ri)
+	const bool   originMoved   = newOrigin != m_oldOrigin;
+	const float  maxDistSqr    = sqr (m_maximumDistance);
+	const int    numberOfNodes = static_cast<int> (m_radialNodeList.size ());
+
+	int numberOfPendingNodes = 0;
+
+	int i;
+	for (i = 0; i < numberOfNodes; ++i)
 	{
+		RadialNodeReference* const ri = &m_radialNodeList [i];
+
 	#ifdef _DEBUG
 		_verifyRadialNodeReference(*ri);
 	#endif
 
 		RadialNode* const radialNode = ri->nodePointer;
 
-		bool         needsHeightSet = false;
-
-		float        magSqr = sqr(ri->position_x-newOrigin.x) + sqr(ri->position_z-newOrigin.z);
-		bool         outsideCircle  = magSqr > maxDistSqr;
-
-		Vector position;
+		const float  magSqr        = sqr(ri->position_x-newOrigin.x) + sqr(ri->position_z-newOrigin.z);
+		const bool   outsideCircle = magSqr > maxDistSqr;
 
 		DEBUG_FATAL(!ri->floraAllowed && ri->hasFlora, ("Node has flora when its not allowed."));
 
-		//-- see if we need to replace a RadialNode
-		if (outsideCircle || !ri->floraAllowed)
+		if (outsideCircle)
 		{
-			if (outsideCircle)
-			{
-				const Vector oldPosition (ri->position_x, 0.f, ri->position_z);
+			const Vector oldPosition (ri->position_x, 0.f, ri->position_z);
 
-				//-- flora fell out of circle, so mirror its position in its old circle into the new circle
-				position = oldPosition - m_oldOrigin;
-				position = -position;
-				position += newOrigin;
+			//-- flora fell out of circle, so mirror its position in its old circle into the new circle
+			Vector position = oldPosition - m_oldOrigin;
+			position = -position;
+			position += newOrigin;
 
-				radialNode->setPosition (position);
-				ri->position_x=position.x;
-				ri->position_z=position.z;
-			}
+			radialNode->setPosition (position);
+			ri->position_x=position.x;
+			ri->position_z=position.z;
 
-			//-- figure out if a piece is supposed to go there
 			if (ri->hasFlora)
 			{
-				needsHeightSet = outsideCircle;
-
 				radialNode->setHasFlora (false);
 				ri->hasFlora=false;
 			}
 
-			bool shouldCreate = !shouldClearFlora(ri->position_x, ri->position_z, mapHalfWidthInMeters);
+			if (ri->floraAllowed)
+			{
+				radialNode->setFloraAllowed (false);
+				ri->floraAllowed=false;
+			}
+
+			ri->pendingFlora=true;
+			ri->pendingHeight=false;
+		}
+		else if (!ri->floraAllowed)
+		{
+			//-- the terrain under the node may have become available
+			if (originMoved || isWithinDirtyRegion (ri->position_x, ri->position_z))
+				ri->pendingFlora=true;
+		}
+		else if (ri->hasFlora && isWithinDirtyRegion (ri->position_x, ri->position_z))
+		{
+			//-- make sure the ground hasn't changed from under the object
+			ri->pendingHeight=true;
+		}
+
+		if (ri->pendingFlora || ri->pendingHeight)
+			++numberOfPendingNodes;
+
+	#ifdef _DEBUG
+		_verifyRadialNodeReference(*ri);
+	#endif
+	}
+
+	if (numberOfPendingNodes == 0)
+		return;
+
+	//-- queue the pending nodes round robin so no part of the circle starves
+	const int numberOfGatherEntries = std::min (numberOfPendingNodes, ms_maximumNumberOfGatherEntries);
+	m_gatherEntryList.reserve (numberOfGatherEntries);
+
+	if (m_nextGatherIndex >= numberOfNodes)
+		m_nextGatherIndex = 0;
+
+	for (i = 0; i < numberOfNodes && static_cast<int> (m_gatherEntryList.size ()) < numberOfGatherEntries; ++i)
+	{
+		const int nodeIndex = (m_nextGatherIndex + i) % numberOfNodes;
+		const RadialNodeReference& reference = m_radialNodeList [nodeIndex];
+
+		if (!reference.pendingFlora && !reference.pendingHeight)
+			continue;
+
+		GatherEntry entry;
+		entry.nodeIndex    = nodeIndex;
+		entry.position_x   = reference.position_x;
+		entry.position_z   = reference.position_z;
+		entry.findFlora    = reference.pendingFlora;
+		entry.floats       = !reference.pendingFlora && reference.nodePointer->shouldFloat ();
+		entry.floraFound   = false;
+		entry.floraAllowed = false;
+		entry.heightSet    = false;
+		entry.height       = 0.f;
+		entry.normal       = Vector::unitY;
+		m_gatherEntryList.push_back (entry);
+	}
+
+	m_nextGatherIndex = (m_nextGatherIndex + i) % numberOfNodes;
+	m_hasPendingNodes = numberOfPendingNodes > numberOfGatherEntries;
+
+	ms_numberOfGatherEntries += numberOfGatherEntries;
+	ms_numberOfDeferredUpdates += numberOfPendingNodes - numberOfGatherEntries;
+}
+
+//-------------------------------------------------------------------
+/**
+ * Looks up the flora and terrain height for every queued node. This may
+ * run on the gather thread, so it must only touch the gather entries, the
+ * flora data of the derived class, the clear flora grid and the terrain.
+ */
+
+void ClientRadialFloraManager::gather () const
+{
+	PerformanceTimer timer;
+	timer.start ();
+
+	const int numberOfEntries = static_cast<int> (m_gatherEntryList.size ());
+	for (int i = 0; i < numberOfEntries; ++i)
+	{
+		GatherEntry& entry = m_gatherEntryList [i];
+
+		if (entry.findFlora)
+		{
+			//-- figure out if a piece is supposed to go there
+			if (shouldClearFlora (entry.position_x, entry.position_z))
+				continue;
+
+			entry.floraFound = findFlora (entry.position_x, entry.position_z, i, entry.floraAllowed, entry.floats);
+			if (!entry.floraFound)
+				continue;
+
+			DEBUG_FATAL (!entry.floraAllowed, ("can't create flora when it's not allowed"));
+		}
+
+		Vector position (entry.position_x, 0.f, entry.position_z);
+
+		if (entry.floats)
+		{
+			entry.heightSet = m_terrainAppearance.getWaterHeight (position, position.y);
+			position.y += 0.05f;
+		}
+		else
+			entry.heightSet = m_terrainAppearance.getHeight (position, position.y, entry.normal);
+
+		entry.height = position.y;
+	}
+
+	timer.stop ();
+	m_gatherTime = timer.getElapsedTime ();
+}
+
+//-------------------------------------------------------------------
+
+void ClientRadialFloraManager::apply () const
+{
+	DEBUG_FATAL (m_gatherInProgress, ("ClientRadialFloraManager::apply - gather in progress"));
+
+	const int numberOfEntries = static_cast<int> (m_gatherEntryList.size ());
+	for (int i = 0; i < numberOfEntries; ++i)
+	{
+		const GatherEntry& entry = m_gatherEntryList [i];
+
+		RadialNodeReference* const ri = &m_radialNodeList [entry.nodeIndex];
+		RadialNode* const radialNode = ri->nodePointer;
+
+		DEBUG_FATAL (ri->position_x != entry.position_x || ri->position_z != entry.position_z, ("ClientRadialFloraManager::apply - node moved while it was being gathered"));
+
+		if (entry.findFlora)
+		{
+			ri->pendingFlora=false;
 
-			bool floraAllowed = false;
-			if (  shouldCreate
-				&& createFlora(ri->position_x, ri->position_z, radialNode, floraAllowed)
-				)
+			if (entry.floraFound)
 			{
-				DEBUG_FATAL (!floraAllowed, ("can't create flora when it's not allowed"));
+				applyFlora (entry.position_x, entry.position_z, radialNode, i);
 
-				needsHeightSet = true;
 				radialNode->setHasFlora (true);
 				ri->hasFlora=true;
 			}
 
-			if (ri->floraAllowed!=floraAllowed)
+			if (ri->floraAllowed!=entry.floraAllowed)
 			{
-				radialNode->setFloraAllowed (floraAllowed);
-				ri->floraAllowed=floraAllowed;
+				radialNode->setFloraAllowed (entry.floraAllowed);
+				ri->floraAllowed=entry.floraAllowed;
 			}
 		}
 
-	#ifdef _DEBUG
-		_verifyRadialNodeReference(*ri);
-	#endif
+		ri->pendingHeight=false;
 
-		//-- make sure the ground hasn't changed from under the object
-		if (ri->hasFlora)
+		if (ri->hasFlora && entry.heightSet)
 		{
-			if (needsHeightSet || isWithinDirtyRegion(ri->position_x, ri->position_z))
+			const Vector position (entry.position_x, entry.height, entry.position_z);
+			const Vector& normal = entry.normal;
+
+			radialNode->setPosition (position);
+			radialNode->setNormal (normal);
+
+			Transform t = radialNode->getTransform ();
+			t.resetRotate_l2p ();
+			t.yaw_l (position.x + position.z);
+			
+			if (radialNode->shouldAlignToTerrain ())
 			{
-				bool heightSet = false;
-
-				position = radialNode->getPosition ();
-
-				Vector normal = Vector::unitY;
-				if (radialNode->shouldFloat ())
-				{
-					heightSet = m_terrainAppearance.getWaterHeight (position, position.y);
-					position.y += 0.05f;
-				}
-				else
-					heightSet = m_terrainAppearance.getHeight (position, position.y, normal);
-
-				if (heightSet)
-				{
-					radialNode->setPosition (position);
-					radialNode->setNormal (normal);
-
-					Transform t = radialNode->getTransform ();
-					t.resetRotate_l2p ();
-					t.yaw_l (position.x + position.z);
-					
-					if (radialNode->shouldAlignToTerrain ())
-					{
-						Vector vk = t.getLocalFrameK_p ();
-
-						Vector vi = normal.cross (vk);
-						if (!vi.normalize ())
-							DEBUG_FATAL (true, ("couldn't normalize vector"));
-
-						vk = vi.cross (normal);
-						if (!vk.normalize ())
-							DEBUG_FATAL (true, ("couldn't normalize vector"));
-
-						t.setLocalFrameIJK_p (vi, normal, vk);
-						t.reorthonormalize ();	
-					}
-
-					radialNode->setTransform (t);
-
-					ri->position_x=position.x;
-					ri->position_z=position.z;
-				}
+				Vector vk = t.getLocalFrameK_p ();
+
+				Vector vi = normal.cross (vk);
+				if (!vi.normalize ())
+					DEBUG_FATAL (true, ("couldn't normalize vector"));
+
+				vk = vi.cross (normal);
+				if (!vk.normalize ())
+					DEBUG_FATAL (true, ("couldn't normalize vector"));
+
+				t.setLocalFrameIJK_p (vi, normal, vk);
+				t.reorthonormalize ();	
 			}
+
+			radialNode->setTransform (t);
 		}
+
 	#ifdef _DEBUG
 		_verifyRadialNodeReference(*ri);
 	#endif
 	}
 
-	m_oldOrigin = newOrigin;
+	m_gatherEntryList.clear ();
+}
+
+//-------------------------------------------------------------------
+
+void ClientRadialFloraManager::startGather () const
+{
+	DEBUG_FATAL (m_gatherInProgress, ("ClientRadialFloraManager::startGather - gather in progress"));
+
+	//-- create the thread to gather the flora
+	if (!m_gatherThread)
+	{
+		MemberFunctionThreadZero<ClientRadialFloraManager> * memberFunction = new MemberFunctionThreadZero<ClientRadialFloraManager>("ClientRadialFlora", *const_cast<ClientRadialFloraManager*> (this), &ClientRadialFloraManager::threadRoutine);
+		m_gatherThread = MemberFunctionThreadZero<ClientRadialFloraManager>::Handle (memberFunction);
+		m_gatherThread->setPriority(Thread::kNormal);
+	}  //lint !e429  //-- memberFunction has not been freed or returned
+
+	m_gatherInProgress = true;
+	m_gatherCompleteGate.close ();
+
+	m_gatherCriticalSection.enter ();
+		m_gatherRequested = true;
+		m_gatherRequestGate.open ();
+	m_gatherCriticalSection.leave ();
+}
+
+//-------------------------------------------------------------------
+
+void ClientRadialFloraManager::finishGather () const
+{
+	waitForGather ();
+
+	if (!m_gatherEntryList.empty ())
+		apply ();
+}
+
+//-------------------------------------------------------------------
+
+void ClientRadialFloraManager::discardGather ()
+{
+	waitForGather ();
+
+	m_gatherEntryList.clear ();
+	m_hasPendingNodes = false;
+	m_nextGatherIndex = 0;
+}
+
+//-------------------------------------------------------------------
+
+void ClientRadialFloraManager::threadRoutine ()
+{
+	for (;;)
+	{
+		m_gatherRequestGate.wait ();
+
+		m_gatherCriticalSection.enter ();
+
+			if (m_quitGatherThread)
+			{
+				m_gatherCriticalSection.leave ();
+				return;
+			}
+
+			const bool gatherRequested = m_gatherRequested;
+			m_gatherRequested = false;
+			m_gatherRequestGate.close ();
+
+		m_gatherCriticalSection.leave ();
+
+		if (gatherRequested)
+		{
+			gather ();
+			m_gatherCompleteGate.open ();
+		}
+	}
+}
+
+//===================================================================
+// ClientRadialFloraManager::ClearFloraGrid
+//===================================================================
+
+ClientRadialFloraManager::ClearFloraGrid::ClearFloraGrid () :
+	m_revision (-1),
+	m_centerX (0.f),
+	m_centerZ (0.f),
+	m_maximumDistance (0.f),
+	m_x0 (0.f),
+	m_z0 (0.f),
+	m_cellSize (1.f),
+	m_oneOverCellSize (1.f),
+	m_width (0),
+	m_cellList (),
+	m_circleList ()
+{
+}
+
+//-------------------------------------------------------------------
+
+bool ClientRadialFloraManager::ClearFloraGrid::needsRebuild (const Vector& origin, float const maximumDistance) const
+{
+	if (m_revision != ms_clearFloraEntryMapRevision || m_maximumDistance != maximumDistance)
+		return true;
+
+	const float slack = maximumDistance * 0.5f;
+	return fabsf (origin.x - m_centerX) > slack || fabsf (origin.z - m_centerZ) > slack;
+}
+
+//-------------------------------------------------------------------
+
+void ClientRadialFloraManager::ClearFloraGrid::build (const Vector& origin, float const maximumDistance)
+{
+	m_revision        = ms_clearFloraEntryMapRevision;
+	m_centerX         = origin.x;
+	m_centerZ         = origin.z;
+	m_maximumDistance = maximumDistance;
+
+	//-- cover the flora circle plus the slack allowed by needsRebuild
+	const float halfWidth = maximumDistance * 1.5f;
+
+	m_cellSize        = std::max (cms_minimumClearFloraGridCellSize, 2.f * halfWidth / static_cast<float> (cms_maximumClearFloraGridWidth));
+	m_oneOverCellSize = 1.f / m_cellSize;
+	m_width           = std::max (1, static_cast<int> (ceilf (2.f * halfWidth * m_oneOverCellSize)));
+	m_x0              = origin.x - halfWidth;
+	m_z0              = origin.z - halfWidth;
+
+	const float x1 = m_x0 + static_cast<float> (m_width) * m_cellSize;
+	const float z1 = m_z0 + static_cast<float> (m_width) * m_cellSize;
+
+	m_cellList.assign (m_width * m_width + 1, 0);
+	m_circleList.clear ();
+
+	//-- collect the circles that overlap the grid along with the cells they touch
+	CellRangeList cellRangeList;
+
+	ClearFloraEntryMap::const_iterator end = ms_clearFloraEntryMap.end ();
+	for (ClearFloraEntryMap::const_iterator iter = ms_clearFloraEntryMap.begin (); iter != end; ++iter)
+	{
+		const ClearFloraEntry* const clearFloraEntry = iter->second;
+
+		//-- check to see if the global sphere touches the grid
+		const Vector& center = clearFloraEntry->m_center_w;
+		const float   radius = clearFloraEntry->m_radius;
+		if (center.x + radius < m_x0 || center.x - radius > x1 || center.z + radius < m_z0 || center.z - radius > z1)
+			continue;
+
+		const ClearFloraEntryList& clearFloraEntryList_w = clearFloraEntry->m_clearFloraEntryList_w;
+		for (uint i = 0; i < clearFloraEntryList_w.size (); ++i)
+		{
+			const Vector& circleCenter = clearFloraEntryList_w [i].first;
+			const float   circleRadius = clearFloraEntryList_w [i].second;
+
+			CellRange cellRange;
+			cellRange.circle.x             = circleCenter.x;
+			cellRange.circle.z             = circleCenter.z;
+			cellRange.circle.radiusSquared = sqr (circleRadius);
+			cellRange.x0 = std::max (0, static_cast<int> (floorf ((circleCenter.x - circleRadius - m_x0) * m_oneOverCellSize)));
+			cellRange.z0 = std::max (0, static_cast<int> (floorf ((circleCenter.z - circleRadius - m_z0) * m_oneOverCellSize)));
+			cellRange.x1 = std::min (m_width - 1, static_cast<int> (floorf ((circleCenter.x + circleRadius - m_x0) * m_oneOverCellSize)));
+			cellRange.z1 = std::min (m_width - 1, static_cast<int> (floorf ((circleCenter.z + circleRadius - m_z0) * m_oneOverCellSize)));
+
+			if (cellRange.x0 <= cellRange.x1 && cellRange.z0 <= cellRange.z1)
+				cellRangeList.push_back (cellRange);
+		}
+	}
+
+	if (cellRangeList.empty ())
+		return;
+
+	//-- count the circles per cell and turn the counts into offsets
+	CellRangeList::const_iterator rangeIter;
+	for (rangeIter = cellRangeList.begin (); rangeIter != cellRangeList.end (); ++rangeIter)
+		for (int z = rangeIter->z0; z <= rangeIter->z1; ++z)
+			for (int x = rangeIter->x0; x <= rangeIter->x1; ++x)
+				++m_cellList [z * m_width + x + 1];
+
+	const int numberOfCells = m_width * m_width;
+
+	int cell;
+	for (cell = 0; cell < numberOfCells; ++cell)
+		m_cellList [cell + 1] += m_cellList [cell];
+
+	//-- fill the cells
+	m_circleList.resize (m_cellList [numberOfCells]);
+
+	CellList cursorList (m_cellList.begin (), m_cellList.end () - 1);
+	for (rangeIter = cellRangeList.begin (); rangeIter != cellRangeList.end (); ++rangeIter)
+		for (int z = rangeIter->z0; z <= rangeIter->z1; ++z)
+			for (int x = rangeIter->x0; x <= rangeIter->x1; ++x)
+				m_circleList [cursorList [z * m_width + x]++] = rangeIter->circle;
+}
+
+//-------------------------------------------------------------------
+
+bool ClientRadialFloraManager::ClearFloraGrid::isCleared (float const positionX, float const positionZ) const
+{
+	if (m_circleList.empty ())
+		return false;
+
+	const int x = static_cast<int> (floorf ((positionX - m_x0) * m_oneOverCellSize));
+	const int z = static_cast<int> (floorf ((positionZ - m_z0) * m_oneOverCellSize));
+	if (x < 0 || x >= m_width || z < 0 || z >= m_width)
+		return false;
+
+	const int cell = z * m_width + x;
+	for (int i = m_cellList [cell]; i < m_cellList [cell + 1]; ++i)
+	{
+		const Circle& circle = m_circleList [i];
+		if (sqr (circle.x - positionX) + sqr (circle.z - positionZ) < circle.radiusSquared)
+			return true;
+	}
+
+	return false;
+}
+
+//-------------------------------------------------------------------
+
+int ClientRadialFloraManager::ClearFloraGrid::getNumberOfCells () const
+{
+	return m_width * m_width;
+}
+
+//-------------------------------------------------------------------
+
+int ClientRadialFloraManager::ClearFloraGrid::getNumberOfCircles () const
+{
+	return static_cast<int> (m_circleList.size ());
 }
 
 //===================================================================
@@ -798,6 +1245,20 @@ void ClientRadialFloraManagerNamespace::debugReport ()
 		total += iter->second->m_clearFloraEntryList->size ();
 
 	DEBUG_REPORT_PRINT (true, ("total entries = %i\n", total));
+	DEBUG_REPORT_PRINT (true, ("multiThreaded = %s\n", (ms_multiThreaded && !ms_disableGatherThread) ? "yes" : "no"));
+	DEBUG_REPORT_PRINT (true, ("  main thread = %1.3f ms\n", ms_mainThreadTime * 1000.f));
+	DEBUG_REPORT_PRINT (true, ("       stalls = %1.3f ms\n", ms_gatherStallTime * 1000.f));
+	DEBUG_REPORT_PRINT (true, ("gather thread = %1.3f ms\n", ms_gatherThreadTime * 1000.f));
+	DEBUG_REPORT_PRINT (true, ("      updated = %i\n", ms_numberOfGatherEntries));
+	DEBUG_REPORT_PRINT (true, ("     deferred = %i\n", ms_numberOfDeferredUpdates));
+	DEBUG_REPORT_PRINT (true, (" grid rebuilt = %i\n", ms_numberOfClearFloraGridRebuilds));
+
+	ms_mainThreadTime = 0.f;
+	ms_gatherStallTime = 0.f;
+	ms_gatherThreadTime = 0.f;
+	ms_numberOfGatherEntries = 0;
+	ms_numberOfDeferredUpdates = 0;
+	ms_numberOfClearFloraGridRebuilds = 0;
 }
 
 //===================================================================
@@ -14,7 +14,10 @@
 
 #include "sharedMath/Rectangle2d.h"
 #include "sharedMath/Vector.h"
+#include "sharedSynchronization/Gate.h"
+#include "sharedSynchronization/Mutex.h"
 #include "sharedTerrain/FloraManager.h"
+#include "sharedThread/ThreadHandle.h"
 
 #include <vector>
 
@@ -41,6 +44,9 @@ public:
 	static void addClearFloraObject (const Object* object, const ClearFloraEntryList& clearFloraEntryList);
 	static void removeClearFloraObject (const Object* object);
 
+	static bool getMultiThreaded ();
+	static void setMultiThreaded (bool multiThreaded);
+
 public:
 
 	ClientRadialFloraManager (const ClientProceduralTerrainAppearance& terrainAppearance, const bool& enabled, float minimumDistance, float const & maximumDistance);
@@ -55,6 +61,8 @@ public:
 	bool isEnabled () const;
 	const ClientProceduralTerrainAppearance &getTerrainAppearance() const { return m_terrainAppearance; }
 
+	void waitForGather () const;
+
 	virtual void alter (float time);
 	virtual void preRender (const Camera* camera);
 	virtual void draw () const=0;
@@ -116,14 +124,12 @@ protected:
 		friend class ClientRadialFloraManager;
 	};
 
-protected:
-
-	static bool shouldClearFlora(float positionX, float positionZ, float mapHalfWidthInMeters);
-
 protected:
 
 	virtual RadialNode* createRadialNode (const Vector& position) const=0;
-	virtual bool        createFlora (float positionX, float positionZ, RadialNode* radialNode, bool& floraAllowed) const=0;
+	virtual void        resizeFloraData (int numberOfEntries) const=0;
+	virtual bool        findFlora (float positionX, float positionZ, int entryIndex, bool& floraAllowed, bool& floats) const=0;
+	virtual void        applyFlora (float positionX, float positionZ, RadialNode* radialNode, int entryIndex) const=0;
 	virtual void        maximumDistanceChanged ();
 
 protected:
@@ -140,8 +146,10 @@ protected:
 		RadialNode *nodePointer;
 		float position_x;
 		float position_z;
-		uint8 floraAllowed : 1;
-		uint8 hasFlora     : 1;
+		uint8 floraAllowed  : 1;
+		uint8 hasFlora      : 1;
+		uint8 pendingFlora  : 1;
+		uint8 pendingHeight : 1;
 	};
 
 	typedef std::vector<Rectangle2d>          RegionList;
@@ -153,6 +161,41 @@ protected:
 	void _verifyRadialNodeReference(const RadialNodeReference &reference) const;
 #endif
 
+private:
+
+	//-- a node that needs a flora lookup and/or a terrain height. the inputs
+	//-- are filled out on the main thread, the results by gather ()
+	struct GatherEntry
+	{
+		int    nodeIndex;
+		float  position_x;
+		float  position_z;
+		bool   findFlora;
+		bool   floats;
+		bool   floraFound;
+		bool   floraAllowed;
+		bool   heightSet;
+		float  height;
+		Vector normal;
+	};
+
+	class ClearFloraGrid;
+
+	typedef std::vector<GatherEntry>          GatherEntryList;
+
+private:
+
+	bool shouldClearFlora (float positionX, float positionZ) const;
+
+	void collect (const Vector& newOrigin) const;
+	void gather () const;
+	void apply () const;
+	void startGather () const;
+	void finishGather () const;
+	void discardGather ();
+
+	void threadRoutine ();
+
 protected:
 
 	std::string*                             m_debugName;
@@ -173,6 +216,25 @@ protected:
 	
 	mutable Vector                           m_oldOrigin;
 
+private:
+
+	mutable GatherEntryList                  m_gatherEntryList;
+	mutable bool                             m_hasPendingNodes;
+	mutable int                              m_nextGatherIndex;
+	ClearFloraGrid* const                    m_clearFloraGrid;
+
+	//-- the gather runs on the worker thread between update () and the next
+	//-- waitForGather (). only the terrain appearance may change its chunk
+	//-- tree in between, and it calls waitForGather () before doing so
+	mutable Mutex                            m_gatherCriticalSection;
+	mutable Gate                             m_gatherRequestGate;
+	mutable Gate                             m_gatherCompleteGate;
+	mutable ThreadHandle                     m_gatherThread;
+	mutable bool                             m_gatherRequested;
+	mutable bool                             m_gatherInProgress;
+	bool                                     m_quitGatherThread;
+	mutable float                            m_gatherTime;
+
 private:
 
 	ClientRadialFloraManager (void);
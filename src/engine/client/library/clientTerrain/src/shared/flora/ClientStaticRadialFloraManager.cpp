@@ -445,7 +445,8 @@ void ClientStaticRadialFloraManager::setRenderDetailLevelFunction (RenderDetailL
 
 ClientStaticRadialFloraManager::ClientStaticRadialFloraManager (const ClientProceduralTerrainAppearance& terrainAppearance, const bool& enabled, float minimumDistance, float const & maximumDistance, FindFloraFunction findFloraFunction) :
 	ClientRadialFloraManager (terrainAppearance, enabled, minimumDistance, maximumDistance),
-	m_findFloraFunction (findFloraFunction)
+	m_findFloraFunction (findFloraFunction),
+	m_floraDataList ()
 #ifdef _DEBUG
 	, m_nextObjectId (0)
 #endif
@@ -456,6 +457,9 @@ ClientStaticRadialFloraManager::ClientStaticRadialFloraManager (const ClientProc
 
 ClientStaticRadialFloraManager::~ClientStaticRadialFloraManager (void)
 {
+	//-- the gather thread may still be calling findFlora
+	waitForGather ();
+
 	std::for_each (m_floraNodeList.begin (), m_floraNodeList.end (), PointerDeleter ());
 
 	m_findFloraFunction = 0;
@@ -654,61 +658,76 @@ bool ClientStaticRadialFloraManager::approximateCollide (const Vector& start_w,
 
 //-------------------------------------------------------------------
 
-bool ClientStaticRadialFloraManager::createFlora (float positionX, float positionZ, RadialNode* radialNode, bool& floraAllowed) const
+void ClientStaticRadialFloraManager::resizeFloraData (int const numberOfEntries) const
+{
+	m_floraDataList.resize (static_cast<size_t> (numberOfEntries));
+}
+
+//-------------------------------------------------------------------
+
+bool ClientStaticRadialFloraManager::findFlora (float const positionX, float const positionZ, int const entryIndex, bool& floraAllowed, bool& floats) const
 {
 	//-- see if flora exists at that position on the terrain
-	ClientProceduralTerrainAppearance::StaticFloraData staticFloraData;
+	ClientProceduralTerrainAppearance::StaticFloraData& staticFloraData = m_floraDataList [static_cast<size_t> (entryIndex)];
 	if ((m_terrainAppearance.*m_findFloraFunction) (positionX, positionZ, staticFloraData, floraAllowed))
 	{
-		StaticRadialNode* const staticRadialNode = safe_cast<StaticRadialNode*> (radialNode);
+		floats = staticFloraData.floats;
+		return true;
+	}
 
-		//-- find appearance if it has been created
-		uint i;
-		for (i = 0; i < m_floraNodeList.size (); ++i)
-			if (m_floraNodeList[i]->getStaticFloraData ().familyChildData->appearanceTemplateName == staticFloraData.familyChildData->appearanceTemplateName)
-				break;
+	return false;
+}
 
-		//-- we can't use an existing template, so create a new one
-		if (i == m_floraNodeList.size ())
-			m_floraNodeList.push_back (new StaticFloraNode (staticFloraData));
+//-------------------------------------------------------------------
 
-		//-- see if the radial node currently represents the object's existing appearance
-		if (staticRadialNode->getStaticFloraNode () != m_floraNodeList[i])
-		{
-			//
-			//-- set the object's appearance
-			//
-			Object* const          object             = staticRadialNode->m_object;
-			object->resetRotate_o2p ();
-			object->yaw_o (positionX + positionZ);
-			StaticFloraNode* const newStaticFloraNode = m_floraNodeList[i];
-
-			//-- cache the old one
-			if (object->getAppearance ())
-			{
-				NOT_NULL (staticRadialNode->getStaticFloraNode ());
+void ClientStaticRadialFloraManager::applyFlora (float const positionX, float const positionZ, RadialNode* const radialNode, int const entryIndex) const
+{
+	const ClientProceduralTerrainAppearance::StaticFloraData& staticFloraData = m_floraDataList [static_cast<size_t> (entryIndex)];
 
-				StaticFloraNode* const oldStaticFloraNode = staticRadialNode->getStaticFloraNode ();
-				oldStaticFloraNode->destroyAppearance (object->stealAppearance ());
-			}
+	StaticRadialNode* const staticRadialNode = safe_cast<StaticRadialNode*> (radialNode);
 
-			//-- set the new one
-			Appearance * const appearance = newStaticFloraNode->createAppearance ();
-			appearance->setKeepAlive (true);
-			object->setAppearance (appearance);
+	//-- find appearance if it has been created
+	uint i;
+	for (i = 0; i < m_floraNodeList.size (); ++i)
+		if (m_floraNodeList[i]->getStaticFloraData ().familyChildData->appearanceTemplateName == staticFloraData.familyChildData->appearanceTemplateName)
+			break;
 
-			//-- record which appearance data we're using
-			DEBUG_FATAL (i >= m_floraNodeList.size (), (""));
-			staticRadialNode->setStaticFloraNode (newStaticFloraNode);
+	//-- we can't use an existing template, so create a new one
+	if (i == m_floraNodeList.size ())
+		m_floraNodeList.push_back (new StaticFloraNode (staticFloraData));
+
+	//-- see if the radial node currently represents the object's existing appearance
+	if (staticRadialNode->getStaticFloraNode () != m_floraNodeList[i])
+	{
+		//
+		//-- set the object's appearance
+		//
+		Object* const          object             = staticRadialNode->m_object;
+		object->resetRotate_o2p ();
+		object->yaw_o (positionX + positionZ);
+		StaticFloraNode* const newStaticFloraNode = m_floraNodeList[i];
+
+		//-- cache the old one
+		if (object->getAppearance ())
+		{
+			NOT_NULL (staticRadialNode->getStaticFloraNode ());
 
-			const Vector scale = staticFloraData.familyChildData->shouldScale ? Vector::xyz111 * Random::randomReal (staticFloraData.familyChildData->minimumScale, staticFloraData.familyChildData->maximumScale) : Vector::xyz111;
-			object->setScale (scale);
+			StaticFloraNode* const oldStaticFloraNode = staticRadialNode->getStaticFloraNode ();
+			oldStaticFloraNode->destroyAppearance (object->stealAppearance ());
 		}
 
-		return true;
-	}
+		//-- set the new one
+		Appearance * const appearance = newStaticFloraNode->createAppearance ();
+		appearance->setKeepAlive (true);
+		object->setAppearance (appearance);
 
-	return false;
+		//-- record which appearance data we're using
+		DEBUG_FATAL (i >= m_floraNodeList.size (), (""));
+		staticRadialNode->setStaticFloraNode (newStaticFloraNode);
+
+		const Vector scale = staticFloraData.familyChildData->shouldScale ? Vector::xyz111 * Random::randomReal (staticFloraData.familyChildData->minimumScale, staticFloraData.familyChildData->maximumScale) : Vector::xyz111;
+		object->setScale (scale);
+	}
 }
 
 //-------------------------------------------------------------------
@@ -49,11 +49,14 @@ private:
 private:
 
 	typedef std::vector<StaticFloraNode*> FloraNodeList;
+	typedef std::vector<ClientProceduralTerrainAppearance::StaticFloraData> FloraDataList;
 
 private:
 
 	virtual RadialNode* createRadialNode (const Vector& position) const;
-	virtual bool        createFlora (float positionX, float positionZ, RadialNode* radialNode, bool& floraAllowed) const;
+	virtual void        resizeFloraData (int numberOfEntries) const;
+	virtual bool        findFlora (float positionX, float positionZ, int entryIndex, bool& floraAllowed, bool& floats) const;
+	virtual void        applyFlora (float positionX, float positionZ, RadialNode* radialNode, int entryIndex) const;
 	virtual void        maximumDistanceChanged ();
 
 private:
@@ -65,6 +68,7 @@ private:
 private:
 
 	mutable FloraNodeList  m_floraNodeList;
+	mutable FloraDataList  m_floraDataList;
 	FindFloraFunction      m_findFloraFunction;
 
 #ifdef _DEBUG
@@ -794,6 +794,9 @@ void ShaderRenderSetCommand::execute(const BlueprintTextureRendererTemplate &trT
 	VALIDATE_RANGE_INCLUSIVE_EXCLUSIVE(0, m_shaderIndex, static_cast<int>(shaders.size()));
 	const StaticShader &shader = NON_NULL(shaders[static_cast<size_t>(m_shaderIndex)])->prepareToView();
 
+	//-- the baked texture keeps whatever levels its sources have now, and they are never reported to the streamer
+	shader.loadTextureTopMipmapLevels();
+
 	const int passCount = shader.getNumberOfPasses();
 	for (int i = 0; i < passCount; ++i)
 	{
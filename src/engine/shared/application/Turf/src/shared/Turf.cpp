@@ -30,6 +30,7 @@
 #include "sharedTerrain/ProceduralTerrainAppearanceTemplate.h"
 #include "sharedTerrain/SamplerProceduralTerrainAppearanceTemplate.h"
 #include "sharedTerrain/CoordinateHash.h"
+#include "sharedTerrain/TerrainGeneratorProfiler.h"
 #include "sharedObject/Appearance.h"
 #include "sharedObject/AppearanceTemplate.h"
 #include "sharedObject/AppearanceTemplateList.h"
@@ -346,6 +347,26 @@ void TurfApp::run(int argc, char *argv[])
 					m_files.pop_front();
 				}
 				break;
+			case 'P':
+				// 'P' profiles all following terrain generation, 'PW' writes the JSON report to the last file given
+				if (toupper(arg[1])=='W')
+				{
+					if (!m_files.empty())
+					{
+						if (TerrainGeneratorProfiler::writeReport(m_files.front().c_str()))
+						{
+							REPORT_LOG_PRINT(true, ("Wrote terrain generator profile: %s\n", m_files.front().c_str()));
+						}
+						m_files.pop_front();
+					}
+				}
+				else
+				{
+					REPORT_PRINT(true, ("Profiling terrain generation\n"));
+					TerrainGeneratorProfiler::reset();
+					TerrainGeneratorProfiler::setEnabled(true);
+				}
+				break;
 			case 'R':
 				if (arg[1]=='(' || arg[1]=='"')
 				{
@@ -0,0 +1 @@
+#include "../../src/shared/ProfilerTimeline.h"
\ No newline at end of file
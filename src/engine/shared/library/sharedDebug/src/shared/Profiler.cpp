@@ -12,11 +12,13 @@
 
 #include "sharedDebug/DebugFlags.h"
 #include "sharedDebug/DebugKey.h"
+#include "sharedDebug/ProfilerTimeline.h"
 #include "sharedDebug/ProfilerTimer.h"
 #include "sharedFoundation/ConfigFile.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/MemoryBlockManager.h"
 #include "sharedFoundation/MemoryBlockManagerMacros.h"
+#include "sharedFoundation/Os.h"
 
 #include <vector>
 #include <algorithm>
@@ -120,6 +122,7 @@ namespace ProfilerNamespace
 	bool                          ms_selectedToggle;
 	int                           ms_displayPercentageMinimum;
 	int                           ms_stackDepth;
+	int                           ms_mainThreadDepth;
 	SortedProfilerEntries         ms_sortedProfilerEntries;
 
 }
@@ -253,6 +256,8 @@ void Profiler::remove()
 	ms_previousVisibleExpandableEntry = NULL;
 	ms_profilerEntriesCurrent = NULL;
 	ms_profilerEntriesLast = NULL;
+
+	ProfilerTimeline::remove();
 }
 
 // ----------------------------------------------------------------------
@@ -265,6 +270,8 @@ void Profiler::registerDebugFlags()
 	DebugFlags::registerFlag(ms_debugReportLogFlag, "SharedDebug/Profiler", "logNextReport");
 	DebugFlags::registerFlag(ms_temporaryExpandAll, "SharedDebug/Profiler", "temporaryExpandAll");
 	ms_displayPercentageMinimum = ConfigFile::getKeyInt("SharedDebug/Profiler", "displayPercentageMinimum", 0);
+
+	ProfilerTimeline::registerDebugFlags();
 }
 
 // ----------------------------------------------------------------------
@@ -691,6 +698,12 @@ void Profiler::handleOperation(char const *operation)
 		setTemporaryExpandAll(true);
 	else if (_stricmp(operation, "showNormal") == 0)
 		setTemporaryExpandAll(false);
+	else if (_stricmp(operation, "timelineStart") == 0)
+		ProfilerTimeline::setRecording(true);
+	else if (_stricmp(operation, "timelineStop") == 0)
+		ProfilerTimeline::setRecording(false);
+	else if (_stricmp(operation, "timelineDump") == 0)
+		ProfilerTimeline::requestDump();
 	else if (myCompare("displayMinimum", operation))
 	{
 		const char *result = strchr(operation, ' ');
@@ -812,34 +825,82 @@ void ProfilerNamespace::leaveWithTime(char const *name, ProfilerTimer::Type time
 
 void Profiler::enter(char const *name)
 {
+	// the block stack belongs to the main thread; other threads only show up in the timeline
+	bool const mainThread = Os::isMainThread();
+	bool const timeline = ProfilerTimeline::isRecording();
+	if (!mainThread && !timeline)
+		return;
+
 	ProfilerTimer::Type time;
 	ProfilerTimer::getTime(time);
-	enterWithTime(name, time);
+
+	if (timeline)
+		ProfilerTimeline::enter(name, time);
+
+	if (mainThread)
+	{
+		++ms_mainThreadDepth;
+		enterWithTime(name, time);
+	}
 }
 
 // ----------------------------------------------------------------------
 
 void Profiler::leave(char const *name)
 {
+	bool const mainThread = Os::isMainThread();
+	bool const timeline = ProfilerTimeline::isRecording();
+	if (!mainThread && !timeline)
+		return;
+
 	ProfilerTimer::Type time;
 	ProfilerTimer::getTime(time);
-	leaveWithTime(name, time);
+
+	if (timeline)
+		ProfilerTimeline::leave(name, time);
+
+	if (mainThread)
+	{
+		leaveWithTime(name, time);
+
+		// leaving the outermost block ends the frame
+		if (ms_mainThreadDepth > 0 && --ms_mainThreadDepth == 0)
+			ProfilerTimeline::endFrame(time);
+	}
 }
 
 // ----------------------------------------------------------------------
 
 void Profiler::transfer(char const *leaveName, char const *enterName)
 {
+	bool const mainThread = Os::isMainThread();
+	bool const timeline = ProfilerTimeline::isRecording();
+	if (!mainThread && !timeline)
+		return;
+
 	ProfilerTimer::Type time;
 	ProfilerTimer::getTime(time);
-	leaveWithTime(leaveName, time);
-	enterWithTime(enterName, time);
+
+	if (timeline)
+	{
+		ProfilerTimeline::leave(leaveName, time);
+		ProfilerTimeline::enter(enterName, time);
+	}
+
+	if (mainThread)
+	{
+		leaveWithTime(leaveName, time);
+		enterWithTime(enterName, time);
+	}
 }
 
 // ----------------------------------------------------------------------
 
 void Profiler::adjustForLostBlocks(char const *expectingName)
 {
+	if (!Os::isMainThread())
+		return;
+
 	// This deals with cases where we've either missed closing a block or closed a block that wasn't open.
 	// We prefer to guess that we've failed to close a block, since that is the more common mistake, before
 	// trying to deal with it as though a block was closed but not opened.
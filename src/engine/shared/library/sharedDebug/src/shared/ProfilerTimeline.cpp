@@ -0,0 +1,599 @@
+// ======================================================================
+//
+// ProfilerTimeline.cpp
+// copyright 2026
+//
+// ======================================================================
+
+#include "sharedDebug/FirstSharedDebug.h"
+#include "sharedDebug/ProfilerTimeline.h"
+
+#include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/DebugKey.h"
+#include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/Os.h"
+#include "sharedFoundation/PerThreadData.h"
+#include "sharedFoundation/PointerDeleter.h"
+#include "sharedSynchronization/Mutex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+// ======================================================================
+/**
+ * The events recorded on one thread.
+ *
+ * The owning thread is the only writer.  It stores an event and then
+ * advances the write index, and every store goes through a volatile so
+ * neither is reordered.  Readers copy the buffer without locking and drop
+ * whatever the owner overwrote while they were copying.
+ */
+
+class ProfilerTimelineBuffer
+{
+public:
+
+	enum EventType
+	{
+		ET_enter,
+		ET_leave,
+		ET_counter,
+		ET_frame
+	};
+
+	struct Event
+	{
+		ProfilerTimer::Type  time;
+		char const          *name;
+		int32                value;
+		int32                type;
+	};
+
+	typedef std::vector<Event> Events;
+
+public:
+
+	ProfilerTimelineBuffer(int capacity, Os::ThreadId threadId, bool mainThread);
+	~ProfilerTimelineBuffer();
+
+	void          write(int type, char const *name, int value, ProfilerTimer::Type time);
+	void          copyEvents(Events &events) const;
+
+	Os::ThreadId  getThreadId() const;
+	bool          isMainThread() const;
+
+private:
+
+	// disabled
+	ProfilerTimelineBuffer();
+	ProfilerTimelineBuffer(ProfilerTimelineBuffer const &);
+	ProfilerTimelineBuffer &operator =(ProfilerTimelineBuffer const &);
+
+private:
+
+	Event volatile * const  m_events;
+	uint32 const            m_mask;
+	uint32 volatile         m_writeIndex;
+	Os::ThreadId const      m_threadId;
+	bool const              m_mainThread;
+};
+
+// ======================================================================
+
+namespace ProfilerTimelineNamespace
+{
+	typedef ProfilerTimelineBuffer::Events         Events;
+	typedef std::vector<ProfilerTimelineBuffer *>  Buffers;
+	typedef std::map<Os::ThreadId, std::string>    ThreadNames;
+	typedef std::vector<char const *>              NameStack;
+
+	int const                cs_maxNumberOfBuffers = 64;
+	int const                cs_maxFrameCount      = 1024;
+
+	Mutex                    ms_mutex;
+	Buffers                  ms_buffers;
+	ProfilerTimelineBuffer  *ms_discardBuffer;
+
+	//-- threads without PerThreadData cache their buffer here so they do not take the mutex per event
+#if defined(PLATFORM_WIN32)
+	__declspec(thread) ProfilerTimelineBuffer  *ms_uninstalledThreadBuffer;
+#else
+	__thread ProfilerTimelineBuffer            *ms_uninstalledThreadBuffer;
+#endif
+
+	ThreadNames              ms_threadNames;
+
+	bool                     ms_desiredRecording;
+	bool                     ms_dumpRequested;
+	bool                     ms_debugKeyContext;
+	int                      ms_eventsPerThread = 65536;
+	int                      ms_frameCount = 60;
+	float                    ms_spikeMilliseconds;
+	char const              *ms_filePrefix = "profile";
+	ProfilerTimer::Type      ms_frequency = 1;
+
+	ProfilerTimer::Type      ms_frameEndTimes[cs_maxFrameCount];
+	int                      ms_numberOfFrames;
+	int                      ms_framesSinceDump;
+	Events                   ms_events;
+
+	ProfilerTimelineBuffer  *getBuffer();
+	std::string              getThreadName(ProfilerTimelineBuffer const &buffer);
+	void                     writeString(FILE *file, char const *string);
+	void                     writeEvent(FILE *file, bool &first, char const *name, char const *phase, double timeStamp, unsigned long threadId);
+	void                     writeBuffer(FILE *file, bool &first, ProfilerTimelineBuffer const &buffer, ProfilerTimer::Type beginTime, ProfilerTimer::Type endTime);
+}
+
+using namespace ProfilerTimelineNamespace;
+
+bool ProfilerTimeline::ms_recording;
+
+// ======================================================================
+
+ProfilerTimelineBuffer::ProfilerTimelineBuffer(int const capacity, Os::ThreadId const threadId, bool const mainThread)
+:
+	m_events(new Event[static_cast<size_t>(capacity)]),
+	m_mask(static_cast<uint32>(capacity - 1)),
+	m_writeIndex(0),
+	m_threadId(threadId),
+	m_mainThread(mainThread)
+{
+	DEBUG_FATAL((capacity & (capacity - 1)) != 0, ("ProfilerTimelineBuffer capacity %d is not a power of 2", capacity));
+}
+
+// ----------------------------------------------------------------------
+
+ProfilerTimelineBuffer::~ProfilerTimelineBuffer()
+{
+	delete [] const_cast<Event *>(m_events);
+}
+
+// ----------------------------------------------------------------------
+
+inline void ProfilerTimelineBuffer::write(int const type, char const * const name, int const value, ProfilerTimer::Type const time)
+{
+	uint32 const writeIndex = m_writeIndex;
+
+	Event volatile &event = m_events[writeIndex & m_mask];
+	event.time  = time;
+	event.name  = name;
+	event.value = value;
+	event.type  = type;
+
+	m_writeIndex = writeIndex + 1;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Append the events in the buffer to a list, oldest first.
+ */
+
+void ProfilerTimelineBuffer::copyEvents(Events &events) const
+{
+	uint32 const capacity = m_mask + 1;
+	uint32 const end = m_writeIndex;
+	uint32 const count = std::min(end, capacity);
+	size_t const first = events.size();
+
+	for (uint32 i = end - count; i != end; ++i)
+	{
+		Event volatile const &source = m_events[i & m_mask];
+
+		Event event;
+		event.time  = source.time;
+		event.name  = source.name;
+		event.value = source.value;
+		event.type  = source.type;
+		events.push_back(event);
+	}
+
+	//-- drop the oldest events if the owner wrapped onto them while they were copied, including the one it may be writing now
+	uint32 const written = m_writeIndex - end + 1;
+	if (written + count > capacity)
+	{
+		uint32 const lost = std::min(written + count - capacity, count);
+		events.erase(events.begin() + static_cast<int>(first), events.begin() + static_cast<int>(first + lost));
+	}
+}
+
+// ----------------------------------------------------------------------
+
+inline Os::ThreadId ProfilerTimelineBuffer::getThreadId() const
+{
+	return m_threadId;
+}
+
+// ----------------------------------------------------------------------
+
+inline bool ProfilerTimelineBuffer::isMainThread() const
+{
+	return m_mainThread;
+}
+
+// ======================================================================
+/**
+ * Get the calling thread's buffer, creating it on first use.
+ *
+ * Threads beyond cs_maxNumberOfBuffers, and threads that have not installed
+ * PerThreadData, record into a buffer that is never written out.  The
+ * latter keep it in a thread local pointer, so only their first event
+ * takes the mutex.
+ */
+
+ProfilerTimelineBuffer *ProfilerTimelineNamespace::getBuffer()
+{
+	ProfilerTimelineBuffer *buffer = PerThreadData::getProfilerTimelineBuffer();
+	if (buffer)
+		return buffer;
+
+	bool const threadInstalled = PerThreadData::isThreadInstalled();
+	if (!threadInstalled && ms_uninstalledThreadBuffer)
+		return ms_uninstalledThreadBuffer;
+
+	ms_mutex.enter();
+
+		if (threadInstalled && static_cast<int>(ms_buffers.size()) < cs_maxNumberOfBuffers)
+		{
+			buffer = new ProfilerTimelineBuffer(ms_eventsPerThread, Os::getThreadId(), Os::isMainThread());
+			ms_buffers.push_back(buffer);
+		}
+		else
+		{
+			if (!ms_discardBuffer)
+				ms_discardBuffer = new ProfilerTimelineBuffer(1, Os::getThreadId(), false);
+
+			buffer = ms_discardBuffer;
+		}
+
+	ms_mutex.leave();
+
+	if (threadInstalled)
+		PerThreadData::setProfilerTimelineBuffer(buffer);
+	else
+		ms_uninstalledThreadBuffer = buffer;
+
+	return buffer;
+}
+
+// ----------------------------------------------------------------------
+
+std::string ProfilerTimelineNamespace::getThreadName(ProfilerTimelineBuffer const &buffer)
+{
+	ThreadNames::const_iterator const i = ms_threadNames.find(buffer.getThreadId());
+	if (i != ms_threadNames.end())
+		return i->second;
+
+	if (buffer.isMainThread())
+		return "Main";
+
+	char name[64];
+	IGNORE_RETURN(snprintf(name, sizeof(name), "Thread %lu", static_cast<unsigned long>(buffer.getThreadId())));
+	return name;
+}
+
+// ----------------------------------------------------------------------
+
+void ProfilerTimelineNamespace::writeString(FILE * const file, char const *string)
+{
+	IGNORE_RETURN(fputc('"', file));
+
+	for ( ; *string; ++string)
+	{
+		char const c = *string;
+		if (c == '"' || c == '\\')
+		{
+			IGNORE_RETURN(fputc('\\', file));
+			IGNORE_RETURN(fputc(c, file));
+		}
+		else if (static_cast<unsigned char>(c) < ' ')
+			IGNORE_RETURN(fputc(' ', file));
+		else
+			IGNORE_RETURN(fputc(c, file));
+	}
+
+	IGNORE_RETURN(fputc('"', file));
+}
+
+// ----------------------------------------------------------------------
+
+void ProfilerTimelineNamespace::writeEvent(FILE * const file, bool &first, char const * const name, char const * const phase, double const timeStamp, unsigned long const threadId)
+{
+	IGNORE_RETURN(fputs(first ? "\n{\"name\":" : ",\n{\"name\":", file));
+	first = false;
+
+	writeString(file, name ? name : "?");
+	IGNORE_RETURN(fprintf(file, ",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%lu", phase, timeStamp, threadId));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Write the events of one thread between two times.
+ *
+ * Blocks left in the window but entered before it are dropped, and blocks
+ * still open at the end of the window are closed there, so every thread's
+ * blocks nest properly.
+ */
+
+void ProfilerTimelineNamespace::writeBuffer(FILE * const file, bool &first, ProfilerTimelineBuffer const &buffer, ProfilerTimer::Type const beginTime, ProfilerTimer::Type const endTime)
+{
+	ms_events.clear();
+	buffer.copyEvents(ms_events);
+
+	unsigned long const threadId = static_cast<unsigned long>(buffer.getThreadId());
+	double const microsecondsPerTick = 1000000.0 / static_cast<double>(ms_frequency);
+
+	//-- name the thread
+	IGNORE_RETURN(fputs(first ? "\n{\"name\":\"thread_name\"" : ",\n{\"name\":\"thread_name\"", file));
+	first = false;
+	IGNORE_RETURN(fprintf(file, ",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":", threadId));
+	writeString(file, getThreadName(buffer).c_str());
+	IGNORE_RETURN(fputs("}}", file));
+
+	NameStack openBlocks;
+
+	Events::const_iterator const iEnd = ms_events.end();
+	for (Events::const_iterator i = ms_events.begin(); i != iEnd; ++i)
+	{
+		if (i->time < beginTime || i->time > endTime)
+			continue;
+
+		double const timeStamp = static_cast<double>(i->time - beginTime) * microsecondsPerTick;
+
+		switch (i->type)
+		{
+			case ProfilerTimelineBuffer::ET_enter:
+				openBlocks.push_back(i->name);
+				writeEvent(file, first, i->name, "B", timeStamp, threadId);
+				IGNORE_RETURN(fputc('}', file));
+				break;
+
+			case ProfilerTimelineBuffer::ET_leave:
+				if (!openBlocks.empty())
+				{
+					openBlocks.pop_back();
+					writeEvent(file, first, i->name, "E", timeStamp, threadId);
+					IGNORE_RETURN(fputc('}', file));
+				}
+				break;
+
+			case ProfilerTimelineBuffer::ET_counter:
+				writeEvent(file, first, i->name, "C", timeStamp, threadId);
+				IGNORE_RETURN(fprintf(file, ",\"args\":{\"value\":%d}}", static_cast<int>(i->value)));
+				break;
+
+			case ProfilerTimelineBuffer::ET_frame:
+				writeEvent(file, first, i->name, "i", timeStamp, threadId);
+				IGNORE_RETURN(fprintf(file, ",\"s\":\"g\",\"args\":{\"frame\":%d}}", static_cast<int>(i->value)));
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	double const endTimeStamp = static_cast<double>(endTime - beginTime) * microsecondsPerTick;
+	while (!openBlocks.empty())
+	{
+		writeEvent(file, first, openBlocks.back(), "E", endTimeStamp, threadId);
+		IGNORE_RETURN(fputc('}', file));
+		openBlocks.pop_back();
+	}
+}
+
+// ======================================================================
+
+void ProfilerTimeline::registerDebugFlags()
+{
+	DebugKey::registerFlag(ms_debugKeyContext, "profilerTimeline");
+	DebugFlags::registerFlag(ms_desiredRecording, "SharedDebug/Profiler", "timeline");
+	DebugFlags::registerFlag(ms_dumpRequested,    "SharedDebug/Profiler", "timelineDump");
+
+	//-- round the ring buffer size up to a power of 2
+	int const eventsPerThread = clamp(1024, ConfigFile::getKeyInt("SharedDebug/Profiler", "timelineEventsPerThread", ms_eventsPerThread), 4 * 1024 * 1024);
+	for (ms_eventsPerThread = 1024; ms_eventsPerThread < eventsPerThread; )
+		ms_eventsPerThread *= 2;
+
+	ms_frameCount        = clamp(1, ConfigFile::getKeyInt("SharedDebug/Profiler", "timelineFrameCount", ms_frameCount), cs_maxFrameCount - 1);
+	ms_spikeMilliseconds = ConfigFile::getKeyFloat("SharedDebug/Profiler", "timelineSpikeMilliseconds", 0.0f);
+	ms_filePrefix        = ConfigFile::getKeyString("SharedDebug/Profiler", "timelineFile", ms_filePrefix);
+
+	ProfilerTimer::getFrequency(ms_frequency);
+	if (ms_frequency == 0)
+		ms_frequency = 1;
+}
+
+// ----------------------------------------------------------------------
+
+void ProfilerTimeline::remove()
+{
+	ms_recording = false;
+	ms_desiredRecording = false;
+
+	ms_mutex.enter();
+
+		std::for_each(ms_buffers.begin(), ms_buffers.end(), PointerDeleter());
+		Buffers().swap(ms_buffers);
+
+		delete ms_discardBuffer;
+		ms_discardBuffer = NULL;
+
+		ms_threadNames.clear();
+
+	ms_mutex.leave();
+
+	Events().swap(ms_events);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Start or stop recording.  The change takes effect at the end of the
+ * current frame, so the main thread's blocks stay balanced.
+ */
+
+void ProfilerTimeline::setRecording(bool const recording)
+{
+	ms_desiredRecording = recording;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Name the calling thread in the timeline.
+ */
+
+void ProfilerTimeline::setThreadName(char const * const name)
+{
+	if (!name)
+		return;
+
+	ms_mutex.enter();
+		ms_threadNames[Os::getThreadId()] = name;
+	ms_mutex.leave();
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Record the value of a counter on the calling thread.
+ *
+ * @param name  The counter name.  It must stay valid until the timeline
+ *              is removed, as only the pointer is recorded.
+ */
+
+void ProfilerTimeline::counter(char const * const name, int const value)
+{
+	if (!ms_recording)
+		return;
+
+	ProfilerTimer::Type time;
+	ProfilerTimer::getTime(time);
+
+	getBuffer()->write(ProfilerTimelineBuffer::ET_counter, name, value, time);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Write a dump at the end of the current frame.
+ */
+
+void ProfilerTimeline::requestDump()
+{
+	ms_dumpRequested = true;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Write the last timelineFrameCount frames as Chrome trace event JSON.
+ *
+ * @return True if the file was written.
+ */
+
+bool ProfilerTimeline::dump(char const * const fileName)
+{
+	if (ms_numberOfFrames == 0)
+	{
+		WARNING(true, ("ProfilerTimeline::dump: no frames have been recorded"));
+		return false;
+	}
+
+	//-- the window runs from the end of the frame before the oldest one written to the end of the last frame
+	int const lastFrame = ms_numberOfFrames - 1;
+	int const frameCount = std::min(ms_frameCount, lastFrame);
+	ProfilerTimer::Type const endTime = ms_frameEndTimes[lastFrame % cs_maxFrameCount];
+	ProfilerTimer::Type const beginTime = frameCount > 0 ? ms_frameEndTimes[(lastFrame - frameCount) % cs_maxFrameCount] : endTime;
+
+	FILE * const file = fopen(fileName, "wt");
+	if (!file)
+	{
+		WARNING(true, ("ProfilerTimeline::dump: could not open %s", fileName));
+		return false;
+	}
+
+	IGNORE_RETURN(fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file));
+
+	bool first = true;
+
+	ms_mutex.enter();
+
+		Buffers::const_iterator const iEnd = ms_buffers.end();
+		for (Buffers::const_iterator i = ms_buffers.begin(); i != iEnd; ++i)
+			writeBuffer(file, first, **i, beginTime, endTime);
+
+	ms_mutex.leave();
+
+	IGNORE_RETURN(fputs("\n]}\n", file));
+	bool const result = ferror(file) == 0;
+	IGNORE_RETURN(fclose(file));
+
+	REPORT_LOG(true, ("ProfilerTimeline: wrote %d frames to %s\n", frameCount, fileName));
+	return result;
+}
+
+// ----------------------------------------------------------------------
+
+void ProfilerTimeline::enter(char const * const name, ProfilerTimer::Type const time)
+{
+	getBuffer()->write(ProfilerTimelineBuffer::ET_enter, name, 0, time);
+}
+
+// ----------------------------------------------------------------------
+
+void ProfilerTimeline::leave(char const * const name, ProfilerTimer::Type const time)
+{
+	getBuffer()->write(ProfilerTimelineBuffer::ET_leave, name, 0, time);
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Called by the Profiler when the main thread leaves its outermost block.
+ */
+
+void ProfilerTimeline::endFrame(ProfilerTimer::Type const time)
+{
+	if (ms_debugKeyContext && DebugKey::isPressed(1))
+		ms_dumpRequested = true;
+
+	if (ms_recording)
+	{
+		float milliseconds = 0.0f;
+		if (ms_numberOfFrames > 0)
+			milliseconds = static_cast<float>(time - ms_frameEndTimes[(ms_numberOfFrames - 1) % cs_maxFrameCount]) * 1000.0f / static_cast<float>(ms_frequency);
+
+		ProfilerTimelineBuffer * const buffer = getBuffer();
+		buffer->write(ProfilerTimelineBuffer::ET_counter, "frameMilliseconds", static_cast<int>(milliseconds + 0.5f), time);
+		buffer->write(ProfilerTimelineBuffer::ET_frame, "frame", Os::getNumberOfUpdates(), time);
+
+		ms_frameEndTimes[ms_numberOfFrames % cs_maxFrameCount] = time;
+		++ms_numberOfFrames;
+		++ms_framesSinceDump;
+
+		//-- dump the frames leading up to a spike, but not again until they have all been replaced
+		if (ms_spikeMilliseconds > 0.0f && milliseconds > ms_spikeMilliseconds && ms_framesSinceDump > ms_frameCount)
+		{
+			REPORT_LOG(true, ("ProfilerTimeline: frame %d took %1.2f ms\n", Os::getNumberOfUpdates(), milliseconds));
+			ms_dumpRequested = true;
+		}
+
+		if (ms_dumpRequested)
+		{
+			char fileName[256];
+			IGNORE_RETURN(snprintf(fileName, sizeof(fileName), "%s_%d.json", ms_filePrefix, Os::getNumberOfUpdates()));
+			IGNORE_RETURN(dump(fileName));
+			ms_framesSinceDump = 0;
+		}
+	}
+	else
+		DEBUG_WARNING(ms_dumpRequested, ("ProfilerTimeline: a dump was requested but the timeline is not recording"));
+
+	ms_dumpRequested = false;
+
+	if (ms_recording != ms_desiredRecording)
+	{
+		ms_recording = ms_desiredRecording;
+		ms_numberOfFrames = 0;
+		ms_framesSinceDump = 0;
+	}
+}
+
+// ======================================================================
@@ -0,0 +1,98 @@
+// ======================================================================
+//
+// ProfilerTimeline.h
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_ProfilerTimeline_H
+#define INCLUDED_ProfilerTimeline_H
+
+// ======================================================================
+
+#include "sharedDebug/ProfilerTimer.h"
+
+class Profiler;
+
+// ======================================================================
+/**
+ * Records profiler blocks from every thread as timestamped events, so a
+ * window of frames can be written out as a Chrome trace.
+ *
+ * The Profiler tree only covers the main thread.  While the timeline is
+ * recording, every ProfilerBlock entered and left on any thread that has
+ * installed PerThreadData is also written to a ring buffer owned by that
+ * thread, along with counters and a marker at the end of each main thread
+ * frame.  Only the owning thread writes a ring buffer, so recording takes
+ * no locks: an event is a timer read and a 24 byte store.
+ *
+ * dump() writes the last timelineFrameCount frames as Chrome trace event
+ * JSON, which chrome://tracing and Perfetto load.  A dump is written at the
+ * end of a frame when requested with debug key 1 in the "profilerTimeline"
+ * context, with the timelineDump debug flag or requestDump(), and when a
+ * frame takes longer than timelineSpikeMilliseconds.
+ *
+ * [SharedDebug/Profiler] keys:
+ *   timeline                    record from startup
+ *   timelineEventsPerThread     ring buffer size, rounded up to a power of 2
+ *   timelineFrameCount          frames written per dump
+ *   timelineSpikeMilliseconds   frame time that triggers a dump, 0 for none
+ *   timelineFile                dump file name prefix
+ */
+
+class ProfilerTimeline
+{
+	friend class Profiler;
+
+public:
+
+	static void registerDebugFlags();
+	static void remove();
+
+	static bool isRecording();
+	static void setRecording(bool recording);
+
+	static void setThreadName(char const *name);
+	static void counter(char const *name, int value);
+
+	static void requestDump();
+	static bool dump(char const *fileName);
+
+private:
+
+	static void enter(char const *name, ProfilerTimer::Type time);
+	static void leave(char const *name, ProfilerTimer::Type time);
+	static void endFrame(ProfilerTimer::Type time);
+
+	// disabled
+	ProfilerTimeline();
+	ProfilerTimeline(ProfilerTimeline const &);
+	ProfilerTimeline &operator =(ProfilerTimeline const &);
+
+private:
+
+	static bool ms_recording;
+};
+
+// ======================================================================
+
+inline bool ProfilerTimeline::isRecording()
+{
+	return ms_recording;
+}
+
+// ======================================================================
+
+#if PRODUCTION == 0
+
+	#define PROFILER_COUNTER(a, b)   ProfilerTimeline::counter(a, b)
+
+#else
+
+	#define PROFILER_COUNTER(a, b)   NOP
+
+#endif
+
+// ======================================================================
+
+#endif
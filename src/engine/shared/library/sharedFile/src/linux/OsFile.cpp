@@ -48,6 +48,21 @@ int OsFile::getFileSize(const char *fileName)
 	return fileSize;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Get a value that changes whenever the file is written, 0 if the file
+ * does not exist.
+ */
+
+uint32 OsFile::getModificationTime(const char *fileName)
+{
+	struct stat statBuffer;
+	if (stat(fileName, &statBuffer) != 0)
+		return 0;
+
+	return static_cast<uint32>(statBuffer.st_mtime);
+}
+
 // ----------------------------------------------------------------------
 
 OsFile *OsFile::open(const char *fileName, bool randomAccess)
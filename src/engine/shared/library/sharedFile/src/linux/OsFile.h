@@ -19,6 +19,7 @@ public:
 
 	static bool    exists(const char *fileName);
 	static int     getFileSize(const char *fileName);
+	static uint32  getModificationTime(const char *fileName);
 	static OsFile *open(const char *fileName, bool randomAccess=false);
 
 public:
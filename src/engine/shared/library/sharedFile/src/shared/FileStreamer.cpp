@@ -97,6 +97,19 @@ int FileStreamer::getFileSize(const char *fileName)
 	return OsFile::getFileSize(fileName);
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Get a value that changes whenever a file is written.
+ *
+ * @param fileName  File name to check
+ * @return The value, or 0 if the file does not exist.
+ */
+
+uint32 FileStreamer::getModificationTime(const char *fileName)
+{
+	return OsFile::getModificationTime(fileName);
+}
+
 // ----------------------------------------------------------------------
 /**
  * Open a file.
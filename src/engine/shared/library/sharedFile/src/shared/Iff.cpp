@@ -382,6 +382,7 @@ void Iff::open(AbstractFile & file, char const * const newFileName)
 	// allocate storage for the data
 	DEBUG_FATAL(data, ("causing memory leak"));
 	data = file.readEntireFileAndClose();
+	ownsData = true;
 
 	FATAL(ConfigSharedFile::getValidateIff() && !IffNamespace::isValid(data, length), ("File corruption detected! Iff::isValid failed for %s (size=%d, crc=%08X). Please try a \"Full Scan\" from the LaunchPad.", newFileName ? newFileName : "null", length, Crc::calculate(data, length)));
 
@@ -391,6 +392,38 @@ void Iff::open(AbstractFile & file, char const * const newFileName)
 	stack[0].used   = 0;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Use Iff data that is already in memory.
+ *
+ * Calling open() on an Iff instance that already contains data will cause the
+ * old data to be discarded.  When the Iff does not own the data, the caller
+ * must keep it alive until the Iff is closed.
+ *
+ * @param newDataSize  Size of the Iff data in bytes
+ * @param newData  The Iff data
+ * @param newFileName  Name reported for the data, may be NULL
+ * @param iffOwnsData  Whether the Iff should delete the data when closed
+ * @see Iff::close()
+ */
+
+void Iff::open(int newDataSize, const byte *newData, char const * const newFileName, bool iffOwnsData)
+{
+	close();
+
+	length   = newDataSize;
+	data     = const_cast<byte *>(newData);
+	ownsData = iffOwnsData;
+
+	// setup the stack data to know about the data
+	stack[0].start  = 0;
+	stack[0].length = length;
+	stack[0].used   = 0;
+
+	if (newFileName)
+		fileName = DuplicateString(newFileName);
+}
+
 // ----------------------------------------------------------------------
 /**
  * Release the data associated with the current Iff.
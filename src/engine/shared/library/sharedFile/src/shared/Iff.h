@@ -115,6 +115,7 @@ public:
 	bool open(const char *filename, bool optional=false);
 	void open(AbstractFile & file);
 	void open(AbstractFile & file, char const * fileName);
+	void open(int newDataSize, const byte *newData, char const * fileName, bool iffOwnsData);
 	void close(void);
 	bool write(const char *filename, bool optional=false);
 
@@ -17,6 +17,7 @@
 #include "sharedFile/FileManifest.h"
 #include "sharedFile/FileStreamer.h"
 #include "sharedFoundation/ConfigFile.h"
+#include "sharedFoundation/Crc.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/Os.h"
 #include "sharedFoundation/Production.h"
@@ -904,6 +905,90 @@ const char *TreeFile::getSearchPath(int index)
 	return NULL;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Get a crc that changes when the data a file would be loaded from changes.
+ *
+ * The crc covers where the file is found, its size, and the size and
+ * modification time of the tree or disk file holding it, so it is cheap
+ * to get and does not read the file.
+ *
+ * @param fileName  File name to check
+ * @return The crc, or 0 if the file could not be found.
+ */
+
+uint32 TreeFile::getSourceIdentity(const char *fileName)
+{
+	char fixedFileName[Os::MAX_PATH_LENGTH];
+	fixUpFileName(fixedFileName, fileName, true);
+
+	SearchNode const * const node = find(fixedFileName);
+	if (!node)
+		return 0;
+
+	char pathName[Os::MAX_PATH_LENGTH];
+	node->getPathName(fixedFileName, pathName, sizeof(pathName));
+
+	// files in trees are named tree[file], the tree is the file on disk
+	char * const bracket = strchr(pathName, '[');
+	if (bracket)
+		*bracket = '\0';
+
+	bool deleted = false;
+	int32 const values[3] =
+	{
+		node->getFileSize(fixedFileName, deleted),
+		FileStreamer::getFileSize(pathName),
+		static_cast<int32>(FileStreamer::getModificationTime(pathName))
+	};
+
+	return Crc::calculate(values, static_cast<int>(sizeof(values)), Crc::calculate(pathName));
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get a crc that changes when the search nodes change, including when a
+ * tree or table of contents file is replaced by a patch.
+ */
+
+uint32 TreeFile::getSearchIdentity()
+{
+	uint32 crc = Crc::crcInit;
+
+	const SearchNodes::iterator iEnd = ms_searchNodes.end();
+	for (SearchNodes::iterator i = ms_searchNodes.begin(); i != iEnd; ++i)
+	{
+		const char *fileName = NULL;
+		const char *pathName = NULL;
+
+		const SearchPath *searchPath = dynamic_cast<const SearchPath*>(*i);
+		const SearchTree *searchTree = dynamic_cast<const SearchTree*>(*i);
+		const SearchTOC  *searchTOC  = dynamic_cast<const SearchTOC*>(*i);
+
+		if (searchPath)
+			pathName = searchPath->getPathName();
+		else if (searchTree)
+			fileName = searchTree->getTreeFileName();
+		else if (searchTOC)
+			fileName = searchTOC->getTOCFileName();
+
+		int32 const values[3] =
+		{
+			(*i)->getPriority(),
+			fileName ? FileStreamer::getFileSize(fileName) : 0,
+			fileName ? static_cast<int32>(FileStreamer::getModificationTime(fileName)) : 0
+		};
+
+		crc = Crc::calculate(values, static_cast<int>(sizeof(values)), crc);
+
+		const char * const name = fileName ? fileName : pathName;
+		if (name)
+			crc = Crc::calculate(name, static_cast<int>(strlen(name)), crc);
+	}
+
+	return crc;
+}
+
 //-----------------------------------------------------------------
 /**
  * This function will return the shortest trailing path of its input that
@@ -98,6 +98,9 @@ public:
 	static int           getNumberOfSearchPaths();
 	static const char   *getSearchPath(int index);
 
+	static uint32        getSourceIdentity(const char *fileName);
+	static uint32        getSearchIdentity();
+
 	static void          addCachedFile(const char *fileName, AbstractFile *file);
 	static void          clearCachedFiles();
 
@@ -147,6 +147,8 @@ public:
 	virtual void          getPathName(const char *fileName, char *pathName, int pathNameLength) const;
 	virtual AbstractFile *open(const char *fileName, AbstractFile::PriorityType priority, bool &deleted);
 
+	const char           *getTreeFileName() const;
+
 private:
 
 	// disabled
@@ -219,6 +221,13 @@ inline bool TreeFile::SearchTree::isCompressed(int compressorIndex)
 	return compressorIndex != static_cast<int>(CT_none);
 }
 
+// ----------------------------------------------------------------------
+
+inline const char *TreeFile::SearchTree::getTreeFileName() const
+{
+	return m_treeFileName;
+}
+
 // ======================================================================
 
 class TreeFile::SearchTOC : public TreeFile::SearchNode
@@ -239,6 +248,8 @@ public:
 	virtual void          getPathName(const char *fileName, char *pathName, int pathNameLength) const;
 	virtual AbstractFile *open(const char *fileName, AbstractFile::PriorityType priority, bool &deleted);
 
+	const char           *getTOCFileName() const;
+
 private:
 
 	// disabled
@@ -316,6 +327,13 @@ inline bool TreeFile::SearchTOC::isCompressed(int compressorIndex)
 	return compressorIndex != static_cast<int>(CT_none);
 }
 
+// ----------------------------------------------------------------------
+
+inline const char *TreeFile::SearchTOC::getTOCFileName() const
+{
+	return m_TOCFileName;
+}
+
 // ======================================================================
 
 class TreeFile::SearchCache : public TreeFile::SearchNode
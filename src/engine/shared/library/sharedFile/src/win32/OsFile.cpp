@@ -73,6 +73,23 @@ int OsFile::getFileSize(const char *fileName)
 	return size;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Get a value that changes whenever the file is written, 0 if the file
+ * does not exist.
+ */
+
+uint32 OsFile::getModificationTime(const char *fileName)
+{
+	NOT_NULL(fileName);
+
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+	if (!GetFileAttributesEx(fileName, GetFileExInfoStandard, &attributes))
+		return 0;
+
+	return static_cast<uint32>(attributes.ftLastWriteTime.dwLowDateTime ^ attributes.ftLastWriteTime.dwHighDateTime);
+}
+
 // ----------------------------------------------------------------------
 
 OsFile *OsFile::open(const char *fileName, bool randomAccess)
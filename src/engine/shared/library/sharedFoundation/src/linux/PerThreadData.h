@@ -15,6 +15,9 @@
 #include "sharedFoundation/ExitChain.h"
 
 class Gate;
+class GraphicsCommandBuffer;
+class ProfilerTimelineBuffer;
+class RandomGenerator;
 
 // ======================================================================
 /**
@@ -37,6 +40,12 @@ private:
 		int               debugPrintFlags;
 
 		Gate             *readGate;
+
+		RandomGenerator  *randomGenerator;
+
+		GraphicsCommandBuffer *graphicsCommandBuffer;
+
+		ProfilerTimelineBuffer *profilerTimelineBuffer;
 	};
 
 	static pthread_key_t slot;
@@ -75,6 +84,15 @@ public:
 	static void setDebugPrintFlags(int newValue);
 
 	static Gate *getFileStreamerReadGate(void);
+
+	static RandomGenerator *getRandomGenerator(void);
+	static void             setRandomGenerator(RandomGenerator *newValue);
+
+	static GraphicsCommandBuffer *getGraphicsCommandBuffer(void);
+	static void                   setGraphicsCommandBuffer(GraphicsCommandBuffer *newValue);
+
+	static ProfilerTimelineBuffer *getProfilerTimelineBuffer(void);
+	static void                   setProfilerTimelineBuffer(ProfilerTimelineBuffer *newValue);
 };
 
 // ======================================================================
@@ -227,6 +245,87 @@ inline Gate *PerThreadData::getFileStreamerReadGate(void)
 	return getData()->readGate;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Get the random number generator that replaces the global one on this thread.
+ *
+ * This routine is not intended for general use; it should only be used by the Random class.
+ *
+ * @return The generator set for this thread, or NULL if the thread uses the global generator
+ */
+
+inline RandomGenerator *PerThreadData::getRandomGenerator(void)
+{
+	Data * const data = getData(true);
+	return data ? data->randomGenerator : NULL;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Set the random number generator that replaces the global one on this thread.
+ *
+ * This routine is not intended for general use; it should only be used by the Random class.
+ */
+
+inline void PerThreadData::setRandomGenerator(RandomGenerator *newValue)
+{
+	getData()->randomGenerator = newValue;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the command buffer that Graphics calls made on this thread are recorded into.
+ *
+ * This routine is not intended for general use; it should only be used by the GraphicsCommandBuffer class.
+ *
+ * @return The command buffer recording on this thread, or NULL if Graphics calls go straight to the rasterizer
+ */
+
+inline GraphicsCommandBuffer *PerThreadData::getGraphicsCommandBuffer(void)
+{
+	Data * const data = getData(true);
+	return data ? data->graphicsCommandBuffer : NULL;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Set the command buffer that Graphics calls made on this thread are recorded into.
+ *
+ * This routine is not intended for general use; it should only be used by the GraphicsCommandBuffer class.
+ */
+
+inline void PerThreadData::setGraphicsCommandBuffer(GraphicsCommandBuffer *newValue)
+{
+	getData()->graphicsCommandBuffer = newValue;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the buffer that profiler timeline events on this thread are recorded into.
+ *
+ * This routine is not intended for general use; it should only be used by the ProfilerTimeline class.
+ *
+ * @return The timeline buffer for this thread, or NULL if it has not recorded yet
+ */
+
+inline ProfilerTimelineBuffer *PerThreadData::getProfilerTimelineBuffer(void)
+{
+	Data * const data = getData(true);
+	return data ? data->profilerTimelineBuffer : NULL;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Set the buffer that profiler timeline events on this thread are recorded into.
+ *
+ * This routine is not intended for general use; it should only be used by the ProfilerTimeline class.
+ */
+
+inline void PerThreadData::setProfilerTimelineBuffer(ProfilerTimelineBuffer *newValue)
+{
+	getData()->profilerTimelineBuffer = newValue;
+}
+
 // ======================================================================
 
 #endif
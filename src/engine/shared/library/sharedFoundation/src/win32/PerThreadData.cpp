@@ -34,6 +34,12 @@ namespace PerThreadDataNamespace
 
 		Gate             *fileStreamerReadGate;
 
+		RandomGenerator  *randomGenerator;
+
+		GraphicsCommandBuffer *graphicsCommandBuffer;
+
+		ProfilerTimelineBuffer *profilerTimelineBuffer;
+
 		HANDLE            watchHandle;
 	};
 
@@ -462,4 +468,85 @@ Gate *PerThreadData::getFileStreamerReadGate()
 	return _getData()->fileStreamerReadGate;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Get the random number generator that replaces the global one on this thread.
+ *
+ * This routine is not intended for general use; it should only be used by the Random class.
+ *
+ * @return The generator set for this thread, or NULL if the thread uses the global generator
+ */
+
+RandomGenerator *PerThreadData::getRandomGenerator()
+{
+	Data * const data = _getData(true);
+	return data ? data->randomGenerator : NULL;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Set the random number generator that replaces the global one on this thread.
+ *
+ * This routine is not intended for general use; it should only be used by the Random class.
+ */
+
+void PerThreadData::setRandomGenerator(RandomGenerator *newValue)
+{
+	_getData()->randomGenerator = newValue;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the command buffer that Graphics calls made on this thread are recorded into.
+ *
+ * This routine is not intended for general use; it should only be used by the GraphicsCommandBuffer class.
+ *
+ * @return The command buffer recording on this thread, or NULL if Graphics calls go straight to the rasterizer
+ */
+
+GraphicsCommandBuffer *PerThreadData::getGraphicsCommandBuffer()
+{
+	Data * const data = _getData(true);
+	return data ? data->graphicsCommandBuffer : NULL;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Set the command buffer that Graphics calls made on this thread are recorded into.
+ *
+ * This routine is not intended for general use; it should only be used by the GraphicsCommandBuffer class.
+ */
+
+void PerThreadData::setGraphicsCommandBuffer(GraphicsCommandBuffer *newValue)
+{
+	_getData()->graphicsCommandBuffer = newValue;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Get the buffer that profiler timeline events on this thread are recorded into.
+ *
+ * This routine is not intended for general use; it should only be used by the ProfilerTimeline class.
+ *
+ * @return The timeline buffer for this thread, or NULL if it has not recorded yet
+ */
+
+ProfilerTimelineBuffer *PerThreadData::getProfilerTimelineBuffer()
+{
+	Data * const data = _getData(true);
+	return data ? data->profilerTimelineBuffer : NULL;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Set the buffer that profiler timeline events on this thread are recorded into.
+ *
+ * This routine is not intended for general use; it should only be used by the ProfilerTimeline class.
+ */
+
+void PerThreadData::setProfilerTimelineBuffer(ProfilerTimelineBuffer *newValue)
+{
+	_getData()->profilerTimelineBuffer = newValue;
+}
+
 // ======================================================================
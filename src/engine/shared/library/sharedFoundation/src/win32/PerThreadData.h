@@ -14,6 +14,9 @@
 // ======================================================================
 
 class Gate;
+class GraphicsCommandBuffer;
+class ProfilerTimelineBuffer;
+class RandomGenerator;
 
 #include "../../../../../../engine/shared/library/sharedFoundation/include/public/sharedFoundation/ExitChain.h"
 
@@ -50,6 +53,15 @@ public:
 	static void setDebugPrintFlags(int newValue);
 
 	static Gate   *getFileStreamerReadGate(void);
+
+	static RandomGenerator *getRandomGenerator(void);
+	static void             setRandomGenerator(RandomGenerator *newValue);
+
+	static GraphicsCommandBuffer *getGraphicsCommandBuffer(void);
+	static void                   setGraphicsCommandBuffer(GraphicsCommandBuffer *newValue);
+
+	static ProfilerTimelineBuffer *getProfilerTimelineBuffer(void);
+	static void                   setProfilerTimelineBuffer(ProfilerTimelineBuffer *newValue);
 };
 
 // ======================================================================
@@ -26,6 +26,17 @@
 
 #endif
 
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+
+	#define EXPAND_USE_SSE2  1
+	#include <emmintrin.h>
+
+#else
+
+	#define EXPAND_USE_SSE2  0
+
+#endif
+
 // ======================================================================
 
 namespace CompressedQuaternionNamespace
@@ -66,6 +77,10 @@ namespace CompressedQuaternionNamespace
 		float   expandTenBit(uint32 compressedValue) const;
 		float   expandElevenBit(uint32 compressedValue) const;
 
+		float   getBaseValue() const;
+		float   getExpandFactorTenBit() const;
+		float   getExpandFactorElevenBit() const;
+
 	private:
 	
 		float  m_baseValue;
@@ -134,6 +149,10 @@ namespace CompressedQuaternionNamespace
 
 	uint32 doCompress(float w, float x, float y, float z, uint8 xFormat, uint8 yFormat, uint8 zFormat);
 	void   doExpand(uint32 data, uint8 xFormat, uint8 yFormat, uint8 zFormat, float &w, float &x, float &y, float &z);
+
+#if EXPAND_USE_SSE2
+	void   doExpandFour(uint32 const *data, uint8 const *xFormats, uint8 const *yFormats, uint8 const *zFormats, float *w, float *x, float *y, float *z);
+#endif
 }
 
 using namespace CompressedQuaternionNamespace;
@@ -227,6 +246,28 @@ float CompressedQuaternionNamespace::FormatData::expandElevenBit(uint32 compress
 		return m_baseValue + (static_cast<float>(compressedValue & cs_valueMaskElevenBit) * s_formatPrecisionInfo[m_formatPrecisionIndex].expandFactorElevenBit);
 }
 
+// ----------------------------------------------------------------------
+
+inline float CompressedQuaternionNamespace::FormatData::getBaseValue() const
+{
+	DEBUG_FATAL(!m_installed, ("format not installed."));
+	return m_baseValue;
+}
+
+// ----------------------------------------------------------------------
+
+inline float CompressedQuaternionNamespace::FormatData::getExpandFactorTenBit() const
+{
+	return s_formatPrecisionInfo[m_formatPrecisionIndex].expandFactorTenBit;
+}
+
+// ----------------------------------------------------------------------
+
+inline float CompressedQuaternionNamespace::FormatData::getExpandFactorElevenBit() const
+{
+	return s_formatPrecisionInfo[m_formatPrecisionIndex].expandFactorElevenBit;
+}
+
 // ======================================================================
 
 inline int CompressedQuaternionNamespace::convertShiftToCount(int shift)
@@ -379,6 +420,79 @@ void CompressedQuaternionNamespace::doExpand(uint32 data, uint8 xFormat, uint8 y
 	w = sqrt(1.0f - (x*x + y*y + z*z));
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Expand four compressed quaternions at once.
+ *
+ * This produces exactly the same values as four doExpand() calls: the
+ * sign bit of each component is moved into the float sign bit, so
+ * base + (-value) matches the scalar base - value.
+ */
+
+#if EXPAND_USE_SSE2
+
+void CompressedQuaternionNamespace::doExpandFour(uint32 const *data, uint8 const *xFormats, uint8 const *yFormats, uint8 const *zFormats, float *w, float *x, float *y, float *z)
+{
+	//-- Gather the per-lane format parameters.
+	FormatData const &x0 = s_formatData[xFormats[0]];
+	FormatData const &x1 = s_formatData[xFormats[1]];
+	FormatData const &x2 = s_formatData[xFormats[2]];
+	FormatData const &x3 = s_formatData[xFormats[3]];
+
+	FormatData const &y0 = s_formatData[yFormats[0]];
+	FormatData const &y1 = s_formatData[yFormats[1]];
+	FormatData const &y2 = s_formatData[yFormats[2]];
+	FormatData const &y3 = s_formatData[yFormats[3]];
+
+	FormatData const &z0 = s_formatData[zFormats[0]];
+	FormatData const &z1 = s_formatData[zFormats[1]];
+	FormatData const &z2 = s_formatData[zFormats[2]];
+	FormatData const &z3 = s_formatData[zFormats[3]];
+
+	__m128 const xBase   = _mm_set_ps(x3.getBaseValue(), x2.getBaseValue(), x1.getBaseValue(), x0.getBaseValue());
+	__m128 const yBase   = _mm_set_ps(y3.getBaseValue(), y2.getBaseValue(), y1.getBaseValue(), y0.getBaseValue());
+	__m128 const zBase   = _mm_set_ps(z3.getBaseValue(), z2.getBaseValue(), z1.getBaseValue(), z0.getBaseValue());
+
+	__m128 const xFactor = _mm_set_ps(x3.getExpandFactorElevenBit(), x2.getExpandFactorElevenBit(), x1.getExpandFactorElevenBit(), x0.getExpandFactorElevenBit());
+	__m128 const yFactor = _mm_set_ps(y3.getExpandFactorElevenBit(), y2.getExpandFactorElevenBit(), y1.getExpandFactorElevenBit(), y0.getExpandFactorElevenBit());
+	__m128 const zFactor = _mm_set_ps(z3.getExpandFactorTenBit(), z2.getExpandFactorTenBit(), z1.getExpandFactorTenBit(), z0.getExpandFactorTenBit());
+
+	//-- Unpack the components.
+	__m128i const packed = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data));
+
+	__m128i const xPacked = _mm_srli_epi32(packed, static_cast<int>(cs_xShift));
+	__m128i const yPacked = _mm_srli_epi32(packed, static_cast<int>(cs_yShift));
+
+	__m128i const xValue = _mm_and_si128(xPacked, _mm_set1_epi32(static_cast<int>(cs_valueMaskElevenBit)));
+	__m128i const yValue = _mm_and_si128(yPacked, _mm_set1_epi32(static_cast<int>(cs_valueMaskElevenBit)));
+	__m128i const zValue = _mm_and_si128(packed,  _mm_set1_epi32(static_cast<int>(cs_valueMaskTenBit)));
+
+	// Move each component's sign bit up to bit 31.
+	__m128i const xSign = _mm_slli_epi32(_mm_and_si128(xPacked, _mm_set1_epi32(static_cast<int>(cs_signBitElevenBit))), 21);
+	__m128i const ySign = _mm_slli_epi32(_mm_and_si128(yPacked, _mm_set1_epi32(static_cast<int>(cs_signBitElevenBit))), 21);
+	__m128i const zSign = _mm_slli_epi32(_mm_and_si128(packed,  _mm_set1_epi32(static_cast<int>(cs_signBitTenBit))), 22);
+
+	//-- Expand.
+	__m128 const xOffset = _mm_xor_ps(_mm_mul_ps(_mm_cvtepi32_ps(xValue), xFactor), _mm_castsi128_ps(xSign));
+	__m128 const yOffset = _mm_xor_ps(_mm_mul_ps(_mm_cvtepi32_ps(yValue), yFactor), _mm_castsi128_ps(ySign));
+	__m128 const zOffset = _mm_xor_ps(_mm_mul_ps(_mm_cvtepi32_ps(zValue), zFactor), _mm_castsi128_ps(zSign));
+
+	__m128 const xResult = _mm_add_ps(xBase, xOffset);
+	__m128 const yResult = _mm_add_ps(yBase, yOffset);
+	__m128 const zResult = _mm_add_ps(zBase, zOffset);
+
+	//-- Calculate w.
+	__m128 const lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xResult, xResult), _mm_mul_ps(yResult, yResult)), _mm_mul_ps(zResult, zResult));
+	__m128 const wResult       = _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), lengthSquared));
+
+	_mm_storeu_ps(w, wResult);
+	_mm_storeu_ps(x, xResult);
+	_mm_storeu_ps(y, yResult);
+	_mm_storeu_ps(z, zResult);
+}
+
+#endif
+
 // ======================================================================
 // class CompressedQuaternion: static public member functions
 // ======================================================================
@@ -620,6 +734,35 @@ void CompressedQuaternion::expand(uint8 xFormat, uint8 yFormat, uint8 zFormat, f
 	doExpand(m_data, xFormat, yFormat, zFormat, w, x, y, z);
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Expand an array of compressed quaternions into separate component arrays.
+ *
+ * Each quaternion may use its own compression format.  The results are
+ * identical to calling expand() on each entry.
+ *
+ * @param count             the number of quaternions to expand.
+ * @param compressedValues  count values as returned by getCompressedValue().
+ * @param xFormats          the x compression format of each quaternion.
+ * @param yFormats          the y compression format of each quaternion.
+ * @param zFormats          the z compression format of each quaternion.
+ */
+
+void CompressedQuaternion::expandArray(int count, uint32 const *compressedValues, uint8 const *xFormats, uint8 const *yFormats, uint8 const *zFormats, float *w, float *x, float *y, float *z)
+{
+	DEBUG_FATAL(!s_installed, ("CompressedQuaternion not installed."));
+
+	int i = 0;
+
+#if EXPAND_USE_SSE2
+	for (; i + 4 <= count; i += 4)
+		doExpandFour(compressedValues + i, xFormats + i, yFormats + i, zFormats + i, w + i, x + i, y + i, z + i);
+#endif
+
+	for (; i < count; ++i)
+		doExpand(compressedValues[i], xFormats[i], yFormats[i], zFormats[i], w[i], x[i], y[i], z[i]);
+}
+
 // ----------------------------------------------------------------------
 
 uint32 CompressedQuaternion::getCompressedValue() const
@@ -30,6 +30,8 @@ public:
 	static void  getOptimalCompressionFormat(const QuaternionVector &sourceRotations, uint8 &xFormat, uint8 &yFormat, uint8 &zFormat);
 	static void  compressRotations(const QuaternionVector &sourceRotations, uint8 xFormat, uint8 yFormat, uint8 zFormat, CompressedQuaternionVector &compressedRotations);
 
+	static void  expandArray(int count, uint32 const *compressedValues, uint8 const *xFormats, uint8 const *yFormats, uint8 const *zFormats, float *w, float *x, float *y, float *z);
+
 public:
 
 	explicit CompressedQuaternion(uint32 compressedValue);
@@ -808,6 +808,20 @@ int MemoryManager::getMaximumNumberOfAllocations()
 
 // ----------------------------------------------------------------------
 
+int MemoryManager::getTotalNumberOfAllocations()
+{
+	return ms_allocateCalls;
+}
+
+// ----------------------------------------------------------------------
+
+unsigned long MemoryManager::getTotalNumberOfBytesAllocated()
+{
+	return ms_allocateBytesTotal;
+}
+
+// ----------------------------------------------------------------------
+
 void MemoryManager::setReportAllocations(bool reportAllocations)
 {
 	ms_reportAllocations = reportAllocations;
@@ -2108,6 +2122,20 @@ int MemoryManager::getMaximumNumberOfAllocations()
 
 // ----------------------------------------------------------------------
 
+int MemoryManager::getTotalNumberOfAllocations()
+{
+	return MemoryManagerNamespace::ms_allocateCalls;
+}
+
+// ----------------------------------------------------------------------
+
+unsigned long MemoryManager::getTotalNumberOfBytesAllocated()
+{
+	return MemoryManagerNamespace::ms_allocateBytesTotal;
+}
+
+// ----------------------------------------------------------------------
+
 void  MemoryManager::setLimit(int, bool, bool)
 {
 }
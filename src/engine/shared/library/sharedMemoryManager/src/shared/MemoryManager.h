@@ -49,6 +49,8 @@ public:
 	static unsigned long   getCurrentNumberOfBytesAllocatedNoLeakTest();
 	static int             getMaximumNumberOfAllocations();
 	static unsigned long   getMaximumNumberOfBytesAllocated();
+	static int             getTotalNumberOfAllocations();
+	static unsigned long   getTotalNumberOfBytesAllocated();
 	static int             getSystemMemoryAllocatedMegabytes();
 
 #ifndef _WIN32
@@ -12,6 +12,7 @@
 
 #include "sharedRandom/RandomGenerator.h"
 #include "sharedFoundation/ExitChain.h"
+#include "sharedFoundation/PerThreadData.h"
 
 // ======================================================================
 
@@ -47,4 +48,20 @@ void Random::remove(void)
 	delete rand;
 }
 
+// ----------------------------------------------------------------------
+/**
+ * Static function to replace the global generator on the calling thread.
+ *
+ * Every random number the thread draws comes from generator until this is
+ * called again with NULL.  The seed functions always use the global generator.
+ *
+ * @param generator  [IN] The generator to use on this thread, or NULL to use the global generator
+ */
+
+void Random::setThreadGenerator(RandomGenerator *generator)
+{
+	DEBUG_FATAL(!installed, ("not installed"));
+	PerThreadData::setRandomGenerator(generator);
+}
+
 // ======================================================================
@@ -10,6 +10,7 @@
 #ifndef _RANDOM_H_
 #define _RANDOM_H_
 
+#include "sharedFoundation/PerThreadData.h"
 #include "sharedRandom/RandomGenerator.h"
 
 // ======================================================================
@@ -20,6 +21,10 @@
 //    It must have install() called before use.  It creates a global random number 
 //    generator.  To create local random number generators, use RandomGenerator.  
 //    The RandomGenerator class depends on this class to generate the seeds for it.
+//
+//    A thread can replace the global generator with its own by calling
+//    setThreadGenerator(), which lets work that is split across threads
+//    draw the same numbers it would have drawn on a single thread.
 
 class Random
 {
@@ -45,6 +50,13 @@ public:
 
 	static bool  isInstalled (void);
 
+	static RandomGenerator *getThreadGenerator (void);
+	static void             setThreadGenerator (RandomGenerator *generator);
+
+private:
+
+	static RandomGenerator *getGenerator (void);
+
 private:
 	// disable: default constructor, copy constructor, assignment operator
   Random (void);
@@ -52,6 +64,31 @@ private:
 	Random &operator =(const Random&);
 };
 
+// ----------------------------------------------------------------------
+/**
+ * Static function to get the generator used by the calling thread.
+ *
+ * @return The generator set with setThreadGenerator(), or the global generator if there is none.
+ */
+
+inline RandomGenerator *Random::getGenerator (void)
+{
+	RandomGenerator * const threadGenerator = getThreadGenerator();
+	return (threadGenerator != NULL) ? threadGenerator : rand;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Static function to get the generator that replaces the global one on the calling thread.
+ *
+ * @return The generator set with setThreadGenerator(), or NULL if the thread uses the global generator.
+ */
+
+inline RandomGenerator *Random::getThreadGenerator (void)
+{
+	return PerThreadData::getRandomGenerator();
+}
+
 // ----------------------------------------------------------------------
 /**
  * Static function to get a real random number between 0 and 1.
@@ -64,7 +101,7 @@ private:
 inline real Random::randomReal (void)
 {
 	DEBUG_FATAL(!installed, ("not installed"));
-	return rand->randomReal();
+	return getGenerator()->randomReal();
 }
 
 // ----------------------------------------------------------------------
@@ -79,7 +116,7 @@ inline real Random::randomReal (void)
 inline int32 Random::random (void)
 {
 	DEBUG_FATAL(!installed, ("not installed"));
-	return rand->random();
+	return getGenerator()->random();
 }
 
 // ----------------------------------------------------------------------
@@ -94,7 +131,7 @@ inline int32 Random::random (void)
 inline real Random::randomReal (real low, real high)
 {
 	DEBUG_FATAL(!installed, ("not installed"));
-	return rand->randomReal(low, high);
+	return getGenerator()->randomReal(low, high);
 }
 
 // ----------------------------------------------------------------------
@@ -109,7 +146,7 @@ inline real Random::randomReal (real low, real high)
 inline int32 Random::random (int32 low, int32 high)
 {
 	DEBUG_FATAL(!installed, ("not installed"));
-	return rand->random(low, high);
+	return getGenerator()->random(low, high);
 }
 
 // ----------------------------------------------------------------------
@@ -125,7 +162,7 @@ inline int32 Random::random (int32 range)
 {
 	DEBUG_FATAL(!installed, ("not installed"));
 	DEBUG_FATAL(range < 0, ("range < 0, use random(-range, 0)"));
-	return rand->random(0, range);
+	return getGenerator()->random(0, range);
 }
 
 // ----------------------------------------------------------------------
@@ -141,7 +178,7 @@ inline real Random::randomReal (real range)
 {
 	DEBUG_FATAL(!installed, ("not installed"));
 	DEBUG_FATAL(range < 0, ("range < 0, use randomReal(-range, 0)"));
-	return rand->randomReal (CONST_REAL(0), range);
+	return getGenerator()->randomReal (CONST_REAL(0), range);
 }
 
 // ----------------------------------------------------------------------
@@ -0,0 +1 @@
+#include "../../src/shared/generator/TerrainDirtyRegion.h"
@@ -0,0 +1 @@
+#include "../../src/shared/generator/TerrainGeneratorProfiler.h"
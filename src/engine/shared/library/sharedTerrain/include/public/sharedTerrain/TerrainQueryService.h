@@ -0,0 +1 @@
+#include "../../src/shared/object/TerrainQueryService.h"
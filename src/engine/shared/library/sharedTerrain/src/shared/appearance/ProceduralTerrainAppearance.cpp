@@ -766,6 +766,25 @@ bool ProceduralTerrainAppearance::getHeightForceChunkCreation (const Vector& pos
 	return chunk && chunk->getHeightAt (position_o, &height);
 }
 
+//-------------------------------------------------------------------
+/**
+* Get the height from the full resolution chunk only. Unlike getHeight,
+* this fails instead of answering from a coarser level of detail chunk.
+*/
+bool ProceduralTerrainAppearance::getFinestChunkHeight (const Vector& position_o, float& height) const
+{
+	const Chunk* const chunk = findChunk (position_o, 1);
+
+	return chunk && chunk->getHeightAt (position_o, &height);
+}
+
+//-------------------------------------------------------------------
+
+bool ProceduralTerrainAppearance::hasFinestChunk (const Vector& position_o) const
+{
+	return findChunk (position_o, 1) != 0;
+}
+
 //-------------------------------------------------------------------
 
 const ObjectTemplate* ProceduralTerrainAppearance::getSurfaceProperties (const Vector& position_o) const
@@ -271,6 +271,8 @@ public:
 	virtual bool          getHeight (const Vector& position_o, float& height) const;
 	virtual bool          getHeight (const Vector& position_o, float& height, Vector& normal) const;
 	virtual bool          getHeightForceChunkCreation (const Vector& position_o, float& height) const;
+	bool                  getFinestChunkHeight (const Vector& position_o, float& height) const;
+	bool                  hasFinestChunk (const Vector& position_o) const;
 	virtual const ObjectTemplate* getSurfaceProperties (const Vector& position_o) const;
 	virtual bool          getWaterHeight (const Vector& position_o, float& height) const;
 	virtual bool          getWaterHeight (const Vector& position_o, float& height, TerrainGeneratorWaterType& waterType, bool ignoreNonTransparentWater=false) const;
@@ -19,6 +19,7 @@ namespace
 	bool ms_debugReportInstall;
 	bool ms_debugReportLogPrint;
 	bool ms_disableFloraCaching;
+	int  ms_queryServiceMaximumNumberOfTiles;
 	float ms_maximumValidHeightInMeters;
 }
 
@@ -59,6 +60,13 @@ bool ConfigSharedTerrain::getDisableFloraCaching ()
 
 //-------------------------------------------------------------------
 
+int ConfigSharedTerrain::getQueryServiceMaximumNumberOfTiles ()
+{
+	return ms_queryServiceMaximumNumberOfTiles;
+}
+
+//-------------------------------------------------------------------
+
 float ConfigSharedTerrain::getMaximumValidHeightInMeters ()
 {
 	return ms_maximumValidHeightInMeters;
@@ -80,6 +88,7 @@ void ConfigSharedTerrain::install ()
 	KEY_BOOL (debugReportInstall, false);
 	KEY_BOOL (debugReportLogPrint, false);
 	KEY_BOOL (disableFloraCaching, false);
+	KEY_INT (queryServiceMaximumNumberOfTiles, 2048);
 	KEY_FLOAT (maximumValidHeightInMeters, 16000.0f);
 
 	DEBUG_REPORT_LOG_PRINT (ms_debugReportInstall, ("ConfigSharedTerrain::install\n"));
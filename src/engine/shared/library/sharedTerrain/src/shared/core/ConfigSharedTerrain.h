@@ -21,6 +21,7 @@ public:
 	static bool getDebugReportInstall ();
 	static bool getDebugReportLogPrint ();
 	static bool getDisableFloraCaching ();
+	static int  getQueryServiceMaximumNumberOfTiles ();
 
 	static float getMaximumValidHeightInMeters ();
 
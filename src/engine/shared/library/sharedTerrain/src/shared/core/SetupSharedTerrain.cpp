@@ -17,7 +17,9 @@
 #include "sharedTerrain/ServerProceduralTerrainAppearance.h"
 #include "sharedTerrain/ServerProceduralTerrainAppearanceTemplate.h"
 #include "sharedTerrain/ServerSpaceTerrainAppearanceTemplate.h"
+#include "sharedTerrain/TerrainGeneratorProfiler.h"
 #include "sharedTerrain/TerrainObject.h"
+#include "sharedTerrain/TerrainQueryService.h"
 #include "sharedTerrain/WaterTypeManager.h"
 
 //===================================================================
@@ -48,6 +50,8 @@ void SetupSharedTerrain::install (const SetupSharedTerrain::Data& /*data*/)
 	ConfigSharedTerrain::install ();
 
 	TerrainObject::install ();
+	TerrainQueryService::install ();
+	TerrainGeneratorProfiler::install ();
 	ProceduralTerrainAppearance::install ();
 	ServerProceduralTerrainAppearanceTemplate::install ();
 	ServerSpaceTerrainAppearanceTemplate::install();
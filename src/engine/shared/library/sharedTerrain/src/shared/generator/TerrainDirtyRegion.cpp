@@ -0,0 +1,615 @@
+//===================================================================
+//
+// TerrainDirtyRegion.cpp
+//
+// copyright 2026
+//
+//===================================================================
+
+#include "sharedTerrain/FirstSharedTerrain.h"
+#include "sharedTerrain/TerrainDirtyRegion.h"
+
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedFile/Iff.h"
+#include "sharedFoundation/Crc.h"
+#include "sharedMath/Vector2d.h"
+#include "sharedRandom/FastRandomGenerator.h"
+#include "sharedTerrain/Affector.h"
+
+#include <algorithm>
+#include <map>
+
+//===================================================================
+
+struct TerrainDirtyRegion::Record
+{
+	const TerrainGenerator::LayerItem* parent;
+	int                                index;
+	uint32                             signature;
+	bool                               bounded;
+	Rectangle2d                        extent;
+};
+
+//===================================================================
+
+namespace TerrainDirtyRegionNamespace
+{
+	//-- same chunk padding as the editor
+	int const    cms_originOffset = 1;
+	int const    cms_upperPad = 2;
+
+	int const    cms_maximumNumberOfSampledChunks = 256;
+	uint32 const cms_benchmarkSeed = 0x5eed;
+
+	//----------------------------------------------------------------------
+
+	Rectangle2d const cms_emptyExtent (FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	bool isEmptyExtent (Rectangle2d const & extent)
+	{
+		return extent.x0 > extent.x1 || extent.y0 > extent.y1;
+	}
+
+	//----------------------------------------------------------------------
+	//
+	// an unbounded region covers the entire map, a bounded region with an empty extent covers nothing
+	//
+	void intersect (bool & bounded, Rectangle2d & extent, bool const otherBounded, Rectangle2d const & other)
+	{
+		if (!otherBounded)
+			return;
+
+		if (!bounded)
+		{
+			bounded = true;
+			extent = other;
+			return;
+		}
+
+		extent.x0 = std::max (extent.x0, other.x0);
+		extent.y0 = std::max (extent.y0, other.y0);
+		extent.x1 = std::min (extent.x1, other.x1);
+		extent.y1 = std::min (extent.y1, other.y1);
+	}
+
+	//----------------------------------------------------------------------
+
+	void calculateBoundaryExtent (TerrainGenerator::Layer const & layer, bool & bounded, Rectangle2d & extent)
+	{
+		//-- mirrors TerrainGenerator::Layer::calculateExtent
+		bounded = false;
+		extent = cms_emptyExtent;
+
+		if (layer.getInvertBoundaries ())
+			return;
+
+		for (int i = 0; i < layer.getNumberOfBoundaries (); ++i)
+		{
+			TerrainGenerator::Boundary const * const boundary = layer.getBoundary (i);
+
+			if (boundary->isActive ())
+			{
+				bounded = true;
+				boundary->expand (extent);
+			}
+		}
+	}
+
+	//----------------------------------------------------------------------
+
+	uint32 calculateLayerItemSignature (TerrainGenerator::LayerItem const & layerItem)
+	{
+		Iff iff (1024, true, true);
+
+		iff.insertForm (layerItem.getTag ());
+			layerItem.save (iff);
+		iff.exitForm (layerItem.getTag ());
+
+		return Crc::calculate (iff.getRawData (), iff.getRawDataSize ());
+	}
+
+	//----------------------------------------------------------------------
+
+	uint32 calculateLayerSignature (TerrainGenerator::Layer const & layer)
+	{
+		//-- only the layer's own settings, children are tracked separately
+		int32 data [3];
+		data [0] = layer.isActive () ? 1 : 0;
+		data [1] = layer.getInvertBoundaries () ? 1 : 0;
+		data [2] = layer.getInvertFilters () ? 1 : 0;
+
+		return Crc::calculate (data, sizeof (data));
+	}
+
+	//----------------------------------------------------------------------
+
+	uint32 calculateGroupSignature (TerrainGenerator const & generator)
+	{
+		Iff iff (64 * 1024, true, true);
+
+		iff.insertForm (TAG_0000);
+
+			generator.getShaderGroup ().save (iff);
+			generator.getFloraGroup ().save (iff);
+			generator.getRadialGroup ().save (iff);
+			generator.getEnvironmentGroup ().save (iff);
+			generator.getFractalGroup ().save (iff);
+			generator.getBitmapGroup ().save (iff);
+
+		iff.exitForm (TAG_0000);
+
+		return Crc::calculate (iff.getRawData (), iff.getRawDataSize ());
+	}
+
+	//----------------------------------------------------------------------
+
+	void findSmallestBoundary (TerrainGenerator::Layer * const layer, TerrainGenerator::Boundary * & smallestBoundary, float & smallestArea)
+	{
+		if (!layer->isActive ())
+			return;
+
+		for (int i = 0; i < layer->getNumberOfBoundaries (); ++i)
+		{
+			TerrainGenerator::Boundary * const boundary = layer->getBoundary (i);
+			if (!boundary->isActive ())
+				continue;
+
+			Rectangle2d extent (cms_emptyExtent);
+			boundary->expand (extent);
+
+			float const area = extent.getWidth () * extent.getHeight ();
+			if (area > 0.f && area < smallestArea)
+			{
+				smallestArea = area;
+				smallestBoundary = boundary;
+			}
+		}
+
+		for (int j = 0; j < layer->getNumberOfLayers (); ++j)
+			findSmallestBoundary (layer->getLayer (j), smallestBoundary, smallestArea);
+	}
+
+	//----------------------------------------------------------------------
+
+	void generateChunk (TerrainGenerator const & generator, TerrainGenerator::CreateChunkBuffer & createChunkBuffer, float const x, float const z, int const numberOfPoles, float const distanceBetweenPoles, bool const legacyMode)
+	{
+		TerrainGenerator::GeneratorChunkData generatorChunkData (legacyMode);
+
+		generatorChunkData.heightMap            = &createChunkBuffer.heightMap;
+		generatorChunkData.colorMap             = &createChunkBuffer.colorMap;
+		generatorChunkData.shaderMap            = &createChunkBuffer.shaderMap;
+		generatorChunkData.floraStaticCollidableMap    = &createChunkBuffer.floraStaticCollidableMap;
+		generatorChunkData.floraStaticNonCollidableMap = &createChunkBuffer.floraStaticNonCollidableMap;
+		generatorChunkData.floraDynamicNearMap  = &createChunkBuffer.floraDynamicNearMap;
+		generatorChunkData.floraDynamicFarMap   = &createChunkBuffer.floraDynamicFarMap;
+		generatorChunkData.environmentMap       = &createChunkBuffer.environmentMap;
+		generatorChunkData.vertexPositionMap    = &createChunkBuffer.vertexPositionMap;
+		generatorChunkData.vertexNormalMap      = &createChunkBuffer.vertexNormalMap;
+		generatorChunkData.excludeMap           = &createChunkBuffer.excludeMap;
+		generatorChunkData.passableMap          = &createChunkBuffer.passableMap;
+		generatorChunkData.start                = Vector (x - static_cast<float> (cms_originOffset) * distanceBetweenPoles, 0.f, z - static_cast<float> (cms_originOffset) * distanceBetweenPoles);
+		generatorChunkData.numberOfPoles        = numberOfPoles;
+		generatorChunkData.originOffset         = cms_originOffset;
+		generatorChunkData.upperPad             = cms_upperPad;
+		generatorChunkData.distanceBetweenPoles = distanceBetweenPoles;
+		generatorChunkData.shaderGroup          = &generator.getShaderGroup ();
+		generatorChunkData.floraGroup           = &generator.getFloraGroup ();
+		generatorChunkData.radialGroup          = &generator.getRadialGroup ();
+		generatorChunkData.environmentGroup     = &generator.getEnvironmentGroup ();
+		generatorChunkData.fractalGroup         = &generator.getFractalGroup ();
+		generatorChunkData.bitmapGroup          = &generator.getBitmapGroup ();
+
+		generator.generateChunk (generatorChunkData);
+	}
+}
+
+using namespace TerrainDirtyRegionNamespace;
+
+//===================================================================
+
+TerrainDirtyRegion::BenchmarkResult::BenchmarkResult () :
+	boundaryName (0),
+	entireMap (false),
+	numberOfChunks (0),
+	numberOfDirtyChunks (0),
+	numberOfSampledChunks (0),
+	calculateTime (0.f),
+	secondsPerChunk (0.f),
+	fullRegenerationTime (0.f),
+	dirtyRegenerationTime (0.f)
+{
+}
+
+//===================================================================
+
+void TerrainDirtyRegion::buildRecordMap (const TerrainGenerator& generator, RecordMap& recordMap)
+{
+	recordMap.clear ();
+
+	for (int i = 0; i < generator.getNumberOfLayers (); ++i)
+		buildLayerRecords (*generator.getLayer (i), 0, i, false, cms_emptyExtent, recordMap);
+}
+
+//-------------------------------------------------------------------
+
+void TerrainDirtyRegion::buildLayerRecords (const TerrainGenerator::Layer& layer, const TerrainGenerator::LayerItem* const parent, const int index, const bool ancestorBounded, const Rectangle2d& ancestorExtent, RecordMap& recordMap)
+{
+	bool        boundaryBounded;
+	Rectangle2d boundaryExtent;
+	calculateBoundaryExtent (layer, boundaryBounded, boundaryExtent);
+
+	//-- the layer itself affects everything its boundaries and its ancestors allow
+	Record & layerRecord = recordMap [&layer];
+	layerRecord.parent    = parent;
+	layerRecord.index     = index;
+	layerRecord.signature = calculateLayerSignature (layer);
+	layerRecord.bounded   = ancestorBounded;
+	layerRecord.extent    = ancestorExtent;
+	intersect (layerRecord.bounded, layerRecord.extent, boundaryBounded, boundaryExtent);
+
+	//-- nothing below an inactive layer is generated
+	bool        childBounded = layerRecord.bounded;
+	Rectangle2d childExtent  = layerRecord.extent;
+	bool        siblingBounded = ancestorBounded;
+	Rectangle2d siblingExtent  = ancestorExtent;
+
+	if (!layer.isActive ())
+	{
+		childBounded   = true;
+		childExtent    = cms_emptyExtent;
+		siblingBounded = true;
+		siblingExtent  = cms_emptyExtent;
+	}
+
+	//-- a boundary only changes the area it covers before and after the edit
+	{
+		for (int i = 0; i < layer.getNumberOfBoundaries (); ++i)
+		{
+			TerrainGenerator::Boundary const * const boundary = layer.getBoundary (i);
+
+			Rectangle2d extent (cms_emptyExtent);
+			boundary->expand (extent);
+
+			Record & record = recordMap [boundary];
+			record.parent    = &layer;
+			record.index     = i;
+			record.signature = calculateLayerItemSignature (*boundary);
+			record.bounded   = siblingBounded;
+			record.extent    = siblingExtent;
+			intersect (record.bounded, record.extent, true, extent);
+		}
+	}
+
+	{
+		for (int i = 0; i < layer.getNumberOfFilters (); ++i)
+		{
+			TerrainGenerator::Filter const * const filter = layer.getFilter (i);
+
+			Record & record = recordMap [filter];
+			record.parent    = &layer;
+			record.index     = i;
+			record.signature = calculateLayerItemSignature (*filter);
+			record.bounded   = childBounded;
+			record.extent    = childExtent;
+		}
+	}
+
+	{
+		for (int i = 0; i < layer.getNumberOfAffectors (); ++i)
+		{
+			TerrainGenerator::Affector const * const affector = layer.getAffector (i);
+
+			Record & record = recordMap [affector];
+			record.parent    = &layer;
+			record.index     = i;
+			record.signature = calculateLayerItemSignature (*affector);
+			record.bounded   = childBounded;
+			record.extent    = childExtent;
+
+			//-- rivers, roads and ribbons only touch the area around their spline
+			AffectorBoundaryPoly const * const affectorBoundaryPoly = dynamic_cast<AffectorBoundaryPoly const *> (affector);
+			if (affectorBoundaryPoly)
+				intersect (record.bounded, record.extent, true, affectorBoundaryPoly->getExtent ());
+		}
+	}
+
+	{
+		for (int i = 0; i < layer.getNumberOfLayers (); ++i)
+			buildLayerRecords (*layer.getLayer (i), &layer, i, childBounded, childExtent, recordMap);
+	}
+}
+
+//===================================================================
+
+bool TerrainDirtyRegion::calculateAffectedExtent (const TerrainGenerator& generator, const TerrainGenerator::LayerItem* const layerItem, Rectangle2d& extent)
+{
+	NOT_NULL (layerItem);
+
+	RecordMap recordMap;
+	buildRecordMap (generator, recordMap);
+
+	RecordMap::const_iterator const iter = recordMap.find (layerItem);
+	if (iter == recordMap.end () || !iter->second.bounded)
+		return false;
+
+	extent = iter->second.extent;
+
+	return true;
+}
+
+//-------------------------------------------------------------------
+
+int TerrainDirtyRegion::calculateNumberOfChunks (const Rectangle2d& extent, const float mapWidthInMeters, const float chunkWidthInMeters)
+{
+	DEBUG_FATAL (chunkWidthInMeters <= 0.f, ("TerrainDirtyRegion::calculateNumberOfChunks: invalid chunk width %1.2f", chunkWidthInMeters));
+
+	if (isEmptyExtent (extent))
+		return 0;
+
+	float const halfMapWidthInMeters = mapWidthInMeters * 0.5f;
+	int const   chunksPerSide        = static_cast<int> (mapWidthInMeters / chunkWidthInMeters);
+
+	if (extent.x1 < -halfMapWidthInMeters || extent.x0 > halfMapWidthInMeters || extent.y1 < -halfMapWidthInMeters || extent.y0 > halfMapWidthInMeters)
+		return 0;
+
+	int const x0 = clamp (0, static_cast<int> (floorf ((extent.x0 + halfMapWidthInMeters) / chunkWidthInMeters)), chunksPerSide - 1);
+	int const x1 = clamp (0, static_cast<int> (floorf ((extent.x1 + halfMapWidthInMeters) / chunkWidthInMeters)), chunksPerSide - 1);
+	int const z0 = clamp (0, static_cast<int> (floorf ((extent.y0 + halfMapWidthInMeters) / chunkWidthInMeters)), chunksPerSide - 1);
+	int const z1 = clamp (0, static_cast<int> (floorf ((extent.y1 + halfMapWidthInMeters) / chunkWidthInMeters)), chunksPerSide - 1);
+
+	return (x1 - x0 + 1) * (z1 - z0 + 1);
+}
+
+//-------------------------------------------------------------------
+//
+// Nudges the smallest active boundary in the generator by one chunk, measures how
+// many chunks the dirty region covers compared to regenerating every chunk on the
+// map, and times a sample of chunk generations to turn both into seconds. The
+// generator is restored before returning.
+//
+bool TerrainDirtyRegion::runBenchmark (TerrainGenerator& generator, const float mapWidthInMeters, const float chunkWidthInMeters, const int numberOfTilesPerChunk, const bool legacyMode, BenchmarkResult& result)
+{
+	result = BenchmarkResult ();
+
+	int const chunksPerSide = static_cast<int> (mapWidthInMeters / chunkWidthInMeters);
+	if (chunksPerSide <= 0 || numberOfTilesPerChunk <= 0)
+		return false;
+
+	result.numberOfChunks = chunksPerSide * chunksPerSide;
+
+	//-- find the smallest boundary to edit
+	TerrainGenerator::Boundary* boundary = 0;
+	{
+		float smallestArea = FLT_MAX;
+
+		for (int i = 0; i < generator.getNumberOfLayers (); ++i)
+			findSmallestBoundary (generator.getLayer (i), boundary, smallestArea);
+	}
+
+	if (!boundary)
+	{
+		REPORT_LOG (true, ("TerrainDirtyRegion benchmark: no active boundary to edit\n"));
+		return false;
+	}
+
+	result.boundaryName = boundary->getName ();
+
+	float const distanceBetweenPoles = chunkWidthInMeters / static_cast<float> (2 * numberOfTilesPerChunk);
+	int const   numberOfPoles        = 2 * numberOfTilesPerChunk + cms_originOffset + cms_upperPad;
+
+	generator.prepare ();
+
+	TerrainDirtyRegion dirtyRegion;
+	dirtyRegion.snapshot (generator);
+
+	//-- edit
+	boundary->translate (Vector2d (chunkWidthInMeters, 0.f));
+	generator.prepare ();
+
+	{
+		PerformanceTimer timer;
+		timer.start ();
+
+			IGNORE_RETURN (dirtyRegion.update (generator));
+
+		timer.stop ();
+		result.calculateTime = timer.getElapsedTime ();
+	}
+
+	result.entireMap = dirtyRegion.isEntireMap ();
+
+	if (result.entireMap)
+		result.numberOfDirtyChunks = result.numberOfChunks;
+	else if (!dirtyRegion.isEmpty ())
+	{
+		Rectangle2d extent (dirtyRegion.getExtent ());
+		float const pad = static_cast<float> (cms_upperPad) * distanceBetweenPoles;
+		extent.x0 -= pad;
+		extent.y0 -= pad;
+		extent.x1 += pad;
+		extent.y1 += pad;
+
+		result.numberOfDirtyChunks = calculateNumberOfChunks (extent, mapWidthInMeters, chunkWidthInMeters);
+	}
+
+	//-- time a sample of chunks spread over the map
+	{
+		TerrainGenerator::CreateChunkBuffer createChunkBuffer;
+		createChunkBuffer.allocate (numberOfPoles);
+
+		result.numberOfSampledChunks = std::min (cms_maximumNumberOfSampledChunks, result.numberOfChunks);
+
+		FastRandomGenerator randomGenerator (cms_benchmarkSeed);
+		float const halfMapWidthInMeters = mapWidthInMeters * 0.5f;
+
+		PerformanceTimer timer;
+		timer.start ();
+
+			for (int i = 0; i < result.numberOfSampledChunks; ++i)
+			{
+				float const x = static_cast<float> (randomGenerator.random (chunksPerSide)) * chunkWidthInMeters - halfMapWidthInMeters;
+				float const z = static_cast<float> (randomGenerator.random (chunksPerSide)) * chunkWidthInMeters - halfMapWidthInMeters;
+
+				generateChunk (generator, createChunkBuffer, x, z, numberOfPoles, distanceBetweenPoles, legacyMode);
+			}
+
+		timer.stop ();
+
+		result.secondsPerChunk       = result.numberOfSampledChunks > 0 ? timer.getElapsedTime () / static_cast<float> (result.numberOfSampledChunks) : 0.f;
+		result.fullRegenerationTime  = result.secondsPerChunk * static_cast<float> (result.numberOfChunks);
+		result.dirtyRegenerationTime = result.secondsPerChunk * static_cast<float> (result.numberOfDirtyChunks);
+	}
+
+	//-- restore
+	boundary->translate (Vector2d (-chunkWidthInMeters, 0.f));
+	generator.prepare ();
+
+	REPORT_LOG (true, ("TerrainDirtyRegion benchmark: moved boundary %s by %1.0fm on a %1.0fm map\n", result.boundaryName ? result.boundaryName : "<unnamed>", chunkWidthInMeters, mapWidthInMeters));
+	REPORT_LOG (true, ("  dirty region            %8.3f ms to calculate%s\n", result.calculateTime * 1000.f, result.entireMap ? " (entire map)" : ""));
+	REPORT_LOG (true, ("  full regeneration       %9i chunks  %10.2f s\n", result.numberOfChunks, result.fullRegenerationTime));
+	REPORT_LOG (true, ("  dirty regeneration      %9i chunks  %10.2f s  (%1.4f%% of the map)\n", result.numberOfDirtyChunks, result.dirtyRegenerationTime, 100.f * static_cast<float> (result.numberOfDirtyChunks) / static_cast<float> (result.numberOfChunks)));
+	REPORT_LOG (true, ("  %i sampled chunks, %1.3f ms per chunk\n", result.numberOfSampledChunks, result.secondsPerChunk * 1000.f));
+
+	return true;
+}
+
+//===================================================================
+
+TerrainDirtyRegion::TerrainDirtyRegion () :
+	m_recordMap (new RecordMap),
+	m_hasSnapshot (false),
+	m_groupSignature (0),
+	m_empty (true),
+	m_entireMap (false),
+	m_extent (cms_emptyExtent),
+	m_numberOfChangedItems (0)
+{
+}
+
+//-------------------------------------------------------------------
+
+TerrainDirtyRegion::~TerrainDirtyRegion ()
+{
+	delete m_recordMap;
+	m_recordMap = 0;
+}
+
+//-------------------------------------------------------------------
+
+void TerrainDirtyRegion::reset ()
+{
+	m_recordMap->clear ();
+	m_hasSnapshot          = false;
+	m_groupSignature       = 0;
+	m_empty                = true;
+	m_entireMap            = false;
+	m_extent               = cms_emptyExtent;
+	m_numberOfChangedItems = 0;
+}
+
+//-------------------------------------------------------------------
+
+void TerrainDirtyRegion::snapshot (const TerrainGenerator& generator)
+{
+	reset ();
+
+	buildRecordMap (generator, *m_recordMap);
+	m_groupSignature = calculateGroupSignature (generator);
+	m_hasSnapshot    = true;
+}
+
+//-------------------------------------------------------------------
+
+bool TerrainDirtyRegion::update (const TerrainGenerator& generator)
+{
+	m_empty                = true;
+	m_entireMap            = false;
+	m_extent               = cms_emptyExtent;
+	m_numberOfChangedItems = 0;
+
+	RecordMap recordMap;
+	buildRecordMap (generator, recordMap);
+
+	uint32 const groupSignature = calculateGroupSignature (generator);
+
+	if (!m_hasSnapshot || groupSignature != m_groupSignature)
+	{
+		addExtent (false, cms_emptyExtent);
+		m_numberOfChangedItems = static_cast<int> (recordMap.size ());
+	}
+	else
+	{
+		//-- added and changed items
+		for (RecordMap::const_iterator iter = recordMap.begin (); iter != recordMap.end (); ++iter)
+		{
+			Record const & record = iter->second;
+
+			RecordMap::const_iterator const previousIter = m_recordMap->find (iter->first);
+			if (previousIter == m_recordMap->end ())
+			{
+				++m_numberOfChangedItems;
+				addExtent (record.bounded, record.extent);
+				continue;
+			}
+
+			Record const & previousRecord = previousIter->second;
+
+			//-- a layer losing or gaining its last active boundary changes its whole area
+			if (record.signature != previousRecord.signature || record.parent != previousRecord.parent || record.index != previousRecord.index || record.bounded != previousRecord.bounded)
+			{
+				++m_numberOfChangedItems;
+				addExtent (previousRecord.bounded, previousRecord.extent);
+				addExtent (record.bounded, record.extent);
+			}
+		}
+
+		//-- removed items
+		for (RecordMap::const_iterator iter = m_recordMap->begin (); iter != m_recordMap->end (); ++iter)
+		{
+			if (recordMap.find (iter->first) == recordMap.end ())
+			{
+				++m_numberOfChangedItems;
+				addExtent (iter->second.bounded, iter->second.extent);
+			}
+		}
+	}
+
+	m_recordMap->swap (recordMap);
+	m_groupSignature = groupSignature;
+	m_hasSnapshot    = true;
+
+	return !m_empty;
+}
+
+//-------------------------------------------------------------------
+
+bool TerrainDirtyRegion::intersects (const Rectangle2d& extent) const
+{
+	if (m_entireMap)
+		return true;
+
+	if (m_empty)
+		return false;
+
+	return m_extent.intersects (extent);
+}
+
+//-------------------------------------------------------------------
+
+void TerrainDirtyRegion::addExtent (const bool bounded, const Rectangle2d& extent)
+{
+	if (!bounded)
+	{
+		m_empty     = false;
+		m_entireMap = true;
+		return;
+	}
+
+	if (isEmptyExtent (extent))
+		return;
+
+	m_empty = false;
+	m_extent.expand (extent);
+}
+
+//===================================================================
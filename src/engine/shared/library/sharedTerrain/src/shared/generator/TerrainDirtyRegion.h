@@ -0,0 +1,143 @@
+//===================================================================
+//
+// TerrainDirtyRegion.h
+//
+// copyright 2026
+//
+//===================================================================
+
+#ifndef INCLUDED_TerrainDirtyRegion_H
+#define INCLUDED_TerrainDirtyRegion_H
+
+//===================================================================
+
+#include "sharedMath/Rectangle2d.h"
+#include "sharedTerrain/TerrainGenerator.h"
+
+//-------------------------------------------------------------------
+//
+// TerrainDirtyRegion tracks edits to a TerrainGenerator and reports
+// the world space extent that has to be regenerated.
+//
+// A snapshot records a signature and the affected extent of every
+// LayerItem in the generator. update () compares the generator against
+// the snapshot and accumulates the extents of all added, removed,
+// changed and reordered items, then takes a new snapshot.
+//
+// The affected extent of an item is bounded by the boundaries of the
+// layers that contain it. Boundaries and river/road/ribbon affectors
+// also contribute their own extent. An item in a layer without active
+// (or with inverted) boundaries affects everything its ancestors affect,
+// which may be the entire map. Edits to the shared groups (shaders,
+// flora, fractals, bitmaps...) always dirty the entire map.
+//
+// Chunks sample a few poles beyond their own extent, so callers should
+// pad the extent by their pole spacing before testing chunks against it.
+//
+
+class TerrainDirtyRegion
+{
+public:
+
+	struct BenchmarkResult
+	{
+	public:
+
+		BenchmarkResult ();
+
+	public:
+
+		const char* boundaryName;
+		bool        entireMap;
+		int         numberOfChunks;
+		int         numberOfDirtyChunks;
+		int         numberOfSampledChunks;
+		float       calculateTime;
+		float       secondsPerChunk;
+		float       fullRegenerationTime;
+		float       dirtyRegenerationTime;
+	};
+
+public:
+
+	static bool calculateAffectedExtent (const TerrainGenerator& generator, const TerrainGenerator::LayerItem* layerItem, Rectangle2d& extent);
+	static int  calculateNumberOfChunks (const Rectangle2d& extent, float mapWidthInMeters, float chunkWidthInMeters);
+
+	static bool runBenchmark (TerrainGenerator& generator, float mapWidthInMeters, float chunkWidthInMeters, int numberOfTilesPerChunk, bool legacyMode, BenchmarkResult& result);
+
+public:
+
+	TerrainDirtyRegion ();
+	~TerrainDirtyRegion ();
+
+	void               reset ();
+	void               snapshot (const TerrainGenerator& generator);
+	bool               update (const TerrainGenerator& generator);
+
+	bool               isEmpty () const;
+	bool               isEntireMap () const;
+	const Rectangle2d& getExtent () const;
+	int                getNumberOfChangedItems () const;
+
+	bool               intersects (const Rectangle2d& extent) const;
+
+private:
+
+	struct Record;
+	typedef stdmap<const TerrainGenerator::LayerItem*, Record>::fwd RecordMap;
+
+private:
+
+	static void buildRecordMap (const TerrainGenerator& generator, RecordMap& recordMap);
+	static void buildLayerRecords (const TerrainGenerator::Layer& layer, const TerrainGenerator::LayerItem* parent, int index, bool ancestorBounded, const Rectangle2d& ancestorExtent, RecordMap& recordMap);
+
+	void addExtent (bool bounded, const Rectangle2d& extent);
+
+private:
+
+	TerrainDirtyRegion (const TerrainDirtyRegion& rhs);
+	TerrainDirtyRegion& operator= (const TerrainDirtyRegion& rhs);
+
+private:
+
+	RecordMap*  m_recordMap;
+	bool        m_hasSnapshot;
+	uint32      m_groupSignature;
+
+	bool        m_empty;
+	bool        m_entireMap;
+	Rectangle2d m_extent;
+	int         m_numberOfChangedItems;
+};
+
+//===================================================================
+
+inline bool TerrainDirtyRegion::isEmpty () const
+{
+	return m_empty;
+}
+
+//-------------------------------------------------------------------
+
+inline bool TerrainDirtyRegion::isEntireMap () const
+{
+	return m_entireMap;
+}
+
+//-------------------------------------------------------------------
+
+inline const Rectangle2d& TerrainDirtyRegion::getExtent () const
+{
+	return m_extent;
+}
+
+//-------------------------------------------------------------------
+
+inline int TerrainDirtyRegion::getNumberOfChangedItems () const
+{
+	return m_numberOfChangedItems;
+}
+
+//===================================================================
+
+#endif
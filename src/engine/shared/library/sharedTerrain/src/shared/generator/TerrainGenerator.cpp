@@ -15,6 +15,7 @@
 #include "sharedMath/Vector2d.h"
 #include "sharedTerrain/Feather.h"
 #include "sharedTerrain/TerrainGeneratorLoader.h"
+#include "sharedTerrain/TerrainGeneratorProfiler.h"
 #include "sharedTerrain/Filter.h"
 
 #include <algorithm>
@@ -1015,6 +1016,33 @@ bool TerrainGenerator::Layer::prune(unsigned &mapMask, const Rectangle2d &chunkE
 
 void TerrainGenerator::Layer::affect (const float * previousAmountMap, const GeneratorChunkData& generatorChunkData) const
 {
+	//-----------------------------------------------------------------------
+	//-- profiling is opt in, when disabled the sample arrays stay null and only the pointer tests remain
+	TerrainGeneratorProfiler::ItemSample* boundarySamples = 0;
+	TerrainGeneratorProfiler::ItemSample* filterSamples = 0;
+	TerrainGeneratorProfiler::ItemSample* affectorSamples = 0;
+	float subLayerTime = 0.f;
+	PerformanceTimer layerTimer;
+	PerformanceTimer itemTimer;
+
+	const bool profile = TerrainGeneratorProfiler::isEnabled ();
+	if (profile)
+	{
+		const int boundarySamplesSize = std::max (1, m_boundaryList.getNumberOfElements ()) * static_cast<int> (sizeof (*boundarySamples));
+		boundarySamples = static_cast<TerrainGeneratorProfiler::ItemSample*> (_alloca (boundarySamplesSize));
+		memset (boundarySamples, 0, boundarySamplesSize);
+
+		const int filterSamplesSize = std::max (1, m_filterList.getNumberOfElements ()) * static_cast<int> (sizeof (*filterSamples));
+		filterSamples = static_cast<TerrainGeneratorProfiler::ItemSample*> (_alloca (filterSamplesSize));
+		memset (filterSamples, 0, filterSamplesSize);
+
+		const int affectorSamplesSize = std::max (1, m_affectorList.getNumberOfElements ()) * static_cast<int> (sizeof (*affectorSamples));
+		affectorSamples = static_cast<TerrainGeneratorProfiler::ItemSample*> (_alloca (affectorSamplesSize));
+		memset (affectorSamples, 0, affectorSamplesSize);
+
+		layerTimer.start ();
+	}
+
 	//-----------------------------------------------------------------------
 	//-- scan filters to see if we need to generate plane and vertex normals
 	if (m_hasActiveFilters)
@@ -1092,122 +1120,185 @@ void TerrainGenerator::Layer::affect (const float * previousAmountMap, const Gen
 					memset(boundaryMap, 0, boundaryMapSize);
 				}
 
+				if (boundarySamples)
+					itemTimer.start ();
+
 				b->scanConvertGT(boundaryMap, generatorChunkData.chunkExtentIUO, numberOfPoles);
+
+				if (boundarySamples)
+				{
+					itemTimer.stop ();
+					boundarySamples [i].time += itemTimer.getElapsedTime ();
+					boundarySamples [i].numberOfPoles += numberOfPoles * numberOfPoles;
+				}
 			}
 		}
 		//---------------------------------------------------------------------------------------------
 
+		//---------------------------------------------------------------------------------------------
+		//-- every item runs over the whole chunk before the next one starts so each is timed once per
+		//   chunk. filters and affectors only read and write their own pole, so running them item by
+		//   item gives the same result as running them pole by pole
+		const int numberOfPolesTotal = numberOfPoles * numberOfPoles;
+		float *fuzzyMap = (float *)_alloca(numberOfPolesTotal*sizeof(*fuzzyMap));
+
 		const bool invertBoundaries=m_invertBoundaries;
-		const float distanceBetweenPoles = generatorChunkData.distanceBetweenPoles;
-		for (int z = 0; z < numberOfPoles; z++)
+		for (int index = 0; index < numberOfPolesTotal; index++)
 		{
-			const int rowIndex = z * numberOfPoles;
+			float fuzzyTest = boundaryMap ? boundaryMap[index] : 1.f;
+
+			if (invertBoundaries)
+			{
+				fuzzyTest = 1.f - fuzzyTest;
+			}
 
-			const float worldZ = generatorChunkData.start.z + static_cast<float>(z)*distanceBetweenPoles;
-			const float *previousAmountRow = previousAmountMap + rowIndex;
+			DEBUG_FATAL (fuzzyTest < 0.f || fuzzyTest > 1.f, ("Boundary tests returned invalid value: %1.3f", fuzzyTest));
 
-			for (int x = 0; x < numberOfPoles; x++)
+			fuzzyMap[index] = fuzzyTest;
+		}
+
+		const float distanceBetweenPoles = generatorChunkData.distanceBetweenPoles;
+
+		//---------------------------------------------------------------------------------------------
+		//-- see if each pole passes all filters (if any)
+		if (m_hasActiveFilters)
+		{
+			for (int i = 0; i < m_filterList.getNumberOfElements (); i++)
 			{
-				const float worldX         = generatorChunkData.start.x + static_cast<float>(x)*distanceBetweenPoles;
-				const float previousAmount = previousAmountRow[x];
+				if (!m_filterList [i]->isActive ())
+				{
+					continue;
+				}
 
-				float fuzzyTest;
-				//-------------------------------------------------------------------------------------
-				if (boundaryMap)
+				if(m_filterList[i]->getType() == TGFT_bitmap) // special case the bitmap filter because of boundaries
 				{
-					fuzzyTest=boundaryMap[rowIndex + x];
+					FilterBitmap *filterBitmap = safe_cast<FilterBitmap *>(m_filterList[i]);
+					filterBitmap->setExtent(m_extent);
 				}
-				else
+
+				const Feather feather (m_filterList [i]->getFeatherFunction ());
+				int numberOfPolesTested = 0;
+
+				if (filterSamples)
+					itemTimer.start ();
+
+				for (int z = 0; z < numberOfPoles; z++)
 				{
-					fuzzyTest=1.0;
+					const int rowIndex = z * numberOfPoles;
+					const float worldZ = generatorChunkData.start.z + static_cast<float>(z)*distanceBetweenPoles;
+
+					for (int x = 0; x < numberOfPoles; x++)
+					{
+						float &fuzzyTest = fuzzyMap[rowIndex + x];
+						if (fuzzyTest > 0.f)
+						{
+							const float worldX = generatorChunkData.start.x + static_cast<float>(x)*distanceBetweenPoles;
+							const float amount = m_filterList [i]->isWithin (worldX, worldZ, x, z, generatorChunkData);
+							++numberOfPolesTested;
+
+							DEBUG_FATAL (amount < 0.f || amount > 1.f, ("amount out of range [0-1] %1.2f", amount));
+
+							fuzzyTest = FuzzyAnd (fuzzyTest, feather.feather (0.f, 1.f, amount));
+						}
+					}
 				}
-				//-------------------------------------------------------------------------------------
-				//float _fuzzyTest;
-				//_oldBoundaryTest(_fuzzyTest, worldX, worldZ);
-				//DEBUG_FATAL(fabs(_fuzzyTest-fuzzyTest)>1e-6, (""));
-				//-------------------------------------------------------------------------------------
 
-				if (invertBoundaries)
+				if (filterSamples)
+				{
+					itemTimer.stop ();
+					filterSamples [i].time += itemTimer.getElapsedTime ();
+					filterSamples [i].numberOfPoles += numberOfPolesTested;
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------------------------------
+		//-- poles outside the boundaries stay at zero, the filter inversion only applies to poles inside them
+		for (int index = 0; index < numberOfPolesTotal; index++)
+		{
+			float &fuzzyTest = fuzzyMap[index];
+
+			DEBUG_FATAL (fuzzyTest < 0.f || fuzzyTest > 1.f, ("Filter tests returned invalid value: %1.3f", fuzzyTest));
+
+			if (m_invertFilters)
+			{
+				const float boundaryTest = boundaryMap ? boundaryMap[index] : 1.f;
+				if ((invertBoundaries ? 1.f - boundaryTest : boundaryTest) > 0.f)
 				{
 					fuzzyTest = 1.f - fuzzyTest;
 				}
+			}
+
+			//-- there was at least one fuzzy test valid here, so we should affect sublayers
+			if (fuzzyTest > 0.f)
+			{
+				shouldAffectSubLayers = true;
+			}
+		}
+
+		//---------------------------------------------------------------------------------------------
+		//-- run all affectors
+		if (shouldAffectSubLayers && m_hasUnprunedAffectors)
+		{
+			for (int i = 0; i < m_affectorList.getNumberOfElements (); i++)
+			{
+				Affector *a = m_affectorList[i];
+				if (a->isPruned())
+				{
+					continue;
+				}
 
-				DEBUG_FATAL (fuzzyTest < 0.f || fuzzyTest > 1.f, ("Boundary tests returned invalid value: %1.3f", fuzzyTest));
+				int numberOfPolesAffected = 0;
 
-				if (fuzzyTest > 0.f)
+				if (affectorSamples)
+					itemTimer.start ();
+
+				for (int z = 0; z < numberOfPoles; z++)
 				{
-					//-- see if it passes all filters (if any)
-					if (m_hasActiveFilters)
+					const int rowIndex = z * numberOfPoles;
+					const float worldZ = generatorChunkData.start.z + static_cast<float>(z)*distanceBetweenPoles;
+					const float *previousAmountRow = previousAmountMap + rowIndex;
+
+					for (int x = 0; x < numberOfPoles; x++)
 					{
-						int i;
-						for (i = 0; i < m_filterList.getNumberOfElements (); i++)
+						const float fuzzyTest = fuzzyMap[rowIndex + x];
+						if (fuzzyTest > 0.f)
 						{
-							if (m_filterList [i]->isActive ())
-							{
-
-								if(m_filterList[i]->getType() == TGFT_bitmap) // special case the bitmap filter because of boundaries
-								{
-									FilterBitmap *filterBitmap = safe_cast<FilterBitmap *>(m_filterList[i]);
-									filterBitmap->setExtent(m_extent);
-								}
-								
-								const Feather feather (m_filterList [i]->getFeatherFunction ());
-
-								const float amount = m_filterList [i]->isWithin (worldX, worldZ, x, z, generatorChunkData);
-								
-								DEBUG_FATAL (amount < 0.f || amount > 1.f, ("amount out of range [0-1] %1.2f", amount));
-
-								fuzzyTest = FuzzyAnd (fuzzyTest, feather.feather (0.f, 1.f, amount));
-
-								if (fuzzyTest == 0.f) 
-									break;
-								
-							}
+							const float worldX = generatorChunkData.start.x + static_cast<float>(x)*distanceBetweenPoles;
+							a->affect (worldX, worldZ, x, z, fuzzyTest * previousAmountRow[x], generatorChunkData);
+							++numberOfPolesAffected;
 						}
-
 					}
+				}
 
-					DEBUG_FATAL (fuzzyTest < 0.f || fuzzyTest > 1.f, ("Filter tests returned invalid value: %1.3f", fuzzyTest));
+				if (affectorSamples)
+				{
+					itemTimer.stop ();
+					affectorSamples [i].time += itemTimer.getElapsedTime ();
+					affectorSamples [i].numberOfPoles += numberOfPolesAffected;
+				}
 
-					if (m_invertFilters)
+				if (numberOfPolesAffected > 0)
+				{
+					if (a->affectsHeight())
 					{
-						fuzzyTest = 1.f - fuzzyTest;
+						generatorChunkData.normalsDirtyIUO = true;
 					}
-					
-					if (fuzzyTest > 0.f)
-					{
-						//-- there was at least one fuzzy test valid here, so we should affect sublayers
-						shouldAffectSubLayers = true;
 
-						//-- run all affectors
-						if (m_hasUnprunedAffectors)
-						{
-							for (int i = 0; i < m_affectorList.getNumberOfElements (); i++)
-							{
-								Affector *a = m_affectorList[i];
-								if (!a->isPruned())
-								{
-									a->affect (worldX, worldZ, x, z, fuzzyTest * previousAmount, generatorChunkData);
-
-									if (a->affectsHeight())
-									{
-										generatorChunkData.normalsDirtyIUO = true;
-									}
-
-									if (a->affectsShader())
-									{
-										generatorChunkData.shadersDirtyIUO = true;
-									}
-								}
-							}
-						}
+					if (a->affectsShader())
+					{
+						generatorChunkData.shadersDirtyIUO = true;
 					}
 				}
+			}
+		}
 
-				if (amountMap)
-				{
-					amountMap[rowIndex + x]=fuzzyTest * previousAmount;
-				}
+		//---------------------------------------------------------------------------------------------
+		if (amountMap)
+		{
+			for (int index = 0; index < numberOfPolesTotal; index++)
+			{
+				amountMap[index]=fuzzyMap[index] * previousAmountMap[index];
 			}
 		}
 	}
@@ -1215,6 +1306,9 @@ void TerrainGenerator::Layer::affect (const float * previousAmountMap, const Gen
 	//-- now affect the layers
 	if (shouldAffectSubLayers && m_hasActiveLayers)
 	{
+		if (profile)
+			itemTimer.start ();
+
 		for (int i = 0; i < m_subLayerList.getNumberOfElements (); i++)
 		{
 			const Layer *l = m_subLayerList[i];
@@ -1223,6 +1317,18 @@ void TerrainGenerator::Layer::affect (const float * previousAmountMap, const Gen
 				l->affect(onlyHasSubLayers ? previousAmountMap : amountMap, generatorChunkData);
 			}
 		}
+
+		if (profile)
+		{
+			itemTimer.stop ();
+			subLayerTime = itemTimer.getElapsedTime ();
+		}
+	}
+
+	if (profile)
+	{
+		layerTimer.stop ();
+		TerrainGeneratorProfiler::addLayerSample (*this, m_profileData, layerTimer.getElapsedTime (), subLayerTime, boundarySamples, filterSamples, affectorSamples);
 	}
 }
 
@@ -1951,7 +2057,18 @@ void TerrainGenerator::generateChunk (const GeneratorChunkData& generatorChunkDa
 	}
 
 	//-- run the affectors
-	affect (generatorChunkData);
+	if (TerrainGeneratorProfiler::isEnabled ())
+	{
+		PerformanceTimer timer;
+		timer.start ();
+
+		affect (generatorChunkData);
+
+		timer.stop ();
+		TerrainGeneratorProfiler::addChunkSample (timer.getElapsedTime (), generatorChunkData.numberOfPoles * generatorChunkData.numberOfPoles);
+	}
+	else
+		affect (generatorChunkData);
 }
 
 //----------------------------------------------------------------------
@@ -2316,6 +2433,8 @@ void TerrainGenerator::Layer::resetProfileData ()
 
 void TerrainGenerator::resetProfileData ()
 {
+	TerrainGeneratorProfiler::reset ();
+
 	int i;
 	for (i = 0; i < m_layerList.getNumberOfElements (); i++)
 		m_layerList [i]->resetProfileData ();
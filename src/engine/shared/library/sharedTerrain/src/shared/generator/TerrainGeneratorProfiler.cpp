@@ -0,0 +1,362 @@
+//===================================================================
+//
+// TerrainGeneratorProfiler.cpp
+//
+// copyright 2026
+//
+//===================================================================
+
+#include "sharedTerrain/FirstSharedTerrain.h"
+#include "sharedTerrain/TerrainGeneratorProfiler.h"
+
+#include "sharedDebug/DebugFlags.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedSynchronization/Mutex.h"
+
+#include <algorithm>
+#include <map>
+#include <stdio.h>
+#include <vector>
+
+//===================================================================
+
+namespace TerrainGeneratorProfilerNamespace
+{
+	typedef std::map<const TerrainGenerator::LayerItem*, TerrainGeneratorProfiler::Record> RecordMap;
+
+	char const * const cms_reportFileName = "terrainGeneratorProfile.json";
+	int const          cms_numberOfReportedRecords = 16;
+
+	bool      ms_installed;
+	bool      ms_debugReport;
+	bool      ms_writeReport;
+
+	Mutex     ms_mutex;
+	RecordMap ms_recordMap;
+	int       ms_numberOfChunks;
+	int       ms_numberOfChunkPoles;
+	float     ms_chunkTime;
+
+	//----------------------------------------------------------------------
+
+	//-- must be called with ms_mutex held
+	TerrainGeneratorProfiler::Record& findRecord (const TerrainGenerator::LayerItem& layerItem, const char* const type, const TerrainGenerator::Layer* const layer)
+	{
+		RecordMap::iterator iter = ms_recordMap.find (&layerItem);
+		if (iter == ms_recordMap.end ())
+		{
+			TerrainGeneratorProfiler::Record record;
+			record.type = type;
+			record.tag = layerItem.getTag ();
+			record.name = layerItem.getName () ? layerItem.getName () : "";
+			record.layerName = (layer && layer->getName ()) ? layer->getName () : "";
+
+			iter = ms_recordMap.insert (std::make_pair (&layerItem, record)).first;
+		}
+
+		return iter->second;
+	}
+
+	//----------------------------------------------------------------------
+
+	float addItemSamples (const TerrainGenerator::LayerItem& layerItem, const char* const type, const TerrainGenerator::Layer& layer, const TerrainGeneratorProfiler::ItemSample* const samples, const int index)
+	{
+		if (!samples || samples [index].numberOfPoles == 0)
+			return 0.f;
+
+		TerrainGeneratorProfiler::Record& record = findRecord (layerItem, type, &layer);
+		record.time          += samples [index].time;
+		record.totalTime     += samples [index].time;
+		record.numberOfPoles += samples [index].numberOfPoles;
+		++record.numberOfCalls;
+
+		return samples [index].time;
+	}
+
+	//----------------------------------------------------------------------
+
+	bool compareRecords (const TerrainGeneratorProfiler::Record& lhs, const TerrainGeneratorProfiler::Record& rhs)
+	{
+		return lhs.time > rhs.time;
+	}
+
+	//----------------------------------------------------------------------
+
+	void appendJsonString (std::string& output, const std::string& value)
+	{
+		output += '"';
+
+		for (std::string::const_iterator iter = value.begin (); iter != value.end (); ++iter)
+		{
+			const char ch = *iter;
+			switch (ch)
+			{
+			case '"':  output += "\\\""; break;
+			case '\\': output += "\\\\"; break;
+			case '\n': output += "\\n";  break;
+			case '\r': output += "\\r";  break;
+			case '\t': output += "\\t";  break;
+			default:
+				if (static_cast<unsigned char> (ch) < 0x20)
+				{
+					char buffer [8];
+					sprintf (buffer, "\\u%04x", static_cast<int> (ch));
+					output += buffer;
+				}
+				else
+					output += ch;
+				break;
+			}
+		}
+
+		output += '"';
+	}
+}
+
+using namespace TerrainGeneratorProfilerNamespace;
+
+//===================================================================
+
+bool TerrainGeneratorProfiler::ms_enabled;
+
+//===================================================================
+
+TerrainGeneratorProfiler::Record::Record () :
+	type (""),
+	tag (0),
+	name (),
+	layerName (),
+	time (0.f),
+	totalTime (0.f),
+	numberOfPoles (0),
+	numberOfCalls (0)
+{
+}
+
+//===================================================================
+// STATIC PUBLIC TerrainGeneratorProfiler
+//===================================================================
+
+void TerrainGeneratorProfiler::install ()
+{
+	DEBUG_FATAL (ms_installed, ("TerrainGeneratorProfiler::install already installed"));
+	ms_installed = true;
+
+	DebugFlags::registerFlag (ms_enabled, "SharedTerrain/TerrainGeneratorProfiler", "enabled");
+	DebugFlags::registerFlag (ms_debugReport, "SharedTerrain/TerrainGeneratorProfiler", "debugReport", debugReport);
+	DebugFlags::registerFlag (ms_writeReport, "SharedTerrain/TerrainGeneratorProfiler", "writeReport", writeReportFromDebugFlag);
+
+	ExitChain::add (remove, "TerrainGeneratorProfiler::remove");
+}
+
+//-------------------------------------------------------------------
+
+void TerrainGeneratorProfiler::setEnabled (const bool enabled)
+{
+	ms_enabled = enabled;
+}
+
+//-------------------------------------------------------------------
+
+void TerrainGeneratorProfiler::reset ()
+{
+	ms_mutex.enter ();
+
+		ms_recordMap.clear ();
+		ms_numberOfChunks = 0;
+		ms_numberOfChunkPoles = 0;
+		ms_chunkTime = 0.f;
+
+	ms_mutex.leave ();
+}
+
+//-------------------------------------------------------------------
+
+void TerrainGeneratorProfiler::addChunkSample (const float time, const int numberOfPoles)
+{
+	ms_mutex.enter ();
+
+		++ms_numberOfChunks;
+		ms_numberOfChunkPoles += numberOfPoles;
+		ms_chunkTime += time;
+
+	ms_mutex.leave ();
+}
+
+//-------------------------------------------------------------------
+
+void TerrainGeneratorProfiler::addLayerSample (const TerrainGenerator::Layer& layer, TerrainGenerator::Layer::ProfileData& profileData, const float totalTime, const float subLayerTime, const ItemSample* const boundarySamples, const ItemSample* const filterSamples, const ItemSample* const affectorSamples)
+{
+	ms_mutex.enter ();
+
+		float timeInBoundaries = 0.f;
+		float timeInFilters = 0.f;
+		float timeInAffectors = 0.f;
+
+		int i;
+		for (i = 0; i < layer.getNumberOfBoundaries (); ++i)
+			timeInBoundaries += addItemSamples (*layer.getBoundary (i), "boundary", layer, boundarySamples, i);
+
+		for (i = 0; i < layer.getNumberOfFilters (); ++i)
+			timeInFilters += addItemSamples (*layer.getFilter (i), "filter", layer, filterSamples, i);
+
+		for (i = 0; i < layer.getNumberOfAffectors (); ++i)
+			timeInAffectors += addItemSamples (*layer.getAffector (i), "affector", layer, affectorSamples, i);
+
+		const float timeInOverhead = std::max (0.f, totalTime - subLayerTime - timeInBoundaries - timeInFilters - timeInAffectors);
+
+		profileData.timeInOverhead   += timeInOverhead;
+		profileData.timeInBoundaries += timeInBoundaries;
+		profileData.timeInFilters    += timeInFilters;
+		profileData.timeInAffectors  += timeInAffectors;
+		profileData.timeInSubLayers  += subLayerTime;
+
+		//-- the layer's own time is its overhead, everything else is attributed to its items and sublayers
+		Record& record = findRecord (layer, "layer", 0);
+		record.time      += timeInOverhead;
+		record.totalTime += totalTime;
+		++record.numberOfCalls;
+
+	ms_mutex.leave ();
+}
+
+//-------------------------------------------------------------------
+
+int TerrainGeneratorProfiler::getNumberOfChunks ()
+{
+	return ms_numberOfChunks;
+}
+
+//-------------------------------------------------------------------
+
+float TerrainGeneratorProfiler::getChunkTime ()
+{
+	return ms_chunkTime;
+}
+
+//-------------------------------------------------------------------
+
+void TerrainGeneratorProfiler::getRecords (RecordList& recordList)
+{
+	recordList.clear ();
+
+	ms_mutex.enter ();
+
+		recordList.reserve (ms_recordMap.size ());
+
+		for (RecordMap::const_iterator iter = ms_recordMap.begin (); iter != ms_recordMap.end (); ++iter)
+			recordList.push_back (iter->second);
+
+	ms_mutex.leave ();
+
+	std::stable_sort (recordList.begin (), recordList.end (), compareRecords);
+}
+
+//-------------------------------------------------------------------
+
+void TerrainGeneratorProfiler::buildReport (std::string& report)
+{
+	RecordList recordList;
+	getRecords (recordList);
+
+	char buffer [256];
+
+	report = "{\n";
+
+	sprintf (buffer, "  \"numberOfChunks\": %i,\n  \"numberOfPoles\": %i,\n  \"chunkTime\": %.6f,\n", ms_numberOfChunks, ms_numberOfChunkPoles, ms_chunkTime);
+	report += buffer;
+
+	report += "  \"items\": [";
+
+	for (RecordList::const_iterator iter = recordList.begin (); iter != recordList.end (); ++iter)
+	{
+		const Record& record = *iter;
+
+		char tagBuffer [5];
+		ConvertTagToString (record.tag, tagBuffer);
+
+		report += iter == recordList.begin () ? "\n    { \"type\": " : ",\n    { \"type\": ";
+		appendJsonString (report, record.type);
+		report += ", \"tag\": ";
+		appendJsonString (report, tagBuffer);
+		report += ", \"name\": ";
+		appendJsonString (report, record.name);
+		report += ", \"layer\": ";
+		appendJsonString (report, record.layerName);
+
+		const float timePerPole = record.numberOfPoles > 0 ? record.time / static_cast<float> (record.numberOfPoles) : 0.f;
+		sprintf (buffer, ", \"time\": %.6f, \"totalTime\": %.6f, \"poles\": %i, \"calls\": %i, \"nanosecondsPerPole\": %.1f }", record.time, record.totalTime, record.numberOfPoles, record.numberOfCalls, timePerPole * 1.0e9f);
+		report += buffer;
+	}
+
+	report += "\n  ]\n}\n";
+}
+
+//-------------------------------------------------------------------
+
+bool TerrainGeneratorProfiler::writeReport (const char* const fileName)
+{
+	NOT_NULL (fileName);
+
+	std::string report;
+	buildReport (report);
+
+	FILE* const outfile = fopen (fileName, "wt");
+	if (!outfile)
+	{
+		DEBUG_WARNING (true, ("TerrainGeneratorProfiler: could not open %s", fileName));
+		return false;
+	}
+
+	IGNORE_RETURN (fwrite (report.c_str (), 1, report.size (), outfile));
+	IGNORE_RETURN (fclose (outfile));
+
+	return true;
+}
+
+//===================================================================
+// STATIC PRIVATE TerrainGeneratorProfiler
+//===================================================================
+
+void TerrainGeneratorProfiler::remove ()
+{
+	DEBUG_FATAL (!ms_installed, ("TerrainGeneratorProfiler::remove not installed"));
+	ms_installed = false;
+
+	DebugFlags::unregisterFlag (ms_enabled);
+	DebugFlags::unregisterFlag (ms_debugReport);
+	DebugFlags::unregisterFlag (ms_writeReport);
+
+	reset ();
+}
+
+//-------------------------------------------------------------------
+
+void TerrainGeneratorProfiler::debugReport ()
+{
+	RecordList recordList;
+	getRecords (recordList);
+
+	DEBUG_REPORT_PRINT (true, ("-- TerrainGeneratorProfiler %s\n", ms_enabled ? "" : "(disabled)"));
+	DEBUG_REPORT_PRINT (true, ("  chunks = %i, %1.3f seconds\n", ms_numberOfChunks, ms_chunkTime));
+
+	const int numberOfRecords = std::min (cms_numberOfReportedRecords, static_cast<int> (recordList.size ()));
+	for (int i = 0; i < numberOfRecords; ++i)
+	{
+		const Record& record = recordList [static_cast<size_t> (i)];
+		DEBUG_REPORT_PRINT (true, ("  %1.3f %-8s %-32s (%s) %i poles\n", record.time, record.type, record.name.c_str (), record.layerName.c_str (), record.numberOfPoles));
+	}
+}
+
+//-------------------------------------------------------------------
+
+void TerrainGeneratorProfiler::writeReportFromDebugFlag ()
+{
+	//-- one shot
+	ms_writeReport = false;
+
+	if (writeReport (cms_reportFileName))
+		REPORT_LOG_PRINT (true, ("TerrainGeneratorProfiler: wrote %s\n", cms_reportFileName));
+}
+
+//===================================================================
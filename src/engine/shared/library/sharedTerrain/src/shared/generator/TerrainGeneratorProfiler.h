@@ -0,0 +1,110 @@
+//===================================================================
+//
+// TerrainGeneratorProfiler.h
+//
+// copyright 2026
+//
+//===================================================================
+
+#ifndef INCLUDED_TerrainGeneratorProfiler_H
+#define INCLUDED_TerrainGeneratorProfiler_H
+
+//===================================================================
+
+#include "sharedTerrain/TerrainGenerator.h"
+
+#include <string>
+
+//-------------------------------------------------------------------
+//
+// TerrainGeneratorProfiler records the time spent and the number of
+// poles processed by every Layer, Boundary, Filter and Affector while
+// TerrainGenerator generates chunks.
+//
+// Profiling is opt in. When it is disabled, the generator only tests
+// isEnabled () once per layer and once around each item call.
+//
+// A layer's own time is its overhead, i.e. the time not spent in its
+// boundaries, filters, affectors or sublayers. Its total time includes
+// all of them. Records are sorted by their own time, so the most
+// expensive items come first.
+//
+// The results are reported through the SharedTerrain/TerrainGeneratorProfiler
+// debug flags and can be written out as a JSON report.
+//
+
+class TerrainGeneratorProfiler
+{
+public:
+
+	struct ItemSample
+	{
+		float time;
+		int   numberOfPoles;
+	};
+
+	struct Record
+	{
+	public:
+
+		Record ();
+
+	public:
+
+		const char* type;
+		Tag         tag;
+		std::string name;
+		std::string layerName;
+		float       time;
+		float       totalTime;
+		int         numberOfPoles;
+		int         numberOfCalls;
+	};
+
+	typedef stdvector<Record>::fwd RecordList;
+
+public:
+
+	static void  install ();
+
+	static bool  isEnabled ();
+	static void  setEnabled (bool enabled);
+	static void  reset ();
+
+	static void  addChunkSample (float time, int numberOfPoles);
+	static void  addLayerSample (const TerrainGenerator::Layer& layer, TerrainGenerator::Layer::ProfileData& profileData, float totalTime, float subLayerTime, const ItemSample* boundarySamples, const ItemSample* filterSamples, const ItemSample* affectorSamples);
+
+	static int   getNumberOfChunks ();
+	static float getChunkTime ();
+	static void  getRecords (RecordList& recordList);
+
+	static void  buildReport (std::string& report);
+	static bool  writeReport (const char* fileName);
+
+private:
+
+	static void  remove ();
+	static void  debugReport ();
+	static void  writeReportFromDebugFlag ();
+
+private:
+
+	static bool ms_enabled;
+
+private:
+
+	TerrainGeneratorProfiler ();
+	TerrainGeneratorProfiler (const TerrainGeneratorProfiler&);
+	TerrainGeneratorProfiler& operator= (const TerrainGeneratorProfiler&);
+};
+
+//===================================================================
+
+inline bool TerrainGeneratorProfiler::isEnabled ()
+{
+	return ms_enabled;
+}
+
+//===================================================================
+
+#endif
@@ -18,6 +18,7 @@
 #include "sharedMath/Sphere.h"
 #include "sharedTerrain/ConfigSharedTerrain.h"
 #include "sharedTerrain/TerrainAppearance.h"
+#include "sharedTerrain/TerrainQueryService.h"
 
 #include <string>
 #include <vector>
@@ -160,6 +161,8 @@ TerrainObject::~TerrainObject ()
 	
 	DEBUG_FATAL (ms_instance != this, ("TerrainObject instance is not this object"));
 	ms_instance = NULL;
+
+	TerrainQueryService::clear ();
 }
 
 //-------------------------------------------------------------------
@@ -776,6 +779,7 @@ void TerrainObject::getPolygonSoup (const Rectangle2d& extent2d_w, IndexedTriang
 void TerrainObject::invalidateRegion (const Rectangle2d& extent2d)
 {
 	getCastedAppearance (this)->invalidateRegion (extent2d);
+	TerrainQueryService::invalidate (extent2d);
 }
 
 //-------------------------------------------------------------------
@@ -783,6 +787,7 @@ void TerrainObject::invalidateRegion (const Rectangle2d& extent2d)
 void TerrainObject::purgeChunks()
 {
 	getCastedAppearance(this)->purgeChunks();
+	TerrainQueryService::clear();
 }
 
 //----------------------------------------------------------------------
@@ -0,0 +1,832 @@
+//===================================================================
+//
+// TerrainQueryService.cpp
+//
+// copyright 2026
+//
+//===================================================================
+
+#include "sharedTerrain/FirstSharedTerrain.h"
+#include "sharedTerrain/TerrainQueryService.h"
+
+#include "sharedDebug/DebugFlags.h"
+#include "sharedDebug/PerformanceTimer.h"
+#include "sharedFoundation/ExitChain.h"
+#include "sharedFoundation/Os.h"
+#include "sharedMath/Rectangle2d.h"
+#include "sharedMath/Vector.h"
+#include "sharedRandom/FastRandomGenerator.h"
+#include "sharedTerrain/ConfigSharedTerrain.h"
+#include "sharedTerrain/ProceduralTerrainAppearance.h"
+#include "sharedTerrain/TerrainObject.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+//===================================================================
+
+namespace TerrainQueryServiceNamespace
+{
+	//-- level 0 has two samples per shader tile, so a chunk with 8 shader tiles decimates 16/8/4/2/1
+	int const   cms_maximumNumberOfLevelsOfDetail = 6;
+
+	//-- samples on the far chunk edges are nudged inside the chunk so they resolve to the chunk that owns the tile
+	float const cms_edgeEpsilon = 0.001f;
+
+	//-- the passable mask mirrors ProceduralTerrainAppearance::Chunk::m_passable
+	int const   cms_maximumNumberOfPassableTiles = 32;
+
+	int const   cms_benchmarkNumberOfQueries = 10000;
+	float const cms_benchmarkRadius = 128.f;
+
+	//----------------------------------------------------------------------
+
+	struct Level
+	{
+		int   samplesPerSide;
+		int   sampleOffset;
+		float sampleSpacing;
+	};
+
+	struct Tile
+	{
+		int    chunkX;
+		int    chunkZ;
+		float  minimumHeight;
+		float  heightScale;
+		uint32 passable;
+		int    lastUsed;
+
+		//-- filled partly from coarser level of detail chunks, refilled once the full resolution chunk is resident
+		bool   approximate;
+
+		//-- least recently used list, most recent first
+		int    previous;
+		int    next;
+	};
+
+	typedef std::map<uint32, int> TileMap;
+	typedef std::vector<Tile>     TileList;
+	typedef std::vector<uint16>   SampleList;
+	typedef std::vector<int>      FreeTileList;
+	typedef std::vector<float>    HeightList;
+
+	//----------------------------------------------------------------------
+
+	bool  ms_installed;
+	bool  ms_debugReport;
+	bool  ms_runBenchmark;
+
+	//-- layout of the terrain the cache is currently bound to
+	TerrainObject const * ms_terrainObject;
+	ProceduralTerrainAppearance const * ms_appearance;
+	float        ms_chunkWidthInMeters;
+	float        ms_halfMapWidthInMeters;
+	int          ms_numberOfTilesPerChunk;
+	float        ms_tileWidthInMeters;
+	int          ms_numberOfLevels;
+	Level        ms_levels [cms_maximumNumberOfLevelsOfDetail];
+	int          ms_samplesPerTile;
+
+	int          ms_maximumNumberOfTiles;
+	TileList     ms_tileList;
+	SampleList   ms_sampleList;
+	TileMap      ms_tileMap;
+	FreeTileList ms_freeTileList;
+	HeightList   ms_fillHeightList;
+	Tile *       ms_lastTile;
+	int          ms_useStamp;
+	int          ms_mostRecentTile = -1;
+	int          ms_leastRecentTile = -1;
+
+	//-- statistics since the last clear
+	int          ms_numberOfQueries;
+	int          ms_numberOfTileHits;
+	int          ms_numberOfTileFills;
+	int          ms_numberOfTileGenerations;
+	int          ms_numberOfTileEvictions;
+	int          ms_numberOfTileRefreshes;
+
+	//----------------------------------------------------------------------
+
+	inline uint32 makeKey (int const chunkX, int const chunkZ)
+	{
+		return (static_cast<uint32> (chunkX & 0xffff) << 16) | static_cast<uint32> (chunkZ & 0xffff);
+	}
+
+	//----------------------------------------------------------------------
+
+	inline int calculateChunkIndex (float const position)
+	{
+		//-- matches ProceduralTerrainAppearance::calculateChunkX/Z
+		int const chunkIndex = static_cast<int> ((position >= 0.f) ? floorf (position / ms_chunkWidthInMeters) : ceilf (position / ms_chunkWidthInMeters));
+
+		return (position < 0.f) ? chunkIndex - 1 : chunkIndex;
+	}
+
+	//----------------------------------------------------------------------
+
+	inline bool isWithinMap (Vector const & position_w)
+	{
+		return fabsf (position_w.x) <= ms_halfMapWidthInMeters && fabsf (position_w.z) <= ms_halfMapWidthInMeters;
+	}
+
+	//----------------------------------------------------------------------
+
+	inline float getSample (Tile const & tile, uint16 const * const samples, Level const & level, int const x, int const z)
+	{
+		return tile.minimumHeight + static_cast<float> (samples [level.sampleOffset + z * level.samplesPerSide + x]) * tile.heightScale;
+	}
+
+	//----------------------------------------------------------------------
+
+	void unlinkTile (int const index)
+	{
+		Tile & tile = ms_tileList [static_cast<size_t> (index)];
+
+		if (tile.previous >= 0)
+			ms_tileList [static_cast<size_t> (tile.previous)].next = tile.next;
+		else
+			ms_mostRecentTile = tile.next;
+
+		if (tile.next >= 0)
+			ms_tileList [static_cast<size_t> (tile.next)].previous = tile.previous;
+		else
+			ms_leastRecentTile = tile.previous;
+
+		tile.previous = -1;
+		tile.next = -1;
+	}
+
+	//----------------------------------------------------------------------
+
+	void linkTileAsMostRecent (int const index)
+	{
+		Tile & tile = ms_tileList [static_cast<size_t> (index)];
+
+		tile.previous = -1;
+		tile.next = ms_mostRecentTile;
+
+		if (ms_mostRecentTile >= 0)
+			ms_tileList [static_cast<size_t> (ms_mostRecentTile)].previous = index;
+		else
+			ms_leastRecentTile = index;
+
+		ms_mostRecentTile = index;
+	}
+
+	//----------------------------------------------------------------------
+
+	void releaseTiles ()
+	{
+		TileMap ().swap (ms_tileMap);
+		TileList ().swap (ms_tileList);
+		SampleList ().swap (ms_sampleList);
+		FreeTileList ().swap (ms_freeTileList);
+		HeightList ().swap (ms_fillHeightList);
+
+		ms_terrainObject = 0;
+		ms_appearance = 0;
+		ms_lastTile = 0;
+		ms_mostRecentTile = -1;
+		ms_leastRecentTile = -1;
+	}
+
+	//----------------------------------------------------------------------
+
+	bool bind ()
+	{
+		TerrainObject const * const terrainObject = TerrainObject::getConstInstance ();
+		if (terrainObject == ms_terrainObject)
+			return terrainObject != 0;
+
+		releaseTiles ();
+
+		if (!terrainObject)
+			return false;
+
+		//-- only procedural terrain has a height field to cache
+		ProceduralTerrainAppearance const * const appearance = dynamic_cast<ProceduralTerrainAppearance const *> (terrainObject->getAppearance ());
+		if (!appearance)
+			return false;
+
+		ms_chunkWidthInMeters    = terrainObject->getChunkWidthInMeters ();
+		ms_halfMapWidthInMeters  = terrainObject->getMapWidthInMeters () * 0.5f;
+		ms_numberOfTilesPerChunk = appearance->getNumberOfTilesPerChunk ();
+		ms_tileWidthInMeters     = ms_chunkWidthInMeters / static_cast<float> (ms_numberOfTilesPerChunk);
+
+		DEBUG_WARNING (ms_numberOfTilesPerChunk * ms_numberOfTilesPerChunk > cms_maximumNumberOfPassableTiles, ("TerrainQueryService: %i shader tiles per chunk exceeds the passable mask, passability is approximate", ms_numberOfTilesPerChunk * ms_numberOfTilesPerChunk));
+
+		//-- build the mip chain, halving the number of intervals while it divides evenly
+		int numberOfIntervals = ms_numberOfTilesPerChunk * 2;
+		ms_numberOfLevels = 0;
+		ms_samplesPerTile = 0;
+
+		while (ms_numberOfLevels < cms_maximumNumberOfLevelsOfDetail)
+		{
+			Level & level = ms_levels [ms_numberOfLevels++];
+			level.samplesPerSide = numberOfIntervals + 1;
+			level.sampleOffset   = ms_samplesPerTile;
+			level.sampleSpacing  = ms_chunkWidthInMeters / static_cast<float> (numberOfIntervals);
+
+			ms_samplesPerTile += level.samplesPerSide * level.samplesPerSide;
+
+			if (numberOfIntervals == 1 || (numberOfIntervals & 1) != 0)
+				break;
+
+			numberOfIntervals /= 2;
+		}
+
+		ms_tileList.resize (static_cast<size_t> (ms_maximumNumberOfTiles));
+		ms_sampleList.resize (static_cast<size_t> (ms_maximumNumberOfTiles * ms_samplesPerTile));
+		ms_fillHeightList.resize (static_cast<size_t> (ms_levels [0].samplesPerSide * ms_levels [0].samplesPerSide));
+
+		ms_freeTileList.reserve (static_cast<size_t> (ms_maximumNumberOfTiles));
+		for (int i = ms_maximumNumberOfTiles - 1; i >= 0; --i)
+			ms_freeTileList.push_back (i);
+
+		ms_terrainObject = terrainObject;
+		ms_appearance = appearance;
+
+		return true;
+	}
+
+	//----------------------------------------------------------------------
+
+	int allocateTile ()
+	{
+		if (!ms_freeTileList.empty ())
+		{
+			int const index = ms_freeTileList.back ();
+			ms_freeTileList.pop_back ();
+			return index;
+		}
+
+		//-- evict the least recently used tile
+		int const index = ms_leastRecentTile;
+		DEBUG_FATAL (index < 0, ("TerrainQueryService: no tile to evict"));
+
+		Tile const & victim = ms_tileList [static_cast<size_t> (index)];
+		IGNORE_RETURN (ms_tileMap.erase (makeKey (victim.chunkX, victim.chunkZ)));
+		unlinkTile (index);
+		++ms_numberOfTileEvictions;
+
+		if (ms_lastTile == &ms_tileList [static_cast<size_t> (index)])
+			ms_lastTile = 0;
+
+		return index;
+	}
+
+	//----------------------------------------------------------------------
+
+	bool fillTile (int const index, int const chunkX, int const chunkZ)
+	{
+		Tile & tile = ms_tileList [static_cast<size_t> (index)];
+		uint16 * const samples = &ms_sampleList [static_cast<size_t> (index * ms_samplesPerTile)];
+
+		Level const & level0 = ms_levels [0];
+		int const side = level0.samplesPerSide;
+
+		float const x0 = static_cast<float> (chunkX) * ms_chunkWidthInMeters;
+		float const z0 = static_cast<float> (chunkZ) * ms_chunkWidthInMeters;
+		float const x1 = x0 + ms_chunkWidthInMeters - cms_edgeEpsilon;
+		float const z1 = z0 + ms_chunkWidthInMeters - cms_edgeEpsilon;
+
+		//-- sample the full resolution chunk, fall back to a coarser resident chunk, and only force generation when neither exists
+		bool generated = false;
+		bool approximate = false;
+		float minimumHeight = FLT_MAX;
+		float maximumHeight = -FLT_MAX;
+
+		Vector position;
+		for (int z = 0; z < side; ++z)
+		{
+			position.z = std::min (z0 + static_cast<float> (z) * level0.sampleSpacing, z1);
+
+			for (int x = 0; x < side; ++x)
+			{
+				position.x = std::min (x0 + static_cast<float> (x) * level0.sampleSpacing, x1);
+
+				Vector const position_o = ms_terrainObject->rotateTranslate_w2o (position);
+
+				float height = 0.f;
+				if (!ms_appearance->getFinestChunkHeight (position_o, height))
+				{
+					if (ms_terrainObject->getHeight (position, height))
+						approximate = true;
+					else
+					{
+						generated = true;
+
+						if (!ms_terrainObject->getHeightForceChunkCreation (position, height))
+							return false;
+
+						//-- the client only answers forced queries from its renderable chunks
+						approximate = approximate || !ms_appearance->hasFinestChunk (position_o);
+					}
+				}
+
+				ms_fillHeightList [static_cast<size_t> (z * side + x)] = height;
+				minimumHeight = std::min (minimumHeight, height);
+				maximumHeight = std::max (maximumHeight, height);
+			}
+		}
+
+		//-- quantize to 16 bit offsets from the tile minimum; coarser levels are decimations of level 0
+		float const heightScale = (maximumHeight - minimumHeight) / 65535.f;
+		float const oneOverHeightScale = heightScale > 0.f ? 1.f / heightScale : 0.f;
+
+		for (int i = 0; i < ms_numberOfLevels; ++i)
+		{
+			Level const & level = ms_levels [i];
+			int const stride = 1 << i;
+
+			for (int z = 0; z < level.samplesPerSide; ++z)
+				for (int x = 0; x < level.samplesPerSide; ++x)
+				{
+					float const height = ms_fillHeightList [static_cast<size_t> (z * stride * side + x * stride)];
+					samples [level.sampleOffset + z * level.samplesPerSide + x] = static_cast<uint16> ((height - minimumHeight) * oneOverHeightScale + 0.5f);
+				}
+		}
+
+		//-- passability per shader tile, sampled at the tile centers
+		uint32 passable = 0xffffffff;
+		if (ms_terrainObject->hasPassableAffectors ())
+		{
+			passable = 0;
+
+			int const numberOfPassableTiles = std::min (ms_numberOfTilesPerChunk * ms_numberOfTilesPerChunk, cms_maximumNumberOfPassableTiles);
+			for (int tileIndex = 0; tileIndex < numberOfPassableTiles; ++tileIndex)
+			{
+				Vector const center (x0 + (static_cast<float> (tileIndex % ms_numberOfTilesPerChunk) + 0.5f) * ms_tileWidthInMeters, 0.f, z0 + (static_cast<float> (tileIndex / ms_numberOfTilesPerChunk) + 0.5f) * ms_tileWidthInMeters);
+				bool const isPassable = generated ? ms_terrainObject->isPassableForceChunkCreation (center) : ms_terrainObject->isPassable (center);
+				if (isPassable)
+					passable |= (1u << tileIndex);
+			}
+		}
+
+		tile.chunkX        = chunkX;
+		tile.chunkZ        = chunkZ;
+		tile.minimumHeight = minimumHeight;
+		tile.heightScale   = heightScale;
+		tile.passable      = passable;
+		tile.lastUsed      = ms_useStamp;
+		tile.approximate   = approximate;
+
+		++ms_numberOfTileFills;
+		if (generated)
+			++ms_numberOfTileGenerations;
+
+		return true;
+	}
+
+	//----------------------------------------------------------------------
+
+	Tile const * findTile (Vector const & position_w)
+	{
+		++ms_numberOfQueries;
+
+		if (!isWithinMap (position_w))
+			return 0;
+
+		int const chunkX = calculateChunkIndex (position_w.x);
+		int const chunkZ = calculateChunkIndex (position_w.z);
+
+		//-- batches are usually spatially coherent, and the last tile was already touched for this batch
+		if (ms_lastTile && ms_lastTile->lastUsed == ms_useStamp && ms_lastTile->chunkX == chunkX && ms_lastTile->chunkZ == chunkZ)
+		{
+			++ms_numberOfTileHits;
+			return ms_lastTile;
+		}
+
+		uint32 const key = makeKey (chunkX, chunkZ);
+		TileMap::iterator const iter = ms_tileMap.find (key);
+
+		int index;
+		if (iter != ms_tileMap.end ())
+		{
+			index = iter->second;
+			++ms_numberOfTileHits;
+
+			Tile & tile = ms_tileList [static_cast<size_t> (index)];
+			unlinkTile (index);
+
+			//-- check an approximate tile once per batch; a failed refill keeps the approximate heights
+			if (tile.approximate && tile.lastUsed != ms_useStamp)
+			{
+				Vector const center_w ((static_cast<float> (chunkX) + 0.5f) * ms_chunkWidthInMeters, 0.f, (static_cast<float> (chunkZ) + 0.5f) * ms_chunkWidthInMeters);
+				if (ms_appearance->hasFinestChunk (ms_terrainObject->rotateTranslate_w2o (center_w)) && fillTile (index, chunkX, chunkZ))
+					++ms_numberOfTileRefreshes;
+			}
+		}
+		else
+		{
+			index = allocateTile ();
+			if (!fillTile (index, chunkX, chunkZ))
+			{
+				ms_freeTileList.push_back (index);
+				return 0;
+			}
+
+			IGNORE_RETURN (ms_tileMap.insert (std::make_pair (key, index)));
+		}
+
+		linkTileAsMostRecent (index);
+
+		Tile & tile = ms_tileList [static_cast<size_t> (index)];
+		tile.lastUsed = ms_useStamp;
+		ms_lastTile = &tile;
+
+		return &tile;
+	}
+
+	//----------------------------------------------------------------------
+
+	float evaluate (Tile const & tile, int const levelOfDetail, Vector const & position_w, Vector * const normal)
+	{
+		Level const & level = ms_levels [levelOfDetail];
+		uint16 const * const samples = &ms_sampleList [static_cast<size_t> ((&tile - &ms_tileList [0]) * ms_samplesPerTile)];
+
+		float const localX = (position_w.x - static_cast<float> (tile.chunkX) * ms_chunkWidthInMeters) / level.sampleSpacing;
+		float const localZ = (position_w.z - static_cast<float> (tile.chunkZ) * ms_chunkWidthInMeters) / level.sampleSpacing;
+
+		int const numberOfCells = level.samplesPerSide - 1;
+		int const x = clamp (0, static_cast<int> (floorf (localX)), numberOfCells - 1);
+		int const z = clamp (0, static_cast<int> (floorf (localZ)), numberOfCells - 1);
+		float const fx = clamp (0.f, localX - static_cast<float> (x), 1.f);
+		float const fz = clamp (0.f, localZ - static_cast<float> (z), 1.f);
+
+		float const h00 = getSample (tile, samples, level, x,     z);
+		float const h10 = getSample (tile, samples, level, x + 1, z);
+		float const h01 = getSample (tile, samples, level, x,     z + 1);
+		float const h11 = getSample (tile, samples, level, x + 1, z + 1);
+
+		float height;
+		float dhdx;
+		float dhdz;
+
+		if (levelOfDetail == 0)
+		{
+			//-- match the tile fan: every cell is split along the diagonal that touches the shader tile center,
+			//-- which runs (x,z)-(x+1,z+1) when x+z is even and (x+1,z)-(x,z+1) when it is odd
+			if (((x + z) & 1) == 0)
+			{
+				if (fx >= fz)
+				{
+					dhdx = h10 - h00;
+					dhdz = h11 - h10;
+				}
+				else
+				{
+					dhdx = h11 - h01;
+					dhdz = h01 - h00;
+				}
+
+				height = h00 + dhdx * fx + dhdz * fz;
+			}
+			else
+			{
+				if (fx + fz <= 1.f)
+				{
+					dhdx = h10 - h00;
+					dhdz = h01 - h00;
+					height = h00 + dhdx * fx + dhdz * fz;
+				}
+				else
+				{
+					dhdx = h11 - h01;
+					dhdz = h11 - h10;
+					height = h11 - dhdx * (1.f - fx) - dhdz * (1.f - fz);
+				}
+			}
+		}
+		else
+		{
+			float const h0 = linearInterpolate (h00, h10, fx);
+			float const h1 = linearInterpolate (h01, h11, fx);
+			height = linearInterpolate (h0, h1, fz);
+
+			dhdx = linearInterpolate (h10 - h00, h11 - h01, fz);
+			dhdz = linearInterpolate (h01 - h00, h11 - h10, fx);
+		}
+
+		if (normal)
+		{
+			*normal = Vector (-dhdx / level.sampleSpacing, 1.f, -dhdz / level.sampleSpacing);
+			IGNORE_RETURN (normal->normalize ());
+		}
+
+		return height;
+	}
+
+	//----------------------------------------------------------------------
+
+	int query (Vector const * const positions_w, int const numberOfPositions, float * const heights, Vector * const normals, bool * const results, int const levelOfDetail)
+	{
+		NOT_NULL (positions_w);
+		DEBUG_FATAL (numberOfPositions < 0, ("TerrainQueryService: negative number of positions"));
+		DEBUG_FATAL (!Os::isMainThread (), ("TerrainQueryService: queried from a thread other than the main thread"));
+
+		if (!bind ())
+		{
+			if (results)
+				std::fill (results, results + numberOfPositions, false);
+
+			return 0;
+		}
+
+		++ms_useStamp;
+
+		int const level = clamp (0, levelOfDetail, ms_numberOfLevels - 1);
+		int numberOfResults = 0;
+
+		for (int i = 0; i < numberOfPositions; ++i)
+		{
+			Tile const * const tile = findTile (positions_w [i]);
+			if (tile)
+			{
+				float const height = evaluate (*tile, level, positions_w [i], normals ? normals + i : 0);
+				if (heights)
+					heights [i] = height;
+
+				++numberOfResults;
+			}
+
+			if (results)
+				results [i] = tile != 0;
+		}
+
+		return numberOfResults;
+	}
+}
+
+using namespace TerrainQueryServiceNamespace;
+
+//===================================================================
+// STATIC PUBLIC TerrainQueryService
+//===================================================================
+
+void TerrainQueryService::install ()
+{
+	DEBUG_FATAL (ms_installed, ("TerrainQueryService::install already installed"));
+	ms_installed = true;
+
+	ms_maximumNumberOfTiles = std::max (1, ConfigSharedTerrain::getQueryServiceMaximumNumberOfTiles ());
+
+	DebugFlags::registerFlag (ms_debugReport, "SharedTerrain/TerrainQueryService", "debugReport", debugReport);
+	DebugFlags::registerFlag (ms_runBenchmark, "SharedTerrain/TerrainQueryService", "runBenchmark", runBenchmarkFromDebugFlag);
+
+	TerrainObject::addTerrainChangedFunction (invalidate);
+
+	ExitChain::add (remove, "TerrainQueryService::remove");
+}
+
+//-------------------------------------------------------------------
+
+int TerrainQueryService::getHeight (Vector const * const positions_w, int const numberOfPositions, float * const heights, bool * const results, int const levelOfDetail)
+{
+	NOT_NULL (heights);
+	return query (positions_w, numberOfPositions, heights, 0, results, levelOfDetail);
+}
+
+//-------------------------------------------------------------------
+
+int TerrainQueryService::getNormal (Vector const * const positions_w, int const numberOfPositions, Vector * const normals, float * const heights, bool * const results, int const levelOfDetail)
+{
+	NOT_NULL (normals);
+	return query (positions_w, numberOfPositions, heights, normals, results, levelOfDetail);
+}
+
+//-------------------------------------------------------------------
+
+int TerrainQueryService::isPassable (Vector const * const positions_w, int const numberOfPositions, bool * const passable)
+{
+	NOT_NULL (positions_w);
+	NOT_NULL (passable);
+	DEBUG_FATAL (!Os::isMainThread (), ("TerrainQueryService: queried from a thread other than the main thread"));
+
+	if (!bind ())
+	{
+		std::fill (passable, passable + numberOfPositions, false);
+		return 0;
+	}
+
+	++ms_useStamp;
+
+	int numberOfResults = 0;
+
+	for (int i = 0; i < numberOfPositions; ++i)
+	{
+		Vector const & position_w = positions_w [i];
+		Tile const * const tile = findTile (position_w);
+
+		if (!tile)
+		{
+			passable [i] = false;
+			continue;
+		}
+
+		int const tileX = clamp (0, static_cast<int> ((position_w.x - static_cast<float> (tile->chunkX) * ms_chunkWidthInMeters) / ms_tileWidthInMeters), ms_numberOfTilesPerChunk - 1);
+		int const tileZ = clamp (0, static_cast<int> ((position_w.z - static_cast<float> (tile->chunkZ) * ms_chunkWidthInMeters) / ms_tileWidthInMeters), ms_numberOfTilesPerChunk - 1);
+		int const tileIndex = tileZ * ms_numberOfTilesPerChunk + tileX;
+
+		passable [i] = tileIndex >= cms_maximumNumberOfPassableTiles || (tile->passable & (1u << tileIndex)) != 0;
+		++numberOfResults;
+	}
+
+	return numberOfResults;
+}
+
+//-------------------------------------------------------------------
+
+void TerrainQueryService::invalidate (Rectangle2d const & extent2d_w)
+{
+	DEBUG_FATAL (!Os::isMainThread (), ("TerrainQueryService: invalidated from a thread other than the main thread"));
+
+	if (!ms_terrainObject || ms_tileMap.empty ())
+		return;
+
+	int const chunkX0 = calculateChunkIndex (std::min (extent2d_w.x0, extent2d_w.x1));
+	int const chunkX1 = calculateChunkIndex (std::max (extent2d_w.x0, extent2d_w.x1));
+	int const chunkZ0 = calculateChunkIndex (std::min (extent2d_w.y0, extent2d_w.y1));
+	int const chunkZ1 = calculateChunkIndex (std::max (extent2d_w.y0, extent2d_w.y1));
+
+	TileMap::iterator iter = ms_tileMap.begin ();
+	while (iter != ms_tileMap.end ())
+	{
+		Tile const & tile = ms_tileList [static_cast<size_t> (iter->second)];
+
+		if (tile.chunkX >= chunkX0 && tile.chunkX <= chunkX1 && tile.chunkZ >= chunkZ0 && tile.chunkZ <= chunkZ1)
+		{
+			if (ms_lastTile == &tile)
+				ms_lastTile = 0;
+
+			unlinkTile (iter->second);
+			ms_freeTileList.push_back (iter->second);
+			ms_tileMap.erase (iter++);
+		}
+		else
+			++iter;
+	}
+}
+
+//-------------------------------------------------------------------
+
+void TerrainQueryService::clear ()
+{
+	releaseTiles ();
+
+	ms_numberOfQueries = 0;
+	ms_numberOfTileHits = 0;
+	ms_numberOfTileFills = 0;
+	ms_numberOfTileGenerations = 0;
+	ms_numberOfTileEvictions = 0;
+	ms_numberOfTileRefreshes = 0;
+}
+
+//-------------------------------------------------------------------
+
+int TerrainQueryService::getMaximumNumberOfTiles ()
+{
+	return ms_maximumNumberOfTiles;
+}
+
+//-------------------------------------------------------------------
+
+void TerrainQueryService::setMaximumNumberOfTiles (int const maximumNumberOfTiles)
+{
+	ms_maximumNumberOfTiles = std::max (1, maximumNumberOfTiles);
+
+	//-- the pool is resized the next time a query binds to the terrain
+	clear ();
+}
+
+//-------------------------------------------------------------------
+
+int TerrainQueryService::getNumberOfTiles ()
+{
+	return static_cast<int> (ms_tileMap.size ());
+}
+
+//-------------------------------------------------------------------
+
+int TerrainQueryService::getNumberOfLevelsOfDetail ()
+{
+	return ms_terrainObject ? ms_numberOfLevels : 0;
+}
+
+//-------------------------------------------------------------------
+
+int TerrainQueryService::getTileMemorySize ()
+{
+	return static_cast<int> (ms_tileList.size () * sizeof (Tile) + ms_sampleList.size () * sizeof (uint16));
+}
+
+//-------------------------------------------------------------------
+
+void TerrainQueryService::runBenchmark (int const numberOfQueries, float const radius)
+{
+	TerrainObject const * const terrainObject = TerrainObject::getConstInstance ();
+	if (!terrainObject || numberOfQueries <= 0)
+		return;
+
+	//-- fixed seed so cold and warm runs, and runs on different builds, query the same points
+	FastRandomGenerator randomGenerator (12345);
+
+	std::vector<Vector> positions (static_cast<size_t> (numberOfQueries));
+	for (size_t i = 0; i < positions.size (); ++i)
+		positions [i] = Vector (randomGenerator.randomFloat (-radius, radius), 0.f, randomGenerator.randomFloat (-radius, radius));
+
+	std::vector<float> heights (positions.size ());
+	std::vector<Vector> normals (positions.size ());
+	bool * const results = new bool [positions.size ()];
+
+	PerformanceTimer timer;
+
+	//-- per point through TerrainObject, as callers do today
+	timer.start ();
+	int legacyResults = 0;
+	for (size_t i = 0; i < positions.size (); ++i)
+		if (terrainObject->getHeight (positions [i], heights [i]))
+			++legacyResults;
+	timer.stop ();
+	float const legacyTime = timer.getElapsedTime ();
+
+	clear ();
+
+	timer.start ();
+	int const coldResults = getHeight (&positions [0], numberOfQueries, &heights [0], results);
+	timer.stop ();
+	float const coldTime = timer.getElapsedTime ();
+	int const coldFills = ms_numberOfTileFills;
+	int const coldGenerations = ms_numberOfTileGenerations;
+
+	timer.start ();
+	int const warmResults = getHeight (&positions [0], numberOfQueries, &heights [0], results);
+	timer.stop ();
+	float const warmTime = timer.getElapsedTime ();
+
+	timer.start ();
+	IGNORE_RETURN (getNormal (&positions [0], numberOfQueries, &normals [0], &heights [0], results));
+	timer.stop ();
+	float const warmNormalTime = timer.getElapsedTime ();
+
+	timer.start ();
+	IGNORE_RETURN (isPassable (&positions [0], numberOfQueries, results));
+	timer.stop ();
+	float const warmPassableTime = timer.getElapsedTime ();
+
+	delete [] results;
+
+	REPORT_LOG (true, ("TerrainQueryService benchmark: %i queries within %1.0fm\n", numberOfQueries, radius));
+	REPORT_LOG (true, ("  legacy getHeight       %8.3f ms  %9.0f queries/s  (%i valid)\n", legacyTime * 1000.f, legacyTime > 0.f ? numberOfQueries / legacyTime : 0.f, legacyResults));
+	REPORT_LOG (true, ("  cold cache getHeight   %8.3f ms  %9.0f queries/s  (%i valid, %i tiles filled, %i generated)\n", coldTime * 1000.f, coldTime > 0.f ? numberOfQueries / coldTime : 0.f, coldResults, coldFills, coldGenerations));
+	REPORT_LOG (true, ("  warm cache getHeight   %8.3f ms  %9.0f queries/s  (%i valid)\n", warmTime * 1000.f, warmTime > 0.f ? numberOfQueries / warmTime : 0.f, warmResults));
+	REPORT_LOG (true, ("  warm cache getNormal   %8.3f ms  %9.0f queries/s\n", warmNormalTime * 1000.f, warmNormalTime > 0.f ? numberOfQueries / warmNormalTime : 0.f));
+	REPORT_LOG (true, ("  warm cache isPassable  %8.3f ms  %9.0f queries/s\n", warmPassableTime * 1000.f, warmPassableTime > 0.f ? numberOfQueries / warmPassableTime : 0.f));
+	REPORT_LOG (true, ("  %i tiles resident, %i bytes\n", getNumberOfTiles (), getTileMemorySize ()));
+}
+
+//===================================================================
+// STATIC PRIVATE TerrainQueryService
+//===================================================================
+
+void TerrainQueryService::remove ()
+{
+	DEBUG_FATAL (!ms_installed, ("TerrainQueryService::remove not installed"));
+	ms_installed = false;
+
+	DebugFlags::unregisterFlag (ms_debugReport);
+	DebugFlags::unregisterFlag (ms_runBenchmark);
+
+	clear ();
+}
+
+//-------------------------------------------------------------------
+
+void TerrainQueryService::debugReport ()
+{
+	DEBUG_REPORT_PRINT (true, ("-- TerrainQueryService\n"));
+	DEBUG_REPORT_PRINT (true, ("           tiles = %i/%i\n", getNumberOfTiles (), ms_maximumNumberOfTiles));
+	DEBUG_REPORT_PRINT (true, ("     tile memory = %i\n", getTileMemorySize ()));
+	DEBUG_REPORT_PRINT (true, ("levels of detail = %i\n", getNumberOfLevelsOfDetail ()));
+	DEBUG_REPORT_PRINT (true, ("         queries = %i\n", ms_numberOfQueries));
+	DEBUG_REPORT_PRINT (true, ("       tile hits = %i\n", ms_numberOfTileHits));
+	DEBUG_REPORT_PRINT (true, ("      tile fills = %i\n", ms_numberOfTileFills));
+	DEBUG_REPORT_PRINT (true, (" tile generation = %i\n", ms_numberOfTileGenerations));
+	DEBUG_REPORT_PRINT (true, ("  tile evictions = %i\n", ms_numberOfTileEvictions));
+	DEBUG_REPORT_PRINT (true, ("  tile refreshes = %i\n", ms_numberOfTileRefreshes));
+}
+
+//-------------------------------------------------------------------
+
+void TerrainQueryService::runBenchmarkFromDebugFlag ()
+{
+	//-- one shot
+	ms_runBenchmark = false;
+
+	runBenchmark (cms_benchmarkNumberOfQueries, cms_benchmarkRadius);
+}
+
+//===================================================================
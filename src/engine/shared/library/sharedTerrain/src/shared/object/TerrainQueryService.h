@@ -0,0 +1,84 @@
+//===================================================================
+//
+// TerrainQueryService.h
+//
+// copyright 2026
+//
+//===================================================================
+
+#ifndef INCLUDED_TerrainQueryService_H
+#define INCLUDED_TerrainQueryService_H
+
+//===================================================================
+
+class Rectangle2d;
+class Vector;
+
+//-------------------------------------------------------------------
+//
+// TerrainQueryService answers batched height, normal and passability
+// queries from a compact tile cache instead of asking the terrain
+// appearance one point at a time.
+//
+// Each tile covers exactly one terrain chunk. Heights are sampled once
+// at the chunk's pole spacing (two samples per shader tile) and stored
+// as 16-bit offsets from the tile minimum, followed by a chain of
+// decimated mip levels for coarse queries (flora, AI, far camera).
+// Level 0 is interpolated using the same triangle fan split as the
+// terrain mesh; coarser levels are interpolated bilinearly.
+//
+// Passability is stored as one bit per shader tile, using the same
+// layout as ProceduralTerrainAppearance::Chunk.
+//
+// Tiles are filled from the resident full resolution chunks. Where only
+// a coarser level of detail chunk is resident (the client) the tile is
+// filled from it and marked approximate, and it is refilled the first
+// time a batch touches it after the full resolution chunk is resident.
+// Chunk generation is only forced for tiles with no resident chunk.
+// The cache is bounded and evicts the least recently used tile, and it
+// is invalidated through TerrainObject::terrainChanged and
+// TerrainObject::invalidateRegion.
+//
+// The service is not locked and must only be used from the main thread.
+//
+// All batch functions return the number of positions that produced a
+// valid result. Positions outside the map produce an invalid result.
+//
+
+class TerrainQueryService
+{
+public:
+
+	static void install ();
+
+	static int  getHeight (Vector const * positions_w, int numberOfPositions, float * heights, bool * results, int levelOfDetail = 0);
+	static int  getNormal (Vector const * positions_w, int numberOfPositions, Vector * normals, float * heights, bool * results, int levelOfDetail = 0);
+	static int  isPassable (Vector const * positions_w, int numberOfPositions, bool * passable);
+
+	static void invalidate (Rectangle2d const & extent2d_w);
+	static void clear ();
+
+	static int  getMaximumNumberOfTiles ();
+	static void setMaximumNumberOfTiles (int maximumNumberOfTiles);
+	static int  getNumberOfTiles ();
+	static int  getNumberOfLevelsOfDetail ();
+	static int  getTileMemorySize ();
+
+	static void runBenchmark (int numberOfQueries, float radius);
+
+private:
+
+	static void remove ();
+	static void debugReport ();
+	static void runBenchmarkFromDebugFlag ();
+
+private:
+
+	TerrainQueryService ();
+	TerrainQueryService (TerrainQueryService const &);
+	TerrainQueryService & operator= (TerrainQueryService const &);
+};
+
+//===================================================================
+
+#endif
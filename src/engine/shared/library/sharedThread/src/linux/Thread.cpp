@@ -10,6 +10,7 @@
 #include "sharedFoundation/FirstSharedFoundation.h"
 #include "sharedThread/Thread.h"
 
+#include "sharedDebug/ProfilerTimeline.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedFoundation/Os.h"
 #include "sharedFoundation/PerThreadData.h"
@@ -79,6 +80,7 @@ void * Thread::threadFunc(void * i)
 	pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, 0);
 	Os::setThreadName(impl->thread, impl->name.c_str());
 	PerThreadData::threadInstall(true);
+	ProfilerTimeline::setThreadName(impl->name.c_str());
 	impl->run();
 	PerThreadData::threadRemove();
 	impl->kill();
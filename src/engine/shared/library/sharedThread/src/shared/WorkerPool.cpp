@@ -0,0 +1,169 @@
+// ======================================================================
+//
+// WorkerPool.cpp
+//
+// copyright 2026
+//
+// ======================================================================
+
+#include "sharedThread/FirstSharedThread.h"
+#include "sharedThread/WorkerPool.h"
+
+#include <stdio.h>
+
+// ======================================================================
+
+WorkerPool::WorkerPool(char const *const name, int const numberOfThreads) :
+	m_name(name ? name : "WorkerPool"),
+	m_numberOfThreads(numberOfThreads > 0 ? numberOfThreads : 0),
+	m_threads(0),
+	m_mutex(),
+	m_startGate(false),
+	m_finishedGate(true),
+	m_quit(false),
+	m_generation(0),
+	m_jobFunction(0),
+	m_context(0),
+	m_numberOfJobs(0),
+	m_nextJob(0),
+	m_numberOfFinishedJobs(0)
+{
+	if (m_numberOfThreads > 0)
+	{
+		m_threads = new ThreadHandle[static_cast<size_t>(m_numberOfThreads)];
+
+		for (int i = 0; i < m_numberOfThreads; ++i)
+		{
+			char threadName[64];
+			IGNORE_RETURN(snprintf(threadName, sizeof(threadName), "%s%d", m_name.c_str(), i));
+			threadName[sizeof(threadName) - 1] = '\0';
+
+			MemberFunctionThreadZero<WorkerPool> *const memberFunction = new MemberFunctionThreadZero<WorkerPool>(threadName, *this, &WorkerPool::threadRoutine);
+			m_threads[i] = ThreadHandle(memberFunction);
+			m_threads[i]->setPriority(Thread::kNormal);
+		}  //lint !e429  //-- memberFunction is owned by the thread handle
+	}
+}
+
+// ----------------------------------------------------------------------
+
+WorkerPool::~WorkerPool()
+{
+	if (m_threads)
+	{
+		m_mutex.enter();
+			m_quit = true;
+			m_startGate.open();
+		m_mutex.leave();
+
+		for (int i = 0; i < m_numberOfThreads; ++i)
+			m_threads[i]->wait();
+
+		delete [] m_threads;
+		m_threads = 0;
+	}
+
+	m_jobFunction = 0;
+	m_context = 0;
+}
+
+// ----------------------------------------------------------------------
+/**
+ * Run jobFunction(context, i) for every i in [0, numberOfJobs).
+ *
+ * The calling thread runs jobs too, and the call does not return until
+ * all of them have finished.  Must not be called from a job.
+ */
+
+void WorkerPool::run(JobFunction const jobFunction, void *const context, int const numberOfJobs)
+{
+	NOT_NULL(jobFunction);
+
+	if (numberOfJobs <= 0)
+		return;
+
+	if (!m_threads || numberOfJobs == 1)
+	{
+		for (int i = 0; i < numberOfJobs; ++i)
+			(*jobFunction)(context, i);
+
+		return;
+	}
+
+	m_mutex.enter();
+
+		++m_generation;
+		m_jobFunction          = jobFunction;
+		m_context              = context;
+		m_numberOfJobs         = numberOfJobs;
+		m_nextJob              = 0;
+		m_numberOfFinishedJobs = 0;
+
+		int const generation = m_generation;
+
+		m_finishedGate.close();
+		m_startGate.open();
+
+	m_mutex.leave();
+
+	runJobs(generation);
+
+	m_finishedGate.wait();
+}
+
+// ======================================================================
+
+void WorkerPool::threadRoutine()
+{
+	for (;;)
+	{
+		m_startGate.wait();
+
+		m_mutex.enter();
+			bool const quit       = m_quit;
+			int const  generation = m_generation;
+		m_mutex.leave();
+
+		if (quit)
+			return;
+
+		runJobs(generation);
+	}
+}
+
+// ----------------------------------------------------------------------
+
+void WorkerPool::runJobs(int const generation)
+{
+	for (;;)
+	{
+		m_mutex.enter();
+
+			//-- once every job of this batch has been handed out, close the start gate so idle workers go back to sleep.
+			if (m_generation != generation || m_nextJob >= m_numberOfJobs)
+			{
+				if (m_generation == generation && !m_quit)
+					m_startGate.close();
+
+				m_mutex.leave();
+				return;
+			}
+
+			int const         jobIndex    = m_nextJob++;
+			JobFunction const jobFunction = m_jobFunction;
+			void *const       context     = m_context;
+
+		m_mutex.leave();
+
+		(*jobFunction)(context, jobIndex);
+
+		m_mutex.enter();
+
+			if (++m_numberOfFinishedJobs == m_numberOfJobs)
+				m_finishedGate.open();
+
+		m_mutex.leave();
+	}
+}
+
+// ======================================================================
@@ -0,0 +1,88 @@
+// ======================================================================
+//
+// WorkerPool.h
+//
+// copyright 2026
+//
+// ======================================================================
+
+#ifndef INCLUDED_WorkerPool_H
+#define INCLUDED_WorkerPool_H
+
+// ======================================================================
+
+#include "sharedSynchronization/Gate.h"
+#include "sharedSynchronization/Mutex.h"
+#include "sharedThread/RunThread.h"
+
+#include <string>
+
+// ======================================================================
+// A fixed set of worker threads that run batches of independent jobs.
+//
+// run() hands out the job indices [0, numberOfJobs) to the workers and
+// the calling thread, and returns once every job has completed.  Jobs
+// must not touch state shared with other jobs without their own locking.
+//
+// A pool with no worker threads runs every job on the calling thread.
+
+class WorkerPool
+{
+public:
+
+	typedef void (*JobFunction)(void *context, int jobIndex);
+
+public:
+
+	WorkerPool(char const *name, int numberOfThreads);
+	~WorkerPool();
+
+	int  getNumberOfThreads() const;
+
+	void run(JobFunction jobFunction, void *context, int numberOfJobs);
+
+private:
+
+	typedef MemberFunctionThreadZero<WorkerPool>::Handle ThreadHandle;
+
+private:
+
+	void threadRoutine();
+	void runJobs(int generation);
+
+private:
+
+	// disabled
+	WorkerPool();
+	WorkerPool(WorkerPool const &);
+	WorkerPool &operator =(WorkerPool const &);
+
+private:
+
+	std::string   m_name;
+	int           m_numberOfThreads;
+	ThreadHandle *m_threads;
+
+	Mutex         m_mutex;
+	Gate          m_startGate;
+	Gate          m_finishedGate;
+
+	bool          m_quit;
+	int           m_generation;
+	JobFunction   m_jobFunction;
+	void         *m_context;
+	int           m_numberOfJobs;
+	int           m_nextJob;
+	int           m_numberOfFinishedJobs;
+};
+
+// ======================================================================
+
+inline int WorkerPool::getNumberOfThreads() const
+{
+	return m_numberOfThreads;
+}
+
+// ======================================================================
+
+#endif
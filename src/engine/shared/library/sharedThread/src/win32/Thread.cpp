@@ -10,6 +10,7 @@
 #include "sharedThread/FirstSharedThread.h"
 #include "sharedThread/Thread.h"
 
+#include "sharedDebug/ProfilerTimeline.h"
 #include "sharedFoundation/ExitChain.h"
 #include "sharedSynchronization/Mutex.h"
 #include "sharedSynchronization/RecursiveMutex.h"
@@ -98,6 +99,7 @@ unsigned int Thread::threadFunc(void * i)
 	TlsSetValue(implindex, impl);
 	Os::setThreadName(impl->id, impl->name->c_str());
 	PerThreadData::threadInstall(true);
+	ProfilerTimeline::setThreadName(impl->name->c_str());
 	impl->run();
 	PerThreadData::threadRemove();
 	impl->kill();
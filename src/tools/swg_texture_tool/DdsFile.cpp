@@ -0,0 +1,208 @@
+#include "DdsFile.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x20534444; // "DDS "
+
+constexpr std::uint32_t DDSD_CAPS = 0x1;
+constexpr std::uint32_t DDSD_HEIGHT = 0x2;
+constexpr std::uint32_t DDSD_WIDTH = 0x4;
+constexpr std::uint32_t DDSD_PITCH = 0x8;
+constexpr std::uint32_t DDSD_PIXELFORMAT = 0x1000;
+constexpr std::uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+constexpr std::uint32_t DDSD_LINEARSIZE = 0x80000;
+
+constexpr std::uint32_t DDPF_ALPHAPIXELS = 0x1;
+constexpr std::uint32_t DDPF_ALPHA = 0x2;
+constexpr std::uint32_t DDPF_FOURCC = 0x4;
+constexpr std::uint32_t DDPF_RGB = 0x40;
+constexpr std::uint32_t DDPF_LUMINANCE = 0x20000;
+
+constexpr std::uint32_t DDSCAPS_COMPLEX = 0x8;
+constexpr std::uint32_t DDSCAPS_TEXTURE = 0x1000;
+constexpr std::uint32_t DDSCAPS_MIPMAP = 0x400000;
+
+constexpr std::uint32_t DDSCAPS2_CUBEMAP = 0x200;
+constexpr std::uint32_t DDSCAPS2_VOLUME = 0x200000;
+
+constexpr std::uint32_t fourcc(char a, char b, char c, char d) {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(a)) | (static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8) |
+           (static_cast<std::uint32_t>(static_cast<unsigned char>(c)) << 16) | (static_cast<std::uint32_t>(static_cast<unsigned char>(d)) << 24);
+}
+
+struct PixelFormatEntry {
+    TextureFormat format;
+    std::uint32_t flags;
+    std::uint32_t four_cc;
+    std::uint32_t bit_count;
+    std::uint32_t red_mask;
+    std::uint32_t green_mask;
+    std::uint32_t blue_mask;
+    std::uint32_t alpha_mask;
+};
+
+const std::array<PixelFormatEntry, 12> kPixelFormats = {{
+    {TextureFormat::argb_8888, DDPF_RGB | DDPF_ALPHAPIXELS, 0, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000},
+    {TextureFormat::xrgb_8888, DDPF_RGB, 0, 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0},
+    {TextureFormat::rgb_888, DDPF_RGB, 0, 24, 0x00ff0000, 0x0000ff00, 0x000000ff, 0},
+    {TextureFormat::argb_4444, DDPF_RGB | DDPF_ALPHAPIXELS, 0, 16, 0x0f00, 0x00f0, 0x000f, 0xf000},
+    {TextureFormat::argb_1555, DDPF_RGB | DDPF_ALPHAPIXELS, 0, 16, 0x7c00, 0x03e0, 0x001f, 0x8000},
+    {TextureFormat::rgb_555, DDPF_RGB, 0, 16, 0x7c00, 0x03e0, 0x001f, 0},
+    {TextureFormat::rgb_565, DDPF_RGB, 0, 16, 0xf800, 0x07e0, 0x001f, 0},
+    {TextureFormat::a_8, DDPF_ALPHA, 0, 8, 0, 0, 0, 0xff},
+    {TextureFormat::l_8, DDPF_LUMINANCE, 0, 8, 0xff, 0, 0, 0},
+    {TextureFormat::dxt1, DDPF_FOURCC, fourcc('D', 'X', 'T', '1'), 0, 0, 0, 0, 0},
+    {TextureFormat::dxt3, DDPF_FOURCC, fourcc('D', 'X', 'T', '3'), 0, 0, 0, 0, 0},
+    {TextureFormat::dxt5, DDPF_FOURCC, fourcc('D', 'X', 'T', '5'), 0, 0, 0, 0, 0},
+}};
+
+// header fields by 32-bit index after the magic word
+enum HeaderField {
+    kSize = 0,
+    kFlags = 1,
+    kHeight = 2,
+    kWidth = 3,
+    kPitchOrLinearSize = 4,
+    kMipMapCount = 6,
+    kPixelFormatSize = 18,
+    kPixelFormatFlags = 19,
+    kFourCC = 20,
+    kBitCount = 21,
+    kRedMask = 22,
+    kGreenMask = 23,
+    kBlueMask = 24,
+    kAlphaMask = 25,
+    kCaps = 26,
+    kCaps2 = 27,
+    kHeaderWords = 31,
+};
+
+TextureFormat identify(const std::array<std::uint32_t, kHeaderWords> &header) {
+    const std::uint32_t flags = header[kPixelFormatFlags];
+    if (flags & DDPF_FOURCC) {
+        const std::uint32_t code = header[kFourCC];
+        if (code == fourcc('D', 'X', 'T', '1')) {
+            return TextureFormat::dxt1;
+        }
+        if (code == fourcc('D', 'X', 'T', '2') || code == fourcc('D', 'X', 'T', '3')) {
+            return TextureFormat::dxt3;
+        }
+        if (code == fourcc('D', 'X', 'T', '4') || code == fourcc('D', 'X', 'T', '5')) {
+            return TextureFormat::dxt5;
+        }
+        throw TextureToolError("Unsupported DDS FourCC");
+    }
+    for (const PixelFormatEntry &entry : kPixelFormats) {
+        if (entry.four_cc != 0 || entry.bit_count != header[kBitCount]) {
+            continue;
+        }
+        const bool entry_alpha = (entry.flags & DDPF_ALPHAPIXELS) != 0;
+        const bool file_alpha = (flags & DDPF_ALPHAPIXELS) != 0;
+        if ((entry.flags & ~DDPF_ALPHAPIXELS) != (flags & ~DDPF_ALPHAPIXELS) || entry_alpha != file_alpha) {
+            continue;
+        }
+        if (entry.red_mask == header[kRedMask] && entry.green_mask == header[kGreenMask] && entry.blue_mask == header[kBlueMask] &&
+            (!entry_alpha || entry.alpha_mask == header[kAlphaMask]) && (!(flags & DDPF_ALPHA) || entry.alpha_mask == header[kAlphaMask])) {
+            return entry.format;
+        }
+    }
+    throw TextureToolError("Unsupported DDS pixel format");
+}
+
+} // namespace
+
+std::vector<TextureImage> read_dds(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw TextureToolError("Unable to open DDS file: " + path.string());
+    }
+
+    std::uint32_t magic = 0;
+    std::array<std::uint32_t, kHeaderWords> header{};
+    in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    in.read(reinterpret_cast<char *>(header.data()), static_cast<std::streamsize>(header.size() * sizeof(std::uint32_t)));
+    if (!in || magic != kMagic || header[kSize] != 124 || header[kPixelFormatSize] != 32) {
+        throw TextureToolError("Not a DDS file: " + path.string());
+    }
+    if (header[kCaps2] & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)) {
+        throw TextureToolError("Cube map and volume DDS files are not supported: " + path.string());
+    }
+
+    const TextureFormat format = identify(header);
+    int width = static_cast<int>(header[kWidth]);
+    int height = static_cast<int>(header[kHeight]);
+    const int level_count = (header[kFlags] & DDSD_MIPMAPCOUNT) && header[kMipMapCount] > 0 ? static_cast<int>(header[kMipMapCount]) : 1;
+
+    std::vector<TextureImage> levels;
+    for (int level = 0; level < level_count; ++level) {
+        TextureImage image = TextureImage::create(format, width, height);
+        in.read(reinterpret_cast<char *>(image.pixels.data()), static_cast<std::streamsize>(image.pixels.size()));
+        if (!in) {
+            throw TextureToolError("Truncated DDS file: " + path.string());
+        }
+        levels.push_back(std::move(image));
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return levels;
+}
+
+void write_dds(const std::filesystem::path &path, const std::vector<TextureImage> &levels) {
+    if (levels.empty()) {
+        throw TextureToolError("No levels to write to " + path.string());
+    }
+    const TextureImage &top = levels.front();
+    const PixelFormatEntry *entry = nullptr;
+    for (const PixelFormatEntry &candidate : kPixelFormats) {
+        if (candidate.format == top.format) {
+            entry = &candidate;
+        }
+    }
+
+    std::array<std::uint32_t, kHeaderWords> header{};
+    header[kSize] = 124;
+    header[kFlags] = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT;
+    header[kHeight] = static_cast<std::uint32_t>(top.height);
+    header[kWidth] = static_cast<std::uint32_t>(top.width);
+    if (is_compressed(top.format)) {
+        header[kFlags] |= DDSD_LINEARSIZE;
+        header[kPitchOrLinearSize] = static_cast<std::uint32_t>(top.pixels.size());
+    } else {
+        header[kFlags] |= DDSD_PITCH;
+        header[kPitchOrLinearSize] = static_cast<std::uint32_t>(top.pitch());
+    }
+    header[kCaps] = DDSCAPS_TEXTURE;
+    if (levels.size() > 1) {
+        header[kFlags] |= DDSD_MIPMAPCOUNT;
+        header[kMipMapCount] = static_cast<std::uint32_t>(levels.size());
+        header[kCaps] |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+    }
+    header[kPixelFormatSize] = 32;
+    header[kPixelFormatFlags] = entry->flags;
+    header[kFourCC] = entry->four_cc;
+    header[kBitCount] = entry->bit_count;
+    header[kRedMask] = entry->red_mask;
+    header[kGreenMask] = entry->green_mask;
+    header[kBlueMask] = entry->blue_mask;
+    header[kAlphaMask] = entry->alpha_mask;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw TextureToolError("Unable to write DDS file: " + path.string());
+    }
+    out.write(reinterpret_cast<const char *>(&kMagic), sizeof(kMagic));
+    out.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size() * sizeof(std::uint32_t)));
+    for (const TextureImage &level : levels) {
+        if (level.format != top.format) {
+            throw TextureToolError("Every DDS level must share one format");
+        }
+        out.write(reinterpret_cast<const char *>(level.pixels.data()), static_cast<std::streamsize>(level.pixels.size()));
+    }
+    if (!out) {
+        throw TextureToolError("Failed writing DDS file: " + path.string());
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "TextureFormat.h"
+
+#include <filesystem>
+#include <vector>
+
+// Reads and writes 2D .dds files in any TextureFormat, one TextureImage per
+// mip level.  Cube maps and volume textures are rejected.  DXT2 and DXT4
+// surfaces load as dxt3 and dxt5.
+std::vector<TextureImage> read_dds(const std::filesystem::path &path);
+void write_dds(const std::filesystem::path &path, const std::vector<TextureImage> &levels);
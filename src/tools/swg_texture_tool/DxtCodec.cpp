@@ -0,0 +1,458 @@
+#include "DxtCodec.h"
+
+#include "SimdSupport.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace {
+
+inline std::uint32_t quantize(std::uint32_t value, std::uint32_t maximum) {
+    const std::uint32_t t = value * maximum + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+inline std::uint32_t channel(std::uint32_t pixel, int shift) {
+    return (pixel >> shift) & 0xff;
+}
+
+inline std::uint32_t to_565(std::uint32_t pixel) {
+    return (quantize(channel(pixel, 16), 31) << 11) | (quantize(channel(pixel, 8), 63) << 5) | quantize(channel(pixel, 0), 31);
+}
+
+inline std::uint32_t from_565(std::uint32_t color) {
+    const std::uint32_t r = (color >> 11) & 31;
+    const std::uint32_t g = (color >> 5) & 63;
+    const std::uint32_t b = color & 31;
+    return 0xff000000u | (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+}
+
+inline std::uint32_t blend(std::uint32_t a, std::uint32_t b, std::uint32_t weight_a, std::uint32_t weight_b, std::uint32_t divisor) {
+    std::uint32_t result = 0xff000000u;
+    for (int shift = 0; shift < 24; shift += 8) {
+        result |= ((channel(a, shift) * weight_a + channel(b, shift) * weight_b + divisor / 2) / divisor) << shift;
+    }
+    return result;
+}
+
+inline void store16(std::uint8_t *destination, std::uint32_t value) {
+    destination[0] = static_cast<std::uint8_t>(value);
+    destination[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+inline std::uint32_t load16(const std::uint8_t *source) {
+    return static_cast<std::uint32_t>(source[0]) | (static_cast<std::uint32_t>(source[1]) << 8);
+}
+
+struct BlockBounds {
+    std::uint32_t minimum;
+    std::uint32_t maximum;
+};
+
+struct ColorEndpoints {
+    std::uint32_t color0;
+    std::uint32_t color1;
+    std::int32_t origin[3];
+    std::int32_t direction[3];
+    std::int32_t length_squared;
+    bool transparent;
+};
+
+// ----------------------------------------------------------------------
+
+BlockBounds bounds_scalar(const std::uint32_t *pixels) {
+    std::uint32_t low[4] = {255, 255, 255, 255};
+    std::uint32_t high[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            const std::uint32_t value = channel(pixels[i], c * 8);
+            low[c] = std::min(low[c], value);
+            high[c] = std::max(high[c], value);
+        }
+    }
+    return {low[0] | (low[1] << 8) | (low[2] << 16) | (low[3] << 24), high[0] | (high[1] << 8) | (high[2] << 16) | (high[3] << 24)};
+}
+
+ColorEndpoints make_color_endpoints(const BlockBounds &bounds, bool allow_transparent) {
+    std::uint32_t low = 0;
+    std::uint32_t high = 0;
+    for (int shift = 0; shift < 24; shift += 8) {
+        const std::uint32_t minimum = channel(bounds.minimum, shift);
+        const std::uint32_t maximum = channel(bounds.maximum, shift);
+        const std::uint32_t inset = (maximum - minimum) >> 4;
+        low |= (minimum + inset) << shift;
+        high |= (maximum - inset) << shift;
+    }
+
+    ColorEndpoints endpoints{};
+    endpoints.transparent = allow_transparent && (bounds.minimum >> 24) < 128;
+    const std::uint32_t low565 = to_565(low);
+    const std::uint32_t high565 = to_565(high);
+    if (endpoints.transparent) {
+        endpoints.color0 = low565;
+        endpoints.color1 = high565;
+    } else {
+        endpoints.color0 = high565;
+        endpoints.color1 = low565;
+    }
+
+    const std::uint32_t low_expanded = from_565(low565);
+    const std::uint32_t high_expanded = from_565(high565);
+    endpoints.length_squared = 0;
+    for (int c = 0; c < 3; ++c) {
+        endpoints.origin[c] = static_cast<std::int32_t>(channel(low_expanded, c * 8));
+        endpoints.direction[c] = static_cast<std::int32_t>(channel(high_expanded, c * 8)) - endpoints.origin[c];
+        endpoints.length_squared += endpoints.direction[c] * endpoints.direction[c];
+    }
+    return endpoints;
+}
+
+// position along the endpoint line in steps of 1/3 (four colors) or 1/2
+std::int32_t color_step(std::int32_t dot, const ColorEndpoints &endpoints) {
+    const std::int32_t total = endpoints.length_squared;
+    if (endpoints.transparent) {
+        return (dot * 4 >= total) + (dot * 4 >= total * 3);
+    }
+    return (dot * 6 >= total) + (dot * 6 >= total * 3) + (dot * 6 >= total * 5);
+}
+
+void write_color_block(const std::uint32_t *pixels, const ColorEndpoints &endpoints, const std::int32_t *steps, std::uint8_t *block) {
+    static const std::uint32_t four_color_index[4] = {1, 3, 2, 0};
+    static const std::uint32_t three_color_index[3] = {0, 2, 1};
+
+    std::uint32_t indices = 0;
+    if (endpoints.color0 != endpoints.color1 || endpoints.transparent) {
+        for (int i = 0; i < 16; ++i) {
+            std::uint32_t index;
+            if (endpoints.transparent) {
+                index = (pixels[i] >> 24) < 128 ? 3u : three_color_index[steps[i]];
+            } else {
+                index = four_color_index[steps[i]];
+            }
+            indices |= index << (i * 2);
+        }
+    }
+    store16(block, endpoints.color0);
+    store16(block + 2, endpoints.color1);
+    for (int i = 0; i < 4; ++i) {
+        block[4 + i] = static_cast<std::uint8_t>(indices >> (i * 8));
+    }
+}
+
+void color_steps_scalar(const std::uint32_t *pixels, const ColorEndpoints &endpoints, std::int32_t *steps) {
+    for (int i = 0; i < 16; ++i) {
+        std::int32_t dot = 0;
+        for (int c = 0; c < 3; ++c) {
+            dot += (static_cast<std::int32_t>(channel(pixels[i], c * 8)) - endpoints.origin[c]) * endpoints.direction[c];
+        }
+        steps[i] = color_step(dot, endpoints);
+    }
+}
+
+void alpha_steps_scalar(const std::uint32_t *pixels, std::int32_t minimum, std::int32_t range, std::int32_t *steps) {
+    for (int i = 0; i < 16; ++i) {
+        const std::int32_t scaled = (static_cast<std::int32_t>(pixels[i] >> 24) - minimum) * 14;
+        std::int32_t step = 0;
+        for (int j = 1; j <= 7; ++j) {
+            step += scaled >= (2 * j - 1) * range;
+        }
+        steps[i] = step;
+    }
+}
+
+// ----------------------------------------------------------------------
+
+#if SWG_TEXTURE_USE_SSE2
+
+BlockBounds bounds_simd(const std::uint32_t *pixels) {
+    const __m128i *rows = reinterpret_cast<const __m128i *>(pixels);
+    __m128i low = _mm_loadu_si128(rows);
+    __m128i high = low;
+    for (int row = 1; row < 4; ++row) {
+        const __m128i value = _mm_loadu_si128(rows + row);
+        low = _mm_min_epu8(low, value);
+        high = _mm_max_epu8(high, value);
+    }
+    low = _mm_min_epu8(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+    low = _mm_min_epu8(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+    high = _mm_max_epu8(high, _mm_shuffle_epi32(high, _MM_SHUFFLE(1, 0, 3, 2)));
+    high = _mm_max_epu8(high, _mm_shuffle_epi32(high, _MM_SHUFFLE(2, 3, 0, 1)));
+    return {static_cast<std::uint32_t>(_mm_cvtsi128_si32(low)), static_cast<std::uint32_t>(_mm_cvtsi128_si32(high))};
+}
+
+inline __m128i times(__m128i value, int factor) {
+    switch (factor) {
+    case 4:
+        return _mm_slli_epi32(value, 2);
+    case 6:
+    default:
+        return _mm_add_epi32(_mm_slli_epi32(value, 2), _mm_slli_epi32(value, 1));
+    }
+}
+
+inline __m128i at_least(__m128i value, std::int32_t threshold) {
+    return _mm_cmpgt_epi32(value, _mm_set1_epi32(threshold - 1));
+}
+
+void color_steps_simd(const std::uint32_t *pixels, const ColorEndpoints &endpoints, std::int32_t *steps) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i origin = _mm_setr_epi16(static_cast<short>(endpoints.origin[0]), static_cast<short>(endpoints.origin[1]), static_cast<short>(endpoints.origin[2]), 0,
+                                          static_cast<short>(endpoints.origin[0]), static_cast<short>(endpoints.origin[1]), static_cast<short>(endpoints.origin[2]), 0);
+    const __m128i direction = _mm_setr_epi16(static_cast<short>(endpoints.direction[0]), static_cast<short>(endpoints.direction[1]), static_cast<short>(endpoints.direction[2]), 0,
+                                             static_cast<short>(endpoints.direction[0]), static_cast<short>(endpoints.direction[1]), static_cast<short>(endpoints.direction[2]), 0);
+    const std::int32_t total = endpoints.length_squared;
+    const int factor = endpoints.transparent ? 4 : 6;
+
+    for (int row = 0; row < 4; ++row) {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + row * 4));
+        // (b*db + g*dg, r*dr) pairs for two pixels per register
+        __m128i low = _mm_madd_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(value, zero), origin), direction);
+        __m128i high = _mm_madd_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(value, zero), origin), direction);
+        low = _mm_add_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+        high = _mm_add_epi32(high, _mm_shuffle_epi32(high, _MM_SHUFFLE(2, 3, 0, 1)));
+        const __m128i dot = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(low), _mm_castsi128_ps(high), _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m128i scaled = times(dot, factor);
+
+        __m128i step;
+        if (endpoints.transparent) {
+            step = _mm_add_epi32(at_least(scaled, total), at_least(scaled, total * 3));
+        } else {
+            step = _mm_add_epi32(_mm_add_epi32(at_least(scaled, total), at_least(scaled, total * 3)), at_least(scaled, total * 5));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(steps + row * 4), _mm_sub_epi32(zero, step));
+    }
+}
+
+void alpha_steps_simd(const std::uint32_t *pixels, std::int32_t minimum, std::int32_t range, std::int32_t *steps) {
+    const __m128i *rows = reinterpret_cast<const __m128i *>(pixels);
+    const __m128i minimum16 = _mm_set1_epi16(static_cast<short>(minimum));
+    const __m128i fourteen = _mm_set1_epi16(14);
+    for (int half = 0; half < 2; ++half) {
+        const __m128i first = _mm_srli_epi32(_mm_loadu_si128(rows + half * 2), 24);
+        const __m128i second = _mm_srli_epi32(_mm_loadu_si128(rows + half * 2 + 1), 24);
+        const __m128i scaled = _mm_mullo_epi16(_mm_sub_epi16(_mm_packs_epi32(first, second), minimum16), fourteen);
+        __m128i step = _mm_setzero_si128();
+        for (int j = 1; j <= 7; ++j) {
+            step = _mm_sub_epi16(step, _mm_cmpgt_epi16(scaled, _mm_set1_epi16(static_cast<short>((2 * j - 1) * range - 1))));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(steps + half * 8), _mm_unpacklo_epi16(step, _mm_setzero_si128()));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(steps + half * 8 + 4), _mm_unpackhi_epi16(step, _mm_setzero_si128()));
+    }
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+
+void encode_alpha_dxt5(const std::uint32_t *pixels, const BlockBounds &bounds, bool use_simd, std::uint8_t *block) {
+    const std::int32_t minimum = static_cast<std::int32_t>(bounds.minimum >> 24);
+    const std::int32_t maximum = static_cast<std::int32_t>(bounds.maximum >> 24);
+    const std::int32_t inset = (maximum - minimum) >> 5;
+    const std::int32_t low = minimum + inset;
+    const std::int32_t high = maximum - inset;
+
+    block[0] = static_cast<std::uint8_t>(high);
+    block[1] = static_cast<std::uint8_t>(low);
+    std::memset(block + 2, 0, 6);
+    if (high == low) {
+        return;
+    }
+
+    std::int32_t steps[16];
+#if SWG_TEXTURE_USE_SSE2
+    if (use_simd) {
+        alpha_steps_simd(pixels, low, high - low, steps);
+    } else
+#endif
+    {
+        static_cast<void>(use_simd);
+        alpha_steps_scalar(pixels, low, high - low, steps);
+    }
+
+    std::uint64_t indices = 0;
+    for (int i = 0; i < 16; ++i) {
+        const std::int32_t step = steps[i];
+        const std::uint64_t index = step == 7 ? 0u : (step == 0 ? 1u : static_cast<std::uint64_t>(8 - step));
+        indices |= index << (i * 3);
+    }
+    for (int i = 0; i < 6; ++i) {
+        block[2 + i] = static_cast<std::uint8_t>(indices >> (i * 8));
+    }
+}
+
+void encode_alpha_dxt3(const std::uint32_t *pixels, std::uint8_t *block) {
+    for (int i = 0; i < 8; ++i) {
+        const std::uint32_t first = quantize(pixels[i * 2] >> 24, 15);
+        const std::uint32_t second = quantize(pixels[i * 2 + 1] >> 24, 15);
+        block[i] = static_cast<std::uint8_t>(first | (second << 4));
+    }
+}
+
+void encode_block(TextureFormat format, const std::uint32_t *pixels, bool use_simd, std::uint8_t *block) {
+    BlockBounds bounds;
+#if SWG_TEXTURE_USE_SSE2
+    if (use_simd) {
+        bounds = bounds_simd(pixels);
+    } else
+#endif
+    {
+        bounds = bounds_scalar(pixels);
+    }
+
+    std::uint8_t *color_block = block;
+    if (format == TextureFormat::dxt5) {
+        encode_alpha_dxt5(pixels, bounds, use_simd, block);
+        color_block = block + 8;
+    } else if (format == TextureFormat::dxt3) {
+        encode_alpha_dxt3(pixels, block);
+        color_block = block + 8;
+    }
+
+    const ColorEndpoints endpoints = make_color_endpoints(bounds, format == TextureFormat::dxt1);
+    std::int32_t steps[16];
+#if SWG_TEXTURE_USE_SSE2
+    if (use_simd) {
+        color_steps_simd(pixels, endpoints, steps);
+    } else
+#endif
+    {
+        color_steps_scalar(pixels, endpoints, steps);
+    }
+    write_color_block(pixels, endpoints, steps, color_block);
+}
+
+void gather_block(const TextureImage &source, int block_x, int block_y, std::uint32_t *pixels) {
+    const int x0 = block_x * 4;
+    const int y0 = block_y * 4;
+    const bool inside = x0 + 4 <= source.width && y0 + 4 <= source.height;
+    for (int y = 0; y < 4; ++y) {
+        const int source_y = std::min(y0 + y, source.height - 1);
+        const std::uint8_t *row = source.row(static_cast<std::size_t>(source_y));
+        if (inside) {
+            std::memcpy(pixels + y * 4, row + x0 * 4, 16);
+            continue;
+        }
+        for (int x = 0; x < 4; ++x) {
+            const int source_x = std::min(x0 + x, source.width - 1);
+            std::memcpy(pixels + y * 4 + x, row + source_x * 4, 4);
+        }
+    }
+}
+
+void decode_color_block(const std::uint8_t *block, bool allow_transparent, std::uint32_t *pixels) {
+    const std::uint32_t color0 = load16(block);
+    const std::uint32_t color1 = load16(block + 2);
+    std::array<std::uint32_t, 4> palette;
+    palette[0] = from_565(color0);
+    palette[1] = from_565(color1);
+    if (color0 > color1 || !allow_transparent) {
+        palette[2] = blend(palette[0], palette[1], 2, 1, 3);
+        palette[3] = blend(palette[0], palette[1], 1, 2, 3);
+    } else {
+        palette[2] = blend(palette[0], palette[1], 1, 1, 2);
+        palette[3] = 0;
+    }
+    for (int i = 0; i < 16; ++i) {
+        const std::uint32_t index = (block[4 + i / 4] >> ((i % 4) * 2)) & 3;
+        pixels[i] = palette[index];
+    }
+}
+
+} // namespace
+
+void decode_dxt_block(TextureFormat format, const std::uint8_t *block, std::uint32_t *pixels) {
+    if (format == TextureFormat::dxt1) {
+        decode_color_block(block, true, pixels);
+        return;
+    }
+
+    decode_color_block(block + 8, false, pixels);
+    if (format == TextureFormat::dxt3) {
+        for (int i = 0; i < 16; ++i) {
+            const std::uint32_t alpha = (block[i / 2] >> ((i % 2) * 4)) & 15;
+            pixels[i] = (pixels[i] & 0x00ffffffu) | ((alpha * 17) << 24);
+        }
+        return;
+    }
+
+    const std::uint32_t alpha0 = block[0];
+    const std::uint32_t alpha1 = block[1];
+    std::array<std::uint32_t, 8> palette;
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+    if (alpha0 > alpha1) {
+        for (std::uint32_t k = 2; k < 8; ++k) {
+            palette[k] = ((8 - k) * alpha0 + (k - 1) * alpha1 + 3) / 7;
+        }
+    } else {
+        for (std::uint32_t k = 2; k < 6; ++k) {
+            palette[k] = ((6 - k) * alpha0 + (k - 1) * alpha1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    std::uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i) {
+        indices |= static_cast<std::uint64_t>(block[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < 16; ++i) {
+        const std::uint32_t alpha = palette[(indices >> (i * 3)) & 7];
+        pixels[i] = (pixels[i] & 0x00ffffffu) | (alpha << 24);
+    }
+}
+
+TextureImage compress_dxt(const TextureImage &source, TextureFormat format, const PipelineOptions &options) {
+    if (!is_compressed(format)) {
+        throw TextureToolError(std::string("Not a DXT format: ") + format_name(format));
+    }
+    if (source.format != TextureFormat::argb_8888) {
+        throw TextureToolError("DXT blocks are compressed from argb_8888 images");
+    }
+
+    TextureImage destination = TextureImage::create(format, source.width, source.height);
+    const int blocks_wide = static_cast<int>(row_pitch(format, source.width)) / bytes_per_block(format);
+    const int blocks_high = static_cast<int>(row_count(format, source.height));
+    const std::size_t block_size = static_cast<std::size_t>(bytes_per_block(format));
+
+    parallel_rows(options, 0, blocks_high, 2, [&](int begin, int end) {
+        alignas(16) std::uint32_t pixels[16];
+        for (int block_y = begin; block_y < end; ++block_y) {
+            std::uint8_t *row = destination.row(static_cast<std::size_t>(block_y));
+            for (int block_x = 0; block_x < blocks_wide; ++block_x) {
+                gather_block(source, block_x, block_y, pixels);
+                encode_block(format, pixels, options.use_simd, row + static_cast<std::size_t>(block_x) * block_size);
+            }
+        }
+    });
+
+    return destination;
+}
+
+TextureImage decompress_dxt(const TextureImage &source, const PipelineOptions &options) {
+    if (!is_compressed(source.format)) {
+        throw TextureToolError(std::string("Not a DXT format: ") + format_name(source.format));
+    }
+
+    TextureImage destination = TextureImage::create(TextureFormat::argb_8888, source.width, source.height);
+    const int blocks_wide = static_cast<int>(source.pitch()) / bytes_per_block(source.format);
+    const int blocks_high = static_cast<int>(row_count(source.format, source.height));
+    const std::size_t block_size = static_cast<std::size_t>(bytes_per_block(source.format));
+
+    parallel_rows(options, 0, blocks_high, 4, [&](int begin, int end) {
+        std::uint32_t pixels[16];
+        for (int block_y = begin; block_y < end; ++block_y) {
+            const std::uint8_t *row = source.row(static_cast<std::size_t>(block_y));
+            const int rows = std::min(4, source.height - block_y * 4);
+            for (int block_x = 0; block_x < blocks_wide; ++block_x) {
+                decode_dxt_block(source.format, row + static_cast<std::size_t>(block_x) * block_size, pixels);
+                const int columns = std::min(4, source.width - block_x * 4);
+                for (int y = 0; y < rows; ++y) {
+                    std::memcpy(destination.row(static_cast<std::size_t>(block_y * 4 + y)) + block_x * 16, pixels + y * 4, static_cast<std::size_t>(columns) * 4);
+                }
+            }
+        }
+    });
+
+    return destination;
+}
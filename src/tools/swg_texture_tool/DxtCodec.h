@@ -0,0 +1,20 @@
+#pragma once
+
+#include "PipelineOptions.h"
+#include "TextureFormat.h"
+
+#include <cstdint>
+
+// Compresses an argb_8888 image to dxt1, dxt3 or dxt5.  Color endpoints are
+// the block's bounding box inset by 1/16 of its range and every pixel takes
+// the palette entry nearest its projection onto the endpoint line; dxt5
+// alpha works the same way with eight levels.  dxt1 blocks holding any
+// alpha below 128 switch to three colors plus transparent black.  Partial
+// blocks at the right and bottom edges repeat the last pixel.
+TextureImage compress_dxt(const TextureImage &source, TextureFormat format, const PipelineOptions &options);
+
+// Expands a dxt1, dxt3 or dxt5 image to argb_8888.
+TextureImage decompress_dxt(const TextureImage &source, const PipelineOptions &options);
+
+// Decodes one block into 16 argb_8888 pixels in row order.
+void decode_dxt_block(TextureFormat format, const std::uint8_t *block, std::uint32_t *pixels);
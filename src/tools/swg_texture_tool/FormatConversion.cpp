@@ -0,0 +1,322 @@
+#include "FormatConversion.h"
+
+#include "DxtCodec.h"
+#include "SimdSupport.h"
+
+#include <cstring>
+
+namespace {
+
+// round(value * maximum / 255) for 8-bit values without a divide
+inline std::uint32_t quantize(std::uint32_t value, std::uint32_t maximum) {
+    const std::uint32_t t = value * maximum + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+inline std::uint32_t expand4(std::uint32_t value) { return value * 17; }
+inline std::uint32_t expand5(std::uint32_t value) { return (value << 3) | (value >> 2); }
+inline std::uint32_t expand6(std::uint32_t value) { return (value << 2) | (value >> 4); }
+
+inline std::uint16_t load16(const std::uint8_t *source) {
+    std::uint16_t value;
+    std::memcpy(&value, source, sizeof(value));
+    return value;
+}
+
+inline void store16(std::uint8_t *destination, std::uint32_t value) {
+    const std::uint16_t narrowed = static_cast<std::uint16_t>(value);
+    std::memcpy(destination, &narrowed, sizeof(narrowed));
+}
+
+inline std::uint32_t pack_argb(std::uint32_t a, std::uint32_t r, std::uint32_t g, std::uint32_t b) {
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+// ----------------------------------------------------------------------
+
+std::uint32_t unpack_pixel16(TextureFormat format, std::uint32_t v) {
+    switch (format) {
+    case TextureFormat::argb_4444:
+        return pack_argb(expand4(v >> 12), expand4((v >> 8) & 15), expand4((v >> 4) & 15), expand4(v & 15));
+    case TextureFormat::argb_1555:
+        return pack_argb((v & 0x8000) ? 255 : 0, expand5((v >> 10) & 31), expand5((v >> 5) & 31), expand5(v & 31));
+    case TextureFormat::rgb_555:
+        return pack_argb(255, expand5((v >> 10) & 31), expand5((v >> 5) & 31), expand5(v & 31));
+    case TextureFormat::rgb_565:
+        return pack_argb(255, expand5(v >> 11), expand6((v >> 5) & 63), expand5(v & 31));
+    default:
+        return 0;
+    }
+}
+
+std::uint32_t pack_pixel16(TextureFormat format, std::uint32_t p) {
+    const std::uint32_t a = p >> 24;
+    const std::uint32_t r = (p >> 16) & 0xff;
+    const std::uint32_t g = (p >> 8) & 0xff;
+    const std::uint32_t b = p & 0xff;
+    switch (format) {
+    case TextureFormat::argb_4444:
+        return (quantize(a, 15) << 12) | (quantize(r, 15) << 8) | (quantize(g, 15) << 4) | quantize(b, 15);
+    case TextureFormat::argb_1555:
+        return ((a >= 128) ? 0x8000u : 0u) | (quantize(r, 31) << 10) | (quantize(g, 31) << 5) | quantize(b, 31);
+    case TextureFormat::rgb_555:
+        return 0x8000u | (quantize(r, 31) << 10) | (quantize(g, 31) << 5) | quantize(b, 31);
+    case TextureFormat::rgb_565:
+        return (quantize(r, 31) << 11) | (quantize(g, 63) << 5) | quantize(b, 31);
+    default:
+        return 0;
+    }
+}
+
+bool is_16bit(TextureFormat format) {
+    return format == TextureFormat::argb_4444 || format == TextureFormat::argb_1555 || format == TextureFormat::rgb_555 || format == TextureFormat::rgb_565;
+}
+
+// ----------------------------------------------------------------------
+
+#if SWG_TEXTURE_USE_SSE2
+
+inline __m128i quantize4(__m128i value, int maximum) {
+    const __m128i t = _mm_add_epi32(_mm_mullo_epi16(value, _mm_set1_epi32(maximum)), _mm_set1_epi32(128));
+    return _mm_srli_epi32(_mm_add_epi32(t, _mm_srli_epi32(t, 8)), 8);
+}
+
+inline __m128i channel4(__m128i pixels, int shift) {
+    return _mm_and_si128(_mm_srli_epi32(pixels, shift), _mm_set1_epi32(0xff));
+}
+
+inline __m128i field4(__m128i values, int shift, int mask) {
+    return _mm_and_si128(_mm_srli_epi32(values, shift), _mm_set1_epi32(mask));
+}
+
+inline __m128i expand5_4(__m128i value) { return _mm_or_si128(_mm_slli_epi32(value, 3), _mm_srli_epi32(value, 2)); }
+inline __m128i expand6_4(__m128i value) { return _mm_or_si128(_mm_slli_epi32(value, 2), _mm_srli_epi32(value, 4)); }
+inline __m128i expand4_4(__m128i value) { return _mm_or_si128(_mm_slli_epi32(value, 4), value); }
+
+inline __m128i combine4(__m128i a, __m128i r, __m128i g, __m128i b) {
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(a, 24), _mm_slli_epi32(r, 16)), _mm_or_si128(_mm_slli_epi32(g, 8), b));
+}
+
+__m128i unpack4_16(TextureFormat format, __m128i v) {
+    switch (format) {
+    case TextureFormat::argb_4444:
+        return combine4(expand4_4(_mm_srli_epi32(v, 12)), expand4_4(field4(v, 8, 15)), expand4_4(field4(v, 4, 15)), expand4_4(field4(v, 0, 15)));
+    case TextureFormat::argb_1555: {
+        const __m128i alpha = _mm_and_si128(_mm_sub_epi32(_mm_setzero_si128(), _mm_srli_epi32(v, 15)), _mm_set1_epi32(0xff));
+        return combine4(alpha, expand5_4(field4(v, 10, 31)), expand5_4(field4(v, 5, 31)), expand5_4(field4(v, 0, 31)));
+    }
+    case TextureFormat::rgb_555:
+        return combine4(_mm_set1_epi32(0xff), expand5_4(field4(v, 10, 31)), expand5_4(field4(v, 5, 31)), expand5_4(field4(v, 0, 31)));
+    case TextureFormat::rgb_565:
+    default:
+        return combine4(_mm_set1_epi32(0xff), expand5_4(_mm_srli_epi32(v, 11)), expand6_4(field4(v, 5, 63)), expand5_4(field4(v, 0, 31)));
+    }
+}
+
+__m128i pack4_16(TextureFormat format, __m128i p) {
+    const __m128i a = _mm_srli_epi32(p, 24);
+    const __m128i r = channel4(p, 16);
+    const __m128i g = channel4(p, 8);
+    const __m128i b = channel4(p, 0);
+    switch (format) {
+    case TextureFormat::argb_4444:
+        return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(quantize4(a, 15), 12), _mm_slli_epi32(quantize4(r, 15), 8)), _mm_or_si128(_mm_slli_epi32(quantize4(g, 15), 4), quantize4(b, 15)));
+    case TextureFormat::argb_1555: {
+        const __m128i alpha = _mm_slli_epi32(_mm_srli_epi32(a, 7), 15);
+        return _mm_or_si128(_mm_or_si128(alpha, _mm_slli_epi32(quantize4(r, 31), 10)), _mm_or_si128(_mm_slli_epi32(quantize4(g, 31), 5), quantize4(b, 31)));
+    }
+    case TextureFormat::rgb_555:
+        return _mm_or_si128(_mm_or_si128(_mm_set1_epi32(0x8000), _mm_slli_epi32(quantize4(r, 31), 10)), _mm_or_si128(_mm_slli_epi32(quantize4(g, 31), 5), quantize4(b, 31)));
+    case TextureFormat::rgb_565:
+    default:
+        return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(quantize4(r, 31), 11), _mm_slli_epi32(quantize4(g, 63), 5)), quantize4(b, 31));
+    }
+}
+
+// narrows four 32-bit lanes holding 16-bit values without signed saturation
+inline __m128i narrow_to_16(__m128i values) {
+    return _mm_srai_epi32(_mm_slli_epi32(values, 16), 16);
+}
+
+int unpack_row16_simd(TextureFormat format, const std::uint8_t *source, std::uint32_t *destination, int width) {
+    const __m128i zero = _mm_setzero_si128();
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x * 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x), unpack4_16(format, _mm_unpacklo_epi16(packed, zero)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x + 4), unpack4_16(format, _mm_unpackhi_epi16(packed, zero)));
+    }
+    return x;
+}
+
+int pack_row16_simd(TextureFormat format, const std::uint32_t *source, std::uint8_t *destination, int width) {
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m128i low = narrow_to_16(pack4_16(format, _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x))));
+        const __m128i high = narrow_to_16(pack4_16(format, _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x + 4))));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x * 2), _mm_packs_epi32(low, high));
+    }
+    return x;
+}
+
+int set_alpha_row_simd(const std::uint32_t *source, std::uint32_t *destination, int width) {
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000u));
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + x));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x), _mm_or_si128(pixels, alpha));
+    }
+    return x;
+}
+
+#endif
+
+} // namespace
+
+bool simd_available() {
+    return SWG_TEXTURE_USE_SSE2 != 0;
+}
+
+void unpack_row(TextureFormat format, const std::uint8_t *source, std::uint32_t *destination, int width, bool use_simd) {
+    int x = 0;
+    switch (format) {
+    case TextureFormat::argb_8888:
+        std::memcpy(destination, source, static_cast<std::size_t>(width) * 4);
+        return;
+    case TextureFormat::xrgb_8888: {
+        const std::uint32_t *pixels = reinterpret_cast<const std::uint32_t *>(source);
+#if SWG_TEXTURE_USE_SSE2
+        if (use_simd) {
+            x = set_alpha_row_simd(pixels, destination, width);
+        }
+#endif
+        for (; x < width; ++x) {
+            destination[x] = pixels[x] | 0xff000000u;
+        }
+        return;
+    }
+    case TextureFormat::rgb_888:
+        // SSE2 has no byte shuffle, so the 24-bit layout stays scalar
+        for (; x < width; ++x) {
+            const std::uint8_t *pixel = source + x * 3;
+            destination[x] = pack_argb(255, pixel[2], pixel[1], pixel[0]);
+        }
+        return;
+    case TextureFormat::a_8:
+        for (; x < width; ++x) {
+            destination[x] = static_cast<std::uint32_t>(source[x]) << 24;
+        }
+        return;
+    case TextureFormat::l_8:
+        for (; x < width; ++x) {
+            destination[x] = 0xff000000u | (static_cast<std::uint32_t>(source[x]) * 0x010101u);
+        }
+        return;
+    default:
+        break;
+    }
+
+    if (!is_16bit(format)) {
+        throw TextureToolError(std::string("Cannot unpack rows of ") + format_name(format));
+    }
+#if SWG_TEXTURE_USE_SSE2
+    if (use_simd) {
+        x = unpack_row16_simd(format, source, destination, width);
+    }
+#else
+    static_cast<void>(use_simd);
+#endif
+    for (; x < width; ++x) {
+        destination[x] = unpack_pixel16(format, load16(source + x * 2));
+    }
+}
+
+void pack_row(TextureFormat format, const std::uint32_t *source, std::uint8_t *destination, int width, bool use_simd) {
+    int x = 0;
+    switch (format) {
+    case TextureFormat::argb_8888:
+        std::memcpy(destination, source, static_cast<std::size_t>(width) * 4);
+        return;
+    case TextureFormat::xrgb_8888: {
+        std::uint32_t *pixels = reinterpret_cast<std::uint32_t *>(destination);
+#if SWG_TEXTURE_USE_SSE2
+        if (use_simd) {
+            x = set_alpha_row_simd(source, pixels, width);
+        }
+#endif
+        for (; x < width; ++x) {
+            pixels[x] = source[x] | 0xff000000u;
+        }
+        return;
+    }
+    case TextureFormat::rgb_888:
+        for (; x < width; ++x) {
+            std::uint8_t *pixel = destination + x * 3;
+            pixel[0] = static_cast<std::uint8_t>(source[x]);
+            pixel[1] = static_cast<std::uint8_t>(source[x] >> 8);
+            pixel[2] = static_cast<std::uint8_t>(source[x] >> 16);
+        }
+        return;
+    case TextureFormat::a_8:
+        for (; x < width; ++x) {
+            destination[x] = static_cast<std::uint8_t>(source[x] >> 24);
+        }
+        return;
+    case TextureFormat::l_8:
+        for (; x < width; ++x) {
+            const std::uint32_t p = source[x];
+            destination[x] = static_cast<std::uint8_t>((77 * ((p >> 16) & 0xff) + 150 * ((p >> 8) & 0xff) + 29 * (p & 0xff) + 128) >> 8);
+        }
+        return;
+    default:
+        break;
+    }
+
+    if (!is_16bit(format)) {
+        throw TextureToolError(std::string("Cannot pack rows of ") + format_name(format));
+    }
+#if SWG_TEXTURE_USE_SSE2
+    if (use_simd) {
+        x = pack_row16_simd(format, source, destination, width);
+    }
+#else
+    static_cast<void>(use_simd);
+#endif
+    for (; x < width; ++x) {
+        store16(destination + x * 2, pack_pixel16(format, source[x]));
+    }
+}
+
+TextureImage convert_format(const TextureImage &source, TextureFormat destination_format, const PipelineOptions &options) {
+    if (source.format == destination_format) {
+        return source;
+    }
+    if (is_compressed(source.format)) {
+        TextureImage decompressed = decompress_dxt(source, options);
+        return convert_format(decompressed, destination_format, options);
+    }
+    if (is_compressed(destination_format)) {
+        return compress_dxt(convert_format(source, TextureFormat::argb_8888, options), destination_format, options);
+    }
+
+    TextureImage destination = TextureImage::create(destination_format, source.width, source.height);
+    const int width = source.width;
+
+    parallel_rows(options, 0, source.height, 16, [&](int begin, int end) {
+        std::vector<std::uint32_t> scratch(static_cast<std::size_t>(width));
+        for (int y = begin; y < end; ++y) {
+            const std::uint8_t *source_row = source.row(static_cast<std::size_t>(y));
+            std::uint8_t *destination_row = destination.row(static_cast<std::size_t>(y));
+            if (source.format == TextureFormat::argb_8888) {
+                pack_row(destination_format, reinterpret_cast<const std::uint32_t *>(source_row), destination_row, width, options.use_simd);
+            } else if (destination_format == TextureFormat::argb_8888) {
+                unpack_row(source.format, source_row, reinterpret_cast<std::uint32_t *>(destination_row), width, options.use_simd);
+            } else {
+                unpack_row(source.format, source_row, scratch.data(), width, options.use_simd);
+                pack_row(destination_format, scratch.data(), destination_row, width, options.use_simd);
+            }
+        }
+    });
+
+    return destination;
+}
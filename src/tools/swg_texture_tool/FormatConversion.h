@@ -0,0 +1,17 @@
+#pragma once
+
+#include "PipelineOptions.h"
+#include "TextureFormat.h"
+
+#include <cstdint>
+
+// Converts between any two formats by way of argb_8888 rows.  Narrowing a
+// channel rounds to the nearest representable value and widening replicates
+// the high bits, so a round trip through a wider format is lossless.  DXT
+// sources and destinations go through DxtCodec.
+TextureImage convert_format(const TextureImage &source, TextureFormat destination_format, const PipelineOptions &options);
+
+// Row helpers shared with the mip and DXT stages.  Neither accepts DXT
+// formats.
+void unpack_row(TextureFormat format, const std::uint8_t *source, std::uint32_t *destination, int width, bool use_simd);
+void pack_row(TextureFormat format, const std::uint32_t *source, std::uint8_t *destination, int width, bool use_simd);
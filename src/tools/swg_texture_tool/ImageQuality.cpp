@@ -0,0 +1,32 @@
+#include "ImageQuality.h"
+
+#include "ReferencePipeline.h"
+
+#include <cmath>
+#include <limits>
+
+double psnr(const TextureImage &first, const TextureImage &second, bool include_alpha) {
+    if (first.width != second.width || first.height != second.height) {
+        throw TextureToolError("PSNR needs two images of the same size");
+    }
+    const TextureImage a = reference_pipeline::convert_format(first, TextureFormat::argb_8888);
+    const TextureImage b = reference_pipeline::convert_format(second, TextureFormat::argb_8888);
+
+    const int channels = include_alpha ? 4 : 3;
+    double squared_error = 0.0;
+    for (std::size_t i = 0; i < a.pixels.size(); i += 4) {
+        for (int channel = 0; channel < channels; ++channel) {
+            const double difference = static_cast<double>(a.pixels[i + static_cast<std::size_t>(channel)]) - static_cast<double>(b.pixels[i + static_cast<std::size_t>(channel)]);
+            squared_error += difference * difference;
+        }
+    }
+    if (squared_error == 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    const double samples = static_cast<double>(a.pixels.size() / 4) * channels;
+    return 10.0 * std::log10((255.0 * 255.0) / (squared_error / samples));
+}
+
+bool identical(const TextureImage &first, const TextureImage &second) {
+    return first.format == second.format && first.width == second.width && first.height == second.height && first.pixels == second.pixels;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "TextureFormat.h"
+
+// Peak signal to noise ratio in dB between two images of the same size and
+// any formats, over red, green and blue plus alpha when include_alpha is
+// set.  Identical images give infinity.
+double psnr(const TextureImage &first, const TextureImage &second, bool include_alpha);
+
+bool identical(const TextureImage &first, const TextureImage &second);
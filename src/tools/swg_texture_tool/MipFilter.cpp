@@ -0,0 +1,313 @@
+#include "MipFilter.h"
+
+#include "FormatConversion.h"
+#include "SimdSupport.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr int kKaiserTaps = 12;
+constexpr double kKaiserWidth = 3.0;
+constexpr double kKaiserAlpha = 4.0;
+
+double bessel_i0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double quarter_x2 = x * x * 0.25;
+    for (int k = 1; k < 32; ++k) {
+        term *= quarter_x2 / (static_cast<double>(k) * static_cast<double>(k));
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+double sinc(double x) {
+    if (std::fabs(x) < 1e-9) {
+        return 1.0;
+    }
+    const double pix = 3.14159265358979323846 * x;
+    return std::sin(pix) / pix;
+}
+
+// Weights for source pixels 2x-5 .. 2x+6 around destination pixel x.  The
+// offsets are the same for every destination pixel of a 2:1 reduction.
+const std::array<float, kKaiserTaps> &kaiser_weights() {
+    static const std::array<float, kKaiserTaps> weights = [] {
+        std::array<double, kKaiserTaps> raw{};
+        double total = 0.0;
+        for (int tap = 0; tap < kKaiserTaps; ++tap) {
+            const double offset = ((tap - 5) + 0.5 - 1.0) * 0.5;
+            const double window_position = offset / kKaiserWidth;
+            double weight = 0.0;
+            if (std::fabs(window_position) < 1.0) {
+                weight = sinc(offset) * bessel_i0(kKaiserAlpha * std::sqrt(1.0 - window_position * window_position)) / bessel_i0(kKaiserAlpha);
+            }
+            raw[static_cast<std::size_t>(tap)] = weight;
+            total += weight;
+        }
+        std::array<float, kKaiserTaps> normalized{};
+        for (int tap = 0; tap < kKaiserTaps; ++tap) {
+            normalized[static_cast<std::size_t>(tap)] = static_cast<float>(raw[static_cast<std::size_t>(tap)] / total);
+        }
+        return normalized;
+    }();
+    return weights;
+}
+
+inline int clamp_index(int index, int size) {
+    return std::min(std::max(index, 0), size - 1);
+}
+
+inline std::uint8_t to_byte(float value) {
+    const float clamped = std::min(std::max(value + 0.5f, 0.0f), 255.0f);
+    return static_cast<std::uint8_t>(static_cast<int>(clamped));
+}
+
+// ----------------------------------------------------------------------
+
+void box_row_scalar(const std::uint8_t *upper, const std::uint8_t *lower, std::uint8_t *destination, int destination_width, int x) {
+    for (; x < destination_width; ++x) {
+        const std::uint8_t *a = upper + x * 8;
+        const std::uint8_t *b = lower + x * 8;
+        for (int channel = 0; channel < 4; ++channel) {
+            const int sum = a[channel] + a[channel + 4] + b[channel] + b[channel + 4];
+            destination[x * 4 + channel] = static_cast<std::uint8_t>((sum + 2) >> 2);
+        }
+    }
+}
+
+#if SWG_TEXTURE_USE_SSE2
+
+int box_row_simd(const std::uint8_t *upper, const std::uint8_t *lower, std::uint8_t *destination, int destination_width) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi16(2);
+    int x = 0;
+    for (; x + 4 <= destination_width; x += 4) {
+        __m128i result[2];
+        for (int half = 0; half < 2; ++half) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(upper + (x + half * 2) * 8));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lower + (x + half * 2) * 8));
+            const __m128i sum_low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+            const __m128i sum_high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+            // fold each pixel pair: lanes 0-3 of sum_low + lanes 4-7 of sum_low
+            const __m128i pair_low = _mm_add_epi16(sum_low, _mm_srli_si128(sum_low, 8));
+            const __m128i pair_high = _mm_add_epi16(sum_high, _mm_srli_si128(sum_high, 8));
+            result[half] = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(pair_low, pair_high), rounding), 2);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + x * 4), _mm_packus_epi16(result[0], result[1]));
+    }
+    return x;
+}
+
+inline void store_pixel(std::uint8_t *pixel, __m128 value) {
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_add_ps(value, _mm_set1_ps(0.5f)), _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    const __m128i integers = _mm_cvttps_epi32(clamped);
+    const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(integers, integers), _mm_setzero_si128());
+    const std::int32_t packed = _mm_cvtsi128_si32(bytes);
+    std::memcpy(pixel, &packed, sizeof(packed));
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+
+TextureImage box_mip(const TextureImage &source, const PipelineOptions &options) {
+    const int destination_width = std::max(1, source.width / 2);
+    const int destination_height = std::max(1, source.height / 2);
+    TextureImage destination = TextureImage::create(TextureFormat::argb_8888, destination_width, destination_height);
+
+    const bool halve_x = source.width > 1;
+    const bool halve_y = source.height > 1;
+
+    parallel_rows(options, 0, destination_height, 8, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            const std::uint8_t *upper = source.row(static_cast<std::size_t>(halve_y ? y * 2 : y));
+            const std::uint8_t *lower = source.row(static_cast<std::size_t>(halve_y ? y * 2 + 1 : y));
+            std::uint8_t *row = destination.row(static_cast<std::size_t>(y));
+            if (!halve_x) {
+                // a one pixel wide column only halves vertically
+                for (int channel = 0; channel < 4; ++channel) {
+                    row[channel] = static_cast<std::uint8_t>((upper[channel] + lower[channel] + 1) >> 1);
+                }
+                continue;
+            }
+            int x = 0;
+#if SWG_TEXTURE_USE_SSE2
+            if (options.use_simd) {
+                x = box_row_simd(upper, lower, row, destination_width);
+            }
+#endif
+            box_row_scalar(upper, lower, row, destination_width, x);
+        }
+    });
+
+    return destination;
+}
+
+// ----------------------------------------------------------------------
+
+TextureImage kaiser_mip(const TextureImage &source, const PipelineOptions &options) {
+    const int source_width = source.width;
+    const int source_height = source.height;
+    const int destination_width = std::max(1, source_width / 2);
+    const int destination_height = std::max(1, source_height / 2);
+    const bool halve_x = source_width > 1;
+    const bool halve_y = source_height > 1;
+    const std::array<float, kKaiserTaps> &weights = kaiser_weights();
+
+    // horizontal pass into a float image of destination width and source
+    // height, reading each source row through a float copy padded with its
+    // edge pixels so no tap needs clamping
+    std::vector<float> horizontal(static_cast<std::size_t>(destination_width) * static_cast<std::size_t>(source_height) * 4);
+
+    parallel_rows(options, 0, source_height, 8, [&](int begin, int end) {
+        std::vector<float> padded(static_cast<std::size_t>(source_width + kKaiserTaps) * 4);
+        for (int y = begin; y < end; ++y) {
+            const std::uint8_t *row = source.row(static_cast<std::size_t>(y));
+            float *out = horizontal.data() + static_cast<std::size_t>(y) * static_cast<std::size_t>(destination_width) * 4;
+            if (!halve_x) {
+                for (int channel = 0; channel < 4; ++channel) {
+                    out[channel] = row[channel];
+                }
+                continue;
+            }
+            for (int x = -5; x < source_width + 6; ++x) {
+                const std::uint8_t *pixel = row + clamp_index(x, source_width) * 4;
+                float *padded_pixel = padded.data() + static_cast<std::size_t>(x + 5) * 4;
+                for (int channel = 0; channel < 4; ++channel) {
+                    padded_pixel[channel] = pixel[channel];
+                }
+            }
+            int x = 0;
+#if SWG_TEXTURE_USE_SSE2
+            if (options.use_simd) {
+                // four pixels at a time keeps four independent sums in flight
+                for (; x + 4 <= destination_width; x += 4) {
+                    const float *taps = padded.data() + static_cast<std::size_t>(x) * 8;
+                    __m128 sum[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+                    for (int tap = 0; tap < kKaiserTaps; ++tap) {
+                        const __m128 weight = _mm_set1_ps(weights[static_cast<std::size_t>(tap)]);
+                        for (int pixel = 0; pixel < 4; ++pixel) {
+                            sum[pixel] = _mm_add_ps(sum[pixel], _mm_mul_ps(_mm_loadu_ps(taps + (pixel * 2 + tap) * 4), weight));
+                        }
+                    }
+                    for (int pixel = 0; pixel < 4; ++pixel) {
+                        _mm_storeu_ps(out + (x + pixel) * 4, sum[pixel]);
+                    }
+                }
+            }
+#endif
+            for (; x < destination_width; ++x) {
+                const float *taps = padded.data() + static_cast<std::size_t>(x) * 8;
+                float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                for (int tap = 0; tap < kKaiserTaps; ++tap) {
+                    const float weight = weights[static_cast<std::size_t>(tap)];
+                    for (int channel = 0; channel < 4; ++channel) {
+                        sum[channel] += taps[tap * 4 + channel] * weight;
+                    }
+                }
+                std::memcpy(out + x * 4, sum, sizeof(sum));
+            }
+        }
+    });
+
+    TextureImage destination = TextureImage::create(TextureFormat::argb_8888, destination_width, destination_height);
+    const std::size_t float_pitch = static_cast<std::size_t>(destination_width) * 4;
+
+    parallel_rows(options, 0, destination_height, 8, [&](int begin, int end) {
+        std::array<const float *, kKaiserTaps> taps{};
+        for (int y = begin; y < end; ++y) {
+            std::uint8_t *row = destination.row(static_cast<std::size_t>(y));
+            if (!halve_y) {
+                const float *in = horizontal.data() + static_cast<std::size_t>(y) * float_pitch;
+                for (std::size_t i = 0; i < float_pitch; ++i) {
+                    row[i] = to_byte(in[i]);
+                }
+                continue;
+            }
+            for (int tap = 0; tap < kKaiserTaps; ++tap) {
+                taps[static_cast<std::size_t>(tap)] = horizontal.data() + static_cast<std::size_t>(clamp_index(y * 2 - 5 + tap, source_height)) * float_pitch;
+            }
+            int x = 0;
+#if SWG_TEXTURE_USE_SSE2
+            if (options.use_simd) {
+                for (; x + 4 <= destination_width; x += 4) {
+                    const std::size_t offset = static_cast<std::size_t>(x) * 4;
+                    __m128 sum[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+                    for (int tap = 0; tap < kKaiserTaps; ++tap) {
+                        const __m128 weight = _mm_set1_ps(weights[static_cast<std::size_t>(tap)]);
+                        const float *in = taps[static_cast<std::size_t>(tap)] + offset;
+                        for (int pixel = 0; pixel < 4; ++pixel) {
+                            sum[pixel] = _mm_add_ps(sum[pixel], _mm_mul_ps(_mm_loadu_ps(in + pixel * 4), weight));
+                        }
+                    }
+                    for (int pixel = 0; pixel < 4; ++pixel) {
+                        store_pixel(row + offset + static_cast<std::size_t>(pixel) * 4, sum[pixel]);
+                    }
+                }
+            }
+#endif
+            for (; x < destination_width; ++x) {
+                const std::size_t offset = static_cast<std::size_t>(x) * 4;
+                float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                for (int tap = 0; tap < kKaiserTaps; ++tap) {
+                    const float weight = weights[static_cast<std::size_t>(tap)];
+                    for (int channel = 0; channel < 4; ++channel) {
+                        sum[channel] += taps[static_cast<std::size_t>(tap)][offset + static_cast<std::size_t>(channel)] * weight;
+                    }
+                }
+                for (int channel = 0; channel < 4; ++channel) {
+                    row[offset + static_cast<std::size_t>(channel)] = to_byte(sum[channel]);
+                }
+            }
+        }
+    });
+
+    return destination;
+}
+
+} // namespace
+
+const char *filter_name(MipFilter filter) {
+    return filter == MipFilter::kaiser ? "kaiser" : "box";
+}
+
+std::optional<MipFilter> parse_filter(std::string_view name) {
+    if (name == "box") {
+        return MipFilter::box;
+    }
+    if (name == "kaiser") {
+        return MipFilter::kaiser;
+    }
+    return std::nullopt;
+}
+
+TextureImage next_mip(const TextureImage &source, MipFilter filter, const PipelineOptions &options) {
+    if (source.format != TextureFormat::argb_8888) {
+        throw TextureToolError("Mip levels are filtered from argb_8888 images");
+    }
+    return filter == MipFilter::kaiser ? kaiser_mip(source, options) : box_mip(source, options);
+}
+
+std::vector<TextureImage> build_mip_chain(const TextureImage &top, MipFilter filter, TextureFormat format, int max_levels, const PipelineOptions &options) {
+    std::vector<TextureImage> levels;
+    TextureImage current = convert_format(top, TextureFormat::argb_8888, options);
+    for (;;) {
+        const bool last = (current.width == 1 && current.height == 1) || (max_levels > 0 && static_cast<int>(levels.size()) + 1 >= max_levels);
+        if (last) {
+            levels.push_back(convert_format(current, format, options));
+            break;
+        }
+        TextureImage next = next_mip(current, filter, options);
+        levels.push_back(convert_format(current, format, options));
+        current = std::move(next);
+    }
+    return levels;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "PipelineOptions.h"
+#include "TextureFormat.h"
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+enum class MipFilter {
+    box,
+    kaiser,
+};
+
+const char *filter_name(MipFilter filter);
+std::optional<MipFilter> parse_filter(std::string_view name);
+
+// Halves each dimension of an argb_8888 image that is longer than one pixel.
+// The box filter averages each 2x2 footprint with rounding.  The Kaiser
+// filter is a separable Kaiser-windowed sinc, three destination pixels wide
+// with alpha 4, that clamps at the image edges.  An odd trailing row or
+// column is dropped by the box filter, as ImageManipulation does.
+TextureImage next_mip(const TextureImage &source, MipFilter filter, const PipelineOptions &options);
+
+// Builds the chain from the argb_8888 top level down to 1x1, or to
+// max_levels levels when that is positive, converting every level to
+// `format` once the next level has been filtered from it.
+std::vector<TextureImage> build_mip_chain(const TextureImage &top, MipFilter filter, TextureFormat format, int max_levels, const PipelineOptions &options);
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "ThreadPool.h"
+
+// How the fast pipeline runs.  With no pool every stage runs on the calling
+// thread; with use_simd off every stage takes its scalar path, which gives
+// the same results as the SSE2 path.
+struct PipelineOptions {
+    ThreadPool *pool = nullptr;
+    bool use_simd = true;
+};
+
+// True when the SSE2 paths were compiled in.
+bool simd_available();
+
+inline void parallel_rows(const PipelineOptions &options, int begin, int end, int grain, const ThreadPool::RangeFunction &body) {
+    if (options.pool) {
+        options.pool->parallel_for(begin, end, grain, body);
+    } else if (begin < end) {
+        body(begin, end);
+    }
+}
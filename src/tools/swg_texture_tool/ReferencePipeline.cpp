@@ -0,0 +1,421 @@
+#include "ReferencePipeline.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace {
+
+struct Color {
+    int r = 0;
+    int g = 0;
+    int b = 0;
+    int a = 255;
+};
+
+int narrow(int value, int maximum) {
+    return (value * maximum + 127) / 255;
+}
+
+int widen(int value, int maximum) {
+    switch (maximum) {
+    case 15:
+        return (value << 4) | value;
+    case 31:
+        return (value << 3) | (value >> 2);
+    case 63:
+        return (value << 2) | (value >> 4);
+    default:
+        return value ? 255 : 0;
+    }
+}
+
+int read16(const std::uint8_t *pixel) {
+    return pixel[0] | (pixel[1] << 8);
+}
+
+void write16(std::uint8_t *pixel, int value) {
+    pixel[0] = static_cast<std::uint8_t>(value);
+    pixel[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+Color get_pixel(TextureFormat format, const std::uint8_t *pixel) {
+    Color color;
+    switch (format) {
+    case TextureFormat::argb_8888:
+        color.b = pixel[0];
+        color.g = pixel[1];
+        color.r = pixel[2];
+        color.a = pixel[3];
+        break;
+    case TextureFormat::xrgb_8888:
+    case TextureFormat::rgb_888:
+        color.b = pixel[0];
+        color.g = pixel[1];
+        color.r = pixel[2];
+        break;
+    case TextureFormat::argb_4444: {
+        const int v = read16(pixel);
+        color.a = widen(v >> 12, 15);
+        color.r = widen((v >> 8) & 15, 15);
+        color.g = widen((v >> 4) & 15, 15);
+        color.b = widen(v & 15, 15);
+        break;
+    }
+    case TextureFormat::argb_1555:
+    case TextureFormat::rgb_555: {
+        const int v = read16(pixel);
+        color.a = format == TextureFormat::argb_1555 ? widen(v >> 15, 1) : 255;
+        color.r = widen((v >> 10) & 31, 31);
+        color.g = widen((v >> 5) & 31, 31);
+        color.b = widen(v & 31, 31);
+        break;
+    }
+    case TextureFormat::rgb_565: {
+        const int v = read16(pixel);
+        color.r = widen(v >> 11, 31);
+        color.g = widen((v >> 5) & 63, 63);
+        color.b = widen(v & 31, 31);
+        break;
+    }
+    case TextureFormat::a_8:
+        color.r = color.g = color.b = 0;
+        color.a = pixel[0];
+        break;
+    case TextureFormat::l_8:
+        color.r = color.g = color.b = pixel[0];
+        break;
+    default:
+        throw TextureToolError(std::string("Cannot read pixels of ") + format_name(format));
+    }
+    return color;
+}
+
+void set_pixel(TextureFormat format, std::uint8_t *pixel, const Color &color) {
+    switch (format) {
+    case TextureFormat::argb_8888:
+    case TextureFormat::xrgb_8888:
+        pixel[0] = static_cast<std::uint8_t>(color.b);
+        pixel[1] = static_cast<std::uint8_t>(color.g);
+        pixel[2] = static_cast<std::uint8_t>(color.r);
+        pixel[3] = static_cast<std::uint8_t>(format == TextureFormat::argb_8888 ? color.a : 255);
+        break;
+    case TextureFormat::rgb_888:
+        pixel[0] = static_cast<std::uint8_t>(color.b);
+        pixel[1] = static_cast<std::uint8_t>(color.g);
+        pixel[2] = static_cast<std::uint8_t>(color.r);
+        break;
+    case TextureFormat::argb_4444:
+        write16(pixel, (narrow(color.a, 15) << 12) | (narrow(color.r, 15) << 8) | (narrow(color.g, 15) << 4) | narrow(color.b, 15));
+        break;
+    case TextureFormat::argb_1555:
+        write16(pixel, (color.a >= 128 ? 0x8000 : 0) | (narrow(color.r, 31) << 10) | (narrow(color.g, 31) << 5) | narrow(color.b, 31));
+        break;
+    case TextureFormat::rgb_555:
+        write16(pixel, 0x8000 | (narrow(color.r, 31) << 10) | (narrow(color.g, 31) << 5) | narrow(color.b, 31));
+        break;
+    case TextureFormat::rgb_565:
+        write16(pixel, (narrow(color.r, 31) << 11) | (narrow(color.g, 63) << 5) | narrow(color.b, 31));
+        break;
+    case TextureFormat::a_8:
+        pixel[0] = static_cast<std::uint8_t>(color.a);
+        break;
+    case TextureFormat::l_8:
+        pixel[0] = static_cast<std::uint8_t>((77 * color.r + 150 * color.g + 29 * color.b + 128) >> 8);
+        break;
+    default:
+        throw TextureToolError(std::string("Cannot write pixels of ") + format_name(format));
+    }
+}
+
+// ----------------------------------------------------------------------
+
+Color color_from_565(int value) {
+    Color color;
+    color.r = widen(value >> 11, 31);
+    color.g = widen((value >> 5) & 63, 63);
+    color.b = widen(value & 31, 31);
+    return color;
+}
+
+int color_to_565(const Color &color) {
+    return (narrow(color.r, 31) << 11) | (narrow(color.g, 63) << 5) | narrow(color.b, 31);
+}
+
+Color mix(const Color &first, const Color &second, int first_weight, int second_weight) {
+    const int divisor = first_weight + second_weight;
+    Color color;
+    color.r = (first.r * first_weight + second.r * second_weight + divisor / 2) / divisor;
+    color.g = (first.g * first_weight + second.g * second_weight + divisor / 2) / divisor;
+    color.b = (first.b * first_weight + second.b * second_weight + divisor / 2) / divisor;
+    return color;
+}
+
+void color_palette(int color0, int color1, bool four_colors, Color *palette) {
+    palette[0] = color_from_565(color0);
+    palette[1] = color_from_565(color1);
+    if (four_colors) {
+        palette[2] = mix(palette[0], palette[1], 2, 1);
+        palette[3] = mix(palette[0], palette[1], 1, 2);
+    } else {
+        palette[2] = mix(palette[0], palette[1], 1, 1);
+        palette[3] = Color{0, 0, 0, 0};
+    }
+}
+
+void alpha_palette(int alpha0, int alpha1, int *palette) {
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+    if (alpha0 > alpha1) {
+        for (int k = 2; k < 8; ++k) {
+            palette[k] = ((8 - k) * alpha0 + (k - 1) * alpha1 + 3) / 7;
+        }
+    } else {
+        for (int k = 2; k < 6; ++k) {
+            palette[k] = ((6 - k) * alpha0 + (k - 1) * alpha1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+int color_distance(const Color &first, const Color &second) {
+    const int r = first.r - second.r;
+    const int g = first.g - second.g;
+    const int b = first.b - second.b;
+    return r * r + g * g + b * b;
+}
+
+void encode_color(const Color *pixels, bool allow_transparent, std::uint8_t *block) {
+    Color low{255, 255, 255, 255};
+    Color high{0, 0, 0, 0};
+    bool transparent = false;
+    for (int i = 0; i < 16; ++i) {
+        if (allow_transparent && pixels[i].a < 128) {
+            transparent = true;
+            continue;
+        }
+        low.r = std::min(low.r, pixels[i].r);
+        low.g = std::min(low.g, pixels[i].g);
+        low.b = std::min(low.b, pixels[i].b);
+        high.r = std::max(high.r, pixels[i].r);
+        high.g = std::max(high.g, pixels[i].g);
+        high.b = std::max(high.b, pixels[i].b);
+    }
+    if (high.r < low.r) {
+        low = high = Color{0, 0, 0, 255};
+    }
+
+    int color0 = color_to_565(high);
+    int color1 = color_to_565(low);
+    if (transparent) {
+        std::swap(color0, color1);
+    }
+    const bool four_colors = !transparent && color0 > color1;
+    Color palette[4];
+    color_palette(color0, color1, four_colors, palette);
+
+    std::uint32_t indices = 0;
+    for (int i = 0; i < 16; ++i) {
+        int best = 0;
+        if (transparent && pixels[i].a < 128) {
+            best = 3;
+        } else {
+            int best_distance = INT_MAX;
+            const int candidates = four_colors ? 4 : 3;
+            for (int k = 0; k < candidates; ++k) {
+                const int distance = color_distance(pixels[i], palette[k]);
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best = k;
+                }
+            }
+        }
+        indices |= static_cast<std::uint32_t>(best) << (i * 2);
+    }
+
+    write16(block, color0);
+    write16(block + 2, color1);
+    for (int i = 0; i < 4; ++i) {
+        block[4 + i] = static_cast<std::uint8_t>(indices >> (i * 8));
+    }
+}
+
+void encode_alpha(const Color *pixels, TextureFormat format, std::uint8_t *block) {
+    if (format == TextureFormat::dxt3) {
+        for (int i = 0; i < 16; i += 2) {
+            block[i / 2] = static_cast<std::uint8_t>(narrow(pixels[i].a, 15) | (narrow(pixels[i + 1].a, 15) << 4));
+        }
+        return;
+    }
+
+    int low = 255;
+    int high = 0;
+    for (int i = 0; i < 16; ++i) {
+        low = std::min(low, pixels[i].a);
+        high = std::max(high, pixels[i].a);
+    }
+    int palette[8];
+    alpha_palette(high, low, palette);
+
+    std::uint64_t indices = 0;
+    for (int i = 0; i < 16; ++i) {
+        int best = 0;
+        int best_distance = INT_MAX;
+        for (int k = 0; k < 8; ++k) {
+            const int distance = std::abs(pixels[i].a - palette[k]);
+            if (distance < best_distance) {
+                best_distance = distance;
+                best = k;
+            }
+        }
+        indices |= static_cast<std::uint64_t>(best) << (i * 3);
+    }
+    block[0] = static_cast<std::uint8_t>(high);
+    block[1] = static_cast<std::uint8_t>(low);
+    for (int i = 0; i < 6; ++i) {
+        block[2 + i] = static_cast<std::uint8_t>(indices >> (i * 8));
+    }
+}
+
+} // namespace
+
+namespace reference_pipeline {
+
+TextureImage convert_format(const TextureImage &source, TextureFormat destination_format) {
+    if (source.format == destination_format) {
+        return source;
+    }
+    if (is_compressed(source.format)) {
+        return convert_format(decompress_dxt(source), destination_format);
+    }
+    if (is_compressed(destination_format)) {
+        return compress_dxt(convert_format(source, TextureFormat::argb_8888), destination_format);
+    }
+
+    TextureImage destination = TextureImage::create(destination_format, source.width, source.height);
+    const int source_stride = bytes_per_pixel(source.format);
+    const int destination_stride = bytes_per_pixel(destination_format);
+    for (int y = 0; y < source.height; ++y) {
+        const std::uint8_t *source_pixel = source.row(static_cast<std::size_t>(y));
+        std::uint8_t *destination_pixel = destination.row(static_cast<std::size_t>(y));
+        for (int x = 0; x < source.width; ++x) {
+            set_pixel(destination_format, destination_pixel, get_pixel(source.format, source_pixel));
+            source_pixel += source_stride;
+            destination_pixel += destination_stride;
+        }
+    }
+    return destination;
+}
+
+TextureImage next_mip(const TextureImage &source) {
+    if (source.format != TextureFormat::argb_8888) {
+        throw TextureToolError("Mip levels are filtered from argb_8888 images");
+    }
+
+    const int destination_width = std::max(1, source.width / 2);
+    const int destination_height = std::max(1, source.height / 2);
+    TextureImage destination = TextureImage::create(TextureFormat::argb_8888, destination_width, destination_height);
+
+    // 2x2, 1x2 or 2x1 footprint, each sample shifted down before it is summed
+    const bool halve_x = source.width > 1;
+    const bool halve_y = source.height > 1;
+    const int shift = (halve_x && halve_y) ? 2 : 1;
+    const std::size_t next_column = halve_x ? 4 : 0;
+    const std::size_t next_line = halve_y ? source.pitch() : 0;
+
+    for (int y = 0; y < destination_height; ++y) {
+        const std::uint8_t *source_pixel = source.row(static_cast<std::size_t>(halve_y ? y * 2 : y));
+        std::uint8_t *destination_pixel = destination.row(static_cast<std::size_t>(y));
+        for (int x = 0; x < destination_width; ++x) {
+            for (std::size_t channel = 0; channel < 4; ++channel) {
+                int value = source_pixel[channel] >> shift;
+                if (halve_x) {
+                    value += source_pixel[next_column + channel] >> shift;
+                }
+                if (halve_y) {
+                    value += source_pixel[next_line + channel] >> shift;
+                }
+                if (halve_x && halve_y) {
+                    value += source_pixel[next_line + next_column + channel] >> shift;
+                }
+                if (!halve_x && !halve_y) {
+                    value = source_pixel[channel];
+                }
+                destination_pixel[channel] = static_cast<std::uint8_t>(value);
+            }
+            source_pixel += halve_x ? 8 : 4;
+            destination_pixel += 4;
+        }
+    }
+    return destination;
+}
+
+TextureImage compress_dxt(const TextureImage &source, TextureFormat format) {
+    if (!is_compressed(format) || source.format != TextureFormat::argb_8888) {
+        throw TextureToolError("DXT blocks are compressed from argb_8888 images");
+    }
+
+    TextureImage destination = TextureImage::create(format, source.width, source.height);
+    const int block_size = bytes_per_block(format);
+    const int blocks_wide = static_cast<int>(destination.pitch()) / block_size;
+    const int blocks_high = static_cast<int>(row_count(format, source.height));
+
+    for (int block_y = 0; block_y < blocks_high; ++block_y) {
+        for (int block_x = 0; block_x < blocks_wide; ++block_x) {
+            Color pixels[16];
+            for (int i = 0; i < 16; ++i) {
+                const int x = std::min(block_x * 4 + i % 4, source.width - 1);
+                const int y = std::min(block_y * 4 + i / 4, source.height - 1);
+                pixels[i] = get_pixel(TextureFormat::argb_8888, source.row(static_cast<std::size_t>(y)) + x * 4);
+            }
+            std::uint8_t *block = destination.row(static_cast<std::size_t>(block_y)) + block_x * block_size;
+            if (format == TextureFormat::dxt1) {
+                encode_color(pixels, true, block);
+            } else {
+                encode_alpha(pixels, format, block);
+                encode_color(pixels, false, block + 8);
+            }
+        }
+    }
+    return destination;
+}
+
+TextureImage decompress_dxt(const TextureImage &source) {
+    if (!is_compressed(source.format)) {
+        throw TextureToolError(std::string("Not a DXT format: ") + format_name(source.format));
+    }
+
+    TextureImage destination = TextureImage::create(TextureFormat::argb_8888, source.width, source.height);
+    const int block_size = bytes_per_block(source.format);
+
+    for (int y = 0; y < source.height; ++y) {
+        std::uint8_t *destination_pixel = destination.row(static_cast<std::size_t>(y));
+        for (int x = 0; x < source.width; ++x) {
+            const std::uint8_t *block = source.row(static_cast<std::size_t>(y / 4)) + (x / 4) * block_size;
+            const int i = (y % 4) * 4 + (x % 4);
+            const std::uint8_t *color_block = source.format == TextureFormat::dxt1 ? block : block + 8;
+
+            const int color0 = read16(color_block);
+            const int color1 = read16(color_block + 2);
+            Color palette[4];
+            color_palette(color0, color1, source.format != TextureFormat::dxt1 || color0 > color1, palette);
+            Color color = palette[(color_block[4 + i / 4] >> ((i % 4) * 2)) & 3];
+
+            if (source.format == TextureFormat::dxt3) {
+                color.a = widen((block[i / 2] >> ((i % 2) * 4)) & 15, 15);
+            } else if (source.format == TextureFormat::dxt5) {
+                int alphas[8];
+                alpha_palette(block[0], block[1], alphas);
+                const int bit = i * 3;
+                const int packed = block[2 + bit / 8] | ((bit / 8 + 1 < 6 ? block[3 + bit / 8] : 0) << 8);
+                color.a = alphas[(packed >> (bit % 8)) & 7];
+            }
+            set_pixel(TextureFormat::argb_8888, destination_pixel, color);
+            destination_pixel += 4;
+        }
+    }
+    return destination;
+}
+
+} // namespace reference_pipeline
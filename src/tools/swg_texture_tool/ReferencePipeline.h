@@ -0,0 +1,18 @@
+#pragma once
+
+#include "TextureFormat.h"
+
+// Single threaded, per-pixel versions of each stage that the fast pipeline
+// is measured and checked against.  next_mip is a port of
+// ImageManipulation::defaultNextMipmapFunction, which shifts every source
+// sample right before summing them.  The DXT encoder fits the block's
+// bounding box and searches the palette for every pixel, the way the
+// exporter's offline compressor does.
+namespace reference_pipeline {
+
+TextureImage convert_format(const TextureImage &source, TextureFormat destination_format);
+TextureImage next_mip(const TextureImage &source);
+TextureImage compress_dxt(const TextureImage &source, TextureFormat format);
+TextureImage decompress_dxt(const TextureImage &source);
+
+} // namespace reference_pipeline
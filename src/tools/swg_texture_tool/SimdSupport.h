@@ -0,0 +1,8 @@
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWG_TEXTURE_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define SWG_TEXTURE_USE_SSE2 0
+#endif
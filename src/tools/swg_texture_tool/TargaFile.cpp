@@ -0,0 +1,133 @@
+#include "TargaFile.h"
+
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+std::uint32_t read_targa_pixel(const std::uint8_t *source, int bytes_per_pixel) {
+    switch (bytes_per_pixel) {
+    case 1:
+        return 0xff000000u | (static_cast<std::uint32_t>(source[0]) * 0x010101u);
+    case 2: {
+        const std::uint32_t v = static_cast<std::uint32_t>(source[0]) | (static_cast<std::uint32_t>(source[1]) << 8);
+        const std::uint32_t r = (v >> 10) & 31;
+        const std::uint32_t g = (v >> 5) & 31;
+        const std::uint32_t b = v & 31;
+        return ((v & 0x8000) ? 0xff000000u : 0u) | (((r << 3) | (r >> 2)) << 16) | (((g << 3) | (g >> 2)) << 8) | ((b << 3) | (b >> 2));
+    }
+    case 3:
+        return 0xff000000u | (static_cast<std::uint32_t>(source[2]) << 16) | (static_cast<std::uint32_t>(source[1]) << 8) | source[0];
+    default:
+        return (static_cast<std::uint32_t>(source[3]) << 24) | (static_cast<std::uint32_t>(source[2]) << 16) | (static_cast<std::uint32_t>(source[1]) << 8) | source[0];
+    }
+}
+
+} // namespace
+
+TextureImage read_targa(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw TextureToolError("Unable to open TGA file: " + path.string());
+    }
+    const std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (bytes.size() < 18) {
+        throw TextureToolError("Not a TGA file: " + path.string());
+    }
+
+    const int id_length = bytes[0];
+    const int color_map_type = bytes[1];
+    const int image_type = bytes[2];
+    const int width = bytes[12] | (bytes[13] << 8);
+    const int height = bytes[14] | (bytes[15] << 8);
+    const int bits_per_pixel = bytes[16];
+    const bool top_down = (bytes[17] & 0x20) != 0;
+
+    const bool run_length = image_type == 10 || image_type == 11;
+    const bool supported_type = image_type == 2 || image_type == 3 || run_length;
+    if (color_map_type != 0 || !supported_type) {
+        throw TextureToolError("Only true color and grayscale TGA files are supported: " + path.string());
+    }
+    if (bits_per_pixel != 8 && bits_per_pixel != 16 && bits_per_pixel != 24 && bits_per_pixel != 32) {
+        throw TextureToolError("Unsupported TGA pixel depth: " + path.string());
+    }
+
+    const int bytes_per_pixel = bits_per_pixel / 8;
+    const std::size_t pixel_count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    std::vector<std::uint32_t> pixels;
+    pixels.reserve(pixel_count);
+
+    std::size_t offset = 18 + static_cast<std::size_t>(id_length);
+    const auto require = [&](std::size_t count) {
+        if (offset + count > bytes.size()) {
+            throw TextureToolError("Truncated TGA file: " + path.string());
+        }
+    };
+
+    while (pixels.size() < pixel_count) {
+        if (!run_length) {
+            require(static_cast<std::size_t>(bytes_per_pixel));
+            pixels.push_back(read_targa_pixel(bytes.data() + offset, bytes_per_pixel));
+            offset += static_cast<std::size_t>(bytes_per_pixel);
+            continue;
+        }
+        require(1);
+        const int packet = bytes[offset++];
+        const int count = (packet & 0x7f) + 1;
+        if (packet & 0x80) {
+            require(static_cast<std::size_t>(bytes_per_pixel));
+            const std::uint32_t value = read_targa_pixel(bytes.data() + offset, bytes_per_pixel);
+            offset += static_cast<std::size_t>(bytes_per_pixel);
+            for (int i = 0; i < count && pixels.size() < pixel_count; ++i) {
+                pixels.push_back(value);
+            }
+        } else {
+            for (int i = 0; i < count && pixels.size() < pixel_count; ++i) {
+                require(static_cast<std::size_t>(bytes_per_pixel));
+                pixels.push_back(read_targa_pixel(bytes.data() + offset, bytes_per_pixel));
+                offset += static_cast<std::size_t>(bytes_per_pixel);
+            }
+        }
+    }
+
+    TextureImage image = TextureImage::create(TextureFormat::argb_8888, width, height);
+    for (int y = 0; y < height; ++y) {
+        const int source_y = top_down ? y : height - 1 - y;
+        const std::uint32_t *source_row = pixels.data() + static_cast<std::size_t>(source_y) * static_cast<std::size_t>(width);
+        std::uint8_t *row = image.row(static_cast<std::size_t>(y));
+        for (int x = 0; x < width; ++x) {
+            const std::uint32_t value = source_row[x];
+            row[x * 4 + 0] = static_cast<std::uint8_t>(value);
+            row[x * 4 + 1] = static_cast<std::uint8_t>(value >> 8);
+            row[x * 4 + 2] = static_cast<std::uint8_t>(value >> 16);
+            row[x * 4 + 3] = static_cast<std::uint8_t>(value >> 24);
+        }
+    }
+    return image;
+}
+
+void write_targa(const std::filesystem::path &path, const TextureImage &image) {
+    if (image.format != TextureFormat::argb_8888) {
+        throw TextureToolError("TGA files are written from argb_8888 images");
+    }
+    std::array<std::uint8_t, 18> header{};
+    header[2] = 2;
+    header[12] = static_cast<std::uint8_t>(image.width);
+    header[13] = static_cast<std::uint8_t>(image.width >> 8);
+    header[14] = static_cast<std::uint8_t>(image.height);
+    header[15] = static_cast<std::uint8_t>(image.height >> 8);
+    header[16] = 32;
+    header[17] = 0x28;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw TextureToolError("Unable to write TGA file: " + path.string());
+    }
+    out.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+    out.write(reinterpret_cast<const char *>(image.pixels.data()), static_cast<std::streamsize>(image.pixels.size()));
+    if (!out) {
+        throw TextureToolError("Failed writing TGA file: " + path.string());
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "TextureFormat.h"
+
+#include <filesystem>
+
+// Reads true color, grayscale and run-length encoded .tga files into an
+// argb_8888 image and writes argb_8888 images as uncompressed 32-bit files.
+TextureImage read_targa(const std::filesystem::path &path);
+void write_targa(const std::filesystem::path &path, const TextureImage &image);
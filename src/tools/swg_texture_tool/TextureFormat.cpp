@@ -0,0 +1,127 @@
+#include "TextureFormat.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+namespace {
+
+struct FormatInfo {
+    TextureFormat format;
+    const char *name;
+    int bytes_per_pixel;
+    int bytes_per_block;
+    bool alpha;
+};
+
+constexpr std::array<FormatInfo, 12> kFormats = {{
+    {TextureFormat::argb_8888, "argb_8888", 4, 0, true},
+    {TextureFormat::argb_4444, "argb_4444", 2, 0, true},
+    {TextureFormat::argb_1555, "argb_1555", 2, 0, true},
+    {TextureFormat::xrgb_8888, "xrgb_8888", 4, 0, false},
+    {TextureFormat::rgb_888, "rgb_888", 3, 0, false},
+    {TextureFormat::rgb_565, "rgb_565", 2, 0, false},
+    {TextureFormat::rgb_555, "rgb_555", 2, 0, false},
+    {TextureFormat::dxt1, "dxt1", 0, 8, true},
+    {TextureFormat::dxt3, "dxt3", 0, 16, true},
+    {TextureFormat::dxt5, "dxt5", 0, 16, true},
+    {TextureFormat::a_8, "a_8", 1, 0, true},
+    {TextureFormat::l_8, "l_8", 1, 0, false},
+}};
+
+const FormatInfo &info(TextureFormat format) {
+    return kFormats[static_cast<std::size_t>(format)];
+}
+
+} // namespace
+
+const char *format_name(TextureFormat format) {
+    return info(format).name;
+}
+
+std::optional<TextureFormat> parse_format(std::string_view name) {
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+    for (const FormatInfo &entry : kFormats) {
+        if (lower == entry.name) {
+            return entry.format;
+        }
+    }
+    return std::nullopt;
+}
+
+bool is_compressed(TextureFormat format) {
+    return info(format).bytes_per_block != 0;
+}
+
+bool has_alpha(TextureFormat format) {
+    return info(format).alpha;
+}
+
+int bytes_per_pixel(TextureFormat format) {
+    return info(format).bytes_per_pixel;
+}
+
+int bytes_per_block(TextureFormat format) {
+    return info(format).bytes_per_block;
+}
+
+std::size_t row_pitch(TextureFormat format, int width) {
+    if (is_compressed(format)) {
+        return static_cast<std::size_t>(std::max(1, (width + 3) / 4)) * static_cast<std::size_t>(bytes_per_block(format));
+    }
+    return static_cast<std::size_t>(width) * static_cast<std::size_t>(bytes_per_pixel(format));
+}
+
+std::size_t row_count(TextureFormat format, int height) {
+    if (is_compressed(format)) {
+        return static_cast<std::size_t>(std::max(1, (height + 3) / 4));
+    }
+    return static_cast<std::size_t>(height);
+}
+
+std::size_t surface_size(TextureFormat format, int width, int height) {
+    return row_pitch(format, width) * row_count(format, height);
+}
+
+const std::vector<std::pair<TextureFormat, TextureFormat>> &engine_conversions() {
+    static const std::vector<std::pair<TextureFormat, TextureFormat>> conversions = {
+        {TextureFormat::argb_8888, TextureFormat::argb_4444},
+        {TextureFormat::argb_4444, TextureFormat::argb_8888},
+        {TextureFormat::argb_1555, TextureFormat::argb_4444},
+        {TextureFormat::argb_1555, TextureFormat::argb_8888},
+        {TextureFormat::xrgb_8888, TextureFormat::rgb_888},
+        {TextureFormat::xrgb_8888, TextureFormat::argb_8888},
+        {TextureFormat::xrgb_8888, TextureFormat::rgb_565},
+        {TextureFormat::xrgb_8888, TextureFormat::rgb_555},
+        {TextureFormat::rgb_888, TextureFormat::xrgb_8888},
+        {TextureFormat::rgb_888, TextureFormat::argb_8888},
+        {TextureFormat::rgb_888, TextureFormat::rgb_565},
+        {TextureFormat::rgb_888, TextureFormat::rgb_555},
+        {TextureFormat::rgb_565, TextureFormat::rgb_555},
+        {TextureFormat::rgb_565, TextureFormat::argb_1555},
+        {TextureFormat::rgb_565, TextureFormat::rgb_888},
+        {TextureFormat::rgb_565, TextureFormat::argb_8888},
+        {TextureFormat::rgb_555, TextureFormat::rgb_565},
+        {TextureFormat::rgb_555, TextureFormat::argb_1555},
+        {TextureFormat::rgb_555, TextureFormat::rgb_888},
+        {TextureFormat::rgb_555, TextureFormat::argb_8888},
+        {TextureFormat::dxt1, TextureFormat::argb_1555},
+        {TextureFormat::dxt1, TextureFormat::argb_8888},
+        {TextureFormat::dxt3, TextureFormat::argb_8888},
+        {TextureFormat::dxt5, TextureFormat::argb_8888},
+    };
+    return conversions;
+}
+
+TextureImage TextureImage::create(TextureFormat format, int width, int height) {
+    if (width < 1 || height < 1) {
+        throw TextureToolError("Texture dimensions must be at least 1x1");
+    }
+    TextureImage image;
+    image.format = format;
+    image.width = width;
+    image.height = height;
+    image.pixels.assign(surface_size(format, width, height), 0);
+    return image;
+}
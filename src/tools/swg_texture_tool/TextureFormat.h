@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class TextureToolError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Mirrors the engine's TextureFormat values that have a CPU representation.
+// DXT2 and DXT4 share the DXT3 and DXT5 block layouts and are not listed.
+enum class TextureFormat {
+    argb_8888,
+    argb_4444,
+    argb_1555,
+    xrgb_8888,
+    rgb_888,
+    rgb_565,
+    rgb_555,
+    dxt1,
+    dxt3,
+    dxt5,
+    a_8,
+    l_8,
+};
+
+const char *format_name(TextureFormat format);
+std::optional<TextureFormat> parse_format(std::string_view name);
+
+bool is_compressed(TextureFormat format);
+bool has_alpha(TextureFormat format);
+int bytes_per_pixel(TextureFormat format);
+int bytes_per_block(TextureFormat format);
+
+// Bytes in one row of pixels, or one row of 4x4 blocks for DXT formats.
+std::size_t row_pitch(TextureFormat format, int width);
+std::size_t row_count(TextureFormat format, int height);
+std::size_t surface_size(TextureFormat format, int width, int height);
+
+// The source/destination pairs Texture registers with addConversion() at
+// install time, excluding the identity copies.
+const std::vector<std::pair<TextureFormat, TextureFormat>> &engine_conversions();
+
+// Pixels are stored the way Direct3D lays them out in memory, so argb_8888
+// is a little-endian 0xAARRGGBB word per pixel.
+struct TextureImage {
+    TextureFormat format = TextureFormat::argb_8888;
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> pixels;
+
+    static TextureImage create(TextureFormat format, int width, int height);
+
+    std::size_t pitch() const { return row_pitch(format, width); }
+    std::uint8_t *row(std::size_t index) { return pixels.data() + index * pitch(); }
+    const std::uint8_t *row(std::size_t index) const { return pixels.data() + index * pitch(); }
+};
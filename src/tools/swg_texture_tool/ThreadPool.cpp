@@ -0,0 +1,110 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace {
+
+thread_local bool t_inside_pool = false;
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_workers.reserve(thread_count - 1);
+    for (unsigned i = 1; i < thread_count; ++i) {
+        m_workers.emplace_back([this] { worker_main(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallel_for(int begin, int end, int grain, const RangeFunction &body) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max(1, grain);
+    if (m_workers.empty() || t_inside_pool || end - begin <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    std::lock_guard<std::mutex> dispatch(m_dispatch_mutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_body = &body;
+        m_next.store(begin);
+        m_end = end;
+        m_grain = grain;
+        m_finished = 0;
+        m_error = nullptr;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    run_chunks();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this] { return m_finished == m_workers.size(); });
+        m_body = nullptr;
+        error = m_error;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::worker_main() {
+    std::uint64_t seen_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_generation != seen_generation; });
+            if (m_stopping) {
+                return;
+            }
+            seen_generation = m_generation;
+        }
+
+        run_chunks();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_finished;
+        }
+        m_done.notify_one();
+    }
+}
+
+void ThreadPool::run_chunks() {
+    t_inside_pool = true;
+    for (;;) {
+        const int chunk_begin = m_next.fetch_add(m_grain);
+        if (chunk_begin >= m_end) {
+            break;
+        }
+        const int chunk_end = std::min(m_end, chunk_begin + m_grain);
+        try {
+            (*m_body)(chunk_begin, chunk_end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_error) {
+                m_error = std::current_exception();
+            }
+            m_next.store(m_end);
+        }
+    }
+    t_inside_pool = false;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads that split [begin, end) into chunks of at
+// least `grain` items.  The calling thread takes chunks too, and a
+// parallel_for issued from inside a body runs inline on that thread.
+class ThreadPool {
+public:
+    using RangeFunction = std::function<void(int begin, int end)>;
+
+    // thread_count counts the calling thread; 0 uses every hardware thread.
+    explicit ThreadPool(unsigned thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    unsigned thread_count() const { return static_cast<unsigned>(m_workers.size()) + 1; }
+
+    void parallel_for(int begin, int end, int grain, const RangeFunction &body);
+
+private:
+    void worker_main();
+    void run_chunks();
+
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_dispatch_mutex;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::uint64_t m_generation = 0;
+    unsigned m_finished = 0;
+    bool m_stopping = false;
+
+    const RangeFunction *m_body = nullptr;
+    std::atomic<int> m_next{0};
+    int m_end = 0;
+    int m_grain = 1;
+    std::exception_ptr m_error;
+};
@@ -0,0 +1,465 @@
+#include "DdsFile.h"
+#include "DxtCodec.h"
+#include "FormatConversion.h"
+#include "ImageQuality.h"
+#include "MipFilter.h"
+#include "ReferencePipeline.h"
+#include "TargaFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void print_usage() {
+    std::cout << "swg_texture_tool - convert textures, build mip chains and compress DXT on the CPU\n"
+              << "Usage:\n"
+              << "  swg_texture_tool convert <input.tga|input.dds> <output.dds> [--format <format>] [--mips box|kaiser|none] [--levels <n>]\n"
+              << "  swg_texture_tool decode <input.dds> <output.tga> [--level <n>]\n"
+              << "  swg_texture_tool batch <input_dir> <output_dir> [--format <format>] [--mips box|kaiser|none] [--levels <n>]\n"
+              << "  swg_texture_tool bench [--size <pixels>] [--input <file>] [--iterations <n>]\n\n"
+              << "  --format <format>  Output format (default argb_8888): argb_8888, argb_4444, argb_1555,\n"
+              << "                     xrgb_8888, rgb_888, rgb_565, rgb_555, dxt1, dxt3, dxt5, a_8, l_8\n"
+              << "  --mips <filter>    Mip filter for the chain (default box); none writes one level\n"
+              << "  --levels <n>       Stop the chain after n levels (default: down to 1x1)\n"
+              << "  --level <n>        Mip level to decode (default 0)\n"
+              << "  --threads <n>      Threads including the main thread (default: every hardware thread)\n"
+              << "  --no-simd          Use the scalar paths\n"
+              << "  --size <pixels>    Width and height of the generated bench image (default 1024)\n"
+              << "  --input <file>     Bench with the top level of a .tga or .dds file instead\n"
+              << "  --iterations <n>   Runs per bench stage; the fastest is reported (default 3)\n";
+}
+
+struct CommandLine {
+    std::string command;
+    std::vector<std::string> positional;
+    TextureFormat format = TextureFormat::argb_8888;
+    std::optional<MipFilter> filter = MipFilter::box;
+    int levels = 0;
+    int level = 0;
+    unsigned threads = 0;
+    bool use_simd = true;
+    int size = 1024;
+    int iterations = 3;
+    std::filesystem::path input;
+};
+
+int parse_count(const std::string &text, const std::string &option) {
+    char *end = nullptr;
+    const long value = std::strtol(text.c_str(), &end, 10);
+    if (end == text.c_str() || *end != '\0' || value < 0 || value > 1 << 16) {
+        throw TextureToolError("Invalid value for " + option + ": " + text);
+    }
+    return static_cast<int>(value);
+}
+
+CommandLine parse_command_line(int argc, char **argv) {
+    CommandLine line;
+    if (argc < 2) {
+        throw TextureToolError("Missing command");
+    }
+    line.command = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const bool has_value = i + 1 < argc;
+        if (arg == "--format" && has_value) {
+            const std::optional<TextureFormat> format = parse_format(argv[++i]);
+            if (!format) {
+                throw TextureToolError(std::string("Unknown format: ") + argv[i]);
+            }
+            line.format = *format;
+        } else if (arg == "--mips" && has_value) {
+            const std::string name(argv[++i]);
+            line.filter = parse_filter(name);
+            if (!line.filter && name != "none") {
+                throw TextureToolError("Unknown mip filter: " + name);
+            }
+        } else if (arg == "--levels" && has_value) {
+            line.levels = parse_count(argv[++i], arg);
+        } else if (arg == "--level" && has_value) {
+            line.level = parse_count(argv[++i], arg);
+        } else if (arg == "--threads" && has_value) {
+            line.threads = static_cast<unsigned>(parse_count(argv[++i], arg));
+        } else if (arg == "--no-simd") {
+            line.use_simd = false;
+        } else if (arg == "--size" && has_value) {
+            line.size = std::max(1, parse_count(argv[++i], arg));
+        } else if (arg == "--input" && has_value) {
+            line.input = argv[++i];
+        } else if (arg == "--iterations" && has_value) {
+            line.iterations = std::max(1, parse_count(argv[++i], arg));
+        } else if (!arg.empty() && arg[0] == '-') {
+            throw TextureToolError("Unknown argument: " + arg);
+        } else {
+            line.positional.push_back(arg);
+        }
+    }
+    return line;
+}
+
+std::string lower_extension(const std::filesystem::path &path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+    return extension;
+}
+
+TextureImage load_top_level(const std::filesystem::path &path, const PipelineOptions &options) {
+    const std::string extension = lower_extension(path);
+    if (extension == ".tga") {
+        return read_targa(path);
+    }
+    if (extension == ".dds") {
+        return convert_format(read_dds(path).front(), TextureFormat::argb_8888, options);
+    }
+    throw TextureToolError("Expected a .tga or .dds file: " + path.string());
+}
+
+std::vector<TextureImage> build_levels(const TextureImage &top, const CommandLine &line, const PipelineOptions &options) {
+    if (!line.filter) {
+        return {convert_format(top, line.format, options)};
+    }
+    return build_mip_chain(top, *line.filter, line.format, line.levels, options);
+}
+
+double megapixels_per_second(std::size_t pixels, double seconds) {
+    return seconds > 0.0 ? static_cast<double>(pixels) / seconds / 1.0e6 : 0.0;
+}
+
+// ----------------------------------------------------------------------
+
+int run_convert(const CommandLine &line, const PipelineOptions &options) {
+    if (line.positional.size() != 2) {
+        print_usage();
+        return 1;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const TextureImage top = load_top_level(line.positional[0], options);
+    const std::vector<TextureImage> levels = build_levels(top, line, options);
+    write_dds(line.positional[1], levels);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Wrote " << line.positional[1] << ": " << top.width << "x" << top.height << " " << format_name(line.format) << ", " << levels.size() << " level(s) in "
+              << std::fixed << std::setprecision(3) << seconds << "s" << std::endl;
+    return 0;
+}
+
+int run_decode(const CommandLine &line, const PipelineOptions &options) {
+    if (line.positional.size() != 2) {
+        print_usage();
+        return 1;
+    }
+    const std::vector<TextureImage> levels = read_dds(line.positional[0]);
+    if (line.level >= static_cast<int>(levels.size())) {
+        throw TextureToolError("The file has " + std::to_string(levels.size()) + " level(s)");
+    }
+    const TextureImage &level = levels[static_cast<std::size_t>(line.level)];
+    write_targa(line.positional[1], convert_format(level, TextureFormat::argb_8888, options));
+    std::cout << "Wrote " << line.positional[1] << " from level " << line.level << " (" << level.width << "x" << level.height << " " << format_name(level.format) << ")" << std::endl;
+    return 0;
+}
+
+int run_batch(const CommandLine &line, const PipelineOptions &options) {
+    if (line.positional.size() != 2) {
+        print_usage();
+        return 1;
+    }
+    const std::filesystem::path input_root(line.positional[0]);
+    const std::filesystem::path output_root(line.positional[1]);
+
+    std::vector<std::filesystem::path> inputs;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(input_root)) {
+        const std::string extension = lower_extension(entry.path());
+        if (entry.is_regular_file() && (extension == ".tga" || extension == ".dds")) {
+            inputs.push_back(entry.path());
+        }
+    }
+    std::sort(inputs.begin(), inputs.end());
+
+    // files are spread over the pool; the stages inside each file then run inline
+    std::mutex report_mutex;
+    std::atomic<std::size_t> pixels{0};
+    std::atomic<int> failures{0};
+    const auto start = std::chrono::steady_clock::now();
+
+    const auto process = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const std::filesystem::path &input = inputs[static_cast<std::size_t>(i)];
+            std::filesystem::path output = output_root / std::filesystem::relative(input, input_root);
+            output.replace_extension(".dds");
+            try {
+                const TextureImage top = load_top_level(input, options);
+                std::filesystem::create_directories(output.parent_path());
+                write_dds(output, build_levels(top, line, options));
+                pixels += static_cast<std::size_t>(top.width) * static_cast<std::size_t>(top.height);
+            } catch (const std::exception &err) {
+                std::lock_guard<std::mutex> lock(report_mutex);
+                std::cerr << "Failed " << input.string() << ": " << err.what() << std::endl;
+                ++failures;
+            }
+        }
+    };
+    parallel_rows(options, 0, static_cast<int>(inputs.size()), 1, process);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Built " << (inputs.size() - static_cast<std::size_t>(failures.load())) << " of " << inputs.size() << " texture(s) in " << std::fixed << std::setprecision(3) << seconds
+              << "s, " << std::setprecision(1) << megapixels_per_second(pixels.load(), seconds) << " MPixels/s of source" << std::endl;
+    return failures.load() == 0 ? 0 : 1;
+}
+
+// ----------------------------------------------------------------------
+
+// Smooth gradients, a soft-edged disc, stripes and a hashed grain so every
+// stage sees both flat and busy blocks.
+TextureImage make_bench_image(int size) {
+    TextureImage image = TextureImage::create(TextureFormat::argb_8888, size, size);
+    const double scale = 1.0 / static_cast<double>(size);
+    for (int y = 0; y < size; ++y) {
+        std::uint8_t *row = image.row(static_cast<std::size_t>(y));
+        for (int x = 0; x < size; ++x) {
+            const double u = x * scale;
+            const double v = y * scale;
+            const double disc = std::hypot(u - 0.6, v - 0.4) < 0.25 ? 1.0 : 0.0;
+            const double stripes = 0.5 + 0.5 * std::sin((u * 3.0 + v) * 40.0);
+            std::uint32_t hash = static_cast<std::uint32_t>(x) * 73856093u ^ static_cast<std::uint32_t>(y) * 19349663u;
+            hash = (hash ^ (hash >> 13)) * 0x5bd1e995u;
+            const double grain = static_cast<double>((hash >> 24) & 15) - 7.5;
+
+            const auto clamp_byte = [](double value) { return static_cast<std::uint8_t>(std::clamp(value, 0.0, 255.0)); };
+            row[x * 4 + 0] = clamp_byte(255.0 * v * 0.8 + 40.0 * stripes + grain);
+            row[x * 4 + 1] = clamp_byte(200.0 * (1.0 - u) * (1.0 - disc) + 230.0 * disc + grain);
+            row[x * 4 + 2] = clamp_byte(255.0 * u + 30.0 * stripes * (1.0 - disc));
+            row[x * 4 + 3] = clamp_byte(255.0 * (0.5 + 0.5 * std::cos(u * 6.0)) * (0.6 + 0.4 * disc));
+        }
+    }
+    return image;
+}
+
+double best_seconds(int iterations, const std::function<void()> &body) {
+    double best = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = (i == 0) ? seconds : std::min(best, seconds);
+    }
+    return best;
+}
+
+std::string format_db(double value) {
+    if (std::isinf(value)) {
+        return "exact";
+    }
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(2) << value;
+    return text.str();
+}
+
+struct BenchStage {
+    std::string name;
+    std::size_t pixels = 0;
+    double reference_seconds = 0.0;
+    double single_seconds = 0.0;
+    double threaded_seconds = 0.0;
+    double quality = 0.0;
+    std::string requirement;
+    bool passed = false;
+    bool simd_mismatch = false;
+    std::string note;
+};
+
+void print_stage(const BenchStage &stage) {
+    std::cout << std::left << std::setw(28) << stage.name << std::right << std::fixed << std::setprecision(1) << std::setw(11) << megapixels_per_second(stage.pixels, stage.reference_seconds)
+              << std::setw(11) << megapixels_per_second(stage.pixels, stage.single_seconds) << std::setw(11) << megapixels_per_second(stage.pixels, stage.threaded_seconds) << std::setw(8)
+              << std::setprecision(1) << (stage.threaded_seconds > 0.0 ? stage.reference_seconds / stage.threaded_seconds : 0.0) << "x" << std::setw(10) << format_db(stage.quality) << "  "
+              << std::left << std::setw(14) << stage.requirement << (stage.passed ? "ok" : "FAIL");
+    if (stage.simd_mismatch) {
+        std::cout << "  scalar and SIMD results differ";
+    }
+    if (!stage.note.empty()) {
+        std::cout << "  " << stage.note;
+    }
+    std::cout << std::right << std::endl;
+}
+
+bool same_result(const TextureImage &first, const TextureImage &second) {
+    return identical(first, second);
+}
+
+bool same_result(const std::vector<TextureImage> &first, const std::vector<TextureImage> &second) {
+    return std::equal(first.begin(), first.end(), second.begin(), second.end(), [](const TextureImage &a, const TextureImage &b) { return identical(a, b); });
+}
+
+// Runs one stage through the reference, the fast pipeline on one thread and
+// the fast pipeline on the pool, and checks that the scalar and SIMD fast
+// paths agree bit for bit.
+template <typename Result>
+BenchStage measure(const std::string &name, std::size_t pixels, int iterations, const PipelineOptions &options, const std::function<Result()> &reference,
+                   const std::function<Result(const PipelineOptions &)> &fast, Result &reference_result, Result &fast_result) {
+    BenchStage stage;
+    stage.name = name;
+    stage.pixels = pixels;
+
+    PipelineOptions single = options;
+    single.pool = nullptr;
+
+    stage.reference_seconds = best_seconds(iterations, [&] { reference_result = reference(); });
+    stage.single_seconds = best_seconds(iterations, [&] { fast_result = fast(single); });
+    stage.threaded_seconds = best_seconds(iterations, [&] { fast_result = fast(options); });
+
+    if (options.use_simd && simd_available()) {
+        PipelineOptions scalar = options;
+        scalar.use_simd = false;
+        stage.simd_mismatch = !same_result(fast(scalar), fast_result);
+    }
+    return stage;
+}
+
+// Lowest PSNR of each level of the chain against the reference filter run
+// on the level above it, so the engine filter's rounding bias is measured
+// once per level instead of compounding down the chain.
+double chain_psnr(const std::vector<TextureImage> &levels) {
+    double lowest = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 1; i < levels.size(); ++i) {
+        lowest = std::min(lowest, psnr(reference_pipeline::next_mip(levels[i - 1]), levels[i], true));
+    }
+    return lowest;
+}
+
+std::vector<TextureImage> reference_chain(const TextureImage &top) {
+    std::vector<TextureImage> levels{top};
+    while (levels.back().width > 1 || levels.back().height > 1) {
+        levels.push_back(reference_pipeline::next_mip(levels.back()));
+    }
+    return levels;
+}
+
+int run_bench(const CommandLine &line, const PipelineOptions &options) {
+    const TextureImage source = line.input.empty() ? make_bench_image(line.size) : load_top_level(line.input, options);
+    const std::size_t pixels = static_cast<std::size_t>(source.width) * static_cast<std::size_t>(source.height);
+    const double exact_db = 99.0;
+    const double mip_box_db = 40.0;
+    const double mip_kaiser_db = 24.0;
+    const double dxt_margin_db = 1.0;
+
+    std::cout << "Texture pipeline bench: " << source.width << "x" << source.height << ", " << (options.pool ? options.pool->thread_count() : 1u) << " thread(s), "
+              << (options.use_simd && simd_available() ? "SSE2" : "scalar") << ", best of " << line.iterations << "\n"
+              << "MPixels/s columns: reference (engine per-pixel loops), fast on 1 thread, fast on every thread\n\n"
+              << std::left << std::setw(28) << "stage" << std::right << std::setw(11) << "reference" << std::setw(11) << "fast x1" << std::setw(11) << "fast xN" << std::setw(9)
+              << "speedup" << std::setw(10) << "PSNR dB" << "  " << std::left << std::setw(14) << "required" << "result" << std::right << std::endl;
+
+    bool all_passed = true;
+    const auto finish = [&](BenchStage &stage) {
+        stage.passed = stage.passed && !stage.simd_mismatch;
+        all_passed = all_passed && stage.passed;
+        print_stage(stage);
+    };
+
+    //-- every conversion Texture registers with addConversion
+    for (const auto &[from, to] : engine_conversions()) {
+        const TextureImage input = convert_format(source, from, options);
+        TextureImage reference_result;
+        TextureImage fast_result;
+        BenchStage stage = measure<TextureImage>(
+            std::string(format_name(from)) + " -> " + format_name(to), pixels, line.iterations, options, [&] { return reference_pipeline::convert_format(input, to); },
+            [&](const PipelineOptions &run) { return convert_format(input, to, run); }, reference_result, fast_result);
+        stage.quality = psnr(reference_result, fast_result, true);
+        stage.requirement = ">= " + format_db(exact_db);
+        stage.passed = stage.quality >= exact_db;
+        finish(stage);
+    }
+
+    //-- mip chains
+    {
+        std::vector<TextureImage> reference_levels;
+        std::vector<TextureImage> fast_levels;
+        BenchStage stage = measure<std::vector<TextureImage>>(
+            "mips box", pixels, line.iterations, options, [&] { return reference_chain(source); },
+            [&](const PipelineOptions &run) { return build_mip_chain(source, MipFilter::box, TextureFormat::argb_8888, 0, run); }, reference_levels, fast_levels);
+        stage.quality = chain_psnr(fast_levels);
+        stage.requirement = ">= " + format_db(mip_box_db);
+        stage.passed = stage.quality >= mip_box_db;
+        finish(stage);
+    }
+    {
+        std::vector<TextureImage> reference_levels;
+        std::vector<TextureImage> fast_levels;
+        BenchStage stage = measure<std::vector<TextureImage>>(
+            "mips kaiser", pixels, line.iterations, options, [&] { return reference_chain(source); },
+            [&](const PipelineOptions &run) { return build_mip_chain(source, MipFilter::kaiser, TextureFormat::argb_8888, 0, run); }, reference_levels, fast_levels);
+        stage.quality = chain_psnr(fast_levels);
+        stage.requirement = ">= " + format_db(mip_kaiser_db);
+        stage.passed = stage.quality >= mip_kaiser_db;
+        stage.note = "vs reference box filter";
+        finish(stage);
+    }
+
+    //-- DXT compression, judged by how close each decoded result stays to the
+    //-- source; dxt1 gets an opaque copy so one-bit alpha does not dominate
+    const TextureImage opaque = convert_format(convert_format(source, TextureFormat::xrgb_8888, options), TextureFormat::argb_8888, options);
+    for (const TextureFormat format : {TextureFormat::dxt1, TextureFormat::dxt3, TextureFormat::dxt5}) {
+        const TextureImage &input = format == TextureFormat::dxt1 ? opaque : source;
+        TextureImage reference_result;
+        TextureImage fast_result;
+        BenchStage stage = measure<TextureImage>(
+            std::string("compress ") + format_name(format), pixels, line.iterations, options, [&] { return reference_pipeline::compress_dxt(input, format); },
+            [&](const PipelineOptions &run) { return compress_dxt(input, format, run); }, reference_result, fast_result);
+        const bool with_alpha = format != TextureFormat::dxt1;
+        const double reference_db = psnr(input, reference_pipeline::decompress_dxt(reference_result), with_alpha);
+        stage.quality = psnr(input, reference_pipeline::decompress_dxt(fast_result), with_alpha);
+        stage.requirement = ">= " + format_db(reference_db - dxt_margin_db);
+        stage.passed = stage.quality >= reference_db - dxt_margin_db;
+        stage.note = "reference " + format_db(reference_db) + " dB vs source";
+        finish(stage);
+    }
+
+    std::cout << "\n" << (all_passed ? "All stages passed" : "Some stages FAILED") << std::endl;
+    return all_passed ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    try {
+        const CommandLine line = parse_command_line(argc, argv);
+
+        ThreadPool pool(line.threads);
+        PipelineOptions options;
+        options.pool = &pool;
+        options.use_simd = line.use_simd;
+
+        if (line.command == "convert") {
+            return run_convert(line, options);
+        }
+        if (line.command == "decode") {
+            return run_decode(line, options);
+        }
+        if (line.command == "batch") {
+            return run_batch(line, options);
+        }
+        if (line.command == "bench") {
+            return run_bench(line, options);
+        }
+        print_usage();
+        return 1;
+    } catch (const TextureToolError &err) {
+        std::cerr << err.what() << std::endl;
+        print_usage();
+        return 1;
+    } catch (const std::exception &err) {
+        std::cerr << "Error: " << err.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,11 +1,13 @@
 #include "TerrainAutoPainter.h"
 #include "SmartTerrainAnalyzer.h"
 #include "TerrainEditorDoc.h"
+#include "sharedTerrain/TerrainDirtyRegion.h"
 
 #include <afxwin.h>
 #include <atlconv.h>
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -81,16 +83,50 @@ namespace
 
                 return document;
         }
+
+        // Moves the smallest boundary in the document by one chunk and reports how
+        // much of the map the dirty region regenerates compared with a full rebuild.
+        int runDirtyRegionBenchmark(TerrainEditorDoc &document)
+        {
+                // EditorTerrain always generates legacy mode chunks.
+                const bool legacyMode = true;
+
+                TerrainDirtyRegion::BenchmarkResult result;
+                if (!TerrainDirtyRegion::runBenchmark(*document.getTerrainGenerator(), document.getMapWidthInMeters(), document.getChunkWidthInMeters(), document.getNumberOfTilesPerChunk(), legacyMode, result))
+                {
+                        std::cerr << "Dirty region benchmark needs at least one active boundary\n";
+                        return 3;
+                }
+
+                const float fraction = result.numberOfChunks > 0 ? static_cast<float>(result.numberOfDirtyChunks) / static_cast<float>(result.numberOfChunks) : 0.0f;
+
+                std::cout << "{\n";
+                std::cout << "  \"mapWidthMeters\": " << document.getMapWidthInMeters() << ",\n";
+                std::cout << "  \"chunkWidthMeters\": " << document.getChunkWidthInMeters() << ",\n";
+                std::cout << "  \"boundary\": \"" << escapeJson(result.boundaryName ? result.boundaryName : "") << "\",\n";
+                std::cout << "  \"entireMap\": " << (result.entireMap ? "true" : "false") << ",\n";
+                std::cout << "  \"dirtyRegionSeconds\": " << result.calculateTime << ",\n";
+                std::cout << "  \"sampledChunks\": " << result.numberOfSampledChunks << ",\n";
+                std::cout << "  \"secondsPerChunk\": " << result.secondsPerChunk << ",\n";
+                std::cout << "  \"fullRegeneration\": { \"chunks\": " << result.numberOfChunks << ", \"seconds\": " << result.fullRegenerationTime << " },\n";
+                std::cout << "  \"dirtyRegeneration\": { \"chunks\": " << result.numberOfDirtyChunks << ", \"seconds\": " << result.dirtyRegenerationTime << " },\n";
+                std::cout << "  \"regeneratedFraction\": " << fraction << "\n";
+                std::cout << "}\n";
+
+                return 0;
+        }
 }
 
 int main(int argc, char **argv)
 {
         if (argc < 2)
         {
-                std::cerr << "Usage: terrain_autopainter_headless <terrain_file>\n";
+                std::cerr << "Usage: terrain_autopainter_headless <terrain_file> [--dirty-region-benchmark]\n";
                 return 1;
         }
 
+        const bool dirtyRegionBenchmark = argc > 2 && std::strcmp(argv[2], "--dirty-region-benchmark") == 0;
+
         TerrainEditorDoc *document = loadTerrainDocument(argv[1]);
         if (!document)
         {
@@ -98,6 +134,13 @@ int main(int argc, char **argv)
                 return 2;
         }
 
+        if (dirtyRegionBenchmark)
+        {
+                const int exitCode = runDirtyRegionBenchmark(*document);
+                delete document;
+                return exitCode;
+        }
+
         TerrainAutoPainter::Config config;
         config.gridSize = std::max(257, config.gridSize);
 